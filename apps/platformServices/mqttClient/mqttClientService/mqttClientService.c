@@ -14,6 +14,7 @@
 
 #include "MQTTClient.h"
 #include "Socket.h"
+#include "publishQueue.h"
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -38,14 +39,31 @@ typedef struct mqtt_Session
     void* connectionLostHandlerContextPtr;
     // The legato client session that owns this MQTT session
     le_msg_SessionRef_t clientSession;
+    // Messages published by the client, sent by the publish thread
+    pubQueue_Ref_t publishQueue;
 } mqtt_Session;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delivery report from paho: a QoS 1 or 2 message was acknowledged by the broker.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    mqtt_SessionRef_t sessionRef;
+    MQTTClient_deliveryToken token;
+} mqtt_Delivery;
+
 static int QosEnumToValue(mqtt_Qos_t qos);
 static void ConnectionLostHandler(void* contextPtr, char* causePtr);
 static void ConnectionLostEventHandler(void* reportPtr);
 static int MessageArrivedHandler(
     void* contextPtr, char* topicNamePtr, int topicLen, MQTTClient_message* messagePtr);
 static void MessageReceivedEventHandler(void* reportPtr);
+static void DeliveryCompleteHandler(void* contextPtr, MQTTClient_deliveryToken token);
+static void DeliveryCompleteEventHandler(void* reportPtr);
+static le_result_t SendMessage(void* contextPtr, const char* topicPtr, const uint8_t* payloadPtr,
+    size_t payloadLen, int qos, bool retain, int* tokenPtr);
 static void DestroySessionInternal(mqtt_Session* sessionPtr);
 
 //--------------------------------------------------------------------------------------------------
@@ -72,6 +90,14 @@ static le_event_Id_t ReceiveThreadEventId;
 //--------------------------------------------------------------------------------------------------
 static le_event_Id_t ConnectionLostThreadEventId;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Event id for delivery complete events from paho.  The justification for this event is the same
+ * as for ReceiveThreadEventId.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_event_Id_t DeliveryCompleteThreadEventId;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * MQTT session memory pool.
@@ -177,12 +203,14 @@ le_result_t mqtt_CreateSession
 
     *sessionRefPtr = le_ref_CreateRef(SessionRefMap, s);
 
+    s->publishQueue = pubQueue_Create(SendMessage, s);
+
     LE_ASSERT(MQTTClient_setCallbacks(
             s->client,
             *sessionRefPtr,
             &ConnectionLostHandler,
             &MessageArrivedHandler,
-            NULL) == MQTTCLIENT_SUCCESS);
+            &DeliveryCompleteHandler) == MQTTCLIENT_SUCCESS);
 
     return LE_OK;
 }
@@ -228,6 +256,8 @@ static void DestroySessionInternal
     mqtt_Session* sessionPtr
 )
 {
+    // Stop the sending before destroying the paho client it uses
+    pubQueue_Delete(sessionPtr->publishQueue);
     MQTTClient_destroy(&(sessionPtr->client));
     // It is necessary to cast to char* from const char* in order to free the memory
     // associated with the username and password.
@@ -369,6 +399,12 @@ le_result_t mqtt_Connect
             break;
 
         case MQTTCLIENT_SUCCESS:
+            // A clean session drops the messages paho had in flight: send them again
+            if (s->connectOptions.cleansession)
+            {
+                pubQueue_RequeueInFlight(s->publishQueue);
+            }
+            pubQueue_SetConnected(s->publishQueue, true);
             result = LE_OK;
             break;
 
@@ -411,6 +447,9 @@ le_result_t mqtt_Disconnect
         return LE_FAULT;
     }
 
+    // The queued messages are kept until the next connection
+    pubQueue_SetConnected(s->publishQueue, false);
+
     const int waitBeforeDisconnectMs = 0;
     const int disconnectResult = MQTTClient_disconnect(s->client, waitBeforeDisconnectMs);
     le_result_t result;
@@ -442,8 +481,14 @@ le_result_t mqtt_Disconnect
 /**
  * Publish the supplied payload to the MQTT broker on the given topic.
  *
+ * The message is queued and sent by the publish thread, so that the service does not wait for
+ * the network. Messages published while the session is disconnected are sent once it is
+ * connected again.
+ *
  * @return
- *      LE_OK on success or LE_FAULT on failure
+ *      - LE_OK on success
+ *      - LE_NO_MEMORY if the publish queue is full
+ *      - LE_FAULT on failure
  */
 //--------------------------------------------------------------------------------------------------
 le_result_t mqtt_Publish
@@ -468,19 +513,61 @@ le_result_t mqtt_Publish
         return LE_FAULT;
     }
 
-    MQTTClient_deliveryToken* dtNotUsed = NULL;
-    const int publishResult = MQTTClient_publish(
-        s->client, topicPtr, payloadLen, (void*)payloadPtr, QosEnumToValue(qos), retain, dtNotUsed);
-    le_result_t result = LE_OK;
-    if (publishResult != MQTTCLIENT_SUCCESS)
+    le_result_t result = pubQueue_Publish(
+        s->publishQueue, topicPtr, payloadPtr, payloadLen, QosEnumToValue(qos), retain);
+    switch (result)
     {
-        LE_WARN("Publish failed with error code (%d)", publishResult);
-        result = LE_FAULT;
+        case LE_OK:
+            break;
+
+        case LE_NO_MEMORY:
+            LE_WARN("Publish queue full, message on topic '%s' dropped", topicPtr);
+            break;
+
+        default:
+            LE_WARN("Publish failed (%s)", LE_RESULT_TXT(result));
+            result = LE_FAULT;
+            break;
     }
 
     return result;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Configure the queue of the messages published on the session.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_BAD_PARAMETER if the queue size or the in-flight window is out of range
+ *      - LE_FAULT if the spool file cannot be opened
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t mqtt_SetPublishQueue
+(
+    mqtt_SessionRef_t sessionRef,   ///< [IN] Session
+    uint32_t queueSize,             ///< [IN] Maximum number of messages held in memory
+    uint32_t inFlightWindow,        ///< [IN] Maximum number of QoS 1 and 2 messages sent but not
+                                    ///  yet acknowledged by the broker
+    const char* spoolPathPtr        ///< [IN] File where the QoS 1 and 2 messages overflowing the
+                                    ///  queue are stored, empty for none
+)
+{
+    mqtt_Session* s = le_ref_Lookup(SessionRefMap, sessionRef);
+    if (s == NULL)
+    {
+        LE_KILL_CLIENT("Session doesn't exist");
+        return LE_FAULT;
+    }
+    if (s->clientSession != mqtt_GetClientSessionRef())
+    {
+        LE_KILL_CLIENT("Session doesn't belong to this client");
+        return LE_FAULT;
+    }
+
+    return pubQueue_Configure(s->publishQueue, queueSize, inFlightWindow, spoolPathPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Subscribe to the given topic pattern.  Topics look like UNIX filesystem paths.  Eg.
@@ -771,6 +858,9 @@ static void ConnectionLostEventHandler
         return;
     }
 
+    // The queued messages are kept until the next connection
+    pubQueue_SetConnected(s->publishQueue, false);
+
     if (s->connectionLostHandler != NULL)
     {
         s->connectionLostHandler(s->connectionLostHandlerContextPtr);
@@ -881,6 +971,93 @@ static void MessageReceivedEventHandler
     le_mem_Release(storedMsgPtr);
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This is the delivery complete callback function that is supplied to the paho library.  The
+ * function generates an event rather than updating the publish queue because the session may be
+ * destroyed meanwhile by the main thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DeliveryCompleteHandler
+(
+    void* contextPtr,               ///< Session of the delivered message
+    MQTTClient_deliveryToken token  ///< Delivery token of the message
+)
+{
+    mqtt_Delivery delivery =
+    {
+        .sessionRef = contextPtr,
+        .token = token,
+    };
+
+    le_event_Report(DeliveryCompleteThreadEventId, &delivery, sizeof(delivery));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The event handler for the delivery complete event that is generated by DeliveryCompleteHandler.
+ * This function releases the message from the publish queue.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DeliveryCompleteEventHandler
+(
+    void* reportPtr
+)
+{
+    mqtt_Delivery* deliveryPtr = reportPtr;
+
+    mqtt_Session* s = le_ref_Lookup(SessionRefMap, deliveryPtr->sessionRef);
+    if (s == NULL)
+    {
+        LE_DEBUG("Delivery for a destroyed session=0x%p", deliveryPtr->sessionRef);
+        return;
+    }
+
+    pubQueue_Delivered(s->publishQueue, deliveryPtr->token);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send a queued message to the broker.  This function is called on the publish thread.
+ *
+ * @return
+ *      - LE_OK if the message is sent
+ *      - LE_NOT_POSSIBLE if the session is not connected
+ *      - LE_FAULT if the message is rejected
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t SendMessage
+(
+    void* contextPtr,           ///< [IN] Session
+    const char* topicPtr,       ///< [IN] Topic
+    const uint8_t* payloadPtr,  ///< [IN] Message
+    size_t payloadLen,          ///< [IN] Message length
+    int qos,                    ///< [IN] QoS value
+    bool retain,                ///< [IN] Retain flag for message
+    int* tokenPtr               ///< [OUT] Delivery token
+)
+{
+    mqtt_Session* s = contextPtr;
+    MQTTClient_deliveryToken token = 0;
+
+    const int publishResult = MQTTClient_publish(
+        s->client, topicPtr, payloadLen, (void*)payloadPtr, qos, retain, &token);
+    switch (publishResult)
+    {
+        case MQTTCLIENT_SUCCESS:
+            *tokenPtr = token;
+            return LE_OK;
+
+        case MQTTCLIENT_DISCONNECTED:
+        case SOCKET_ERROR:
+            return LE_NOT_POSSIBLE;
+
+        default:
+            LE_WARN("Publish failed with error code (%d)", publishResult);
+            return LE_FAULT;
+    }
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Destroy all owned sessions
@@ -939,6 +1116,19 @@ COMPONENT_INIT
         ConnectionLostThreadEventId,
         ConnectionLostEventHandler);
 
+    DeliveryCompleteThreadEventId = le_event_CreateId(
+        "MqttClient delivery complete notification", sizeof(mqtt_Delivery));
+    le_event_AddHandler(
+        "MqttClient delivery complete notification",
+        DeliveryCompleteThreadEventId,
+        DeliveryCompleteEventHandler);
+
+    // Queued messages must fit in the limits of the API
+    LE_FATAL_IF((MQTT_MAX_TOPIC_LENGTH > PUBQUEUE_MAX_TOPIC_LEN) ||
+                (MQTT_MAX_PAYLOAD_LENGTH > PUBQUEUE_MAX_PAYLOAD_BYTES),
+                "Publish queue too small for the MQTT API limits");
+    pubQueue_Init();
+
     le_msg_AddServiceCloseHandler(mqtt_GetServiceRef(), DestroyAllOwnedSessions, NULL);
 
     MQTTClient_init_options initOptions = MQTTClient_init_options_initializer;
@@ -0,0 +1,1030 @@
+/**
+ * @file publishQueue.c
+ *
+ * Implementation of the asynchronous MQTT publish pipeline.
+ *
+ * The messages of a queue move from the pending list (waiting to be sent) to the sending list of
+ * the publish thread, which sends them by batches without holding the queue lock, then QoS 1 and 2
+ * messages wait in the in-flight list for their acknowledgement. The queue lock is never held
+ * while sending.
+ *
+ * A spooled message stays in the spool file until the broker acknowledges it. The read offset
+ * saved in the spool file only moves past the messages which are acknowledged, or dropped, along
+ * with all the messages before them, so that a restart replays any message not acknowledged yet.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "publishQueue.h"
+
+#include <sys/uio.h>
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of messages sent by the publish thread in a row for a queue, before giving the
+ * other queues their turn.
+ */
+//--------------------------------------------------------------------------------------------------
+#define BATCH_MAX_COUNT     16
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Spool file magic.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SPOOL_MAGIC         "MQSP"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Spool file header: the messages before the read offset have been acknowledged.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct __attribute__((packed))
+{
+    char     magic[4];      ///< SPOOL_MAGIC
+    uint32_t readOffset;    ///< Offset of the first message not acknowledged
+}
+SpoolHeader_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Spool file record header, followed by the topic and the payload.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct __attribute__((packed))
+{
+    uint16_t topicLen;      ///< Topic length
+    uint16_t payloadLen;    ///< Payload size
+    uint8_t  qos;           ///< QoS
+    uint8_t  retain;        ///< Retain flag
+}
+SpoolRecord_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queued message.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_dls_Link_t link;                                 ///< Link in a message list
+    le_result_t   result;                               ///< Result of the sending function
+    int           token;                                ///< Delivery token
+    int           qos;                                  ///< QoS
+    bool          retain;                               ///< Retain flag
+    uint32_t      spoolId;                              ///< Spool the message comes from, 0 if none
+    uint32_t      spoolOffset;                          ///< Offset of the spool record
+    size_t        payloadLen;                           ///< Payload size
+    char          topic[PUBQUEUE_MAX_TOPIC_LEN + 1];    ///< Topic
+    uint8_t       payload[PUBQUEUE_MAX_PAYLOAD_BYTES];  ///< Payload
+}
+Message_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Publish queue.
+ */
+//--------------------------------------------------------------------------------------------------
+struct pubQueue
+{
+    le_mutex_Ref_t      mutex;              ///< Lock of the queue
+    pubQueue_SendFunc_t sendFunc;           ///< Sending function
+    void*               contextPtr;         ///< Context of the sending function
+    le_dls_List_t       pendingList;        ///< Messages waiting to be sent
+    le_dls_List_t       sendingList;        ///< Messages being sent by the publish thread
+    le_dls_List_t       inFlightList;       ///< Messages waiting for acknowledgement
+    size_t              pendingCount;       ///< Number of messages in the pending list
+    size_t              inFlightCount;      ///< QoS 1 and 2 messages in flight or being sent
+    size_t              sendingCount;       ///< QoS 1 and 2 messages being sent
+    size_t              size;               ///< Maximum number of messages held in memory
+    size_t              window;             ///< Maximum number of QoS 1 and 2 messages in flight
+    bool                connected;          ///< Session connected
+    uint32_t            connectCount;       ///< Number of connections, to detect a reconnection
+    bool                scheduled;          ///< Sending queued to the publish thread
+    bool                deleted;            ///< Queue being deleted
+    int                 earlyTokens[PUBQUEUE_MAX_WINDOW]; ///< Acknowledged while being sent
+    size_t              earlyTokenCount;    ///< Number of early tokens
+    int                 spoolFd;            ///< Spool file, -1 if none
+    uint32_t            spoolId;            ///< Identifier of the spool file opened last
+    uint32_t            spoolReadOffset;    ///< Next record to load in memory
+    uint32_t            spoolAckOffset;     ///< Read offset saved in the spool file
+    uint32_t            spoolWriteOffset;   ///< End of the spool file
+    size_t              spoolCount;         ///< Number of records not loaded in memory
+    le_sem_Ref_t        deleteSem;          ///< Posted when the publish thread releases the queue
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pools of queues and messages.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t QueuePool;
+static le_mem_PoolRef_t MessagePool;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Publish thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_thread_Ref_t PublishThreadRef;
+
+static void SendPending(void* param1Ptr, void* param2Ptr);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queue the sending of the pending messages to the publish thread. The queue lock must be held.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Schedule
+(
+    pubQueue_Ref_t queueRef
+)
+{
+    if ((!queueRef->scheduled) && (!queueRef->deleted) && (queueRef->connected))
+    {
+        queueRef->scheduled = true;
+        le_event_QueueFunctionToThread(PublishThreadRef, SendPending, queueRef, NULL);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Put messages back at the head of the pending list, in their order. The queue lock must be held.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Requeue
+(
+    pubQueue_Ref_t queueRef,
+    le_dls_List_t* listPtr      ///< [IN] Messages to requeue, emptied
+)
+{
+    le_dls_Link_t* linkPtr;
+
+    while (NULL != (linkPtr = le_dls_PopTail(listPtr)))
+    {
+        le_dls_Stack(&queueRef->pendingList, linkPtr);
+        queueRef->pendingCount++;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release the messages of a list.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReleaseMessages
+(
+    le_dls_List_t* listPtr
+)
+{
+    le_dls_Link_t* linkPtr;
+
+    while (NULL != (linkPtr = le_dls_Pop(listPtr)))
+    {
+        le_mem_Release(CONTAINER_OF(linkPtr, Message_t, link));
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write the spool file header.
+ *
+ * @return LE_OK on success, LE_FAULT otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t WriteSpoolHeader
+(
+    int      fd,
+    uint32_t readOffset
+)
+{
+    SpoolHeader_t header;
+
+    memcpy(header.magic, SPOOL_MAGIC, sizeof(header.magic));
+    header.readOffset = readOffset;
+
+    if (sizeof(header) != pwrite(fd, &header, sizeof(header), 0))
+    {
+        LE_ERROR("Cannot write spool header (%m)");
+        return LE_FAULT;
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open a spool file and count the messages not sent yet. A truncated last record is dropped.
+ *
+ * @return LE_OK on success, LE_FAULT otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t OpenSpool
+(
+    pubQueue_Ref_t queueRef,
+    const char*    pathPtr
+)
+{
+    SpoolHeader_t header;
+    SpoolRecord_t record;
+    struct stat st;
+    uint32_t offset;
+    size_t count = 0;
+
+    int fd = open(pathPtr, O_RDWR | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (-1 == fd)
+    {
+        LE_ERROR("Cannot open spool %s (%m)", pathPtr);
+        return LE_FAULT;
+    }
+
+    if ((-1 == fstat(fd, &st)) || (st.st_size > UINT32_MAX))
+    {
+        LE_ERROR("Invalid spool %s", pathPtr);
+        close(fd);
+        return LE_FAULT;
+    }
+
+    if ((st.st_size < (off_t)sizeof(header))
+        || (sizeof(header) != pread(fd, &header, sizeof(header), 0))
+        || (0 != memcmp(header.magic, SPOOL_MAGIC, sizeof(header.magic)))
+        || (header.readOffset < sizeof(header)) || (header.readOffset > (uint64_t)st.st_size))
+    {
+        if (st.st_size > 0)
+        {
+            LE_WARN("Invalid spool %s, discarded", pathPtr);
+        }
+        if ((-1 == ftruncate(fd, 0)) || (LE_OK != WriteSpoolHeader(fd, sizeof(header))))
+        {
+            close(fd);
+            return LE_FAULT;
+        }
+        header.readOffset = sizeof(header);
+        st.st_size = sizeof(header);
+    }
+
+    for (offset = header.readOffset;
+         (offset + sizeof(record) <= (uint64_t)st.st_size)
+         && (sizeof(record) == pread(fd, &record, sizeof(record), offset))
+         && (offset + sizeof(record) + record.topicLen + record.payloadLen
+             <= (uint64_t)st.st_size);
+         offset += sizeof(record) + record.topicLen + record.payloadLen)
+    {
+        count++;
+    }
+
+    if ((offset != (uint64_t)st.st_size) && (-1 == ftruncate(fd, offset)))
+    {
+        LE_ERROR("Cannot truncate spool %s (%m)", pathPtr);
+        close(fd);
+        return LE_FAULT;
+    }
+
+    queueRef->spoolFd = fd;
+    queueRef->spoolId++;
+    queueRef->spoolReadOffset = header.readOffset;
+    queueRef->spoolAckOffset = header.readOffset;
+    queueRef->spoolWriteOffset = offset;
+    queueRef->spoolCount = count;
+
+    LE_INFO("Spool %s: %zu messages to replay", pathPtr, count);
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close the spool file. The messages loaded from it are now only in memory.
+ * The queue lock must be held.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CloseSpool
+(
+    pubQueue_Ref_t queueRef
+)
+{
+    if (-1 == queueRef->spoolFd)
+    {
+        return;
+    }
+
+    close(queueRef->spoolFd);
+    queueRef->spoolFd = -1;
+    queueRef->spoolCount = 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a message to the spool file. The queue lock must be held.
+ *
+ * @return LE_OK on success, LE_NO_MEMORY otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t AppendToSpool
+(
+    pubQueue_Ref_t queueRef,
+    const char*    topicPtr,
+    size_t         topicLen,
+    const uint8_t* payloadPtr,
+    size_t         payloadLen,
+    int            qos,
+    bool           retain
+)
+{
+    SpoolRecord_t record =
+    {
+        .topicLen = topicLen,
+        .payloadLen = payloadLen,
+        .qos = qos,
+        .retain = retain,
+    };
+    struct iovec iov[] =
+    {
+        { .iov_base = &record,            .iov_len = sizeof(record) },
+        { .iov_base = (char*)topicPtr,    .iov_len = topicLen },
+        { .iov_base = (uint8_t*)payloadPtr, .iov_len = payloadLen },
+    };
+    size_t recordSize = sizeof(record) + topicLen + payloadLen;
+
+    if ((uint64_t)queueRef->spoolWriteOffset + recordSize > UINT32_MAX)
+    {
+        LE_WARN("Spool full");
+        return LE_NO_MEMORY;
+    }
+
+    if (recordSize != pwritev(queueRef->spoolFd, iov, NUM_ARRAY_MEMBERS(iov),
+                              queueRef->spoolWriteOffset))
+    {
+        LE_ERROR("Cannot write spool (%m)");
+        // Drop a partial record
+        if (-1 == ftruncate(queueRef->spoolFd, queueRef->spoolWriteOffset))
+        {
+            LE_ERROR("Cannot truncate spool (%m)");
+        }
+        return LE_NO_MEMORY;
+    }
+
+    queueRef->spoolWriteOffset += recordSize;
+    queueRef->spoolCount++;
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Load spooled messages in memory, while there is room. The queue lock must be held.
+ */
+//--------------------------------------------------------------------------------------------------
+static void LoadFromSpool
+(
+    pubQueue_Ref_t queueRef
+)
+{
+    while ((queueRef->spoolCount > 0) && (queueRef->pendingCount < queueRef->size))
+    {
+        SpoolRecord_t record;
+        uint32_t offset = queueRef->spoolReadOffset;
+
+        if ((sizeof(record) != pread(queueRef->spoolFd, &record, sizeof(record), offset))
+            || (record.topicLen > PUBQUEUE_MAX_TOPIC_LEN)
+            || (record.payloadLen > PUBQUEUE_MAX_PAYLOAD_BYTES))
+        {
+            LE_ERROR("Corrupted spool, %zu messages lost", queueRef->spoolCount);
+            queueRef->spoolCount = 0;
+            queueRef->spoolReadOffset = queueRef->spoolWriteOffset;
+            break;
+        }
+
+        Message_t* msgPtr = le_mem_ForceAlloc(MessagePool);
+        struct iovec iov[] =
+        {
+            { .iov_base = msgPtr->topic,   .iov_len = record.topicLen },
+            { .iov_base = msgPtr->payload, .iov_len = record.payloadLen },
+        };
+        size_t dataSize = record.topicLen + record.payloadLen;
+
+        offset += sizeof(record);
+        if (dataSize != preadv(queueRef->spoolFd, iov, NUM_ARRAY_MEMBERS(iov), offset))
+        {
+            LE_ERROR("Corrupted spool, %zu messages lost", queueRef->spoolCount);
+            le_mem_Release(msgPtr);
+            queueRef->spoolCount = 0;
+            queueRef->spoolReadOffset = queueRef->spoolWriteOffset;
+            break;
+        }
+
+        msgPtr->link = LE_DLS_LINK_INIT;
+        msgPtr->topic[record.topicLen] = '\0';
+        msgPtr->payloadLen = record.payloadLen;
+        msgPtr->qos = record.qos;
+        msgPtr->retain = record.retain;
+        msgPtr->spoolId = queueRef->spoolId;
+        msgPtr->spoolOffset = queueRef->spoolReadOffset;
+
+        le_dls_Queue(&queueRef->pendingList, &msgPtr->link);
+        queueRef->pendingCount++;
+        queueRef->spoolCount--;
+        queueRef->spoolReadOffset = offset + dataSize;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record in the spool file that the spooled messages are acknowledged up to the first one still
+ * held in memory, and empty the file once all of them are. Must be called after spooled messages
+ * are released. The queue lock must be held.
+ */
+//--------------------------------------------------------------------------------------------------
+static void UpdateSpoolAck
+(
+    pubQueue_Ref_t queueRef
+)
+{
+    le_dls_List_t* lists[] =
+    {
+        &queueRef->pendingList, &queueRef->sendingList, &queueRef->inFlightList
+    };
+    uint32_t ackOffset = queueRef->spoolReadOffset;
+    le_dls_Link_t* linkPtr;
+    size_t i;
+
+    if (-1 == queueRef->spoolFd)
+    {
+        return;
+    }
+
+    // The messages loaded from the spool and not released yet are not acknowledged
+    for (i = 0; i < NUM_ARRAY_MEMBERS(lists); i++)
+    {
+        for (linkPtr = le_dls_Peek(lists[i]); NULL != linkPtr;
+             linkPtr = le_dls_PeekNext(lists[i], linkPtr))
+        {
+            Message_t* msgPtr = CONTAINER_OF(linkPtr, Message_t, link);
+
+            if ((msgPtr->spoolId == queueRef->spoolId) && (msgPtr->spoolOffset < ackOffset))
+            {
+                ackOffset = msgPtr->spoolOffset;
+            }
+        }
+    }
+
+    if (ackOffset <= queueRef->spoolAckOffset)
+    {
+        return;
+    }
+
+    queueRef->spoolAckOffset = ackOffset;
+
+    if ((0 == queueRef->spoolCount) && (ackOffset == queueRef->spoolWriteOffset))
+    {
+        // Everything is acknowledged: start again from an empty spool
+        queueRef->spoolReadOffset = sizeof(SpoolHeader_t);
+        queueRef->spoolAckOffset = sizeof(SpoolHeader_t);
+        queueRef->spoolWriteOffset = sizeof(SpoolHeader_t);
+        if (-1 == ftruncate(queueRef->spoolFd, sizeof(SpoolHeader_t)))
+        {
+            LE_ERROR("Cannot truncate spool (%m)");
+        }
+    }
+
+    WriteSpoolHeader(queueRef->spoolFd, queueRef->spoolAckOffset);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move the next messages to send to a batch, within the in-flight window. The queue lock must be
+ * held.
+ *
+ * @return The number of messages in the batch.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t TakeBatch
+(
+    pubQueue_Ref_t queueRef,
+    le_dls_List_t* batchListPtr,    ///< [OUT] Messages to send
+    uint32_t*      connectCountPtr  ///< [OUT] Connection the messages are sent in
+)
+{
+    size_t count = 0;
+
+    if ((queueRef->deleted) || (!queueRef->connected))
+    {
+        return 0;
+    }
+
+    LoadFromSpool(queueRef);
+    *connectCountPtr = queueRef->connectCount;
+
+    while (count < BATCH_MAX_COUNT)
+    {
+        le_dls_Link_t* linkPtr = le_dls_Peek(&queueRef->pendingList);
+
+        if (NULL == linkPtr)
+        {
+            break;
+        }
+
+        Message_t* msgPtr = CONTAINER_OF(linkPtr, Message_t, link);
+
+        if (msgPtr->qos > 0)
+        {
+            if (queueRef->inFlightCount >= queueRef->window)
+            {
+                break;
+            }
+            queueRef->inFlightCount++;
+            queueRef->sendingCount++;
+        }
+
+        le_dls_Pop(&queueRef->pendingList);
+        queueRef->pendingCount--;
+        le_dls_Queue(batchListPtr, linkPtr);
+        count++;
+    }
+
+    return count;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether an acknowledgement arrived while the message was being sent, and forget it.
+ * The queue lock must be held.
+ *
+ * @return true if the message is already acknowledged.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool TakeEarlyToken
+(
+    pubQueue_Ref_t queueRef,
+    int            token
+)
+{
+    size_t i;
+
+    for (i = 0; i < queueRef->earlyTokenCount; i++)
+    {
+        if (queueRef->earlyTokens[i] == token)
+        {
+            queueRef->earlyTokens[i] = queueRef->earlyTokens[--queueRef->earlyTokenCount];
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Dispatch the messages of a sent batch according to the result of their sending. The queue lock
+ * must be held.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ProcessBatch
+(
+    pubQueue_Ref_t queueRef,
+    le_dls_List_t* batchListPtr,    ///< [IN] Sent messages, emptied
+    uint32_t       connectCount     ///< [IN] Connection the messages were sent in
+)
+{
+    le_dls_List_t requeueList = LE_DLS_LIST_INIT;
+    le_dls_Link_t* linkPtr;
+
+    while (NULL != (linkPtr = le_dls_Pop(batchListPtr)))
+    {
+        Message_t* msgPtr = CONTAINER_OF(linkPtr, Message_t, link);
+
+        if (msgPtr->qos > 0)
+        {
+            queueRef->sendingCount--;
+        }
+
+        if (LE_NOT_POSSIBLE == msgPtr->result)
+        {
+            // Not sent: the message keeps its place at the head of the queue
+            if (msgPtr->qos > 0)
+            {
+                queueRef->inFlightCount--;
+            }
+            // Unless the session has reconnected meanwhile, wait for the next connection
+            if (queueRef->connectCount == connectCount)
+            {
+                queueRef->connected = false;
+            }
+            le_dls_Queue(&requeueList, linkPtr);
+            continue;
+        }
+
+        if (LE_OK != msgPtr->result)
+        {
+            LE_WARN("Message on topic '%s' dropped (%s)", msgPtr->topic,
+                    LE_RESULT_TXT(msgPtr->result));
+            if (msgPtr->qos > 0)
+            {
+                queueRef->inFlightCount--;
+            }
+            le_mem_Release(msgPtr);
+        }
+        else if (0 == msgPtr->qos)
+        {
+            le_mem_Release(msgPtr);
+        }
+        else if (TakeEarlyToken(queueRef, msgPtr->token))
+        {
+            queueRef->inFlightCount--;
+            le_mem_Release(msgPtr);
+        }
+        else
+        {
+            le_dls_Queue(&queueRef->inFlightList, linkPtr);
+        }
+    }
+
+    Requeue(queueRef, &requeueList);
+    UpdateSpoolAck(queueRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send a batch of pending messages, on the publish thread. The sending is queued again while
+ * there are messages to send, so that the queues are served in turn.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SendPending
+(
+    void* param1Ptr,
+    void* param2Ptr
+)
+{
+    pubQueue_Ref_t queueRef = param1Ptr;
+    le_dls_List_t* batchListPtr = &queueRef->sendingList;
+    le_dls_Link_t* linkPtr;
+    le_result_t result = LE_OK;
+    uint32_t connectCount;
+
+    le_mutex_Lock(queueRef->mutex);
+    queueRef->scheduled = false;
+
+    if (0 == TakeBatch(queueRef, batchListPtr, &connectCount))
+    {
+        le_mutex_Unlock(queueRef->mutex);
+        return;
+    }
+
+    le_mutex_Unlock(queueRef->mutex);
+
+    // The messages following a failure because of the connection are not even tried
+    for (linkPtr = le_dls_Peek(batchListPtr); NULL != linkPtr;
+         linkPtr = le_dls_PeekNext(batchListPtr, linkPtr))
+    {
+        Message_t* msgPtr = CONTAINER_OF(linkPtr, Message_t, link);
+
+        if (LE_NOT_POSSIBLE != result)
+        {
+            result = queueRef->sendFunc(queueRef->contextPtr, msgPtr->topic, msgPtr->payload,
+                                        msgPtr->payloadLen, msgPtr->qos, msgPtr->retain,
+                                        &msgPtr->token);
+        }
+        msgPtr->result = result;
+    }
+
+    le_mutex_Lock(queueRef->mutex);
+    ProcessBatch(queueRef, batchListPtr, connectCount);
+    Schedule(queueRef);
+    le_mutex_Unlock(queueRef->mutex);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Let the deleting thread release a queue, on the publish thread: no sending is in progress and
+ * none is queued anymore.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReleaseQueue
+(
+    void* param1Ptr,
+    void* param2Ptr
+)
+{
+    pubQueue_Ref_t queueRef = param1Ptr;
+
+    le_sem_Post(queueRef->deleteSem);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Publish thread main function.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* PublishThread
+(
+    void* contextPtr
+)
+{
+    le_event_RunLoop();
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the module and start the publish thread. Must be called once before any other
+ * function.
+ */
+//--------------------------------------------------------------------------------------------------
+void pubQueue_Init
+(
+    void
+)
+{
+    QueuePool = le_mem_CreatePool("MqttPubQueue", sizeof(struct pubQueue));
+    MessagePool = le_mem_CreatePool("MqttPubMessage", sizeof(Message_t));
+
+    PublishThreadRef = le_thread_Create("MqttPublish", PublishThread, NULL);
+    le_thread_Start(PublishThreadRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a queue, with the default size and window, without spool. The queue starts disconnected.
+ *
+ * @return The queue reference.
+ */
+//--------------------------------------------------------------------------------------------------
+pubQueue_Ref_t pubQueue_Create
+(
+    pubQueue_SendFunc_t sendFunc,   ///< [IN] Function sending the messages
+    void*               contextPtr  ///< [IN] Context given to the sending function
+)
+{
+    pubQueue_Ref_t queueRef = le_mem_ForceAlloc(QueuePool);
+
+    memset(queueRef, 0, sizeof(struct pubQueue));
+    queueRef->mutex = le_mutex_CreateNonRecursive("MqttPubQueue");
+    queueRef->deleteSem = le_sem_Create("MqttPubQueueDelete", 0);
+    queueRef->sendFunc = sendFunc;
+    queueRef->contextPtr = contextPtr;
+    queueRef->pendingList = LE_DLS_LIST_INIT;
+    queueRef->sendingList = LE_DLS_LIST_INIT;
+    queueRef->inFlightList = LE_DLS_LIST_INIT;
+    queueRef->size = PUBQUEUE_DEFAULT_SIZE;
+    queueRef->window = PUBQUEUE_DEFAULT_WINDOW;
+    queueRef->spoolFd = -1;
+
+    return queueRef;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete a queue and its queued messages. The spool file is kept. Once this function returns, the
+ * sending function is not called anymore for this queue.
+ */
+//--------------------------------------------------------------------------------------------------
+void pubQueue_Delete
+(
+    pubQueue_Ref_t queueRef     ///< [IN] Queue
+)
+{
+    le_dls_List_t* lists[] = { &queueRef->pendingList, &queueRef->inFlightList };
+    size_t i;
+
+    // No sending is queued after this point: release the queue after the ones already queued
+    le_mutex_Lock(queueRef->mutex);
+    queueRef->deleted = true;
+    le_mutex_Unlock(queueRef->mutex);
+
+    le_event_QueueFunctionToThread(PublishThreadRef, ReleaseQueue, queueRef, NULL);
+    le_sem_Wait(queueRef->deleteSem);
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(lists); i++)
+    {
+        ReleaseMessages(lists[i]);
+    }
+
+    CloseSpool(queueRef);
+    le_sem_Delete(queueRef->deleteSem);
+    le_mutex_Delete(queueRef->mutex);
+    le_mem_Release(queueRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Configure a queue.
+ *
+ * @return
+ *      - LE_OK             The queue is configured
+ *      - LE_BAD_PARAMETER  The size or window is out of range
+ *      - LE_FAULT          The spool file cannot be opened
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pubQueue_Configure
+(
+    pubQueue_Ref_t queueRef,    ///< [IN] Queue
+    size_t         size,        ///< [IN] Maximum number of messages held in memory
+    size_t         window,      ///< [IN] Maximum number of unacknowledged QoS 1 and 2 messages
+    const char*    spoolPathPtr ///< [IN] Spool file, NULL or empty for none
+)
+{
+    le_result_t result = LE_OK;
+
+    if ((0 == size) || (0 == window) || (window > PUBQUEUE_MAX_WINDOW))
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    le_mutex_Lock(queueRef->mutex);
+
+    queueRef->size = size;
+    queueRef->window = window;
+
+    CloseSpool(queueRef);
+    if ((NULL != spoolPathPtr) && ('\0' != spoolPathPtr[0]))
+    {
+        result = OpenSpool(queueRef, spoolPathPtr);
+    }
+
+    Schedule(queueRef);
+    le_mutex_Unlock(queueRef->mutex);
+
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queue a message.
+ *
+ * @return
+ *      - LE_OK             The message is queued or spooled
+ *      - LE_BAD_PARAMETER  The topic or payload is too long, or the QoS is invalid
+ *      - LE_NO_MEMORY      The queue is full and the message cannot be spooled
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pubQueue_Publish
+(
+    pubQueue_Ref_t queueRef,    ///< [IN] Queue
+    const char*    topicPtr,    ///< [IN] Topic
+    const uint8_t* payloadPtr,  ///< [IN] Payload
+    size_t         payloadLen,  ///< [IN] Payload size
+    int            qos,         ///< [IN] QoS, from 0 to 2
+    bool           retain       ///< [IN] Retain flag
+)
+{
+    size_t topicLen = strnlen(topicPtr, PUBQUEUE_MAX_TOPIC_LEN + 1);
+    le_result_t result = LE_OK;
+
+    if ((topicLen > PUBQUEUE_MAX_TOPIC_LEN) || (payloadLen > PUBQUEUE_MAX_PAYLOAD_BYTES)
+        || (qos < 0) || (qos > 2))
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    le_mutex_Lock(queueRef->mutex);
+
+    // Once a message is spooled, the next QoS 1 and 2 messages follow it there to keep their order
+    if ((qos > 0) && (-1 != queueRef->spoolFd)
+        && ((queueRef->spoolCount > 0) || (queueRef->pendingCount >= queueRef->size)))
+    {
+        result = AppendToSpool(queueRef, topicPtr, topicLen, payloadPtr, payloadLen, qos, retain);
+    }
+    else if (queueRef->pendingCount >= queueRef->size)
+    {
+        result = LE_NO_MEMORY;
+    }
+    else
+    {
+        Message_t* msgPtr = le_mem_ForceAlloc(MessagePool);
+
+        msgPtr->link = LE_DLS_LINK_INIT;
+        memcpy(msgPtr->topic, topicPtr, topicLen);
+        msgPtr->topic[topicLen] = '\0';
+        memcpy(msgPtr->payload, payloadPtr, payloadLen);
+        msgPtr->payloadLen = payloadLen;
+        msgPtr->qos = qos;
+        msgPtr->retain = retain;
+        msgPtr->spoolId = 0;
+
+        le_dls_Queue(&queueRef->pendingList, &msgPtr->link);
+        queueRef->pendingCount++;
+    }
+
+    if (LE_OK == result)
+    {
+        Schedule(queueRef);
+    }
+
+    le_mutex_Unlock(queueRef->mutex);
+
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Report the connection state of the session. Messages are sent only while connected.
+ */
+//--------------------------------------------------------------------------------------------------
+void pubQueue_SetConnected
+(
+    pubQueue_Ref_t queueRef,    ///< [IN] Queue
+    bool           connected    ///< [IN] Connection state
+)
+{
+    le_mutex_Lock(queueRef->mutex);
+    if ((connected) && (!queueRef->connected))
+    {
+        queueRef->connectCount++;
+    }
+    queueRef->connected = connected;
+    Schedule(queueRef);
+    le_mutex_Unlock(queueRef->mutex);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send again the unacknowledged messages, when the broker session they were sent in is lost.
+ */
+//--------------------------------------------------------------------------------------------------
+void pubQueue_RequeueInFlight
+(
+    pubQueue_Ref_t queueRef     ///< [IN] Queue
+)
+{
+    le_mutex_Lock(queueRef->mutex);
+
+    queueRef->inFlightCount -= le_dls_NumLinks(&queueRef->inFlightList);
+    Requeue(queueRef, &queueRef->inFlightList);
+    queueRef->earlyTokenCount = 0;
+
+    Schedule(queueRef);
+    le_mutex_Unlock(queueRef->mutex);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Report the acknowledgement of a QoS 1 or 2 message by the broker.
+ */
+//--------------------------------------------------------------------------------------------------
+void pubQueue_Delivered
+(
+    pubQueue_Ref_t queueRef,    ///< [IN] Queue
+    int            token        ///< [IN] Delivery token set by the sending function
+)
+{
+    le_dls_Link_t* linkPtr;
+
+    le_mutex_Lock(queueRef->mutex);
+
+    for (linkPtr = le_dls_Peek(&queueRef->inFlightList); NULL != linkPtr;
+         linkPtr = le_dls_PeekNext(&queueRef->inFlightList, linkPtr))
+    {
+        Message_t* msgPtr = CONTAINER_OF(linkPtr, Message_t, link);
+
+        if (msgPtr->token == token)
+        {
+            le_dls_Remove(&queueRef->inFlightList, linkPtr);
+            le_mem_Release(msgPtr);
+            queueRef->inFlightCount--;
+            UpdateSpoolAck(queueRef);
+            Schedule(queueRef);
+            break;
+        }
+    }
+
+    // The acknowledgement may come before the sending function returns the token
+    if ((NULL == linkPtr) && (queueRef->sendingCount > 0)
+        && (queueRef->earlyTokenCount < PUBQUEUE_MAX_WINDOW))
+    {
+        queueRef->earlyTokens[queueRef->earlyTokenCount++] = token;
+    }
+
+    le_mutex_Unlock(queueRef->mutex);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of messages in a queue.
+ */
+//--------------------------------------------------------------------------------------------------
+void pubQueue_GetCounts
+(
+    pubQueue_Ref_t queueRef,    ///< [IN]  Queue
+    size_t*        pendingPtr,  ///< [OUT] Messages waiting to be sent, may be NULL
+    size_t*        inFlightPtr, ///< [OUT] Messages waiting for acknowledgement, may be NULL
+    size_t*        spooledPtr   ///< [OUT] Messages in the spool file, may be NULL
+)
+{
+    le_mutex_Lock(queueRef->mutex);
+
+    if (NULL != pendingPtr)
+    {
+        *pendingPtr = queueRef->pendingCount;
+    }
+    if (NULL != inFlightPtr)
+    {
+        *inFlightPtr = queueRef->inFlightCount;
+    }
+    if (NULL != spooledPtr)
+    {
+        *spooledPtr = queueRef->spoolCount;
+    }
+
+    le_mutex_Unlock(queueRef->mutex);
+}
@@ -0,0 +1,192 @@
+/**
+ * @file publishQueue.h
+ *
+ * Asynchronous MQTT publish pipeline.
+ *
+ * Messages published by the clients are queued in memory and sent by a dedicated publish thread,
+ * so that the service event loop never waits for the network. Each queue:
+ *  - holds a bounded number of messages, kept while the session is disconnected and sent in order
+ *    once it is connected again;
+ *  - limits the number of QoS 1 and 2 messages sent but not yet acknowledged by the broker;
+ *  - optionally spills QoS 1 and 2 messages to a spool file when full. The spool survives a
+ *    restart of the service and is replayed once the session is connected. A spooled message
+ *    stays in the spool until the broker acknowledges it. QoS 0 messages are never spooled.
+ *
+ * All the functions are thread safe.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#ifndef LEGATO_MQTT_PUBLISH_QUEUE_INCLUDE_GUARD
+#define LEGATO_MQTT_PUBLISH_QUEUE_INCLUDE_GUARD
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum topic length and payload size of a queued message.
+ */
+//--------------------------------------------------------------------------------------------------
+#define PUBQUEUE_MAX_TOPIC_LEN          1024
+#define PUBQUEUE_MAX_PAYLOAD_BYTES      1024
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Default queue size and in-flight window.
+ */
+//--------------------------------------------------------------------------------------------------
+#define PUBQUEUE_DEFAULT_SIZE           64
+#define PUBQUEUE_DEFAULT_WINDOW         10
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum in-flight window.
+ */
+//--------------------------------------------------------------------------------------------------
+#define PUBQUEUE_MAX_WINDOW             64
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reference to a publish queue.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct pubQueue* pubQueue_Ref_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function sending a message to the broker, called on the publish thread.
+ *
+ * @return
+ *      - LE_OK             The message is sent. For QoS 1 and 2, the delivery token is set.
+ *      - LE_NOT_POSSIBLE   The session is disconnected: the message is sent again on reconnection.
+ *      - Other codes       The message is rejected and dropped.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef le_result_t (*pubQueue_SendFunc_t)
+(
+    void*          contextPtr,  ///< [IN]  Context given to pubQueue_Create()
+    const char*    topicPtr,    ///< [IN]  Topic
+    const uint8_t* payloadPtr,  ///< [IN]  Payload
+    size_t         payloadLen,  ///< [IN]  Payload size
+    int            qos,         ///< [IN]  QoS, from 0 to 2
+    bool           retain,      ///< [IN]  Retain flag
+    int*           tokenPtr     ///< [OUT] Delivery token, for QoS 1 and 2
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the module and start the publish thread. Must be called once before any other
+ * function.
+ */
+//--------------------------------------------------------------------------------------------------
+void pubQueue_Init
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a queue, with the default size and window, without spool. The queue starts disconnected.
+ *
+ * @return The queue reference.
+ */
+//--------------------------------------------------------------------------------------------------
+pubQueue_Ref_t pubQueue_Create
+(
+    pubQueue_SendFunc_t sendFunc,   ///< [IN] Function sending the messages
+    void*               contextPtr  ///< [IN] Context given to the sending function
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete a queue and its queued messages. The spool file is kept. Once this function returns, the
+ * sending function is not called anymore for this queue.
+ */
+//--------------------------------------------------------------------------------------------------
+void pubQueue_Delete
+(
+    pubQueue_Ref_t queueRef     ///< [IN] Queue
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Configure a queue.
+ *
+ * @return
+ *      - LE_OK             The queue is configured
+ *      - LE_BAD_PARAMETER  The size or window is out of range
+ *      - LE_FAULT          The spool file cannot be opened
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pubQueue_Configure
+(
+    pubQueue_Ref_t queueRef,    ///< [IN] Queue
+    size_t         size,        ///< [IN] Maximum number of messages held in memory
+    size_t         window,      ///< [IN] Maximum number of unacknowledged QoS 1 and 2 messages
+    const char*    spoolPathPtr ///< [IN] Spool file, NULL or empty for none
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queue a message.
+ *
+ * @return
+ *      - LE_OK             The message is queued or spooled
+ *      - LE_BAD_PARAMETER  The topic or payload is too long, or the QoS is invalid
+ *      - LE_NO_MEMORY      The queue is full and the message cannot be spooled
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pubQueue_Publish
+(
+    pubQueue_Ref_t queueRef,    ///< [IN] Queue
+    const char*    topicPtr,    ///< [IN] Topic
+    const uint8_t* payloadPtr,  ///< [IN] Payload
+    size_t         payloadLen,  ///< [IN] Payload size
+    int            qos,         ///< [IN] QoS, from 0 to 2
+    bool           retain       ///< [IN] Retain flag
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Report the connection state of the session. Messages are sent only while connected.
+ */
+//--------------------------------------------------------------------------------------------------
+void pubQueue_SetConnected
+(
+    pubQueue_Ref_t queueRef,    ///< [IN] Queue
+    bool           connected    ///< [IN] Connection state
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send again the unacknowledged messages, when the broker session they were sent in is lost.
+ */
+//--------------------------------------------------------------------------------------------------
+void pubQueue_RequeueInFlight
+(
+    pubQueue_Ref_t queueRef     ///< [IN] Queue
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Report the acknowledgement of a QoS 1 or 2 message by the broker.
+ */
+//--------------------------------------------------------------------------------------------------
+void pubQueue_Delivered
+(
+    pubQueue_Ref_t queueRef,    ///< [IN] Queue
+    int            token        ///< [IN] Delivery token set by the sending function
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of messages in a queue.
+ */
+//--------------------------------------------------------------------------------------------------
+void pubQueue_GetCounts
+(
+    pubQueue_Ref_t queueRef,    ///< [IN]  Queue
+    size_t*        pendingPtr,  ///< [OUT] Messages waiting to be sent, may be NULL
+    size_t*        inFlightPtr, ///< [OUT] Messages waiting for acknowledgement, may be NULL
+    size_t*        spooledPtr   ///< [OUT] Messages in the spool file, may be NULL
+);
+
+#endif // LEGATO_MQTT_PUBLISH_QUEUE_INCLUDE_GUARD
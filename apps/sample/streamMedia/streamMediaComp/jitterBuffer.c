@@ -0,0 +1,497 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file jitterBuffer.c
+ *
+ * Implementation of the adaptive jitter buffer.
+ *
+ * The frames are stored in a ring of slots indexed by sequence number, so that the buffered frames
+ * always lie within JITTERBUFFER_MAX_FRAMES sequence numbers from the next frame to play out.
+ *
+ * The buffer fills up until it holds the target depth, then plays out one frame per call:
+ *  - when the next frame is missing and the buffer is empty, the delay grows: the missing frame is
+ *    concealed and expected again at the next call;
+ *  - when the next frame is missing and the buffer holds at least the target depth, the frame is
+ *    considered lost: it is concealed and skipped;
+ *  - when the buffer holds more than the target depth plus a margin, the delay shrinks: one frame
+ *    is skipped.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "jitterBuffer.h"
+
+#include <pthread.h>
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of buffers pre-allocated.
+ */
+//--------------------------------------------------------------------------------------------------
+#define BUFFER_POOL_SIZE        1
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Ratio between the target buffering delay and the interarrival jitter.
+ */
+//--------------------------------------------------------------------------------------------------
+#define JITTER_FACTOR           3
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum target depth, in frames.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_TARGET_DEPTH        (JITTERBUFFER_MAX_FRAMES / 2)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of frames above the target depth tolerated before shrinking the buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SHRINK_MARGIN           2
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of consecutive frames concealed by repeating the last played frame, before silence.
+ */
+//--------------------------------------------------------------------------------------------------
+#define PLC_MAX_FRAMES          4
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Frame slot.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    bool     valid;                                 ///< A frame is stored
+    uint16_t size;                                  ///< Frame size, in bytes
+    uint8_t  data[JITTERBUFFER_MAX_FRAME_BYTES];    ///< Frame
+}
+Slot_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Jitter buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+struct jitterBuffer
+{
+    pthread_mutex_t mutex;                          ///< Protects the buffer
+    uint32_t        clockRate;                      ///< RTP clock rate, in Hz
+    uint32_t        frameSamples;                   ///< Number of samples per frame
+    Slot_t          slots[JITTERBUFFER_MAX_FRAMES]; ///< Frames, indexed by sequence number
+    uint32_t        count;                          ///< Number of frames stored
+    bool            started;                        ///< A frame has been received
+    bool            playing;                        ///< The buffer is playing out
+    bool            playedOut;                      ///< A frame has been played out
+    uint16_t        nextSeq;                        ///< Sequence number of the next frame to play
+    uint16_t        highSeq;                        ///< Highest sequence number received
+    bool            hasTransit;                     ///< lastTransit is set
+    int32_t         lastTransit;                    ///< Relative transit time of the last frame
+    int32_t         jitterQ4;                       ///< Estimated jitter, in 1/16 timestamp unit
+    uint32_t        targetDepth;                    ///< Number of frames targeted
+    uint32_t        concealRun;                     ///< Number of consecutive frames concealed
+    uint16_t        lastSize;                       ///< Size of the last frame played
+    uint8_t         lastFrame[JITTERBUFFER_MAX_FRAME_BYTES]; ///< Last frame played
+    uint32_t        lateCount;                      ///< Packets received too late
+    uint32_t        lostCount;                      ///< Frames missing at their playout time
+    uint32_t        concealedCount;                 ///< Frames concealed
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool of jitter buffers.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t BufferPool;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the slot of a sequence number.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline Slot_t* GetSlot
+(
+    jitterBuffer_Ref_t bufferRef,   ///< [IN] Buffer
+    uint16_t           seq          ///< [IN] Sequence number
+)
+{
+    return &bufferRef->slots[seq % JITTERBUFFER_MAX_FRAMES];
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Drop the buffered frames and fill the buffer up again from the next received frame.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Flush
+(
+    jitterBuffer_Ref_t bufferRef    ///< [IN] Buffer
+)
+{
+    int i;
+
+    for (i = 0; i < JITTERBUFFER_MAX_FRAMES; i++)
+    {
+        bufferRef->slots[i].valid = false;
+    }
+
+    bufferRef->count = 0;
+    bufferRef->started = false;
+    bufferRef->playing = false;
+    bufferRef->playedOut = false;
+    bufferRef->concealRun = 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute the target depth from the estimated jitter.
+ */
+//--------------------------------------------------------------------------------------------------
+static void UpdateTarget
+(
+    jitterBuffer_Ref_t bufferRef    ///< [IN] Buffer
+)
+{
+    uint32_t jitter = (uint32_t)(bufferRef->jitterQ4 >> 4);
+    uint32_t target;
+
+    target = 1 + (JITTER_FACTOR * jitter + bufferRef->frameSamples - 1) / bufferRef->frameSamples;
+    bufferRef->targetDepth = (target > MAX_TARGET_DEPTH) ? MAX_TARGET_DEPTH : target;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Update the interarrival jitter estimation with a received frame, as described in RFC-3550
+ * section 6.4.1.
+ */
+//--------------------------------------------------------------------------------------------------
+static void UpdateJitter
+(
+    jitterBuffer_Ref_t bufferRef,   ///< [IN] Buffer
+    uint32_t           timestamp,   ///< [IN] RTP timestamp
+    uint64_t           arrivalUs    ///< [IN] Arrival time, in microseconds
+)
+{
+    uint32_t arrival = (uint32_t)(arrivalUs * bufferRef->clockRate / 1000000);
+    int32_t transit = (int32_t)(arrival - timestamp);
+
+    if (bufferRef->hasTransit)
+    {
+        int32_t delta = transit - bufferRef->lastTransit;
+
+        if (delta < 0)
+        {
+            delta = -delta;
+        }
+        // A timestamp jump is a new stream, not jitter.
+        if (delta > (int32_t)bufferRef->clockRate)
+        {
+            delta = bufferRef->clockRate;
+        }
+
+        bufferRef->jitterQ4 += delta - ((bufferRef->jitterQ4 + 8) >> 4);
+    }
+
+    bufferRef->lastTransit = transit;
+    bufferRef->hasTransit = true;
+
+    UpdateTarget(bufferRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Conceal a missing frame: repeat the last played frame with a decreasing gain, then play silence.
+ *
+ * @return The frame size in bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t Conceal
+(
+    jitterBuffer_Ref_t bufferRef,   ///< [IN]  Buffer
+    uint8_t*           framePtr,    ///< [OUT] Frame
+    size_t             frameSize    ///< [IN]  Frame buffer size, in bytes
+)
+{
+    size_t size = (0 != bufferRef->lastSize) ? bufferRef->lastSize :
+                                               bufferRef->frameSamples * sizeof(int16_t);
+    size_t i;
+
+    if (size > frameSize)
+    {
+        size = frameSize;
+    }
+
+    bufferRef->concealRun++;
+    bufferRef->concealedCount++;
+
+    if ((0 == bufferRef->lastSize) || (bufferRef->concealRun > PLC_MAX_FRAMES))
+    {
+        memset(framePtr, 0, size);
+        return size;
+    }
+
+    int32_t gain = PLC_MAX_FRAMES + 1 - bufferRef->concealRun;
+
+    for (i = 0; i + sizeof(int16_t) <= size; i += sizeof(int16_t))
+    {
+        int16_t sample;
+
+        memcpy(&sample, &bufferRef->lastFrame[i], sizeof(sample));
+        sample = (int16_t)(sample * gain / (PLC_MAX_FRAMES + 1));
+        memcpy(&framePtr[i], &sample, sizeof(sample));
+    }
+
+    return size;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the module. Must be called once before any other function.
+ */
+//--------------------------------------------------------------------------------------------------
+void jitterBuffer_Init
+(
+    void
+)
+{
+    BufferPool = le_mem_CreatePool("JitterBufferPool", sizeof(struct jitterBuffer));
+    le_mem_ExpandPool(BufferPool, BUFFER_POOL_SIZE);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create an empty jitter buffer.
+ *
+ * @return The buffer reference.
+ */
+//--------------------------------------------------------------------------------------------------
+jitterBuffer_Ref_t jitterBuffer_Create
+(
+    uint32_t clockRate,     ///< [IN] RTP clock rate, in Hz
+    uint32_t frameSamples   ///< [IN] Number of samples per frame
+)
+{
+    jitterBuffer_Ref_t bufferRef = le_mem_ForceAlloc(BufferPool);
+
+    memset(bufferRef, 0, sizeof(struct jitterBuffer));
+    LE_FATAL_IF(0 != pthread_mutex_init(&bufferRef->mutex, NULL), "Cannot create mutex");
+    bufferRef->clockRate = clockRate;
+    bufferRef->frameSamples = frameSamples;
+
+    jitterBuffer_Reset(bufferRef);
+
+    return bufferRef;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete a jitter buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+void jitterBuffer_Delete
+(
+    jitterBuffer_Ref_t bufferRef    ///< [IN] Buffer
+)
+{
+    pthread_mutex_destroy(&bufferRef->mutex);
+    le_mem_Release(bufferRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Empty a jitter buffer and reset its jitter estimation and statistics, before a new stream.
+ */
+//--------------------------------------------------------------------------------------------------
+void jitterBuffer_Reset
+(
+    jitterBuffer_Ref_t bufferRef    ///< [IN] Buffer
+)
+{
+    pthread_mutex_lock(&bufferRef->mutex);
+
+    Flush(bufferRef);
+    bufferRef->hasTransit = false;
+    bufferRef->jitterQ4 = 0;
+    bufferRef->lastSize = 0;
+    bufferRef->lateCount = 0;
+    bufferRef->lostCount = 0;
+    bufferRef->concealedCount = 0;
+    UpdateTarget(bufferRef);
+
+    pthread_mutex_unlock(&bufferRef->mutex);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Put a received frame in a jitter buffer. Duplicated and late frames are dropped.
+ */
+//--------------------------------------------------------------------------------------------------
+void jitterBuffer_Put
+(
+    jitterBuffer_Ref_t bufferRef,   ///< [IN] Buffer
+    uint16_t           seq,         ///< [IN] RTP sequence number
+    uint32_t           timestamp,   ///< [IN] RTP timestamp
+    uint64_t           arrivalUs,   ///< [IN] Arrival time, in microseconds
+    const uint8_t*     framePtr,    ///< [IN] Frame
+    size_t             frameSize    ///< [IN] Frame size, in bytes
+)
+{
+    if (frameSize > JITTERBUFFER_MAX_FRAME_BYTES)
+    {
+        LE_ERROR("Frame too large: %zu bytes", frameSize);
+        return;
+    }
+
+    pthread_mutex_lock(&bufferRef->mutex);
+
+    UpdateJitter(bufferRef, timestamp, arrivalUs);
+
+    if (!bufferRef->started)
+    {
+        bufferRef->started = true;
+        bufferRef->nextSeq = seq;
+        bufferRef->highSeq = seq;
+    }
+
+    int16_t offset = (int16_t)(seq - bufferRef->nextSeq);
+
+    if (offset < 0)
+    {
+        // Until the first frame is played out, an earlier frame becomes the first one to play.
+        if (bufferRef->playedOut ||
+            ((uint16_t)(bufferRef->highSeq - seq) >= JITTERBUFFER_MAX_FRAMES))
+        {
+            bufferRef->lateCount++;
+            pthread_mutex_unlock(&bufferRef->mutex);
+            return;
+        }
+        bufferRef->nextSeq = seq;
+    }
+    else if (offset >= JITTERBUFFER_MAX_FRAMES)
+    {
+        // The sender restarted or a long burst of frames was lost: start over from this frame.
+        Flush(bufferRef);
+        bufferRef->started = true;
+        bufferRef->nextSeq = seq;
+        bufferRef->highSeq = seq;
+    }
+
+    if ((int16_t)(seq - bufferRef->highSeq) > 0)
+    {
+        bufferRef->highSeq = seq;
+    }
+
+    Slot_t* slotPtr = GetSlot(bufferRef, seq);
+
+    // The slots hold distinct sequence numbers: a valid slot is a duplicated frame.
+    if (!slotPtr->valid)
+    {
+        memcpy(slotPtr->data, framePtr, frameSize);
+        slotPtr->size = frameSize;
+        slotPtr->valid = true;
+        bufferRef->count++;
+    }
+
+    pthread_mutex_unlock(&bufferRef->mutex);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the next frame to play out. Must be called once per frame duration.
+ *
+ * @return The frame size in bytes, or 0 if nothing is to be played out yet because the buffer is
+ *         filling up.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t jitterBuffer_Get
+(
+    jitterBuffer_Ref_t bufferRef,   ///< [IN]  Buffer
+    uint8_t*           framePtr,    ///< [OUT] Frame
+    size_t             frameSize    ///< [IN]  Frame buffer size, in bytes
+)
+{
+    size_t size = 0;
+
+    pthread_mutex_lock(&bufferRef->mutex);
+
+    if (!bufferRef->playing)
+    {
+        if ((0 == bufferRef->count) || (bufferRef->count < bufferRef->targetDepth))
+        {
+            pthread_mutex_unlock(&bufferRef->mutex);
+            return 0;
+        }
+        bufferRef->playing = true;
+        bufferRef->concealRun = 0;
+    }
+
+    Slot_t* slotPtr = GetSlot(bufferRef, bufferRef->nextSeq);
+
+    if (slotPtr->valid && (bufferRef->count > bufferRef->targetDepth + SHRINK_MARGIN))
+    {
+        slotPtr->valid = false;
+        bufferRef->count--;
+        bufferRef->nextSeq++;
+        slotPtr = GetSlot(bufferRef, bufferRef->nextSeq);
+    }
+
+    if (slotPtr->valid)
+    {
+        size = (slotPtr->size > frameSize) ? frameSize : slotPtr->size;
+        memcpy(framePtr, slotPtr->data, size);
+        memcpy(bufferRef->lastFrame, slotPtr->data, slotPtr->size);
+        bufferRef->lastSize = slotPtr->size;
+
+        slotPtr->valid = false;
+        bufferRef->count--;
+        bufferRef->nextSeq++;
+        bufferRef->playedOut = true;
+        bufferRef->concealRun = 0;
+    }
+    else if ((0 == bufferRef->count) && (bufferRef->concealRun >= PLC_MAX_FRAMES))
+    {
+        // The stream stalled: fill the buffer up again before resuming.
+        bufferRef->playing = false;
+    }
+    else
+    {
+        if (bufferRef->count >= bufferRef->targetDepth)
+        {
+            bufferRef->lostCount++;
+            bufferRef->nextSeq++;
+            bufferRef->playedOut = true;
+        }
+
+        size = Conceal(bufferRef, framePtr, frameSize);
+    }
+
+    pthread_mutex_unlock(&bufferRef->mutex);
+
+    return size;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the statistics of a jitter buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+void jitterBuffer_GetStats
+(
+    jitterBuffer_Ref_t    bufferRef,    ///< [IN]  Buffer
+    jitterBuffer_Stats_t* statsPtr      ///< [OUT] Statistics
+)
+{
+    pthread_mutex_lock(&bufferRef->mutex);
+
+    statsPtr->depth = bufferRef->count;
+    statsPtr->targetDepth = bufferRef->targetDepth;
+    statsPtr->lateCount = bufferRef->lateCount;
+    statsPtr->lostCount = bufferRef->lostCount;
+    statsPtr->concealedCount = bufferRef->concealedCount;
+
+    pthread_mutex_unlock(&bufferRef->mutex);
+}
@@ -0,0 +1,145 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file jitterBuffer.h
+ *
+ * Adaptive jitter buffer for the received RTP audio frames.
+ *
+ * The received frames are stored by sequence number and played out at a fixed cadence, one frame
+ * per call to jitterBuffer_Get(), so that reordered packets are played in order and network jitter
+ * does not interrupt the audio. The buffer depth targeted before playing out follows the
+ * interarrival jitter, estimated from the received packets as described in RFC-3550.
+ *
+ * A frame missing at its playout time is concealed by repeating the last played frame with a
+ * decreasing gain, then by silence.
+ *
+ * The buffer is protected by a POSIX mutex rather than a Legato one, since the frames are put by
+ * the PJSIP worker thread, which is not a Legato thread.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#ifndef LEGATO_STREAMMEDIA_JITTER_BUFFER_INCLUDE_GUARD
+#define LEGATO_STREAMMEDIA_JITTER_BUFFER_INCLUDE_GUARD
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum size of a frame, in bytes. The frames are 16 bits linear PCM samples.
+ */
+//--------------------------------------------------------------------------------------------------
+#define JITTERBUFFER_MAX_FRAME_BYTES    1280
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of frames held by a buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+#define JITTERBUFFER_MAX_FRAMES         64
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reference to a jitter buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct jitterBuffer* jitterBuffer_Ref_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Jitter buffer statistics, reset by jitterBuffer_Reset().
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t depth;         ///< Number of frames currently buffered
+    uint32_t targetDepth;   ///< Number of frames targeted
+    uint32_t lateCount;     ///< Packets received after their playout time, and dropped
+    uint32_t lostCount;     ///< Frames missing at their playout time, whether late or never received
+    uint32_t concealedCount;///< Frames played out by the packet loss concealment
+}
+jitterBuffer_Stats_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the module. Must be called once before any other function.
+ */
+//--------------------------------------------------------------------------------------------------
+void jitterBuffer_Init
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create an empty jitter buffer.
+ *
+ * @return The buffer reference.
+ */
+//--------------------------------------------------------------------------------------------------
+jitterBuffer_Ref_t jitterBuffer_Create
+(
+    uint32_t clockRate,     ///< [IN] RTP clock rate, in Hz
+    uint32_t frameSamples   ///< [IN] Number of samples per frame
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete a jitter buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+void jitterBuffer_Delete
+(
+    jitterBuffer_Ref_t bufferRef    ///< [IN] Buffer
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Empty a jitter buffer and reset its jitter estimation and statistics, before a new stream.
+ */
+//--------------------------------------------------------------------------------------------------
+void jitterBuffer_Reset
+(
+    jitterBuffer_Ref_t bufferRef    ///< [IN] Buffer
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Put a received frame in a jitter buffer. Duplicated and late frames are dropped.
+ */
+//--------------------------------------------------------------------------------------------------
+void jitterBuffer_Put
+(
+    jitterBuffer_Ref_t bufferRef,   ///< [IN] Buffer
+    uint16_t           seq,         ///< [IN] RTP sequence number
+    uint32_t           timestamp,   ///< [IN] RTP timestamp
+    uint64_t           arrivalUs,   ///< [IN] Arrival time, in microseconds
+    const uint8_t*     framePtr,    ///< [IN] Frame
+    size_t             frameSize    ///< [IN] Frame size, in bytes
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the next frame to play out. Must be called once per frame duration.
+ *
+ * @return The frame size in bytes, or 0 if nothing is to be played out yet because the buffer is
+ *         filling up.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t jitterBuffer_Get
+(
+    jitterBuffer_Ref_t bufferRef,   ///< [IN]  Buffer
+    uint8_t*           framePtr,    ///< [OUT] Frame
+    size_t             frameSize    ///< [IN]  Frame buffer size, in bytes
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the statistics of a jitter buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+void jitterBuffer_GetStats
+(
+    jitterBuffer_Ref_t    bufferRef,    ///< [IN]  Buffer
+    jitterBuffer_Stats_t* statsPtr      ///< [OUT] Statistics
+);
+
+#endif // LEGATO_STREAMMEDIA_JITTER_BUFFER_INCLUDE_GUARD
@@ -24,6 +24,7 @@
 #include "pjlib-util.h"
 #include "pjlib.h"
 #include "pjsip.h"
+#include "jitterBuffer.h"
 
 //--------------------------------------------------------------------------------------------------
 // Symbol and Enum definitions.
@@ -76,6 +77,14 @@
 #define STREAMMEDIA_BITS_PER_SAMPLE 16
 #define STREAMMEDIA_SAMPLE_PER_FRAME 160
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Duration of a frame, in nanoseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+#define STREAMMEDIA_FRAME_NSEC \
+    ((int64_t)STREAMMEDIA_SAMPLE_PER_FRAME * 1000000000 / STREAMMEDIA_CLOCK_RATE)
+
 //--------------------------------------------------------------------------------------------------
 /**
  * RTP session variables. These variables should be allocated dynamically when connecting a RTP
@@ -108,6 +117,10 @@ typedef struct
                                                 // stream.
 
     le_thread_Ref_t         TransmitRtpThreadRef; // Transmission RTP thread, sends audio samples.
+    le_thread_Ref_t         PlayoutRtpThreadRef; // Playout RTP thread, writes the received audio
+                                                // samples to the reception pipe.
+
+    jitterBuffer_Ref_t      jitterBufferRef;    // Jitter buffer of the received audio samples.
 
     bool                    isInit;             // True when the RTP sockets are created.
     bool                    rxOn;               // True when reception is ON, e.g. the received
@@ -194,11 +207,63 @@ static void* TransmitRtpSamplesThread
     return NULL;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Playout thread.
+ * Every frame duration, this thread writes the next audio sample from the jitter buffer into the
+ * reception pipe. This pipe is read by the audio player that is connected to another audio
+ * interface.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void* PlayoutRtpSamplesThread
+(
+    void* contextPtr
+)
+{
+    uint8_t         data[MAX_AUDIO_SAMPLE_SIZE];
+    size_t          size;
+    struct timespec deadline;
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+
+    while (1)
+    {
+        // Play out on absolute deadlines, so that the cadence does not drift with the time spent
+        // writing to the pipe.
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL);
+
+        size = jitterBuffer_Get(RtpSession.jitterBufferRef, data, sizeof(data));
+        if ((size > 0) && (write(RtpSession.rxPipefd[1], data, size) < 0))
+        {
+            LE_ERROR("Cannot write in Alsa reception pipe %d. err %m", RtpSession.rxPipefd[1]);
+        }
+
+        deadline.tv_nsec += STREAMMEDIA_FRAME_NSEC;
+        if (deadline.tv_nsec >= 1000000000)
+        {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000;
+        }
+
+        // Do not try to catch up after the pipe blocked for more than a frame.
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        if ((now.tv_sec > deadline.tv_sec) ||
+            ((now.tv_sec == deadline.tv_sec) && (now.tv_nsec > deadline.tv_nsec)))
+        {
+            deadline = now;
+        }
+    }
+
+    return NULL;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * RTP reception handler function.
- * This function decodes the RTP header from the received packet and writes the audio sample into
- * a pipe. This pipe is read by the audio player that is connected to another audio interface.
+ * This function decodes the RTP header from the received packet and puts the audio sample into
+ * the jitter buffer, played out by the playout thread.
  *
  */
 //--------------------------------------------------------------------------------------------------
@@ -229,10 +294,15 @@ static void OnRxRtp
         return;
     }
 
-    if ( write(RtpSession.rxPipefd[1], (char*)payloadPtr, payloadLen) < 0 )
-    {
-        LE_ERROR("Cannot write in Alsa reception pipe %d. err %m", RtpSession.rxPipefd[1]);
-    }
+    le_clk_Time_t now = le_clk_GetRelativeTime();
+    pj_uint16_t seq = pj_ntohs(headerPtr->seq);
+    pj_uint32_t timestamp = pj_ntohl(headerPtr->ts);
+
+    // Update the reception statistics reported by RTCP.
+    pjmedia_rtcp_rx_rtp(&RtpSession.pjRtcpSess, seq, timestamp, payloadLen);
+
+    jitterBuffer_Put(RtpSession.jitterBufferRef, seq, timestamp,
+                     (uint64_t)now.sec * 1000000 + now.usec, payloadPtr, payloadLen);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -320,6 +390,25 @@ static void FirstLayerStreamEventHandler
                       le_event_GetContextPtr());
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stop the playout thread, if it is running.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void StopPlayout
+(
+    void
+)
+{
+    if (NULL != RtpSession.PlayoutRtpThreadRef)
+    {
+        le_thread_Cancel(RtpSession.PlayoutRtpThreadRef);
+        le_thread_Join(RtpSession.PlayoutRtpThreadRef, NULL);
+        RtpSession.PlayoutRtpThreadRef = NULL;
+    }
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function initializes a RTP session.
@@ -597,6 +686,44 @@ void streamMedia_RemoveRtcpHandler
     le_event_RemoveHandler((le_event_HandlerRef_t)handlerRef);
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the jitter buffer statistics of the RTP reception stream.
+ *
+ * @return LE_FAULT         The stream is not a RTP reception stream.
+ * @return LE_OK            Function succeeded.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t streamMedia_GetJitterStats
+(
+    le_audio_StreamRef_t streamRef,         ///< [IN]  Audio stream reference.
+    uint32_t*            depthMsPtr,        ///< [OUT] Buffered audio, in milliseconds.
+    uint32_t*            targetDepthMsPtr,  ///< [OUT] Targeted buffered audio, in milliseconds.
+    uint32_t*            lateCountPtr,      ///< [OUT] Packets received after their playout time.
+    uint32_t*            lostCountPtr,      ///< [OUT] Packets missing at their playout time.
+    uint32_t*            concealedCountPtr  ///< [OUT] Frames played out by the loss concealment.
+)
+{
+    jitterBuffer_Stats_t stats;
+    const uint32_t frameMs = STREAMMEDIA_SAMPLE_PER_FRAME * 1000 / STREAMMEDIA_CLOCK_RATE;
+
+    if ((NULL == streamRef) || (streamRef != RtpSession.receptionPlayerRef))
+    {
+        LE_ERROR("Invalid reference (%p) provided!", streamRef);
+        return LE_FAULT;
+    }
+
+    jitterBuffer_GetStats(RtpSession.jitterBufferRef, &stats);
+
+    *depthMsPtr = stats.depth * frameMs;
+    *targetDepthMsPtr = stats.targetDepth * frameMs;
+    *lateCountPtr = stats.lateCount;
+    *lostCountPtr = stats.lostCount;
+    *concealedCountPtr = stats.concealedCount;
+
+    return LE_OK;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Open the received audio stream of a RTP session.
@@ -698,6 +825,14 @@ le_result_t streamMedia_Start
             LE_ERROR("Cannot start RTP reception : cannot play samples.");
             return LE_FAULT;
         }
+        // Start playout thread that writes the audio samples from the jitter buffer to the
+        // reception pipe.
+        jitterBuffer_Reset(RtpSession.jitterBufferRef);
+        StopPlayout();
+        RtpSession.PlayoutRtpThreadRef = le_thread_Create("PlayoutSamples",
+                                                          PlayoutRtpSamplesThread, streamRef);
+        le_thread_SetJoinable(RtpSession.PlayoutRtpThreadRef);
+        le_thread_Start(RtpSession.PlayoutRtpThreadRef);
         RtpSession.rxOn = true;
     }
     else if (streamRef == RtpSession.transmissionRecorderRef)
@@ -742,6 +877,7 @@ le_result_t streamMedia_Stop
     {
         LE_DEBUG("Stop RTP Reception.");
         RtpSession.rxOn = false;
+        StopPlayout();
         if (LE_OK != le_audio_Stop(streamRef))
         {
             LE_ERROR("Cannot stop RTP Reception");
@@ -783,6 +919,7 @@ void streamMedia_Close
     if (streamRef == RtpSession.receptionPlayerRef)
     {
         RtpSession.rxOn = false;
+        StopPlayout();
 
         le_audio_Close(streamRef);
 
@@ -861,4 +998,8 @@ COMPONENT_INIT
     LE_INFO("Starting streamMedia");
 
     RtpSession.isInit = false;
+
+    jitterBuffer_Init();
+    RtpSession.jitterBufferRef = jitterBuffer_Create(STREAMMEDIA_CLOCK_RATE,
+                                                     STREAMMEDIA_SAMPLE_PER_FRAME);
 }
@@ -0,0 +1,262 @@
+/**
+ * This module tests the AT pattern matcher and benchmarks it against the linear scan of the
+ * pattern list, over a recorded modem transcript.
+ *
+ * Usage: atMatcherBench <transcript>
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "atMatcher.h"
+
+#include <time.h>
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of transcript lines and line length.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_LINES           256
+#define MAX_LINE_BYTES      256
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of passes over the transcript for the benchmark.
+ */
+//--------------------------------------------------------------------------------------------------
+#define PASS_COUNT          2000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Patterns subscribed by a typical set of services: unsolicited and final responses.
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* const Patterns[] =
+{
+    "+CREG:", "+CGREG:", "+CEREG:", "+C5GREG:", "+CGEV:", "+CMTI:", "+CMT:", "+CDS:", "+CDSI:",
+    "+CBM:", "+CBMI:", "+CIEV:", "+CLIP:", "+CRING:", "RING", "+CCWA:", "+CUSD:", "+CUSATP:",
+    "+CUSATEND", "+STKPCI:", "+CTZV:", "+CTZE:", "+CSCON:", "+CESQ:", "+CSQ:", "+COPS:",
+    "+CPIN:", "+QIND:", "+WIND:", "^SYSSTART", "+PACSP", "+CMGR:", "+CGDCONT:", "+CCLK:",
+    "+CGATT:", "OK", "ERROR", "+CME ERROR:", "+CMS ERROR:", "NO CARRIER", "BUSY", "NO ANSWER",
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Transcript lines.
+ */
+//--------------------------------------------------------------------------------------------------
+static char Lines[MAX_LINES][MAX_LINE_BYTES];
+static size_t LineCount;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the current time in microseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t GetTimeUs
+(
+    void
+)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Match a line against the pattern list one pattern at a time, as done without matcher.
+ *
+ * @return The number of matching patterns.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t LinearMatch
+(
+    const char* linePtr,
+    size_t      lineSize
+)
+{
+    uint32_t count = 0;
+    size_t i;
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(Patterns); i++)
+    {
+        if ((lineSize >= strlen(Patterns[i])) &&
+            (strncmp(Patterns[i], linePtr, strlen(Patterns[i])) == 0))
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record the order of the matching values.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RecordMatch
+(
+    void* valuePtr,
+    void* contextPtr
+)
+{
+    char* orderPtr = contextPtr;
+    char value[2] = { (char)(intptr_t)valuePtr, '\0' };
+
+    strcat(orderPtr, value);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Load the transcript.
+ */
+//--------------------------------------------------------------------------------------------------
+static void LoadTranscript
+(
+    const char* pathPtr
+)
+{
+    FILE* filePtr = fopen(pathPtr, "r");
+
+    LE_TEST_ASSERT(NULL != filePtr, "Transcript %s opened", pathPtr);
+
+    while ((LineCount < MAX_LINES) && (NULL != fgets(Lines[LineCount], MAX_LINE_BYTES, filePtr)))
+    {
+        Lines[LineCount][strcspn(Lines[LineCount], "\r\n")] = '\0';
+        LineCount++;
+    }
+
+    fclose(filePtr);
+
+    LE_TEST_ASSERT(LineCount > 0, "%zu lines in the transcript", LineCount);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test the matcher semantics.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestMatcher
+(
+    void
+)
+{
+    atMatcher_Ref_t matcherRef = atMatcher_Create();
+    char order[16] = {0};
+
+    LE_TEST_OK(0 == atMatcher_Match(matcherRef, "OK", 2, NULL, NULL), "Empty matcher");
+
+    atMatcher_Add(matcherRef, "+CREG:", (void*)'a');
+    atMatcher_Add(matcherRef, "+C", (void*)'b');
+    atMatcher_Add(matcherRef, "+CREG:", (void*)'c');
+    atMatcher_Add(matcherRef, "+CGREG:", (void*)'d');
+
+    LE_TEST_OK((3 == atMatcher_Match(matcherRef, "+CREG: 1", 8, RecordMatch, order)) &&
+               (0 == strcmp(order, "bac")), "Shorter patterns first, then adding order: %s",
+               order);
+    LE_TEST_OK(1 == atMatcher_Match(matcherRef, "+CREG: 1", 4, NULL, NULL),
+               "Line size is honoured");
+    LE_TEST_OK(0 == atMatcher_Match(matcherRef, "+", 1, NULL, NULL), "No partial match");
+
+    atMatcher_Add(matcherRef, "", (void*)'e');
+    LE_TEST_OK(1 == atMatcher_Match(matcherRef, "OK", 2, NULL, NULL),
+               "Empty pattern matches every line");
+    LE_TEST_OK(1 == atMatcher_Match(matcherRef, "", 0, NULL, NULL),
+               "Empty pattern matches an empty line");
+
+    atMatcher_Clear(matcherRef);
+    LE_TEST_OK(0 == atMatcher_Match(matcherRef, "+CREG: 1", 8, NULL, NULL), "Matcher cleared");
+
+    atMatcher_Delete(matcherRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check the matcher against the linear scan, then time both.
+ */
+//--------------------------------------------------------------------------------------------------
+static void BenchTranscript
+(
+    void
+)
+{
+    atMatcher_Ref_t matcherRef = atMatcher_Create();
+    size_t lineSizes[MAX_LINES];
+    uint32_t linearCount = 0;
+    uint32_t matcherCount = 0;
+    bool identical = true;
+    size_t i;
+    int pass;
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(Patterns); i++)
+    {
+        atMatcher_Add(matcherRef, Patterns[i], (void*)Patterns[i]);
+    }
+
+    for (i = 0; i < LineCount; i++)
+    {
+        lineSizes[i] = strlen(Lines[i]);
+        if (LinearMatch(Lines[i], lineSizes[i]) !=
+            atMatcher_Match(matcherRef, Lines[i], lineSizes[i], NULL, NULL))
+        {
+            LE_TEST_INFO("Mismatch on line '%s'", Lines[i]);
+            identical = false;
+        }
+    }
+    LE_TEST_OK(identical, "Matcher and linear scan agree on every line");
+
+    uint64_t startUs = GetTimeUs();
+    for (pass = 0; pass < PASS_COUNT; pass++)
+    {
+        for (i = 0; i < LineCount; i++)
+        {
+            linearCount += LinearMatch(Lines[i], lineSizes[i]);
+        }
+    }
+    uint64_t linearUs = GetTimeUs() - startUs;
+
+    startUs = GetTimeUs();
+    for (pass = 0; pass < PASS_COUNT; pass++)
+    {
+        for (i = 0; i < LineCount; i++)
+        {
+            matcherCount += atMatcher_Match(matcherRef, Lines[i], lineSizes[i], NULL, NULL);
+        }
+    }
+    uint64_t matcherUs = GetTimeUs() - startUs;
+
+    LE_TEST_OK(linearCount == matcherCount, "Same number of matches: %" PRIu32, matcherCount);
+
+    uint64_t totalLines = (uint64_t)PASS_COUNT * LineCount;
+    LE_TEST_INFO("%zu patterns, %" PRIu64 " lines: linear scan %" PRIu64 " ns/line, "
+                 "matcher %" PRIu64 " ns/line", NUM_ARRAY_MEMBERS(Patterns), totalLines,
+                 linearUs * 1000 / totalLines, matcherUs * 1000 / totalLines);
+
+    atMatcher_Delete(matcherRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * main of the test
+ */
+//--------------------------------------------------------------------------------------------------
+COMPONENT_INIT
+{
+    const char* transcriptPtr = le_arg_GetArg(0);
+
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+
+    LE_TEST_ASSERT(NULL != transcriptPtr, "Usage: atMatcherBench <transcript>");
+
+    atMatcher_Init();
+
+    LoadTranscript(transcriptPtr);
+    TestMatcher();
+    BenchTranscript();
+
+    LE_TEST_EXIT;
+}
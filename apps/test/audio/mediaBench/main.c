@@ -0,0 +1,437 @@
+/**
+ * This module checks the tone oscillators of the media threads, and measures the CPU time spent by the
+ * media thread paths per second of audio: DTMF synthesis, WAV file playback and AMR decoding.
+ *
+ * The DTMF and WAV paths are measured against the processing done before: two sin() calls per
+ * DTMF sample, and a clear of the whole buffer at each read.
+ *
+ * Usage: mediaBench <WAV file> <AMR file>
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+#include "le_audio_local.h"
+#include "pa_amr.h"
+#include "pcmKernel.h"
+
+#include <math.h>
+#include <time.h>
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * DTMF parameters, as played by le_media.
+ */
+//--------------------------------------------------------------------------------------------------
+#define DTMF_SAMPLE_RATE    16000
+#define DTMF_AMPLITUDE      (32767 * 40 / 100)
+#define DTMF_SECONDS        20
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of times the WAV file is played.
+ */
+//--------------------------------------------------------------------------------------------------
+#define WAV_PASS_COUNT      200
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Buffer size of the WAV and AMR paths, as set by le_media.
+ */
+//--------------------------------------------------------------------------------------------------
+#define WAV_BUFFER_SIZE     (16 * 1024)
+#define AMR_BUFFER_SIZE     4096
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of samples of the tone tests.
+ */
+//--------------------------------------------------------------------------------------------------
+#define KERNEL_SAMPLES      4099
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * WAV file header.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t riffId;
+    uint32_t riffSize;
+    uint32_t riffFmt;
+    uint32_t fmtId;
+    uint32_t fmtSize;
+    uint16_t audioFormat;
+    uint16_t channelsCount;
+    uint32_t sampleRate;
+    uint32_t byteRate;
+    uint16_t blockAlign;
+    uint16_t bitsPerSample;
+    uint32_t dataId;
+    uint32_t dataSize;
+}
+WavHeader_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * DTMF frequencies of the digits "0" to "9".
+ */
+//--------------------------------------------------------------------------------------------------
+static const uint32_t DtmfFreqs[][2] =
+{
+    { 941, 1336 }, { 697, 1209 }, { 697, 1336 }, { 697, 1477 }, { 770, 1209 },
+    { 770, 1336 }, { 770, 1477 }, { 852, 1209 }, { 852, 1336 }, { 852, 1477 },
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * One second of samples.
+ */
+//--------------------------------------------------------------------------------------------------
+static int16_t Samples[DTMF_SAMPLE_RATE];
+static int16_t ReferenceSamples[DTMF_SAMPLE_RATE];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the CPU time used by the process, in microseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t GetCpuTimeUs
+(
+    void
+)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get a pseudo random sample.
+ */
+//--------------------------------------------------------------------------------------------------
+static int16_t RandomSample
+(
+    void
+)
+{
+    static uint32_t seed = 1;
+
+    seed = seed * 1103515245 + 12345;
+    return (int16_t)(seed >> 16);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Synthesize one second of a DTMF the way le_media did before the tone oscillators.
+ */
+//--------------------------------------------------------------------------------------------------
+static void LegacyDtmf
+(
+    uint32_t freq1,
+    uint32_t freq2,
+    int16_t* samplesPtr
+)
+{
+    double d1 = 1.0f * freq1 / DTMF_SAMPLE_RATE;
+    double d2 = 1.0f * freq2 / DTMF_SAMPLE_RATE;
+    uint32_t i;
+
+    for (i = 0; i < DTMF_SAMPLE_RATE; i++)
+    {
+        int32_t s1 = (int16_t)(32767 * 40 / 100.0f * sin(2 * M_PI * d1 * i));
+        int32_t s2 = (int16_t)(32767 * 40 / 100.0f * sin(2 * M_PI * d2 * i));
+        int32_t sum = s1 + s2;
+
+        samplesPtr[i] = (sum > INT16_MAX) ? INT16_MAX : ((sum < INT16_MIN) ? INT16_MIN : sum);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Synthesize one second of a DTMF with the tone oscillators, as le_media does.
+ */
+//--------------------------------------------------------------------------------------------------
+static void KernelDtmf
+(
+    uint32_t freq1,
+    uint32_t freq2,
+    int16_t* samplesPtr
+)
+{
+    pcmKernel_Tone_t lowTone;
+    pcmKernel_Tone_t highTone;
+
+    pcmKernel_InitTone(&lowTone, freq1, DTMF_SAMPLE_RATE, DTMF_AMPLITUDE, 0);
+    pcmKernel_InitTone(&highTone, freq2, DTMF_SAMPLE_RATE, DTMF_AMPLITUDE, 0);
+    pcmKernel_GenerateTone(&lowTone, samplesPtr, DTMF_SAMPLE_RATE);
+    pcmKernel_AddTone(&highTone, samplesPtr, DTMF_SAMPLE_RATE);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test the tone oscillators against their sin() based definition.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestKernels
+(
+    void
+)
+{
+    static int16_t src[KERNEL_SAMPLES];
+    static int16_t dst[KERNEL_SAMPLES];
+    bool identical = true;
+    size_t i;
+
+    // Adding a tone saturates like generating it and adding it.
+    for (i = 0; i < KERNEL_SAMPLES; i++)
+    {
+        dst[i] = RandomSample();
+    }
+    dst[0] = INT16_MAX;
+    dst[1] = INT16_MIN;
+
+    pcmKernel_Tone_t tone;
+    pcmKernel_InitTone(&tone, 697, DTMF_SAMPLE_RATE, INT16_MAX, 3);
+    pcmKernel_GenerateTone(&tone, src, KERNEL_SAMPLES);
+    for (i = 0; i < KERNEL_SAMPLES; i++)
+    {
+        int32_t sum = dst[i] + src[i];
+
+        src[i] = (sum > INT16_MAX) ? INT16_MAX : ((sum < INT16_MIN) ? INT16_MIN : sum);
+    }
+    pcmKernel_InitTone(&tone, 697, DTMF_SAMPLE_RATE, INT16_MAX, 3);
+    pcmKernel_AddTone(&tone, dst, KERNEL_SAMPLES);
+    for (i = 0; i < KERNEL_SAMPLES; i++)
+    {
+        identical &= (dst[i] == src[i]);
+    }
+    LE_TEST_OK(identical, "Saturated tone mixing");
+
+    // The tone oscillator follows sin() within one unit.
+    int32_t maxError = 0;
+    pcmKernel_InitTone(&tone, 1477, DTMF_SAMPLE_RATE, DTMF_AMPLITUDE, 5);
+    pcmKernel_GenerateTone(&tone, Samples, DTMF_SAMPLE_RATE);
+    for (i = 0; i < DTMF_SAMPLE_RATE; i++)
+    {
+        int32_t error = Samples[i] -
+                        (int32_t)lrint(DTMF_AMPLITUDE * sin(2 * M_PI * 1477 * (i + 5) /
+                                                            DTMF_SAMPLE_RATE));
+        error = (error < 0) ? -error : error;
+        maxError = (error > maxError) ? error : maxError;
+    }
+    LE_TEST_OK(maxError <= 1, "Tone within %" PRId32 " of sin()", maxError);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Measure the DTMF synthesis.
+ */
+//--------------------------------------------------------------------------------------------------
+static void BenchDtmf
+(
+    void
+)
+{
+    int32_t maxError = 0;
+    uint64_t legacyUs = 0;
+    uint64_t kernelUs = 0;
+    int second;
+    size_t i;
+
+    for (second = 0; second < DTMF_SECONDS; second++)
+    {
+        const uint32_t* freqsPtr = DtmfFreqs[second % NUM_ARRAY_MEMBERS(DtmfFreqs)];
+
+        uint64_t startUs = GetCpuTimeUs();
+        LegacyDtmf(freqsPtr[0], freqsPtr[1], ReferenceSamples);
+        legacyUs += GetCpuTimeUs() - startUs;
+
+        startUs = GetCpuTimeUs();
+        KernelDtmf(freqsPtr[0], freqsPtr[1], Samples);
+        kernelUs += GetCpuTimeUs() - startUs;
+
+        for (i = 0; i < DTMF_SAMPLE_RATE; i++)
+        {
+            int32_t error = Samples[i] - ReferenceSamples[i];
+            error = (error < 0) ? -error : error;
+            maxError = (error > maxError) ? error : maxError;
+        }
+    }
+
+    // The sin() synthesis truncates its samples and computes the phase step in float, so that it
+    // drifts by a few units from the exact tone over one second.
+    LE_TEST_OK(maxError <= 8, "DTMF within %" PRId32 " of the sin() synthesis", maxError);
+    LE_TEST_INFO("DTMF at %d Hz: sin() %" PRIu64 " us, oscillators %" PRIu64
+                 " us of CPU per second of audio", DTMF_SAMPLE_RATE,
+                 legacyUs / DTMF_SECONDS, kernelUs / DTMF_SECONDS);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Play a WAV file to /dev/null the way the media thread does.
+ *
+ * @return The CPU time, in microseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t PlayWav
+(
+    int  fd,
+    int  nullFd,
+    bool clearBuffer
+)
+{
+    uint8_t buffer[WAV_BUFFER_SIZE];
+    uint64_t startUs = GetCpuTimeUs();
+    int pass;
+
+    for (pass = 0; pass < WAV_PASS_COUNT; pass++)
+    {
+        ssize_t len;
+
+        lseek(fd, sizeof(WavHeader_t), SEEK_SET);
+        do
+        {
+            if (clearBuffer)
+            {
+                memset(buffer, 0, sizeof(buffer));
+            }
+            len = read(fd, buffer, sizeof(buffer));
+            if ((len > 0) && (write(nullFd, buffer, len) != len))
+            {
+                LE_TEST_FATAL("Cannot write to /dev/null");
+            }
+        }
+        while (len > 0);
+    }
+
+    return GetCpuTimeUs() - startUs;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Measure the WAV playback.
+ */
+//--------------------------------------------------------------------------------------------------
+static void BenchWav
+(
+    const char* pathPtr
+)
+{
+    WavHeader_t hdr;
+    int fd = open(pathPtr, O_RDONLY);
+    int nullFd = open("/dev/null", O_WRONLY);
+
+    LE_TEST_ASSERT((fd >= 0) && (nullFd >= 0), "WAV file %s opened", pathPtr);
+    LE_TEST_ASSERT((read(fd, &hdr, sizeof(hdr)) == sizeof(hdr)) && (0 != hdr.byteRate),
+                   "WAV header read");
+
+    double seconds = (double)hdr.dataSize * WAV_PASS_COUNT / hdr.byteRate;
+    uint64_t clearedUs = PlayWav(fd, nullFd, true);
+    uint64_t uncleared = PlayWav(fd, nullFd, false);
+
+    close(fd);
+    close(nullFd);
+
+    LE_TEST_INFO("WAV %" PRIu32 " Hz, %u bits: cleared buffer %.1f us, uncleared buffer %.1f us "
+                 "of CPU per second of audio",
+                 hdr.sampleRate, hdr.bitsPerSample, clearedUs / seconds, uncleared / seconds);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Measure the AMR decoding by the platform decoder.
+ */
+//--------------------------------------------------------------------------------------------------
+static void BenchAmr
+(
+    const char* pathPtr
+)
+{
+    le_audio_Stream_t stream;
+    le_audio_MediaThreadContext_t mediaCtx;
+    uint8_t buffer[AMR_BUFFER_SIZE];
+    char header[10] = {0};
+    uint32_t sampleRate = 8000;
+    uint64_t decodedBytes = 0;
+    uint32_t readLen;
+    int fd = open(pathPtr, O_RDONLY);
+
+    LE_TEST_ASSERT(fd >= 0, "AMR file %s opened", pathPtr);
+
+    memset(&stream, 0, sizeof(stream));
+    memset(&mediaCtx, 0, sizeof(mediaCtx));
+    stream.fd = fd;
+    mediaCtx.fd_in = fd;
+    mediaCtx.bufferSize = sizeof(buffer);
+
+    // Skip the header, as le_media does.
+    LE_TEST_ASSERT(read(fd, header, 9) == 9, "AMR header read");
+    if (0 == strncmp(header, "#!AMR-WB\n", 9))
+    {
+        mediaCtx.format = LE_AUDIO_FILE_AMR_WB;
+        sampleRate = 16000;
+    }
+    else
+    {
+        mediaCtx.format = LE_AUDIO_FILE_AMR_NB;
+        if (0 == strncmp(header, "#!AMR\n", 6))
+        {
+            lseek(fd, -3, SEEK_CUR);
+        }
+    }
+
+    if (LE_OK != pa_amr_StartDecoder(&stream, &mediaCtx))
+    {
+        LE_TEST_INFO("No AMR decoder on this platform: AMR path not measured");
+        close(fd);
+        return;
+    }
+
+    uint64_t startUs = GetCpuTimeUs();
+    while ((LE_OK == pa_amr_DecodeFrames(&mediaCtx, buffer, &readLen)) && (0 != readLen))
+    {
+        decodedBytes += readLen;
+    }
+    uint64_t decodeUs = GetCpuTimeUs() - startUs;
+
+    pa_amr_StopDecoder(&mediaCtx);
+    close(fd);
+
+    LE_TEST_OK(decodedBytes > 0, "AMR file decoded");
+
+    double seconds = (double)decodedBytes / (sampleRate * sizeof(int16_t));
+    if (seconds > 0)
+    {
+        LE_TEST_INFO("AMR %s: %.1f us of CPU per second of audio",
+                     (16000 == sampleRate) ? "WB" : "NB", decodeUs / seconds);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * main of the test
+ */
+//--------------------------------------------------------------------------------------------------
+COMPONENT_INIT
+{
+    const char* wavPathPtr = le_arg_GetArg(0);
+    const char* amrPathPtr = le_arg_GetArg(1);
+
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+
+    LE_TEST_ASSERT((NULL != wavPathPtr) && (NULL != amrPathPtr),
+                   "Usage: mediaBench <WAV file> <AMR file>");
+
+    pcmKernel_Init();
+
+    TestKernels();
+    BenchDtmf();
+    BenchWav(wavPathPtr);
+    BenchAmr(amrPathPtr);
+
+    LE_TEST_EXIT;
+}
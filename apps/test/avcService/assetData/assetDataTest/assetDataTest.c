@@ -326,6 +326,62 @@ void RunTest(void)
     LE_TEST(LE_FAULT == assetData_client_GetString(testOneRefZero, 4, strBuf, sizeof(strBuf)));
 
 
+    banner("Field lookup by name");
+    int fieldId;
+
+    LE_TEST(LE_OK == assetData_GetFieldIdFromName(testOneRefZero, "Bedroom/temp", &fieldId));
+    LE_TEST(4 == fieldId);
+    LE_TEST(LE_OK == assetData_GetFieldIdFromName(testOneRefOne, "Bathroom/humidity", &fieldId));
+    LE_TEST(14 == fieldId);
+    LE_TEST(LE_FAULT == assetData_GetFieldIdFromName(testOneRefZero, "Garage/temp", &fieldId));
+
+
+    banner("Check/Write values as client");
+    bool bool_value;
+
+    LE_TEST(LE_OK == assetData_client_CheckValue(testOneRefZero, 8, "-25"));
+    LE_TEST(LE_FORMAT_ERROR == assetData_client_CheckValue(testOneRefZero, 8, "25C"));
+    LE_TEST(LE_FORMAT_ERROR == assetData_client_CheckValue(testOneRefZero, 8, ""));
+    LE_TEST(LE_FORMAT_ERROR == assetData_client_CheckValue(testOneRefZero, 13, "wet"));
+    LE_TEST(LE_FORMAT_ERROR == assetData_client_CheckValue(testOneRefZero, 9, "maybe"));
+    LE_TEST(LE_FAULT == assetData_client_CheckValue(testOneRefZero, 10, "1"));
+    LE_TEST(LE_NOT_FOUND == assetData_client_CheckValue(testOneRefZero, 50, "1"));
+
+    LE_TEST(LE_OK == assetData_client_SetValue(testOneRefZero, 8, "-25"));
+    LE_TEST(LE_OK == assetData_client_GetInt(testOneRefZero, 8, &value));
+    LE_TEST(-25 == value);
+
+    LE_TEST(LE_OK == assetData_client_SetValue(testOneRefZero, 9, "true"));
+    LE_TEST(LE_OK == assetData_client_GetBool(testOneRefZero, 9, &bool_value));
+    LE_TEST(bool_value);
+
+
+    banner("Batch writes with observe");
+
+    LE_TEST(LE_OK == assetData_SetObserve(testOneRefZero, true, (uint8_t*)"tok", 3));
+
+    assetData_client_StartBatch(testOneRefZero);
+    LE_TEST(LE_OK == assetData_client_SetValue(testOneRefZero, 0, "22"));
+    LE_TEST(LE_OK == assetData_client_SetValue(testOneRefZero, 12, "45.5"));
+    LE_TEST(LE_OK == assetData_client_SetValue(testOneRefZero, 14, "60.25"));
+
+    // Values are visible before the batch is committed
+    LE_TEST(LE_OK == assetData_client_GetInt(testOneRefZero, 0, &value));
+    LE_TEST(22 == value);
+    LE_TEST(LE_OK == assetData_client_CommitBatch(testOneRefZero));
+
+    LE_TEST(LE_OK == assetData_client_GetFloat(testOneRefZero, 12, &float_value));
+    LE_TEST(45.5 == float_value);
+    LE_TEST(LE_OK == assetData_client_GetFloat(testOneRefZero, 14, &float_value));
+    LE_TEST(60.25 == float_value);
+
+    // Committing an empty batch sends nothing
+    assetData_client_StartBatch(testOneRefZero);
+    LE_TEST(LE_OK == assetData_client_CommitBatch(testOneRefZero));
+
+    LE_TEST(LE_OK == assetData_SetObserve(testOneRefZero, false, NULL, 0));
+
+
     banner("Field write int handlers");
 
     LE_TEST(NULL != assetData_server_AddFieldActionHandler(testOneAssetRef, 4,
@@ -62,12 +62,15 @@ static void NotifyTimer
 )
 {
     le_avdata_AssetInstanceRef_t instZeroRef;
+    char batch[LE_AVDATA_BATCH_LEN];
 
     instZeroRef = (le_avdata_AssetInstanceRef_t) le_timer_GetContextPtr(timerRef);
 
-    le_avdata_SetInt(instZeroRef, "Speed", (int) RandBetween(0, 100));
-    le_avdata_SetFloat(instZeroRef, "InteriorTemperature", RandBetween(20, 30));
-    le_avdata_SetBool(instZeroRef, "LowFuelWarning", (bool) (rand() % 2));
+    // Update all the fields at once, so that a single notify is sent to the server.
+    snprintf(batch, sizeof(batch), "Speed=%d\nInteriorTemperature=%f\nLowFuelWarning=%d",
+             (int) RandBetween(0, 100), RandBetween(20, 30), rand() % 2);
+
+    LE_ERROR_IF(le_avdata_SetBatch(instZeroRef, batch) != LE_OK, "Failed to set the car state");
 }
 
 
@@ -8,6 +8,7 @@
 #include "legato.h"
 #include "interfaces.h"
 #include "pa_dcs.h"
+#include "dcsNetlink.h"
 
 
 //--------------------------------------------------------------------------------------------------
@@ -1625,6 +1626,55 @@ le_result_t pa_dcs_GetTimeWithNetworkTimeProtocol
     return LE_FAULT;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stub: routing netlink is not used, the routes are applied through the platform adaptor stubs
+ *
+ * @return
+ *      - LE_UNSUPPORTED    Function not supported
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t dcsNetlink_Init
+(
+    dcsNetlink_EventHandlerFunc_t handlerFunc,  ///< [IN] Notification handler
+    void*                         contextPtr    ///< [IN] Context given to the handler
+)
+{
+    return LE_UNSUPPORTED;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stub
+ *
+ * @return
+ *      - LE_UNSUPPORTED    Function not supported
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t dcsNetlink_ApplyRoutes
+(
+    const dcsNetlink_Route_t* routesPtr,    ///< [IN] Route changes
+    size_t                    count         ///< [IN] Number of changes
+)
+{
+    return LE_UNSUPPORTED;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stub
+ *
+ * @return False
+ */
+//--------------------------------------------------------------------------------------------------
+bool dcsNetlink_HasAddress
+(
+    const char* interfaceNamePtr    ///< [IN] Interface name
+)
+{
+    return false;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Start watchdogs 0..N-1.  Typically this is used in COMPONENT_INIT to start all watchdogs needed
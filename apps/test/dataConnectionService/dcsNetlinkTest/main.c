@@ -0,0 +1,527 @@
+/**
+ * This module tests the routing netlink interface of the Data Connection Service on a veth pair,
+ * in a network namespace of its own so that the routes of the host are not modified.
+ *
+ * The test is skipped when the network namespace cannot be created, i.e. when it is not run with
+ * the CAP_SYS_ADMIN capability and user namespaces are not available.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "dcsNetlink.h"
+#include <arpa/inet.h>
+#include <sched.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/veth.h>
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Interfaces of the veth pair, and their addressing.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LOCAL_INTF          "dcs0"
+#define PEER_INTF           "dcs1"
+#define LOCAL_ADDR          "10.1.0.1"
+#define LOCAL_PREFIX_LEN    24
+#define GATEWAY_ADDR        "10.1.0.2"
+#define UNREACHABLE_GATEWAY "192.168.99.1"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Time to wait for a kernel notification, in seconds.
+ */
+//--------------------------------------------------------------------------------------------------
+#define EVENT_TIMEOUT_SEC   5
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Netlink request message.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    struct nlmsghdr hdr;
+    union
+    {
+        struct ifinfomsg ifi;
+        struct ifaddrmsg ifa;
+    };
+    uint8_t attributes[256];
+}
+Request_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Notifications received on the local interface, and semaphore posted on each of them.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool EventReceived[DCSNETLINK_OVERRUN + 1];
+static le_mutex_Ref_t EventMutex;
+static le_sem_Ref_t EventSem;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Notification handler, called from the main thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static void EventHandler
+(
+    const dcsNetlink_Event_t* eventPtr,
+    void*                     contextPtr
+)
+{
+    if (0 != strcmp(eventPtr->interfaceName, LOCAL_INTF))
+    {
+        return;
+    }
+
+    le_mutex_Lock(EventMutex);
+    EventReceived[eventPtr->type] = true;
+    le_mutex_Unlock(EventMutex);
+
+    le_sem_Post(EventSem);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Forget the notifications received so far.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ClearEvents
+(
+    void
+)
+{
+    le_mutex_Lock(EventMutex);
+    memset(EventReceived, 0, sizeof(EventReceived));
+    le_mutex_Unlock(EventMutex);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Wait for a notification on the local interface.
+ *
+ * @return The time elapsed since startTime, in microseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t WaitEvent
+(
+    dcsNetlink_EventType_t type,
+    le_clk_Time_t          startTime
+)
+{
+    le_clk_Time_t timeout = { .sec = EVENT_TIMEOUT_SEC };
+    bool received;
+
+    for (;;)
+    {
+        le_mutex_Lock(EventMutex);
+        received = EventReceived[type];
+        le_mutex_Unlock(EventMutex);
+
+        if (received)
+        {
+            le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+
+            return (uint64_t)elapsed.sec * 1000000 + elapsed.usec;
+        }
+
+        LE_ASSERT_OK(le_sem_WaitWithTimeOut(EventSem, timeout));
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append an attribute to a request.
+ *
+ * @return The attribute.
+ */
+//--------------------------------------------------------------------------------------------------
+static struct rtattr* AddAttribute
+(
+    Request_t*  reqPtr,
+    uint16_t    type,
+    const void* dataPtr,
+    size_t      len
+)
+{
+    struct rtattr* rtaPtr = (struct rtattr*)((uint8_t*)reqPtr + NLMSG_ALIGN(reqPtr->hdr.nlmsg_len));
+
+    LE_ASSERT(NLMSG_ALIGN(reqPtr->hdr.nlmsg_len) + RTA_SPACE(len) <= sizeof(*reqPtr));
+
+    rtaPtr->rta_type = type;
+    rtaPtr->rta_len = RTA_LENGTH(len);
+    if (len > 0)
+    {
+        memcpy(RTA_DATA(rtaPtr), dataPtr, len);
+    }
+    reqPtr->hdr.nlmsg_len = NLMSG_ALIGN(reqPtr->hdr.nlmsg_len) + RTA_ALIGN(rtaPtr->rta_len);
+
+    return rtaPtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close a nested attribute opened with AddAttribute().
+ */
+//--------------------------------------------------------------------------------------------------
+static void EndNest
+(
+    Request_t*     reqPtr,
+    struct rtattr* nestPtr
+)
+{
+    nestPtr->rta_len = (uint8_t*)reqPtr + reqPtr->hdr.nlmsg_len - (uint8_t*)nestPtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send a request to the kernel and wait for its acknowledgement.
+ *
+ * @return 0 on success, or a negative errno.
+ */
+//--------------------------------------------------------------------------------------------------
+static int SendRequest
+(
+    Request_t* reqPtr
+)
+{
+    uint32_t buffer[1024];
+    struct nlmsghdr* hdrPtr = (struct nlmsghdr*)buffer;
+    int fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    ssize_t len;
+
+    LE_ASSERT(-1 != fd);
+
+    reqPtr->hdr.nlmsg_flags |= NLM_F_REQUEST | NLM_F_ACK;
+    LE_ASSERT(reqPtr->hdr.nlmsg_len == send(fd, reqPtr, reqPtr->hdr.nlmsg_len, 0));
+
+    len = recv(fd, buffer, sizeof(buffer), 0);
+    close(fd);
+
+    LE_ASSERT(NLMSG_OK(hdrPtr, (size_t)len) && (NLMSG_ERROR == hdrPtr->nlmsg_type));
+
+    return ((struct nlmsgerr*)NLMSG_DATA(hdrPtr))->error;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create the veth pair.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CreateVethPair
+(
+    void
+)
+{
+    Request_t req;
+    struct rtattr* linkInfoPtr;
+    struct rtattr* dataPtr;
+    struct rtattr* peerPtr;
+    struct ifinfomsg peerInfo;
+
+    memset(&req, 0, sizeof(req));
+    memset(&peerInfo, 0, sizeof(peerInfo));
+    req.hdr.nlmsg_len = NLMSG_LENGTH(sizeof(struct ifinfomsg));
+    req.hdr.nlmsg_type = RTM_NEWLINK;
+    req.hdr.nlmsg_flags = NLM_F_CREATE | NLM_F_EXCL;
+    req.ifi.ifi_family = AF_UNSPEC;
+
+    AddAttribute(&req, IFLA_IFNAME, LOCAL_INTF, sizeof(LOCAL_INTF));
+    linkInfoPtr = AddAttribute(&req, IFLA_LINKINFO, NULL, 0);
+    AddAttribute(&req, IFLA_INFO_KIND, "veth", sizeof("veth") - 1);
+    dataPtr = AddAttribute(&req, IFLA_INFO_DATA, NULL, 0);
+    peerPtr = AddAttribute(&req, VETH_INFO_PEER, &peerInfo, sizeof(peerInfo));
+    AddAttribute(&req, IFLA_IFNAME, PEER_INTF, sizeof(PEER_INTF));
+    EndNest(&req, peerPtr);
+    EndNest(&req, dataPtr);
+    EndNest(&req, linkInfoPtr);
+
+    LE_ASSERT(0 == SendRequest(&req));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Bring an interface up.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SetLinkUp
+(
+    const char* interfaceNamePtr
+)
+{
+    Request_t req;
+
+    memset(&req, 0, sizeof(req));
+    req.hdr.nlmsg_len = NLMSG_LENGTH(sizeof(struct ifinfomsg));
+    req.hdr.nlmsg_type = RTM_NEWLINK;
+    req.ifi.ifi_family = AF_UNSPEC;
+    req.ifi.ifi_index = if_nametoindex(interfaceNamePtr);
+    req.ifi.ifi_flags = IFF_UP;
+    req.ifi.ifi_change = IFF_UP;
+
+    LE_ASSERT(0 != req.ifi.ifi_index);
+    LE_ASSERT(0 == SendRequest(&req));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add or remove the address of the local interface.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ChangeLocalAddress
+(
+    bool add
+)
+{
+    Request_t req;
+    struct in_addr addr;
+
+    LE_ASSERT(1 == inet_pton(AF_INET, LOCAL_ADDR, &addr));
+
+    memset(&req, 0, sizeof(req));
+    req.hdr.nlmsg_len = NLMSG_LENGTH(sizeof(struct ifaddrmsg));
+    req.hdr.nlmsg_type = add ? RTM_NEWADDR : RTM_DELADDR;
+    req.hdr.nlmsg_flags = add ? (NLM_F_CREATE | NLM_F_EXCL) : 0;
+    req.ifa.ifa_family = AF_INET;
+    req.ifa.ifa_prefixlen = LOCAL_PREFIX_LEN;
+    req.ifa.ifa_scope = RT_SCOPE_UNIVERSE;
+    req.ifa.ifa_index = if_nametoindex(LOCAL_INTF);
+
+    AddAttribute(&req, IFA_LOCAL, &addr, sizeof(addr));
+    AddAttribute(&req, IFA_ADDRESS, &addr, sizeof(addr));
+
+    LE_ASSERT(0 == SendRequest(&req));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether an IPv4 route of the main table exists, from /proc/net/route.
+ *
+ * @return True if the route exists.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool RouteExists
+(
+    const char* destinationPtr,     ///< Destination, "0.0.0.0" for the default route
+    const char* gatewayPtr          ///< Gateway
+)
+{
+    FILE* filePtr = fopen("/proc/net/route", "r");
+    char line[256];
+    struct in_addr destination;
+    struct in_addr gateway;
+    bool found = false;
+
+    LE_ASSERT(NULL != filePtr);
+    LE_ASSERT(1 == inet_pton(AF_INET, destinationPtr, &destination));
+    LE_ASSERT(1 == inet_pton(AF_INET, gatewayPtr, &gateway));
+
+    while (!found && (NULL != fgets(line, sizeof(line), filePtr)))
+    {
+        char interfaceName[IF_NAMESIZE];
+        unsigned int lineDestination;
+        unsigned int lineGateway;
+
+        if (   (3 == sscanf(line, "%15s %x %x", interfaceName, &lineDestination, &lineGateway))
+            && (0 == strcmp(interfaceName, LOCAL_INTF))
+            && (lineDestination == destination.s_addr)
+            && (lineGateway == gateway.s_addr))
+        {
+            found = true;
+        }
+    }
+
+    fclose(filePtr);
+
+    return found;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fill a route change.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SetRoute
+(
+    dcsNetlink_Route_t*      routePtr,
+    dcsNetlink_RouteAction_t action,
+    const char*              destinationPtr,
+    const char*              gatewayPtr,
+    const char*              interfaceNamePtr
+)
+{
+    routePtr->action = action;
+    LE_ASSERT_OK(le_utf8_Copy(routePtr->destination, destinationPtr,
+                              sizeof(routePtr->destination), NULL));
+    LE_ASSERT_OK(le_utf8_Copy(routePtr->gateway, gatewayPtr, sizeof(routePtr->gateway), NULL));
+    LE_ASSERT_OK(le_utf8_Copy(routePtr->interfaceName, interfaceNamePtr,
+                              sizeof(routePtr->interfaceName), NULL));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test the link and address notifications.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestNotifications
+(
+    void
+)
+{
+    le_clk_Time_t startTime;
+
+    LE_INFO("======== Test notifications ========");
+
+    CreateVethPair();
+    LE_ASSERT(!dcsNetlink_HasAddress(LOCAL_INTF));
+
+    ClearEvents();
+    startTime = le_clk_GetRelativeTime();
+    SetLinkUp(PEER_INTF);
+    SetLinkUp(LOCAL_INTF);
+    LE_INFO("Link up notified in %" PRIu64 " us", WaitEvent(DCSNETLINK_LINK_UP, startTime));
+
+    ClearEvents();
+    startTime = le_clk_GetRelativeTime();
+    ChangeLocalAddress(true);
+    LE_INFO("Address notified in %" PRIu64 " us", WaitEvent(DCSNETLINK_ADDRESS_ADDED, startTime));
+    LE_ASSERT(dcsNetlink_HasAddress(LOCAL_INTF));
+    LE_ASSERT(!dcsNetlink_HasAddress(PEER_INTF));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test the route batches.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestRoutes
+(
+    void
+)
+{
+    dcsNetlink_Route_t routes[DCSNETLINK_MAX_ROUTES + 1];
+    le_clk_Time_t startTime;
+    le_clk_Time_t elapsed;
+    int i;
+
+    LE_INFO("======== Test routes ========");
+
+    // Default route and DNS route in one batch
+    ClearEvents();
+    startTime = le_clk_GetRelativeTime();
+    SetRoute(&routes[0], DCSNETLINK_ROUTE_REPLACE, "", GATEWAY_ADDR, LOCAL_INTF);
+    SetRoute(&routes[1], DCSNETLINK_ROUTE_ADD, "10.2.0.53", GATEWAY_ADDR, LOCAL_INTF);
+    LE_ASSERT_OK(dcsNetlink_ApplyRoutes(routes, 2));
+    LE_INFO("Route added notified in %" PRIu64 " us",
+            WaitEvent(DCSNETLINK_ROUTE_ADDED, startTime));
+    LE_ASSERT(RouteExists("0.0.0.0", GATEWAY_ADDR));
+    LE_ASSERT(RouteExists("10.2.0.53", GATEWAY_ADDR));
+
+    // Existing routes are kept
+    LE_ASSERT_OK(dcsNetlink_ApplyRoutes(routes, 2));
+
+    // A rejected change reverts the batch, but not the routes existing before
+    SetRoute(&routes[0], DCSNETLINK_ROUTE_ADD, "10.2.0.54", GATEWAY_ADDR, LOCAL_INTF);
+    SetRoute(&routes[2], DCSNETLINK_ROUTE_ADD, "10.2.0.55", UNREACHABLE_GATEWAY, LOCAL_INTF);
+    LE_ASSERT(LE_FAULT == dcsNetlink_ApplyRoutes(routes, 3));
+    LE_ASSERT(!RouteExists("10.2.0.54", GATEWAY_ADDR));
+    LE_ASSERT(RouteExists("10.2.0.53", GATEWAY_ADDR));
+    LE_ASSERT(RouteExists("0.0.0.0", GATEWAY_ADDR));
+
+    // Invalid batches are not sent
+    SetRoute(&routes[0], DCSNETLINK_ROUTE_ADD, "10.2.0.56", "fe80::1", LOCAL_INTF);
+    LE_ASSERT(LE_BAD_PARAMETER == dcsNetlink_ApplyRoutes(routes, 1));
+    SetRoute(&routes[0], DCSNETLINK_ROUTE_ADD, "10.2.0.56", GATEWAY_ADDR, "unknown0");
+    LE_ASSERT(LE_BAD_PARAMETER == dcsNetlink_ApplyRoutes(routes, 1));
+    SetRoute(&routes[0], DCSNETLINK_ROUTE_ADD, "", "", LOCAL_INTF);
+    LE_ASSERT(LE_BAD_PARAMETER == dcsNetlink_ApplyRoutes(routes, 1));
+    LE_ASSERT(LE_BAD_PARAMETER == dcsNetlink_ApplyRoutes(routes, DCSNETLINK_MAX_ROUTES + 1));
+    LE_ASSERT(!RouteExists("10.2.0.56", GATEWAY_ADDR));
+
+    // Full batch
+    for (i = 0; i < DCSNETLINK_MAX_ROUTES; i++)
+    {
+        char destination[DCSNETLINK_ADDR_MAX_BYTES];
+
+        snprintf(destination, sizeof(destination), "10.3.0.%d", i + 1);
+        SetRoute(&routes[i], DCSNETLINK_ROUTE_ADD, destination, GATEWAY_ADDR, LOCAL_INTF);
+    }
+    startTime = le_clk_GetRelativeTime();
+    LE_ASSERT_OK(dcsNetlink_ApplyRoutes(routes, DCSNETLINK_MAX_ROUTES));
+    elapsed = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+    LE_INFO("%d routes applied in %" PRIu64 " us", DCSNETLINK_MAX_ROUTES,
+            (uint64_t)elapsed.sec * 1000000 + elapsed.usec);
+    LE_ASSERT(RouteExists("10.3.0.1", GATEWAY_ADDR));
+    LE_ASSERT(RouteExists("10.3.0.8", GATEWAY_ADDR));
+
+    for (i = 0; i < DCSNETLINK_MAX_ROUTES; i++)
+    {
+        routes[i].action = DCSNETLINK_ROUTE_DELETE;
+    }
+    LE_ASSERT_OK(dcsNetlink_ApplyRoutes(routes, DCSNETLINK_MAX_ROUTES));
+    LE_ASSERT(!RouteExists("10.3.0.1", GATEWAY_ADDR));
+
+    // Deleting a missing route fails
+    LE_ASSERT(LE_FAULT == dcsNetlink_ApplyRoutes(routes, 1));
+
+    // Remove the default and DNS routes
+    SetRoute(&routes[0], DCSNETLINK_ROUTE_DELETE, "10.2.0.53", GATEWAY_ADDR, LOCAL_INTF);
+    SetRoute(&routes[1], DCSNETLINK_ROUTE_DELETE, "", GATEWAY_ADDR, LOCAL_INTF);
+    LE_ASSERT_OK(dcsNetlink_ApplyRoutes(routes, 2));
+    LE_ASSERT(!RouteExists("10.2.0.53", GATEWAY_ADDR));
+    LE_ASSERT(!RouteExists("0.0.0.0", GATEWAY_ADDR));
+
+    // Address removal
+    ClearEvents();
+    startTime = le_clk_GetRelativeTime();
+    ChangeLocalAddress(false);
+    WaitEvent(DCSNETLINK_ADDRESS_REMOVED, startTime);
+    LE_ASSERT(!dcsNetlink_HasAddress(LOCAL_INTF));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* TestThread
+(
+    void* contextPtr
+)
+{
+    TestNotifications();
+    TestRoutes();
+
+    LE_INFO("======== dcsNetlink test success! ========");
+    exit(EXIT_SUCCESS);
+
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Main of the test.
+ */
+//--------------------------------------------------------------------------------------------------
+COMPONENT_INIT
+{
+    LE_INFO("======== Start dcsNetlink test ========");
+
+    // The threads created from now on share the new namespace
+    if (   (-1 == unshare(CLONE_NEWNET))
+        && (-1 == unshare(CLONE_NEWUSER | CLONE_NEWNET)))
+    {
+        LE_WARN("Unable to create a network namespace (%m), test skipped");
+        exit(EXIT_SUCCESS);
+    }
+
+    EventMutex = le_mutex_CreateNonRecursive("EventMutex");
+    EventSem = le_sem_Create("EventSem", 0);
+
+    LE_ASSERT_OK(dcsNetlink_Init(EventHandler, NULL));
+
+    le_thread_Start(le_thread_Create("dcsNetlinkTest", TestThread, NULL));
+}
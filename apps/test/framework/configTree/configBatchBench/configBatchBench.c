@@ -0,0 +1,354 @@
+/**
+ * This module measures how long an app takes to load its settings from the config tree when it
+ * starts, in the two ways the le_cfg API allows:
+ *  - per-key: one request to check that each node exists and one to read it, as the eCall service
+ *    does in LoadECallSettings()
+ *  - batch: all the nodes read with a single le_cfg_GetBatch() request
+ *
+ * Both loads are done in their own read transaction, like at start-up. The settings are written
+ * to the app's tree first, with a single le_cfg_SetBatch() request.
+ *
+ * Options:
+ *  - --count=<n>        Number of loads per test (default 1000)
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Base path of the settings in the app's tree.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SETTINGS_PATH "/cfgBatchBench"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A setting, as written to the tree.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const char* pathPtr;        ///< Path, relative to SETTINGS_PATH
+    le_cfg_nodeType_t type;     ///< Value type
+    double number;              ///< Value of a bool, int or float setting
+    const char* stringPtr;      ///< Value of a string setting
+}
+Setting_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A setting, as loaded from the tree.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    bool exists;                            ///< Whether the node exists
+    double number;                          ///< Value of a bool, int or float setting
+    char string[LE_CFG_STR_LEN_BYTES];      ///< Value of a string setting
+}
+Loaded_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Settings typically read by the modem, positioning and data connection services at start-up.
+ */
+//--------------------------------------------------------------------------------------------------
+static const Setting_t Settings[] =
+{
+    { "ecall/vin",                      LE_CFG_TYPE_STRING, 0,    "WM9VDSVDSYA123456" },
+    { "ecall/vehicleType",              LE_CFG_TYPE_STRING, 0,    "Passenger-M1" },
+    { "ecall/msdVersion",               LE_CFG_TYPE_INT,    2,    "" },
+    { "ecall/systemStandard",           LE_CFG_TYPE_STRING, 0,    "PAN-EUROPEAN" },
+    { "ecall/propulsionType/0",         LE_CFG_TYPE_STRING, 0,    "Gasoline" },
+    { "ecall/propulsionType/1",         LE_CFG_TYPE_STRING, 0,    "Electric" },
+    { "ecall/pushButtonEnabled",        LE_CFG_TYPE_BOOL,   1,    "" },
+    { "positioning/acquisitionRate",    LE_CFG_TYPE_INT,    1000, "" },
+    { "positioning/minAccuracy",        LE_CFG_TYPE_FLOAT,  2.5,  "" },
+    { "dataConnection/profileIndex",    LE_CFG_TYPE_INT,    1,    "" },
+    { "dataConnection/apn",             LE_CFG_TYPE_STRING, 0,    "internet.example.com" },
+    { "dataConnection/retryEnabled",    LE_CFG_TYPE_BOOL,   0,    "" },
+};
+
+#define NUM_SETTINGS    NUM_ARRAY_MEMBERS(Settings)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Command line options.
+ */
+//--------------------------------------------------------------------------------------------------
+static int Count = 1000;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Packed paths and string values of the settings, for the batch requests.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t Paths[LE_CFG_BATCH_BYTES];
+static size_t PathsSize;
+static uint8_t Strings[LE_CFG_BATCH_BYTES];
+static size_t StringsSize;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Settings loaded by the last load.
+ */
+//--------------------------------------------------------------------------------------------------
+static Loaded_t Loaded[NUM_SETTINGS];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the time elapsed since a start time, in microseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t ElapsedUs
+(
+    le_clk_Time_t start     ///< [IN] Start time
+)
+{
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), start);
+
+    return ((uint64_t)elapsed.sec * 1000000) + elapsed.usec;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Print the result of a test.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Report
+(
+    const char* namePtr,    ///< [IN] Test name
+    int requests,           ///< [IN] Number of requests per load
+    uint64_t elapsedUs      ///< [IN] Time taken by all the loads
+)
+{
+    LE_TEST_INFO("%-10s %6d loads of %zu settings in %8" PRIu64 " us: %8.1f us/load, "
+                 "%d requests/load",
+                 namePtr, Count, NUM_SETTINGS, elapsedUs, (double)elapsedUs / Count, requests);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a string to a packed strings buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Pack
+(
+    uint8_t* bufferPtr,     ///< [IN] Packed strings buffer
+    size_t* sizePtr,        ///< [INOUT] Size used in the buffer
+    const char* stringPtr   ///< [IN] String to append
+)
+{
+    size_t len = strlen(stringPtr) + 1;
+
+    LE_ASSERT(*sizePtr + len <= LE_CFG_BATCH_BYTES);
+    memcpy(bufferPtr + *sizePtr, stringPtr, len);
+    *sizePtr += len;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write the settings to the tree with one batch request.
+ */
+//--------------------------------------------------------------------------------------------------
+static void WriteSettings
+(
+    void
+)
+{
+    le_cfg_nodeType_t types[NUM_SETTINGS];
+    double numbers[NUM_SETTINGS];
+    size_t i;
+
+    for (i = 0; i < NUM_SETTINGS; i++)
+    {
+        Pack(Paths, &PathsSize, Settings[i].pathPtr);
+        Pack(Strings, &StringsSize, Settings[i].stringPtr);
+        types[i] = Settings[i].type;
+        numbers[i] = Settings[i].number;
+    }
+
+    le_cfg_IteratorRef_t iteratorRef = le_cfg_CreateWriteTxn(SETTINGS_PATH);
+
+    LE_TEST_OK(le_cfg_SetBatch(iteratorRef, Paths, PathsSize, types, NUM_SETTINGS,
+                               numbers, NUM_SETTINGS, Strings, StringsSize) == LE_OK,
+               "write %zu settings with one batch request", NUM_SETTINGS);
+
+    le_cfg_CommitTxn(iteratorRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Load the settings with a get request per setting.
+ */
+//--------------------------------------------------------------------------------------------------
+static void LoadPerKey
+(
+    void
+)
+{
+    le_cfg_IteratorRef_t iteratorRef = le_cfg_CreateReadTxn(SETTINGS_PATH);
+    size_t i;
+
+    for (i = 0; i < NUM_SETTINGS; i++)
+    {
+        const char* pathPtr = Settings[i].pathPtr;
+        Loaded_t* loadedPtr = &Loaded[i];
+
+        loadedPtr->exists = le_cfg_NodeExists(iteratorRef, pathPtr);
+        loadedPtr->number = 0;
+        loadedPtr->string[0] = '\0';
+
+        switch (Settings[i].type)
+        {
+            case LE_CFG_TYPE_STRING:
+                le_cfg_GetString(iteratorRef, pathPtr, loadedPtr->string,
+                                 sizeof(loadedPtr->string), "");
+                break;
+
+            case LE_CFG_TYPE_BOOL:
+                loadedPtr->number = le_cfg_GetBool(iteratorRef, pathPtr, false) ? 1 : 0;
+                break;
+
+            case LE_CFG_TYPE_INT:
+                loadedPtr->number = le_cfg_GetInt(iteratorRef, pathPtr, 0);
+                break;
+
+            case LE_CFG_TYPE_FLOAT:
+                loadedPtr->number = le_cfg_GetFloat(iteratorRef, pathPtr, 0.0);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    le_cfg_CancelTxn(iteratorRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Load the settings with one batch request.
+ */
+//--------------------------------------------------------------------------------------------------
+static void LoadBatch
+(
+    void
+)
+{
+    le_cfg_nodeType_t types[NUM_SETTINGS];
+    double numbers[NUM_SETTINGS];
+    char strings[LE_CFG_BATCH_BYTES];
+    size_t typesSize = NUM_SETTINGS;
+    size_t numbersSize = NUM_SETTINGS;
+    size_t stringsSize = sizeof(strings);
+    size_t i;
+
+    le_cfg_IteratorRef_t iteratorRef = le_cfg_CreateReadTxn(SETTINGS_PATH);
+    le_result_t result = le_cfg_GetBatch(iteratorRef, Paths, PathsSize, types, &typesSize,
+                                         numbers, &numbersSize, (uint8_t*)strings, &stringsSize);
+    le_cfg_CancelTxn(iteratorRef);
+
+    LE_ASSERT((result == LE_OK) && (typesSize == NUM_SETTINGS));
+
+    const char* stringPtr = strings;
+
+    for (i = 0; i < NUM_SETTINGS; i++)
+    {
+        Loaded_t* loadedPtr = &Loaded[i];
+
+        loadedPtr->exists = (types[i] != LE_CFG_TYPE_DOESNT_EXIST);
+        loadedPtr->number = (types[i] == Settings[i].type) ? numbers[i] : 0;
+        loadedPtr->string[0] = '\0';
+
+        if (types[i] == LE_CFG_TYPE_STRING)
+        {
+            LE_ASSERT_OK(le_utf8_Copy(loadedPtr->string, stringPtr, sizeof(loadedPtr->string),
+                                      NULL));
+        }
+
+        stringPtr += strlen(stringPtr) + 1;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that the last load read back the values written.
+ *
+ * @return true if all the settings match.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool CheckLoaded
+(
+    void
+)
+{
+    size_t i;
+
+    for (i = 0; i < NUM_SETTINGS; i++)
+    {
+        if (   (Loaded[i].exists == false)
+            || (Loaded[i].number != Settings[i].number)
+            || (strcmp(Loaded[i].string, Settings[i].stringPtr) != 0))
+        {
+            LE_TEST_INFO("Setting '%s' not loaded as written", Settings[i].pathPtr);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Time a number of loads.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestLoad
+(
+    const char* namePtr,        ///< [IN] Test name
+    void (*loadFunc)(void),     ///< [IN] Load function
+    int requests                ///< [IN] Number of requests per load
+)
+{
+    int i;
+
+    memset(Loaded, 0, sizeof(Loaded));
+    loadFunc();
+    LE_TEST_OK(CheckLoaded(), "%s load reads the settings written", namePtr);
+
+    le_clk_Time_t start = le_clk_GetRelativeTime();
+
+    for (i = 0; i < Count; i++)
+    {
+        loadFunc();
+    }
+
+    Report(namePtr, requests, ElapsedUs(start));
+}
+
+COMPONENT_INIT
+{
+    le_arg_SetIntVar(&Count, NULL, "count");
+    le_arg_Scan();
+
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+
+    if (Count <= 0)
+    {
+        LE_TEST_FATAL("Invalid load count %d", Count);
+    }
+
+    WriteSettings();
+
+    // Create and cancel the read transaction, then two requests per setting.
+    TestLoad("per-key", LoadPerKey, 2 + (2 * NUM_SETTINGS));
+
+    // Create and cancel the read transaction, then one request for all the settings.
+    TestLoad("batch", LoadBatch, 3);
+
+    LE_TEST_EXIT;
+}
@@ -558,6 +558,293 @@ static void TestImportLargeString()
 
 
 
+static void TestImportExportFd()
+{
+    LE_INFO("---- Import Export Fd Test -------------------------------------------------------");
+
+    static const char jsonData[] =
+        {
+            "{\"name\":\"importExportFd\",\"type\":\"stem\",\"children\":["
+                "{\"name\":\"aBoolValue\",\"type\":\"bool\",\"value\":true},"
+                "{\"name\":\"aStringValue\",\"type\":\"string\","
+                    "\"value\":\"Something \\\"wicked\\\" this way comes!\"},"
+                "{\"name\":\"anIntVal\",\"type\":\"int\",\"value\":1024},"
+                "{\"name\":\"nestedValues\",\"type\":\"stem\",\"children\":["
+                    "{\"name\":\"aFloatVal\",\"type\":\"float\",\"value\":10.24},"
+                    "{\"name\":\"anEmptyVal\",\"type\":\"empty\"}"
+                "]}"
+            "]}\n"
+        };
+
+    static const char nativeData[] =
+        {
+            "{ "
+                "\"aBoolValue\" !t "
+                "\"aStringValue\" \"Something \\\"wicked\\\" this way comes!\" "
+                "\"anIntVal\" [1024] "
+                "\"nestedValues\" "
+                "{ "
+                    "\"aFloatVal\" (10.24) "
+                    "\"anEmptyVal\" ~ "
+                "} "
+            "} "
+        };
+
+    static char pathBuffer[LE_CFG_STR_LEN_BYTES] = "";
+    snprintf(pathBuffer, LE_CFG_STR_LEN_BYTES, "/%s/importExportFd", TestRootDir);
+
+    char nameTemplate[NAMETEMPLATESIZE] = "";
+    sprintf(nameTemplate, "./%s_testImportFdData.json", TestRootDir);
+
+    char filePath[PATH_MAX] = "";
+    realpath(nameTemplate, filePath);
+
+    WriteConfigData(filePath, jsonData);
+
+    // The whole JSON document is imported in one request.
+    int fd = open(filePath, O_RDONLY);
+    LE_ASSERT(fd != -1);
+    unlink(filePath);
+
+    le_cfg_IteratorRef_t iterRef = le_cfg_CreateWriteTxn(pathBuffer);
+    LE_TEST(le_cfgAdmin_ImportTreeFd(iterRef, fd, LE_CFGADMIN_FORMAT_JSON, "") == LE_OK);
+    le_cfg_CommitTxn(iterRef);
+
+    iterRef = le_cfg_CreateReadTxn(pathBuffer);
+
+    char strBuffer[LE_CFG_STR_LEN_BYTES] = "";
+    LE_TEST(le_cfg_GetBool(iterRef, "aBoolValue", false) == true);
+    LE_TEST(le_cfg_GetString(iterRef, "aStringValue", strBuffer, sizeof(strBuffer), "") == LE_OK);
+    LE_TEST(strcmp(strBuffer, "Something \"wicked\" this way comes!") == 0);
+    LE_TEST(le_cfg_GetInt(iterRef, "anIntVal", 0) == 1024);
+    LE_TEST(le_cfg_GetNodeType(iterRef, "nestedValues/aFloatVal") == LE_CFG_TYPE_FLOAT);
+    LE_TEST(le_cfg_IsEmpty(iterRef, "nestedValues/anEmptyVal") == true);
+
+    // Export it back, in both formats.
+    sprintf(nameTemplate, "./%s_testExportFdData", TestRootDir);
+    realpath(nameTemplate, filePath);
+
+    fd = open(filePath, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    LE_ASSERT(fd != -1);
+    LE_TEST(le_cfgAdmin_ExportTreeFd(iterRef, fd, LE_CFGADMIN_FORMAT_JSON, "") == LE_OK);
+    CompareFile(filePath, jsonData);
+
+    fd = open(filePath, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    LE_ASSERT(fd != -1);
+    LE_TEST(le_cfgAdmin_ExportTreeFd(iterRef, fd, LE_CFGADMIN_FORMAT_NATIVE, "") == LE_OK);
+    CompareFile(filePath, nativeData);
+    unlink(filePath);
+
+    // Only regular files are accepted.
+    int pipeFds[2];
+    LE_ASSERT(pipe(pipeFds) == 0);
+    LE_TEST(le_cfgAdmin_ExportTreeFd(iterRef, pipeFds[1], LE_CFGADMIN_FORMAT_JSON, "")
+            == LE_BAD_PARAMETER);
+    close(pipeFds[0]);
+
+    le_cfg_CancelTxn(iterRef);
+
+    // A malformed import leaves the tree untouched once the transaction is cancelled.
+    WriteConfigData(filePath, "{\"name\":\"x\",\"type\":\"int\",\"value\":\"notAnInt\"}");
+    fd = open(filePath, O_RDONLY);
+    LE_ASSERT(fd != -1);
+    unlink(filePath);
+
+    iterRef = le_cfg_CreateWriteTxn(pathBuffer);
+    LE_TEST(le_cfgAdmin_ImportTreeFd(iterRef, fd, LE_CFGADMIN_FORMAT_JSON, "") == LE_FORMAT_ERROR);
+    le_cfg_CancelTxn(iterRef);
+
+    iterRef = le_cfg_CreateReadTxn(pathBuffer);
+    LE_TEST(le_cfg_GetInt(iterRef, "anIntVal", 0) == 1024);
+    le_cfg_CancelTxn(iterRef);
+}
+
+
+
+static void TestCopyMove()
+{
+    LE_INFO("---- Copy Move Test ---------------------------------------------------------------");
+
+    static char pathBuffer[LE_CFG_STR_LEN_BYTES] = "";
+    snprintf(pathBuffer, LE_CFG_STR_LEN_BYTES, "/%s/copyMove", TestRootDir);
+
+    char strBuffer[LE_CFG_STR_LEN_BYTES] = "";
+    le_cfg_IteratorRef_t iterRef = le_cfg_CreateWriteTxn(pathBuffer);
+
+    le_cfg_SetString(iterRef, "source/aString", "hello");
+    le_cfg_SetInt(iterRef, "source/nested/anInt", 42);
+    le_cfg_SetString(iterRef, "dest/old", "replaced");
+
+    LE_TEST(le_cfgAdmin_CopyTree(iterRef, "source", "dest", false) == LE_OK);
+    LE_TEST(le_cfgAdmin_CopyTree(iterRef, "source", "source/nested/loop", false)
+            == LE_BAD_PARAMETER);
+    LE_TEST(le_cfgAdmin_CopyTree(iterRef, "source/nested", "source", false) == LE_BAD_PARAMETER);
+    LE_TEST(le_cfgAdmin_CopyTree(iterRef, "missing", "other", false) == LE_NOT_FOUND);
+
+    le_cfg_CommitTxn(iterRef);
+
+    iterRef = le_cfg_CreateReadTxn(pathBuffer);
+    LE_TEST(le_cfg_NodeExists(iterRef, "dest/old") == false);
+    LE_TEST(le_cfg_GetString(iterRef, "dest/aString", strBuffer, sizeof(strBuffer), "") == LE_OK);
+    LE_TEST(strcmp(strBuffer, "hello") == 0);
+    LE_TEST(le_cfg_GetInt(iterRef, "dest/nested/anInt", 0) == 42);
+    LE_TEST(le_cfg_GetInt(iterRef, "source/nested/anInt", 0) == 42);
+    LE_TEST(le_cfg_NodeExists(iterRef, "other") == false);
+    le_cfg_CancelTxn(iterRef);
+
+    // Move, the source is gone once the transaction is committed.
+    iterRef = le_cfg_CreateWriteTxn(pathBuffer);
+    LE_TEST(le_cfgAdmin_CopyTree(iterRef, "source", "moved", true) == LE_OK);
+    LE_TEST(le_cfg_NodeExists(iterRef, "source") == false);
+    le_cfg_CommitTxn(iterRef);
+
+    iterRef = le_cfg_CreateReadTxn(pathBuffer);
+    LE_TEST(le_cfg_NodeExists(iterRef, "source") == false);
+    LE_TEST(le_cfg_GetInt(iterRef, "moved/nested/anInt", 0) == 42);
+    le_cfg_CancelTxn(iterRef);
+}
+
+
+
+static void TestBatch()
+{
+    LE_INFO("---- Batch Test --------------------------------------------------------------------");
+
+    static char pathBuffer[LE_CFG_STR_LEN_BYTES] = "";
+    snprintf(pathBuffer, LE_CFG_STR_LEN_BYTES, "/%s/batch", TestRootDir);
+
+    static const char paths[] = "aString\0" "aBool\0" "nested/anInt\0" "aFloat\0" "anEmpty";
+    static const char strings[] = "hello\0" "\0" "\0" "\0";
+    le_cfg_nodeType_t types[LE_CFG_BATCH_MAX_NODES] =
+        {
+            LE_CFG_TYPE_STRING, LE_CFG_TYPE_BOOL, LE_CFG_TYPE_INT, LE_CFG_TYPE_FLOAT,
+            LE_CFG_TYPE_EMPTY
+        };
+    double numbers[LE_CFG_BATCH_MAX_NODES] = { 0, 1, -42, 2.5, 0 };
+    char strBuffer[LE_CFG_BATCH_BYTES] = "";
+
+    le_cfg_IteratorRef_t iterRef = le_cfg_CreateWriteTxn(pathBuffer);
+
+    LE_TEST(le_cfg_SetBatch(iterRef,
+                            (const uint8_t*)paths,
+                            sizeof(paths),
+                            types,
+                            5,
+                            numbers,
+                            5,
+                            (const uint8_t*)strings,
+                            sizeof(strings)) == LE_OK);
+
+    // Nothing is written if a value can't be, or if the paths don't match the values.
+    numbers[2] = 1.5;
+    LE_TEST(le_cfg_SetBatch(iterRef,
+                            (const uint8_t*)"other\0" "nested/anInt",
+                            sizeof("other\0" "nested/anInt"),
+                            types + 1,
+                            2,
+                            numbers + 1,
+                            2,
+                            (const uint8_t*)"\0",
+                            2) == LE_BAD_PARAMETER);
+    LE_TEST(le_cfg_SetBatch(iterRef,
+                            (const uint8_t*)paths,
+                            sizeof(paths),
+                            types,
+                            4,
+                            numbers,
+                            4,
+                            (const uint8_t*)strings,
+                            sizeof(strings)) == LE_FORMAT_ERROR);
+    LE_TEST(le_cfg_NodeExists(iterRef, "other") == false);
+
+    // Nor if a path or a string value is longer than the tree allows.
+    char tooLong[LE_CFG_STR_LEN_BYTES + 1];
+    memset(tooLong, 'x', LE_CFG_STR_LEN + 1);
+    tooLong[LE_CFG_STR_LEN + 1] = '\0';
+
+    LE_TEST(le_cfg_SetBatch(iterRef,
+                            (const uint8_t*)"tooLong",
+                            sizeof("tooLong"),
+                            types,
+                            1,
+                            numbers,
+                            1,
+                            (const uint8_t*)tooLong,
+                            sizeof(tooLong)) == LE_BAD_PARAMETER);
+    LE_TEST(le_cfg_SetBatch(iterRef,
+                            (const uint8_t*)tooLong,
+                            sizeof(tooLong),
+                            types,
+                            1,
+                            numbers,
+                            1,
+                            (const uint8_t*)"",
+                            1) == LE_BAD_PARAMETER);
+    LE_TEST(le_cfg_NodeExists(iterRef, "tooLong") == false);
+
+    le_cfg_CommitTxn(iterRef);
+
+    static const char readPaths[] = "aString\0" "aBool\0" "nested/anInt\0" "aFloat\0"
+                                    "anEmpty\0" "missing\0" "nested";
+    size_t typesSize = NUM_ARRAY_MEMBERS(types);
+    size_t numbersSize = NUM_ARRAY_MEMBERS(numbers);
+    size_t stringsSize = sizeof(strBuffer);
+
+    iterRef = le_cfg_CreateReadTxn(pathBuffer);
+
+    LE_TEST(le_cfg_GetBatch(iterRef,
+                            (const uint8_t*)readPaths,
+                            sizeof(readPaths),
+                            types,
+                            &typesSize,
+                            numbers,
+                            &numbersSize,
+                            (uint8_t*)strBuffer,
+                            &stringsSize) == LE_OK);
+    LE_TEST((typesSize == 7) && (numbersSize == 7));
+    LE_TEST(types[0] == LE_CFG_TYPE_STRING);
+    LE_TEST(strcmp(strBuffer, "hello") == 0);
+    LE_TEST((types[1] == LE_CFG_TYPE_BOOL) && (numbers[1] == 1));
+    LE_TEST((types[2] == LE_CFG_TYPE_INT) && (numbers[2] == -42));
+    LE_TEST((types[3] == LE_CFG_TYPE_FLOAT) && (numbers[3] == 2.5));
+    LE_TEST(types[4] == LE_CFG_TYPE_EMPTY);
+    LE_TEST(types[5] == LE_CFG_TYPE_DOESNT_EXIST);
+    LE_TEST(types[6] == LE_CFG_TYPE_STEM);
+
+    // Too many paths for the client's buffers.
+    typesSize = 2;
+    numbersSize = NUM_ARRAY_MEMBERS(numbers);
+    stringsSize = sizeof(strBuffer);
+    LE_TEST(le_cfg_GetBatch(iterRef,
+                            (const uint8_t*)readPaths,
+                            sizeof(readPaths),
+                            types,
+                            &typesSize,
+                            numbers,
+                            &numbersSize,
+                            (uint8_t*)strBuffer,
+                            &stringsSize) == LE_OVERFLOW);
+    LE_TEST(typesSize == 0);
+
+    // The last path must be NULL terminated.
+    typesSize = NUM_ARRAY_MEMBERS(types);
+    numbersSize = NUM_ARRAY_MEMBERS(numbers);
+    stringsSize = sizeof(strBuffer);
+    LE_TEST(le_cfg_GetBatch(iterRef,
+                            (const uint8_t*)readPaths,
+                            sizeof(readPaths) - 1,
+                            types,
+                            &typesSize,
+                            numbers,
+                            &numbersSize,
+                            (uint8_t*)strBuffer,
+                            &stringsSize) == LE_FORMAT_ERROR);
+
+    le_cfg_CancelTxn(iterRef);
+}
+
+
+
 static void MultiTreeTest()
 {
     char strBuffer[LE_CFG_STR_LEN_BYTES] = "";
@@ -898,6 +1185,9 @@ COMPONENT_INIT
     DeleteTest();
     StringSizeTest();
     TestImportExport();
+    TestImportExportFd();
+    TestCopyMove();
+    TestBatch();
     MultiTreeTest();
     ExistAndEmptyTest();
     ListTreeTest();
@@ -0,0 +1,340 @@
+/**
+ * Test the le_crc API against a bitwise CRC32, and measure its throughput.
+ *
+ * The CRC32 of buffers of every size up to a few blocks, at every alignment, is checked so that the
+ * slicing and instruction paths and their tails are covered. The streaming API is checked by
+ * splitting a buffer into random chunks, and into parts computed by several threads then merged.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the test buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+#define BUFFER_SIZE         (4 * 1024 * 1024)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Largest buffer size checked at every alignment.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_CHECKED_SIZE    300
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of threads of the parallel computation.
+ */
+//--------------------------------------------------------------------------------------------------
+#define THREAD_COUNT        4
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of passes over the buffer of the throughput measurement.
+ */
+//--------------------------------------------------------------------------------------------------
+#define BENCH_PASSES        16
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t* BufferPtr;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Part of the buffer computed by a thread.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const uint8_t*    dataPtr;
+    size_t            size;
+    le_crc_Crc32Ctx_t ctx;
+}
+Part_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute a CRC32 one bit at a time, as the reference.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t BitwiseCrc32
+(
+    const uint8_t* dataPtr,
+    size_t         size,
+    uint32_t       crc
+)
+{
+    while (size--)
+    {
+        int bit;
+
+        crc ^= *dataPtr++;
+        for (bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1)));
+        }
+    }
+    return crc;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute a CRC32 one byte at a time with a table, as le_crc_Crc32() did before the slicing tables.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t ByteCrc32
+(
+    const uint8_t* dataPtr,
+    size_t         size,
+    uint32_t       crc
+)
+{
+    static uint32_t table[256];
+
+    if (0 == table[1])
+    {
+        uint32_t i;
+
+        for (i = 0; i < 256; i++)
+        {
+            uint8_t byte = i;
+
+            table[i] = BitwiseCrc32(&byte, 1, 0);
+        }
+    }
+
+    while (size--)
+    {
+        crc = (crc >> 8) ^ table[(crc ^ *dataPtr++) & 0xFF];
+    }
+    return crc;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the time elapsed since a start time, in seconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static double ElapsedSeconds
+(
+    le_clk_Time_t start
+)
+{
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), start);
+
+    return elapsed.sec + elapsed.usec / 1e6;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check the CRC32 of small buffers at every alignment.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestSizes
+(
+    void
+)
+{
+    size_t offset;
+    size_t size;
+    uint8_t check[] = "123456789";
+
+    LE_INFO("Test the check value");
+    LE_ASSERT(~0xCBF43926U == le_crc_Crc32(check, sizeof(check) - 1, LE_CRC_START_CRC32));
+
+    LE_INFO("Test sizes up to %d at every alignment", MAX_CHECKED_SIZE);
+    for (offset = 0; offset < 16; offset++)
+    {
+        for (size = 0; size <= MAX_CHECKED_SIZE; size++)
+        {
+            uint32_t seed = (uint32_t)(size * 0x9E3779B9U);
+
+            LE_ASSERT(BitwiseCrc32(BufferPtr + offset, size, seed) ==
+                      le_crc_Crc32(BufferPtr + offset, size, seed));
+        }
+    }
+
+    LE_INFO("Test the whole buffer");
+    LE_ASSERT(BitwiseCrc32(BufferPtr, BUFFER_SIZE, LE_CRC_START_CRC32) ==
+              le_crc_Crc32(BufferPtr, BUFFER_SIZE, LE_CRC_START_CRC32));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check the streaming API with random chunks.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestStream
+(
+    uint32_t expected
+)
+{
+    le_crc_Crc32Ctx_t ctx;
+    le_crc_Crc32Ctx_t emptyCtx;
+    size_t offset = 0;
+
+    LE_INFO("Test the streaming API");
+    le_crc_Crc32Init(&ctx);
+    le_crc_Crc32Init(&emptyCtx);
+    while (offset < BUFFER_SIZE)
+    {
+        size_t size = le_rand_GetNumBetween(0, 100000);
+
+        if (size > BUFFER_SIZE - offset)
+        {
+            size = BUFFER_SIZE - offset;
+        }
+        le_crc_Crc32Update(&ctx, BufferPtr + offset, size);
+        offset += size;
+    }
+    LE_ASSERT(BUFFER_SIZE == ctx.size);
+    LE_ASSERT(expected == le_crc_Crc32Final(&ctx));
+
+    // Merging an empty context changes nothing
+    le_crc_Crc32Merge(&ctx, &emptyCtx);
+    LE_ASSERT(expected == le_crc_Crc32Final(&ctx));
+    le_crc_Crc32Merge(&emptyCtx, &ctx);
+    LE_ASSERT(expected == le_crc_Crc32Final(&emptyCtx));
+
+    LE_INFO("Test combining at every split point of a small buffer");
+    for (offset = 0; offset <= MAX_CHECKED_SIZE; offset++)
+    {
+        uint32_t first = le_crc_Crc32(BufferPtr, offset, LE_CRC_START_CRC32);
+        uint32_t second = le_crc_Crc32(BufferPtr + offset, MAX_CHECKED_SIZE - offset,
+                                       LE_CRC_START_CRC32);
+
+        LE_ASSERT(le_crc_Crc32(BufferPtr, MAX_CHECKED_SIZE, LE_CRC_START_CRC32) ==
+                  le_crc_Crc32Combine(first, second, MAX_CHECKED_SIZE - offset));
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute the CRC32 of a part of the buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* PartThread
+(
+    void* contextPtr
+)
+{
+    Part_t* partPtr = contextPtr;
+
+    le_crc_Crc32Init(&partPtr->ctx);
+    le_crc_Crc32Update(&partPtr->ctx, partPtr->dataPtr, partPtr->size);
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute the CRC32 of the buffer with several threads, and merge the parts.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t ParallelCrc32
+(
+    void
+)
+{
+    Part_t parts[THREAD_COUNT];
+    le_thread_Ref_t threads[THREAD_COUNT];
+    size_t partSize = BUFFER_SIZE / THREAD_COUNT;
+    int i;
+
+    for (i = 0; i < THREAD_COUNT; i++)
+    {
+        char name[16];
+
+        parts[i].dataPtr = BufferPtr + i * partSize;
+        parts[i].size = (i == THREAD_COUNT - 1) ? (BUFFER_SIZE - i * partSize) : partSize;
+        snprintf(name, sizeof(name), "crcPart%d", i);
+        threads[i] = le_thread_Create(name, PartThread, &parts[i]);
+        le_thread_SetJoinable(threads[i]);
+        le_thread_Start(threads[i]);
+    }
+
+    for (i = 0; i < THREAD_COUNT; i++)
+    {
+        LE_ASSERT_OK(le_thread_Join(threads[i], NULL));
+        if (i > 0)
+        {
+            le_crc_Crc32Merge(&parts[0].ctx, &parts[i].ctx);
+        }
+    }
+
+    return le_crc_Crc32Final(&parts[0].ctx);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Measure the throughput of the bitwise and byte loops, of le_crc_Crc32() and of the parallel
+ * computation.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Benchmark
+(
+    uint32_t expected
+)
+{
+    double megabytes = (double)BENCH_PASSES * BUFFER_SIZE / (1024 * 1024);
+    volatile uint32_t crc = 0;
+    le_clk_Time_t start;
+    int pass;
+
+    start = le_clk_GetRelativeTime();
+    for (pass = 0; pass < BENCH_PASSES; pass++)
+    {
+        crc = BitwiseCrc32(BufferPtr, BUFFER_SIZE, LE_CRC_START_CRC32);
+    }
+    LE_INFO("Bitwise loop:  %8.1f MB/s", megabytes / ElapsedSeconds(start));
+    LE_ASSERT(expected == crc);
+
+    start = le_clk_GetRelativeTime();
+    for (pass = 0; pass < BENCH_PASSES; pass++)
+    {
+        crc = ByteCrc32(BufferPtr, BUFFER_SIZE, LE_CRC_START_CRC32);
+    }
+    LE_INFO("Byte loop:     %8.1f MB/s", megabytes / ElapsedSeconds(start));
+    LE_ASSERT(expected == crc);
+
+    start = le_clk_GetRelativeTime();
+    for (pass = 0; pass < BENCH_PASSES; pass++)
+    {
+        crc = le_crc_Crc32(BufferPtr, BUFFER_SIZE, LE_CRC_START_CRC32);
+    }
+    LE_INFO("le_crc_Crc32:  %8.1f MB/s", megabytes / ElapsedSeconds(start));
+    LE_ASSERT(expected == crc);
+
+    start = le_clk_GetRelativeTime();
+    for (pass = 0; pass < BENCH_PASSES; pass++)
+    {
+        crc = ParallelCrc32();
+    }
+    LE_INFO("%d threads:     %8.1f MB/s", THREAD_COUNT, megabytes / ElapsedSeconds(start));
+    LE_ASSERT(expected == crc);
+}
+
+COMPONENT_INIT
+{
+    uint32_t expected;
+
+    BufferPtr = malloc(BUFFER_SIZE);
+    LE_ASSERT(NULL != BufferPtr);
+    le_rand_GetBuffer(BufferPtr, BUFFER_SIZE);
+
+    TestSizes();
+
+    expected = le_crc_Crc32(BufferPtr, BUFFER_SIZE, LE_CRC_START_CRC32);
+    TestStream(expected);
+    Benchmark(expected);
+
+    free(BufferPtr);
+
+    LE_INFO("CRC test passed");
+    exit(EXIT_SUCCESS);
+}
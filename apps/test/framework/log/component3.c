@@ -0,0 +1,60 @@
+ /**
+  * This is component 3 for the multi-component logging unit test.  It is compiled with
+  * LE_LOG_COMPILE_LEVEL set to WARNING, so its DEBUG and INFO messages are compiled out.
+  *
+  * Copyright (C) Sierra Wireless Inc.
+  */
+
+#ifdef LE_COMPONENT_NAME
+# undef LE_COMPONENT_NAME
+#endif
+
+#ifdef LE_LOG_SESSION
+# undef LE_LOG_SESSION
+#endif
+
+#ifdef LE_LOG_LEVEL_FILTER_PTR
+# undef LE_LOG_LEVEL_FILTER_PTR
+#endif
+
+#define LE_COMPONENT_NAME       Comp_3
+#define LE_LOG_SESSION          Comp_3_LogSession
+#define LE_LOG_LEVEL_FILTER_PTR Comp_3_LogLevelFilterPtr
+#define LE_LOG_COMPILE_LEVEL    LE_LOG_WARN
+
+#include "legato.h"
+#include "component3.h"
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the component.
+ */
+//--------------------------------------------------------------------------------------------------
+void comp3_Init(void)
+{
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Component code that logs messages at every level, the less severe than WARNING being compiled
+ * out.
+ *
+ * @return The number of messages whose parameters were evaluated.
+ */
+//--------------------------------------------------------------------------------------------------
+int comp3_Foo(void)
+{
+    int evaluated = 0;
+
+    LE_DEBUG("comp3 %d msg", (evaluated++, LE_LOG_DEBUG));
+    LE_INFO("comp3 %d msg", (evaluated++, LE_LOG_INFO));
+    LE_WARN("comp3 %d msg", (evaluated++, LE_LOG_WARN));
+    LE_ERROR("comp3 %d msg", (evaluated++, LE_LOG_ERR));
+    LE_CRIT("comp3 %d msg", (evaluated++, LE_LOG_CRIT));
+    LE_EMERG("comp3 %d msg", (evaluated++, LE_LOG_EMERG));
+
+    return evaluated;
+}
@@ -0,0 +1,26 @@
+ /**
+  * This is component 3 for the multi-component logging unit test.
+  *
+  * Copyright (C) Sierra Wireless Inc.
+  */
+
+#include "legato.h"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the component.
+ */
+//--------------------------------------------------------------------------------------------------
+void comp3_Init(void);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Component code that logs messages at every level, the less severe than WARNING being compiled
+ * out.
+ *
+ * @return The number of messages whose parameters were evaluated.
+ */
+//--------------------------------------------------------------------------------------------------
+int comp3_Foo(void);
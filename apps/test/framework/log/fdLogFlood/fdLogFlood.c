@@ -0,0 +1,37 @@
+//--------------------------------------------------------------------------------------------------
+/** @file fdLogFlood.c
+ *
+ * This program floods its standard output, to check the rate limit the log daemon applies to the
+ * standard output of the apps.  It writes a line longer than a log message and FLOOD_LINES lines
+ * at once, waits for the rate limit to let lines through again, then writes a last line.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+#include "legato.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of lines written at once, well above the burst the log daemon lets through.
+ */
+//--------------------------------------------------------------------------------------------------
+#define FLOOD_LINES     1000
+
+
+COMPONENT_INIT
+{
+    int i;
+
+    // A line longer than a log message, logged cut short and alone.
+    printf("flood long line %0300d\n", 0);
+
+    for (i = 0; i < FLOOD_LINES; i++)
+    {
+        printf("flood line %04d\n", i);
+    }
+
+    fflush(stdout);
+    sleep(1);
+
+    printf("flood done\n");
+    fflush(stdout);
+}
@@ -0,0 +1,48 @@
+#!/bin/bash
+
+# Rate limit of the standard output of the apps: the log daemon lets a burst of lines through, then
+# discards the lines over the average rate and logs how many were discarded before the next line.
+
+LoadTestLib
+
+targetAddr=$1
+targetType=${2:-ar7}
+
+OnFail() {
+    echo "Fd Log Flood Test Failed!"
+}
+
+OnExit() {
+    app remove FdLogFloodApp $targetAddr
+}
+
+scriptDir=$( cd "$( dirname "${BASH_SOURCE[0]}" )" && pwd )
+
+cd $scriptDir
+
+echo "Build FdLogFloodApp"
+mkapp FdLogFloodApp.adef -t $targetType
+CheckRet
+
+InstallApp FdLogFloodApp
+
+ClearLogs
+
+ssh root@$targetAddr "$BIN_PATH/app start FdLogFloodApp"
+CheckRet
+
+# Wait for the last line.
+sleep 3
+
+# Each line is logged in a message of its own, the long line cut short.
+CheckLogStr "==" 1 "flood long line 0*$"
+CheckLogStr "==" 1 "flood line 0000"
+CheckLogStr "==" 1 "flood line 0150"
+
+# The end of the flood is over the burst, and is counted in a single summary.
+CheckLogStr "==" 0 "flood line 0999"
+CheckLogStr "==" 1 "\[[0-9]* lines suppressed\]"
+CheckLogStr "==" 1 "flood done"
+
+echo "Fd Log Flood Test Passed!"
+exit 0
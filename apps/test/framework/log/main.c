@@ -7,6 +7,7 @@
 #include "legato.h"
 #include "component1.h"
 #include "component2.h"
+#include "component3.h"
 #include "component1Helper.h"
 #include "log.h"
 
@@ -508,11 +509,108 @@ void TestStopTraceAll(void)
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads the next log line and compares it with the expected beginning, skipping the newline at the
+ * end.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckNextLine
+(
+    const char* expectedPtr
+)
+{
+    char logLine[300];
+
+    LE_ASSERT(fgets(logLine, sizeof(logLine), LogFile) != NULL);
+    LE_ASSERT(strncmp(expectedPtr, logLine, le_utf8_NumBytes(logLine) - 1) == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test disabling and enabling a single call site of component 1.  The line of its LE_ERROR() is
+ * given by the test script in COMP1_ERROR_LINE.
+ */
+//--------------------------------------------------------------------------------------------------
+void TestCallSiteComp1(void)
+{
+    const char* linePtr = getenv("COMP1_ERROR_LINE");
+    LE_ASSERT(linePtr != NULL);
+
+    char callSite[64];
+    LE_ASSERT(snprintf(callSite, sizeof(callSite), "component1.c:%s", linePtr) < sizeof(callSite));
+
+    // Show the messages of component 1 down to WARNING, then disable its LE_ERROR().
+    SendLogCmd("level", "WARNING", "*/Comp_1");
+    SendLogCmd("disable", callSite, "*/Comp_1");
+    LogMessages();
+
+    CheckNextLine("*EMR* | framework | log.c, log_TestFrameworkMsgs");
+
+    CheckNextLine("-WRN- | Comp_1 | component1.c, comp1_Foo");
+    CheckNextLine("*CRT* | Comp_1 | component1.c, comp1_Foo");
+    CheckNextLine("*EMR* | Comp_1 | component1.c, comp1_Foo");
+
+    // The same level in another file of the component is still logged.
+    CheckNextLine("-WRN- | Comp_1 | component1Helper.c, comp1_HelperFoo");
+    CheckNextLine("=ERR= | Comp_1 | component1Helper.c, comp1_HelperFoo");
+    CheckNextLine("*CRT* | Comp_1 | component1Helper.c, comp1_HelperFoo");
+    CheckNextLine("*EMR* | Comp_1 | component1Helper.c, comp1_HelperFoo");
+
+    CheckNextLine("*EMR* | Comp_2 | component2.c, comp2_Foo");
+
+    // Enable it again.
+    SendLogCmd("enable", callSite, "*/Comp_1");
+    LogMessages();
+
+    CheckNextLine("*EMR* | framework | log.c, log_TestFrameworkMsgs");
+
+    CheckNextLine("-WRN- | Comp_1 | component1.c, comp1_Foo");
+    CheckNextLine("=ERR= | Comp_1 | component1.c, comp1_Foo");
+    CheckNextLine("*CRT* | Comp_1 | component1.c, comp1_Foo");
+    CheckNextLine("*EMR* | Comp_1 | component1.c, comp1_Foo");
+
+    CheckNextLine("-WRN- | Comp_1 | component1Helper.c, comp1_HelperFoo");
+    CheckNextLine("=ERR= | Comp_1 | component1Helper.c, comp1_HelperFoo");
+    CheckNextLine("*CRT* | Comp_1 | component1Helper.c, comp1_HelperFoo");
+    CheckNextLine("*EMR* | Comp_1 | component1Helper.c, comp1_HelperFoo");
+
+    CheckNextLine("*EMR* | Comp_2 | component2.c, comp2_Foo");
+
+    // Reset the level of component 1.
+    SendLogCmd("level", "EMERGENCY", "*/Comp_1");
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test the messages compiled out of component 3 by LE_LOG_COMPILE_LEVEL: they are not logged even
+ * at the DEBUG level, and their parameters are not evaluated.
+ */
+//--------------------------------------------------------------------------------------------------
+void TestCompileLevelComp3(void)
+{
+    SendLogCmd("level", "DEBUG", "*/Comp_3");
+
+    LE_ASSERT(comp3_Foo() == 4);
+
+    CheckNextLine("-WRN- | Comp_3 | component3.c, comp3_Foo");
+    CheckNextLine("=ERR= | Comp_3 | component3.c, comp3_Foo");
+    CheckNextLine("*CRT* | Comp_3 | component3.c, comp3_Foo");
+    CheckNextLine("*EMR* | Comp_3 | component3.c, comp3_Foo");
+
+    SendLogCmd("level", "EMERGENCY", "*/Comp_3");
+}
+
+
 le_log_SessionRef_t comp1_LogSession;
 le_log_SessionRef_t comp2_LogSession;
+le_log_SessionRef_t comp3_LogSession;
 
 le_log_Level_t* comp1_LogLevelFilterPtr;
 le_log_Level_t* comp2_LogLevelFilterPtr;
+le_log_Level_t* comp3_LogLevelFilterPtr;
 
 COMPONENT_INIT
 {
@@ -520,8 +618,10 @@ COMPONENT_INIT
     // component inits.
     comp1_LogSession = log_RegComponent("Comp_1", &comp1_LogLevelFilterPtr);
     comp2_LogSession = log_RegComponent("Comp_2", &comp2_LogLevelFilterPtr);
+    comp3_LogSession = log_RegComponent("Comp_3", &comp3_LogLevelFilterPtr);
     comp1_Init();
     comp2_Init();
+    comp3_Init();
 
     // Open the test file where the log messages are being written to.
     LogFile = fopen(TESTLOG_STDERR_FILE_PATH, "r");
@@ -544,4 +644,6 @@ COMPONENT_INIT
     TestTraceAll();
     TestTraceFramework();
     TestStopTraceAll();
+    TestCallSiteComp1();
+    TestCompileLevelComp3();
 }
@@ -21,14 +21,19 @@ if [ -z "$LOGTEST_PATH" ]; then
     echo "LOGTEST_PATH not set, default to $LOGTEST_PATH"
 fi
 
+# Line of the call site of component 1 disabled and enabled by the test.
+export COMP1_ERROR_LINE=$(grep -n 'LE_ERROR(' $SCRIPT_DIR/component1.c | cut -d: -f1)
+
 LOGDAEMON_SOCKET="/tmp/le_LogDaemon"
 LOGTOOL_SOCKET="/tmp/logTool"
 
 echo "LOGDAEMON_PATH=$LOGDAEMON_PATH"
 echo "LOGTOOL_PATH=$LOGTOOL_PATH"
 echo "LOG_STDERR_PATH=$LOG_STDERR_PATH"
+echo "COMP1_ERROR_LINE=$COMP1_ERROR_LINE"
 
-if [[ ! -f $LOGDAEMON_PATH ]] || [[ ! -f $LOGTOOL_PATH ]] || [[ ! -f $LOGTEST_PATH ]]; then
+if [[ ! -f $LOGDAEMON_PATH ]] || [[ ! -f $LOGTOOL_PATH ]] || [[ ! -f $LOGTEST_PATH ]] ||
+   [[ -z $COMP1_ERROR_LINE ]]; then
     echo "A path is not good"
     exit -1
 fi
@@ -0,0 +1,364 @@
+/**
+ * Test the persistent log store of the log daemon.
+ *
+ * Records of two apps are written by two processes in turn, enough of them to fill several segment
+ * files.  The last block written is then cut in the middle, as a power failure during its write
+ * would leave it, and the index is loaded again by this process, which queries the records by app,
+ * time and level.  Records added after the reload must be appended after the cut.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "logStore.h"
+#include <dirent.h>
+#include <sys/wait.h>
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of records of each app, and one in ERROR_PERIOD of them is logged at the error level.
+ */
+//--------------------------------------------------------------------------------------------------
+#define APP_A_RECORDS       2000
+#define APP_B_RECORDS       500
+#define ERROR_PERIOD        10
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of records of the block cut by the simulated power failure.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LOST_RECORDS        5
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Length of the random part of the messages, which keeps the blocks from compressing too well.
+ */
+//--------------------------------------------------------------------------------------------------
+#define PAYLOAD_LEN         400
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of bytes cut from the end of the newest segment.
+ */
+//--------------------------------------------------------------------------------------------------
+#define CUT_BYTES           10
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Directory of the store.
+ */
+//--------------------------------------------------------------------------------------------------
+static char StoreDir[] = "/tmp/logStoreTest.XXXXXX";
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Result of a query.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    size_t          count;              ///< Number of records reported.
+    uint64_t        lastTimeMs;         ///< Time of the last record reported.
+    char            lastMsg[64];        ///< Beginning of the message of the last record.
+    const char*     appNamePtr;         ///< App every record must belong to, or NULL.
+    le_log_Level_t  level;              ///< Least severe level of every record.
+}
+QueryResult_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the current time in milliseconds since the Epoch.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t GetTimeMs
+(
+    void
+)
+{
+    le_clk_Time_t now = le_clk_GetAbsoluteTime();
+
+    return (uint64_t)now.sec * 1000 + now.usec / 1000;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds a record with a random payload to the store.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AppendRecord
+(
+    const char*     appNamePtr,
+    le_log_Level_t  level,
+    const char*     prefixPtr,
+    int             index
+)
+{
+    static const char digits[] = "0123456789abcdef";
+    char msg[PAYLOAD_LEN + 64];
+    int len = snprintf(msg, sizeof(msg), "%s %04d ", prefixPtr, index);
+    int i;
+
+    for (i = 0; i < PAYLOAD_LEN; i++)
+    {
+        msg[len++] = digits[random() % 16];
+    }
+
+    logStore_Append(level, appNamePtr, "proc", getpid(), msg, len);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes the records of an app from a child process, which leaves the store as the log daemon
+ * would when it exits.
+ */
+//--------------------------------------------------------------------------------------------------
+static void WriteApp
+(
+    const char* appNamePtr,
+    int         numRecords,
+    bool        withLostBlock
+)
+{
+    pid_t pid = fork();
+    LE_ASSERT(pid != -1);
+
+    if (pid == 0)
+    {
+        int i;
+
+        logStore_Init(StoreDir);
+
+        for (i = 0; i < numRecords; i++)
+        {
+            AppendRecord(appNamePtr, (i % ERROR_PERIOD == 0) ? LE_LOG_ERR : LE_LOG_INFO, "msg", i);
+        }
+
+        logStore_Flush();
+
+        if (withLostBlock)
+        {
+            for (i = 0; i < LOST_RECORDS; i++)
+            {
+                AppendRecord(appNamePtr, LE_LOG_ERR, "lost", i);
+            }
+
+            logStore_Flush();
+        }
+
+        _exit(EXIT_SUCCESS);
+    }
+
+    int status;
+    LE_ASSERT(waitpid(pid, &status, 0) == pid);
+    LE_ASSERT(WIFEXITED(status) && (WEXITSTATUS(status) == EXIT_SUCCESS));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the path of the newest segment file, and returns the number of segment files.
+ */
+//--------------------------------------------------------------------------------------------------
+static int GetNewestSegment
+(
+    char*   pathPtr,
+    size_t  pathSize
+)
+{
+    DIR* dirPtr = opendir(StoreDir);
+    LE_ASSERT(dirPtr != NULL);
+
+    char newestName[NAME_MAX + 1] = "";
+    int numSegments = 0;
+    struct dirent* entryPtr;
+
+    while ((entryPtr = readdir(dirPtr)) != NULL)
+    {
+        if (strstr(entryPtr->d_name, ".seg") != NULL)
+        {
+            numSegments++;
+
+            if (strcmp(entryPtr->d_name, newestName) > 0)
+            {
+                LE_ASSERT_OK(le_utf8_Copy(newestName, entryPtr->d_name, sizeof(newestName), NULL));
+            }
+        }
+    }
+
+    closedir(dirPtr);
+
+    LE_ASSERT(snprintf(pathPtr, pathSize, "%s/%s", StoreDir, newestName) < pathSize);
+
+    return numSegments;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the size of a file.
+ */
+//--------------------------------------------------------------------------------------------------
+static off_t GetFileSize
+(
+    const char* pathPtr
+)
+{
+    struct stat st;
+
+    LE_ASSERT(stat(pathPtr, &st) == 0);
+
+    return st.st_size;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Query handler, checking each record against the query.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RecordHandler
+(
+    const logStore_Record_t* recordPtr,
+    void* contextPtr
+)
+{
+    QueryResult_t* resultPtr = contextPtr;
+
+    LE_ASSERT(recordPtr->level >= resultPtr->level);
+    LE_ASSERT(strcmp(recordPtr->procNamePtr, "proc") == 0);
+    LE_ASSERT(strncmp(recordPtr->msgPtr, "lost", 4) != 0);
+
+    if (resultPtr->appNamePtr != NULL)
+    {
+        LE_ASSERT(strcmp(recordPtr->appNamePtr, resultPtr->appNamePtr) == 0);
+    }
+
+    // The records are reported from the oldest to the newest.
+    LE_ASSERT(recordPtr->timeMs >= resultPtr->lastTimeMs);
+
+    resultPtr->count++;
+    resultPtr->lastTimeMs = recordPtr->timeMs;
+    snprintf(resultPtr->lastMsg, sizeof(resultPtr->lastMsg), "%s", recordPtr->msgPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Runs a query and returns the number of records reported.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t RunQuery
+(
+    const char*     appNamePtr,
+    le_log_Level_t  level,
+    uint64_t        sinceMs,
+    size_t          maxRecords,
+    QueryResult_t*  resultPtr
+)
+{
+    logStore_Query_t query =
+    {
+        .appNamePtr = appNamePtr,
+        .procNamePtr = NULL,
+        .level = level,
+        .sinceMs = sinceMs,
+        .maxRecords = maxRecords
+    };
+
+    memset(resultPtr, 0, sizeof(*resultPtr));
+    resultPtr->appNamePtr = appNamePtr;
+    resultPtr->level = level;
+
+    LE_ASSERT_OK(logStore_Query(&query, RecordHandler, resultPtr));
+
+    LE_INFO("Query app '%s', level %d, since %" PRIu64 ": %zu records.",
+            (appNamePtr == NULL) ? "*" : appNamePtr, level, sinceMs, resultPtr->count);
+
+    return resultPtr->count;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Removes the store directory.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RemoveStore
+(
+    void
+)
+{
+    le_dir_RemoveRecursive(StoreDir);
+}
+
+COMPONENT_INIT
+{
+    QueryResult_t result;
+    char newestPath[PATH_MAX];
+
+    LE_INFO("======== Start log store test ========");
+
+    LE_ASSERT(mkdtemp(StoreDir) != NULL);
+    atexit(RemoveStore);
+
+    srandom(1);
+
+    LE_INFO("Write the records of appA.");
+    WriteApp("appA", APP_A_RECORDS, false);
+
+    // Separate the records of the two apps in time.
+    usleep(20 * 1000);
+    uint64_t appBTimeMs = GetTimeMs();
+    usleep(20 * 1000);
+
+    LE_INFO("Write the records of appB, then a block which is cut.");
+    WriteApp("appB", APP_B_RECORDS, true);
+
+    int numSegments = GetNewestSegment(newestPath, sizeof(newestPath));
+    LE_INFO("%d segments written.", numSegments);
+    LE_ASSERT(numSegments > 1);
+
+    off_t size = GetFileSize(newestPath);
+    LE_ASSERT(truncate(newestPath, size - CUT_BYTES) == 0);
+
+    LE_INFO("Load the index again.");
+    logStore_Init(StoreDir);
+
+    // The partial block is cut off whole.
+    off_t cutSize = GetFileSize(newestPath);
+    LE_ASSERT(cutSize < size - CUT_BYTES);
+
+    LE_ASSERT(RunQuery(NULL, LE_LOG_DEBUG, 0, SIZE_MAX, &result) == APP_A_RECORDS + APP_B_RECORDS);
+
+    LE_INFO("Query by app.");
+    LE_ASSERT(RunQuery("appA", LE_LOG_DEBUG, 0, SIZE_MAX, &result) == APP_A_RECORDS);
+    LE_ASSERT(RunQuery("appB", LE_LOG_DEBUG, 0, SIZE_MAX, &result) == APP_B_RECORDS);
+    LE_ASSERT(RunQuery("appC", LE_LOG_DEBUG, 0, SIZE_MAX, &result) == 0);
+
+    LE_INFO("Query by time.");
+    LE_ASSERT(RunQuery(NULL, LE_LOG_DEBUG, appBTimeMs, SIZE_MAX, &result) == APP_B_RECORDS);
+    LE_ASSERT(RunQuery("appA", LE_LOG_DEBUG, appBTimeMs, SIZE_MAX, &result) == 0);
+    LE_ASSERT(RunQuery(NULL, LE_LOG_DEBUG, GetTimeMs() + 1000, SIZE_MAX, &result) == 0);
+
+    LE_INFO("Query by level.");
+    LE_ASSERT(RunQuery(NULL, LE_LOG_ERR, 0, SIZE_MAX, &result) ==
+              (APP_A_RECORDS + APP_B_RECORDS) / ERROR_PERIOD);
+    LE_ASSERT(RunQuery("appB", LE_LOG_ERR, appBTimeMs, SIZE_MAX, &result) ==
+              APP_B_RECORDS / ERROR_PERIOD);
+    LE_ASSERT(RunQuery(NULL, LE_LOG_CRIT, 0, SIZE_MAX, &result) == 0);
+
+    LE_INFO("Query the newest records.");
+    LE_ASSERT(RunQuery("appA", LE_LOG_DEBUG, 0, 3, &result) == 3);
+    LE_ASSERT(strncmp(result.lastMsg, "msg 1999 ", 9) == 0);
+    LE_ASSERT(RunQuery(NULL, LE_LOG_DEBUG, 0, 150, &result) == 150);
+    LE_ASSERT(strncmp(result.lastMsg, "msg 0499 ", 9) == 0);
+
+    LE_INFO("Append after the cut.");
+    AppendRecord("appC", LE_LOG_INFO, "msg", 0);
+    LE_ASSERT(RunQuery("appC", LE_LOG_DEBUG, 0, SIZE_MAX, &result) == 1);
+    logStore_Flush();
+    LE_ASSERT(GetFileSize(newestPath) > cutSize);
+    LE_ASSERT(RunQuery("appC", LE_LOG_DEBUG, 0, SIZE_MAX, &result) == 1);
+    LE_ASSERT(RunQuery(NULL, LE_LOG_DEBUG, 0, SIZE_MAX, &result) ==
+              APP_A_RECORDS + APP_B_RECORDS + 1);
+
+    LE_INFO("======== Log store test PASSED ========");
+
+    exit(EXIT_SUCCESS);
+}
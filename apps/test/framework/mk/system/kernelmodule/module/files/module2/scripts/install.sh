@@ -3,4 +3,4 @@
 
 KO_PATH=$1
 
-insmod KO_PATH
+insmod $KO_PATH
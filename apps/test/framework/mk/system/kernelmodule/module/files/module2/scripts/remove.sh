@@ -3,4 +3,4 @@
 
 KO_PATH=$1
 
-rmmod KO_PATH
+rmmod $KO_PATH
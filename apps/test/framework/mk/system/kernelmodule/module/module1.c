@@ -10,9 +10,14 @@ static char *param2 = "PARAM2";
 module_param(param2, charp, S_IRUGO);
 MODULE_PARM_DESC(param2, "Second module parameter");
 
+static int param3 = 0;
+module_param(param3, int, S_IRUGO);
+MODULE_PARM_DESC(param3, "Third module parameter");
+
 static int __init module1_init(void)
 {
-   pr_info("Executing %s(), param1='%s' param2='%s'.\n", __func__, param1, param2);
+   pr_info("Executing %s(), param1='%s' param2='%s' param3=%d.\n",
+           __func__, param1, param2, param3);
    return 0;
 }
 
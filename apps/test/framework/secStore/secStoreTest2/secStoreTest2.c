@@ -1,3 +1,5 @@
+#include <arpa/inet.h>
+
 #include "legato.h"
 #include "interfaces.h"
 
@@ -258,6 +260,174 @@ static void Test6
     LE_INFO(" ");
 }
 
+// writing an item from a file descriptor
+// reading an item to a file descriptor
+// checking the item size
+static void Test7
+(
+    void
+)
+{
+    LE_INFO("############################################################################################");
+    LE_INFO("#################### Test7 #################################################################");
+    LE_INFO("############################################################################################");
+
+    char outBuffer[1024] = {0};
+    uint32_t itemSize = 0;
+    int pipeFds[2];
+    le_result_t result;
+
+
+    LE_INFO("=======================   Create a 10-byte file from a pipe.   ==============================");
+    LE_ASSERT(pipe(pipeFds) == 0);
+    LE_ASSERT(write(pipeFds[1], "string321", 10) == 10);
+    close(pipeFds[1]);
+
+    result = le_secStore_WriteFromFd("file1", pipeFds[0]);
+    LE_FATAL_IF(result != LE_OK, "write from fd failed: [%s]", LE_RESULT_TXT(result));
+
+
+    LE_INFO("=======================   Get the size of the file.   =================================");
+    result = le_secStore_GetItemSize("file1", &itemSize);
+    LE_FATAL_IF(result != LE_OK, "get size failed: [%s]", LE_RESULT_TXT(result));
+    LE_FATAL_IF(itemSize != 10, "unexpected item size %" PRIu32, itemSize);
+
+
+    LE_INFO("=======================   Read the file into a pipe.   =================================");
+    LE_ASSERT(pipe(pipeFds) == 0);
+
+    result = le_secStore_ReadToFd("file1", pipeFds[1]);
+    LE_FATAL_IF(result != LE_OK, "read to fd failed: [%s]", LE_RESULT_TXT(result));
+
+    ssize_t readCount = read(pipeFds[0], outBuffer, sizeof(outBuffer));
+    close(pipeFds[0]);
+
+    if ( (readCount != 10) || (strcmp(outBuffer, "string321") != 0) )
+    {
+        LE_FATAL("Reading secStore item resulting in unexpected item contents: [%s]", outBuffer);
+    }
+    else
+    {
+        LE_INFO("secStore item read: [%s]", outBuffer);
+    }
+
+
+    LE_INFO("=======================   Delete the file and check it is gone.   ====================================");
+    result = le_secStore_Delete("file1");
+    LE_FATAL_IF(result != LE_OK, "delete failed: [%s]", LE_RESULT_TXT(result));
+
+    result = le_secStore_GetItemSize("file1", &itemSize);
+    LE_FATAL_IF(result != LE_NOT_FOUND, "get size failed: [%s]", LE_RESULT_TXT(result));
+
+    LE_INFO("#################### END OF Test7 #################################################################");
+    LE_INFO(" ");
+}
+
+// Append one batch record to a buffer.
+static size_t AddBatchRecord
+(
+    uint8_t* bufPtr,
+    const char* namePtr,
+    const char* dataPtr,
+    uint32_t dataSize
+)
+{
+    size_t nameSize = strlen(namePtr) + 1;
+    uint32_t netSize = htonl(dataSize);
+
+    memcpy(bufPtr, namePtr, nameSize);
+    memcpy(bufPtr + nameSize, &netSize, sizeof(netSize));
+    memcpy(bufPtr + nameSize + sizeof(netSize), dataPtr, dataSize);
+
+    return nameSize + sizeof(netSize) + dataSize;
+}
+
+// writing several items in one batch
+// reading several items, including a non-existing one, in one batch
+// delete the items
+static void Test8
+(
+    void
+)
+{
+    LE_INFO("############################################################################################");
+    LE_INFO("#################### Test8 #################################################################");
+    LE_INFO("############################################################################################");
+
+    uint8_t batch[1024] = {0};
+    size_t batchSize = 0;
+    uint32_t numItems = 0;
+    int pipeFds[2];
+    le_result_t result;
+
+
+    LE_INFO("=======================   Write two files in a batch.   ==============================");
+    batchSize += AddBatchRecord(batch + batchSize, "file1", "string321", 10);
+    batchSize += AddBatchRecord(batch + batchSize, "dir/file2", "abc", 4);
+
+    LE_ASSERT(pipe(pipeFds) == 0);
+    LE_ASSERT(write(pipeFds[1], batch, batchSize) == (ssize_t)batchSize);
+    close(pipeFds[1]);
+
+    result = le_secStore_WriteBatch(pipeFds[0], &numItems);
+    LE_FATAL_IF(result != LE_OK, "write batch failed: [%s]", LE_RESULT_TXT(result));
+    LE_FATAL_IF(numItems != 2, "unexpected number of items written %" PRIu32, numItems);
+
+
+    LE_INFO("=======================   Read the files back in a batch.   =================================");
+    static const uint8_t names[] = "file1\0file3\0dir/file2";
+
+    LE_ASSERT(pipe(pipeFds) == 0);
+
+    result = le_secStore_ReadBatch(names, sizeof(names), pipeFds[1], &numItems);
+    LE_FATAL_IF(result != LE_OK, "read batch failed: [%s]", LE_RESULT_TXT(result));
+    LE_FATAL_IF(numItems != 2, "unexpected number of items read %" PRIu32, numItems);
+
+    uint8_t outBatch[1024] = {0};
+    ssize_t readCount = read(pipeFds[0], outBatch, sizeof(outBatch));
+    close(pipeFds[0]);
+
+    if ( (readCount != (ssize_t)batchSize) || (memcmp(outBatch, batch, batchSize) != 0) )
+    {
+        LE_FATAL("Reading secStore batch resulting in unexpected contents.");
+    }
+
+
+    LE_INFO("=======================   Write the same file twice in a batch.   ===================");
+    char outBuffer[100] = {0};
+    size_t outBufferSize = sizeof(outBuffer);
+
+    batchSize = AddBatchRecord(batch, "file1", "first", 6);
+    batchSize += AddBatchRecord(batch + batchSize, "file1", "second", 7);
+
+    LE_ASSERT(pipe(pipeFds) == 0);
+    LE_ASSERT(write(pipeFds[1], batch, batchSize) == (ssize_t)batchSize);
+    close(pipeFds[1]);
+
+    result = le_secStore_WriteBatch(pipeFds[0], &numItems);
+    LE_FATAL_IF(result != LE_OK, "write batch failed: [%s]", LE_RESULT_TXT(result));
+    LE_FATAL_IF(numItems != 1, "unexpected number of items written %" PRIu32, numItems);
+
+    result = le_secStore_Read("file1", (uint8_t*)outBuffer, &outBufferSize);
+    LE_FATAL_IF(result != LE_OK, "read failed: [%s]", LE_RESULT_TXT(result));
+
+    if (strcmp(outBuffer, "second") != 0)
+    {
+        LE_FATAL("Reading secStore item resulting in unexpected item contents: [%s]", outBuffer);
+    }
+
+
+    LE_INFO("=======================   Delete the files.   ====================================");
+    result = le_secStore_Delete("file1");
+    LE_FATAL_IF(result != LE_OK, "delete failed: [%s]", LE_RESULT_TXT(result));
+
+    result = le_secStore_Delete("dir");
+    LE_FATAL_IF(result != LE_OK, "delete failed: [%s]", LE_RESULT_TXT(result));
+
+    LE_INFO("#################### END OF Test8 #################################################################");
+    LE_INFO(" ");
+}
+
 
 COMPONENT_INIT
 {
@@ -271,6 +441,8 @@ COMPONENT_INIT
     Test4();
     Test5();
     Test6();
+    Test7();
+    Test8();
 
     LE_INFO("============ SecStoreTest2 PASSED =============");
 
@@ -96,4 +96,93 @@ le_result_t secStoreGlobal_Read
 le_result_t secStoreGlobal_Delete
 (
     const char* name    ///< [IN] Name of the secure storage item.
-);
\ No newline at end of file
+);
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the size of an item in secure storage.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_NOT_FOUND if the item does not exist.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t secStoreGlobal_GetItemSize
+(
+    const char* name,               ///< [IN] Name of the secure storage item.
+    uint32_t* sizePtr               ///< [OUT] Size of the item in bytes.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes an item to secure storage, taking its value from a file descriptor.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_OVERFLOW if there is more than LE_SECSTORE_MAX_STREAM_SIZE bytes to read.
+ *      LE_NO_MEMORY if there is not enough memory to store the item.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t secStoreGlobal_WriteFromFd
+(
+    const char* name,               ///< [IN] Name of the secure storage item.
+    int fd                          ///< [IN] File descriptor to read the value from.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads an item from secure storage into a file descriptor.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_NOT_FOUND if the item does not exist.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t secStoreGlobal_ReadToFd
+(
+    const char* name,               ///< [IN] Name of the secure storage item.
+    int fd                          ///< [IN] File descriptor to write the value to.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes several items to secure storage from batch records read from a file descriptor.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_OVERFLOW if there is more than LE_SECSTORE_MAX_STREAM_SIZE bytes to read.
+ *      LE_FORMAT_ERROR if the records are malformed.
+ *      LE_NO_MEMORY if there is not enough memory to store the items.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t secStoreGlobal_WriteBatch
+(
+    int fd,                         ///< [IN] File descriptor to read the records from.
+    uint32_t* numItemsPtr           ///< [OUT] Number of items written.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads several items from secure storage and writes them as batch records to a file descriptor.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_OVERFLOW if the records would be larger than LE_SECSTORE_MAX_STREAM_SIZE bytes.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t secStoreGlobal_ReadBatch
+(
+    const uint8_t* namesPtr,        ///< [IN] Consecutive NUL-terminated item names.
+    size_t namesSize,               ///< [IN] Size of the names buffer.
+    int fd,                         ///< [IN] File descriptor to write the records to.
+    uint32_t* numItemsPtr           ///< [OUT] Number of items found and written.
+);
@@ -0,0 +1,85 @@
+#!/bin/bash
+
+# Kernel module loading test.
+#
+# The target must run the system built from apps/test/framework/mk/system/basic.sdef, which bundles
+# the modules of apps/test/framework/mk/system/kernelmodule. Modules without an install script are
+# loaded with finit_module(), or with insmod when the kernel does not provide it: the path expected
+# from the supervisor depends on the kernel of the target.
+
+LoadTestLib
+
+targetAddr=$1
+targetType=${2:-ar7}
+
+OnFail() {
+    echo "Kernel Module Test Failed!"
+}
+
+OnExit() {
+    ssh root@$targetAddr "$BIN_PATH/kmod unload module5.ko" > /dev/null 2>&1
+}
+
+echo "******** Kernel Module Test Starting ***********"
+
+echo "Make sure Legato is running."
+ssh root@$targetAddr "$BIN_PATH/legato start"
+CheckRet
+
+if ssh root@$targetAddr "grep -q 'sys_finit_module$' /proc/kallsyms"
+then
+    echo "Kernel provides finit_module()."
+    fallbackCount=0
+else
+    echo "Kernel does not provide finit_module(), insmod is expected."
+    fallbackCount=1
+fi
+
+echo "Check the parameters of the module loaded at start-up."
+ssh root@$targetAddr "grep -qx 'module1' /sys/module/module1/parameters/param1 &&
+                      grep -qx 'loadable kernel module' /sys/module/module1/parameters/param2 &&
+                      grep -qx '3' /sys/module/module1/parameters/param3"
+CheckRet
+
+ClearLogs
+
+echo "Load a manual module."
+ssh root@$targetAddr "$BIN_PATH/kmod load module5.ko"
+CheckRet
+
+ssh root@$targetAddr "grep -qx 'module5' /sys/module/module5/parameters/param1 &&
+                      grep -qx 'manually loaded kernel module' /sys/module/module5/parameters/param2 &&
+                      grep -qx '5' /sys/module/module5/parameters/param3"
+CheckRet
+
+CheckLogStr "==" 1 "Load '.*/module5.ko'"
+CheckLogStr "==" $fallbackCount "finit_module() is not supported, falling back to /sbin/insmod"
+CheckLogStr "==" 1 "New kernel module 'module5.ko'"
+
+echo "Unload the manual module."
+ssh root@$targetAddr "$BIN_PATH/kmod unload module5.ko"
+CheckRet
+
+ssh root@$targetAddr "test ! -e /sys/module/module5"
+CheckRet
+
+if [ $fallbackCount -eq 0 ]
+then
+    ClearLogs
+
+    echo "Load a manual module already inserted outside of the supervisor."
+    ssh root@$targetAddr "insmod /legato/systems/current/modules/module5.ko"
+    CheckRet
+
+    ssh root@$targetAddr "$BIN_PATH/kmod load module5.ko"
+    CheckRet
+
+    CheckLogStr "==" 1 "Module 'module5.ko' is already loaded."
+    CheckLogStr "==" 1 "New kernel module 'module5.ko'"
+
+    ssh root@$targetAddr "$BIN_PATH/kmod unload module5.ko"
+    CheckRet
+fi
+
+echo "Kernel Module Test Passed!"
+exit 0
@@ -40,6 +40,7 @@ done
 
 InstallApp ForkChildApp
 InstallApp NonSandboxedForkChildApp
+InstallApp RealtimeApp
 
 echo "Stop all other apps."
 ssh root@$targetAddr "$BIN_PATH/app stop \"*\""
@@ -73,6 +74,33 @@ CheckRet
 ssh root@$targetAddr  "$BIN_PATH/app stop NonSandboxedForkChildApp"
 CheckRet
 
+echo "Testing realtime processes in the app cgroups."
+
+ssh root@$targetAddr  "$BIN_PATH/app start RealtimeApp"
+CheckRet
+
+sleep 1
+
+ssh root@$targetAddr  "$BIN_PATH/app status RealtimeApp | grep -q '^\[running\]'"
+CheckRet
+
+# Both processes must be in the freezer cgroup of the app, which is used to kill them.  Realtime
+# processes are only kept out of the cpu cgroup of the app.
+ssh root@$targetAddr  "if [ -e /sys/fs/cgroup/cgroup.controllers ]
+                       then
+                           procs=/sys/fs/cgroup/RealtimeApp/cgroup.procs
+                       else
+                           procs=/sys/fs/cgroup/freezer/RealtimeApp/cgroup.procs
+                       fi
+                       test \$(wc -l < \$procs) -eq 2"
+CheckRet
+
+ssh root@$targetAddr  "$BIN_PATH/app stop RealtimeApp"
+CheckRet
+
+ssh root@$targetAddr  "! pgrep -f 'RealtimeApp noExit'"
+CheckRet
+
 ClearLogs
 
 echo "Run the apps."
@@ -9,6 +9,8 @@
 #define APP_USER_NAME   "appAthens"
 #define APP_NAME        "Athens"
 #define GROUP_NAME      "testGroup"
+#define EXT_GROUP_NAME  "testExtGroup"
+#define EXT_GROUP_ID    59999
 
 uid_t Uid, AppUid;
 gid_t Gid, AppGid;
@@ -113,10 +115,35 @@ static void TestGroupDelete(void)
 }
 
 
+static void TestExternalChange(void)
+{
+    // Fill the group index, then add a group behind its back.
+    gid_t gid;
+    LE_ASSERT(user_GetGid(EXT_GROUP_NAME, &gid) == LE_NOT_FOUND);
+
+    FILE* filePtr = fopen("/etc/group", "a");
+    LE_ASSERT(filePtr != NULL);
+    fprintf(filePtr, "%s:*:%d:\n", EXT_GROUP_NAME, EXT_GROUP_ID);
+    LE_ASSERT(fclose(filePtr) == 0);
+
+    LE_ASSERT(user_GetGid(EXT_GROUP_NAME, &gid) == LE_OK);
+    LE_ASSERT(gid == EXT_GROUP_ID);
+
+    char buf[100];
+    LE_ASSERT(user_GetGroupName(EXT_GROUP_ID, buf, sizeof(buf)) == LE_OK);
+    LE_ASSERT(strcmp(buf, EXT_GROUP_NAME) == 0);
+
+    LE_ASSERT(user_DeleteGroup(EXT_GROUP_NAME) == LE_OK);
+    LE_ASSERT(user_GetGroupName(EXT_GROUP_ID, buf, sizeof(buf)) == LE_NOT_FOUND);
+}
+
+
 COMPONENT_INIT
 {
     LE_INFO("======== Starting Users Test ========");
 
+    user_Init();
+
     // These functions should be called together in this order.
     TestUserCreation();
     TestUserNameAndId();
@@ -129,6 +156,9 @@ COMPONENT_INIT
     TestGroupCreation();
     TestGroupDelete();
 
+    // Changes made without this API must be seen by the lookups.
+    TestExternalChange();
+
     LE_INFO("======== Users Test Completed Successfully ========");
     exit(EXIT_SUCCESS);
 }
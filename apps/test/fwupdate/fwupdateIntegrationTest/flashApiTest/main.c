@@ -50,6 +50,8 @@ static le_result_t FlashApiTest_Info(char **args);
 static le_result_t FlashApiTest_Dump(char **args);
 static le_result_t FlashApiTest_Flash(char **args);
 static le_result_t FlashApiTest_FlashErase(char **args);
+static le_result_t FlashApiTest_FlashFd(char **args);
+static le_result_t FlashApiTest_Bench(char **args);
 static le_result_t FlashApiTest_Copy(char **args);
 static le_result_t FlashApiTest_InfoUbi(char **args);
 static le_result_t FlashApiTest_DumpUbi(char **args);
@@ -78,6 +80,13 @@ static FlashApiTest_t FlashApiTest[] =
     { "flash-erase",    2, FlashApiTest_FlashErase,
       "flash-erase paritionName fileName: flash the file into the given"
            " partition and erase remaining blocks",                             },
+    { "flash-fd",       2, FlashApiTest_FlashFd,
+      "flash-fd paritionName fileName: flash the file into the given partition"
+           " in a single transfer",                                             },
+    { "bench",          2, FlashApiTest_Bench,
+      "bench paritionName fileName: flash the file into the given partition"
+           " block by block, then in a single transfer, and read it back in a"
+           " single transfer. Report the throughput of each method",            },
     { "copy",           2, FlashApiTest_Copy,
       "copy sourceName destinationName: copy in raw the source to the"
            " destination",                                                      },
@@ -525,6 +534,214 @@ static le_result_t FlashApiTest_FlashErase
 }
 //! [FlashErase]
 
+//! [FlashFd]
+//--------------------------------------------------------------------------------------------------
+/**
+ * Flash a file into a MTD partition in a single transfer
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t FlashApiTest_FlashFd
+(
+    char **args
+)
+{
+    const char *partNameStr = args[0];
+    const char *fromFile = args[1];
+    le_flash_PartitionRef_t partRef = NULL;
+    le_result_t res;
+    uint32_t blockCount;
+    int fromFd;
+
+    fromFd = open(fromFile, O_RDONLY);
+    if (-1 == fromFd)
+    {
+        LE_ERROR("Failed to open '%s': %m", fromFile);
+        return LE_FAULT;
+    }
+
+    // Open the given MTD partition in W/O
+    res = le_flash_OpenMtd(partNameStr, LE_FLASH_WRITE_ONLY, &partRef);
+    LE_INFO("partition \"%s\" open ref %p, res %d", partNameStr, partRef, res);
+    if (LE_OK != res)
+    {
+        close(fromFd);
+        return res;
+    }
+
+    // The whole file is written from the block 0. The file descriptor is sent to the flash
+    // service, which reads the file while the blocks are programmed, erasing them first and
+    // skipping the bad blocks as le_flash_Write() does. The service closes its copy of the file
+    // descriptor.
+    res = le_flash_WriteFromFd(partRef, 0, fromFd, &blockCount);
+    close(fromFd);
+    if (LE_OK != res)
+    {
+        LE_ERROR("le_flash_WriteFromFd failed after %u blocks: %d", blockCount, res);
+        le_flash_Close(partRef);
+        return res;
+    }
+    LE_INFO("Written %u blocks to partition \"%s\"", blockCount, partNameStr);
+
+    // Close the MTD
+    res = le_flash_Close(partRef);
+    LE_INFO("partition \"%s\" close ref %p, res %d", partNameStr, partRef, res);
+    return res;
+}
+//! [FlashFd]
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the time elapsed since a start time, in seconds
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static double ElapsedSeconds
+(
+    le_clk_Time_t start
+)
+{
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), start);
+
+    return elapsed.sec + (elapsed.usec / 1000000.0);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Flash a file into a MTD partition block by block, then in a single transfer, then read it back
+ * in a single transfer, and report the throughput of each method. On a Linux host, the partition
+ * can be a nandsim or mtdram device.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t FlashApiTest_Bench
+(
+    char **args
+)
+{
+    const char *partNameStr = args[0];
+    const char *fromFile = args[1];
+    le_flash_PartitionRef_t partRef = NULL;
+    le_result_t res;
+    uint32_t badBlock, numBlock, eraseBlockSize, pageSize, blockIdx, blockCount;
+    ssize_t readSize;
+    int fromFd, toFd = -1;
+    uint8_t rData[LE_FLASH_MAX_READ_SIZE];
+    le_clk_Time_t start;
+    double megaBytes, seconds;
+    struct stat st;
+    char tmpFile[] = "/tmp/flashApiTestXXXXXX";
+    char line[128];
+
+    fromFd = open(fromFile, O_RDONLY);
+    if ((-1 == fromFd) || (-1 == fstat(fromFd, &st)))
+    {
+        LE_ERROR("Failed to open '%s': %m", fromFile);
+        if (-1 != fromFd)
+        {
+            close(fromFd);
+        }
+        return LE_FAULT;
+    }
+    megaBytes = st.st_size / (1024.0 * 1024.0);
+
+    // Open the given MTD partition in R/W
+    res = le_flash_OpenMtd(partNameStr, LE_FLASH_READ_WRITE, &partRef);
+    LE_INFO("partition \"%s\" open ref %p, res %d", partNameStr, partRef, res);
+    if (LE_OK != res)
+    {
+        close(fromFd);
+        return res;
+    }
+
+    res = le_flash_GetBlockInformation(partRef, &badBlock, &numBlock, &eraseBlockSize, &pageSize);
+    if ((LE_OK != res) || (eraseBlockSize > sizeof(rData)))
+    {
+        LE_ERROR("Unable to get the block information, or erase block too large: %d", res);
+        res = LE_FAULT;
+        goto end;
+    }
+
+    // One IPC call per block
+    start = le_clk_GetRelativeTime();
+    for (blockIdx = 0; blockIdx < numBlock; blockIdx++)
+    {
+        readSize = read(fromFd, rData, eraseBlockSize);
+        if (readSize <= 0)
+        {
+            break;
+        }
+        res = le_flash_Write(partRef, blockIdx, rData, readSize);
+        if (LE_OK != res)
+        {
+            LE_ERROR("le_flash_Write failed: %d", res);
+            goto end;
+        }
+    }
+    seconds = ElapsedSeconds(start);
+    snprintf(line, sizeof(line), "le_flash_Write:       %u blocks, %.3f s, %.2f MB/s",
+             blockIdx, seconds, megaBytes / seconds);
+    Print("%s", line);
+
+    // One transfer
+    lseek(fromFd, 0, SEEK_SET);
+    start = le_clk_GetRelativeTime();
+    res = le_flash_WriteFromFd(partRef, 0, fromFd, &blockCount);
+    seconds = ElapsedSeconds(start);
+    if (LE_OK != res)
+    {
+        LE_ERROR("le_flash_WriteFromFd failed: %d", res);
+        goto end;
+    }
+    snprintf(line, sizeof(line), "le_flash_WriteFromFd: %u blocks, %.3f s, %.2f MB/s",
+             blockCount, seconds, megaBytes / seconds);
+    Print("%s", line);
+
+    // Read back into a temporary file and compare with the file
+    toFd = mkstemp(tmpFile);
+    if (-1 == toFd)
+    {
+        LE_ERROR("Failed to create '%s': %m", tmpFile);
+        res = LE_FAULT;
+        goto end;
+    }
+    unlink(tmpFile);
+    start = le_clk_GetRelativeTime();
+    res = le_flash_ReadToFd(partRef, 0, blockCount, toFd);
+    seconds = ElapsedSeconds(start);
+    if (LE_OK != res)
+    {
+        LE_ERROR("le_flash_ReadToFd failed: %d", res);
+        goto end;
+    }
+    snprintf(line, sizeof(line), "le_flash_ReadToFd:    %u blocks, %.3f s, %.2f MB/s",
+             blockCount, seconds, megaBytes / seconds);
+    Print("%s", line);
+
+    lseek(fromFd, 0, SEEK_SET);
+    lseek(toFd, 0, SEEK_SET);
+    while ((readSize = read(fromFd, rData, eraseBlockSize)) > 0)
+    {
+        uint8_t flashData[LE_FLASH_MAX_READ_SIZE];
+
+        if ((readSize != read(toFd, flashData, readSize)) || memcmp(rData, flashData, readSize))
+        {
+            LE_ERROR("Data read back differ from '%s'", fromFile);
+            res = LE_FAULT;
+            break;
+        }
+    }
+
+end:
+    close(fromFd);
+    if (-1 != toFd)
+    {
+        close(toFd);
+    }
+    le_flash_Close(partRef);
+    return res;
+}
+
 //! [Copy]
 //--------------------------------------------------------------------------------------------------
 /**
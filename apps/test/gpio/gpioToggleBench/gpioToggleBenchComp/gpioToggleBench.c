@@ -0,0 +1,195 @@
+/**
+ * This module measures how fast a GPIO can be toggled and read through the le_gpio API. Each
+ * access is an IPC request to the GPIO service, which then goes through the backend it was built
+ * with:
+ *  - sysfs: the value file is opened, written and closed for each access (gpioSysfsUtils.c)
+ *  - character device: a line handle is kept open and each access is a single ioctl
+ *    (gpioChardev.c, built with GPIO_CHARDEV=1)
+ *
+ * Pins 1 and 2 are then toggled together with WritePins(), which the character device backend
+ * does with a single ioctl on a multi-line handle.
+ *
+ * The same test is run against both builds of the service to compare them.
+ *
+ * Options:
+ *  - --count=<n>        Number of accesses per test (default 10000)
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Command line options.
+ */
+//--------------------------------------------------------------------------------------------------
+static int Count = 10000;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the time elapsed since a start time, in microseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t ElapsedUs
+(
+    le_clk_Time_t start     ///< [IN] Start time
+)
+{
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), start);
+
+    return ((uint64_t)elapsed.sec * 1000000) + elapsed.usec;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Print the result of a test.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Report
+(
+    const char* namePtr,    ///< [IN] Test name
+    int accesses,           ///< [IN] Number of accesses done
+    uint64_t elapsedUs      ///< [IN] Time taken
+)
+{
+    if (elapsedUs == 0)
+    {
+        elapsedUs = 1;
+    }
+
+    LE_TEST_INFO("%-10s %8d accesses in %8" PRIu64 " us: %10" PRIu64 " accesses/s, "
+                 "%6.2f us/access",
+                 namePtr, accesses, elapsedUs, ((uint64_t)accesses * 1000000) / elapsedUs,
+                 (double)elapsedUs / accesses);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Toggle the pin as a push-pull output.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestToggle
+(
+    void
+)
+{
+    int i;
+
+    LE_TEST_OK(LE_OK == le_gpioPin1_SetPushPullOutput(LE_GPIOPIN1_ACTIVE_HIGH, false),
+               "pin set as output");
+
+    le_clk_Time_t start = le_clk_GetRelativeTime();
+    for (i = 0; i < Count; i++)
+    {
+        le_result_t result = (i & 1) ? le_gpioPin1_Deactivate() : le_gpioPin1_Activate();
+        if (LE_OK != result)
+        {
+            break;
+        }
+    }
+    uint64_t elapsedUs = ElapsedUs(start);
+
+    LE_TEST_OK(i == Count, "%d toggles done", i);
+    Report("toggle", i, elapsedUs);
+
+    // Check that the line really follows the last value written
+    LE_TEST_OK(le_gpioPin1_IsActive() == !((Count - 1) & 1), "last value read back");
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the pin as an input.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestRead
+(
+    void
+)
+{
+    int i;
+
+    LE_TEST_OK(LE_OK == le_gpioPin1_SetInput(LE_GPIOPIN1_ACTIVE_HIGH), "pin set as input");
+
+    le_clk_Time_t start = le_clk_GetRelativeTime();
+    for (i = 0; i < Count; i++)
+    {
+        le_gpioPin1_Read();
+    }
+    Report("read", i, ElapsedUs(start));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Toggle pins 1 and 2 together as push-pull outputs, in opposite states.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestGroupToggle
+(
+    void
+)
+{
+    const uint64_t pinMask = 0x3;
+    uint64_t values = 0;
+    int i;
+
+    LE_TEST_OK(LE_OK == le_gpioPin1_SetPushPullOutput(LE_GPIOPIN1_ACTIVE_HIGH, false),
+               "pin 1 set as output");
+    LE_TEST_OK(LE_OK == le_gpioPin2_SetPushPullOutput(LE_GPIOPIN2_ACTIVE_HIGH, false),
+               "pin 2 set as output");
+
+    le_clk_Time_t start = le_clk_GetRelativeTime();
+    for (i = 0; i < Count; i++)
+    {
+        if (LE_OK != le_gpioPin1_WritePins(pinMask, (i & 1) ? 0x2 : 0x1))
+        {
+            break;
+        }
+    }
+    uint64_t elapsedUs = ElapsedUs(start);
+
+    LE_TEST_OK(i == Count, "%d group toggles done", i);
+    Report("group", i, elapsedUs);
+
+    LE_TEST_OK(LE_OK == le_gpioPin1_ReadPins(pinMask, &values), "pins read together");
+    LE_TEST_OK(values == (((Count - 1) & 1) ? 0x2 : 0x1), "last values read back");
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test init.
+ */
+//--------------------------------------------------------------------------------------------------
+COMPONENT_INIT
+{
+    le_arg_SetIntVar(&Count, NULL, "count");
+    le_arg_Scan();
+
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+
+    if (Count <= 0)
+    {
+        LE_TEST_FATAL("Invalid access count %d", Count);
+    }
+
+    // The pin service is only advertised if the pin is available
+    if (LE_OK != le_gpioPin1_TryConnectService())
+    {
+        LE_TEST_FATAL("GPIO service pin 1 unavailable");
+    }
+
+    TestToggle();
+    TestRead();
+
+    if (LE_OK == le_gpioPin2_TryConnectService())
+    {
+        TestGroupToggle();
+    }
+    else
+    {
+        LE_TEST_INFO("GPIO service pin 2 unavailable, group toggle skipped");
+    }
+
+    LE_TEST_EXIT;
+}
@@ -0,0 +1,211 @@
+/**
+ * This module benchmarks the default APN lookup by MCC/MNC, comparing the scan of the JSON APN
+ * database done by the modemDaemon without APN table to the binary search in the APN table.
+ *
+ * It also checks that the table gives the same APN as the JSON database for every home network.
+ *
+ * Usage: apnTableBench <apns-full-conf.json> <apns-mccmnc.bin>
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "apnTable.h"
+#include "jansson.h"
+
+#include <time.h>
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of JSON lookups timed, each one parsing the whole database.
+ */
+//--------------------------------------------------------------------------------------------------
+#define JSON_LOOKUP_COUNT   10
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of passes over all the home networks for the table lookups.
+ */
+//--------------------------------------------------------------------------------------------------
+#define TABLE_PASS_COUNT    100
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum APN length.
+ */
+//--------------------------------------------------------------------------------------------------
+#define APN_BYTES           101
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the current time in microseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t GetTimeUs
+(
+    void
+)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether a JSON APN entry is a default one.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsDefaultApn
+(
+    json_t* dataPtr     ///< [IN] APN entry
+)
+{
+    json_t* typePtr = json_object_get(dataPtr, "@type");
+
+    // No type set for this carrier means "default"
+    return (!json_is_string(typePtr) || (NULL != strstr(json_string_value(typePtr), "default")));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find the default APN of a home network in the JSON database, as the modemDaemon does without
+ * APN table: load the whole file, then scan the entries.
+ *
+ * @return LE_OK if the APN is found.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t FindApnInJson
+(
+    const char* filePtr,    ///< [IN]  JSON database
+    const char* mccPtr,     ///< [IN]  MCC
+    const char* mncPtr,     ///< [IN]  MNC
+    char* apnPtr,           ///< [OUT] APN
+    size_t apnSize          ///< [IN]  Size of APN buffer
+)
+{
+    le_result_t result = LE_NOT_FOUND;
+    json_error_t error;
+    json_t* rootPtr = json_load_file(filePtr, 0, &error);
+    json_t* apnArrayPtr = json_object_get(json_object_get(rootPtr, "apns"), "apn");
+    size_t i;
+
+    for (i = 0; i < json_array_size(apnArrayPtr); i++)
+    {
+        json_t* dataPtr = json_array_get(apnArrayPtr, i);
+        const char* mccReadPtr = json_string_value(json_object_get(dataPtr, "@mcc"));
+        const char* mncReadPtr = json_string_value(json_object_get(dataPtr, "@mnc"));
+        const char* apnReadPtr = json_string_value(json_object_get(dataPtr, "@apn"));
+
+        if (IsDefaultApn(dataPtr) && mccReadPtr && mncReadPtr && apnReadPtr
+            && (0 == strcmp(mccReadPtr, mccPtr)) && (0 == strcmp(mncReadPtr, mncPtr)))
+        {
+            result = le_utf8_Copy(apnPtr, apnReadPtr, apnSize, NULL);
+            break;
+        }
+    }
+
+    json_decref(rootPtr);
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * main of the test
+ */
+//--------------------------------------------------------------------------------------------------
+COMPONENT_INIT
+{
+    const char* jsonFilePtr = le_arg_GetArg(0);
+    const char* tableFilePtr = le_arg_GetArg(1);
+    json_error_t error;
+    char apn[APN_BYTES];
+    size_t i;
+    int pass;
+    int mismatchCount = 0;
+    int lookupCount = 0;
+
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+
+    LE_TEST_ASSERT((NULL != jsonFilePtr) && (NULL != tableFilePtr),
+                   "Usage: apnTableBench <apns-full-conf.json> <apns-mccmnc.bin>");
+
+    apnTable_Ref_t tableRef = apnTable_Open(tableFilePtr);
+    LE_TEST_ASSERT(NULL != tableRef, "APN table %s opened", tableFilePtr);
+
+    json_t* rootPtr = json_load_file(jsonFilePtr, 0, &error);
+    LE_TEST_ASSERT(NULL != rootPtr, "JSON database %s loaded", jsonFilePtr);
+    json_t* apnArrayPtr = json_object_get(json_object_get(rootPtr, "apns"), "apn");
+    LE_TEST_ASSERT(json_is_array(apnArrayPtr), "JSON database has an APN array");
+
+    // Every home network of the JSON database gives the same APN from the table. Only the first
+    // default entry of a home network is the expected one: skip the networks already seen.
+    json_t* seenPtr = json_object();
+    for (i = 0; i < json_array_size(apnArrayPtr); i++)
+    {
+        json_t* dataPtr = json_array_get(apnArrayPtr, i);
+        const char* mccPtr = json_string_value(json_object_get(dataPtr, "@mcc"));
+        const char* mncPtr = json_string_value(json_object_get(dataPtr, "@mnc"));
+        const char* apnReadPtr = json_string_value(json_object_get(dataPtr, "@apn"));
+        char key[16];
+
+        if (!IsDefaultApn(dataPtr) || !mccPtr || !mncPtr || !apnReadPtr)
+        {
+            continue;
+        }
+
+        snprintf(key, sizeof(key), "%s/%s", mccPtr, mncPtr);
+        if (NULL != json_object_get(seenPtr, key))
+        {
+            continue;
+        }
+        json_object_set_new(seenPtr, key, json_true());
+
+        lookupCount++;
+        if ((LE_OK != apnTable_FindByMccMnc(tableRef, mccPtr, mncPtr, apn, sizeof(apn)))
+            || (0 != strcmp(apn, apnReadPtr)))
+        {
+            LE_TEST_INFO("Mismatch for %s/%s: expected '%s'", mccPtr, mncPtr, apnReadPtr);
+            mismatchCount++;
+        }
+    }
+
+    json_decref(seenPtr);
+    json_decref(rootPtr);
+
+    LE_TEST_OK(lookupCount > 0, "%d home networks in the JSON database", lookupCount);
+    LE_TEST_OK(0 == mismatchCount, "Table matches the JSON database (%d mismatches)",
+               mismatchCount);
+    LE_TEST_OK(LE_NOT_FOUND == apnTable_FindByMccMnc(tableRef, "000", "00", apn, sizeof(apn)),
+               "Unknown home network not found");
+
+    // Time the lookups
+    uint64_t startUs = GetTimeUs();
+    for (pass = 0; pass < JSON_LOOKUP_COUNT; pass++)
+    {
+        FindApnInJson(jsonFilePtr, "208", "01", apn, sizeof(apn));
+    }
+    uint64_t jsonUs = (GetTimeUs() - startUs) / JSON_LOOKUP_COUNT;
+
+    static const char* const mccMncList[][2] =
+    {
+        {"208", "01"}, {"310", "410"}, {"234", "15"}, {"262", "01"}, {"000", "00"}
+    };
+    size_t listCount = NUM_ARRAY_MEMBERS(mccMncList);
+
+    startUs = GetTimeUs();
+    for (pass = 0; pass < TABLE_PASS_COUNT * lookupCount; pass++)
+    {
+        const char* const* mccMncPtr = mccMncList[pass % listCount];
+        apnTable_FindByMccMnc(tableRef, mccMncPtr[0], mccMncPtr[1], apn, sizeof(apn));
+    }
+    uint64_t tableNs = (GetTimeUs() - startUs) * 1000 / (TABLE_PASS_COUNT * lookupCount);
+
+    LE_TEST_INFO("JSON lookup: %" PRIu64 " us, table lookup: %" PRIu64 " ns", jsonUs, tableNs);
+    LE_TEST_OK(jsonUs * 1000 > tableNs, "Table lookup faster than JSON lookup");
+
+    apnTable_Close(tableRef);
+
+    LE_TEST_EXIT;
+}
@@ -1366,6 +1366,60 @@ static void Testle_sms_StatusReport
     LE_ASSERT_OK(le_sms_GetTpSt(ReceivedSmsRef, &myStatus));
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Testle_sms_PduCache: this function tests that the PDU encoded for a message is reused as long
+ * as the status report request does not change, and encoded again otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+static void Testle_sms_PduCache
+(
+    void
+)
+{
+    le_sms_MsgRef_t myMsg;
+    uint8_t         pdu[LE_SMS_PDU_MAX_BYTES];
+    uint8_t         sentPdu[LE_SMS_PDU_MAX_BYTES];
+    size_t          length;
+    size_t          sentLength;
+
+    LE_ASSERT_OK(le_sms_DisableStatusReport());
+
+    myMsg = le_sms_Create();
+    LE_ASSERT(myMsg);
+    LE_ASSERT_OK(le_sms_SetDestination(myMsg, DEST_TEST_PATTERN));
+    LE_ASSERT_OK(le_sms_SetText(myMsg, TEXT_TEST_PATTERN));
+
+    // Send twice: the PDU encoded for the first sending is sent again
+    LE_ASSERT_OK(le_sms_Send(myMsg));
+    sentLength = sizeof(sentPdu);
+    LE_ASSERT_OK(le_sms_GetPDU(myMsg, sentPdu, &sentLength));
+    // No TP-Status-Report-Request in the first octet, after the SMSC length
+    LE_ASSERT(0 == (sentPdu[1] & 0x20));
+
+    LE_ASSERT_OK(le_sms_Send(myMsg));
+    length = sizeof(pdu);
+    LE_ASSERT_OK(le_sms_GetPDU(myMsg, pdu, &length));
+    LE_ASSERT(length == sentLength);
+    LE_ASSERT(0 == memcmp(pdu, sentPdu, length));
+
+    // The status report request invalidates the encoded PDU
+    LE_ASSERT_OK(le_sms_EnableStatusReport());
+    LE_ASSERT_OK(le_sms_Send(myMsg));
+    length = sizeof(pdu);
+    LE_ASSERT_OK(le_sms_GetPDU(myMsg, pdu, &length));
+    LE_ASSERT(length == sentLength);
+    LE_ASSERT(0 != (pdu[1] & 0x20));
+    LE_ASSERT(0 == memcmp(pdu + 2, sentPdu + 2, length - 2));
+
+    LE_ASSERT_OK(le_sms_DisableStatusReport());
+    length = sizeof(pdu);
+    LE_ASSERT_OK(le_sms_GetPDU(myMsg, pdu, &length));
+    LE_ASSERT(0 == memcmp(pdu, sentPdu, length));
+
+    le_sms_Delete(myMsg);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * SMS API Unitary Test
@@ -1424,5 +1478,8 @@ void testle_sms_SmsApiUnitTest
     LE_INFO("Test Testle_sms_StatusReport started");
     Testle_sms_StatusReport();
 
+    LE_INFO("Test Testle_sms_PduCache started");
+    Testle_sms_PduCache();
+
     LE_INFO("smsApiUnitTest sequence PASSED");
 }
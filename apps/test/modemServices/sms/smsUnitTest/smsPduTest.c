@@ -2097,6 +2097,260 @@ static le_result_t TestEncodePdu
     return LE_OK;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of random messages encoded and decoded by the round-trip test
+ */
+//--------------------------------------------------------------------------------------------------
+#define ROUND_TRIP_MESSAGE_COUNT    2000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Characters of the random messages: they are all in the GSM 7 bits default alphabet, or in its
+ * extension table, and in the 7 bits ASCII set used by CDMA.
+ */
+//--------------------------------------------------------------------------------------------------
+static const char RoundTripChars[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789"
+                                     " .,;:!?@$_-+*/=<>()&%#'\"\n\r[]{}^~|\\\f";
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Encode random messages of random lengths, decode them and check that the text is unchanged.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t TestPduRoundTrip
+(
+    void
+)
+{
+    static const struct
+    {
+        pa_sms_Protocol_t protocol;
+        smsPdu_Encoding_t encoding;
+        size_t            maxLength;
+    }
+    formats[] =
+    {
+        { PA_SMS_PROTOCOL_GSM,  SMSPDU_7_BITS, LE_SMS_TEXT_MAX_LEN },
+        { PA_SMS_PROTOCOL_GSM,  SMSPDU_8_BITS, LE_SMS_BINARY_MAX_BYTES },
+        { PA_SMS_PROTOCOL_CDMA, SMSPDU_7_BITS, LE_SMS_TEXT_MAX_LEN },
+        { PA_SMS_PROTOCOL_CDMA, SMSPDU_8_BITS, LE_SMS_BINARY_MAX_BYTES },
+    };
+    unsigned int seed = 1;
+    uint8_t text[LE_SMS_TEXT_MAX_BYTES];
+    pa_sms_Pdu_t pdu;
+    pa_sms_Message_t message;
+    smsPdu_DataToEncode_t data;
+    int i;
+
+    for (i = 0; i < ROUND_TRIP_MESSAGE_COUNT; i++)
+    {
+        int format = rand_r(&seed) % NUM_ARRAY_MEMBERS(formats);
+        size_t length = 1 + rand_r(&seed) % formats[format].maxLength;
+        size_t j;
+
+        for (j = 0; j < length; j++)
+        {
+            text[j] = RoundTripChars[rand_r(&seed) % (sizeof(RoundTripChars) - 1)];
+        }
+
+        memset(&data, 0, sizeof(data));
+        data.protocol = formats[format].protocol;
+        data.messagePtr = text;
+        data.length = length;
+        data.addressPtr = "+33661651866";
+        data.encoding = formats[format].encoding;
+        data.messageType = PA_SMS_SUBMIT;
+
+        switch (smsPdu_Encode(&data, &pdu))
+        {
+            case LE_OK:
+                break;
+
+            case LE_OVERFLOW:
+                // Too many characters of the extension table for a GSM message
+                continue;
+
+            default:
+                LE_ERROR("Encoding of message %d failed", i);
+                return LE_FAULT;
+        }
+
+        if ((LE_OK != smsPdu_Decode(data.protocol, pdu.data, pdu.dataLen, true, &message)) ||
+            (PA_SMS_SUBMIT != message.type))
+        {
+            LE_ERROR("Decoding of message %d failed", i);
+            DumpPdu("PDU", pdu.data, pdu.dataLen);
+            return LE_FAULT;
+        }
+
+        if ((message.smsSubmit.dataLen != length) ||
+            (0 != memcmp(message.smsSubmit.data, text, length)))
+        {
+            LE_ERROR("Message %d changed, length %zu -> %u", i, length, message.smsSubmit.dataLen);
+            DumpPdu("Text", text, length);
+            DumpPdu("Decoded text", message.smsSubmit.data, message.smsSubmit.dataLen);
+            return LE_FAULT;
+        }
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Encode GSM 7 bits messages whose escape sequences reach the payload limit: an escape sequence
+ * must fit as a whole in the remaining septets.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t TestPduEscapeLimit
+(
+    void
+)
+{
+    static const struct
+    {
+        const char* firstPtr;       // Characters before the 'a' characters
+        size_t      count;          // Number of 'a' characters
+        const char* lastPtr;        // Characters after the 'a' characters
+        le_result_t result;         // Expected encoding result
+    }
+    cases[] =
+    {
+        { "{", 158, "",  LE_OK },           // 160 septets
+        { "",  159, "{", LE_OVERFLOW },     // Escape sequence crossing the limit
+        { "{", 158, "{", LE_OVERFLOW },     // Escape sequence just after the limit
+        { "{", 156, "{", LE_OK },           // 160 septets
+    };
+    char text[LE_SMS_TEXT_MAX_BYTES];
+    pa_sms_Pdu_t pdu;
+    pa_sms_Message_t message;
+    smsPdu_DataToEncode_t data;
+    int i;
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(cases); i++)
+    {
+        size_t length = strlen(cases[i].firstPtr);
+
+        memcpy(text, cases[i].firstPtr, length);
+        memset(text + length, 'a', cases[i].count);
+        length += cases[i].count;
+        strcpy(text + length, cases[i].lastPtr);
+        length += strlen(cases[i].lastPtr);
+
+        memset(&data, 0, sizeof(data));
+        data.protocol = PA_SMS_PROTOCOL_GSM;
+        data.messagePtr = (const uint8_t*)text;
+        data.length = length;
+        data.addressPtr = "+33661651866";
+        data.encoding = SMSPDU_7_BITS;
+        data.messageType = PA_SMS_SUBMIT;
+
+        if (cases[i].result != smsPdu_Encode(&data, &pdu))
+        {
+            LE_ERROR("Case %d: unexpected encoding result", i);
+            return LE_FAULT;
+        }
+
+        if (LE_OK != cases[i].result)
+        {
+            continue;
+        }
+
+        if ((LE_OK != smsPdu_Decode(data.protocol, pdu.data, pdu.dataLen, true, &message)) ||
+            (message.smsSubmit.dataLen != length) ||
+            (0 != memcmp(message.smsSubmit.data, text, length)))
+        {
+            LE_ERROR("Case %d: message changed", i);
+            return LE_FAULT;
+        }
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of PDUs encoded and decoded to measure the codec throughput
+ */
+//--------------------------------------------------------------------------------------------------
+#define THROUGHPUT_PDU_COUNT    100000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Measure the 7 bits encoding and decoding throughput of full length messages, which bounds the
+ * number of messages the SMS service can prepare while the modem is sending.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t TestPduThroughput
+(
+    void
+)
+{
+    static const pa_sms_Protocol_t protocols[] = { PA_SMS_PROTOCOL_GSM, PA_SMS_PROTOCOL_CDMA };
+    uint8_t text[LE_SMS_TEXT_MAX_LEN];
+    pa_sms_Pdu_t pdu;
+    pa_sms_Message_t message;
+    smsPdu_DataToEncode_t data;
+    le_clk_Time_t startTime;
+    le_clk_Time_t elapsedTime;
+    uint64_t elapsedUs;
+    int p;
+    int i;
+
+    for (i = 0; i < sizeof(text); i++)
+    {
+        text[i] = RoundTripChars[i % 62];
+    }
+
+    for (p = 0; p < NUM_ARRAY_MEMBERS(protocols); p++)
+    {
+        memset(&data, 0, sizeof(data));
+        data.protocol = protocols[p];
+        data.messagePtr = text;
+        data.length = sizeof(text);
+        data.addressPtr = "+33661651866";
+        data.encoding = SMSPDU_7_BITS;
+        data.messageType = PA_SMS_SUBMIT;
+
+        startTime = le_clk_GetRelativeTime();
+        for (i = 0; i < THROUGHPUT_PDU_COUNT; i++)
+        {
+            if (LE_OK != smsPdu_Encode(&data, &pdu))
+            {
+                return LE_FAULT;
+            }
+        }
+        elapsedTime = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+        elapsedUs = (uint64_t)elapsedTime.sec * 1000000 + elapsedTime.usec;
+        LE_INFO("Protocol %d: encoded %d PDUs in %"PRIu64" us (%"PRIu64" PDUs/s)", data.protocol,
+                THROUGHPUT_PDU_COUNT, elapsedUs,
+                (uint64_t)THROUGHPUT_PDU_COUNT * 1000000 / (elapsedUs ? elapsedUs : 1));
+
+        startTime = le_clk_GetRelativeTime();
+        for (i = 0; i < THROUGHPUT_PDU_COUNT; i++)
+        {
+            if (LE_OK != smsPdu_Decode(data.protocol, pdu.data, pdu.dataLen, true, &message))
+            {
+                return LE_FAULT;
+            }
+        }
+        elapsedTime = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+        elapsedUs = (uint64_t)elapsedTime.sec * 1000000 + elapsedTime.usec;
+        LE_INFO("Protocol %d: decoded %d PDUs in %"PRIu64" us (%"PRIu64" PDUs/s)", data.protocol,
+                THROUGHPUT_PDU_COUNT, elapsedUs,
+                (uint64_t)THROUGHPUT_PDU_COUNT * 1000000 / (elapsedUs ? elapsedUs : 1));
+
+        if ((message.smsSubmit.dataLen != data.length) ||
+            (0 != memcmp(message.smsSubmit.data, text, data.length)))
+        {
+            return LE_FAULT;
+        }
+    }
+
+    return LE_OK;
+}
+
 //--------------------------------------------------------------------------------------------------
 /*
  * SMS PDU encoding and decoding test
@@ -2114,5 +2368,14 @@ void testle_sms_SmsPduTest
     LE_INFO("Test DecodePdu started");
     LE_ASSERT_OK(TestDecodePdu());
 
+    LE_INFO("Test PduRoundTrip started");
+    LE_ASSERT_OK(TestPduRoundTrip());
+
+    LE_INFO("Test PduEscapeLimit started");
+    LE_ASSERT_OK(TestPduEscapeLimit());
+
+    LE_INFO("Test PduThroughput started");
+    LE_ASSERT_OK(TestPduThroughput());
+
     LE_INFO("smsPduTest SUCCESS");
 }
@@ -0,0 +1,540 @@
+/**
+ * This module tests the asynchronous MQTT publish pipeline against a broker stand-in, and measures
+ * its throughput.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "publishQueue.h"
+
+#include <time.h>
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Spool file used by the test.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SPOOL_PATH          "/tmp/publishQueueTest.spool"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum time to wait for the publish thread, in milliseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+#define WAIT_TIMEOUT_MS     5000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of messages of the throughput tests.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SLOW_BROKER_COUNT   500
+#define FAST_BROKER_COUNT   20000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Latency of the slow broker, in microseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SLOW_BROKER_LATENCY_US  200
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of acknowledgements held by the broker.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_HELD_ACKS       PUBQUEUE_MAX_WINDOW
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Broker stand-in state, shared with the publish thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static struct
+{
+    le_mutex_Ref_t mutex;
+    pubQueue_Ref_t queueRef;
+    bool           up;                      ///< Accepting messages
+    bool           holdAcks;                ///< Keep the acknowledgements until released
+    uint32_t       latencyUs;               ///< Time spent sending a message
+    uint32_t       receivedCount;           ///< Messages received
+    uint32_t       expectedSeq;             ///< Next expected sequence number
+    bool           inOrder;                 ///< Messages received in sequence
+    int            nextToken;               ///< Next delivery token
+    int            heldAcks[MAX_HELD_ACKS]; ///< Acknowledgements held
+    size_t         heldAckCount;            ///< Number of acknowledgements held
+}
+Broker;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the current time in microseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t GetTimeUs
+(
+    void
+)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Broker stand-in: receive a message, whose payload is its sequence number. QoS 1 and 2 messages
+ * are acknowledged at once, possibly before the function returns their token, unless the
+ * acknowledgements are held.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t BrokerSend
+(
+    void*          contextPtr,
+    const char*    topicPtr,
+    const uint8_t* payloadPtr,
+    size_t         payloadLen,
+    int            qos,
+    bool           retain,
+    int*           tokenPtr
+)
+{
+    uint32_t seq;
+    int token = 0;
+    bool ack = false;
+
+    if (0 != Broker.latencyUs)
+    {
+        usleep(Broker.latencyUs);
+    }
+
+    le_mutex_Lock(Broker.mutex);
+
+    if (!Broker.up)
+    {
+        le_mutex_Unlock(Broker.mutex);
+        return LE_NOT_POSSIBLE;
+    }
+
+    LE_ASSERT(sizeof(seq) == payloadLen);
+    memcpy(&seq, payloadPtr, sizeof(seq));
+    if (seq != Broker.expectedSeq)
+    {
+        LE_TEST_INFO("Received %" PRIu32 ", expected %" PRIu32, seq, Broker.expectedSeq);
+        Broker.inOrder = false;
+    }
+    Broker.expectedSeq = seq + 1;
+    Broker.receivedCount++;
+
+    if (qos > 0)
+    {
+        token = ++Broker.nextToken;
+        if (Broker.holdAcks)
+        {
+            LE_ASSERT(Broker.heldAckCount < MAX_HELD_ACKS);
+            Broker.heldAcks[Broker.heldAckCount++] = token;
+        }
+        else
+        {
+            ack = true;
+        }
+    }
+
+    le_mutex_Unlock(Broker.mutex);
+
+    if (ack)
+    {
+        pubQueue_Delivered(Broker.queueRef, token);
+    }
+    *tokenPtr = token;
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release the acknowledgements held by the broker.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReleaseAcks
+(
+    void
+)
+{
+    int acks[MAX_HELD_ACKS];
+    size_t count;
+    size_t i;
+
+    le_mutex_Lock(Broker.mutex);
+    count = Broker.heldAckCount;
+    memcpy(acks, Broker.heldAcks, count * sizeof(int));
+    Broker.heldAckCount = 0;
+    le_mutex_Unlock(Broker.mutex);
+
+    for (i = 0; i < count; i++)
+    {
+        pubQueue_Delivered(Broker.queueRef, acks[i]);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release the acknowledgements held by the broker, except the first one which is dropped.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AckAllButFirst
+(
+    void
+)
+{
+    le_mutex_Lock(Broker.mutex);
+    LE_ASSERT(Broker.heldAckCount > 0);
+    Broker.heldAckCount--;
+    memmove(Broker.heldAcks, Broker.heldAcks + 1, Broker.heldAckCount * sizeof(int));
+    le_mutex_Unlock(Broker.mutex);
+
+    ReleaseAcks();
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of messages received by the broker.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t GetReceivedCount
+(
+    void
+)
+{
+    le_mutex_Lock(Broker.mutex);
+    uint32_t count = Broker.receivedCount;
+    le_mutex_Unlock(Broker.mutex);
+
+    return count;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reset the broker statistics and set its behaviour.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ResetBroker
+(
+    pubQueue_Ref_t queueRef,
+    bool           holdAcks,
+    uint32_t       latencyUs,
+    uint32_t       firstSeq
+)
+{
+    le_mutex_Lock(Broker.mutex);
+    Broker.queueRef = queueRef;
+    Broker.up = true;
+    Broker.holdAcks = holdAcks;
+    Broker.latencyUs = latencyUs;
+    Broker.receivedCount = 0;
+    Broker.expectedSeq = firstSeq;
+    Broker.inOrder = true;
+    Broker.heldAckCount = 0;
+    le_mutex_Unlock(Broker.mutex);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Wait until the broker has received a number of messages and the queue has no message in flight,
+ * releasing the held acknowledgements meanwhile if requested.
+ *
+ * @return true if the expected state is reached in time.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool WaitFor
+(
+    pubQueue_Ref_t queueRef,
+    uint32_t       receivedCount,
+    size_t         inFlightCount,
+    bool           releaseAcks
+)
+{
+    uint64_t deadlineUs = GetTimeUs() + WAIT_TIMEOUT_MS * 1000;
+    size_t inFlight;
+
+    do
+    {
+        if (releaseAcks)
+        {
+            ReleaseAcks();
+        }
+
+        pubQueue_GetCounts(queueRef, NULL, &inFlight, NULL);
+        if ((GetReceivedCount() == receivedCount) && (inFlight == inFlightCount))
+        {
+            return true;
+        }
+
+        usleep(1000);
+    }
+    while (GetTimeUs() < deadlineUs);
+
+    LE_TEST_INFO("Received %" PRIu32 "/%" PRIu32 ", %zu/%zu in flight", GetReceivedCount(),
+                 receivedCount, inFlight, inFlightCount);
+    return false;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Publish messages numbered from a sequence number.
+ *
+ * @return The number of messages accepted.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t PublishSeq
+(
+    pubQueue_Ref_t queueRef,
+    uint32_t       firstSeq,
+    uint32_t       count,
+    int            qos
+)
+{
+    uint32_t seq;
+
+    for (seq = firstSeq; seq < firstSeq + count; seq++)
+    {
+        if (LE_OK != pubQueue_Publish(queueRef, "test/seq", (uint8_t*)&seq, sizeof(seq), qos,
+                                      false))
+        {
+            break;
+        }
+    }
+
+    return seq - firstSeq;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test queueing while disconnected, sending on connection and early acknowledgements.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestOffline
+(
+    void
+)
+{
+    pubQueue_Ref_t queueRef = pubQueue_Create(BrokerSend, NULL);
+    size_t pending;
+
+    ResetBroker(queueRef, false, 0, 0);
+
+    LE_TEST_OK(20 == PublishSeq(queueRef, 0, 20, 1), "Messages queued while disconnected");
+    usleep(10000);
+    pubQueue_GetCounts(queueRef, &pending, NULL, NULL);
+    LE_TEST_OK((0 == GetReceivedCount()) && (20 == pending), "Nothing sent while disconnected");
+
+    pubQueue_SetConnected(queueRef, true);
+    LE_TEST_OK(WaitFor(queueRef, 20, 0, false), "Messages sent and acknowledged once connected");
+    LE_TEST_OK(Broker.inOrder, "Messages received in order");
+
+    LE_TEST_OK(LE_BAD_PARAMETER == pubQueue_Publish(queueRef, "test", NULL, 0, 3, false),
+               "Invalid QoS rejected");
+    LE_TEST_OK(LE_BAD_PARAMETER == pubQueue_Publish(queueRef, "test", NULL,
+                                                    PUBQUEUE_MAX_PAYLOAD_BYTES + 1, 0, false),
+               "Payload too long rejected");
+
+    pubQueue_Delete(queueRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test the in-flight window, the connection loss and the requeueing of in-flight messages.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestWindow
+(
+    void
+)
+{
+    pubQueue_Ref_t queueRef = pubQueue_Create(BrokerSend, NULL);
+    size_t pending;
+    size_t inFlight;
+
+    ResetBroker(queueRef, true, 0, 0);
+
+    LE_TEST_OK(LE_BAD_PARAMETER == pubQueue_Configure(queueRef, 16, PUBQUEUE_MAX_WINDOW + 1, NULL),
+               "Window out of range rejected");
+    LE_TEST_OK(LE_OK == pubQueue_Configure(queueRef, 16, 4, NULL), "Window set to 4");
+    pubQueue_SetConnected(queueRef, true);
+
+    PublishSeq(queueRef, 0, 10, 1);
+    LE_TEST_OK(WaitFor(queueRef, 4, 4, false), "Sending stops at the window");
+    usleep(10000);
+    pubQueue_GetCounts(queueRef, &pending, &inFlight, NULL);
+    LE_TEST_OK((4 == GetReceivedCount()) && (6 == pending) && (4 == inFlight),
+               "Window full: %zu pending, %zu in flight", pending, inFlight);
+
+    LE_TEST_OK(WaitFor(queueRef, 10, 0, true), "Sending resumes with acknowledgements");
+    LE_TEST_OK(Broker.inOrder, "Messages received in order");
+
+    // Broker session lost: the unacknowledged messages are sent again
+    PublishSeq(queueRef, 10, 3, 2);
+    LE_TEST_OK(WaitFor(queueRef, 13, 3, false), "QoS 2 messages in flight");
+    ResetBroker(queueRef, false, 0, 10);
+    pubQueue_RequeueInFlight(queueRef);
+    LE_TEST_OK(WaitFor(queueRef, 3, 0, false), "In-flight messages sent again");
+    LE_TEST_OK(Broker.inOrder, "Messages received again in order");
+
+    // Connection lost: the message is kept and sent on reconnection
+    le_mutex_Lock(Broker.mutex);
+    Broker.up = false;
+    le_mutex_Unlock(Broker.mutex);
+    PublishSeq(queueRef, 13, 5, 0);
+    usleep(10000);
+    pubQueue_GetCounts(queueRef, &pending, NULL, NULL);
+    LE_TEST_OK((3 == GetReceivedCount()) && (5 == pending), "Messages kept while disconnected");
+
+    le_mutex_Lock(Broker.mutex);
+    Broker.up = true;
+    le_mutex_Unlock(Broker.mutex);
+    pubQueue_SetConnected(queueRef, true);
+    LE_TEST_OK(WaitFor(queueRef, 8, 0, false), "Messages sent on reconnection");
+    LE_TEST_OK(Broker.inOrder, "Messages received in order");
+
+    pubQueue_Delete(queueRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test a full queue, with and without spool, and the replay of the spool after a restart.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestSpool
+(
+    void
+)
+{
+    pubQueue_Ref_t queueRef = pubQueue_Create(BrokerSend, NULL);
+    size_t pending;
+    size_t spooled;
+    struct stat st;
+
+    unlink(SPOOL_PATH);
+    ResetBroker(queueRef, false, 0, 0);
+
+    LE_TEST_OK(LE_OK == pubQueue_Configure(queueRef, 8, 4, NULL), "Queue size set to 8");
+    LE_TEST_OK(8 == PublishSeq(queueRef, 0, 20, 1), "Queue full without spool");
+    LE_TEST_OK(LE_NO_MEMORY == pubQueue_Publish(queueRef, "test", NULL, 0, 0, false),
+               "QoS 0 message rejected when full");
+
+    pubQueue_Delete(queueRef);
+    queueRef = pubQueue_Create(BrokerSend, NULL);
+    ResetBroker(queueRef, false, 0, 8);
+
+    LE_TEST_OK(LE_OK == pubQueue_Configure(queueRef, 8, 4, SPOOL_PATH), "Spool opened");
+    LE_TEST_OK(20 == PublishSeq(queueRef, 0, 20, 1), "QoS 1 messages spooled when full");
+    LE_TEST_OK(LE_NO_MEMORY == pubQueue_Publish(queueRef, "test", NULL, 0, 0, false),
+               "QoS 0 message not spooled");
+    pubQueue_GetCounts(queueRef, &pending, NULL, &spooled);
+    LE_TEST_OK((8 == pending) && (12 == spooled), "%zu pending, %zu spooled", pending, spooled);
+
+    // Restart: the messages held in memory are lost, the spooled ones are replayed
+    pubQueue_Delete(queueRef);
+    queueRef = pubQueue_Create(BrokerSend, NULL);
+    ResetBroker(queueRef, false, 0, 8);
+
+    LE_TEST_OK(LE_OK == pubQueue_Configure(queueRef, 8, 4, SPOOL_PATH), "Spool opened again");
+    pubQueue_GetCounts(queueRef, &pending, NULL, &spooled);
+    LE_TEST_OK((0 == pending) && (12 == spooled), "%zu spooled messages found", spooled);
+
+    // Restart with the first spooled message sent but not acknowledged: all of them are replayed
+    ResetBroker(queueRef, true, 0, 8);
+    pubQueue_SetConnected(queueRef, true);
+    LE_TEST_OK(WaitFor(queueRef, 4, 4, false), "Window of spooled messages sent");
+    AckAllButFirst();
+    LE_TEST_OK(WaitFor(queueRef, 7, 4, false), "Acknowledged messages replaced in the window");
+
+    pubQueue_Delete(queueRef);
+    queueRef = pubQueue_Create(BrokerSend, NULL);
+    ResetBroker(queueRef, false, 0, 8);
+
+    LE_TEST_OK(LE_OK == pubQueue_Configure(queueRef, 8, 4, SPOOL_PATH), "Spool opened again");
+    pubQueue_GetCounts(queueRef, &pending, NULL, &spooled);
+    LE_TEST_OK((0 == pending) && (12 == spooled), "%zu unacknowledged messages kept", spooled);
+
+    pubQueue_SetConnected(queueRef, true);
+    LE_TEST_OK(WaitFor(queueRef, 12, 0, false), "Spooled messages replayed");
+    LE_TEST_OK(Broker.inOrder, "Spooled messages replayed in order");
+    LE_TEST_OK((0 == stat(SPOOL_PATH, &st)) && (8 == st.st_size), "Spool emptied");
+
+    pubQueue_Delete(queueRef);
+    unlink(SPOOL_PATH);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Measure the time spent by the publisher with a slow broker, and the pipeline throughput with a
+ * fast one.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestThroughput
+(
+    void
+)
+{
+    pubQueue_Ref_t queueRef = pubQueue_Create(BrokerSend, NULL);
+    uint32_t seq;
+
+    LE_TEST_OK(LE_OK == pubQueue_Configure(queueRef, SLOW_BROKER_COUNT, PUBQUEUE_MAX_WINDOW, NULL),
+               "Queue size set to %d", SLOW_BROKER_COUNT);
+    pubQueue_SetConnected(queueRef, true);
+
+    ResetBroker(queueRef, false, SLOW_BROKER_LATENCY_US, 0);
+    uint64_t startUs = GetTimeUs();
+    PublishSeq(queueRef, 0, SLOW_BROKER_COUNT, 1);
+    uint64_t publishUs = GetTimeUs() - startUs;
+    LE_TEST_OK(WaitFor(queueRef, SLOW_BROKER_COUNT, 0, false), "Slow broker: all delivered");
+    uint64_t deliveryUs = GetTimeUs() - startUs;
+
+    LE_TEST_INFO("Slow broker: publishing %d messages took %" PRIu64 " us, delivering them %"
+                 PRIu64 " us", SLOW_BROKER_COUNT, publishUs, deliveryUs);
+    LE_TEST_OK(publishUs * 10 < (uint64_t)SLOW_BROKER_COUNT * SLOW_BROKER_LATENCY_US,
+               "Publisher does not wait for the broker");
+
+    ResetBroker(queueRef, false, 0, 0);
+    startUs = GetTimeUs();
+    for (seq = 0; seq < FAST_BROKER_COUNT;)
+    {
+        seq += PublishSeq(queueRef, seq, FAST_BROKER_COUNT - seq, seq % 2);
+        if (seq < FAST_BROKER_COUNT)
+        {
+            sched_yield();
+        }
+    }
+    LE_TEST_OK(WaitFor(queueRef, FAST_BROKER_COUNT, 0, false), "Fast broker: all delivered");
+    LE_TEST_OK(Broker.inOrder, "Messages received in order");
+    uint64_t elapsedUs = GetTimeUs() - startUs;
+
+    LE_TEST_INFO("Fast broker: %d messages in %" PRIu64 " us, %" PRIu64 " messages/s",
+                 FAST_BROKER_COUNT, elapsedUs,
+                 (uint64_t)FAST_BROKER_COUNT * 1000000 / (elapsedUs ? elapsedUs : 1));
+
+    pubQueue_Delete(queueRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * main of the test
+ */
+//--------------------------------------------------------------------------------------------------
+COMPONENT_INIT
+{
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+
+    Broker.mutex = le_mutex_CreateNonRecursive("Broker");
+    pubQueue_Init();
+
+    TestOffline();
+    TestWindow();
+    TestSpool();
+    TestThroughput();
+
+    LE_TEST_EXIT;
+}
@@ -91,6 +91,15 @@ static le_gnss_SampleRef_t GnssPositionSampleRef;
 //--------------------------------------------------------------------------------------------------
 static le_gnss_PositionHandlerRef_t GnssPositionHandlerRef = NULL;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Second position handler reference and the last sample reference it received.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static le_gnss_PositionHandlerRef_t SecondPositionHandlerRef = NULL;
+static le_gnss_SampleRef_t          SecondPositionSampleRef = NULL;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Thread and semaphore reference.
@@ -751,6 +760,116 @@ static void Testset_gnss_PositionData
     SynchTest();
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Second handler function for Position Notifications: keep the sample reference for the test.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void SecondPositionHandlerFunction
+(
+    le_gnss_SampleRef_t positionSampleRef,
+    void* contextPtr
+)
+{
+    SecondPositionSampleRef = positionSampleRef;
+    le_sem_Post(ThreadSemaphore);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test: this function handles the add of the second position handler
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddSecondHandler
+(
+    void* param1Ptr,
+    void* param2Ptr
+)
+{
+    LOCK
+    SecondPositionHandlerRef = le_gnss_AddPositionHandler(SecondPositionHandlerFunction, NULL);
+    LE_ASSERT(NULL != SecondPositionHandlerRef);
+    UNLOCK
+    le_sem_Post(ThreadSemaphore);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test: this function handles the remove of the second position handler
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void RemoveSecondHandler
+(
+    void* param1Ptr,
+    void* param2Ptr
+)
+{
+    LOCK
+    le_gnss_RemovePositionHandler(SecondPositionHandlerRef);
+    SecondPositionHandlerRef = NULL;
+    UNLOCK
+    le_sem_Post(ThreadSemaphore);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test: a fix is shared by several position handlers.
+ *
+ * Each handler gets its own sample reference on the same fix. A reference stays valid when the
+ * other handlers release theirs, and the last sample reference reports the same fix.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void Testle_gnss_SharedPositionSample
+(
+    void
+)
+{
+    int32_t latitude, longitude, hAccuracy;
+    int32_t lastLatitude, lastLongitude, lastHAccuracy;
+    le_result_t result;
+
+    le_event_QueueFunctionToThread(AppThreadRef, AddSecondHandler, NULL, NULL);
+    SynchTest();
+
+    // Both handlers are called for the same fix
+    pa_gnssSimu_ReportEvent();
+    SynchTest();
+    SynchTest();
+
+    LOCK
+    LE_ASSERT(NULL != SecondPositionSampleRef);
+
+    // The first handler has already released its own reference
+    result = le_gnss_GetLocation(SecondPositionSampleRef, &latitude, &longitude, &hAccuracy);
+    LE_ASSERT((LE_OK == result) || (LE_OUT_OF_RANGE == result));
+
+    le_gnss_SampleRef_t lastSampleRef = le_gnss_GetLastSampleRef();
+    LE_ASSERT(NULL != lastSampleRef);
+    LE_ASSERT(lastSampleRef != SecondPositionSampleRef);
+    LE_ASSERT(result == le_gnss_GetLocation(lastSampleRef, &lastLatitude, &lastLongitude,
+                                            &lastHAccuracy));
+    LE_ASSERT(latitude == lastLatitude);
+    LE_ASSERT(longitude == lastLongitude);
+    LE_ASSERT(hAccuracy == lastHAccuracy);
+
+    le_gnss_ReleaseSampleRef(SecondPositionSampleRef);
+    SecondPositionSampleRef = NULL;
+
+    // The last sample reference is still valid
+    result = le_gnss_GetLocation(lastSampleRef, &lastLatitude, &lastLongitude, &lastHAccuracy);
+    LE_ASSERT((LE_OK == result) || (LE_OUT_OF_RANGE == result));
+    LE_ASSERT(latitude == lastLatitude);
+    le_gnss_ReleaseSampleRef(lastSampleRef);
+    UNLOCK
+
+    le_event_QueueFunctionToThread(AppThreadRef, RemoveSecondHandler, NULL, NULL);
+    SynchTest();
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Test: this function handles the remove position handler
@@ -1217,6 +1336,9 @@ COMPONENT_INIT
     LE_INFO("======== GNSS Position Fill the position data ========");
     Testset_gnss_PositionData();
 
+    LE_INFO("======== GNSS Shared Position Sample Test ========");
+    Testle_gnss_SharedPositionSample();
+
     LE_INFO("======== GNSS Device State Test ========");
     Testle_gnss_GetState();
 
@@ -0,0 +1,268 @@
+/**
+ * This module implements the unit tests of the shared NMEA stream ring.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "nmeaStream.h"
+
+#include <sys/mman.h>
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of slots of the ring under test.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SLOT_COUNT      8
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * NMEA frame used for the tests.
+ */
+//--------------------------------------------------------------------------------------------------
+#define NMEA_FRAME  "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open a new reader on the ring.
+ */
+//--------------------------------------------------------------------------------------------------
+static nmeaStream_ReaderRef_t OpenReader
+(
+    void
+)
+{
+    nmeaStream_ReaderRef_t readerRef = nmeaStream_Open(nmeaStream_GetReaderFd());
+
+    LE_TEST_ASSERT(NULL != readerRef, "Reader opened");
+    return readerRef;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test the ring creation and the reader file descriptor.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestCreate
+(
+    void
+)
+{
+    LE_TEST_OK(-1 == nmeaStream_GetReaderFd(), "No reader file descriptor before creation");
+    LE_TEST_OK(NULL == nmeaStream_Open(-1), "Invalid file descriptor rejected");
+    LE_TEST_OK(LE_BAD_PARAMETER == nmeaStream_Create(SLOT_COUNT + 1),
+               "Slot count not a power of two rejected");
+    LE_TEST_ASSERT(LE_OK == nmeaStream_Create(SLOT_COUNT), "Ring created");
+    LE_TEST_OK(LE_DUPLICATE == nmeaStream_Create(SLOT_COUNT), "Ring creation is done once");
+
+    // Readers cannot map the ring writable
+    int fd = nmeaStream_GetReaderFd();
+    LE_TEST_ASSERT(fd >= 0, "Reader file descriptor");
+    void* mapPtr = mmap(NULL, 4096, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    LE_TEST_OK(MAP_FAILED == mapPtr, "Reader file descriptor is read-only");
+    if (MAP_FAILED != mapPtr)
+    {
+        munmap(mapPtr, 4096);
+    }
+    close(fd);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test that several readers get the same frames.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestReaders
+(
+    void
+)
+{
+    nmeaStream_ReaderRef_t reader1 = OpenReader();
+    nmeaStream_ReaderRef_t reader2 = OpenReader();
+    char buf[NMEA_STREAM_SLOT_DATA_BYTES];
+    size_t len = sizeof(buf);
+
+    LE_TEST_OK(LE_WOULD_BLOCK == nmeaStream_Read(reader1, buf, &len), "Reader starts empty");
+
+    nmeaStream_Write(NMEA_FRAME, sizeof(NMEA_FRAME) - 1);
+
+    len = sizeof(buf);
+    LE_TEST_OK((LE_OK == nmeaStream_Read(reader1, buf, &len)) &&
+               (sizeof(NMEA_FRAME) - 1 == len) && (0 == memcmp(buf, NMEA_FRAME, len)),
+               "Reader 1 got the frame");
+    len = sizeof(buf);
+    LE_TEST_OK((LE_OK == nmeaStream_Read(reader2, buf, &len)) &&
+               (sizeof(NMEA_FRAME) - 1 == len) && (0 == memcmp(buf, NMEA_FRAME, len)),
+               "Reader 2 got the frame");
+    len = sizeof(buf);
+    LE_TEST_OK(LE_WOULD_BLOCK == nmeaStream_Read(reader1, buf, &len), "Frame consumed once");
+
+    // A buffer too small does not consume the chunk
+    nmeaStream_Write(NMEA_FRAME, sizeof(NMEA_FRAME) - 1);
+    len = 10;
+    LE_TEST_OK((LE_OVERFLOW == nmeaStream_Read(reader1, buf, &len)) &&
+               (sizeof(NMEA_FRAME) - 1 == len), "Buffer too small reported");
+    len = sizeof(buf);
+    LE_TEST_OK(LE_OK == nmeaStream_Read(reader1, buf, &len), "Chunk read after overflow");
+
+    LE_TEST_OK(0 == nmeaStream_GetOverrunCount(reader1), "No overrun for reader 1");
+    LE_TEST_OK(0 == nmeaStream_GetOverrunCount(reader2), "No overrun for reader 2");
+
+    nmeaStream_Close(reader1);
+    nmeaStream_Close(reader2);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test that a frame longer than a slot is split and read back identical.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestLongFrame
+(
+    void
+)
+{
+    nmeaStream_ReaderRef_t readerRef = OpenReader();
+    char frame[NMEA_STREAM_SLOT_DATA_BYTES * 2 + 100];
+    char readFrame[sizeof(frame)];
+    size_t readLen = 0;
+    size_t i;
+
+    for (i = 0; i < sizeof(frame); i++)
+    {
+        frame[i] = 'A' + (i % 26);
+    }
+
+    nmeaStream_Write(frame, sizeof(frame));
+
+    while (readLen < sizeof(readFrame))
+    {
+        size_t len = sizeof(readFrame) - readLen;
+        if (LE_OK != nmeaStream_Read(readerRef, readFrame + readLen, &len))
+        {
+            break;
+        }
+        readLen += len;
+    }
+
+    LE_TEST_OK((sizeof(frame) == readLen) && (0 == memcmp(frame, readFrame, readLen)),
+               "Long frame read back in %zu bytes", readLen);
+
+    nmeaStream_Close(readerRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test that a slow reader loses the oldest frames without disturbing the others.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestOverrun
+(
+    void
+)
+{
+    nmeaStream_ReaderRef_t slowReader = OpenReader();
+    nmeaStream_ReaderRef_t fastReader = OpenReader();
+    char buf[NMEA_STREAM_SLOT_DATA_BYTES];
+    size_t len;
+    int i;
+    int fastCount = 0;
+    int slowCount = 0;
+    bool ordered = true;
+
+    for (i = 0; i < SLOT_COUNT + 5; i++)
+    {
+        char frame[16];
+        snprintf(frame, sizeof(frame), "%d", i);
+        nmeaStream_Write(frame, strlen(frame));
+
+        len = sizeof(buf);
+        if (LE_OK == nmeaStream_Read(fastReader, buf, &len))
+        {
+            fastCount++;
+        }
+    }
+
+    len = sizeof(buf) - 1;
+    while (LE_OK == nmeaStream_Read(slowReader, buf, &len))
+    {
+        buf[len] = '\0';
+        if (atoi(buf) != 5 + slowCount)
+        {
+            ordered = false;
+        }
+        slowCount++;
+        len = sizeof(buf) - 1;
+    }
+
+    LE_TEST_OK(SLOT_COUNT + 5 == fastCount, "Fast reader got all the frames");
+    LE_TEST_OK(0 == nmeaStream_GetOverrunCount(fastReader), "No overrun for the fast reader");
+    LE_TEST_OK(SLOT_COUNT == slowCount, "Slow reader got the last %d frames", slowCount);
+    LE_TEST_OK(ordered, "Slow reader got the newest frames in order");
+    LE_TEST_OK(5 == nmeaStream_GetOverrunCount(slowReader), "Overrun of the slow reader: %" PRIu32,
+               nmeaStream_GetOverrunCount(slowReader));
+
+    nmeaStream_Close(slowReader);
+    nmeaStream_Close(fastReader);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Thread writing a frame after a delay.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* DelayedWriter
+(
+    void* contextPtr
+)
+{
+    usleep(50000);
+    nmeaStream_Write(NMEA_FRAME, sizeof(NMEA_FRAME) - 1);
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test waiting for new frames.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestWait
+(
+    void
+)
+{
+    nmeaStream_ReaderRef_t readerRef = OpenReader();
+    char buf[NMEA_STREAM_SLOT_DATA_BYTES];
+    size_t len = sizeof(buf);
+
+    LE_TEST_OK(LE_TIMEOUT == nmeaStream_Wait(readerRef, 10), "Wait times out without frame");
+
+    le_thread_Ref_t threadRef = le_thread_Create("NmeaWriter", DelayedWriter, NULL);
+    le_thread_SetJoinable(threadRef);
+    le_thread_Start(threadRef);
+
+    LE_TEST_OK(LE_OK == nmeaStream_Wait(readerRef, 5000), "Wait woken up by the writer");
+    LE_TEST_OK(LE_OK == nmeaStream_Read(readerRef, buf, &len), "Frame read after wait");
+
+    le_thread_Join(threadRef, NULL);
+    nmeaStream_Close(readerRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * main of the test
+ */
+//--------------------------------------------------------------------------------------------------
+COMPONENT_INIT
+{
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+
+    TestCreate();
+    TestReaders();
+    TestLongFrame();
+    TestOverrun();
+    TestWait();
+
+    LE_TEST_EXIT;
+}
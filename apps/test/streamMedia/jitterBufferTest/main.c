@@ -0,0 +1,449 @@
+/**
+ * This module tests the streamMedia jitter buffer over a simulated RTP loopback, injecting network
+ * jitter, packet loss and reordering between the sender and the receiver.
+ *
+ * The sender produces one frame every frame duration, tagged with its sequence number. The
+ * network delays, drops or reorders the frames, and the receiver plays them out from the jitter
+ * buffer at the frame rate. The time is simulated, so that the test is deterministic and fast.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "jitterBuffer.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stream format: 8 kHz, 20 ms frames of 16 bits samples.
+ */
+//--------------------------------------------------------------------------------------------------
+#define CLOCK_RATE          8000
+#define FRAME_SAMPLES       160
+#define FRAME_BYTES         (FRAME_SAMPLES * sizeof(int16_t))
+#define FRAME_US            20000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Network delay without jitter, and phase of the receiver ticks, in microseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+#define BASE_DELAY_US       30000
+#define TICK_PHASE_US       7000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of frames of a stream.
+ */
+//--------------------------------------------------------------------------------------------------
+#define STREAM_FRAMES       1500
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Value of the second sample of the sent frames, telling them from the concealed ones, and value
+ * of the other samples.
+ */
+//--------------------------------------------------------------------------------------------------
+#define FRAME_MAGIC         0x5A5A
+#define FRAME_LEVEL         1000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Simulated network.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t jitterUs;          ///< Maximum delay added to the base delay
+    uint32_t lossPermille;      ///< Packet loss rate
+    uint32_t reorderPermille;   ///< Rate of packets overtaken by the next one
+    uint32_t calmFrom;          ///< Frame from which the network has no jitter nor loss, 0 if none
+}
+Network_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Packet in flight.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint16_t seq;               ///< Sequence number
+    uint32_t timestamp;         ///< RTP timestamp
+    uint64_t arrivalUs;         ///< Arrival time at the receiver
+}
+Packet_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Result of a stream.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t             dropped;       ///< Packets dropped by the network
+    uint32_t             played;        ///< Sent frames played out
+    uint32_t             outOfOrder;    ///< Sent frames played out after a later one
+    uint32_t             maxTarget;     ///< Maximum target depth
+    uint32_t             endDepth;      ///< Depth when the last packet is received
+    jitterBuffer_Stats_t stats;         ///< Statistics at the end of the stream
+}
+Result_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Packets of the stream, sorted by arrival time.
+ */
+//--------------------------------------------------------------------------------------------------
+static Packet_t Packets[STREAM_FRAMES];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pseudo random generator state, for a reproducible network.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t Seed = 1;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get a pseudo random number.
+ *
+ * @return A number lower than the range.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t Random
+(
+    uint32_t range
+)
+{
+    Seed = Seed * 1103515245 + 12345;
+    return (Seed >> 8) % range;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Build the frame of a sequence number.
+ */
+//--------------------------------------------------------------------------------------------------
+static void MakeFrame
+(
+    uint16_t seq,
+    uint8_t* framePtr
+)
+{
+    int16_t samples[FRAME_SAMPLES];
+    int i;
+
+    samples[0] = (int16_t)seq;
+    samples[1] = FRAME_MAGIC;
+    for (i = 2; i < FRAME_SAMPLES; i++)
+    {
+        samples[i] = FRAME_LEVEL;
+    }
+
+    memcpy(framePtr, samples, FRAME_BYTES);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get a sample of a frame.
+ */
+//--------------------------------------------------------------------------------------------------
+static int16_t GetSample
+(
+    const uint8_t* framePtr,
+    int            index
+)
+{
+    int16_t sample;
+
+    memcpy(&sample, &framePtr[index * sizeof(int16_t)], sizeof(sample));
+    return sample;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compare the arrival times of two packets.
+ */
+//--------------------------------------------------------------------------------------------------
+static int CompareArrival
+(
+    const void* aPtr,
+    const void* bPtr
+)
+{
+    const Packet_t* packetAPtr = aPtr;
+    const Packet_t* packetBPtr = bPtr;
+
+    if (packetAPtr->arrivalUs != packetBPtr->arrivalUs)
+    {
+        return (packetAPtr->arrivalUs < packetBPtr->arrivalUs) ? -1 : 1;
+    }
+    return (packetAPtr->seq < packetBPtr->seq) ? -1 : 1;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Put a frame in the jitter buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PutFrame
+(
+    jitterBuffer_Ref_t bufferRef,
+    uint16_t           seq,
+    uint32_t           timestamp,
+    uint64_t           arrivalUs
+)
+{
+    uint8_t frame[FRAME_BYTES];
+
+    MakeFrame(seq, frame);
+    jitterBuffer_Put(bufferRef, seq, timestamp, arrivalUs, frame, sizeof(frame));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send a stream through the simulated network and play it out.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunStream
+(
+    jitterBuffer_Ref_t bufferRef,
+    uint16_t           firstSeq,
+    const Network_t*   networkPtr,
+    Result_t*          resultPtr
+)
+{
+    uint8_t frame[JITTERBUFFER_MAX_FRAME_BYTES];
+    uint32_t count = 0;
+    uint32_t received = 0;
+    uint16_t lastSeq = 0;
+    uint32_t i;
+    uint64_t tick;
+
+    memset(resultPtr, 0, sizeof(*resultPtr));
+    jitterBuffer_Reset(bufferRef);
+
+    for (i = 0; i < STREAM_FRAMES; i++)
+    {
+        bool calm = (0 != networkPtr->calmFrom) && (i >= networkPtr->calmFrom);
+        uint64_t delayUs = BASE_DELAY_US;
+
+        if (!calm && (Random(1000) < networkPtr->lossPermille))
+        {
+            resultPtr->dropped++;
+            continue;
+        }
+        if (!calm)
+        {
+            delayUs += Random(networkPtr->jitterUs + 1);
+            if (Random(1000) < networkPtr->reorderPermille)
+            {
+                delayUs += FRAME_US + FRAME_US / 2;
+            }
+        }
+
+        Packets[count].seq = (uint16_t)(firstSeq + i);
+        Packets[count].timestamp = i * FRAME_SAMPLES;
+        Packets[count].arrivalUs = (uint64_t)i * FRAME_US + delayUs;
+        count++;
+    }
+
+    qsort(Packets, count, sizeof(Packet_t), CompareArrival);
+
+    // Play out until the stream stalls after the last packet.
+    for (tick = 0; ; tick++)
+    {
+        uint64_t nowUs = tick * FRAME_US + TICK_PHASE_US;
+        jitterBuffer_Stats_t stats;
+
+        while ((received < count) && (Packets[received].arrivalUs <= nowUs))
+        {
+            PutFrame(bufferRef, Packets[received].seq, Packets[received].timestamp,
+                     Packets[received].arrivalUs);
+            received++;
+        }
+
+        size_t size = jitterBuffer_Get(bufferRef, frame, sizeof(frame));
+
+        if ((FRAME_BYTES == size) && (FRAME_MAGIC == GetSample(frame, 1)))
+        {
+            uint16_t seq = (uint16_t)GetSample(frame, 0);
+
+            if ((0 != resultPtr->played) && ((int16_t)(seq - lastSeq) <= 0))
+            {
+                resultPtr->outOfOrder++;
+            }
+            lastSeq = seq;
+            resultPtr->played++;
+        }
+
+        jitterBuffer_GetStats(bufferRef, &stats);
+        if (stats.targetDepth > resultPtr->maxTarget)
+        {
+            resultPtr->maxTarget = stats.targetDepth;
+        }
+
+        if (received == count)
+        {
+            if (0 == resultPtr->endDepth)
+            {
+                resultPtr->endDepth = stats.depth;
+            }
+            if (0 == size)
+            {
+                break;
+            }
+        }
+    }
+
+    jitterBuffer_GetStats(bufferRef, &resultPtr->stats);
+
+    LE_TEST_INFO("Jitter %" PRIu32 " us, loss %" PRIu32 "/1000, reorder %" PRIu32 "/1000: "
+                 "%" PRIu32 " dropped, %" PRIu32 " played, target up to %" PRIu32 " frames, "
+                 "%" PRIu32 " late, %" PRIu32 " lost, %" PRIu32 " concealed",
+                 networkPtr->jitterUs, networkPtr->lossPermille, networkPtr->reorderPermille,
+                 resultPtr->dropped, resultPtr->played, resultPtr->maxTarget,
+                 resultPtr->stats.lateCount, resultPtr->stats.lostCount,
+                 resultPtr->stats.concealedCount);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test the concealment of missing frames, and the late and duplicated frames.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestConcealment
+(
+    jitterBuffer_Ref_t bufferRef
+)
+{
+    uint8_t frame[JITTERBUFFER_MAX_FRAME_BYTES];
+    jitterBuffer_Stats_t stats;
+    uint16_t seq;
+    int run;
+
+    jitterBuffer_Reset(bufferRef);
+
+    LE_TEST_OK(0 == jitterBuffer_Get(bufferRef, frame, sizeof(frame)), "Nothing to play out");
+
+    for (seq = 0; seq < 2; seq++)
+    {
+        PutFrame(bufferRef, seq, seq * FRAME_SAMPLES, seq * FRAME_US);
+    }
+    PutFrame(bufferRef, 1, FRAME_SAMPLES, FRAME_US);
+    jitterBuffer_GetStats(bufferRef, &stats);
+    LE_TEST_OK(2 == stats.depth, "Duplicated frame dropped");
+
+    LE_TEST_OK((FRAME_BYTES == jitterBuffer_Get(bufferRef, frame, sizeof(frame))) &&
+               (0 == GetSample(frame, 0)), "Frame 0 played out");
+    LE_TEST_OK((FRAME_BYTES == jitterBuffer_Get(bufferRef, frame, sizeof(frame))) &&
+               (1 == GetSample(frame, 0)), "Frame 1 played out");
+
+    // Frame 2 is delayed: the last frame is repeated, and frame 2 is still expected.
+    LE_TEST_OK((FRAME_BYTES == jitterBuffer_Get(bufferRef, frame, sizeof(frame))) &&
+               (FRAME_LEVEL * 4 / 5 == GetSample(frame, 2)), "Delayed frame concealed");
+
+    // Frame 2 is lost: it is concealed and skipped once the next frame is received.
+    PutFrame(bufferRef, 3, 3 * FRAME_SAMPLES, 3 * FRAME_US);
+    LE_TEST_OK((FRAME_BYTES == jitterBuffer_Get(bufferRef, frame, sizeof(frame))) &&
+               (FRAME_LEVEL * 3 / 5 == GetSample(frame, 2)), "Lost frame concealed");
+    LE_TEST_OK((FRAME_BYTES == jitterBuffer_Get(bufferRef, frame, sizeof(frame))) &&
+               (3 == GetSample(frame, 0)), "Frame 3 played out");
+
+    PutFrame(bufferRef, 2, 2 * FRAME_SAMPLES, 4 * FRAME_US);
+    jitterBuffer_GetStats(bufferRef, &stats);
+    LE_TEST_OK((0 == stats.depth) && (1 == stats.lateCount) && (1 == stats.lostCount) &&
+               (2 == stats.concealedCount), "Late frame dropped: %" PRIu32 " late, %" PRIu32
+               " lost, %" PRIu32 " concealed", stats.lateCount, stats.lostCount,
+               stats.concealedCount);
+
+    // The stream stalls: the last frame fades out, then nothing is played out.
+    int16_t level = FRAME_LEVEL;
+    bool fading = true;
+    for (run = 0; run < 4; run++)
+    {
+        if ((FRAME_BYTES != jitterBuffer_Get(bufferRef, frame, sizeof(frame))) ||
+            (GetSample(frame, 2) >= level))
+        {
+            fading = false;
+        }
+        level = GetSample(frame, 2);
+    }
+    LE_TEST_OK(fading, "Last frame faded out");
+    LE_TEST_OK(0 == jitterBuffer_Get(bufferRef, frame, sizeof(frame)), "Stalled stream");
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test streams over simulated networks.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestNetworks
+(
+    jitterBuffer_Ref_t bufferRef
+)
+{
+    Result_t result;
+
+    const Network_t clean = { 0, 0, 0, 0 };
+    RunStream(bufferRef, 0, &clean, &result);
+    LE_TEST_OK((STREAM_FRAMES == result.played) && (0 == result.outOfOrder) &&
+               (0 == result.stats.lateCount) && (0 == result.stats.lostCount) &&
+               (1 == result.maxTarget), "Clean network: every frame played out in order");
+
+    // Across the sequence number wrap-around.
+    RunStream(bufferRef, 65000, &clean, &result);
+    LE_TEST_OK((STREAM_FRAMES == result.played) && (0 == result.outOfOrder) &&
+               (0 == result.stats.lostCount), "Sequence number wrap-around");
+
+    const Network_t jittery = { 80000, 0, 0, 0 };
+    RunStream(bufferRef, 100, &jittery, &result);
+    LE_TEST_OK(0 == result.outOfOrder, "Jitter: frames played out in order");
+    LE_TEST_OK(result.maxTarget >= 3, "Jitter: target depth raised to %" PRIu32 " frames",
+               result.maxTarget);
+    LE_TEST_OK(result.stats.lateCount * 100 < STREAM_FRAMES * 2,
+               "Jitter: %" PRIu32 " late frames", result.stats.lateCount);
+
+    const Network_t lossy = { 20000, 50, 0, 0 };
+    RunStream(bufferRef, 200, &lossy, &result);
+    LE_TEST_OK(0 == result.outOfOrder, "Loss: frames played out in order");
+    LE_TEST_OK((result.stats.lostCount + 1 >= result.dropped) &&
+               (result.stats.lostCount <= result.dropped + result.stats.lateCount),
+               "Loss: %" PRIu32 " lost frames for %" PRIu32 " dropped",
+               result.stats.lostCount, result.dropped);
+    LE_TEST_OK(result.stats.concealedCount >= result.stats.lostCount, "Loss: lost frames concealed");
+
+    const Network_t reordering = { 0, 0, 100, 0 };
+    RunStream(bufferRef, 300, &reordering, &result);
+    LE_TEST_OK(0 == result.outOfOrder, "Reordering: frames played out in order");
+    LE_TEST_OK(result.stats.lateCount * 100 < STREAM_FRAMES,
+               "Reordering: %" PRIu32 " late frames", result.stats.lateCount);
+
+    const Network_t calming = { 120000, 20, 0, STREAM_FRAMES / 3 };
+    RunStream(bufferRef, 400, &calming, &result);
+    LE_TEST_OK(0 == result.outOfOrder, "Calming network: frames played out in order");
+    LE_TEST_OK((result.maxTarget >= 4) && (result.stats.targetDepth <= 2) &&
+               (result.endDepth <= result.stats.targetDepth + 2),
+               "Calming network: target depth up to %" PRIu32 ", back to %" PRIu32
+               ", depth %" PRIu32, result.maxTarget, result.stats.targetDepth, result.endDepth);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * main of the test
+ */
+//--------------------------------------------------------------------------------------------------
+COMPONENT_INIT
+{
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+
+    jitterBuffer_Init();
+    jitterBuffer_Ref_t bufferRef = jitterBuffer_Create(CLOCK_RATE, FRAME_SAMPLES);
+
+    TestConcealment(bufferRef);
+    TestNetworks(bufferRef);
+
+    jitterBuffer_Delete(bufferRef);
+
+    LE_TEST_EXIT;
+}
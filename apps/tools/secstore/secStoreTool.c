@@ -158,23 +158,27 @@ static void ListEntries
     void
 )
 {
-    // Iterate over the Path and print the values to stdout.
+    // Iterate over the Path and print the values to stdout.  Entry names are fetched several at a
+    // time; directory names come back with a trailing separator.
     secStoreAdmin_IterRef_t iterRef = secStoreAdmin_CreateIter(Path);
 
     if (iterRef != NULL)
     {
-        while (secStoreAdmin_Next(iterRef) == LE_OK)
+        uint8_t names[SECSTOREADMIN_MAX_ENTRIES_BYTES];
+        size_t namesSize = sizeof(names);
+        uint32_t numEntries;
+
+        while (secStoreAdmin_GetNextEntries(iterRef, names, &namesSize, &numEntries) == LE_OK)
         {
-            bool isDir;
-            char entryName[SECSTOREADMIN_MAX_PATH_BYTES];
+            const char* entryName = (const char*)names;
 
-            if (secStoreAdmin_GetEntry(iterRef, entryName, sizeof(entryName), &isDir) == LE_OK)
+            for (; numEntries > 0; numEntries--, entryName += strlen(entryName) + 1)
             {
-                char sizeStr[100] = "";
-
                 // See if we have to print the entry size.
                 if (ListSizeFlag)
                 {
+                    char sizeStr[100] = "";
+
                     // Get the entry size.
                     char fullPath[SECSTOREADMIN_MAX_PATH_BYTES] = "";
 
@@ -197,27 +201,18 @@ static void ListEntries
                         snprintf(sizeStr, sizeof(sizeStr), "%" PRIu64, size);
                     }
 
-                    printf("%-12s %s", sizeStr, entryName);
+                    printf("%-12s %s\n", sizeStr, entryName);
                 }
                 else
                 {
-                    printf("%s", entryName);
+                    printf("%s\n", entryName);
                 }
-
-                if (isDir)
-                {
-                    printf("/\n");
-                }
-                else
-                {
-                    printf("\n");
-                }
-            }
-            else
-            {
-                break;
             }
+
+            namesSize = sizeof(names);
         }
+
+        secStoreAdmin_DeleteIter(iterRef);
     }
     else
     {
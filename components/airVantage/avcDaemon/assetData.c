@@ -66,6 +66,15 @@
 #define MAX_CBOR_BUFFER_NUMBYTES 1024
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initial capacity of the maps indexing all the asset instances and fields
+ */
+//--------------------------------------------------------------------------------------------------
+#define INSTANCE_MAP_CAPACITY 63
+#define FIELD_MAP_CAPACITY 511
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Checks the return value from the tinyCBOR encoder and returns from function if an error is found.
@@ -138,6 +147,33 @@ typedef struct assetData_AssetData
 AssetData_t;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Key of an instance in InstanceMap, or of a field in FieldMap: the id of the instance or field
+ * within its containing asset or instance.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const void* containerPtr;    ///< Asset containing the instance, or instance containing the field
+    int id;                      ///< Instance id or field id
+}
+IdKey_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Key of a field in FieldMapByName: the name of the field within its containing instance.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const void* containerPtr;    ///< Instance containing the field
+    const char* namePtr;         ///< Field name
+}
+NameKey_t;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Data contained in a single asset instance
@@ -149,6 +185,8 @@ typedef struct le_avdata_AssetInstance
     AssetData_t* assetDataPtr;   ///< Back reference to asset data containing this instance
     le_dls_List_t fieldList;     ///< List of fields for this instance
     le_dls_Link_t link;          ///< For adding to the asset instance list
+    IdKey_t key;                 ///< Key in InstanceMap
+    bool isBatchStarted;         ///< Are observe notifications deferred until the batch commit?
 }
 InstanceData_t;
 
@@ -210,6 +248,10 @@ typedef struct
 
     TimeSeriesData_t* timeSeriesPtr;
 
+    bool isNotifyPending;        ///< Changed during a batch, and not yet notified
+    IdKey_t idKey;               ///< Key in FieldMap
+    NameKey_t nameKey;           ///< Key in FieldMapByName
+
     le_dls_Link_t link;          ///< For adding to the field list
 }
 FieldData_t;
@@ -323,6 +365,30 @@ static le_hashmap_Ref_t AssetMap = NULL;
 static le_hashmap_Ref_t AssetMapByName = NULL;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maps (asset, instanceId) to an InstanceData block.  Initialized in assetData_Init().
+ */
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t InstanceMap = NULL;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maps (instance, fieldId) to a FieldData block.  Initialized in assetData_Init().
+ */
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t FieldMap = NULL;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maps (instance, fieldName) to a FieldData block.  Initialized in assetData_Init().
+ */
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t FieldMapByName = NULL;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Used to delay reporting REG_UPDATE, so that we don't generate too much message traffic.
@@ -387,15 +453,22 @@ static bool IsRegUpdatePending = false;
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Declare this function here, until the QMI functions are moved out of this file.
+ * Declare these functions here, until the QMI functions are moved out of this file.
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t WriteNotifyObjectToTLV
+static le_result_t WriteInstanceToTLV
 (
-    assetData_AssetDataRef_t assetRef,          ///< [IN] Asset to use
-    int instanceId,                             ///< [IN] Instance that has a changed resource
-    int fieldId,                                ///< [IN] The resource which changed
-    uint8_t* bufPtr,                            ///< [OUT] Buffer for writing the TLV list
+    assetData_InstanceDataRef_t instanceRef,    ///< [IN] Asset instance to use
+    int fieldId,                                ///< [IN] Field to write, or -1 for all fields
+    uint8_t* bufPtr,                            ///< [OUT] Buffer for writing the object instance
+    size_t bufNumBytes,                         ///< [IN] Size of buffer
+    size_t* numBytesWrittenPtr                  ///< [OUT] # bytes written to buffer.
+);
+
+static le_result_t WritePendingNotifyToTLV
+(
+    assetData_InstanceDataRef_t instanceRef,    ///< [IN] Asset instance to use
+    uint8_t* bufPtr,                            ///< [OUT] Buffer for writing the object instance
     size_t bufNumBytes,                         ///< [IN] Size of buffer
     size_t* numBytesWrittenPtr                  ///< [OUT] # bytes written to buffer.
 );
@@ -405,6 +478,112 @@ static le_result_t WriteNotifyObjectToTLV
 //--------------------------------------------------------------------------------------------------
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hash function for IdKey_t keys
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t HashIdKey
+(
+    const void* keyPtr
+)
+{
+    const IdKey_t* idKeyPtr = keyPtr;
+
+    return (((size_t)idKeyPtr->containerPtr >> 3) * 31) + (size_t)idKeyPtr->id;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Equality function for IdKey_t keys
+ */
+//--------------------------------------------------------------------------------------------------
+static bool EqualsIdKey
+(
+    const void* firstKeyPtr,
+    const void* secondKeyPtr
+)
+{
+    const IdKey_t* firstPtr = firstKeyPtr;
+    const IdKey_t* secondPtr = secondKeyPtr;
+
+    return (firstPtr->containerPtr == secondPtr->containerPtr) && (firstPtr->id == secondPtr->id);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hash function for NameKey_t keys
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t HashNameKey
+(
+    const void* keyPtr
+)
+{
+    const NameKey_t* nameKeyPtr = keyPtr;
+
+    return le_hashmap_HashString(nameKeyPtr->namePtr) ^ ((size_t)nameKeyPtr->containerPtr >> 3);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Equality function for NameKey_t keys
+ */
+//--------------------------------------------------------------------------------------------------
+static bool EqualsNameKey
+(
+    const void* firstKeyPtr,
+    const void* secondKeyPtr
+)
+{
+    const NameKey_t* firstPtr = firstKeyPtr;
+    const NameKey_t* secondPtr = secondKeyPtr;
+
+    return (firstPtr->containerPtr == secondPtr->containerPtr) &&
+           (strcmp(firstPtr->namePtr, secondPtr->namePtr) == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add an instance and all its fields to InstanceMap, FieldMap and FieldMapByName. The instance id
+ * and asset back reference must be set.
+ */
+//--------------------------------------------------------------------------------------------------
+static void IndexInstance
+(
+    InstanceData_t* instanceDataPtr     ///< [IN] Instance to add
+)
+{
+    FieldData_t* fieldDataPtr;
+    le_dls_Link_t* linkPtr;
+
+    instanceDataPtr->key.containerPtr = instanceDataPtr->assetDataPtr;
+    instanceDataPtr->key.id = instanceDataPtr->instanceId;
+    le_hashmap_Put(InstanceMap, &instanceDataPtr->key, instanceDataPtr);
+
+    linkPtr = le_dls_Peek(&instanceDataPtr->fieldList);
+
+    while ( linkPtr != NULL )
+    {
+        fieldDataPtr = CONTAINER_OF(linkPtr, FieldData_t, link);
+
+        fieldDataPtr->idKey.containerPtr = instanceDataPtr;
+        fieldDataPtr->idKey.id = fieldDataPtr->fieldId;
+        le_hashmap_Put(FieldMap, &fieldDataPtr->idKey, fieldDataPtr);
+
+        fieldDataPtr->nameKey.containerPtr = instanceDataPtr;
+        fieldDataPtr->nameKey.namePtr = fieldDataPtr->name;
+        le_hashmap_Put(FieldMapByName, &fieldDataPtr->nameKey, fieldDataPtr);
+
+        linkPtr = le_dls_PeekNext(&instanceDataPtr->fieldList, linkPtr);
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Write the formatted string to a buffer
@@ -558,6 +737,7 @@ static void InitDefaultFieldData
 )
 {
     fieldDataPtr->isObserve = false;
+    fieldDataPtr->isNotifyPending = false;
     fieldDataPtr->readCallBackOpRef = NULL;
 
     fieldDataPtr->timeSeriesPtr = NULL;
@@ -1121,28 +1301,16 @@ static le_result_t GetInstanceFromAssetData
     InstanceData_t** instanceDataPtrPtr   ///< [OUT]
 )
 {
-    InstanceData_t* assetInstancePtr;
-    le_dls_Link_t* linkPtr;
-
-    // Get the start of the instance list
-    linkPtr = le_dls_Peek(&assetDataPtr->instanceList);
+    IdKey_t key = { .containerPtr = assetDataPtr, .id = instanceId };
+    InstanceData_t* assetInstancePtr = le_hashmap_Get(InstanceMap, &key);
 
-    // Loop through the asset instances
-    while ( linkPtr != NULL )
+    if ( assetInstancePtr == NULL )
     {
-        assetInstancePtr = CONTAINER_OF(linkPtr, InstanceData_t, link);
-        //LE_PRINT_VALUE("%i", assetInstancePtr->instanceId);
-
-        if ( assetInstancePtr->instanceId == instanceId )
-        {
-            *instanceDataPtrPtr = assetInstancePtr;
-            return LE_OK;
-        }
-
-        linkPtr = le_dls_PeekNext(&assetDataPtr->instanceList, linkPtr);
+        return LE_NOT_FOUND;
     }
 
-    return LE_NOT_FOUND;
+    *instanceDataPtrPtr = assetInstancePtr;
+    return LE_OK;
 }
 
 
@@ -1162,28 +1330,16 @@ static le_result_t GetFieldFromInstance
     FieldData_t** fieldDataPtrPtr   ///< [OUT]
 )
 {
-    FieldData_t* fieldDataPtr;
-    le_dls_Link_t* fieldLinkPtr;
+    IdKey_t key = { .containerPtr = instanceDataPtr, .id = fieldId };
+    FieldData_t* fieldDataPtr = le_hashmap_Get(FieldMap, &key);
 
-    // Get the start of the field list
-    fieldLinkPtr = le_dls_Peek(&instanceDataPtr->fieldList);
-
-    // Loop through the fields
-    while ( fieldLinkPtr != NULL )
+    if ( fieldDataPtr == NULL )
     {
-        fieldDataPtr = CONTAINER_OF(fieldLinkPtr, FieldData_t, link);
-        //LE_PRINT_VALUE("%i", fieldDataPtr->fieldId);
-
-        if ( fieldDataPtr->fieldId == fieldId )
-        {
-            *fieldDataPtrPtr = fieldDataPtr;
-            return LE_OK;
-        }
-
-        fieldLinkPtr = le_dls_PeekNext(&instanceDataPtr->fieldList, fieldLinkPtr);
+        return LE_NOT_FOUND;
     }
 
-    return LE_NOT_FOUND;
+    *fieldDataPtrPtr = fieldDataPtr;
+    return LE_OK;
 }
 
 
@@ -2129,6 +2285,60 @@ static le_result_t GetFloat
     return LE_OK;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Notify the server that an observed field was changed by the client.
+ *
+ * The server sends notify on entire object, so the TLV of the entire object is sent, but it
+ * includes only the resource that changed. If a batch is started on the instance, the notification
+ * is deferred and coalesced with the other changes of the batch by assetData_client_CommitBatch().
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_FAULT on error
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t NotifyFieldChange
+(
+    assetData_InstanceDataRef_t instanceRef,    ///< [IN] Asset instance containing the field
+    FieldData_t* fieldDataPtr                   ///< [IN] The field which changed
+)
+{
+    uint8_t valueData[256+1];
+    size_t bytesWritten;
+    pa_avc_LWM2MOperationDataRef_t opRef;
+
+    if (instanceRef->isBatchStarted)
+    {
+        fieldDataPtr->isNotifyPending = true;
+        return LE_OK;
+    }
+
+    if ( WriteInstanceToTLV(instanceRef,
+                            fieldDataPtr->fieldId,
+                            valueData,
+                            sizeof(valueData),
+                            &bytesWritten) != LE_OK )
+    {
+        LE_ERROR("Failed to send lwm2m notification.");
+        return LE_FAULT;
+    }
+
+    opRef = pa_avc_CreateOpData(instanceRef->assetDataPtr->appName,
+                                instanceRef->assetDataPtr->assetId,
+                                -1,
+                                -1,
+                                PA_AVC_OPTYPE_NOTIFY,
+                                TLV_ENCODING,
+                                fieldDataPtr->token,
+                                fieldDataPtr->tokenLength);
+
+    pa_avc_NotifyChange(opRef, valueData, bytesWritten);
+
+    return LE_OK;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Set the integer value for the specified field
@@ -2157,7 +2367,6 @@ static le_result_t SetInt
     uint8_t valueData[256+1];  // +1 for null byte, if storing a string
     size_t bytesWritten;
     int prevValue;
-    pa_avc_LWM2MOperationDataRef_t opRef;
 
     result = GetFieldFromInstance(instanceRef, fieldId, &fieldDataPtr);
 
@@ -2204,39 +2413,11 @@ static le_result_t SetInt
     }
 
     // Notify the server if observe is enabled and the value is changed.
-    // The server sends notify on entire object, so we need to send the TLV of entire
-    // object but include only the resource that changed.
     if (fieldDataPtr->isObserve && prevValue != value && isClient == true)
     {
-        assetData_AssetDataRef_t assetRef;
-        result = assetData_GetAssetRefById(instanceRef->assetDataPtr->appName,
-                                           instanceRef->assetDataPtr->assetId,
-                                           &assetRef);
-
-        if ( result == LE_OK)
+        if ( NotifyFieldChange(instanceRef, fieldDataPtr) != LE_OK )
         {
-            result = WriteNotifyObjectToTLV(assetRef,
-                                            instanceRef->instanceId,
-                                            fieldId,
-                                            valueData,
-                                            sizeof(valueData),
-                                            &bytesWritten);
-            if ( result != LE_OK )
-            {
-                LE_ERROR("Failed to send lwm2m notification.");
-                return LE_FAULT;
-            }
-
-            opRef = pa_avc_CreateOpData(instanceRef->assetDataPtr->appName,
-                                        instanceRef->assetDataPtr->assetId,
-                                        -1,
-                                        -1,
-                                        PA_AVC_OPTYPE_NOTIFY,
-                                        TLV_ENCODING,
-                                        fieldDataPtr->token,
-                                        fieldDataPtr->tokenLength);
-
-            pa_avc_NotifyChange(opRef, valueData, bytesWritten);
+            return LE_FAULT;
         }
     }
 
@@ -2272,7 +2453,6 @@ static le_result_t SetFloat
     uint8_t valueData[256+1];  // +1 for null byte, if storing a string
     size_t bytesWritten;
     float prevValue;
-    pa_avc_LWM2MOperationDataRef_t opRef;
 
     result = GetFieldFromInstance(instanceRef, fieldId, &fieldDataPtr);
     if ( result != LE_OK )
@@ -2318,39 +2498,11 @@ static le_result_t SetFloat
     }
 
     // Notify the server if observe is enabled and the value is changed.
-    // The server sends notify on entire object, so we need to send the TLV of entire
-    // object but include only the resource that changed.
     if (fieldDataPtr->isObserve && prevValue != value && isClient == true)
     {
-        assetData_AssetDataRef_t assetRef;
-        result = assetData_GetAssetRefById(instanceRef->assetDataPtr->appName,
-                                           instanceRef->assetDataPtr->assetId,
-                                           &assetRef);
-
-        if ( result == LE_OK)
+        if ( NotifyFieldChange(instanceRef, fieldDataPtr) != LE_OK )
         {
-            result = WriteNotifyObjectToTLV(assetRef,
-                                            instanceRef->instanceId,
-                                            fieldId,
-                                            valueData,
-                                            sizeof(valueData),
-                                            &bytesWritten);
-            if ( result != LE_OK )
-            {
-                LE_ERROR("Failed to send lwm2m notification.");
-                return LE_FAULT;
-            }
-
-            opRef = pa_avc_CreateOpData(instanceRef->assetDataPtr->appName,
-                                        instanceRef->assetDataPtr->assetId,
-                                        -1,
-                                        -1,
-                                        PA_AVC_OPTYPE_NOTIFY,
-                                        TLV_ENCODING,
-                                        fieldDataPtr->token,
-                                        fieldDataPtr->tokenLength);
-
-            pa_avc_NotifyChange(opRef, valueData, bytesWritten);
+            return LE_FAULT;
         }
     }
 
@@ -2427,7 +2579,6 @@ static le_result_t SetBool
     uint8_t valueData[256+1];  // +1 for null byte, if storing a string
     size_t bytesWritten;
     bool prevValue;
-    pa_avc_LWM2MOperationDataRef_t opRef;
 
     result = GetFieldFromInstance(instanceRef, fieldId, &fieldDataPtr);
     if ( result != LE_OK )
@@ -2473,39 +2624,11 @@ static le_result_t SetBool
     }
 
     // Notify the server if observe is enabled and the value is changed.
-    // The server sends notify on entire object, so we need to send the TLV of entire
-    // object but include only the resource that changed.
     if (fieldDataPtr->isObserve && prevValue != value && isClient == true)
     {
-        assetData_AssetDataRef_t assetRef;
-        result = assetData_GetAssetRefById(instanceRef->assetDataPtr->appName,
-                                           instanceRef->assetDataPtr->assetId,
-                                           &assetRef);
-
-        if ( result == LE_OK)
+        if ( NotifyFieldChange(instanceRef, fieldDataPtr) != LE_OK )
         {
-            result = WriteNotifyObjectToTLV(assetRef,
-                                            instanceRef->instanceId,
-                                            fieldId,
-                                            valueData,
-                                            sizeof(valueData),
-                                            &bytesWritten);
-            if ( result != LE_OK )
-            {
-                LE_ERROR("Failed to send lwm2m notification.");
-                return LE_FAULT;
-            }
-
-            opRef = pa_avc_CreateOpData(instanceRef->assetDataPtr->appName,
-                                        instanceRef->assetDataPtr->assetId,
-                                        -1,
-                                        -1,
-                                        PA_AVC_OPTYPE_NOTIFY,
-                                        TLV_ENCODING,
-                                        fieldDataPtr->token,
-                                        fieldDataPtr->tokenLength);
-
-            pa_avc_NotifyChange(opRef, valueData, bytesWritten);
+            return LE_FAULT;
         }
     }
 
@@ -2585,7 +2708,6 @@ static le_result_t SetString
     uint8_t valueData[256+1];  // +1 for null byte, if storing a string
     size_t bytesWritten;
     char prevStr[STRING_VALUE_NUMBYTES];
-    pa_avc_LWM2MOperationDataRef_t opRef;
 
     result = GetFieldFromInstance(instanceRef, fieldId, &fieldDataPtr);
     if ( result != LE_OK )
@@ -2631,39 +2753,11 @@ static le_result_t SetString
     }
 
     // Notify the server if observe is enabled and the value is changed.
-    // The server sends notify on entire object, so we need to send the TLV of entire
-    // object but include only the resource that changed.
     if (fieldDataPtr->isObserve && strcmp(prevStr, strPtr) != 0 && isClient == true)
     {
-        assetData_AssetDataRef_t assetRef;
-        result = assetData_GetAssetRefById(instanceRef->assetDataPtr->appName,
-                                           instanceRef->assetDataPtr->assetId,
-                                           &assetRef);
-
-        if ( result == LE_OK)
+        if ( NotifyFieldChange(instanceRef, fieldDataPtr) != LE_OK )
         {
-            result = WriteNotifyObjectToTLV(assetRef,
-                                            instanceRef->instanceId,
-                                            fieldId,
-                                            valueData,
-                                            sizeof(valueData),
-                                            &bytesWritten);
-            if ( result != LE_OK )
-            {
-                LE_ERROR("Failed to send lwm2m notification.");
-                return LE_FAULT;
-            }
-
-            opRef = pa_avc_CreateOpData(instanceRef->assetDataPtr->appName,
-                                        instanceRef->assetDataPtr->assetId,
-                                        -1,
-                                        -1,
-                                        PA_AVC_OPTYPE_NOTIFY,
-                                        TLV_ENCODING,
-                                        fieldDataPtr->token,
-                                        fieldDataPtr->tokenLength);
-
-            pa_avc_NotifyChange(opRef, valueData, bytesWritten);
+            return LE_FAULT;
         }
     }
 
@@ -3062,9 +3156,11 @@ le_result_t assetData_CreateInstanceById
 
     // Add back reference from instance data to the asset containing the instance
     assetInstPtr->assetDataPtr = assetDataPtr;
+    assetInstPtr->isBatchStarted = false;
 
 
     le_dls_Queue(&assetDataPtr->instanceList, &assetInstPtr->link);
+    IndexInstance(assetInstPtr);
 
     // todo: For now, for testing, print it out; add trace support later.
     if ( 0 )
@@ -3175,6 +3271,9 @@ void assetData_DeleteInstance
     {
         fieldDataPtr = CONTAINER_OF(linkPtr, FieldData_t, link);
 
+        le_hashmap_Remove(FieldMap, &fieldDataPtr->idKey);
+        le_hashmap_Remove(FieldMapByName, &fieldDataPtr->nameKey);
+
         // Some field types have allocated data, so release that first
         switch ( fieldDataPtr->type )
         {
@@ -3204,6 +3303,7 @@ void assetData_DeleteInstance
 
     // Remove the instance from the asset instance list
     le_dls_Remove(&instanceRef->assetDataPtr->instanceList, &instanceRef->link);
+    le_hashmap_Remove(InstanceMap, &instanceRef->key);
 
     // Lastly, release the instance data.
     le_mem_Release(instanceRef);
@@ -3553,40 +3653,20 @@ le_result_t assetData_GetFieldIdFromName
     /*
      * NOTE:
      *   The main use for this function is to get the fieldId that is then passed to the various
-     *   assetData_client_Get* functions.  This is not particularly efficient as it requires
-     *   iterating twice through the field list.  One alternative would be to add a new set of
-     *   assetData_client_Get* functions that take a field name instead of field id.
-     *
-     *   For now, assume that the performance is good enough, but if it becomes an issue then
-     *   this second set of functions may need to be added.  Of course, there might also be some
-     *   other alternative solution that has not yet been considered.
+     *   assetData_client_Get* functions.  Both the name and the id lookups go through hashmaps,
+     *   so the double lookup stays cheap even for assets with many fields.
      */
 
-    FieldData_t* fieldDataPtr;
-    le_dls_Link_t* fieldLinkPtr;
-
-    // Get the start of the field list
-    fieldLinkPtr = le_dls_Peek(&instanceRef->fieldList);
-
-    //LE_PRINT_VALUE("%s", instanceRef->assetDataPtr->appName);
-    //LE_PRINT_VALUE("%s", instanceRef->assetDataPtr->assetName);
+    NameKey_t key = { .containerPtr = instanceRef, .namePtr = fieldNamePtr };
+    FieldData_t* fieldDataPtr = le_hashmap_Get(FieldMapByName, &key);
 
-    // Loop through the fields
-    while ( fieldLinkPtr != NULL )
+    if ( fieldDataPtr == NULL )
     {
-        fieldDataPtr = CONTAINER_OF(fieldLinkPtr, FieldData_t, link);
-        //LE_PRINT_VALUE("%s", fieldDataPtr->name);
-
-        if ( strcmp(fieldDataPtr->name, fieldNamePtr) == 0 )
-        {
-            *fieldIdPtr = fieldDataPtr->fieldId;
-            return LE_OK;
-        }
-
-        fieldLinkPtr = le_dls_PeekNext(&instanceRef->fieldList, fieldLinkPtr);
+        return LE_FAULT;
     }
 
-    return LE_FAULT;
+    *fieldIdPtr = fieldDataPtr->fieldId;
+    return LE_OK;
 }
 
 
@@ -3879,6 +3959,275 @@ le_result_t assetData_client_RecordString
     return SetString(instanceRef, fieldId, strPtr, true, timeStamp);
 }
 
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse the string representation of a value for the specified field. Integer and float values
+ * must be fully numeric, boolean values are "true", "false", "1" or "0".
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_FORMAT_ERROR if the string is not a valid value for the field type
+ *      - LE_FAULT if the field has no value
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ParseFieldValue
+(
+    FieldData_t* fieldDataPtr,                  ///< [IN] Field to parse the value for
+    const char* strPtr,                         ///< [IN] The value to parse
+    int* intValuePtr,                           ///< [OUT] Parsed value, for integer fields
+    double* floatValuePtr,                      ///< [OUT] Parsed value, for float fields
+    bool* boolValuePtr                          ///< [OUT] Parsed value, for boolean fields
+)
+{
+    char* endPtr;
+    long intValue;
+
+    switch ( fieldDataPtr->type )
+    {
+        case DATA_TYPE_INT:
+            errno = 0;
+            intValue = strtol(strPtr, &endPtr, 10);
+            if ( (errno != 0) || (endPtr == strPtr) || (*endPtr != '\0') ||
+                 (intValue < INT_MIN) || (intValue > INT_MAX) )
+            {
+                return LE_FORMAT_ERROR;
+            }
+            *intValuePtr = (int)intValue;
+            return LE_OK;
+
+        case DATA_TYPE_FLOAT:
+            errno = 0;
+            *floatValuePtr = strtod(strPtr, &endPtr);
+            if ( (errno != 0) || (endPtr == strPtr) || (*endPtr != '\0') )
+            {
+                return LE_FORMAT_ERROR;
+            }
+            return LE_OK;
+
+        case DATA_TYPE_BOOL:
+            if ( (strcmp(strPtr, "true") == 0) || (strcmp(strPtr, "1") == 0) )
+            {
+                *boolValuePtr = true;
+            }
+            else if ( (strcmp(strPtr, "false") == 0) || (strcmp(strPtr, "0") == 0) )
+            {
+                *boolValuePtr = false;
+            }
+            else
+            {
+                return LE_FORMAT_ERROR;
+            }
+            return LE_OK;
+
+        case DATA_TYPE_STRING:
+            return LE_OK;
+
+        case DATA_TYPE_NONE:
+            break;
+    }
+
+    return LE_FAULT;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that a string is a valid value for the specified field, without setting it.
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_NOT_FOUND if field not found
+ *      - LE_FORMAT_ERROR if the string is not a valid value for the field type
+ *      - LE_FAULT on any other error
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t assetData_client_CheckValue
+(
+    assetData_InstanceDataRef_t instanceRef,    ///< [IN] Asset instance to use
+    int fieldId,                                ///< [IN] Field to check
+    const char* strPtr                          ///< [IN] The value to check
+)
+{
+    le_result_t result;
+    FieldData_t* fieldDataPtr;
+    int intValue;
+    double floatValue;
+    bool boolValue;
+
+    result = GetFieldFromInstance(instanceRef, fieldId, &fieldDataPtr);
+    if ( result != LE_OK )
+    {
+        return result;
+    }
+
+    return ParseFieldValue(fieldDataPtr, strPtr, &intValue, &floatValue, &boolValue);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the value of the specified field from its string representation, as a client write.
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_NOT_FOUND if field not found
+ *      - LE_FORMAT_ERROR if the string is not a valid value for the field type
+ *      - LE_OVERFLOW if the stored string was truncated or
+ *                    if the current entry was NOT added as the time series buffer is full.
+ *      - LE_NO_MEMORY if the current entry was added but there is no space for next one.
+ *                    (This error is applicable only if time series is enabled on this field)
+ *      - LE_FAULT on any other error
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t assetData_client_SetValue
+(
+    assetData_InstanceDataRef_t instanceRef,    ///< [IN] Asset instance to use
+    int fieldId,                                ///< [IN] Field to write
+    const char* strPtr                          ///< [IN] The value to write
+)
+{
+    le_result_t result;
+    FieldData_t* fieldDataPtr;
+    int intValue;
+    double floatValue;
+    bool boolValue;
+
+    result = GetFieldFromInstance(instanceRef, fieldId, &fieldDataPtr);
+    if ( result != LE_OK )
+    {
+        return result;
+    }
+
+    result = ParseFieldValue(fieldDataPtr, strPtr, &intValue, &floatValue, &boolValue);
+    if ( result != LE_OK )
+    {
+        return result;
+    }
+
+    switch ( fieldDataPtr->type )
+    {
+        case DATA_TYPE_INT:
+            return SetInt(instanceRef, fieldId, intValue, true, 0);
+
+        case DATA_TYPE_FLOAT:
+            return SetFloat(instanceRef, fieldId, floatValue, true, 0);
+
+        case DATA_TYPE_BOOL:
+            return SetBool(instanceRef, fieldId, boolValue, true, 0);
+
+        case DATA_TYPE_STRING:
+            return SetString(instanceRef, fieldId, strPtr, true, 0);
+
+        case DATA_TYPE_NONE:
+            break;
+    }
+
+    return LE_FAULT;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start a batch of client writes on the specified instance. Until the batch is committed, the
+ * observe notifications of the changed fields are deferred.
+ */
+//--------------------------------------------------------------------------------------------------
+void assetData_client_StartBatch
+(
+    assetData_InstanceDataRef_t instanceRef     ///< [IN] Asset instance to use
+)
+{
+    instanceRef->isBatchStarted = true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Commit a batch of client writes on the specified instance. The observed fields changed during
+ * the batch are reported to the server in a single notification. If they do not fit in a single
+ * notification, each field is notified separately.
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_FAULT on error
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t assetData_client_CommitBatch
+(
+    assetData_InstanceDataRef_t instanceRef     ///< [IN] Asset instance to use
+)
+{
+    le_result_t result = LE_OK;
+    le_dls_Link_t* linkPtr;
+    FieldData_t* fieldDataPtr;
+    FieldData_t* firstPendingPtr = NULL;
+    uint8_t valueData[256+1];
+    size_t bytesWritten;
+    bool isNotified = false;
+    pa_avc_LWM2MOperationDataRef_t opRef;
+
+    instanceRef->isBatchStarted = false;
+
+    // Find the first pending field; all the fields of an instance are observed with the same token.
+    linkPtr = le_dls_Peek(&instanceRef->fieldList);
+    while ( (linkPtr != NULL) && (firstPendingPtr == NULL) )
+    {
+        fieldDataPtr = CONTAINER_OF(linkPtr, FieldData_t, link);
+        if ( fieldDataPtr->isNotifyPending )
+        {
+            firstPendingPtr = fieldDataPtr;
+        }
+        linkPtr = le_dls_PeekNext(&instanceRef->fieldList, linkPtr);
+    }
+
+    if ( firstPendingPtr == NULL )
+    {
+        return LE_OK;
+    }
+
+    if ( WritePendingNotifyToTLV(instanceRef,
+                                 valueData,
+                                 sizeof(valueData),
+                                 &bytesWritten) == LE_OK )
+    {
+        opRef = pa_avc_CreateOpData(instanceRef->assetDataPtr->appName,
+                                    instanceRef->assetDataPtr->assetId,
+                                    -1,
+                                    -1,
+                                    PA_AVC_OPTYPE_NOTIFY,
+                                    TLV_ENCODING,
+                                    firstPendingPtr->token,
+                                    firstPendingPtr->tokenLength);
+
+        pa_avc_NotifyChange(opRef, valueData, bytesWritten);
+        isNotified = true;
+    }
+
+    // Clear the pending flags, notifying each field separately if the coalesced notification
+    // could not be sent.
+    linkPtr = le_dls_Peek(&instanceRef->fieldList);
+    while ( linkPtr != NULL )
+    {
+        fieldDataPtr = CONTAINER_OF(linkPtr, FieldData_t, link);
+        linkPtr = le_dls_PeekNext(&instanceRef->fieldList, linkPtr);
+
+        if ( !fieldDataPtr->isNotifyPending )
+        {
+            continue;
+        }
+
+        fieldDataPtr->isNotifyPending = false;
+
+        if ( (!isNotified) && (NotifyFieldChange(instanceRef, fieldDataPtr) != LE_OK) )
+        {
+            result = LE_FAULT;
+        }
+    }
+
+    return result;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Allocate resources and start accumulating time series data on the specified field.
@@ -4544,6 +4893,13 @@ le_result_t assetData_Init
                                        le_hashmap_HashString,
                                        le_hashmap_EqualsString);
 
+    // Create the maps indexing the instances and fields of all the assets.
+    InstanceMap = le_hashmap_Create("InstanceMap", INSTANCE_MAP_CAPACITY, HashIdKey, EqualsIdKey);
+    FieldMap = le_hashmap_Create("FieldMap", FIELD_MAP_CAPACITY, HashIdKey, EqualsIdKey);
+    FieldMapByName = le_hashmap_Create("FieldMapByName",
+                                       FIELD_MAP_CAPACITY,
+                                       HashNameKey,
+                                       EqualsNameKey);
 
     // Use a timer to delay reporting instance creation events to the modem for 15 seconds after
     // the last creation event. This allows us to aggregate multiple registration updates together.
@@ -5066,50 +5422,71 @@ le_result_t assetData_WriteObjectToTLV
 
 //--------------------------------------------------------------------------------------------------
 /**
- *  Write TLV for an object but include only the instance/resource which changed. This type of
- *  response is needed as the server sends notify on entire object, but we need to notify changes
- *  at resource level.
+ *  Write TLV for an object but include only the resources of the instance whose notification is
+ *  pending. This type of response is needed as the server sends notify on entire object, but we
+ *  need to notify changes at resource level.
  *
  *  @return:
  *      - LE_OK on success
- *      - LE_FAULT on error
+ *      - LE_OVERFLOW if the TLV data could not fit in the buffer
+ *      - LE_FAULT on any other error
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t WriteNotifyObjectToTLV
+static le_result_t WritePendingNotifyToTLV
 (
-    assetData_AssetDataRef_t assetRef,          ///< [IN] Asset to use
-    int instanceId,                             ///< [IN] Instance that has a changed resource
-    int fieldId,                                ///< [IN] The resource which changed
-    uint8_t* bufPtr,                            ///< [OUT] Buffer for writing the TLV list
+    assetData_InstanceDataRef_t instanceRef,    ///< [IN] Asset instance to use
+    uint8_t* bufPtr,                            ///< [OUT] Buffer for writing the object instance
     size_t bufNumBytes,                         ///< [IN] Size of buffer
     size_t* numBytesWrittenPtr                  ///< [OUT] # bytes written to buffer.
 )
 {
-    le_result_t result = LE_OK;
-    InstanceData_t* instancePtr;
-
-    LE_DEBUG("instanceId = %d", instanceId);
-    LE_DEBUG("fieldId = %d", fieldId);
+    le_result_t result;
+    le_dls_Link_t* linkPtr;
+    FieldData_t* fieldDataPtr;
+    size_t totalNumBytesWritten = 0;
+    size_t numBytesWritten;
+    uint8_t tmpBuffer[256-6];  // leave enough space for maximum header size of 6 bytes
 
-    result = GetInstanceFromAssetData(assetRef, instanceId, &instancePtr);
+    linkPtr = le_dls_Peek(&instanceRef->fieldList);
 
-    if (result != LE_OK)
+    while ( linkPtr != NULL )
     {
-        LE_ERROR("Error reading instance reference result = %d.", result);
-        return LE_FAULT;
+        fieldDataPtr = CONTAINER_OF(linkPtr, FieldData_t, link);
+
+        if ( fieldDataPtr->isNotifyPending )
+        {
+            result = WriteFieldTLV(instanceRef,
+                                   fieldDataPtr,
+                                   tmpBuffer + totalNumBytesWritten,
+                                   sizeof(tmpBuffer) - totalNumBytesWritten,
+                                   &numBytesWritten);
+            if ( result != LE_OK )
+            {
+                return result;
+            }
+
+            totalNumBytesWritten += numBytesWritten;
+        }
+
+        linkPtr = le_dls_PeekNext(&instanceRef->fieldList, linkPtr);
     }
 
-    result = WriteInstanceToTLV(instancePtr,
-                                fieldId,
-                                bufPtr,
-                                bufNumBytes,
-                                numBytesWrittenPtr);
-    if (result != LE_OK)
+    if ( totalNumBytesWritten + 6 > bufNumBytes )
     {
-        LE_ERROR("Error while setting asset instance result = %d.", result);
-        return LE_FAULT;
+        LE_WARN("Overflow: oiid=%i", instanceRef->instanceId);
+        return LE_OVERFLOW;
     }
 
+    WriteTLVHeader(TLV_TYPE_OBJ_INST,
+                   instanceRef->instanceId,
+                   totalNumBytesWritten,
+                   bufPtr,
+                   bufNumBytes,
+                   &numBytesWritten);
+
+    memcpy(bufPtr + numBytesWritten, tmpBuffer, totalNumBytesWritten);
+    *numBytesWrittenPtr = numBytesWritten + totalNumBytesWritten;
+
     return LE_OK;
 }
 
@@ -1252,6 +1252,76 @@ LE_SHARED le_result_t assetData_client_RecordString
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that a string is a valid value for the specified field, without setting it.
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_NOT_FOUND if field not found
+ *      - LE_FORMAT_ERROR if the string is not a valid value for the field type
+ *      - LE_FAULT on any other error
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED le_result_t assetData_client_CheckValue
+(
+    assetData_InstanceDataRef_t instanceRef,    ///< [IN] Asset instance to use
+    int fieldId,                                ///< [IN] Field to check
+    const char* strPtr                          ///< [IN] The value to check
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the value of the specified field from its string representation, as a client write.
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_NOT_FOUND if field not found
+ *      - LE_FORMAT_ERROR if the string is not a valid value for the field type
+ *      - LE_OVERFLOW if the stored string was truncated or
+ *                    if the current entry was NOT added as the time series buffer is full.
+ *      - LE_NO_MEMORY if the current entry was added but there is no space for next one.
+ *                    (This error is applicable only if time series is enabled on this field)
+ *      - LE_FAULT on any other error
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED le_result_t assetData_client_SetValue
+(
+    assetData_InstanceDataRef_t instanceRef,    ///< [IN] Asset instance to use
+    int fieldId,                                ///< [IN] Field to write
+    const char* strPtr                          ///< [IN] The value to write
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start a batch of client writes on the specified instance. Until the batch is committed, the
+ * observe notifications of the changed fields are deferred.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED void assetData_client_StartBatch
+(
+    assetData_InstanceDataRef_t instanceRef     ///< [IN] Asset instance to use
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Commit a batch of client writes on the specified instance. The observed fields changed during
+ * the batch are reported to the server in a single notification.
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_FAULT on error
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED le_result_t assetData_client_CommitBatch
+(
+    assetData_InstanceDataRef_t instanceRef     ///< [IN] Asset instance to use
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Update current status and send pending registration updates.
@@ -25,6 +25,13 @@
 // Macros
 //--------------------------------------------------------------------------------------------------
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of fields in a batch. The shortest batch entry is "n=\n".
+ */
+//--------------------------------------------------------------------------------------------------
+#define BATCH_MAX_FIELDS ((LE_AVDATA_BATCH_LEN + 1) / 3)
+
 //--------------------------------------------------------------------------------------------------
 // Definitions
 //--------------------------------------------------------------------------------------------------
@@ -838,6 +845,126 @@ void le_avdata_SetBinary
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the values of several variable fields in a single call.
+ *
+ * All the entries are checked before any field is set. The observe notifications of the changed
+ * fields are coalesced into a single notification, sent once all the fields are set.
+ *
+ * @note The client will be terminated if the instRef is not valid, or a field doesn't exist
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_FORMAT_ERROR if a line or a value of the batch is malformed. No field is set.
+ *      - LE_OVERFLOW if a stored string was truncated or
+ *                    if an entry was NOT added as the time series buffer is full.
+ *      - LE_NO_MEMORY if an entry was added but there is no space for next one.
+ *                    (This error is applicable only if time series is enabled on the field)
+ *      - LE_FAULT on any other error
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_avdata_SetBatch
+(
+    le_avdata_AssetInstanceRef_t instRef,
+        ///< [IN]
+
+    const char* batch
+        ///< [IN]
+)
+{
+    char batchBuf[LE_AVDATA_BATCH_LEN + 1];
+    int fieldIds[BATCH_MAX_FIELDS];
+    const char* valuePtrs[BATCH_MAX_FIELDS];
+    int numFields = 0;
+    char* linePtr;
+    char* nextLinePtr;
+    char* valuePtr;
+    le_result_t result;
+    le_result_t batchResult = LE_OK;
+    int i;
+
+    // Map safeRef to desired data
+    instRef = GetInstRefFromSafeRef(instRef, __func__);
+    if ( instRef == NULL )
+    {
+        return LE_FAULT;
+    }
+
+    if ( le_utf8_Copy(batchBuf, batch, sizeof(batchBuf), NULL) != LE_OK )
+    {
+        return LE_FORMAT_ERROR;
+    }
+
+    // First pass: split the lines, and check every entry before setting anything.
+    for ( linePtr = batchBuf; linePtr != NULL; linePtr = nextLinePtr )
+    {
+        nextLinePtr = strchr(linePtr, '\n');
+        if ( nextLinePtr != NULL )
+        {
+            *nextLinePtr++ = '\0';
+        }
+
+        if ( *linePtr == '\0' )
+        {
+            continue;
+        }
+
+        valuePtr = strchr(linePtr, '=');
+        if ( (valuePtr == NULL) || (valuePtr == linePtr) || (numFields >= BATCH_MAX_FIELDS) )
+        {
+            LE_ERROR("Malformed batch entry '%s'", linePtr);
+            return LE_FORMAT_ERROR;
+        }
+        *valuePtr++ = '\0';
+
+        if ( assetData_GetFieldIdFromName(instRef, linePtr, &fieldIds[numFields]) != LE_OK )
+        {
+            LE_KILL_CLIENT("Invalid instance '%p' or unknown field name '%s'", instRef, linePtr);
+            return LE_FAULT;
+        }
+
+        result = assetData_client_CheckValue(instRef, fieldIds[numFields], valuePtr);
+        if ( result != LE_OK )
+        {
+            LE_ERROR("Invalid value '%s' for field '%s'", valuePtr, linePtr);
+            return result;
+        }
+
+        valuePtrs[numFields++] = valuePtr;
+    }
+
+    // Second pass: set the fields, deferring the observe notifications until the commit.
+    assetData_client_StartBatch(instRef);
+
+    for ( i = 0; i < numFields; i++ )
+    {
+        result = assetData_client_SetValue(instRef, fieldIds[i], valuePtrs[i]);
+
+        if (result == LE_NO_MEMORY)
+        {
+            LE_WARN("Time series buffer full for field=%i", fieldIds[i]);
+        }
+        else if (result != LE_OK)
+        {
+            LE_ERROR("Error setting field=%i", fieldIds[i]);
+        }
+
+        if ( batchResult == LE_OK )
+        {
+            batchResult = result;
+        }
+    }
+
+    if ( (assetData_client_CommitBatch(instRef) != LE_OK) && (batchResult == LE_OK) )
+    {
+        batchResult = LE_FAULT;
+    }
+
+    return batchResult;
+}
+
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -0,0 +1,333 @@
+/** @file atMatcher.c
+ *
+ * Implementation of the multi-pattern matcher for AT lines.
+ *
+ * Each trie node stands for a pattern prefix: its children extend the prefix by one character and
+ * are kept sorted by character, its values are those of the patterns ending on it.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "atMatcher.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initial number of trie nodes and values.
+ */
+//--------------------------------------------------------------------------------------------------
+#define NODE_POOL_SIZE      64
+#define VALUE_POOL_SIZE     16
+#define MATCHER_POOL_SIZE   8
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Trie node.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct Node
+{
+    struct Node*  childPtr;     ///< First child, children are sorted by character
+    struct Node*  siblingPtr;   ///< Next sibling
+    le_sls_List_t valueList;    ///< Values of the patterns ending on this node
+    char          character;    ///< Character leading to this node from its parent
+}
+Node_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pattern value.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    void*         valuePtr;     ///< Value given to atMatcher_Add()
+    le_sls_Link_t link;         ///< Link in the node value list
+}
+Value_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Matcher.
+ */
+//--------------------------------------------------------------------------------------------------
+struct atMatcher
+{
+    Node_t root;                ///< Trie root, standing for the empty pattern
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pools of matchers, trie nodes and pattern values.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t MatcherPool;
+static le_mem_PoolRef_t NodePool;
+static le_mem_PoolRef_t ValuePool;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release the values of a node.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReleaseValues
+(
+    Node_t* nodePtr     ///< [IN] Node
+)
+{
+    le_sls_Link_t* linkPtr;
+
+    while (NULL != (linkPtr = le_sls_Pop(&nodePtr->valueList)))
+    {
+        le_mem_Release(CONTAINER_OF(linkPtr, Value_t, link));
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release the descendants of a node.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReleaseChildren
+(
+    Node_t* nodePtr     ///< [IN] Node
+)
+{
+    Node_t* childPtr = nodePtr->childPtr;
+
+    while (NULL != childPtr)
+    {
+        Node_t* nextPtr = childPtr->siblingPtr;
+
+        ReleaseChildren(childPtr);
+        ReleaseValues(childPtr);
+        le_mem_Release(childPtr);
+
+        childPtr = nextPtr;
+    }
+
+    nodePtr->childPtr = NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find the child of a node leading by a character.
+ *
+ * @return The child, or NULL if there is none.
+ */
+//--------------------------------------------------------------------------------------------------
+static Node_t* FindChild
+(
+    const Node_t* nodePtr,  ///< [IN] Node
+    char          character ///< [IN] Character
+)
+{
+    Node_t* childPtr = nodePtr->childPtr;
+
+    while ((NULL != childPtr) && (childPtr->character < character))
+    {
+        childPtr = childPtr->siblingPtr;
+    }
+
+    if ((NULL != childPtr) && (childPtr->character == character))
+    {
+        return childPtr;
+    }
+
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the child of a node leading by a character, creating it if needed.
+ *
+ * @return The child.
+ */
+//--------------------------------------------------------------------------------------------------
+static Node_t* GetChild
+(
+    Node_t* nodePtr,    ///< [IN] Node
+    char    character   ///< [IN] Character
+)
+{
+    Node_t** childPtrPtr = &nodePtr->childPtr;
+
+    while ((NULL != *childPtrPtr) && ((*childPtrPtr)->character < character))
+    {
+        childPtrPtr = &(*childPtrPtr)->siblingPtr;
+    }
+
+    if ((NULL != *childPtrPtr) && ((*childPtrPtr)->character == character))
+    {
+        return *childPtrPtr;
+    }
+
+    Node_t* newNodePtr = le_mem_ForceAlloc(NodePool);
+    newNodePtr->childPtr = NULL;
+    newNodePtr->siblingPtr = *childPtrPtr;
+    newNodePtr->valueList = LE_SLS_LIST_INIT;
+    newNodePtr->character = character;
+    *childPtrPtr = newNodePtr;
+
+    return newNodePtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Call the matching function for the values of a node.
+ *
+ * @return The number of values.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t ReportValues
+(
+    const Node_t*         nodePtr,      ///< [IN] Node
+    atMatcher_MatchFunc_t matchFunc,    ///< [IN] Matching function, may be NULL
+    void*                 contextPtr    ///< [IN] Context given to the matching function
+)
+{
+    uint32_t count = 0;
+    le_sls_Link_t* linkPtr = le_sls_Peek(&nodePtr->valueList);
+
+    while (NULL != linkPtr)
+    {
+        if (NULL != matchFunc)
+        {
+            matchFunc(CONTAINER_OF(linkPtr, Value_t, link)->valuePtr, contextPtr);
+        }
+        count++;
+
+        linkPtr = le_sls_PeekNext(&nodePtr->valueList, linkPtr);
+    }
+
+    return count;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the matcher module. Must be called once before any other function.
+ */
+//--------------------------------------------------------------------------------------------------
+void atMatcher_Init
+(
+    void
+)
+{
+    MatcherPool = le_mem_CreatePool("AtMatcherPool", sizeof(struct atMatcher));
+    le_mem_ExpandPool(MatcherPool, MATCHER_POOL_SIZE);
+
+    NodePool = le_mem_CreatePool("AtMatcherNodePool", sizeof(Node_t));
+    le_mem_ExpandPool(NodePool, NODE_POOL_SIZE);
+
+    ValuePool = le_mem_CreatePool("AtMatcherValuePool", sizeof(Value_t));
+    le_mem_ExpandPool(ValuePool, VALUE_POOL_SIZE);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create an empty matcher.
+ *
+ * @return The matcher reference.
+ */
+//--------------------------------------------------------------------------------------------------
+atMatcher_Ref_t atMatcher_Create
+(
+    void
+)
+{
+    atMatcher_Ref_t matcherRef = le_mem_ForceAlloc(MatcherPool);
+
+    memset(matcherRef, 0, sizeof(struct atMatcher));
+    matcherRef->root.valueList = LE_SLS_LIST_INIT;
+
+    return matcherRef;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete a matcher.
+ */
+//--------------------------------------------------------------------------------------------------
+void atMatcher_Delete
+(
+    atMatcher_Ref_t matcherRef  ///< [IN] Matcher reference
+)
+{
+    atMatcher_Clear(matcherRef);
+    le_mem_Release(matcherRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove all the patterns of a matcher, before rebuilding it.
+ */
+//--------------------------------------------------------------------------------------------------
+void atMatcher_Clear
+(
+    atMatcher_Ref_t matcherRef  ///< [IN] Matcher reference
+)
+{
+    ReleaseChildren(&matcherRef->root);
+    ReleaseValues(&matcherRef->root);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a pattern to a matcher. An empty pattern matches every line. Several values can be added
+ * with the same pattern.
+ */
+//--------------------------------------------------------------------------------------------------
+void atMatcher_Add
+(
+    atMatcher_Ref_t matcherRef, ///< [IN] Matcher reference
+    const char*     patternPtr, ///< [IN] Pattern, matching the lines it starts
+    void*           valuePtr    ///< [IN] Value given back when the pattern matches
+)
+{
+    Node_t* nodePtr = &matcherRef->root;
+
+    for (; '\0' != *patternPtr; patternPtr++)
+    {
+        nodePtr = GetChild(nodePtr, *patternPtr);
+    }
+
+    Value_t* newValuePtr = le_mem_ForceAlloc(ValuePool);
+    newValuePtr->valuePtr = valuePtr;
+    newValuePtr->link = LE_SLS_LINK_INIT;
+    le_sls_Queue(&nodePtr->valueList, &newValuePtr->link);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find the patterns starting a line. The matching function is called for each of them, the shorter
+ * patterns first and, for a given pattern, in the order the values were added.
+ *
+ * @return The number of matching values.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t atMatcher_Match
+(
+    atMatcher_Ref_t       matcherRef,   ///< [IN] Matcher reference
+    const char*           linePtr,      ///< [IN] Line, not necessarily NUL terminated
+    size_t                lineSize,     ///< [IN] Line size
+    atMatcher_MatchFunc_t matchFunc,    ///< [IN] Function called for each match, may be NULL
+    void*                 contextPtr    ///< [IN] Context given to the matching function
+)
+{
+    const Node_t* nodePtr = &matcherRef->root;
+    uint32_t count = ReportValues(nodePtr, matchFunc, contextPtr);
+    size_t i;
+
+    for (i = 0; i < lineSize; i++)
+    {
+        nodePtr = FindChild(nodePtr, linePtr[i]);
+        if (NULL == nodePtr)
+        {
+            break;
+        }
+
+        count += ReportValues(nodePtr, matchFunc, contextPtr);
+    }
+
+    return count;
+}
@@ -0,0 +1,105 @@
+/** @file atMatcher.h
+ *
+ * Multi-pattern matcher for AT lines.
+ *
+ * The patterns (unsolicited responses, final and intermediate responses) are stored in a prefix
+ * trie, so finding all the patterns starting a received line costs one walk of the line whatever
+ * the number of patterns, instead of one string comparison per pattern.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#ifndef LEGATO_AT_MATCHER_INCLUDE_GUARD
+#define LEGATO_AT_MATCHER_INCLUDE_GUARD
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reference to a matcher.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct atMatcher* atMatcher_Ref_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function called for each pattern matching a line.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef void (*atMatcher_MatchFunc_t)
+(
+    void* valuePtr,     ///< Value associated to the matching pattern
+    void* contextPtr    ///< Context given to atMatcher_Match()
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the matcher module. Must be called once before any other function.
+ */
+//--------------------------------------------------------------------------------------------------
+void atMatcher_Init
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create an empty matcher.
+ *
+ * @return The matcher reference.
+ */
+//--------------------------------------------------------------------------------------------------
+atMatcher_Ref_t atMatcher_Create
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete a matcher.
+ */
+//--------------------------------------------------------------------------------------------------
+void atMatcher_Delete
+(
+    atMatcher_Ref_t matcherRef  ///< [IN] Matcher reference
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove all the patterns of a matcher, before rebuilding it.
+ */
+//--------------------------------------------------------------------------------------------------
+void atMatcher_Clear
+(
+    atMatcher_Ref_t matcherRef  ///< [IN] Matcher reference
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a pattern to a matcher. An empty pattern matches every line. Several values can be added
+ * with the same pattern.
+ */
+//--------------------------------------------------------------------------------------------------
+void atMatcher_Add
+(
+    atMatcher_Ref_t matcherRef, ///< [IN] Matcher reference
+    const char*     patternPtr, ///< [IN] Pattern, matching the lines it starts
+    void*           valuePtr    ///< [IN] Value given back when the pattern matches
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find the patterns starting a line. The matching function is called for each of them, the shorter
+ * patterns first and, for a given pattern, in the order the values were added.
+ *
+ * @return The number of matching values.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t atMatcher_Match
+(
+    atMatcher_Ref_t       matcherRef,   ///< [IN] Matcher reference
+    const char*           linePtr,      ///< [IN] Line, not necessarily NUL terminated
+    size_t                lineSize,     ///< [IN] Line size
+    atMatcher_MatchFunc_t matchFunc,    ///< [IN] Function called for each match, may be NULL
+    void*                 contextPtr    ///< [IN] Context given to the matching function
+);
+
+#endif // LEGATO_AT_MATCHER_INCLUDE_GUARD
@@ -257,7 +257,7 @@ static le_result_t SetSocketNonBlocking
 /**
  * This function must be called when we want to read on device (or port)
  *
- * @return byte number read
+ * @return byte number read, 0 when there is nothing to read, -1 on error
  */
 //--------------------------------------------------------------------------------------------------
 ssize_t le_dev_Read
@@ -296,6 +296,12 @@ ssize_t le_dev_Read
     count = read(devicePtr->fd, rxDataPtr, size);
     if (-1 == count)
     {
+        // The device is non blocking: nothing left to read is not an error
+        if ((EAGAIN == errno) || (EWOULDBLOCK == errno))
+        {
+            return 0;
+        }
+
         LE_ERROR("read error: %s", StrError(errno));
         return -1;
     }
@@ -365,6 +371,72 @@ int32_t le_dev_Write
     return currentSize;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to write several buffers on device (or port) in one system call,
+ * e.g. a response and its surrounding <CR><LF>, without copying them into a single buffer first.
+ *
+ * @return written byte number
+ */
+//--------------------------------------------------------------------------------------------------
+int32_t le_dev_WriteVec
+(
+    Device_t*           devicePtr,  ///< device pointer
+    const struct iovec* iovPtr,     ///< Buffers to write
+    int                 iovCount    ///< Number of buffers, at most DEV_IOV_MAX
+)
+{
+    struct iovec iov[DEV_IOV_MAX];
+    int32_t amount = 0;
+    int first = 0;
+    int i;
+
+    LE_FATAL_IF(devicePtr->fd==-1,"Write Handle error\n");
+    LE_ASSERT((iovCount > 0) && (iovCount <= DEV_IOV_MAX));
+
+    // Work on a copy: a partial write moves the start of the first buffer not fully written
+    memcpy(iov, iovPtr, iovCount * sizeof(struct iovec));
+
+    while (first < iovCount)
+    {
+        ssize_t sizeWritten = writev(devicePtr->fd, &iov[first], iovCount - first);
+
+        if (sizeWritten < 0)
+        {
+            if ((errno != EINTR) && (errno != EAGAIN))
+            {
+                LE_ERROR("Cannot write on fd: %s", StrError(errno));
+                return amount;
+            }
+            continue;
+        }
+
+        amount += sizeWritten;
+
+        while ((first < iovCount) && ((size_t)sizeWritten >= iov[first].iov_len))
+        {
+            sizeWritten -= iov[first].iov_len;
+            first++;
+        }
+
+        if (first < iovCount)
+        {
+            iov[first].iov_base = (uint8_t*)iov[first].iov_base + sizeWritten;
+            iov[first].iov_len -= sizeWritten;
+        }
+    }
+
+    if (le_log_GetFilterLevel() == LE_LOG_DEBUG)
+    {
+        for (i = 0; i < iovCount; i++)
+        {
+            PrintBuffer(devicePtr->fd, iovPtr[i].iov_base, iovPtr[i].iov_len);
+        }
+    }
+
+    return amount;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function must be called to monitor the specified file descriptor
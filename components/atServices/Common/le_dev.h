@@ -8,6 +8,15 @@
 #ifndef LEGATO_LE_DEV_INCLUDE_GUARD
 #define LEGATO_LE_DEV_INCLUDE_GUARD
 
+#include <sys/uio.h>
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of buffers written by le_dev_WriteVec()
+ */
+//--------------------------------------------------------------------------------------------------
+#define DEV_IOV_MAX     8
+
 //--------------------------------------------------------------------------------------------------
 /**
  * device structure
@@ -25,7 +34,7 @@ Device_t;
 /**
  * This function must be called when we want to read on device (or port)
  *
- * @return byte number read
+ * @return byte number read, 0 when there is nothing to read, -1 on error
  */
 //--------------------------------------------------------------------------------------------------
 ssize_t le_dev_Read
@@ -49,6 +58,21 @@ int32_t le_dev_Write
     uint32_t    size          ///< size of buffer
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to write several buffers on device (or port) in one system call,
+ * e.g. a response and its surrounding <CR><LF>, without copying them into a single buffer first.
+ *
+ * @return written byte number
+ */
+//--------------------------------------------------------------------------------------------------
+int32_t le_dev_WriteVec
+(
+    Device_t*           devicePtr,  ///< device pointer
+    const struct iovec* iovPtr,     ///< Buffers to write
+    int                 iovCount    ///< Number of buffers, at most DEV_IOV_MAX
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function must be called to monitor the specified file descriptor in the calling thread event
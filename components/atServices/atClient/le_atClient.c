@@ -62,6 +62,7 @@
 #include "legato.h"
 #include "interfaces.h"
 #include "le_dev.h"
+#include "atMatcher.h"
 #include "watchdogChain.h"
 
 //--------------------------------------------------------------------------------------------------
@@ -258,6 +259,7 @@ typedef struct
     uint32_t      lineCount;                                    ///< Unsolicited lines number
     uint32_t      lineCounter;                                  ///< Received line counter
     bool          inProgress;                                   ///< Reception in progress
+    bool          matched;                                      ///< Pattern matched current line
     le_atClient_UnsolicitedResponseHandlerRef_t ref;            ///< Unsolicited reference
     DeviceContextPtr_t interfacePtr;                            ///< device context
     le_dls_Link_t link;                                         ///< link in Unsolicited List
@@ -282,6 +284,9 @@ typedef struct DeviceContext
     le_timer_Ref_t  timerRef;           ///< command timer
     le_dls_List_t   atCommandList;      ///< List of command waiting for execution
     le_dls_List_t   unsolicitedList;    ///< unsolicited command list
+    atMatcher_Ref_t unsolMatcherRef;    ///< matcher of the unsolicited patterns
+    bool            unsolMatcherOutdated; ///< unsolicited list changed since matcher was built
+    uint32_t        unsolInProgressCount; ///< number of multi-line unsolicited in progress
     le_sem_Ref_t    waitingSemaphore;   ///< semaphore used for synchronization
     le_atClient_DeviceRef_t ref;        ///< reference of the device context
     le_msg_SessionRef_t sessionRef;     ///< client session reference
@@ -300,6 +305,10 @@ typedef struct AtCmd
                                                                 ///< intermediate response
     le_dls_List_t          expectResponseList;                  ///< List of str  pattern for final
                                                                 ///< response
+    atMatcher_Ref_t        intermediateMatcherRef;              ///< Matcher of intermediate
+                                                                ///< response patterns
+    atMatcher_Ref_t        finalMatcherRef;                     ///< Matcher of final response
+                                                                ///< patterns
     char                   text[LE_ATDEFS_TEXT_MAX_BYTES+1];    ///< text to be sent after >
                                                                 ///< +1 for ctrl-z
     size_t                 textSize;                            ///< size of text to send
@@ -380,6 +389,50 @@ static void UpdateTransitionManager(ClientStatePtr_t  parserStatePtr,
 static void SendLine(RxParserPtr_t charParserPtr);
 static void SendData(RxParserPtr_t charParserPtr);
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function rebuilds the matcher of the unsolicited patterns from the unsolicited list.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void BuildUnsolicitedMatcher
+(
+    DeviceContext_t* interfacePtr
+)
+{
+    le_dls_Link_t* linkPtr = le_dls_Peek(&interfacePtr->unsolicitedList);
+
+    atMatcher_Clear(interfacePtr->unsolMatcherRef);
+
+    while (linkPtr != NULL)
+    {
+        Unsolicited_t *unsolPtr = CONTAINER_OF(linkPtr, Unsolicited_t, link);
+
+        atMatcher_Add(interfacePtr->unsolMatcherRef, unsolPtr->unsolRsp, unsolPtr);
+
+        linkPtr = le_dls_PeekNext(&interfacePtr->unsolicitedList, linkPtr);
+    }
+
+    interfacePtr->unsolMatcherOutdated = false;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function flags an unsolicited response whose pattern matches the received line.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void MarkUnsolicited
+(
+    void* valuePtr,
+    void* contextPtr
+)
+{
+    Unsolicited_t *unsolPtr = valuePtr;
+
+    unsolPtr->matched = true;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function is used to check if the received data matches with a subscribed unsolicited
@@ -391,11 +444,27 @@ static void CheckUnsolicited
 (
     char* unsolRspPtr,
     size_t stringSize,
-    le_dls_List_t *unsolListPtr
+    DeviceContext_t* interfacePtr
 )
 {
+    le_dls_List_t *unsolListPtr = &interfacePtr->unsolicitedList;
+
     LE_DEBUG("Start checking unsolicited");
 
+    if (interfacePtr->unsolMatcherOutdated)
+    {
+        BuildUnsolicitedMatcher(interfacePtr);
+    }
+
+    // Most received lines match no subscription: do not browse the list for them.
+    if ((atMatcher_Match(interfacePtr->unsolMatcherRef, unsolRspPtr, stringSize,
+                         MarkUnsolicited, NULL) == 0) &&
+        (interfacePtr->unsolInProgressCount == 0))
+    {
+        LE_DEBUG("No unsolicited matched");
+        return;
+    }
+
     le_dls_Link_t* linkPtr = le_dls_Peek(unsolListPtr);
 
     /* Browse all the queue while the string is not found */
@@ -405,18 +474,23 @@ static void CheckUnsolicited
                                                Unsolicited_t,
                                                 link);
 
-        if ((strncmp(unsolPtr->unsolRsp,unsolRspPtr,strlen(unsolPtr->unsolRsp)) == 0) ||
-            (unsolPtr->inProgress))
+        if ((unsolPtr->matched) || (unsolPtr->inProgress))
         {
             LE_DEBUG("unsol found");
+            size_t bufferLen = strlen(unsolPtr->unsolBuffer);
             uint32_t len =
-                (stringSize < LE_ATDEFS_UNSOLICITED_MAX_LEN-strlen(unsolPtr->unsolBuffer)) ?
+                (stringSize < LE_ATDEFS_UNSOLICITED_MAX_LEN-bufferLen) ?
                 stringSize :
-                LE_ATDEFS_UNSOLICITED_MAX_LEN-strlen(unsolPtr->unsolBuffer);
+                LE_ATDEFS_UNSOLICITED_MAX_LEN-bufferLen;
 
-            strncpy(unsolPtr->unsolBuffer+strlen(unsolPtr->unsolBuffer), unsolRspPtr, len);
+            strncpy(unsolPtr->unsolBuffer+bufferLen, unsolRspPtr, len);
 
-            unsolPtr->inProgress = true;
+            if (!unsolPtr->inProgress)
+            {
+                unsolPtr->inProgress = true;
+                interfacePtr->unsolInProgressCount++;
+            }
+            unsolPtr->matched = false;
         }
 
         if (unsolPtr->inProgress)
@@ -427,6 +501,7 @@ static void CheckUnsolicited
                 memset(unsolPtr->unsolBuffer,0,LE_ATDEFS_UNSOLICITED_MAX_BYTES);
                 unsolPtr->lineCounter = 0;
                 unsolPtr->inProgress = false;
+                interfacePtr->unsolInProgressCount--;
             }
             else
             {
@@ -535,9 +610,22 @@ static void ParseRxBuffer
 )
 {
     RxEvent_t event;
+    RxData_t* rxDataPtr = &rxParserPtr->rxData;
 
-    for (;rxParserPtr->rxData.idx < rxParserPtr->rxData.endBuffer;)
+    for (;rxDataPtr->idx < rxDataPtr->endBuffer;)
     {
+        // Past the starting state, ordinary characters are not parser events: skip them in one
+        // go up to the next line ending or prompt. The buffer is NUL terminated at endBuffer.
+        if (rxParserPtr->curState != StartingState)
+        {
+            rxDataPtr->idx += strcspn((char*)rxDataPtr->buffer + rxDataPtr->idx, "\r\n>");
+            if (rxDataPtr->idx >= rxDataPtr->endBuffer)
+            {
+                rxDataPtr->idx = rxDataPtr->endBuffer;
+                break;
+            }
+        }
+
         if (GetNextEvent(rxParserPtr, &event))
         {
             (rxParserPtr->curState)(rxParserPtr,event);
@@ -558,16 +646,20 @@ static void ResetRxBuffer
 {
     if (rxParserPtr->curState == ProcessingState)
     {
-        size_t idx,sizeToCopy;
+        size_t sizeToCopy;
         sizeToCopy = rxParserPtr->rxData.endBuffer-rxParserPtr->rxData.idxLastCrLf+2;
 
         LE_DEBUG("%d sizeToCopy %zd from %d",
                             rxParserPtr->rxData.idx,sizeToCopy,rxParserPtr->rxData.idxLastCrLf-2);
 
-        for (idx = 0; idx < sizeToCopy; idx++) {
-            rxParserPtr->rxData.buffer[idx] =
-                                rxParserPtr->rxData.buffer[idx+rxParserPtr->rxData.idxLastCrLf-2];
+        // Only the pending partial line is kept: lines already sent were sliced by pointer
+        if (rxParserPtr->rxData.idxLastCrLf > 2)
+        {
+            memmove(rxParserPtr->rxData.buffer,
+                    rxParserPtr->rxData.buffer + rxParserPtr->rxData.idxLastCrLf - 2,
+                    sizeToCopy);
         }
+        rxParserPtr->rxData.buffer[sizeToCopy] = '\0';
 
         rxParserPtr->rxData.idxLastCrLf = 2;
         rxParserPtr->rxData.endBuffer = sizeToCopy;
@@ -622,28 +714,40 @@ static void RxNewData
     }
 
     ssize_t size = 0;
+    size_t space;
     DeviceContext_t *interfacePtr = le_fdMonitor_GetContextPtr();
 
     LE_DEBUG("Start read");
 
-    /* Read RX data on uart */
-    // PARSER_BUFFER_MAX_BYTES length is including '\0' character.
-    size = le_dev_Read(&interfacePtr->device,
-                         (uint8_t *)(&interfacePtr->rxParser.rxData.buffer) +
-                         interfacePtr->rxParser.rxData.idx,
-                         (PARSER_BUFFER_MAX_BYTES - interfacePtr->rxParser.rxData.idx - 1));
-
-    /* Start the parsing only if we have read some bytes */
-    if (size > 0)
+    /* Read RX data on uart, draining the device while the reads fill the buffer so that a burst
+     * is handled in one wakeup */
+    do
     {
-        interfacePtr->rxParser.rxData.buffer[interfacePtr->rxParser.rxData.idx + size] = '\0';
-        interfacePtr->rxParser.rxData.endBuffer += size;
+        // PARSER_BUFFER_MAX_BYTES length is including '\0' character.
+        space = PARSER_BUFFER_MAX_BYTES - interfacePtr->rxParser.rxData.idx - 1;
+        if (0 == space)
+        {
+            break;
+        }
+
+        size = le_dev_Read(&interfacePtr->device,
+                           (uint8_t *)(&interfacePtr->rxParser.rxData.buffer) +
+                           interfacePtr->rxParser.rxData.idx,
+                           space);
 
-        /* Call the parser */
-        LE_DEBUG("Parsing received data: %s", interfacePtr->rxParser.rxData.buffer);
-        ParseRxBuffer(&interfacePtr->rxParser);
-        ResetRxBuffer(&interfacePtr->rxParser);
+        /* Start the parsing only if we have read some bytes */
+        if (size > 0)
+        {
+            interfacePtr->rxParser.rxData.buffer[interfacePtr->rxParser.rxData.idx + size] = '\0';
+            interfacePtr->rxParser.rxData.endBuffer += size;
+
+            /* Call the parser */
+            LE_DEBUG("Parsing received data: %s", interfacePtr->rxParser.rxData.buffer);
+            ParseRxBuffer(&interfacePtr->rxParser);
+            ResetRxBuffer(&interfacePtr->rxParser);
+        }
     }
+    while ((size_t)size == space);
 
     if (interfacePtr->rxParser.rxData.endBuffer > PARSER_BUFFER_MAX_BYTES)
     {
@@ -846,7 +950,7 @@ static bool CheckResponse
 (
     char*          receivedRspPtr,   ///< [IN] Received line pointer
     size_t         lineSize,         ///< [IN] Received line size
-    le_dls_List_t* responseListPtr,  ///< [IN] List of response strings of the command
+    atMatcher_Ref_t responseMatcherRef, ///< [IN] Matcher of response strings of the command
     le_dls_List_t* resultListPtr,    ///< [OUT] List of matched strings after comparison
     char*          cmdNamePtr        ///< [IN] Command name pointer
 )
@@ -858,8 +962,6 @@ static bool CheckResponse
         return false;
     }
 
-    le_dls_Link_t* linkPtr = le_dls_Peek(responseListPtr);
-
     LE_DEBUG("Command: %s, size: %zu", cmdNamePtr, strlen(cmdNamePtr));
     LE_DEBUG("Received response: %s, size: %zu", receivedRspPtr, lineSize);
 
@@ -869,37 +971,24 @@ static bool CheckResponse
         return false;
     }
 
-    /* Browse all the queue while the string is not found */
-    while (linkPtr != NULL)
+    if (atMatcher_Match(responseMatcherRef, receivedRspPtr, lineSize, NULL, NULL) > 0)
     {
-        RspString_t* currStringPtr = CONTAINER_OF(linkPtr,
-                                                  RspString_t,
-                                                  link);
-        LE_DEBUG("Item: %s, size: %zu", currStringPtr->line, strlen(currStringPtr->line));
-
-        if ((strlen(currStringPtr->line) == 0) ||
-           ((lineSize >= strlen(currStringPtr->line)) &&
-           (strncmp(currStringPtr->line, receivedRspPtr, strlen(currStringPtr->line)) == 0)))
-        {
-            LE_DEBUG("Rsp matched, size: %zu", lineSize);
-
-            RspString_t* newStringPtr = le_mem_ForceAlloc(RspStringPool);
-            memset(newStringPtr, 0, sizeof(RspString_t));
+        LE_DEBUG("Rsp matched, size: %zu", lineSize);
 
-            if(lineSize>LE_ATDEFS_RESPONSE_MAX_BYTES)
-            {
-                LE_ERROR("String too long");
-                le_mem_Release(newStringPtr);
-                return false;
-            }
+        RspString_t* newStringPtr = le_mem_ForceAlloc(RspStringPool);
+        memset(newStringPtr, 0, sizeof(RspString_t));
 
-            strncpy(newStringPtr->line, receivedRspPtr, lineSize);
-            newStringPtr->link = LE_DLS_LINK_INIT;
-            le_dls_Queue(resultListPtr, &(newStringPtr->link));
-            return true;
+        if(lineSize>LE_ATDEFS_RESPONSE_MAX_BYTES)
+        {
+            LE_ERROR("String too long");
+            le_mem_Release(newStringPtr);
+            return false;
         }
 
-        linkPtr = le_dls_PeekNext(responseListPtr, linkPtr);
+        strncpy(newStringPtr->line, receivedRspPtr, lineSize);
+        newStringPtr->link = LE_DLS_LINK_INIT;
+        le_dls_Queue(resultListPtr, &(newStringPtr->link));
+        return true;
     }
 
     LE_DEBUG("Stop checking response");
@@ -937,16 +1026,14 @@ static void SendingState
     {
         case EVENT_SENDTEXT:
         {
-            // Send data
-            le_dev_Write(&(interfacePtr->device),
-                           (uint8_t*) cmdPtr->text,
-                           cmdPtr->textSize);
-
-            // Send Ctrl-z
+            // Send data followed by Ctrl-z
             uint8_t ctrlZ = 0x1A;
-            le_dev_Write(&(interfacePtr->device),
-                         &ctrlZ,
-                         1);
+            struct iovec iov[] =
+            {
+                { .iov_base = cmdPtr->text, .iov_len = cmdPtr->textSize },
+                { .iov_base = &ctrlZ,       .iov_len = 1 },
+            };
+            le_dev_WriteVec(&(interfacePtr->device), iov, NUM_ARRAY_MEMBERS(iov));
 
             break;
         }
@@ -961,7 +1048,7 @@ static void SendingState
             size_t lineSize = newCRLF - parserPtr->idxLastCrLf;
 
             if (CheckResponse((char*)&(parserPtr->buffer[parserPtr->idxLastCrLf]), lineSize,
-                              &(cmdPtr->expectResponseList), &(cmdPtr->responseList),
+                              cmdPtr->finalMatcherRef, &(cmdPtr->responseList),
                               cmdPtr->cmd))
             {
                 LE_DEBUG("Final command found");
@@ -979,7 +1066,7 @@ static void SendingState
             }
 
             CheckResponse((char*)&(parserPtr->buffer[parserPtr->idxLastCrLf]), lineSize,
-                          &(cmdPtr->ExpectintermediateResponseList), &(cmdPtr->responseList),
+                          cmdPtr->intermediateMatcherRef, &(cmdPtr->responseList),
                           cmdPtr->cmd);
             break;
         }
@@ -1028,14 +1115,12 @@ static void WaitingState
                 StartTimer(cmdPtr);
             }
 
-            uint32_t len = strlen(cmdPtr->cmd)+2;
-            char atCommand[len];
-            memset(atCommand, 0, len);
-            snprintf(atCommand, len, "%s\r", cmdPtr->cmd);
-
-            le_dev_Write(&(interfacePtr->device),
-                           (uint8_t*) atCommand,
-                           len-1);
+            struct iovec iov[] =
+            {
+                { .iov_base = cmdPtr->cmd, .iov_len = strlen(cmdPtr->cmd) },
+                { .iov_base = "\r",        .iov_len = 1 },
+            };
+            le_dev_WriteVec(&(interfacePtr->device), iov, NUM_ARRAY_MEMBERS(iov));
 
             UpdateTransitionManager(clientStatePtr,input,SendingState);
 
@@ -1050,7 +1135,7 @@ static void WaitingState
 
             CheckUnsolicited((char*)&(parserPtr->buffer[parserPtr->idxLastCrLf]),
                               lineSize,
-                              &interfacePtr->unsolicitedList);
+                              interfacePtr);
             break;
         }
         default:
@@ -1238,6 +1323,8 @@ static void AtCmdPoolDestructor
     ReleaseRspStringList(&(oldPtr->responseList));
     ReleaseRspStringList(&(oldPtr->expectResponseList));
     ReleaseRspStringList(&(oldPtr->ExpectintermediateResponseList));
+    atMatcher_Delete(oldPtr->finalMatcherRef);
+    atMatcher_Delete(oldPtr->intermediateMatcherRef);
 
     le_ref_DeleteRef(CmdRefMap, oldPtr->ref);
 }
@@ -1263,6 +1350,8 @@ static void DevicesPoolDestructor
 
     le_thread_Join(interfacePtr->threadRef,NULL);
 
+    atMatcher_Delete(interfacePtr->unsolMatcherRef);
+
     le_ref_DeleteRef(DevicesRefMap, interfacePtr->ref);
 
 }
@@ -1290,6 +1379,12 @@ static void UnsolicitedPoolDestructor
     if ( le_dls_IsInList(listPtr, linkPtr) )
     {
         le_dls_Remove(listPtr, linkPtr);
+        unsolicitedPtr->interfacePtr->unsolMatcherOutdated = true;
+    }
+
+    if (unsolicitedPtr->inProgress)
+    {
+        unsolicitedPtr->interfacePtr->unsolInProgressCount--;
     }
 
     // Delete the reference for unsolicited structure pointer.
@@ -1367,6 +1462,8 @@ le_atClient_CmdRef_t le_atClient_Create
 
     cmdPtr->ExpectintermediateResponseList  = LE_DLS_LIST_INIT;
     cmdPtr->expectResponseList              = LE_DLS_LIST_INIT;
+    cmdPtr->intermediateMatcherRef          = atMatcher_Create();
+    cmdPtr->finalMatcherRef                 = atMatcher_Create();
     cmdPtr->textSize                        = 0;
     cmdPtr->timeout                         = LE_ATDEFS_COMMAND_DEFAULT_TIMEOUT;
     cmdPtr->interfacePtr                    = NULL;
@@ -1537,6 +1634,7 @@ le_result_t le_atClient_SetIntermediateResponse
             newStringPtr->link = LE_DLS_LINK_INIT;
 
             le_dls_Queue(&(cmdPtr->ExpectintermediateResponseList), &(newStringPtr->link));
+            atMatcher_Add(cmdPtr->intermediateMatcherRef, newStringPtr->line, newStringPtr);
 
             interPtr = strtok_r(NULL, "|", &savePtr);
         }
@@ -1547,7 +1645,7 @@ le_result_t le_atClient_SetIntermediateResponse
         memset(newStringPtr, 0, sizeof(RspString_t));
         newStringPtr->link = LE_DLS_LINK_INIT;
         le_dls_Queue(&(cmdPtr->ExpectintermediateResponseList), &(newStringPtr->link));
-
+        atMatcher_Add(cmdPtr->intermediateMatcherRef, newStringPtr->line, newStringPtr);
     }
 
     return LE_OK;
@@ -1609,6 +1707,7 @@ le_result_t le_atClient_SetFinalResponse
             newStringPtr->link = LE_DLS_LINK_INIT;
 
             le_dls_Queue(&(cmdPtr->expectResponseList),&(newStringPtr->link));
+            atMatcher_Add(cmdPtr->finalMatcherRef, newStringPtr->line, newStringPtr);
 
             respPtr = strtok_r(NULL, "|", &savePtr);
         }
@@ -2055,6 +2154,7 @@ le_atClient_UnsolicitedResponseHandlerRef_t le_atClient_AddUnsolicitedResponseHa
     unsolicitedPtr->sessionRef = le_atClient_GetClientSessionRef();
 
     le_dls_Queue(&interfacePtr->unsolicitedList, &unsolicitedPtr->link);
+    interfacePtr->unsolMatcherOutdated = true;
 
     return unsolicitedPtr->ref;
 }
@@ -2169,6 +2269,7 @@ le_atClient_DeviceRef_t le_atClient_Start
 
     LE_DEBUG("Create a new interface for '%d'", fd);
     newInterfacePtr->device.fd = fd;
+    newInterfacePtr->unsolMatcherRef = atMatcher_Create();
 
     snprintf(name,THREAD_NAME_MAX_LENGTH,"atCommandClient-%d",threatCounter);
     newInterfacePtr->threadRef = le_thread_Create(name,DeviceThread,newInterfacePtr);
@@ -2229,6 +2330,9 @@ le_result_t le_atClient_Stop
 //--------------------------------------------------------------------------------------------------
 COMPONENT_INIT
 {
+    // Pattern matchers
+    atMatcher_Init();
+
     // Device pool allocation
     DevicesPool = le_mem_CreatePool("AtClientDevicesPool",sizeof(DeviceContext_t));
     le_mem_ExpandPool(DevicesPool,DEVICE_POOL_SIZE);
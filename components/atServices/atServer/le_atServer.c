@@ -878,20 +878,24 @@ static void SendRspString
     const char* rspPtr
 )
 {
-    char string[LE_ATDEFS_RESPONSE_MAX_BYTES+4] = {0};
+    // The response is written between its <CR><LF> in one system call, without being copied
+    struct iovec iov[] =
+    {
+        { .iov_base = "\r\n",        .iov_len = 2 },
+        { .iov_base = (char*)rspPtr, .iov_len = strnlen(rspPtr, LE_ATDEFS_RESPONSE_MAX_LEN) },
+        { .iov_base = "\r\n",        .iov_len = 2 },
+    };
 
     if ((devPtr->rspState == AT_RSP_FINAL) || (devPtr->rspState == AT_RSP_UNSOLICITED) ||
         ((devPtr->rspState == AT_RSP_INTERMEDIATE) && devPtr->isFirstIntermediate))
     {
-        snprintf(string, LE_ATDEFS_RESPONSE_MAX_BYTES+4, "\r\n%s\r\n", rspPtr);
         devPtr->isFirstIntermediate = false;
+        le_dev_WriteVec(&devPtr->device, iov, NUM_ARRAY_MEMBERS(iov));
     }
     else
     {
-        snprintf(string, LE_ATDEFS_RESPONSE_MAX_BYTES+2, "%s\r\n", rspPtr);
+        le_dev_WriteVec(&devPtr->device, &iov[1], NUM_ARRAY_MEMBERS(iov) - 1);
     }
-
-    le_dev_Write(&devPtr->device, (uint8_t*)string, strlen(string));
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -2155,8 +2159,23 @@ static void ParseBuffer
                 }
                 else
                 {
-                    devPtr->currentCmd[devPtr->parseIndex] = input;
-                    devPtr->parseIndex++;
+                    // Move the whole run of command characters up to the next CR or backspace
+                    size_t runLen = 1;
+                    while ((i + runLen < devPtr->indexRead) &&
+                           (devPtr->currentCmd[i + runLen] != AT_TOKEN_CR) &&
+                           (devPtr->currentCmd[i + runLen] != 0x7F))
+                    {
+                        runLen++;
+                    }
+
+                    if (devPtr->parseIndex != i)
+                    {
+                        memmove(devPtr->currentCmd + devPtr->parseIndex,
+                                devPtr->currentCmd + i,
+                                runLen);
+                    }
+                    devPtr->parseIndex += runLen;
+                    i += runLen - 1;
                 }
             }
             break;
@@ -2188,34 +2207,43 @@ static void ReceiveCmd
 )
 {
     ssize_t size;
-    // Read RX data on uart
-    size = le_dev_Read(&devPtr->device,
-                (uint8_t *)(devPtr->currentCmd + devPtr->indexRead),
-                (LE_ATDEFS_COMMAND_MAX_LEN - devPtr->indexRead));
+    size_t space;
 
-    // Value of size is negative.
-    if (0 > size)
+    // Read RX data on uart, draining the device while the reads fill the buffer so that a burst
+    // of commands is handled in one wakeup. Stop when a command switches to text mode or closes
+    // the device: the remaining data is theirs.
+    do
     {
-        LE_ERROR("le_dev_Read failed!");
-        return;
-    }
-    // Value of size is 0.
-    else if (0 == size)
-    {
-        LE_DEBUG("Read data size 0.");
-        return;
-    }
-
-    // Echo is activated
-    if (devPtr->echo)
-    {
-        le_dev_Write(&devPtr->device,
+        space = LE_ATDEFS_COMMAND_MAX_LEN - devPtr->indexRead;
+        size = le_dev_Read(&devPtr->device,
                     (uint8_t *)(devPtr->currentCmd + devPtr->indexRead),
-                    size);
-    }
+                    space);
 
-    devPtr->indexRead += size;
-    ParseBuffer(devPtr);
+        // Value of size is negative.
+        if (0 > size)
+        {
+            LE_ERROR("le_dev_Read failed!");
+            return;
+        }
+        // Value of size is 0.
+        else if (0 == size)
+        {
+            LE_DEBUG("Read data size 0.");
+            return;
+        }
+
+        // Echo is activated
+        if (devPtr->echo)
+        {
+            le_dev_Write(&devPtr->device,
+                        (uint8_t *)(devPtr->currentCmd + devPtr->indexRead),
+                        size);
+        }
+
+        devPtr->indexRead += size;
+        ParseBuffer(devPtr);
+    }
+    while (((size_t)size == space) && !devPtr->text.mode && (NULL != devPtr->device.fdMonitor));
 }
 
 //--------------------------------------------------------------------------------------------------
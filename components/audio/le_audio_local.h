@@ -162,16 +162,16 @@ typedef struct le_audio_MediaThreadContext
     uint32_t                         fd_in;              ///< file descriptor to read
     uint32_t                         fd_out;             ///< file descriptor to write
     uint32_t                         bufferSize;         ///< Size of the required buffer
-    le_sem_Ref_t                     threadSemaphore;    ///< semaphore to wait starting
     InitMediaFunc_t                  initFunc;           ///< Init function for play/capture
                                                          ///< in WAV/AMR format
-    ReadMediaFunc_t                  readFunc;           ///< Read function for play/capture
-                                                         ///< in WAV/AMR format
-    WriteMediaFunc_t                 writeFunc;          ///< Write function for play/capture
+    ReadMediaFunc_t                  readFunc;           ///< Read function for playback
+                                                         ///< in WAV/AMR format or DTMF
+    WriteMediaFunc_t                 writeFunc;          ///< Write function for capture
                                                          ///< in WAV/AMR format
     CloseMediaFunc_t                 closeFunc;          ///< Close function for play/capture
                                                          ///< in WAV/AMR format
     le_audio_Codec_t                 codecParams;        ///< Codec parameters
+    struct le_media_Session*         sessionPtr;         ///< Session served by the media worker
 }
 le_audio_MediaThreadContext_t;
 
@@ -201,7 +201,7 @@ typedef struct le_audio_Stream {
     le_audio_PcmContext_t* pcmContextPtr;              ///< PCM playback/capture context
     le_audio_MediaThreadContext_t* mediaThreadContextPtr;///< Read Media thread
     le_audio_DtmfStreamEventHandlerRef_t dtmfEventHandler; ///< Dtmf stream event handler
-    le_thread_Ref_t     mediaThreadRef;                 ///< Media thread reference
+    struct le_media_Session* mediaSessionPtr;          ///< Session served by the media worker
     bool                playFile;                      ///< Stream plays a file
     int8_t              deviceIdentifier;              ///< Device identifier
     int8_t              hwDeviceId;                    ///< Hardware Device identifier
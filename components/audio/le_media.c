@@ -15,7 +15,7 @@
 #include "pa_audio.h"
 #include "pa_amr.h"
 #include "pa_pcm.h"
-#include <math.h>
+#include "pcmKernel.h"
 
 //--------------------------------------------------------------------------------------------------
 // Symbol and Enum definitions.
@@ -35,9 +35,6 @@
 //--------------------------------------------------------------------------------------------------
 #define SAMPLE_SCALE    (32767)
 #define DTMF_AMPLITUDE  (40)
-#if !defined (PI)
-#define PI 3.14159265358979323846264338327
-#endif
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -57,6 +54,36 @@
 //--------------------------------------------------------------------------------------------------
 #define NO_MORE_SAMPLES_INFINITE_TIMEOUT -1
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the media worker buffers. One second of DTMF at 16 kHz must fit in a buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MEDIA_BUFFER_SIZE       (32 * 1024)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the reads for WAV file playback and of the writes for WAV file recording.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MEDIA_PLAY_WAV_SIZE     (16 * 1024)
+#define MEDIA_REC_WAV_SIZE      (4 * 1024)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the readahead window of the played files.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MEDIA_READAHEAD_SIZE    (256 * 1024)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of media worker buffers queued to a recorded pipe or socket. A recording whose
+ * consumer falls further behind is ended.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MEDIA_OUTPUT_MAX_BUFFERS    8
+
 //--------------------------------------------------------------------------------------------------
 // Data structures.
 //--------------------------------------------------------------------------------------------------
@@ -112,6 +139,58 @@ typedef struct
 }
 WavParams_t;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Media worker buffer. The data are page aligned, and the buffers are kept in a free list once
+ * allocated.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_sls_Link_t link;          ///< Link in the free buffer list or in an output queue
+    uint8_t*      dataPtr;       ///< Data, MEDIA_BUFFER_SIZE bytes
+    uint32_t      len;           ///< Number of bytes queued, in an output queue
+}
+MediaBuffer_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Media session, i.e. a file playback, a DTMF playback or a file recording served by the media
+ * worker.
+ *
+ * A playback is double buffered: one buffer is written to the PCM pipe while the next one is read
+ * or decoded, so that the data are ready as soon as the pipe can accept them. A recording gathers
+ * the data of the PCM pipe in one buffer until the size required by the encoder is reached. When
+ * a recording is written to a pipe or a socket, the encoded data are queued and written when the
+ * consumer can accept them, so that a slow consumer does not stall the other sessions.
+ *
+ * All the fields are only accessed by the media worker.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct le_media_Session
+{
+    le_audio_Stream_t*             streamPtr;         ///< Stream object
+    le_audio_MediaThreadContext_t* mediaCtxPtr;       ///< Media context
+    le_fdMonitor_Ref_t             pipeMonitorRef;    ///< Monitor of the PCM pipe
+    le_fdMonitor_Ref_t             sourceMonitorRef;  ///< Monitor of a played pipe or socket
+    bool                           sourceReadable;    ///< The played pipe or socket has data
+    bool                           readahead;         ///< The played file is a regular file
+    off_t                          readaheadOffset;   ///< End of the readahead window
+    bool                           endOfStream;       ///< All the data have been read
+    MediaBuffer_t*                 bufferPtr[2];      ///< Buffers
+    uint32_t                       bufferLen[2];      ///< Number of bytes in the buffers
+    uint32_t                       writeIdx;          ///< Index of the buffer written to the pipe
+    uint32_t                       writeOffset;       ///< Bytes of that buffer already written
+    bool                           nextReady;         ///< The other buffer is ready to be written
+    bool                           queueOutput;       ///< The recording goes to a pipe or socket
+    le_fdMonitor_Ref_t             outputMonitorRef;  ///< Monitor of that pipe or socket
+    le_sls_List_t                  outputList;        ///< Buffers queued to that pipe or socket
+    uint32_t                       outputCount;       ///< Number of buffers queued
+    uint32_t                       outputOffset;      ///< Bytes of the first one already written
+}
+MediaSession_t;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Playback/Capture Control enumeration.
@@ -160,6 +239,30 @@ static le_mem_PoolRef_t MediaThreadContextPool;
 //--------------------------------------------------------------------------------------------------
 static le_mem_PoolRef_t PcmThreadContextPool;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * The memory pools for the media sessions and the media worker buffers
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t MediaSessionPool;
+static le_mem_PoolRef_t MediaBufferPool;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Media worker buffers not used by a session. Only accessed by the media worker.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_sls_List_t FreeMediaBufferList = LE_SLS_LIST_INIT;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Media worker thread, serving all the media sessions, and the semaphore used to wait for the
+ * requests queued to it.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_thread_Ref_t MediaWorkerRef;
+static le_sem_Ref_t MediaWorkerSem;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Wake Lock for audio streams
@@ -381,34 +484,6 @@ static inline uint32_t Digit2HighFreq
     }
 }
 
-//--------------------------------------------------------------------------------------------------
-/**
- *  Add two 16-bit values.
- *
- */
-//--------------------------------------------------------------------------------------------------
-static inline int16_t SaturateAdd16
-(
-    int32_t a,
-    int32_t b
-)
-{
-    int32_t tot=a+b;
-
-    if (tot > 32767)
-    {
-        return 32767;
-    }
-    else if (tot < -32768)
-    {
-        return -32768;
-    }
-    else
-    {
-        return (tot & 0xFFFF);
-    }
-}
-
 //--------------------------------------------------------------------------------------------------
 /**
  *  Play Tone function. This function split into samples of 1s. To play a DTMF or a PAUSE for a
@@ -423,8 +498,8 @@ static le_result_t PlayTone
     uint32_t*                      bufferLenPtr  ///< [OUT] Length of the buffer
 )
 {
-    double   d1, d2;
-    uint32_t i;
+    pcmKernel_Tone_t lowTone;
+    pcmKernel_Tone_t highTone;
 
     DtmfParams_t*  dtmfParamsPtr = (DtmfParams_t*) mediaCtxPtr->codecParams;
     // Max samples on the whole duration
@@ -433,8 +508,6 @@ static le_result_t PlayTone
     uint32_t sampleOneSecond = dtmfParamsPtr->sampleRate + dtmfParamsPtr->currentSampleCount;
     uint32_t freq1;
     uint32_t freq2;
-    int32_t  amp1;
-    int32_t  amp2;
     int16_t* dataPtr = (int16_t*) bufferOutPtr;
     // Length of the current sample: max 1 second, i.e, sampleRate
     uint32_t sampleLength;
@@ -490,26 +563,24 @@ static le_result_t PlayTone
 
         freq1 = Digit2LowFreq(dtmfParamsPtr->dtmf[dtmfParamsPtr->currentDtmf]);
         freq2 = Digit2HighFreq(dtmfParamsPtr->dtmf[dtmfParamsPtr->currentDtmf]);
-        amp1 = DTMF_AMPLITUDE;
-        amp2 = DTMF_AMPLITUDE;
 
-        d1 = 1.0f * freq1 / dtmfParamsPtr->sampleRate;
-        d2 = 1.0f * freq2 / dtmfParamsPtr->sampleRate;
+        // Play max sampleRate (1s) of DTMF and continue at next call, the oscillators resuming
+        // at the current sample count.
+        pcmKernel_InitTone(&lowTone, freq1, dtmfParamsPtr->sampleRate,
+                           SAMPLE_SCALE * DTMF_AMPLITUDE / 100,
+                           dtmfParamsPtr->currentSampleCount);
+        pcmKernel_InitTone(&highTone, freq2, dtmfParamsPtr->sampleRate,
+                           SAMPLE_SCALE * DTMF_AMPLITUDE / 100,
+                           dtmfParamsPtr->currentSampleCount);
+        pcmKernel_GenerateTone(&lowTone, dataPtr, sampleLength);
+        pcmKernel_AddTone(&highTone, dataPtr, sampleLength);
 
-        for (i = dtmfParamsPtr->currentSampleCount;
-             // Play max sampleRate (1s) of DTMF and continue at next call
-             (i < sampleOneSecond) && (i < samplesCount);
-             i++)
+        // Save the current sample count. If the whole DTMF is played, reset to 0
+        dtmfParamsPtr->currentSampleCount += sampleLength;
+        if (dtmfParamsPtr->currentSampleCount == samplesCount)
         {
-            int16_t s1, s2;
-
-            s1 = (int16_t)(SAMPLE_SCALE * amp1 / 100.0f * sin(2 * PI * d1 * i));
-            s2 = (int16_t)(SAMPLE_SCALE * amp2 / 100.0f * sin(2 * PI * d2 * i));
-            *(dataPtr++) = SaturateAdd16(s1, s2);
+            dtmfParamsPtr->currentSampleCount = 0;
         }
-
-        // Save the current sample count. If the whole DTMF is played, reset to 0
-        dtmfParamsPtr->currentSampleCount = (i == samplesCount ? 0 : i);
         if (0 == dtmfParamsPtr->currentSampleCount)
         {
             // Update the index of DTMF if the current sample count is reset to 0
@@ -575,7 +646,8 @@ static le_result_t SetWavHeader
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Read a file descriptor.
+ * Read a file descriptor. A single read is done, so that the call does not block when a pipe or a
+ * socket has less data than the buffer size.
  *
  */
 //--------------------------------------------------------------------------------------------------
@@ -586,7 +658,13 @@ static le_result_t MediaReadFd
     uint32_t*                      readLenPtr    ///< [OUT] Length of the read data
 )
 {
-    ssize_t size = ReadFd(mediaCtxPtr->fd_in, bufferOutPtr, mediaCtxPtr->bufferSize);
+    ssize_t size;
+
+    do
+    {
+        size = read(mediaCtxPtr->fd_in, bufferOutPtr, mediaCtxPtr->bufferSize);
+    }
+    while ((size < 0) && (EINTR == errno));
 
     if (size < 0)
     {
@@ -601,25 +679,173 @@ static le_result_t MediaReadFd
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Write on a file descriptor.
+ * Get a media worker buffer.
  *
+ * @return The buffer.
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t MediaWriteFd
+static MediaBuffer_t* GetMediaBuffer
 (
-    le_audio_MediaThreadContext_t* mediaCtxPtr,     ///< [IN] Media thread context
-    uint8_t*                       bufferInPtr,     ///< [IN] Decoding samples buffer input
-    uint32_t                       bufferLen        ///< [IN] Buffer length
+    void
 )
 {
-    if (WriteFd(mediaCtxPtr->fd_out, bufferInPtr, bufferLen) < 0)
+    le_sls_Link_t* linkPtr = le_sls_Pop(&FreeMediaBufferList);
+
+    if (linkPtr)
     {
-        return LE_FAULT;
+        return CONTAINER_OF(linkPtr, MediaBuffer_t, link);
     }
 
+    MediaBuffer_t* bufferPtr = le_mem_ForceAlloc(MediaBufferPool);
+    void* dataPtr = NULL;
+
+    LE_FATAL_IF(posix_memalign(&dataPtr, sysconf(_SC_PAGESIZE), MEDIA_BUFFER_SIZE) != 0,
+                "Cannot allocate a media buffer");
+
+    bufferPtr->link = LE_SLS_LINK_INIT;
+    bufferPtr->dataPtr = dataPtr;
+
+    return bufferPtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Give a media worker buffer back to the free list.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReleaseMediaBuffer
+(
+    MediaBuffer_t* bufferPtr    ///< [IN] Buffer, may be NULL
+)
+{
+    if (bufferPtr)
+    {
+        le_sls_Stack(&FreeMediaBufferList, &bufferPtr->link);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write the buffers queued to a recorded pipe or socket, until the consumer cannot accept more or
+ * the queue is empty.
+ *
+ * @return LE_OK    on success
+ * @return LE_FAULT if the consumer is gone
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t WriteOutputQueue
+(
+    MediaSession_t* sessionPtr  ///< [IN] Media session
+)
+{
+    int fd = sessionPtr->mediaCtxPtr->fd_out;
+    le_sls_Link_t* linkPtr;
+
+    while ((linkPtr = le_sls_Peek(&sessionPtr->outputList)) != NULL)
+    {
+        MediaBuffer_t* bufferPtr = CONTAINER_OF(linkPtr, MediaBuffer_t, link);
+        ssize_t len = write(fd,
+                            bufferPtr->dataPtr + sessionPtr->outputOffset,
+                            bufferPtr->len - sessionPtr->outputOffset);
+
+        if (len < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+            {
+                le_fdMonitor_Enable(sessionPtr->outputMonitorRef, POLLOUT);
+                return LE_OK;
+            }
+
+            LE_ERROR("Write error on fd %d: %m", fd);
+            return LE_FAULT;
+        }
+
+        sessionPtr->outputOffset += len;
+
+        if (sessionPtr->outputOffset == bufferPtr->len)
+        {
+            le_sls_Pop(&sessionPtr->outputList);
+            sessionPtr->outputCount--;
+            sessionPtr->outputOffset = 0;
+            ReleaseMediaBuffer(bufferPtr);
+        }
+    }
+
+    le_fdMonitor_Disable(sessionPtr->outputMonitorRef, POLLOUT);
     return LE_OK;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write recorded data. A regular file is written directly, whereas the data for a pipe or a
+ * socket are queued and written when the consumer can accept them.
+ *
+ * @return LE_OK    on success
+ * @return LE_FAULT on failure, or if the consumer of a pipe or socket is too slow
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t WriteOutput
+(
+    le_audio_MediaThreadContext_t* mediaCtxPtr,  ///< [IN] Media thread context
+    const uint8_t*                 bufferInPtr,  ///< [IN] Data
+    uint32_t                       bufferLen     ///< [IN] Data length
+)
+{
+    MediaSession_t* sessionPtr = mediaCtxPtr->sessionPtr;
+
+    if ((sessionPtr == NULL) || !sessionPtr->queueOutput)
+    {
+        ssize_t len = WriteFd(mediaCtxPtr->fd_out, (void*)bufferInPtr, bufferLen);
+
+        if (len != bufferLen)
+        {
+            LE_ERROR("write error: %zd written, expected %u", len, bufferLen);
+            return LE_FAULT;
+        }
+        return LE_OK;
+    }
+
+    if (sessionPtr->outputMonitorRef == NULL)
+    {
+        return LE_FAULT;
+    }
+
+    while (bufferLen > 0)
+    {
+        le_sls_Link_t* linkPtr = le_sls_PeekTail(&sessionPtr->outputList);
+        MediaBuffer_t* bufferPtr = linkPtr ? CONTAINER_OF(linkPtr, MediaBuffer_t, link) : NULL;
+
+        if ((bufferPtr == NULL) || (bufferPtr->len == MEDIA_BUFFER_SIZE))
+        {
+            if (sessionPtr->outputCount == MEDIA_OUTPUT_MAX_BUFFERS)
+            {
+                LE_ERROR("Consumer of fd %d too slow, ending the recording", mediaCtxPtr->fd_out);
+                return LE_FAULT;
+            }
+
+            bufferPtr = GetMediaBuffer();
+            bufferPtr->len = 0;
+            le_sls_Queue(&sessionPtr->outputList, &bufferPtr->link);
+            sessionPtr->outputCount++;
+        }
+
+        uint32_t len = MEDIA_BUFFER_SIZE - bufferPtr->len;
+        len = (len < bufferLen) ? len : bufferLen;
+
+        memcpy(bufferPtr->dataPtr + bufferPtr->len, bufferInPtr, len);
+        bufferPtr->len += len;
+        bufferInPtr += len;
+        bufferLen -= len;
+    }
+
+    return WriteOutputQueue(sessionPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Write on a file descriptor with AMR encoding.
@@ -643,17 +869,7 @@ static le_result_t AmrWriteFd
                             outputBuf,
                             &outputBufLen) == LE_OK)
     {
-        int32_t writeLen = WriteFd( mediaCtxPtr->fd_out, outputBuf, outputBufLen );
-
-        if (writeLen != outputBufLen)
-        {
-            LE_ERROR("write error %d", writeLen);
-            result = LE_FAULT;
-        }
-        else
-        {
-            result = LE_OK;
-        }
+        result = WriteOutput(mediaCtxPtr, outputBuf, outputBufLen);
     }
 
     return result;
@@ -674,33 +890,29 @@ static le_result_t WavWriteFd
 {
     WavHeader_t hdr;
     WavParams_t* wavParamPtr =  (WavParams_t*) mediaCtxPtr->codecParams;
-    int oldstate = PTHREAD_CANCEL_ENABLE, dummy = PTHREAD_CANCEL_ENABLE;
 
-    // This function is set to no cancelable to avoid desynchronisation between the data and the
-    // header
-    pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &oldstate);
-
-    int32_t len = WriteFd(mediaCtxPtr->fd_out, bufferInPtr, bufferLen);
-
-    if (len != bufferLen)
+    if (WriteOutput(mediaCtxPtr, bufferInPtr, bufferLen) != LE_OK)
     {
-        LE_ERROR("write error: %d written, expected %d, errno %d", len, bufferLen, errno);
-        pthread_setcancelstate(oldstate, &dummy);
         return LE_FAULT;
     }
 
-    wavParamPtr->recordingSize += len;
+    wavParamPtr->recordingSize += bufferLen;
+
+    // The sizes in the header can only be updated in a file
+    if (mediaCtxPtr->sessionPtr && mediaCtxPtr->sessionPtr->queueOutput)
+    {
+        return LE_OK;
+    }
 
     lseek(mediaCtxPtr->fd_out, ((uint8_t*)&hdr.dataSize - (uint8_t*)&hdr), SEEK_SET);
 
-    len = WriteFd(mediaCtxPtr->fd_out,
-                &wavParamPtr->recordingSize,
-                sizeof(wavParamPtr->recordingSize));
+    int32_t len = WriteFd(mediaCtxPtr->fd_out,
+                          &wavParamPtr->recordingSize,
+                          sizeof(wavParamPtr->recordingSize));
 
     if (len != sizeof(wavParamPtr->recordingSize))
     {
         LE_ERROR("read error: %d written, errno %d", len, errno);
-        pthread_setcancelstate(oldstate, &dummy);
         return LE_FAULT;
     }
 
@@ -713,14 +925,11 @@ static le_result_t WavWriteFd
     if (len != sizeof(riffSize))
     {
         LE_ERROR("read error: %d written, errno %d", len, errno);
-        pthread_setcancelstate(oldstate, &dummy);
         return LE_FAULT;
     }
 
     lseek(mediaCtxPtr->fd_out, sizeof(WavHeader_t)+wavParamPtr->recordingSize, SEEK_SET);
 
-    pthread_setcancelstate(oldstate, &dummy);
-
     return LE_OK;
 }
 
@@ -760,7 +969,7 @@ static le_result_t InitPlayWavFile
         return LE_FAULT;
     }
 
-    mediaCtxPtr->bufferSize = PIPE_BUF/4;
+    mediaCtxPtr->bufferSize = MEDIA_PLAY_WAV_SIZE;
 
     return LE_OK;
 }
@@ -780,7 +989,7 @@ static le_result_t InitRecWavFile
     SetWavHeader(mediaCtxPtr->fd_out, &(streamPtr->samplePcmConfig));
 
     mediaCtxPtr->format = LE_AUDIO_FILE_WAVE;
-    mediaCtxPtr->bufferSize = 1024;
+    mediaCtxPtr->bufferSize = MEDIA_REC_WAV_SIZE;
 
     return LE_OK;
 }
@@ -808,101 +1017,476 @@ static le_result_t InitPlayDtmf
 
 //--------------------------------------------------------------------------------------------------
 /**
- *  Media threads destructor.
- *
+ * Ask the kernel to read ahead the next part of a played file, once half of the previous window
+ * has been consumed.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReadaheadFile
+(
+    MediaSession_t* sessionPtr  ///< [IN] Media session
+)
+{
+    int fd = sessionPtr->mediaCtxPtr->fd_in;
+    off_t offset = lseek(fd, 0, SEEK_CUR);
+
+    if ((offset >= 0) && ((offset + MEDIA_READAHEAD_SIZE / 2) > sessionPtr->readaheadOffset))
+    {
+        posix_fadvise(fd, offset, MEDIA_READAHEAD_SIZE, POSIX_FADV_WILLNEED);
+        sessionPtr->readaheadOffset = offset + MEDIA_READAHEAD_SIZE;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete the monitor of the PCM pipe of a session. No more data is transferred.
  */
 //--------------------------------------------------------------------------------------------------
-static void DestroyMediaThread
+static void DeletePipeMonitor
 (
-    void *contextPtr
+    MediaSession_t* sessionPtr  ///< [IN] Media session
 )
 {
-    le_audio_Stream_t* streamPtr = (le_audio_Stream_t *) contextPtr;
-    le_audio_MediaThreadContext_t * mediaCtxPtr = NULL;
+    if (sessionPtr->pipeMonitorRef)
+    {
+        le_fdMonitor_Delete(sessionPtr->pipeMonitorRef);
+        sessionPtr->pipeMonitorRef = NULL;
+    }
+}
 
-    if (streamPtr)
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete the monitor of a recorded pipe or socket, and drop the data still queued to it.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DeleteOutputMonitor
+(
+    MediaSession_t* sessionPtr  ///< [IN] Media session
+)
+{
+    le_sls_Link_t* linkPtr;
+
+    if (sessionPtr->outputMonitorRef)
     {
-        mediaCtxPtr = streamPtr->mediaThreadContextPtr;
+        le_fdMonitor_Delete(sessionPtr->outputMonitorRef);
+        sessionPtr->outputMonitorRef = NULL;
     }
 
-    LE_DEBUG("DestroyMediaThread running");
+    LE_WARN_IF(sessionPtr->outputCount, "%u recorded buffers dropped", sessionPtr->outputCount);
 
-    if (mediaCtxPtr)
+    while ((linkPtr = le_sls_Pop(&sessionPtr->outputList)) != NULL)
     {
-        mediaCtxPtr->closeFunc(mediaCtxPtr);
+        ReleaseMediaBuffer(CONTAINER_OF(linkPtr, MediaBuffer_t, link));
+    }
+    sessionPtr->outputCount = 0;
+    sessionPtr->outputOffset = 0;
+}
 
-        close(mediaCtxPtr->fd_pipe_input);
-        close(mediaCtxPtr->fd_pipe_output);
-        streamPtr->fd = mediaCtxPtr->fd_arg;
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read or decode the next playback buffer, unless it is already ready or the played pipe or
+ * socket has no data.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FillPlaybackBuffer
+(
+    MediaSession_t* sessionPtr  ///< [IN] Media session
+)
+{
+    le_audio_MediaThreadContext_t* mediaCtxPtr = sessionPtr->mediaCtxPtr;
+    uint32_t idx = 1 - sessionPtr->writeIdx;
+    uint32_t readLen = 0;
+
+    if (sessionPtr->nextReady || sessionPtr->endOfStream)
+    {
+        return;
+    }
+
+    // A pipe or a socket is only read when it has data, not to block the other sessions.
+    if (sessionPtr->sourceMonitorRef && !sessionPtr->sourceReadable)
+    {
+        le_fdMonitor_Enable(sessionPtr->sourceMonitorRef, POLLIN);
+        return;
+    }
+
+    sessionPtr->sourceReadable = false;
+
+    if ((mediaCtxPtr->readFunc(mediaCtxPtr,
+                               sessionPtr->bufferPtr[idx]->dataPtr,
+                               &readLen) != LE_OK) || (readLen == 0))
+    {
+        LE_DEBUG("End of playback on stream %p", sessionPtr->streamPtr->streamRef);
+        sessionPtr->endOfStream = true;
+        return;
+    }
+
+    sessionPtr->bufferLen[idx] = readLen;
+    sessionPtr->nextReady = true;
+
+    if (sessionPtr->readahead)
+    {
+        ReadaheadFile(sessionPtr);
+    }
+}
 
-        if (mediaCtxPtr->threadSemaphore)
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write the playback buffers to the PCM pipe, until the pipe is full or no buffer is ready.
+ */
+//--------------------------------------------------------------------------------------------------
+static void WritePlaybackBuffers
+(
+    MediaSession_t* sessionPtr  ///< [IN] Media session
+)
+{
+    int fd = sessionPtr->mediaCtxPtr->fd_out;
+
+    if (!sessionPtr->pipeMonitorRef)
+    {
+        return;
+    }
+
+    while (1)
+    {
+        uint32_t idx = sessionPtr->writeIdx;
+        uint8_t* dataPtr = sessionPtr->bufferPtr[idx]->dataPtr;
+
+        while (sessionPtr->writeOffset < sessionPtr->bufferLen[idx])
         {
-            le_sem_Delete(mediaCtxPtr->threadSemaphore);
+            ssize_t len = write(fd,
+                                dataPtr + sessionPtr->writeOffset,
+                                sessionPtr->bufferLen[idx] - sessionPtr->writeOffset);
+
+            if (len < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+
+                if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+                {
+                    le_fdMonitor_Enable(sessionPtr->pipeMonitorRef, POLLOUT);
+                    return;
+                }
+
+                LE_ERROR("Write error on fd %d: %m", fd);
+                DeletePipeMonitor(sessionPtr);
+                return;
+            }
+
+            sessionPtr->writeOffset += len;
         }
 
-        le_mem_Release(mediaCtxPtr);
-        streamPtr->mediaThreadContextPtr = NULL;
+        if (!sessionPtr->nextReady)
+        {
+            // Wait for the played pipe or socket, or the playback is over.
+            le_fdMonitor_Disable(sessionPtr->pipeMonitorRef, POLLOUT);
+            return;
+        }
+
+        // Write the next buffer, and refill this one while the pipe drains.
+        sessionPtr->writeIdx = 1 - idx;
+        sessionPtr->writeOffset = 0;
+        sessionPtr->nextReady = false;
+
+        FillPlaybackBuffer(sessionPtr);
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler of the PCM pipe of a playback.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PlaybackPipeHandler
+(
+    int   fd,       ///< [IN] Write end of the PCM pipe
+    short events    ///< [IN] Events
+)
+{
+    MediaSession_t* sessionPtr = le_fdMonitor_GetContextPtr();
+
+    if (events & (POLLERR | POLLHUP))
+    {
+        LE_ERROR("PCM pipe %d closed", fd);
+        DeletePipeMonitor(sessionPtr);
+        return;
+    }
+
+    WritePlaybackBuffers(sessionPtr);
+}
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Media thread.
- *
+ * Handler of a played pipe or socket.
  */
 //--------------------------------------------------------------------------------------------------
-static void* MediaThread
+static void PlaybackSourceHandler
 (
-    void* contextPtr
+    int   fd,       ///< [IN] Played pipe or socket
+    short events    ///< [IN] Events
 )
 {
-    le_audio_MediaThreadContext_t * mediaCtxPtr = (le_audio_MediaThreadContext_t *) contextPtr;
-    uint8_t outBuffer[mediaCtxPtr->bufferSize];
-    uint32_t readLen = 0;
-    bool semPost = false;
+    MediaSession_t* sessionPtr = le_fdMonitor_GetContextPtr();
 
-    LE_DEBUG("MediaThread");
+    sessionPtr->sourceReadable = true;
+    le_fdMonitor_Disable(sessionPtr->sourceMonitorRef, POLLIN);
 
-    if (!mediaCtxPtr->readFunc || !mediaCtxPtr->closeFunc || !mediaCtxPtr->writeFunc)
+    if (events & (POLLERR | POLLHUP | POLLRDHUP))
     {
-        LE_ERROR("functions not set !!!");
-        return NULL;
+        // The writer is gone: the remaining data can be read without blocking.
+        le_fdMonitor_Delete(sessionPtr->sourceMonitorRef);
+        sessionPtr->sourceMonitorRef = NULL;
     }
 
+    FillPlaybackBuffer(sessionPtr);
+    WritePlaybackBuffers(sessionPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler of the PCM pipe of a recording. The data are gathered until the buffer size required by
+ * the encoder is reached.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RecordPipeHandler
+(
+    int   fd,       ///< [IN] Read end of the PCM pipe
+    short events    ///< [IN] Events
+)
+{
+    MediaSession_t* sessionPtr = le_fdMonitor_GetContextPtr();
+    le_audio_MediaThreadContext_t* mediaCtxPtr = sessionPtr->mediaCtxPtr;
+    uint8_t* dataPtr = sessionPtr->bufferPtr[0]->dataPtr;
+
     while (1)
     {
-        memset(outBuffer,0,mediaCtxPtr->bufferSize);
+        ssize_t len = read(fd,
+                           dataPtr + sessionPtr->bufferLen[0],
+                           mediaCtxPtr->bufferSize - sessionPtr->bufferLen[0]);
 
-        /* read/decode the packet */
-        if ( ( mediaCtxPtr->readFunc( mediaCtxPtr,
-                                      outBuffer,
-                                      &readLen ) == LE_OK ) && readLen )
+        if (len < 0)
         {
-            if ( mediaCtxPtr->writeFunc( mediaCtxPtr,
-                                         outBuffer,
-                                         readLen ) != LE_OK )
+            if (errno == EINTR)
             {
-                break;
+                continue;
             }
-            else
+
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
             {
-                if (mediaCtxPtr->threadSemaphore && !semPost)
-                {
-                    le_sem_Post(mediaCtxPtr->threadSemaphore);
-                    semPost = true;
-                }
+                return;
             }
+
+            LE_ERROR("Read error on fd %d: %m", fd);
+            break;
         }
-        else
+
+        if (len == 0)
         {
             break;
         }
+
+        sessionPtr->bufferLen[0] += len;
+
+        if (sessionPtr->bufferLen[0] == mediaCtxPtr->bufferSize)
+        {
+            sessionPtr->bufferLen[0] = 0;
+
+            if (mediaCtxPtr->writeFunc(mediaCtxPtr, dataPtr, mediaCtxPtr->bufferSize) != LE_OK)
+            {
+                break;
+            }
+        }
     }
 
-    LE_DEBUG("MediaThread end");
+    LE_DEBUG("End of recording on stream %p", sessionPtr->streamPtr->streamRef);
+    DeletePipeMonitor(sessionPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler of a recorded pipe or socket, called when the consumer can accept the queued data.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RecordOutputHandler
+(
+    int   fd,       ///< [IN] Recorded pipe or socket
+    short events    ///< [IN] Events
+)
+{
+    MediaSession_t* sessionPtr = le_fdMonitor_GetContextPtr();
+
+    if ((events & (POLLERR | POLLHUP)) || (WriteOutputQueue(sessionPtr) != LE_OK))
+    {
+        LE_ERROR("Consumer of fd %d gone, ending the recording", fd);
+        DeletePipeMonitor(sessionPtr);
+        DeleteOutputMonitor(sessionPtr);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start a media session. Called by the media worker.
+ *
+ * A played file is read when the PCM pipe can accept data, whereas a played pipe or socket is
+ * monitored and read when it has data. The PCM pipe is filled before the function returns, so that
+ * the PCM playback does not start with an underflow.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StartMediaSession
+(
+    void* param1Ptr,    ///< [IN] Stream object
+    void* param2Ptr     ///< [IN] Unused
+)
+{
+    le_audio_Stream_t* streamPtr = param1Ptr;
+    le_audio_MediaThreadContext_t* mediaCtxPtr = streamPtr->mediaThreadContextPtr;
+    MediaSession_t* sessionPtr = le_mem_ForceAlloc(MediaSessionPool);
+    int fdIn = mediaCtxPtr->fd_in;
+    int fdOut = mediaCtxPtr->fd_out;
+    char name[STRING_LEN];
+    struct stat st;
+
+    memset(sessionPtr, 0, sizeof(MediaSession_t));
+    sessionPtr->streamPtr = streamPtr;
+    sessionPtr->mediaCtxPtr = mediaCtxPtr;
+    sessionPtr->bufferPtr[0] = GetMediaBuffer();
+    sessionPtr->outputList = LE_SLS_LIST_INIT;
+    streamPtr->mediaSessionPtr = sessionPtr;
+    mediaCtxPtr->sessionPtr = sessionPtr;
+
+    if (streamPtr->audioInterface == LE_AUDIO_IF_DSP_FRONTEND_FILE_PLAY)
+    {
+        sessionPtr->bufferPtr[1] = GetMediaBuffer();
+
+        if ((fdIn >= 0) && (fstat(fdIn, &st) == 0))
+        {
+            if (S_ISREG(st.st_mode))
+            {
+                sessionPtr->readahead = true;
+                posix_fadvise(fdIn, 0, 0, POSIX_FADV_SEQUENTIAL);
+                ReadaheadFile(sessionPtr);
+            }
+            else if (S_ISFIFO(st.st_mode) || S_ISSOCK(st.st_mode))
+            {
+                snprintf(name, sizeof(name), "MediaSource-%p", streamPtr->streamRef);
+                sessionPtr->sourceMonitorRef = le_fdMonitor_Create(name,
+                                                                   fdIn,
+                                                                   PlaybackSourceHandler,
+                                                                   0);
+                le_fdMonitor_SetContextPtr(sessionPtr->sourceMonitorRef, sessionPtr);
+            }
+        }
+
+        fcntl(fdOut, F_SETFL, fcntl(fdOut, F_GETFL) | O_NONBLOCK);
+
+        snprintf(name, sizeof(name), "MediaPipe-%p", streamPtr->streamRef);
+        sessionPtr->pipeMonitorRef = le_fdMonitor_Create(name,
+                                                         fdOut,
+                                                         PlaybackPipeHandler,
+                                                         POLLOUT);
+        le_fdMonitor_SetContextPtr(sessionPtr->pipeMonitorRef, sessionPtr);
+
+        FillPlaybackBuffer(sessionPtr);
+        WritePlaybackBuffers(sessionPtr);
+    }
+    else
+    {
+        // Writes to a pipe or a socket are queued, not to block the other sessions on a slow
+        // consumer.
+        if ((fstat(fdOut, &st) == 0) && (S_ISFIFO(st.st_mode) || S_ISSOCK(st.st_mode)))
+        {
+            fcntl(fdOut, F_SETFL, fcntl(fdOut, F_GETFL) | O_NONBLOCK);
+
+            snprintf(name, sizeof(name), "MediaOutput-%p", streamPtr->streamRef);
+            sessionPtr->queueOutput = true;
+            sessionPtr->outputMonitorRef = le_fdMonitor_Create(name,
+                                                               fdOut,
+                                                               RecordOutputHandler,
+                                                               0);
+            le_fdMonitor_SetContextPtr(sessionPtr->outputMonitorRef, sessionPtr);
+        }
+
+        fcntl(fdIn, F_SETFL, fcntl(fdIn, F_GETFL) | O_NONBLOCK);
+
+        snprintf(name, sizeof(name), "MediaPipe-%p", streamPtr->streamRef);
+        sessionPtr->pipeMonitorRef = le_fdMonitor_Create(name,
+                                                         fdIn,
+                                                         RecordPipeHandler,
+                                                         POLLIN);
+        le_fdMonitor_SetContextPtr(sessionPtr->pipeMonitorRef, sessionPtr);
+    }
+
+    le_sem_Post(MediaWorkerSem);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stop a media session and release its resources. Called by the media worker.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StopMediaSession
+(
+    void* param1Ptr,    ///< [IN] Stream object
+    void* param2Ptr     ///< [IN] Unused
+)
+{
+    le_audio_Stream_t* streamPtr = param1Ptr;
+    MediaSession_t* sessionPtr = streamPtr->mediaSessionPtr;
+    le_audio_MediaThreadContext_t* mediaCtxPtr = streamPtr->mediaThreadContextPtr;
+
+    LE_DEBUG("StopMediaSession running");
+
+    if (sessionPtr)
+    {
+        DeletePipeMonitor(sessionPtr);
+
+        // Write what the consumer can still accept without blocking
+        if (sessionPtr->outputMonitorRef && (WriteOutputQueue(sessionPtr) != LE_OK))
+        {
+            LE_ERROR("Consumer of fd %d gone", sessionPtr->mediaCtxPtr->fd_out);
+        }
+        DeleteOutputMonitor(sessionPtr);
+
+        if (sessionPtr->sourceMonitorRef)
+        {
+            le_fdMonitor_Delete(sessionPtr->sourceMonitorRef);
+        }
+
+        ReleaseMediaBuffer(sessionPtr->bufferPtr[0]);
+        ReleaseMediaBuffer(sessionPtr->bufferPtr[1]);
+        le_mem_Release(sessionPtr);
+        streamPtr->mediaSessionPtr = NULL;
+    }
+
+    if (mediaCtxPtr)
+    {
+        mediaCtxPtr->closeFunc(mediaCtxPtr);
+
+        close(mediaCtxPtr->fd_pipe_input);
+        close(mediaCtxPtr->fd_pipe_output);
+        streamPtr->fd = mediaCtxPtr->fd_arg;
+
+        le_mem_Release(mediaCtxPtr);
+        streamPtr->mediaThreadContextPtr = NULL;
+    }
+
+    le_sem_Post(MediaWorkerSem);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Media worker thread. It serves all the media sessions from its event loop.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void* MediaWorker
+(
+    void* contextPtr
+)
+{
+    le_sem_Post(MediaWorkerSem);
 
-    // Run the event loop to wait the end of the thread
     le_event_RunLoop();
 
     return NULL;
@@ -910,11 +1494,11 @@ static void* MediaThread
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Initialize the Media thread
+ * Initialize a media session and hand it over to the media worker.
  *
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t InitMediaThread
+static le_result_t InitMediaSession
 (
     le_audio_Stream_t*          streamPtr,
     le_audio_FileFormat_t       format,
@@ -936,6 +1520,14 @@ static le_result_t InitMediaThread
         return LE_FAULT;
     }
 
+    if (!mediaCtxPtr->closeFunc ||
+        ((streamPtr->audioInterface == LE_AUDIO_IF_DSP_FRONTEND_FILE_PLAY) ?
+         !mediaCtxPtr->readFunc : !mediaCtxPtr->writeFunc))
+    {
+        LE_ERROR("functions not set !!!");
+        return LE_FAULT;
+    }
+
     mediaCtxPtr->fd_in = fd_in;
     mediaCtxPtr->fd_out = fd_out;
     mediaCtxPtr->format = format;
@@ -948,45 +1540,11 @@ static le_result_t InitMediaThread
         return LE_FAULT;
     }
 
-    char name[STRING_LEN];
-
-    snprintf(name, sizeof(name), "MediaThread-%p", streamPtr->streamRef);
+    LE_FATAL_IF(mediaCtxPtr->bufferSize > MEDIA_BUFFER_SIZE,
+                "Buffer size %u larger than the media buffers", mediaCtxPtr->bufferSize);
 
-    streamPtr->mediaThreadRef = le_thread_Create(name,
-                                                 MediaThread,
-                                                 streamPtr->mediaThreadContextPtr);
-
-    snprintf(name, sizeof(name), "MediaSem-%p", streamPtr->streamRef);
-
-    // semaphore only needs for playback. For recording, we are waiting for data on the pipe
-    if (streamPtr->audioInterface == LE_AUDIO_IF_DSP_FRONTEND_FILE_PLAY)
-    {
-        mediaCtxPtr->threadSemaphore = le_sem_Create(name,0);
-    }
-    else
-    {
-        mediaCtxPtr->threadSemaphore = NULL;
-    }
-
-    // Increase thread priority for file playback to avoid underflow
-    if ( LE_AUDIO_IF_DSP_FRONTEND_FILE_PLAY == streamPtr->audioInterface )
-    {
-        le_thread_SetPriority(streamPtr->mediaThreadRef, LE_THREAD_PRIORITY_RT_3);
-    }
-
-    le_thread_SetJoinable(streamPtr->mediaThreadRef);
-
-    le_thread_AddChildDestructor(streamPtr->mediaThreadRef,
-                                 DestroyMediaThread,
-                                 streamPtr);
-
-    le_thread_Start(streamPtr->mediaThreadRef);
-
-    if (mediaCtxPtr->threadSemaphore)
-    {
-        le_clk_Time_t  timeToWait = {1,0};
-        le_sem_WaitWithTimeOut(mediaCtxPtr->threadSemaphore, timeToWait);
-    }
+    le_event_QueueFunctionToThread(MediaWorkerRef, StartMediaSession, streamPtr, NULL);
+    le_sem_Wait(MediaWorkerSem);
 
     return LE_OK;
 }
@@ -1030,7 +1588,6 @@ static le_result_t PlayWavFile
 
     mediaContextPtr->initFunc = InitPlayWavFile;
     mediaContextPtr->readFunc = MediaReadFd;
-    mediaContextPtr->writeFunc = MediaWriteFd;
     mediaContextPtr->closeFunc = ReleaseCodecParams;
 
     *formatPtr = LE_AUDIO_FILE_WAVE;
@@ -1101,7 +1658,6 @@ static le_result_t PlayAmrFile
 
         mediaContextPtr->initFunc = pa_amr_StartDecoder;
         mediaContextPtr->readFunc = pa_amr_DecodeFrames;
-        mediaContextPtr->writeFunc = MediaWriteFd;
         mediaContextPtr->closeFunc = pa_amr_StopDecoder;
 
         return LE_OK;
@@ -1198,7 +1754,6 @@ static le_result_t RecordAmrFile
     }
 
     mediaCtxPtr->initFunc = pa_amr_StartEncoder;
-    mediaCtxPtr->readFunc = MediaReadFd;
     mediaCtxPtr->writeFunc = AmrWriteFd;
     mediaCtxPtr->closeFunc = pa_amr_StopEncoder;
 
@@ -1233,7 +1788,6 @@ static le_result_t RecordWavFile
 
     mediaCtxPtr->codecParams = (le_audio_Codec_t) WavParamsPtr;
     mediaCtxPtr->initFunc = InitRecWavFile;
-    mediaCtxPtr->readFunc = MediaReadFd;
     mediaCtxPtr->writeFunc = WavWriteFd;
     mediaCtxPtr->closeFunc = ReleaseCodecParams;
     *formatPtr = LE_AUDIO_FILE_WAVE;
@@ -1669,7 +2223,6 @@ le_result_t le_media_PlayDtmf
 
     mediaCtxPtr->initFunc = InitPlayDtmf;
     mediaCtxPtr->readFunc = PlayTone;
-    mediaCtxPtr->writeFunc = MediaWriteFd;
     mediaCtxPtr->closeFunc = ReleaseCodecParams;
     mediaCtxPtr->codecParams = (le_audio_Codec_t) dtmfParamsPtr;
 
@@ -1687,7 +2240,7 @@ le_result_t le_media_PlayDtmf
     mediaCtxPtr->fd_pipe_output = pipefd[0];
     streamPtr->fd = pipefd[0];
 
-    if ( (res=InitMediaThread( streamPtr,
+    if ( (res=InitMediaSession( streamPtr,
                             LE_AUDIO_FILE_MAX,
                             -1,
                             pipefd[1] )) == LE_OK)
@@ -1768,7 +2321,7 @@ le_result_t le_media_Open
                             mediaCtxPtr->fd_pipe_output,
                             mediaCtxPtr->fd_arg);
 
-                res = InitMediaThread( streamPtr,
+                res = InitMediaSession( streamPtr,
                                        format,
                                        mediaCtxPtr->fd_arg,
                                        pipefd[1] );
@@ -1829,7 +2382,7 @@ le_result_t le_media_Open
                             mediaCtxPtr->fd_pipe_output,
                             mediaCtxPtr->fd_arg);
 
-                res = InitMediaThread(  streamPtr,
+                res = InitMediaSession(  streamPtr,
                                         format,
                                         pipefd[0],
                                         mediaCtxPtr->fd_arg );
@@ -2120,12 +2673,11 @@ le_result_t le_media_Stop
                 streamPtr->pcmContextPtr = NULL;
             }
 
-            if (streamPtr->mediaThreadRef)
+            if (streamPtr->mediaSessionPtr)
             {
-                LE_DEBUG("Stop media thread");
-                le_thread_Cancel(streamPtr->mediaThreadRef);
-                le_thread_Join(streamPtr->mediaThreadRef,NULL);
-                streamPtr->mediaThreadRef = NULL;
+                LE_DEBUG("Stop media session");
+                le_event_QueueFunctionToThread(MediaWorkerRef, StopMediaSession, streamPtr, NULL);
+                le_sem_Wait(MediaWorkerSem);
             }
 
             // Release the wakeup source for media streams
@@ -2264,6 +2816,9 @@ void le_media_Init
     void
 )
 {
+    // Build the tone synthesis tables.
+    pcmKernel_Init();
+
     // Allocate the Media thread context pool.
     MediaThreadContextPool = le_mem_CreatePool("MediaThreadContextPool",
                                                 sizeof(le_audio_MediaThreadContext_t));
@@ -2278,6 +2833,17 @@ void le_media_Init
     PcmThreadContextPool = le_mem_CreatePool("PcmThreadContextPool",
                                                                sizeof(le_audio_PcmContext_t));
 
+    // Allocate the media sessions and media buffers pools.
+    MediaSessionPool = le_mem_CreatePool("MediaSessionPool", sizeof(MediaSession_t));
+    MediaBufferPool = le_mem_CreatePool("MediaBufferPool", sizeof(MediaBuffer_t));
+
+    // Start the media worker, with a priority avoiding underflows during file playback.
+    MediaWorkerSem = le_sem_Create("MediaWorkerSem", 0);
+    MediaWorkerRef = le_thread_Create("MediaWorker", MediaWorker, NULL);
+    le_thread_SetPriority(MediaWorkerRef, LE_THREAD_PRIORITY_RT_3);
+    le_thread_Start(MediaWorkerRef);
+    le_sem_Wait(MediaWorkerSem);
+
     // Create a Wakeup source for Media
     MediaWakeLock = le_pm_NewWakeupSource( LE_PM_REF_COUNT, "MediaStream" );
 }
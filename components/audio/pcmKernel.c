@@ -0,0 +1,142 @@
+/** @file pcmKernel.c
+ *
+ * Implementation of the PCM sample processing kernels.
+ *
+ * The sine table holds one turn plus one sample, so that the linear interpolation between two
+ * entries never wraps. With 1024 entries and 16 bits of interpolation, the synthesized tones are
+ * within one unit of the sin() based computation.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "pcmKernel.h"
+#include <math.h>
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of bits of the sine table index.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SINE_TABLE_BITS     10
+#define SINE_TABLE_SIZE     (1 << SINE_TABLE_BITS)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sine table, in Q15 format.
+ */
+//--------------------------------------------------------------------------------------------------
+static int16_t SineTable[SINE_TABLE_SIZE + 1];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Saturate a value to 16 bits.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline int32_t Saturate16
+(
+    int32_t value
+)
+{
+    value = (value > INT16_MAX) ? INT16_MAX : value;
+    return (value < INT16_MIN) ? INT16_MIN : value;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute the next sample of a tone.
+ *
+ * @return The sample.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline int32_t NextToneSample
+(
+    pcmKernel_Tone_t* tonePtr       ///< [IN/OUT] Tone oscillator
+)
+{
+    uint32_t index = tonePtr->phase >> (32 - SINE_TABLE_BITS);
+    int32_t fraction = (tonePtr->phase >> (16 - SINE_TABLE_BITS)) & 0xFFFF;
+    int32_t sample = SineTable[index] +
+                     (((SineTable[index + 1] - SineTable[index]) * fraction + (1 << 15)) >> 16);
+
+    tonePtr->phase += tonePtr->step;
+
+    return (sample * tonePtr->amplitude + (1 << 14)) >> 15;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the module. Must be called once before any other function.
+ */
+//--------------------------------------------------------------------------------------------------
+void pcmKernel_Init
+(
+    void
+)
+{
+    int i;
+
+    for (i = 0; i <= SINE_TABLE_SIZE; i++)
+    {
+        SineTable[i] = (int16_t)lrint(INT16_MAX * sin(2 * M_PI * i / SINE_TABLE_SIZE));
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize a tone oscillator.
+ */
+//--------------------------------------------------------------------------------------------------
+void pcmKernel_InitTone
+(
+    pcmKernel_Tone_t* tonePtr,      ///< [OUT] Tone oscillator
+    uint32_t          frequency,    ///< [IN]  Tone frequency, in Hz
+    uint32_t          sampleRate,   ///< [IN]  Sample rate, in Hz
+    int32_t           amplitude,    ///< [IN]  Peak amplitude, up to 32767
+    uint32_t          startSample   ///< [IN]  Index of the first sample to generate
+)
+{
+    tonePtr->step = (uint32_t)(((uint64_t)frequency << 32) / sampleRate);
+    tonePtr->phase = (uint32_t)((uint64_t)tonePtr->step * startSample);
+    tonePtr->amplitude = amplitude;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write the next samples of a tone in a buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+void pcmKernel_GenerateTone
+(
+    pcmKernel_Tone_t* tonePtr,      ///< [IN/OUT] Tone oscillator
+    int16_t*          samplesPtr,   ///< [OUT]    Samples
+    size_t            count         ///< [IN]     Number of samples
+)
+{
+    size_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        samplesPtr[i] = (int16_t)NextToneSample(tonePtr);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mix the next samples of a tone into a buffer, with saturation.
+ */
+//--------------------------------------------------------------------------------------------------
+void pcmKernel_AddTone
+(
+    pcmKernel_Tone_t* tonePtr,      ///< [IN/OUT] Tone oscillator
+    int16_t*          samplesPtr,   ///< [IN/OUT] Samples
+    size_t            count         ///< [IN]     Number of samples
+)
+{
+    size_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        samplesPtr[i] = (int16_t)Saturate16(samplesPtr[i] + NextToneSample(tonePtr));
+    }
+}
@@ -0,0 +1,75 @@
+/** @file pcmKernel.h
+ *
+ * Tone synthesis kernels of the media threads.
+ *
+ * The tone oscillator looks the samples up in a sine table with a 32-bit phase accumulator, so
+ * that no trigonometric function is computed per sample.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#ifndef LEGATO_PCMKERNEL_INCLUDE_GUARD
+#define LEGATO_PCMKERNEL_INCLUDE_GUARD
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Tone oscillator.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t phase;         ///< Current phase, a full turn being 2^32
+    uint32_t step;          ///< Phase increment per sample
+    int32_t  amplitude;     ///< Peak amplitude
+}
+pcmKernel_Tone_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the module. Must be called once before any other function.
+ */
+//--------------------------------------------------------------------------------------------------
+void pcmKernel_Init
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize a tone oscillator.
+ */
+//--------------------------------------------------------------------------------------------------
+void pcmKernel_InitTone
+(
+    pcmKernel_Tone_t* tonePtr,      ///< [OUT] Tone oscillator
+    uint32_t          frequency,    ///< [IN]  Tone frequency, in Hz
+    uint32_t          sampleRate,   ///< [IN]  Sample rate, in Hz
+    int32_t           amplitude,    ///< [IN]  Peak amplitude, up to 32767
+    uint32_t          startSample   ///< [IN]  Index of the first sample to generate
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write the next samples of a tone in a buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+void pcmKernel_GenerateTone
+(
+    pcmKernel_Tone_t* tonePtr,      ///< [IN/OUT] Tone oscillator
+    int16_t*          samplesPtr,   ///< [OUT]    Samples
+    size_t            count         ///< [IN]     Number of samples
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mix the next samples of a tone into a buffer, with saturation.
+ */
+//--------------------------------------------------------------------------------------------------
+void pcmKernel_AddTone
+(
+    pcmKernel_Tone_t* tonePtr,      ///< [IN/OUT] Tone oscillator
+    int16_t*          samplesPtr,   ///< [IN/OUT] Samples
+    size_t            count         ///< [IN]     Number of samples
+);
+
+#endif // LEGATO_PCMKERNEL_INCLUDE_GUARD
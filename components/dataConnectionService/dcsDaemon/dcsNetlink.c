@@ -0,0 +1,739 @@
+/** @file dcsNetlink.c
+ *
+ * Routing netlink interface of the Data Connection Service.
+ *
+ * Two sockets are used: the monitor socket is subscribed to the link, address and route multicast
+ * groups and is served by the event loop, the request socket sends the route changes and waits for
+ * their acknowledgements. All the messages of a batch are sent in a single sendmsg() call, each
+ * one with its own sequence number, so that the kernel result of every change is known.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "dcsNetlink.h"
+#include <arpa/inet.h>
+#include <ifaddrs.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Multicast groups of the monitor socket.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MONITOR_GROUPS  (RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR | \
+                         RTMGRP_IPV4_ROUTE | RTMGRP_IPV6_ROUTE)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the receive buffers. The kernel never sends a notification larger than a page.
+ */
+//--------------------------------------------------------------------------------------------------
+#define RECEIVE_BUFFER_BYTES    8192
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Time to wait for the kernel acknowledgements, in seconds.
+ */
+//--------------------------------------------------------------------------------------------------
+#define ACK_TIMEOUT_SEC         2
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Route request message: header, route message and room for the destination, gateway and output
+ * interface attributes.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    struct nlmsghdr hdr;
+    struct rtmsg    rt;
+    uint8_t         attributes[2 * RTA_SPACE(sizeof(struct in6_addr)) + RTA_SPACE(sizeof(int))];
+}
+RouteMessage_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Socket receiving the kernel notifications.
+ */
+//--------------------------------------------------------------------------------------------------
+static int MonitorFd = -1;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Socket sending the route changes.
+ */
+//--------------------------------------------------------------------------------------------------
+static int RequestFd = -1;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sequence number of the last request message.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t Sequence = 0;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Notification handler and its context.
+ */
+//--------------------------------------------------------------------------------------------------
+static dcsNetlink_EventHandlerFunc_t EventHandler = NULL;
+static void* EventContextPtr = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Receive buffers of the notifications and of the acknowledgements. They are distinct because
+ * the notification handler may apply route changes, and thus wait for acknowledgements, while the
+ * notifications of the monitor buffer are being processed.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t MonitorBuffer[RECEIVE_BUFFER_BYTES / sizeof(uint32_t)];
+static uint32_t RequestBuffer[RECEIVE_BUFFER_BYTES / sizeof(uint32_t)];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open a routing netlink socket.
+ *
+ * @return The socket, or -1 on failure.
+ */
+//--------------------------------------------------------------------------------------------------
+static int OpenSocket
+(
+    uint32_t groups,    ///< [IN] Multicast groups to subscribe to
+    int      flags      ///< [IN] Additional socket type flags
+)
+{
+    struct sockaddr_nl addr;
+    int fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC | flags, NETLINK_ROUTE);
+
+    if (-1 == fd)
+    {
+        LE_WARN("Unable to open netlink socket: %m");
+        return -1;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.nl_family = AF_NETLINK;
+    addr.nl_groups = groups;
+
+    if (-1 == bind(fd, (struct sockaddr*)&addr, sizeof(addr)))
+    {
+        LE_WARN("Unable to bind netlink socket: %m");
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Receive messages from the kernel, ignoring the messages sent by other processes.
+ *
+ * @return The number of bytes received, or -1 on failure with errno set.
+ */
+//--------------------------------------------------------------------------------------------------
+static ssize_t ReceiveFromKernel
+(
+    int       fd,           ///< [IN] Netlink socket
+    uint32_t* bufferPtr,    ///< [OUT] Receive buffer, RECEIVE_BUFFER_BYTES long
+    int       flags         ///< [IN] recvfrom() flags
+)
+{
+    struct sockaddr_nl addr;
+    socklen_t addrLen;
+    ssize_t len;
+
+    do
+    {
+        addrLen = sizeof(addr);
+        len = recvfrom(fd, bufferPtr, RECEIVE_BUFFER_BYTES, flags,
+                       (struct sockaddr*)&addr, &addrLen);
+    }
+    while (((len >= 0) && (0 != addr.nl_pid)) || ((-1 == len) && (EINTR == errno)));
+
+    return len;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Report a notification on an interface to the handler.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReportEvent
+(
+    dcsNetlink_EventType_t type,        ///< [IN] Notification type
+    int                    ifIndex,     ///< [IN] Interface index, 0 for none
+    int                    family       ///< [IN] Address family
+)
+{
+    dcsNetlink_Event_t event;
+
+    memset(&event, 0, sizeof(event));
+    event.type = type;
+    event.family = family;
+
+    if ((0 != ifIndex) && (NULL == if_indextoname(ifIndex, event.interfaceName)))
+    {
+        // Interface already gone
+        return;
+    }
+
+    LE_DEBUG("Event %d on '%s', family %d", type, event.interfaceName, family);
+
+    if (NULL != EventHandler)
+    {
+        EventHandler(&event, EventContextPtr);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Process a link notification.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ProcessLinkMessage
+(
+    const struct nlmsghdr* hdrPtr   ///< [IN] Notification
+)
+{
+    const struct ifinfomsg* ifiPtr = NLMSG_DATA(hdrPtr);
+    bool isRunning = (RTM_NEWLINK == hdrPtr->nlmsg_type) &&
+                     ((ifiPtr->ifi_flags & (IFF_UP | IFF_RUNNING)) == (IFF_UP | IFF_RUNNING));
+
+    ReportEvent(isRunning ? DCSNETLINK_LINK_UP : DCSNETLINK_LINK_DOWN,
+                ifiPtr->ifi_index,
+                AF_UNSPEC);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Process an address notification. Link-local and host addresses are ignored.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ProcessAddressMessage
+(
+    const struct nlmsghdr* hdrPtr   ///< [IN] Notification
+)
+{
+    const struct ifaddrmsg* ifaPtr = NLMSG_DATA(hdrPtr);
+
+    if (ifaPtr->ifa_scope >= RT_SCOPE_LINK)
+    {
+        return;
+    }
+
+    ReportEvent((RTM_NEWADDR == hdrPtr->nlmsg_type) ?
+                    DCSNETLINK_ADDRESS_ADDED : DCSNETLINK_ADDRESS_REMOVED,
+                ifaPtr->ifa_index,
+                ifaPtr->ifa_family);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Process a route notification. Only the unicast routes of the main table are reported.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ProcessRouteMessage
+(
+    const struct nlmsghdr* hdrPtr   ///< [IN] Notification
+)
+{
+    const struct rtmsg* rtPtr = NLMSG_DATA(hdrPtr);
+    const struct rtattr* rtaPtr;
+    int len = RTM_PAYLOAD(hdrPtr);
+    uint32_t table = rtPtr->rtm_table;
+    int ifIndex = 0;
+
+    for (rtaPtr = RTM_RTA(rtPtr); RTA_OK(rtaPtr, len); rtaPtr = RTA_NEXT(rtaPtr, len))
+    {
+        if ((RTA_OIF == rtaPtr->rta_type) && (RTA_PAYLOAD(rtaPtr) >= sizeof(int)))
+        {
+            memcpy(&ifIndex, RTA_DATA(rtaPtr), sizeof(int));
+        }
+        else if ((RTA_TABLE == rtaPtr->rta_type) && (RTA_PAYLOAD(rtaPtr) >= sizeof(uint32_t)))
+        {
+            memcpy(&table, RTA_DATA(rtaPtr), sizeof(uint32_t));
+        }
+    }
+
+    if ((RT_TABLE_MAIN != table) || (RTN_UNICAST != rtPtr->rtm_type) || (0 == ifIndex))
+    {
+        return;
+    }
+
+    ReportEvent((RTM_NEWROUTE == hdrPtr->nlmsg_type) ?
+                    DCSNETLINK_ROUTE_ADDED : DCSNETLINK_ROUTE_REMOVED,
+                ifIndex,
+                rtPtr->rtm_family);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler of the monitor socket: process all the pending notifications.
+ */
+//--------------------------------------------------------------------------------------------------
+static void MonitorHandler
+(
+    int   fd,       ///< [IN] Monitor socket
+    short events    ///< [IN] Poll events
+)
+{
+    if (!(events & POLLIN))
+    {
+        LE_ERROR("Unexpected events 0x%x on netlink socket", events);
+        return;
+    }
+
+    for (;;)
+    {
+        ssize_t len = ReceiveFromKernel(fd, MonitorBuffer, MSG_DONTWAIT);
+        struct nlmsghdr* hdrPtr;
+
+        if (-1 == len)
+        {
+            if (ENOBUFS == errno)
+            {
+                LE_WARN("Netlink notifications lost");
+                ReportEvent(DCSNETLINK_OVERRUN, 0, AF_UNSPEC);
+                continue;
+            }
+            if ((EAGAIN != errno) && (EWOULDBLOCK != errno))
+            {
+                LE_ERROR("Unable to read netlink socket: %m");
+            }
+            return;
+        }
+
+        for (hdrPtr = (struct nlmsghdr*)MonitorBuffer;
+             NLMSG_OK(hdrPtr, (size_t)len);
+             hdrPtr = NLMSG_NEXT(hdrPtr, len))
+        {
+            switch (hdrPtr->nlmsg_type)
+            {
+                case RTM_NEWLINK:
+                case RTM_DELLINK:
+                    ProcessLinkMessage(hdrPtr);
+                    break;
+
+                case RTM_NEWADDR:
+                case RTM_DELADDR:
+                    ProcessAddressMessage(hdrPtr);
+                    break;
+
+                case RTM_NEWROUTE:
+                case RTM_DELROUTE:
+                    ProcessRouteMessage(hdrPtr);
+                    break;
+
+                default:
+                    break;
+            }
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append an attribute to a netlink message.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddAttribute
+(
+    struct nlmsghdr* hdrPtr,    ///< [IN/OUT] Message
+    uint16_t         type,      ///< [IN]     Attribute type
+    const void*      dataPtr,   ///< [IN]     Attribute data
+    size_t           len        ///< [IN]     Attribute data length
+)
+{
+    struct rtattr* rtaPtr = (struct rtattr*)((uint8_t*)hdrPtr + NLMSG_ALIGN(hdrPtr->nlmsg_len));
+
+    rtaPtr->rta_type = type;
+    rtaPtr->rta_len = RTA_LENGTH(len);
+    memcpy(RTA_DATA(rtaPtr), dataPtr, len);
+    hdrPtr->nlmsg_len = NLMSG_ALIGN(hdrPtr->nlmsg_len) + RTA_ALIGN(rtaPtr->rta_len);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse an IPv4 or IPv6 address.
+ *
+ * @return The address family, or AF_UNSPEC if the string is not an address.
+ */
+//--------------------------------------------------------------------------------------------------
+static int ParseAddress
+(
+    const char*      addrStr,   ///< [IN]  Address string
+    struct in6_addr* addrPtr    ///< [OUT] Address, large enough for both families
+)
+{
+    if (1 == inet_pton(AF_INET, addrStr, addrPtr))
+    {
+        return AF_INET;
+    }
+    if (1 == inet_pton(AF_INET6, addrStr, addrPtr))
+    {
+        return AF_INET6;
+    }
+    return AF_UNSPEC;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Build the request message of a route change.
+ *
+ * @return
+ *      - LE_OK             on success
+ *      - LE_BAD_PARAMETER  if the route is invalid
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t BuildRouteMessage
+(
+    const dcsNetlink_Route_t* routePtr,     ///< [IN]  Route change
+    dcsNetlink_RouteAction_t  action,       ///< [IN]  Action to apply
+    RouteMessage_t*           msgPtr        ///< [OUT] Request message
+)
+{
+    struct in6_addr destination;
+    struct in6_addr gateway;
+    int destinationFamily = AF_UNSPEC;
+    int gatewayFamily = AF_UNSPEC;
+    int ifIndex = if_nametoindex(routePtr->interfaceName);
+
+    if (0 == ifIndex)
+    {
+        LE_ERROR("Unknown interface '%s'", routePtr->interfaceName);
+        return LE_BAD_PARAMETER;
+    }
+
+    if ('\0' != routePtr->destination[0])
+    {
+        destinationFamily = ParseAddress(routePtr->destination, &destination);
+    }
+    if ('\0' != routePtr->gateway[0])
+    {
+        gatewayFamily = ParseAddress(routePtr->gateway, &gateway);
+    }
+
+    if (   (('\0' != routePtr->destination[0]) && (AF_UNSPEC == destinationFamily))
+        || (('\0' != routePtr->gateway[0]) && (AF_UNSPEC == gatewayFamily))
+        || ((AF_UNSPEC != destinationFamily) && (AF_UNSPEC != gatewayFamily)
+                                             && (destinationFamily != gatewayFamily))
+        || ((AF_UNSPEC == destinationFamily) && (AF_UNSPEC == gatewayFamily)))
+    {
+        LE_ERROR("Invalid route to '%s' via '%s'", routePtr->destination, routePtr->gateway);
+        return LE_BAD_PARAMETER;
+    }
+
+    memset(msgPtr, 0, sizeof(*msgPtr));
+    msgPtr->hdr.nlmsg_len = NLMSG_LENGTH(sizeof(struct rtmsg));
+    msgPtr->hdr.nlmsg_seq = ++Sequence;
+    msgPtr->hdr.nlmsg_flags = NLM_F_REQUEST | NLM_F_ACK;
+
+    switch (action)
+    {
+        case DCSNETLINK_ROUTE_ADD:
+            msgPtr->hdr.nlmsg_type = RTM_NEWROUTE;
+            msgPtr->hdr.nlmsg_flags |= NLM_F_CREATE | NLM_F_EXCL;
+            break;
+
+        case DCSNETLINK_ROUTE_REPLACE:
+            msgPtr->hdr.nlmsg_type = RTM_NEWROUTE;
+            msgPtr->hdr.nlmsg_flags |= NLM_F_CREATE | NLM_F_REPLACE;
+            break;
+
+        default:
+            msgPtr->hdr.nlmsg_type = RTM_DELROUTE;
+            break;
+    }
+
+    msgPtr->rt.rtm_family = (AF_UNSPEC != destinationFamily) ? destinationFamily : gatewayFamily;
+    msgPtr->rt.rtm_table = RT_TABLE_MAIN;
+    msgPtr->rt.rtm_protocol = RTPROT_BOOT;
+    msgPtr->rt.rtm_type = RTN_UNICAST;
+    msgPtr->rt.rtm_scope = (AF_UNSPEC != gatewayFamily) ? RT_SCOPE_UNIVERSE : RT_SCOPE_LINK;
+
+    if (AF_UNSPEC != destinationFamily)
+    {
+        size_t len = (AF_INET == destinationFamily) ? sizeof(struct in_addr) : sizeof(destination);
+
+        msgPtr->rt.rtm_dst_len = len * 8;
+        AddAttribute(&msgPtr->hdr, RTA_DST, &destination, len);
+    }
+    if (AF_UNSPEC != gatewayFamily)
+    {
+        size_t len = (AF_INET == gatewayFamily) ? sizeof(struct in_addr) : sizeof(gateway);
+
+        AddAttribute(&msgPtr->hdr, RTA_GATEWAY, &gateway, len);
+    }
+    AddAttribute(&msgPtr->hdr, RTA_OIF, &ifIndex, sizeof(ifIndex));
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send request messages in one call and collect their acknowledgements.
+ *
+ * @return
+ *      - LE_OK     if all the acknowledgements were received; errors are set in errorsPtr
+ *      - LE_FAULT  on a socket error
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t SendBatch
+(
+    RouteMessage_t* msgPtr,     ///< [IN]  Request messages
+    size_t          count,      ///< [IN]  Number of messages
+    int*            errorsPtr   ///< [OUT] Kernel result of each message, 0 or a negative errno
+)
+{
+    struct sockaddr_nl kernel = { .nl_family = AF_NETLINK };
+    struct iovec iov[DCSNETLINK_MAX_ROUTES];
+    struct msghdr msg;
+    uint32_t firstSeq = msgPtr[0].hdr.nlmsg_seq;
+    size_t pending = count;
+    size_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        iov[i].iov_base = &msgPtr[i];
+        iov[i].iov_len = msgPtr[i].hdr.nlmsg_len;
+        errorsPtr[i] = -ETIMEDOUT;
+    }
+
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_name = &kernel;
+    msg.msg_namelen = sizeof(kernel);
+    msg.msg_iov = iov;
+    msg.msg_iovlen = count;
+
+    if (-1 == sendmsg(RequestFd, &msg, 0))
+    {
+        LE_ERROR("Unable to send route changes: %m");
+        return LE_FAULT;
+    }
+
+    while (pending > 0)
+    {
+        ssize_t len = ReceiveFromKernel(RequestFd, RequestBuffer, 0);
+        struct nlmsghdr* hdrPtr;
+
+        if (-1 == len)
+        {
+            LE_ERROR("No acknowledgement of route changes: %m");
+            return LE_FAULT;
+        }
+
+        for (hdrPtr = (struct nlmsghdr*)RequestBuffer;
+             NLMSG_OK(hdrPtr, (size_t)len);
+             hdrPtr = NLMSG_NEXT(hdrPtr, len))
+        {
+            uint32_t index = hdrPtr->nlmsg_seq - firstSeq;
+
+            if ((NLMSG_ERROR != hdrPtr->nlmsg_type) || (index >= count))
+            {
+                // Late acknowledgement of a previous batch
+                continue;
+            }
+
+            errorsPtr[index] = ((struct nlmsgerr*)NLMSG_DATA(hdrPtr))->error;
+            pending--;
+        }
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open the netlink sockets and start monitoring the kernel notifications from the calling thread.
+ *
+ * @return
+ *      - LE_OK             on success
+ *      - LE_UNSUPPORTED    if routing netlink is not available
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t dcsNetlink_Init
+(
+    dcsNetlink_EventHandlerFunc_t handlerFunc,  ///< [IN] Notification handler
+    void*                         contextPtr    ///< [IN] Context given to the handler
+)
+{
+    struct timeval timeout = { .tv_sec = ACK_TIMEOUT_SEC };
+
+    LE_ASSERT(-1 == MonitorFd);
+
+    MonitorFd = OpenSocket(MONITOR_GROUPS, SOCK_NONBLOCK);
+    if (-1 == MonitorFd)
+    {
+        return LE_UNSUPPORTED;
+    }
+
+    RequestFd = OpenSocket(0, 0);
+    if (   (-1 == RequestFd)
+        || (-1 == setsockopt(RequestFd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout))))
+    {
+        if (-1 != RequestFd)
+        {
+            close(RequestFd);
+            RequestFd = -1;
+        }
+        close(MonitorFd);
+        MonitorFd = -1;
+        return LE_UNSUPPORTED;
+    }
+
+    EventHandler = handlerFunc;
+    EventContextPtr = contextPtr;
+
+    le_fdMonitor_Create("dcsNetlink", MonitorFd, MonitorHandler, POLLIN);
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Apply a batch of route changes. Either all the changes are applied, or none: the changes
+ * committed before a failure are reverted. A replaced route cannot be restored, so the reverted
+ * replacement leaves no route to its destination.
+ *
+ * @return
+ *      - LE_OK             on success
+ *      - LE_BAD_PARAMETER  if a route is invalid
+ *      - LE_UNSUPPORTED    if dcsNetlink_Init() did not succeed
+ *      - LE_FAULT          if the kernel rejected a change
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t dcsNetlink_ApplyRoutes
+(
+    const dcsNetlink_Route_t* routesPtr,    ///< [IN] Route changes
+    size_t                    count         ///< [IN] Number of changes, up to DCSNETLINK_MAX_ROUTES
+)
+{
+    RouteMessage_t msg[DCSNETLINK_MAX_ROUTES];
+    int errors[DCSNETLINK_MAX_ROUTES];
+    bool applied[DCSNETLINK_MAX_ROUTES];
+    size_t undoCount = 0;
+    le_result_t result = LE_OK;
+    size_t i;
+
+    if (-1 == RequestFd)
+    {
+        return LE_UNSUPPORTED;
+    }
+    if ((0 == count) || (count > DCSNETLINK_MAX_ROUTES))
+    {
+        return (0 == count) ? LE_OK : LE_BAD_PARAMETER;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        if (LE_OK != BuildRouteMessage(&routesPtr[i], routesPtr[i].action, &msg[i]))
+        {
+            return LE_BAD_PARAMETER;
+        }
+    }
+
+    if (LE_OK != SendBatch(msg, count, errors))
+    {
+        return LE_FAULT;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        // An existing route is not owned by this batch, and must not be deleted on revert
+        if ((DCSNETLINK_ROUTE_ADD == routesPtr[i].action) && (-EEXIST == errors[i]))
+        {
+            errors[i] = 0;
+            applied[i] = false;
+            continue;
+        }
+
+        applied[i] = (0 == errors[i]);
+        if (!applied[i])
+        {
+            LE_ERROR("Action %d on route to '%s' via '%s' on '%s' rejected: %s",
+                     routesPtr[i].action, routesPtr[i].destination, routesPtr[i].gateway,
+                     routesPtr[i].interfaceName, strerror(-errors[i]));
+            result = LE_FAULT;
+        }
+    }
+
+    if (LE_OK == result)
+    {
+        return LE_OK;
+    }
+
+    // Revert the committed changes, newest first
+    for (i = count; i-- > 0;)
+    {
+        if (applied[i])
+        {
+            dcsNetlink_RouteAction_t undo = (DCSNETLINK_ROUTE_DELETE == routesPtr[i].action) ?
+                                            DCSNETLINK_ROUTE_ADD : DCSNETLINK_ROUTE_DELETE;
+
+            BuildRouteMessage(&routesPtr[i], undo, &msg[undoCount++]);
+        }
+    }
+
+    if ((undoCount > 0) && (LE_OK == SendBatch(msg, undoCount, errors)))
+    {
+        for (i = 0; i < undoCount; i++)
+        {
+            if ((0 != errors[i]) && (-ESRCH != errors[i]))
+            {
+                LE_WARN("Unable to revert route change: %s", strerror(-errors[i]));
+            }
+        }
+    }
+
+    return LE_FAULT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether an interface has a global IPv4 or IPv6 address.
+ *
+ * @return True if the interface has an address.
+ */
+//--------------------------------------------------------------------------------------------------
+bool dcsNetlink_HasAddress
+(
+    const char* interfaceNamePtr    ///< [IN] Interface name
+)
+{
+    struct ifaddrs* listPtr;
+    struct ifaddrs* ifaPtr;
+    bool found = false;
+
+    if (-1 == getifaddrs(&listPtr))
+    {
+        LE_WARN("Unable to read interface addresses: %m");
+        return false;
+    }
+
+    for (ifaPtr = listPtr; (NULL != ifaPtr) && !found; ifaPtr = ifaPtr->ifa_next)
+    {
+        if ((NULL == ifaPtr->ifa_addr) || (0 != strcmp(ifaPtr->ifa_name, interfaceNamePtr)))
+        {
+            continue;
+        }
+
+        if (AF_INET == ifaPtr->ifa_addr->sa_family)
+        {
+            found = true;
+        }
+        else if (AF_INET6 == ifaPtr->ifa_addr->sa_family)
+        {
+            const struct in6_addr* addrPtr = &((struct sockaddr_in6*)ifaPtr->ifa_addr)->sin6_addr;
+
+            found = !IN6_IS_ADDR_LINKLOCAL(addrPtr) && !IN6_IS_ADDR_LOOPBACK(addrPtr);
+        }
+    }
+
+    freeifaddrs(listPtr);
+
+    return found;
+}
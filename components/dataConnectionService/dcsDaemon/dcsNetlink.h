@@ -0,0 +1,148 @@
+/** @file dcsNetlink.h
+ *
+ * Routing netlink interface of the Data Connection Service.
+ *
+ * The monitor listens to the link, address and route notifications of the kernel, so that the data
+ * connection is configured as soon as the interface gets its address instead of after a fixed
+ * delay. The applier sends a batch of route changes in a single netlink transaction and reverts
+ * the changes already committed when one of them is rejected.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#ifndef LEGATO_DCSNETLINK_INCLUDE_GUARD
+#define LEGATO_DCSNETLINK_INCLUDE_GUARD
+
+#include <net/if.h>
+#include <netinet/in.h>
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of routes of a batch.
+ */
+//--------------------------------------------------------------------------------------------------
+#define DCSNETLINK_MAX_ROUTES       8
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum length of an address string, including the null terminator.
+ */
+//--------------------------------------------------------------------------------------------------
+#define DCSNETLINK_ADDR_MAX_BYTES   INET6_ADDRSTRLEN
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Kernel notifications.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    DCSNETLINK_LINK_UP,             ///< Interface is up and running
+    DCSNETLINK_LINK_DOWN,           ///< Interface is down or has no carrier
+    DCSNETLINK_ADDRESS_ADDED,       ///< Global address added to the interface
+    DCSNETLINK_ADDRESS_REMOVED,     ///< Global address removed from the interface
+    DCSNETLINK_ROUTE_ADDED,         ///< Route through the interface added to the main table
+    DCSNETLINK_ROUTE_REMOVED,       ///< Route through the interface removed from the main table
+    DCSNETLINK_OVERRUN              ///< Notifications were lost, the state must be read again
+}
+dcsNetlink_EventType_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Kernel notification data.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    dcsNetlink_EventType_t type;                    ///< Notification type
+    char                   interfaceName[IF_NAMESIZE]; ///< Interface, empty for an overrun
+    int                    family;                  ///< AF_INET or AF_INET6 for addresses, routes
+}
+dcsNetlink_Event_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler of the kernel notifications.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef void (*dcsNetlink_EventHandlerFunc_t)
+(
+    const dcsNetlink_Event_t* eventPtr,     ///< [IN] Notification
+    void*                     contextPtr    ///< [IN] Context given at initialization
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Route actions.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    DCSNETLINK_ROUTE_ADD,           ///< Add a route, an existing identical route is kept
+    DCSNETLINK_ROUTE_REPLACE,       ///< Add a route or replace the route to the same destination
+    DCSNETLINK_ROUTE_DELETE         ///< Delete a route
+}
+dcsNetlink_RouteAction_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Route change. The address family is the one of the destination, or of the gateway for a default
+ * route.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    dcsNetlink_RouteAction_t action;                            ///< Action
+    char destination[DCSNETLINK_ADDR_MAX_BYTES];                ///< Host, empty for default route
+    char gateway[DCSNETLINK_ADDR_MAX_BYTES];                    ///< Gateway, empty for link route
+    char interfaceName[IF_NAMESIZE];                            ///< Output interface
+}
+dcsNetlink_Route_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open the netlink sockets and start monitoring the kernel notifications from the calling thread.
+ *
+ * @return
+ *      - LE_OK             on success
+ *      - LE_UNSUPPORTED    if routing netlink is not available
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t dcsNetlink_Init
+(
+    dcsNetlink_EventHandlerFunc_t handlerFunc,  ///< [IN] Notification handler
+    void*                         contextPtr    ///< [IN] Context given to the handler
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Apply a batch of route changes. Either all the changes are applied, or none: the changes
+ * committed before a failure are reverted. A replaced route cannot be restored, so the reverted
+ * replacement leaves no route to its destination.
+ *
+ * @return
+ *      - LE_OK             on success
+ *      - LE_BAD_PARAMETER  if a route is invalid
+ *      - LE_UNSUPPORTED    if dcsNetlink_Init() did not succeed
+ *      - LE_FAULT          if the kernel rejected a change
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t dcsNetlink_ApplyRoutes
+(
+    const dcsNetlink_Route_t* routesPtr,    ///< [IN] Route changes
+    size_t                    count         ///< [IN] Number of changes, up to DCSNETLINK_MAX_ROUTES
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether an interface has a global IPv4 or IPv6 address.
+ *
+ * @return True if the interface has an address.
+ */
+//--------------------------------------------------------------------------------------------------
+bool dcsNetlink_HasAddress
+(
+    const char* interfaceNamePtr    ///< [IN] Interface name
+);
+
+#endif // LEGATO_DCSNETLINK_INCLUDE_GUARD
@@ -38,6 +38,7 @@
 #include "le_print.h"
 #include "pa_mdc.h"
 #include "pa_dcs.h"
+#include "dcsNetlink.h"
 
 #include "watchdogChain.h"
 
@@ -153,6 +154,14 @@
 #define RETRY_TECH_BACKOFF_INIT 1                // init backoff: 1 sec
 #define RETRY_TECH_BACKOFF_MAX (60 * 60 * 6)     // max backoff: 6 hrs
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum time to wait for the DHCP client to set the address of the mobile data interface before
+ * configuring the routes and DNS, in seconds.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SESSION_SETUP_TIMEOUT   3
+
 //--------------------------------------------------------------------------------------------------
 // Data structures
 //--------------------------------------------------------------------------------------------------
@@ -184,6 +193,21 @@ typedef struct
 }
 TechRecord_t;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Phases of the mobile data connection set up, used to report the connection latency
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    CONNECT_PHASE_SESSION,      ///< Data session started
+    CONNECT_PHASE_ADDRESS,      ///< Address set on the interface
+    CONNECT_PHASE_ROUTES,       ///< Routes applied
+    CONNECT_PHASE_DNS,          ///< DNS configuration applied
+    CONNECT_PHASE_MAX
+}
+ConnectPhase_t;
+
 //--------------------------------------------------------------------------------------------------
 // Static declarations
 //--------------------------------------------------------------------------------------------------
@@ -194,6 +218,7 @@ TechRecord_t;
  */
 //--------------------------------------------------------------------------------------------------
 static void ConnectionStatusHandler(le_data_Technology_t technology, bool connected);
+static void CancelSessionSetup(void);
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -384,6 +409,42 @@ static le_data_Technology_t CurrentTech = LE_DATA_MAX;
 //--------------------------------------------------------------------------------------------------
 static bool DefaultRouteStatus = true;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Routing netlink availability. When available, the routes are applied through netlink and the
+ * mobile data connection is configured upon the kernel notifications; otherwise the platform
+ * adaptor is used and the DHCP client is given a fixed delay.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool NetlinkAvailable = false;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mobile data connection set up: waiting for the address of the interface, upper bounded by the
+ * SessionSetupTimer. The connected notification received in the meantime is deferred until the
+ * routes and DNS are configured.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool SessionSetupPending = false;
+static bool ConnectedNotificationPending = false;
+static le_timer_Ref_t SessionSetupTimer = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * DNS configuration to retry, upon the kernel notifications or the SetDNSConfigTimer expiry
+ */
+//--------------------------------------------------------------------------------------------------
+static bool DnsConfigPending = false;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Connection latency: start of the connection request, and time elapsed since then at the end of
+ * each phase, in milliseconds
+ */
+//--------------------------------------------------------------------------------------------------
+static le_clk_Time_t ConnectStartTime;
+static uint32_t ConnectPhaseMs[CONNECT_PHASE_MAX];
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Initialize the list of technologies to use with the default values
@@ -731,6 +792,19 @@ static void DataSessionStateHandler
     le_timer_Restart(DelayRequestTimer);
     #endif
 
+    // While the connection is set up, the connected notification is deferred until the routes and
+    // DNS are configured
+    if (SessionSetupPending)
+    {
+        if (LE_MDC_CONNECTED == connectionStatus)
+        {
+            ConnectedNotificationPending = true;
+            return;
+        }
+
+        CancelSessionSetup();
+    }
+
     // Update connection status and send notification to registered applications
     IsConnected = (connectionStatus == LE_MDC_CONNECTED) ? true : false;
     SendConnStateEvent(IsConnected);
@@ -1087,6 +1161,120 @@ static le_result_t LoadSelectedTechProfile
     return result;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record the end of a connection phase
+ */
+//--------------------------------------------------------------------------------------------------
+static void RecordConnectPhase
+(
+    ConnectPhase_t phase    ///< [IN] Completed phase
+)
+{
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), ConnectStartTime);
+
+    ConnectPhaseMs[phase] = elapsed.sec * 1000 + elapsed.usec / 1000;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Report the latency of each phase of the connection set up
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReportConnectLatency
+(
+    void
+)
+{
+    uint32_t sessionMs = ConnectPhaseMs[CONNECT_PHASE_SESSION];
+    uint32_t addressMs = ConnectPhaseMs[CONNECT_PHASE_ADDRESS] - sessionMs;
+    uint32_t routesMs = ConnectPhaseMs[CONNECT_PHASE_ROUTES] -
+                        ConnectPhaseMs[CONNECT_PHASE_ADDRESS];
+
+    if (DnsConfigPending)
+    {
+        LE_INFO("Connection set up in %u ms: session %u ms, address %u ms, routes %u ms, "
+                "DNS pending", ConnectPhaseMs[CONNECT_PHASE_ROUTES], sessionMs, addressMs,
+                routesMs);
+    }
+    else
+    {
+        LE_INFO("Connection set up in %u ms: session %u ms, address %u ms, routes %u ms, "
+                "DNS %u ms", ConnectPhaseMs[CONNECT_PHASE_DNS], sessionMs, addressMs, routesMs,
+                ConnectPhaseMs[CONNECT_PHASE_DNS] - ConnectPhaseMs[CONNECT_PHASE_ROUTES]);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fill a route change
+ */
+//--------------------------------------------------------------------------------------------------
+static void FillRoute
+(
+    dcsNetlink_Route_t*      routePtr,          ///< [OUT] Route change
+    dcsNetlink_RouteAction_t action,            ///< [IN] Action
+    const char*              destinationPtr,    ///< [IN] Destination, empty for the default route
+    const char*              gatewayPtr,        ///< [IN] Gateway, empty for a link route
+    const char*              interfacePtr       ///< [IN] Interface name
+)
+{
+    routePtr->action = action;
+    le_utf8_Copy(routePtr->destination, destinationPtr, sizeof(routePtr->destination), NULL);
+    le_utf8_Copy(routePtr->gateway, gatewayPtr, sizeof(routePtr->gateway), NULL);
+    le_utf8_Copy(routePtr->interfaceName, interfacePtr, sizeof(routePtr->interfaceName), NULL);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Apply a batch of route changes, through netlink if available or else through the platform
+ * adaptor. Only netlink reverts the batch when one of the changes fails.
+ *
+ * @return
+ *      LE_FAULT        Function failed
+ *      LE_OK           Function succeed
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ApplyRoutes
+(
+    const dcsNetlink_Route_t* routesPtr,    ///< [IN] Route changes
+    size_t                    count         ///< [IN] Number of changes
+)
+{
+    size_t i;
+
+    if (NetlinkAvailable)
+    {
+        return (LE_OK == dcsNetlink_ApplyRoutes(routesPtr, count)) ? LE_OK : LE_FAULT;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        le_result_t result;
+
+        if ('\0' == routesPtr[i].destination[0])
+        {
+            result = pa_dcs_SetDefaultGateway(routesPtr[i].interfaceName,
+                                              routesPtr[i].gateway,
+                                              (NULL != strchr(routesPtr[i].gateway, ':')));
+        }
+        else
+        {
+            result = pa_dcs_ChangeRoute((DCSNETLINK_ROUTE_DELETE == routesPtr[i].action) ?
+                                            PA_DCS_ROUTE_DELETE : PA_DCS_ROUTE_ADD,
+                                        routesPtr[i].destination,
+                                        routesPtr[i].interfaceName);
+        }
+
+        if (LE_OK != result)
+        {
+            return result;
+        }
+    }
+
+    return LE_OK;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Restore the default gateway in the system
@@ -1101,10 +1289,17 @@ static le_result_t RestoreDefaultGateway
     void
 )
 {
-    // Restore backed up interface and gateway
-    le_result_t result = pa_dcs_SetDefaultGateway(InterfaceDataBackup.defaultInterface,
-                                                  InterfaceDataBackup.defaultGateway,
-                                                  false);
+    dcsNetlink_Route_t route;
+    le_result_t result = LE_OK;
+
+    // Restore backed up interface and gateway. With netlink, there is nothing to restore if no
+    // default gateway was set.
+    if ((!NetlinkAvailable) || ('\0' != InterfaceDataBackup.defaultInterface[0]))
+    {
+        FillRoute(&route, DCSNETLINK_ROUTE_REPLACE, "", InterfaceDataBackup.defaultGateway,
+                  InterfaceDataBackup.defaultInterface);
+        result = ApplyRoutes(&route, 1);
+    }
 
     // Delete backed up parameters
     memset(InterfaceDataBackup.defaultInterface, '\0',
@@ -1117,7 +1312,7 @@ static le_result_t RestoreDefaultGateway
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Set the default route for a profile
+ * Set the default route for a profile. The IPv6 and IPv4 default routes are applied in one batch.
  *
  * return
  *      LE_FAULT        Function failed
@@ -1129,10 +1324,11 @@ static le_result_t SetRouteConfiguration
     le_mdc_ProfileRef_t profileRef  ///< [IN] Modem data connection profile reference
 )
 {
-    bool isIpv6 = true;
     char ipv6GatewayAddr[LE_MDC_IPV6_ADDR_MAX_BYTES] = {0};
     char ipv4GatewayAddr[LE_MDC_IPV4_ADDR_MAX_BYTES] = {0};
     char interface[LE_MDC_INTERFACE_NAME_MAX_BYTES] = {0};
+    dcsNetlink_Route_t routes[2];
+    size_t count = 0;
 
     if (!(le_mdc_IsIPv6(profileRef) || le_mdc_IsIPv4(profileRef)))
     {
@@ -1140,6 +1336,12 @@ static le_result_t SetRouteConfiguration
         return LE_FAULT;
     }
 
+    if (LE_OK != le_mdc_GetInterfaceName(profileRef, interface, sizeof(interface)))
+    {
+        LE_ERROR("le_mdc_GetInterfaceName failed");
+        return LE_FAULT;
+    }
+
     if (le_mdc_IsIPv6(profileRef))
     {
         if (LE_OK != le_mdc_GetIPv6GatewayAddress(profileRef,
@@ -1150,23 +1352,12 @@ static le_result_t SetRouteConfiguration
             return LE_FAULT;
         }
 
-        if (LE_OK != le_mdc_GetInterfaceName(profileRef, interface, sizeof(interface)))
-        {
-            LE_ERROR("le_mdc_GetInterfaceName failed");
-            return LE_FAULT;
-        }
-
         // Set the default ipv6 gateway retrieved from modem
-        if (LE_OK != pa_dcs_SetDefaultGateway(interface, ipv6GatewayAddr, isIpv6))
-        {
-            LE_ERROR("SetDefaultGateway for ipv6 gateway failed");
-            return LE_FAULT;
-        }
+        FillRoute(&routes[count++], DCSNETLINK_ROUTE_REPLACE, "", ipv6GatewayAddr, interface);
     }
 
     if (le_mdc_IsIPv4(profileRef))
     {
-
         if (LE_OK != le_mdc_GetIPv4GatewayAddress(profileRef,
                                                   ipv4GatewayAddr,
                                                   sizeof(ipv4GatewayAddr)))
@@ -1175,18 +1366,14 @@ static le_result_t SetRouteConfiguration
             return LE_FAULT;
         }
 
-        if (LE_OK != le_mdc_GetInterfaceName(profileRef, interface, sizeof(interface)))
-        {
-            LE_ERROR("le_mdc_GetInterfaceName failed");
-            return LE_FAULT;
-        }
-
         // Set the default ipv4 gateway retrieved from modem
-        if (LE_OK != pa_dcs_SetDefaultGateway(interface, ipv4GatewayAddr, !(isIpv6)))
-        {
-            LE_ERROR("SetDefaultGateway for ipv4 gateway failed");
-            return LE_FAULT;
-        }
+        FillRoute(&routes[count++], DCSNETLINK_ROUTE_REPLACE, "", ipv4GatewayAddr, interface);
+    }
+
+    if (LE_OK != ApplyRoutes(routes, count))
+    {
+        LE_ERROR("SetDefaultGateway failed");
+        return LE_FAULT;
     }
 
     return LE_OK;
@@ -1196,6 +1383,10 @@ static le_result_t SetRouteConfiguration
 /**
  * Set the DNS configuration for a profile
  *
+ * All the DNS addresses are retrieved before anything is applied, and the DNS routes are applied
+ * in one batch before the name servers are written, so that the resolver never uses a name server
+ * it has no route to.
+ *
  * @return
  *      LE_FAULT        Function failed
  *      LE_OK           Function succeed
@@ -1207,78 +1398,101 @@ static le_result_t SetDnsConfiguration
     bool addDnsRoutes                   ///< [IN] Add routes for DNS
 )
 {
-    char dns1Addr[LE_MDC_IPV6_ADDR_MAX_BYTES] = {0};
-    char dns2Addr[LE_MDC_IPV6_ADDR_MAX_BYTES] = {0};
+    char dnsIpv4Addr[2][LE_MDC_IPV6_ADDR_MAX_BYTES] = {{0}};
+    char dnsIpv6Addr[2][LE_MDC_IPV6_ADDR_MAX_BYTES] = {{0}};
+    char interface[LE_MDC_INTERFACE_NAME_MAX_BYTES] = {0};
+    bool isIpv4 = le_mdc_IsIPv4(profileRef);
+    bool isIpv6 = le_mdc_IsIPv6(profileRef);
+    int i;
 
-    if (le_mdc_IsIPv4(profileRef))
+    if (isIpv4)
     {
         if (LE_OK != le_mdc_GetIPv4DNSAddresses(profileRef,
-                                                dns1Addr, sizeof(dns1Addr),
-                                                dns2Addr, sizeof(dns2Addr)))
+                                                dnsIpv4Addr[0], sizeof(dnsIpv4Addr[0]),
+                                                dnsIpv4Addr[1], sizeof(dnsIpv4Addr[1])))
         {
             LE_ERROR("IPv4: le_mdc_GetDNSAddresses failed");
             return LE_FAULT;
         }
+    }
 
-        if (LE_OK != pa_dcs_SetDnsNameServers(dns1Addr, dns2Addr))
+    if (isIpv6)
+    {
+        if (LE_OK != le_mdc_GetIPv6DNSAddresses(profileRef,
+                                                dnsIpv6Addr[0], sizeof(dnsIpv6Addr[0]),
+                                                dnsIpv6Addr[1], sizeof(dnsIpv6Addr[1])))
         {
-            LE_ERROR("IPv4: Could not write in resolv file");
+            LE_ERROR("IPv6: le_mdc_GetDNSAddresses failed");
             return LE_FAULT;
         }
+    }
 
-        le_utf8_Copy(InterfaceDataBackup.newDnsIPv4[0], dns1Addr,
-                     sizeof(InterfaceDataBackup.newDnsIPv4[0]), NULL);
-
-        le_utf8_Copy(InterfaceDataBackup.newDnsIPv4[1], dns2Addr,
-                     sizeof(InterfaceDataBackup.newDnsIPv4[1]), NULL);
+    // Add the DNS routes if necessary. The platform adaptor only supports IPv4 routes.
+    if (addDnsRoutes)
+    {
+        dcsNetlink_Route_t routes[4];
+        size_t count = 0;
 
-        // Add the DNS routes if necessary
-        if (addDnsRoutes)
+        if (LE_OK != le_mdc_GetInterfaceName(profileRef, interface, sizeof(interface)))
+        {
+            LE_ERROR("le_mdc_GetInterfaceName failed");
+        }
+        else
         {
-            if (   (LE_OK != le_data_AddRoute(dns1Addr))
-                || (LE_OK != le_data_AddRoute(dns2Addr)))
+            for (i = 0; i < 2; i++)
+            {
+                if (isIpv4 && ('\0' != dnsIpv4Addr[i][0]))
+                {
+                    FillRoute(&routes[count++], DCSNETLINK_ROUTE_ADD,
+                              dnsIpv4Addr[i], "", interface);
+                }
+                if (isIpv6 && NetlinkAvailable && ('\0' != dnsIpv6Addr[i][0]))
+                {
+                    FillRoute(&routes[count++], DCSNETLINK_ROUTE_ADD,
+                              dnsIpv6Addr[i], "", interface);
+                }
+            }
+
+            if (LE_OK != ApplyRoutes(routes, count))
             {
-                LE_ERROR("IPv4: Could not add DNS routes");
+                LE_ERROR("Could not add DNS routes");
             }
         }
     }
+
+    if (isIpv4)
+    {
+        if (LE_OK != pa_dcs_SetDnsNameServers(dnsIpv4Addr[0], dnsIpv4Addr[1]))
+        {
+            LE_ERROR("IPv4: Could not write in resolv file");
+            return LE_FAULT;
+        }
+
+        le_utf8_Copy(InterfaceDataBackup.newDnsIPv4[0], dnsIpv4Addr[0],
+                     sizeof(InterfaceDataBackup.newDnsIPv4[0]), NULL);
+
+        le_utf8_Copy(InterfaceDataBackup.newDnsIPv4[1], dnsIpv4Addr[1],
+                     sizeof(InterfaceDataBackup.newDnsIPv4[1]), NULL);
+    }
     else
     {
         InterfaceDataBackup.newDnsIPv4[0][0] = '\0';
         InterfaceDataBackup.newDnsIPv4[1][0] = '\0';
     }
 
-    if (le_mdc_IsIPv6(profileRef))
+    if (isIpv6)
     {
-        if (LE_OK != le_mdc_GetIPv6DNSAddresses(profileRef,
-                                                dns1Addr, sizeof(dns1Addr),
-                                                dns2Addr, sizeof(dns2Addr)))
-        {
-            LE_ERROR("IPv6: le_mdc_GetDNSAddresses failed");
-            return LE_FAULT;
-        }
-
-        if (LE_OK != pa_dcs_SetDnsNameServers(dns1Addr, dns2Addr))
+        if (LE_OK != pa_dcs_SetDnsNameServers(dnsIpv6Addr[0], dnsIpv6Addr[1]))
         {
             LE_ERROR("IPv6: Could not write in resolv file");
             return LE_FAULT;
         }
 
-        le_utf8_Copy(InterfaceDataBackup.newDnsIPv6[0], dns1Addr,
+        le_utf8_Copy(InterfaceDataBackup.newDnsIPv6[0], dnsIpv6Addr[0],
                      sizeof(InterfaceDataBackup.newDnsIPv6[0]), NULL);
 
-        le_utf8_Copy(InterfaceDataBackup.newDnsIPv6[1], dns2Addr,
+        le_utf8_Copy(InterfaceDataBackup.newDnsIPv6[1], dnsIpv6Addr[1],
                      sizeof(InterfaceDataBackup.newDnsIPv6[1]), NULL);
-
-        // Add the DNS routes if necessary
-        if (addDnsRoutes)
-        {
-            if (   (LE_OK != le_data_AddRoute(dns1Addr))
-                || (LE_OK != le_data_AddRoute(dns2Addr)))
-            {
-                LE_ERROR("IPv6: Could not add DNS routes");
-            }
-        }
     }
     else
     {
@@ -1311,15 +1525,18 @@ static le_result_t SetDefaultRouteAndDns
         if (LE_OK != SetRouteConfiguration(MobileProfileRef))
         {
             LE_ERROR("Failed to set configuration route");
+            RestoreDefaultGateway();
             return LE_FAULT;
         }
     }
+    RecordConnectPhase(CONNECT_PHASE_ROUTES);
 
     // Set the DNS configuration in all cases and add the DNS routes
     // if the default route is not set
     if (LE_OK != SetDnsConfiguration(MobileProfileRef, !(setDefaultRoute)))
     {
         LE_INFO("Failed to set DNS configuration. Retry later");
+        DnsConfigPending = true;
 
         if (!le_timer_IsRunning(SetDNSConfigTimer))
         {
@@ -1333,6 +1550,8 @@ static le_result_t SetDefaultRouteAndDns
     else
     {
         LE_INFO("DNS configuration is set successfully");
+        DnsConfigPending = false;
+        RecordConnectPhase(CONNECT_PHASE_DNS);
     }
 
     return LE_OK;
@@ -1340,21 +1559,21 @@ static le_result_t SetDefaultRouteAndDns
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Set DNS Configuration Service Timer Handler.
- * When the timer expires, this handler attempts to set DNS configuration.
+ * Retry to set the DNS configuration, if still pending and the data session is connected.
  */
 //--------------------------------------------------------------------------------------------------
-static void SetDNSConfigTimerHandler
+static void RetryDnsConfiguration
 (
-    le_timer_Ref_t timerRef    ///< [IN] Timer used to ensure DNS address is present.
+    void
 )
 {
     le_mdc_ConState_t  sessionState;
     le_result_t result;
 
-    if(0 == RequestCount)
+    if ((!DnsConfigPending) || (0 == RequestCount))
     {
         // Release has been requested in the meantime, We must cancel the Request command process.
+        DnsConfigPending = false;
         return;
     }
 
@@ -1367,11 +1586,189 @@ static void SetDNSConfigTimerHandler
         }
         else
         {
-            LE_INFO("DNS configuration is set successfully");
+            DnsConfigPending = false;
+            RecordConnectPhase(CONNECT_PHASE_DNS);
+            LE_INFO("DNS configuration is set successfully, %u ms after the connection request",
+                    ConnectPhaseMs[CONNECT_PHASE_DNS]);
+
+            if (le_timer_IsRunning(SetDNSConfigTimer))
+            {
+                le_timer_Stop(SetDNSConfigTimer);
+            }
         }
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set DNS Configuration Service Timer Handler.
+ * When the timer expires, this handler attempts to set DNS configuration.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SetDNSConfigTimerHandler
+(
+    le_timer_Ref_t timerRef    ///< [IN] Timer used to ensure DNS address is present.
+)
+{
+    RetryDnsConfiguration();
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Cancel the set up of the mobile data connection
+ */
+//--------------------------------------------------------------------------------------------------
+static void CancelSessionSetup
+(
+    void
+)
+{
+    SessionSetupPending = false;
+    ConnectedNotificationPending = false;
+
+    if (le_timer_IsRunning(SessionSetupTimer))
+    {
+        le_timer_Stop(SessionSetupTimer);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Complete the set up of the mobile data connection: configure the routes and DNS, then send the
+ * connected notification deferred in the meantime.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CompleteSessionSetup
+(
+    void
+)
+{
+    bool notifyConnected = ConnectedNotificationPending;
+
+    CancelSessionSetup();
+
+    if (0 == RequestCount)
+    {
+        // Release has been requested in the meantime
+        return;
+    }
+
+    RecordConnectPhase(CONNECT_PHASE_ADDRESS);
+
+    // Set the default route (if necessary) and the DNS
+    if (LE_OK != SetDefaultRouteAndDns(DefaultRouteStatus))
+    {
+        // Impossible to use this technology, try the next one
+        ConnectionStatusHandler(LE_DATA_CELLULAR, false);
+    }
+    else
+    {
+        ReportConnectLatency();
+    }
+
+    if (notifyConnected)
+    {
+        IsConnected = true;
+        SendConnStateEvent(IsConnected);
+        ConnectionStatusHandler(LE_DATA_CELLULAR, IsConnected);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start the set up of the mobile data connection. The routes and DNS are configured as soon as the
+ * interface has an address, or when the SessionSetupTimer expires. Without routing netlink, the
+ * address is not monitored and the DHCP client is given the whole SessionSetupTimer delay.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StartSessionSetup
+(
+    void
+)
+{
+    char interface[LE_MDC_INTERFACE_NAME_MAX_BYTES] = {0};
+
+    SessionSetupPending = true;
+
+    if (   (NetlinkAvailable)
+        && (LE_OK == le_mdc_GetInterfaceName(MobileProfileRef, interface, sizeof(interface)))
+        && (dcsNetlink_HasAddress(interface)))
+    {
+        CompleteSessionSetup();
+        return;
+    }
+
+    le_timer_Restart(SessionSetupTimer);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Session set up timer handler: the DHCP client did not set the address in time, configure the
+ * routes and DNS anyway.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SessionSetupTimerHandler
+(
+    le_timer_Ref_t timerRef    ///< [IN] Timer used to bound the wait for the address
+)
+{
+    LE_WARN_IF(NetlinkAvailable,
+               "No address on the data interface after %d seconds", SESSION_SETUP_TIMEOUT);
+    CompleteSessionSetup();
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Kernel notification handler: complete the pending connection set up or DNS configuration when
+ * the mobile data interface gets an address.
+ */
+//--------------------------------------------------------------------------------------------------
+static void NetlinkEventHandler
+(
+    const dcsNetlink_Event_t* eventPtr,     ///< [IN] Kernel notification
+    void*                     contextPtr    ///< [IN] Associated context pointer
+)
+{
+    char interface[LE_MDC_INTERFACE_NAME_MAX_BYTES] = {0};
+
+    if (   ((!SessionSetupPending) && (!DnsConfigPending))
+        || (LE_DATA_CELLULAR != CurrentTech)
+        || (NULL == MobileProfileRef)
+        || (LE_OK != le_mdc_GetInterfaceName(MobileProfileRef, interface, sizeof(interface))))
+    {
+        return;
+    }
+
+    if ((DCSNETLINK_OVERRUN != eventPtr->type) && (0 != strcmp(eventPtr->interfaceName, interface)))
+    {
+        return;
+    }
+
+    switch (eventPtr->type)
+    {
+        case DCSNETLINK_LINK_UP:
+        case DCSNETLINK_ADDRESS_ADDED:
+        case DCSNETLINK_OVERRUN:
+            if (!dcsNetlink_HasAddress(interface))
+            {
+                break;
+            }
+
+            if (SessionSetupPending)
+            {
+                CompleteSessionSetup();
+            }
+            else
+            {
+                RetryDnsConfiguration();
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Reset the current backoff duration of the RetryTechTimer to its init value. Stop the timer 1st
@@ -1421,28 +1818,19 @@ static void TryStartDataSession
     }
     #endif
 
+    ConnectStartTime = le_clk_GetRelativeTime();
+
     le_result_t result = le_mdc_StartSession(MobileProfileRef);
 
     // Start data session
     if (result == LE_OK)
     {
         LE_DEBUG("Data connection has been started successfully.");
+        RecordConnectPhase(CONNECT_PHASE_SESSION);
 
-        // First wait a few seconds for the default DHCP client
-        sleep(3);
-
-        // Set the default route (if necessary) and the DNS
-        if (LE_OK != SetDefaultRouteAndDns(DefaultRouteStatus))
-        {
-            // Impossible to use this technology, try the next one
-            ConnectionStatusHandler(LE_DATA_CELLULAR, false);
-        }
-        else
-        {
-            // Wait a few seconds to prevent rapid toggling of data connection
-            LE_DEBUG("Waiting a few seconds to prevent rapid toggling of data connection.");
-            sleep(5);
-        }
+        // Set the default route (if necessary) and the DNS as soon as the DHCP client sets the
+        // address
+        StartSessionSetup();
     }
     else if (result == LE_DUPLICATE)
     {
@@ -2128,6 +2516,7 @@ static le_result_t ChangeRoute
 )
 {
     char interfaceStr[LE_MDC_INTERFACE_NAME_MAX_BYTES] = {0};
+    dcsNetlink_Route_t route;
 
     // Check if the cellular technology is being used
     if (LE_DATA_CELLULAR != CurrentTech)
@@ -2151,9 +2540,13 @@ static le_result_t ChangeRoute
         return LE_FAULT;
     }
 
-    return pa_dcs_ChangeRoute(action,
-                              ipDestAddrStr,
-                              interfaceStr);
+    FillRoute(&route,
+              (PA_DCS_ROUTE_ADD == action) ? DCSNETLINK_ROUTE_ADD : DCSNETLINK_ROUTE_DELETE,
+              ipDestAddrStr,
+              "",
+              interfaceStr);
+
+    return ApplyRoutes(&route, 1);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -2848,6 +3241,25 @@ COMPONENT_INIT
     // Retrieve default gateway activation status
     DefaultRouteStatus = GetDefaultRouteStatus();
 
+    // Monitor the kernel routing notifications, or fall back to the platform adaptor
+    NetlinkAvailable = (LE_OK == dcsNetlink_Init(NetlinkEventHandler, NULL));
+    if (!NetlinkAvailable)
+    {
+        LE_INFO("Routing netlink not available, using the platform adaptor");
+    }
+
+    // Set a one-shot timer bounding the wait for the address of the data interface.
+    SessionSetupTimer = le_timer_Create("SessionSetupTimer");
+    le_clk_Time_t setupInterval = {SESSION_SETUP_TIMEOUT, 0};
+
+    if (   (LE_OK != le_timer_SetHandler(SessionSetupTimer, SessionSetupTimerHandler))
+        || (LE_OK != le_timer_SetRepeat(SessionSetupTimer, 1))    // One shot timer
+        || (LE_OK != le_timer_SetInterval(SessionSetupTimer, setupInterval))
+       )
+    {
+        LE_ERROR("Could not configure the SessionSetup timer!");
+    }
+
     // Set a timer to retry the tech
     RetryTechTimer = le_timer_Create("RetryTechTimer");
     RetryTechBackoffCurrent = RETRY_TECH_BACKOFF_INIT;
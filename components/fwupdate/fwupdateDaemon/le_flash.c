@@ -10,6 +10,11 @@
 #include "interfaces.h"
 #include "pa_fwupdate.h"
 #include "pa_flash.h"
+#include "watchdogChain.h"
+#include "fwupdate_local.h"
+
+#include <poll.h>
+#include <sys/eventfd.h>
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -18,6 +23,21 @@
 //--------------------------------------------------------------------------------------------------
 #define MAX_PARTITION_REF             18
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of block buffers of a streamed transfer: a block is programmed into or read from the
+ * flash while the next ones are filled from or drained to the client file descriptor.
+ */
+//--------------------------------------------------------------------------------------------------
+#define STREAM_BUFFER_COUNT           4
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum time without progress on the client file descriptor of a streamed transfer, in ms.
+ */
+//--------------------------------------------------------------------------------------------------
+#define STREAM_TIMEOUT_MS             (900 * 1000)
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Event ID on bad image notification.
@@ -67,6 +87,38 @@ typedef struct
 }
 Partition_t;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Block buffer of a streamed transfer.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint8_t* dataPtr;       ///< Block data
+    ssize_t  size;          ///< Data size, 0 at the end of the stream, -1 on error
+}
+StreamBuffer_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Streamed transfer between a client file descriptor and the flash. The file descriptor is served
+ * by a dedicated thread, so that the flash and the file descriptor are accessed in parallel.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    int             fd;                             ///< Client file descriptor
+    size_t          blockSize;                      ///< Data size of a block
+    StreamBuffer_t  buffers[STREAM_BUFFER_COUNT];   ///< Ring of block buffers
+    le_sem_Ref_t    freeSem;                        ///< Buffers available to the producer
+    le_sem_Ref_t    readySem;                       ///< Buffers available to the consumer
+    le_thread_Ref_t thread;                         ///< File descriptor thread
+    le_result_t     result;                         ///< Result of the file descriptor thread
+    int             abortFd;                        ///< Event waking up the thread on abort
+    bool            isAborted;                      ///< True if the flash side stopped early
+}
+Stream_t;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Memory pool for allocating partitions ref.
@@ -677,6 +729,425 @@ static void RequestInit
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a block from a partition, or from the UBI volume open on it.
+ *
+ * @return
+ *      - LE_OK            On success
+ *      - LE_FAULT         On failure
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReadBlock
+(
+    Partition_t* partPtr,           ///< [IN] Partition descriptor
+    uint32_t     blockIndex,        ///< [IN] Logical block index to be read
+    uint8_t*     readData,          ///< [OUT] Data buffer to copy the read data
+    size_t*      readDataSizePtr    ///< [INOUT] Data size to be read/data size really read
+)
+{
+    le_result_t res;
+    size_t readSize;
+
+    if (partPtr->isUbi)
+    {
+        readSize = partPtr->mtdInfo->eraseSize - (2 * partPtr->mtdInfo->writeSize);
+        if (*readDataSizePtr < readSize)
+        {
+            readSize = *readDataSizePtr;
+        }
+        res = pa_flash_ReadUbiAtBlock(partPtr->desc, blockIndex, readData, &readSize);
+        if (LE_OK != res)
+        {
+            LE_ERROR("Ubi Volume %u Partition \"%s\" MTD%d: Read failed at blockIndex %u,"
+                     " dataSize %zu: %d",
+                     partPtr->ubiVolume, partPtr->partitionName, partPtr->mtdNum, blockIndex,
+                     readSize, res);
+            res = LE_FAULT;
+        }
+        *readDataSizePtr = readSize;
+    }
+    else
+    {
+        res = pa_flash_ReadAtBlock( partPtr->desc, blockIndex, readData, *readDataSizePtr);
+        if (LE_OK != res)
+        {
+            LE_ERROR("Partition \"%s\" MTD%d: Read failed at blockIndex %u, dataSize %zu: %d",
+                     partPtr->partitionName, partPtr->mtdNum, blockIndex, *readDataSizePtr, res);
+            res = LE_FAULT;
+        }
+    }
+    return res;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Erase and write a block of a partition, or of the UBI volume open on it.
+ *
+ * @return
+ *      - LE_OK            On success
+ *      - LE_FAULT         On failure
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t WriteBlock
+(
+    Partition_t*   partPtr,         ///< [IN] Partition descriptor
+    uint32_t       blockIndex,      ///< [IN] Logical block index to be written
+    const uint8_t* writeData,       ///< [IN] Data buffer to be written
+    size_t         writeDataSize    ///< [IN] Data size to be written
+)
+{
+    le_result_t res;
+
+    if (partPtr->isUbi)
+    {
+        res = pa_flash_WriteUbiAtBlock(partPtr->desc, blockIndex,
+                                       (uint8_t*)writeData, writeDataSize, true);
+        if (LE_OK != res)
+        {
+            LE_ERROR("Ubi Volume %u Partition \"%s\" MTD%d: Write failed at blockIndex %u,"
+                     " dataSize %zu: %d",
+                     partPtr->ubiVolume, partPtr->partitionName, partPtr->mtdNum, blockIndex,
+                     writeDataSize, res);
+            res = LE_FAULT;
+        }
+    }
+    else
+    {
+        res = pa_flash_EraseBlock( partPtr->desc, blockIndex );
+        if (LE_OK != res)
+        {
+            LE_ERROR("Partition \"%s\" MTD%d: Erase failed at blockIndex %u",
+                     partPtr->partitionName, partPtr->mtdNum, blockIndex);
+            return LE_FAULT;
+        }
+        res = pa_flash_WriteAtBlock( partPtr->desc, blockIndex, (uint8_t*)writeData, writeDataSize);
+        if (LE_OK != res)
+        {
+            LE_ERROR("Partition \"%s\" MTD%d: Write failed at blockIndex %u, dataSize %zu: %d",
+                     partPtr->partitionName, partPtr->mtdNum, blockIndex, writeDataSize, res);
+            res = LE_FAULT;
+        }
+    }
+    return res;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the data size of a block: an erase block for MTD, minus the 2 header pages for UBI.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t GetBlockDataSize
+(
+    const Partition_t* partPtr      ///< [IN] Partition descriptor
+)
+{
+    if (partPtr->isUbi)
+    {
+        return partPtr->mtdInfo->eraseSize - (2 * partPtr->mtdInfo->writeSize);
+    }
+    return partPtr->mtdInfo->eraseSize;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Wait until the client file descriptor of a stream is ready.
+ *
+ * @return
+ *      - LE_OK            The file descriptor is ready
+ *      - LE_TIMEOUT       No progress during STREAM_TIMEOUT_MS
+ *      - LE_TERMINATED    The stream was aborted
+ *      - LE_FAULT         On failure
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t WaitStreamFd
+(
+    Stream_t* streamPtr,    ///< [IN] Stream
+    short     events        ///< [IN] POLLIN or POLLOUT
+)
+{
+    struct pollfd pollFds[2] =
+    {
+        { .fd = streamPtr->fd, .events = events },
+        { .fd = streamPtr->abortFd, .events = POLLIN }
+    };
+    int rc;
+
+    do
+    {
+        rc = poll(pollFds, NUM_ARRAY_MEMBERS(pollFds), STREAM_TIMEOUT_MS);
+    }
+    while ((-1 == rc) && (EINTR == errno));
+
+    if (0 == rc)
+    {
+        LE_ERROR("No progress on fd %d for %d ms", streamPtr->fd, STREAM_TIMEOUT_MS);
+        return LE_TIMEOUT;
+    }
+    if (-1 == rc)
+    {
+        LE_ERROR("poll on fd %d failed: %m", streamPtr->fd);
+        return LE_FAULT;
+    }
+    if (pollFds[1].revents)
+    {
+        return LE_TERMINATED;
+    }
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Wait for a block buffer of a stream, on the service thread. The event loop is monitored by the
+ * watchdog and does not run during a streamed transfer, so the watchdog is kicked for each block,
+ * and periodically while the file descriptor thread waits for the client.
+ */
+//--------------------------------------------------------------------------------------------------
+static void WaitStreamBuffer
+(
+    le_sem_Ref_t semRef     ///< [IN] freeSem or readySem of the stream
+)
+{
+    le_clk_Time_t timeout = { .sec = FWUPDATE_WDOG_KICK_INTERVAL };
+
+    while (LE_TIMEOUT == le_sem_WaitWithTimeOut(semRef, timeout))
+    {
+        le_wdogChain_Kick(FWUPDATE_WDOG_TIMER);
+    }
+    le_wdogChain_Kick(FWUPDATE_WDOG_TIMER);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Thread filling the block buffers from the client file descriptor. A block is completed before
+ * it is handed over, as pipes return partial reads.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* StreamFromFdThread
+(
+    void* contextPtr    ///< [IN] Stream
+)
+{
+    Stream_t* streamPtr = contextPtr;
+    int index = 0;
+    size_t size;
+
+    do
+    {
+        StreamBuffer_t* bufferPtr = &streamPtr->buffers[index];
+        bool isEof = false;
+
+        le_sem_Wait(streamPtr->freeSem);
+        if (streamPtr->isAborted)
+        {
+            break;
+        }
+
+        size = 0;
+        while ((size < streamPtr->blockSize) && (!isEof) && (LE_OK == streamPtr->result))
+        {
+            ssize_t rc;
+
+            streamPtr->result = WaitStreamFd(streamPtr, POLLIN);
+            if (LE_OK != streamPtr->result)
+            {
+                break;
+            }
+            rc = read(streamPtr->fd, bufferPtr->dataPtr + size, streamPtr->blockSize - size);
+            if (rc > 0)
+            {
+                size += rc;
+            }
+            else if (0 == rc)
+            {
+                isEof = true;
+            }
+            else if ((EINTR != errno) && (EAGAIN != errno))
+            {
+                LE_ERROR("read on fd %d failed: %m", streamPtr->fd);
+                streamPtr->result = LE_FAULT;
+            }
+        }
+
+        // The end of the stream is an empty block, read once the file descriptor reports the end
+        bufferPtr->size = (LE_OK == streamPtr->result) ? (ssize_t)size : -1;
+        le_sem_Post(streamPtr->readySem);
+        index = (index + 1) % STREAM_BUFFER_COUNT;
+    }
+    while ((0 != size) && (LE_OK == streamPtr->result));
+
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Thread draining the block buffers to the client file descriptor.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* StreamToFdThread
+(
+    void* contextPtr    ///< [IN] Stream
+)
+{
+    Stream_t* streamPtr = contextPtr;
+    int index = 0;
+    sigset_t sigSet;
+
+    // A client closing its end of the pipe must fail the transfer, not kill the daemon.
+    sigemptyset(&sigSet);
+    sigaddset(&sigSet, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &sigSet, NULL);
+
+    for (;;)
+    {
+        StreamBuffer_t* bufferPtr = &streamPtr->buffers[index];
+        ssize_t size = 0;
+
+        le_sem_Wait(streamPtr->readySem);
+        if ((streamPtr->isAborted) || (bufferPtr->size <= 0))
+        {
+            break;
+        }
+
+        while ((size < bufferPtr->size) && (LE_OK == streamPtr->result))
+        {
+            ssize_t rc;
+
+            streamPtr->result = WaitStreamFd(streamPtr, POLLOUT);
+            if (LE_OK != streamPtr->result)
+            {
+                break;
+            }
+            rc = write(streamPtr->fd, bufferPtr->dataPtr + size, bufferPtr->size - size);
+            if (rc >= 0)
+            {
+                size += rc;
+            }
+            else if (EPIPE == errno)
+            {
+                LE_ERROR("fd %d closed by the client", streamPtr->fd);
+                streamPtr->result = LE_CLOSED;
+            }
+            else if ((EINTR != errno) && (EAGAIN != errno))
+            {
+                LE_ERROR("write on fd %d failed: %m", streamPtr->fd);
+                streamPtr->result = LE_FAULT;
+            }
+        }
+
+        // Give the buffer back, the producer checks the result before filling it
+        le_sem_Post(streamPtr->freeSem);
+        if (LE_OK != streamPtr->result)
+        {
+            break;
+        }
+        index = (index + 1) % STREAM_BUFFER_COUNT;
+    }
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allocate the block buffers of a stream and start its file descriptor thread.
+ *
+ * @return
+ *      - LE_OK            On success
+ *      - LE_NO_MEMORY     If the buffers cannot be allocated
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t StartStream
+(
+    Stream_t*               streamPtr,  ///< [OUT] Stream
+    const Partition_t*      partPtr,    ///< [IN] Partition descriptor
+    int                     fd,         ///< [IN] Client file descriptor
+    le_thread_MainFunc_t    threadFunc  ///< [IN] File descriptor thread
+)
+{
+    int index;
+
+    memset(streamPtr, 0, sizeof(*streamPtr));
+    streamPtr->fd = fd;
+    streamPtr->blockSize = GetBlockDataSize(partPtr);
+    streamPtr->result = LE_OK;
+
+    for (index = 0; index < STREAM_BUFFER_COUNT; index++)
+    {
+        streamPtr->buffers[index].dataPtr = malloc(streamPtr->blockSize);
+        if (NULL == streamPtr->buffers[index].dataPtr)
+        {
+            LE_ERROR("Unable to allocate %zu bytes for MTD%d stream",
+                     streamPtr->blockSize, partPtr->mtdNum);
+            while (index--)
+            {
+                free(streamPtr->buffers[index].dataPtr);
+            }
+            return LE_NO_MEMORY;
+        }
+    }
+
+    // Hint the kernel to read ahead files and memfds. This fails harmlessly on pipes.
+    (void)posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    streamPtr->abortFd = eventfd(0, EFD_CLOEXEC);
+    if (-1 == streamPtr->abortFd)
+    {
+        LE_ERROR("Unable to create the abort event of MTD%d stream: %m", partPtr->mtdNum);
+        for (index = 0; index < STREAM_BUFFER_COUNT; index++)
+        {
+            free(streamPtr->buffers[index].dataPtr);
+        }
+        return LE_FAULT;
+    }
+
+    streamPtr->freeSem = le_sem_Create("FlashStreamFree", STREAM_BUFFER_COUNT);
+    streamPtr->readySem = le_sem_Create("FlashStreamReady", 0);
+    streamPtr->thread = le_thread_Create("FlashStream", threadFunc, streamPtr);
+    le_thread_SetJoinable(streamPtr->thread);
+    le_thread_Start(streamPtr->thread);
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stop the file descriptor thread of a stream and release its resources.
+ *
+ * @return
+ *      - Result of the file descriptor thread
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t StopStream
+(
+    Stream_t* streamPtr,    ///< [IN] Stream
+    bool      isAborted     ///< [IN] True if the flash side stopped before the end of the stream
+)
+{
+    int index;
+
+    if (isAborted)
+    {
+        // The thread may wait for the client, or for a buffer which will not come
+        uint64_t event = 1;
+
+        streamPtr->isAborted = true;
+        if (sizeof(event) != write(streamPtr->abortFd, &event, sizeof(event)))
+        {
+            LE_ERROR("Unable to abort the stream: %m");
+        }
+        le_sem_Post(streamPtr->freeSem);
+        le_sem_Post(streamPtr->readySem);
+    }
+    le_thread_Join(streamPtr->thread, NULL);
+
+    close(streamPtr->abortFd);
+    le_sem_Delete(streamPtr->freeSem);
+    le_sem_Delete(streamPtr->readySem);
+    for (index = 0; index < STREAM_BUFFER_COUNT; index++)
+    {
+        free(streamPtr->buffers[index].dataPtr);
+    }
+    return streamPtr->result;
+}
+
 //--------------------------------------------------------------------------------------------------
 // APIs
 //--------------------------------------------------------------------------------------------------
@@ -1101,47 +1572,18 @@ le_result_t le_flash_Read
 )
 {
     Partition_t *partPtr = GetPartitionFromRef(partitionRef);
-    le_result_t res;
-    size_t readSize;
 
     if ((NULL == partPtr) || !(partPtr->isRead) || (NULL == readData) || (NULL == readDataSizePtr))
     {
         return LE_BAD_PARAMETER;
     }
 
-    if (partPtr->isUbi)
+    if ((partPtr->isUbi) && (-1 == partPtr->ubiVolume))
     {
-        if (-1 == partPtr->ubiVolume)
-        {
-            return LE_BAD_PARAMETER;
-        }
-        readSize = partPtr->mtdInfo->eraseSize - (2 * partPtr->mtdInfo->writeSize);
-        if (*readDataSizePtr < readSize)
-        {
-            readSize = *readDataSizePtr;
-        }
-        res = pa_flash_ReadUbiAtBlock(partPtr->desc, blockIndex, readData, &readSize);
-        if (LE_OK != res)
-        {
-            LE_ERROR("Ubi Volume %u Partition \"%s\" MTD%d: Read failed at blockIndex %u,"
-                     " dataSize %zu: %d",
-                     partPtr->ubiVolume, partPtr->partitionName, partPtr->mtdNum, blockIndex,
-                     readSize, res);
-            res = LE_FAULT;
-        }
-        *readDataSizePtr = readSize;
-    }
-    else
-    {
-        res = pa_flash_ReadAtBlock( partPtr->desc, blockIndex, readData, *readDataSizePtr);
-        if (LE_OK != res)
-        {
-            LE_ERROR("Partition \"%s\" MTD%d: Read failed at blockIndex %u, dataSize %zu: %d",
-                     partPtr->partitionName, partPtr->mtdNum, blockIndex, *readDataSizePtr, res);
-            res = LE_FAULT;
-        }
+        return LE_BAD_PARAMETER;
     }
-    return res;
+
+    return ReadBlock(partPtr, blockIndex, readData, readDataSizePtr);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1177,7 +1619,6 @@ le_result_t le_flash_Write
 )
 {
     Partition_t *partPtr = GetPartitionFromRef(partitionRef);
-    le_result_t res;
 
     if ((NULL == partPtr) || !(partPtr->isWrite) || (NULL == writeData))
     {
@@ -1191,35 +1632,9 @@ le_result_t le_flash_Write
             return LE_BAD_PARAMETER;
         }
         LE_INFO("MTD%d BlockIndex %u WriteDataSize %zu", partPtr->mtdNum, blockIndex, writeDataSize);
-        res = pa_flash_WriteUbiAtBlock(partPtr->desc, blockIndex,
-                                       (uint8_t*)writeData, writeDataSize, true);
-        if (LE_OK != res)
-        {
-            LE_ERROR("Ubi Volume %u Partition \"%s\" MTD%d: Write failed at blockIndex %u,"
-                     " dataSize %zu: %d",
-                     partPtr->ubiVolume, partPtr->partitionName, partPtr->mtdNum, blockIndex,
-                     writeDataSize, res);
-            res = LE_FAULT;
-        }
-    }
-    else
-    {
-        res = pa_flash_EraseBlock( partPtr->desc, blockIndex );
-        if (LE_OK != res)
-        {
-            LE_ERROR("Partition \"%s\" MTD%d: Erase failed at blockIndex %u",
-                     partPtr->partitionName, partPtr->mtdNum, blockIndex);
-            return LE_FAULT;
-        }
-        res = pa_flash_WriteAtBlock( partPtr->desc, blockIndex, (uint8_t*)writeData, writeDataSize);
-        if (LE_OK != res)
-        {
-            LE_ERROR("Partition \"%s\" MTD%d: Write failed at blockIndex %u, dataSize %zu: %d",
-                     partPtr->partitionName, partPtr->mtdNum, blockIndex, writeDataSize, res);
-            res = LE_FAULT;
-        }
     }
-    return res;
+
+    return WriteBlock(partPtr, blockIndex, writeData, writeDataSize);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1510,3 +1925,202 @@ le_result_t le_flash_DeleteUbiVolume
 
     return LE_OK;
 }
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write the data read from a file descriptor to a flash partition, or to the UBI volume open on
+ * it, starting at a logical block index. The data are read up to the end of file, and each block
+ * is written as le_flash_Write() does: erased first, and moved to the next physical block if the
+ * erase or the write fails. The file descriptor is read by a thread of the service, so that the
+ * next blocks are read while the current one is programmed.
+ *
+ * @return
+ *      - LE_OK            On success
+ *      - LE_BAD_PARAMETER If a parameter is invalid
+ *      - LE_TIMEOUT       If no data were received for 900 seconds
+ *      - LE_NO_MEMORY     If the block buffers cannot be allocated
+ *      - LE_FAULT         On other error
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_flash_WriteFromFd
+(
+    le_flash_PartitionRef_t partitionRef,   ///< [IN] Partition reference to be used.
+    uint32_t                blockIndex,     ///< [IN] First logical block index to be written.
+    int                     fd,             ///< [IN] File descriptor to read the data from.
+    uint32_t*               blockCountPtr   ///< [OUT] Number of blocks written.
+)
+{
+    Partition_t *partPtr = GetPartitionFromRef(partitionRef);
+    Stream_t stream;
+    le_result_t res = LE_OK;
+    le_result_t streamRes;
+    int index = 0;
+    uint32_t blockCount = 0;
+
+    if (fd < 0)
+    {
+        LE_KILL_CLIENT("'fd' is negative");
+        return LE_BAD_PARAMETER;
+    }
+
+    if ((NULL == partPtr) || !(partPtr->isWrite) || (NULL == blockCountPtr) ||
+        ((partPtr->isUbi) && (-1 == partPtr->ubiVolume)))
+    {
+        close(fd);
+        return LE_BAD_PARAMETER;
+    }
+
+    res = StartStream(&stream, partPtr, fd, StreamFromFdThread);
+    if (LE_OK != res)
+    {
+        close(fd);
+        return res;
+    }
+
+    for (;;)
+    {
+        StreamBuffer_t* bufferPtr = &stream.buffers[index];
+
+        WaitStreamBuffer(stream.readySem);
+        if (bufferPtr->size <= 0)
+        {
+            break;
+        }
+
+        res = WriteBlock(partPtr, blockIndex + blockCount, bufferPtr->dataPtr, bufferPtr->size);
+        if (LE_OK != res)
+        {
+            break;
+        }
+        blockCount++;
+
+        le_sem_Post(stream.freeSem);
+        index = (index + 1) % STREAM_BUFFER_COUNT;
+    }
+
+    streamRes = StopStream(&stream, (LE_OK != res));
+    close(fd);
+
+    LE_INFO("Partition \"%s\" MTD%d: %u blocks written from block %u",
+            partPtr->partitionName, partPtr->mtdNum, blockCount, blockIndex);
+
+    *blockCountPtr = blockCount;
+    return (LE_OK != res) ? res : streamRes;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read blocks of a flash partition, or of the UBI volume open on it, and write their data to a
+ * file descriptor. The data are written by a thread of the service, so that the next blocks are
+ * read from the flash while the current one is written to the file descriptor.
+ *
+ * @return
+ *      - LE_OK            On success
+ *      - LE_BAD_PARAMETER If a parameter is invalid
+ *      - LE_TIMEOUT       If the data could not be written for 900 seconds
+ *      - LE_CLOSED        If the file descriptor was closed by the client
+ *      - LE_NO_MEMORY     If the block buffers cannot be allocated
+ *      - LE_FAULT         On other error
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_flash_ReadToFd
+(
+    le_flash_PartitionRef_t partitionRef,   ///< [IN] Partition reference to be used.
+    uint32_t                blockIndex,     ///< [IN] First logical block index to be read.
+    uint32_t                blockCount,     ///< [IN] Number of blocks to read, 0 to read up to the
+                                            ///<      end of the partition or of the UBI volume.
+    int                     fd              ///< [IN] File descriptor to write the data to.
+)
+{
+    Partition_t *partPtr = GetPartitionFromRef(partitionRef);
+    Stream_t stream;
+    le_result_t res = LE_OK;
+    le_result_t streamRes;
+    uint32_t lastBlock;
+    uint32_t block;
+    uint32_t readCount = 0;
+    int index = 0;
+
+    if (fd < 0)
+    {
+        LE_KILL_CLIENT("'fd' is negative");
+        return LE_BAD_PARAMETER;
+    }
+
+    if ((NULL == partPtr) || !(partPtr->isRead) ||
+        ((partPtr->isUbi) && (-1 == partPtr->ubiVolume)))
+    {
+        close(fd);
+        return LE_BAD_PARAMETER;
+    }
+
+    if (partPtr->isUbi)
+    {
+        uint32_t freeBlock, volSize;
+
+        res = pa_flash_GetUbiInfo(partPtr->desc, &freeBlock, &lastBlock, &volSize);
+        if (LE_OK != res)
+        {
+            close(fd);
+            return LE_FAULT;
+        }
+    }
+    else
+    {
+        lastBlock = partPtr->mtdInfo->nbLeb;
+    }
+    if ((0 != blockCount) && (blockCount < lastBlock) && (blockIndex < lastBlock - blockCount))
+    {
+        lastBlock = blockIndex + blockCount;
+    }
+    if (blockIndex >= lastBlock)
+    {
+        close(fd);
+        return LE_BAD_PARAMETER;
+    }
+
+    res = StartStream(&stream, partPtr, fd, StreamToFdThread);
+    if (LE_OK != res)
+    {
+        close(fd);
+        return res;
+    }
+
+    for (block = blockIndex; block <= lastBlock; block++)
+    {
+        StreamBuffer_t* bufferPtr = &stream.buffers[index];
+        size_t size = stream.blockSize;
+
+        WaitStreamBuffer(stream.freeSem);
+        if (LE_OK != stream.result)
+        {
+            break;
+        }
+
+        // Past the last block, the buffer marks the end of the stream
+        if (block == lastBlock)
+        {
+            bufferPtr->size = 0;
+        }
+        else
+        {
+            res = ReadBlock(partPtr, block, bufferPtr->dataPtr, &size);
+            bufferPtr->size = (LE_OK == res) ? (ssize_t)size : -1;
+            readCount += (LE_OK == res) ? 1 : 0;
+        }
+        le_sem_Post(stream.readySem);
+        if (LE_OK != res)
+        {
+            break;
+        }
+        index = (index + 1) % STREAM_BUFFER_COUNT;
+    }
+
+    streamRes = StopStream(&stream, false);
+    close(fd);
+
+    LE_INFO("Partition \"%s\" MTD%d: %u blocks read from block %u",
+            partPtr->partitionName, partPtr->mtdNum, readCount, blockIndex);
+
+    return (LE_OK != res) ? res : streamRes;
+}
@@ -0,0 +1,342 @@
+/**
+ * @file apnTable.c
+ *
+ * Binary APN tables lookup. The table layout is described in the mkapntable tool.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "apnTable.h"
+
+#include <endian.h>
+#include <sys/mman.h>
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Table magic, version and kinds.
+ */
+//--------------------------------------------------------------------------------------------------
+#define APN_TABLE_MAGIC         "APNT"
+#define APN_TABLE_VERSION       1
+#define APN_TABLE_KIND_MCCMNC   1
+#define APN_TABLE_KIND_IIN      2
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of an entry key, including the NUL padding.
+ */
+//--------------------------------------------------------------------------------------------------
+#define APN_TABLE_KEY_BYTES     8
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Table header, as written by mkapntable. Integers are little-endian.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct __attribute__((packed))
+{
+    char     magic[4];      ///< APN_TABLE_MAGIC
+    uint16_t version;       ///< APN_TABLE_VERSION
+    uint16_t kind;          ///< APN_TABLE_KIND_MCCMNC or APN_TABLE_KIND_IIN
+    uint32_t count;         ///< Number of entries
+    uint32_t poolOffset;    ///< Offset of the string pool from the start of the file
+}
+TableHeader_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Table entry, as written by mkapntable. Integers are little-endian.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct __attribute__((packed))
+{
+    char     key[APN_TABLE_KEY_BYTES];  ///< MCC and MNC, or IIN
+    uint32_t apnOffset;                 ///< Offset of the APN in the string pool
+    uint32_t rank;                      ///< Rank of the entry in the JSON database
+}
+TableEntry_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Opened table.
+ */
+//--------------------------------------------------------------------------------------------------
+struct apnTable
+{
+    void*               mapPtr;     ///< Mapped file
+    size_t              mapSize;    ///< Size of the mapped file
+    uint16_t            kind;       ///< Table kind
+    uint32_t            count;      ///< Number of entries
+    const TableEntry_t* entriesPtr; ///< Sorted entries
+    const char*         poolPtr;    ///< String pool
+    size_t              poolSize;   ///< Size of the string pool
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool of opened tables.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t TablePool;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find the entry of a key.
+ *
+ * @return The entry, or NULL if the key is not in the table.
+ */
+//--------------------------------------------------------------------------------------------------
+static const TableEntry_t* FindEntry
+(
+    apnTable_Ref_t tableRef,    ///< [IN] Table to search
+    const char* keyPtr,         ///< [IN] Key
+    size_t keyLen               ///< [IN] Key length, lower than APN_TABLE_KEY_BYTES
+)
+{
+    char key[APN_TABLE_KEY_BYTES] = {0};
+    uint32_t low = 0;
+    uint32_t high = tableRef->count;
+
+    memcpy(key, keyPtr, keyLen);
+
+    while (low < high)
+    {
+        uint32_t middle = low + (high - low) / 2;
+        int cmp = memcmp(key, tableRef->entriesPtr[middle].key, APN_TABLE_KEY_BYTES);
+
+        if (0 == cmp)
+        {
+            return &tableRef->entriesPtr[middle];
+        }
+        if (cmp < 0)
+        {
+            high = middle;
+        }
+        else
+        {
+            low = middle + 1;
+        }
+    }
+
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copy the APN of an entry.
+ *
+ * @return
+ *      - LE_OK         The APN is copied
+ *      - LE_OVERFLOW   The APN buffer is too small
+ *      - LE_FAULT      The entry is corrupted
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t CopyApn
+(
+    apnTable_Ref_t tableRef,    ///< [IN]  Table
+    const TableEntry_t* entryPtr, ///< [IN]  Entry
+    char* apnPtr,               ///< [OUT] APN
+    size_t apnSize              ///< [IN]  Size of APN buffer
+)
+{
+    uint32_t apnOffset = le32toh(entryPtr->apnOffset);
+
+    if (apnOffset >= tableRef->poolSize)
+    {
+        LE_ERROR("Corrupted APN table entry");
+        return LE_FAULT;
+    }
+
+    // The pool ends with a NUL, checked when opening the table.
+    return le_utf8_Copy(apnPtr, tableRef->poolPtr + apnOffset, apnSize, NULL);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open an APN table.
+ *
+ * @return
+ *      - Reference to the table
+ *      - NULL if the file does not exist or is not a valid APN table
+ */
+//--------------------------------------------------------------------------------------------------
+apnTable_Ref_t apnTable_Open
+(
+    const char* pathPtr     ///< [IN] Path of the table file
+)
+{
+    struct stat st;
+    int fd;
+
+    if (NULL == pathPtr)
+    {
+        return NULL;
+    }
+
+    fd = open(pathPtr, O_RDONLY | O_CLOEXEC);
+    if (-1 == fd)
+    {
+        LE_DEBUG("No APN table %s (%m)", pathPtr);
+        return NULL;
+    }
+
+    if ((-1 == fstat(fd, &st)) || (st.st_size < (off_t)sizeof(TableHeader_t)))
+    {
+        LE_ERROR("Invalid APN table %s", pathPtr);
+        close(fd);
+        return NULL;
+    }
+
+    void* mapPtr = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (MAP_FAILED == mapPtr)
+    {
+        LE_ERROR("Cannot map APN table %s (%m)", pathPtr);
+        return NULL;
+    }
+
+    const TableHeader_t* headerPtr = mapPtr;
+    size_t mapSize = st.st_size;
+    uint16_t kind = le16toh(headerPtr->kind);
+    uint32_t count = le32toh(headerPtr->count);
+    uint32_t poolOffset = le32toh(headerPtr->poolOffset);
+
+    if ((0 != memcmp(headerPtr->magic, APN_TABLE_MAGIC, sizeof(headerPtr->magic)))
+        || (APN_TABLE_VERSION != le16toh(headerPtr->version))
+        || ((APN_TABLE_KIND_MCCMNC != kind) && (APN_TABLE_KIND_IIN != kind))
+        || (poolOffset != sizeof(TableHeader_t) + (uint64_t)count * sizeof(TableEntry_t))
+        || (poolOffset >= mapSize)
+        || ('\0' != ((const char*)mapPtr)[mapSize - 1]))
+    {
+        LE_ERROR("Invalid APN table %s", pathPtr);
+        munmap(mapPtr, mapSize);
+        return NULL;
+    }
+
+    if (NULL == TablePool)
+    {
+        TablePool = le_mem_CreatePool("ApnTable", sizeof(struct apnTable));
+    }
+
+    apnTable_Ref_t tableRef = le_mem_ForceAlloc(TablePool);
+    tableRef->mapPtr = mapPtr;
+    tableRef->mapSize = mapSize;
+    tableRef->kind = kind;
+    tableRef->count = count;
+    tableRef->entriesPtr = (const TableEntry_t*)(headerPtr + 1);
+    tableRef->poolPtr = (const char*)mapPtr + poolOffset;
+    tableRef->poolSize = mapSize - poolOffset;
+
+    LE_DEBUG("APN table %s: %" PRIu32 " entries", pathPtr, count);
+
+    return tableRef;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close an APN table.
+ */
+//--------------------------------------------------------------------------------------------------
+void apnTable_Close
+(
+    apnTable_Ref_t tableRef ///< [IN] Table to close
+)
+{
+    if (NULL == tableRef)
+    {
+        return;
+    }
+
+    munmap(tableRef->mapPtr, tableRef->mapSize);
+    le_mem_Release(tableRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find the default APN of a home network.
+ *
+ * @return
+ *      - LE_OK         The APN is found
+ *      - LE_NOT_FOUND  No APN for this MCC/MNC, or the table is not a MCC/MNC table
+ *      - LE_OVERFLOW   The APN buffer is too small
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t apnTable_FindByMccMnc
+(
+    apnTable_Ref_t tableRef,    ///< [IN]  Table to search
+    const char* mccPtr,         ///< [IN]  MCC
+    const char* mncPtr,         ///< [IN]  MNC
+    char* apnPtr,               ///< [OUT] APN
+    size_t apnSize              ///< [IN]  Size of APN buffer
+)
+{
+    char key[APN_TABLE_KEY_BYTES];
+    size_t mccLen = strlen(mccPtr);
+    size_t mncLen = strlen(mncPtr);
+
+    if ((NULL == tableRef) || (APN_TABLE_KIND_MCCMNC != tableRef->kind)
+        || (mccLen + mncLen >= APN_TABLE_KEY_BYTES))
+    {
+        return LE_NOT_FOUND;
+    }
+
+    memcpy(key, mccPtr, mccLen);
+    memcpy(key + mccLen, mncPtr, mncLen);
+
+    const TableEntry_t* entryPtr = FindEntry(tableRef, key, mccLen + mncLen);
+    if (NULL == entryPtr)
+    {
+        return LE_NOT_FOUND;
+    }
+
+    return CopyApn(tableRef, entryPtr, apnPtr, apnSize);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find the APN of a SIM card, from the Issuer Identification Number (IIN) starting its ICCID.
+ * When several IINs match the ICCID, the one first listed in the JSON database is used.
+ *
+ * @return
+ *      - LE_OK         The APN is found
+ *      - LE_NOT_FOUND  No APN for this ICCID, or the table is not an IIN table
+ *      - LE_OVERFLOW   The APN buffer is too small
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t apnTable_FindByIccid
+(
+    apnTable_Ref_t tableRef,    ///< [IN]  Table to search
+    const char* iccidPtr,       ///< [IN]  ICCID
+    char* apnPtr,               ///< [OUT] APN
+    size_t apnSize              ///< [IN]  Size of APN buffer
+)
+{
+    const TableEntry_t* bestEntryPtr = NULL;
+    size_t iccidLen = strlen(iccidPtr);
+    size_t prefixLen;
+
+    if ((NULL == tableRef) || (APN_TABLE_KIND_IIN != tableRef->kind))
+    {
+        return LE_NOT_FOUND;
+    }
+
+    // Every prefix of the ICCID is a candidate IIN: keep the match listed first in the database.
+    for (prefixLen = 1; (prefixLen < APN_TABLE_KEY_BYTES) && (prefixLen <= iccidLen); prefixLen++)
+    {
+        const TableEntry_t* entryPtr = FindEntry(tableRef, iccidPtr, prefixLen);
+
+        if ((NULL != entryPtr) &&
+            ((NULL == bestEntryPtr) || (le32toh(entryPtr->rank) < le32toh(bestEntryPtr->rank))))
+        {
+            bestEntryPtr = entryPtr;
+        }
+    }
+
+    if (NULL == bestEntryPtr)
+    {
+        return LE_NOT_FOUND;
+    }
+
+    return CopyApn(tableRef, bestEntryPtr, apnPtr, apnSize);
+}
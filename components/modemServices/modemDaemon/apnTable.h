@@ -0,0 +1,86 @@
+/**
+ * @file apnTable.h
+ *
+ * Binary APN tables, generated at build time from the JSON APN databases by the mkapntable tool.
+ *
+ * A table is a sorted array of fixed size entries followed by a string pool. It is mapped
+ * read-only, so it costs no heap and a lookup is a binary search touching a few pages only.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#ifndef _APNTABLE_H
+#define _APNTABLE_H
+
+#include <legato.h>
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reference to an opened APN table.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct apnTable* apnTable_Ref_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open an APN table.
+ *
+ * @return
+ *      - Reference to the table
+ *      - NULL if the file does not exist or is not a valid APN table
+ */
+//--------------------------------------------------------------------------------------------------
+apnTable_Ref_t apnTable_Open
+(
+    const char* pathPtr     ///< [IN] Path of the table file
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close an APN table.
+ */
+//--------------------------------------------------------------------------------------------------
+void apnTable_Close
+(
+    apnTable_Ref_t tableRef ///< [IN] Table to close
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find the default APN of a home network.
+ *
+ * @return
+ *      - LE_OK         The APN is found
+ *      - LE_NOT_FOUND  No APN for this MCC/MNC, or the table is not a MCC/MNC table
+ *      - LE_OVERFLOW   The APN buffer is too small
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t apnTable_FindByMccMnc
+(
+    apnTable_Ref_t tableRef,    ///< [IN]  Table to search
+    const char* mccPtr,         ///< [IN]  MCC
+    const char* mncPtr,         ///< [IN]  MNC
+    char* apnPtr,               ///< [OUT] APN
+    size_t apnSize              ///< [IN]  Size of APN buffer
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find the APN of a SIM card, from the Issuer Identification Number (IIN) starting its ICCID.
+ * When several IINs match the ICCID, the one first listed in the JSON database is used.
+ *
+ * @return
+ *      - LE_OK         The APN is found
+ *      - LE_NOT_FOUND  No APN for this ICCID, or the table is not an IIN table
+ *      - LE_OVERFLOW   The APN buffer is too small
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t apnTable_FindByIccid
+(
+    apnTable_Ref_t tableRef,    ///< [IN]  Table to search
+    const char* iccidPtr,       ///< [IN]  ICCID
+    char* apnPtr,               ///< [OUT] APN
+    size_t apnSize              ///< [IN]  Size of APN buffer
+);
+
+#endif /* _APNTABLE_H */
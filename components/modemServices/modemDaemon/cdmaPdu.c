@@ -7,127 +7,11 @@
 
 #include "legato.h"
 #include "cdmaPdu.h"
+#include "pduBits.h"
 
 // Include macros for printing out values
 #include "le_print.h"
 
-typedef struct
-{
-    const uint8_t  *bufferPtr;  ///< buffer
-    uint32_t        index;      ///< current index in buffer
-    uint32_t        readCache;
-    uint8_t         readCacheSize;
-}
-readBitsBuffer_t;
-
-typedef struct
-{
-    uint8_t    *bufferPtr;     ///< buffer
-    uint32_t    bufferSize;    ///< buffer size
-    uint32_t    index;         ///< current index in buffer
-    uint32_t    writeCache;
-    uint8_t     writeCacheSize;
-}
-writeBitsBuffer_t;
-
-//--------------------------------------------------------------------------------------------------
-/**
- * Initialize readBitsBuffer_t
- */
-//--------------------------------------------------------------------------------------------------
-static void InitializeReadBuffer
-(
-    readBitsBuffer_t *bufferPtr,
-    const uint8_t    *dataBufferPtr
-)
-{
-    bufferPtr->bufferPtr = dataBufferPtr;
-    bufferPtr->index = 0;
-    bufferPtr->readCache = 0;
-    bufferPtr->readCacheSize = 0;
-}
-
-//--------------------------------------------------------------------------------------------------
-/**
- * Initialize writeBitsBuffer_t
- */
-//--------------------------------------------------------------------------------------------------
-static void InitializeWriteBuffer
-(
-    writeBitsBuffer_t *bufferPtr,
-    uint8_t           *dataBufferPtr,
-    uint32_t           dataBufferSize
-)
-{
-    bufferPtr->bufferPtr = dataBufferPtr;
-    bufferPtr->bufferSize = dataBufferSize;
-    bufferPtr->index = 0;
-    bufferPtr->writeCache = 0;
-    bufferPtr->writeCacheSize = 0;
-}
-
-//--------------------------------------------------------------------------------------------------
-/**
- * Skip unused bits from cache.
- */
-//--------------------------------------------------------------------------------------------------
-static void SkipBits
-(
-    readBitsBuffer_t *bufferPtr
-)
-{
-    bufferPtr->readCache = 0;
-    bufferPtr->readCacheSize = 0;
-}
-
-//--------------------------------------------------------------------------------------------------
-/**
- * Return value that corresponds to the next number of bits specified by length
- *
- */
-//--------------------------------------------------------------------------------------------------
-static uint32_t ReadBits
-(
-    readBitsBuffer_t* bufferPtr,
-    uint8_t           length
-)
-{
-    if (length <= 0 || length > 32)
-    {
-        LE_WARN("Should not read more that 32 bits");
-        return 0;
-    }
-
-    if (length > bufferPtr->readCacheSize)
-    {
-        uint8_t i;
-        uint8_t bytesToRead;
-        if ( (length - bufferPtr->readCacheSize) % 8 )
-        {
-            bytesToRead = ((length - bufferPtr->readCacheSize) / 8)+1;
-        }
-        else
-        {
-            bytesToRead = ((length - bufferPtr->readCacheSize) / 8);
-        }
-        for(i = 0; i < bytesToRead; i++)
-        {
-            bufferPtr->readCache =   (bufferPtr->readCache << 8)
-                                | (bufferPtr->bufferPtr[bufferPtr->index++] & 0xFF);
-            bufferPtr->readCacheSize += 8;
-        }
-    }
-
-    uint32_t bitOffset = (bufferPtr->readCacheSize - length);
-    uint32_t resultMask = ((uint64_t)1 << length) - 1;
-    uint32_t result = 0;
-
-    result = (bufferPtr->readCache >> bitOffset) & resultMask;
-    bufferPtr->readCacheSize -= length;
-
-    return result;
-}
-
 //--------------------------------------------------------------------------------------------------
 /**
  * Flush current write cache with padding 0s.
@@ -135,21 +19,13 @@ static uint32_t ReadBits
 //--------------------------------------------------------------------------------------------------
 static void WritePadding
 (
-    writeBitsBuffer_t *bufferPtr
+    pduBits_Writer_t *bufferPtr
 )
 {
-    if (bufferPtr->index>bufferPtr->bufferSize)
+    if (LE_OK != pduBits_AlignWriter(bufferPtr))
     {
         LE_ERROR("Internal buffer overflow [%d]",bufferPtr->bufferSize);
-        return;
     }
-
-    if (bufferPtr->writeCacheSize)
-    {
-      bufferPtr->bufferPtr[bufferPtr->index++] = (bufferPtr->writeCache << (8 - bufferPtr->writeCacheSize));
-    }
-    bufferPtr->writeCache = 0;
-    bufferPtr->writeCacheSize = 0;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -160,57 +36,21 @@ static void WritePadding
 //--------------------------------------------------------------------------------------------------
 static void WriteBits
 (
-    writeBitsBuffer_t* bufferPtr,
-    uint32_t           value,
-    uint8_t            length
+    pduBits_Writer_t* bufferPtr,
+    uint32_t          value,
+    uint8_t           length
 )
 {
-    if (length <= 0 || length > 32)
+    le_result_t result = pduBits_Write(bufferPtr, value, length);
+
+    if (LE_BAD_PARAMETER == result)
     {
         LE_WARN("Should not write more that 32 bits");
-        return;
     }
-
-    if ((bufferPtr->index + (length>>3)) > bufferPtr->bufferSize)
+    else if (LE_OK != result)
     {
         LE_ERROR("Internal buffer overflow [%d]",bufferPtr->bufferSize);
-        return;
     }
-
-    uint8_t totalLength = length + bufferPtr->writeCacheSize;
-
-    // 8-byte cache not full
-    if (totalLength < 8) {
-        uint32_t valueMask = ((uint64_t)1 << length) - 1;
-        bufferPtr->writeCache = (bufferPtr->writeCache << length) | (value & valueMask);
-        bufferPtr->writeCacheSize += length;
-        return;
-    }
-
-    // Deal with unaligned part
-    if (bufferPtr->writeCacheSize) {
-        uint8_t mergeLength = 8 - bufferPtr->writeCacheSize;
-        uint8_t valueMask = (1 << mergeLength) - 1;
-
-        bufferPtr->writeCache =   (bufferPtr->writeCache << mergeLength)
-                             | ((value >> (length - mergeLength)) & valueMask);
-        bufferPtr->bufferPtr[bufferPtr->index++] = bufferPtr->writeCache & 0xFF;
-        length -= mergeLength;
-    }
-
-    // Aligned part, just copy
-    bufferPtr->writeCache = 0;
-    bufferPtr->writeCacheSize = 0;
-    while (length >= 8) {
-        length -= 8;
-        bufferPtr->bufferPtr[bufferPtr->index++] = (value >> length) & 0xFF;
-    }
-
-    // Rest part is saved into cache
-    bufferPtr->writeCacheSize = length;
-    bufferPtr->writeCache = value & (((uint64_t)1 << length) - 1);
-
-    return;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -221,12 +61,12 @@ static void WriteBits
 //--------------------------------------------------------------------------------------------------
 static void ReadParameterTeleserviceId
 (
-    readBitsBuffer_t   *decoderPtr,    ///< [IN/OUT] decoder
+    pduBits_Reader_t   *decoderPtr,    ///< [IN/OUT] decoder
     cdmaPdu_t          *cdmaSmsPtr     ///< [OUT] Buffer to store decoded data
 )
 {
     // Read the parameter Id value
-    cdmaSmsPtr->message.teleServiceId = ReadBits(decoderPtr,16);
+    cdmaSmsPtr->message.teleServiceId = pduBits_Read(decoderPtr,16);
 
     // Teleservice Identifier is available
     cdmaSmsPtr->message.parameterMask |= CDMAPDU_PARAMETERMASK_TELESERVICE_ID;
@@ -240,12 +80,12 @@ static void ReadParameterTeleserviceId
 //--------------------------------------------------------------------------------------------------
 static void ReadParameterServiceCategory
 (
-    readBitsBuffer_t   *decoderPtr,    ///< [IN/OUT] decoder
+    pduBits_Reader_t   *decoderPtr,    ///< [IN/OUT] decoder
     cdmaPdu_t          *cdmaSmsPtr     ///< [OUT] Buffer to store decoded data
 )
 {
     // Read the parameter value
-    cdmaSmsPtr->message.serviceCategory = ReadBits(decoderPtr,16);
+    cdmaSmsPtr->message.serviceCategory = pduBits_Read(decoderPtr,16);
 
     // Service Category is available
     cdmaSmsPtr->message.parameterMask |= CDMAPDU_PARAMETERMASK_SERVICE_CATEGORY;
@@ -259,30 +99,30 @@ static void ReadParameterServiceCategory
 //--------------------------------------------------------------------------------------------------
 static bool ReadParameterAddress
 (
-    readBitsBuffer_t            *decoderPtr,    ///< [IN/OUT] decoder
+    pduBits_Reader_t            *decoderPtr,    ///< [IN/OUT] decoder
     cdmaPdu_AddressParameter_t  *addrPtr     ///< [OUT] Buffer to store decoded data
 )
 {
     // Read the digit mode value
-    addrPtr->digitMode = ReadBits(decoderPtr,1);
+    addrPtr->digitMode = pduBits_Read(decoderPtr,1);
 
     // Read the number mode value
-    addrPtr->numberMode = ReadBits(decoderPtr,1);
+    addrPtr->numberMode = pduBits_Read(decoderPtr,1);
 
     // Read number type when digit mode is true
     if (addrPtr->digitMode)
     {
-        addrPtr->numberType = ReadBits(decoderPtr,3);
+        addrPtr->numberType = pduBits_Read(decoderPtr,3);
 
         // Read number plan type when number mode is true
         if (addrPtr->numberMode)
         {
-            addrPtr->numberPlan = ReadBits(decoderPtr,4);
+            addrPtr->numberPlan = pduBits_Read(decoderPtr,4);
         }
     }
 
     // Read the length of CHARi
-    uint8_t fieldsNumber = ReadBits(decoderPtr,8);
+    uint8_t fieldsNumber = pduBits_Read(decoderPtr,8);
     addrPtr->fieldsNumber = fieldsNumber;
 
     // Determine size for copy
@@ -304,13 +144,13 @@ static bool ReadParameterAddress
     }
 
     // Save each char into the buffer
-    writeBitsBuffer_t buffer;
+    pduBits_Writer_t buffer;
     uint32_t i;
 
-    InitializeWriteBuffer(&buffer,addrPtr->chari,sizeof(addrPtr->chari));
+    pduBits_InitWriter(&buffer,addrPtr->chari,sizeof(addrPtr->chari));
     for (i=0;i<fieldsNumber;i++)
     {
-        WriteBits(&buffer,ReadBits(decoderPtr,sizeChar),sizeChar);
+        WriteBits(&buffer,pduBits_Read(decoderPtr,sizeChar),sizeChar);
     }
     WritePadding(&buffer);
 
@@ -325,7 +165,7 @@ static bool ReadParameterAddress
 //--------------------------------------------------------------------------------------------------
 static void ReadParameterOriginatingAddress
 (
-    readBitsBuffer_t   *decoderPtr,    ///< [IN/OUT] decoder
+    pduBits_Reader_t   *decoderPtr,    ///< [IN/OUT] decoder
     cdmaPdu_t          *cdmaSmsPtr     ///< [OUT] Buffer to store decoded data
 )
 {
@@ -344,7 +184,7 @@ static void ReadParameterOriginatingAddress
 //--------------------------------------------------------------------------------------------------
 static void ReadParameterDestinationAddress
 (
-    readBitsBuffer_t  *decoderPtr,    ///< [IN/OUT] decoder
+    pduBits_Reader_t  *decoderPtr,    ///< [IN/OUT] decoder
     cdmaPdu_t         *cdmaSmsPtr     ///< [OUT] Buffer to store decoded data
 )
 {
@@ -364,18 +204,18 @@ static void ReadParameterDestinationAddress
 //--------------------------------------------------------------------------------------------------
 static bool ReadParameterSubAddress
 (
-    readBitsBuffer_t        *decoderPtr,    ///< [IN/OUT] decoder
+    pduBits_Reader_t        *decoderPtr,    ///< [IN/OUT] decoder
     cdmaPdu_SubAddress_t    *subAddrPtr     ///< [OUT] Buffer to store decoded data
 )
 {
     // Read the type value
-    subAddrPtr->type = ReadBits(decoderPtr,3);
+    subAddrPtr->type = pduBits_Read(decoderPtr,3);
 
     // Read the odd value
-    subAddrPtr->odd = ReadBits(decoderPtr,1);
+    subAddrPtr->odd = pduBits_Read(decoderPtr,1);
 
     // Read the length of CHARi
-    uint8_t fieldsNumber = ReadBits(decoderPtr,8);
+    uint8_t fieldsNumber = pduBits_Read(decoderPtr,8);
     subAddrPtr->fieldsNumber = fieldsNumber;
 
     // check size of receiving buffer
@@ -386,13 +226,13 @@ static bool ReadParameterSubAddress
     }
 
     // Save each char into the buffer
-    writeBitsBuffer_t buffer;
+    pduBits_Writer_t buffer;
     uint32_t i;
 
-    InitializeWriteBuffer(&buffer,subAddrPtr->chari,sizeof(subAddrPtr->chari));
+    pduBits_InitWriter(&buffer,subAddrPtr->chari,sizeof(subAddrPtr->chari));
     for (i=0;i<fieldsNumber;i++)
     {
-        WriteBits(&buffer,ReadBits(decoderPtr,8),8);
+        WriteBits(&buffer,pduBits_Read(decoderPtr,8),8);
     }
     WritePadding(&buffer);
 
@@ -407,7 +247,7 @@ static bool ReadParameterSubAddress
 //--------------------------------------------------------------------------------------------------
 static void ReadParameterOriginationSubAddress
 (
-    readBitsBuffer_t  *decoderPtr,    ///< [IN/OUT] decoder
+    pduBits_Reader_t  *decoderPtr,    ///< [IN/OUT] decoder
     cdmaPdu_t         *cdmaSmsPtr     ///< [OUT] Buffer to store decoded data
 )
 {
@@ -426,7 +266,7 @@ static void ReadParameterOriginationSubAddress
 //--------------------------------------------------------------------------------------------------
 static void ReadParameterDestinationSubAddress
 (
-    readBitsBuffer_t   *decoderPtr,    ///< [IN/OUT] decoder
+    pduBits_Reader_t   *decoderPtr,    ///< [IN/OUT] decoder
     cdmaPdu_t          *cdmaSmsPtr     ///< [OUT] Buffer to store decoded data
 )
 {
@@ -445,15 +285,15 @@ static void ReadParameterDestinationSubAddress
 //--------------------------------------------------------------------------------------------------
 static void ReadParameterBearerReplyOption
 (
-    readBitsBuffer_t   *decoderPtr,    ///< [IN/OUT] decoder
+    pduBits_Reader_t   *decoderPtr,    ///< [IN/OUT] decoder
     cdmaPdu_t          *cdmaSmsPtr     ///< [OUT] Buffer to store decoded data
 )
 {
     // Read the type value
-    cdmaSmsPtr->message.bearerReplyOption.replySeq = ReadBits(decoderPtr,6);
+    cdmaSmsPtr->message.bearerReplyOption.replySeq = pduBits_Read(decoderPtr,6);
 
     // Skip the reserved bits
-    SkipBits(decoderPtr);
+    pduBits_AlignReader(decoderPtr);
 
     // Bearer Reply Option is available
     cdmaSmsPtr->message.parameterMask |= CDMAPDU_PARAMETERMASK_BEARER_REPLY_OPTION;
@@ -467,20 +307,20 @@ static void ReadParameterBearerReplyOption
 //--------------------------------------------------------------------------------------------------
 static void ReadParameterCauseCodes
 (
-    readBitsBuffer_t   *decoderPtr,    ///< [IN/OUT] decoder
+    pduBits_Reader_t   *decoderPtr,    ///< [IN/OUT] decoder
     cdmaPdu_t          *cdmaSmsPtr     ///< [OUT] Buffer to store decoded data
 )
 {
     // Read the reply seq value
-    cdmaSmsPtr->message.causeCodes.replySeq = ReadBits(decoderPtr,6);
+    cdmaSmsPtr->message.causeCodes.replySeq = pduBits_Read(decoderPtr,6);
 
     // Read the error class value
-    cdmaSmsPtr->message.causeCodes.errorClass = ReadBits(decoderPtr,2);
+    cdmaSmsPtr->message.causeCodes.errorClass = pduBits_Read(decoderPtr,2);
 
     // Read cause code value
     if (cdmaSmsPtr->message.causeCodes.errorClass!=CDMAPDU_ERRORCLASS_NO_ERROR)
     {
-        cdmaSmsPtr->message.causeCodes.errorCause = ReadBits(decoderPtr,8);
+        cdmaSmsPtr->message.causeCodes.errorCause = pduBits_Read(decoderPtr,8);
     }
 
     // Destination Address is available
@@ -495,21 +335,22 @@ static void ReadParameterCauseCodes
 //--------------------------------------------------------------------------------------------------
 static void ReadSubParameterMessageIdentifier
 (
-    readBitsBuffer_t   *decoderPtr,    ///< [IN/OUT] decoder
+    pduBits_Reader_t   *decoderPtr,    ///< [IN/OUT] decoder
     cdmaPdu_t          *cdmaSmsPtr     ///< [OUT] Buffer to store decoded data
 )
 {
     // Read the message type value
-    cdmaSmsPtr->message.bearerData.messageIdentifier.messageType = ReadBits(decoderPtr,4);
+    cdmaSmsPtr->message.bearerData.messageIdentifier.messageType = pduBits_Read(decoderPtr,4);
 
     // Read the message id value
-    cdmaSmsPtr->message.bearerData.messageIdentifier.messageIdentifier = ReadBits(decoderPtr,16);
+    cdmaSmsPtr->message.bearerData.messageIdentifier.messageIdentifier =
+        pduBits_Read(decoderPtr,16);
 
     // Read the header indication value
-    cdmaSmsPtr->message.bearerData.messageIdentifier.headerIndication = ReadBits(decoderPtr,1);
+    cdmaSmsPtr->message.bearerData.messageIdentifier.headerIndication = pduBits_Read(decoderPtr,1);
 
     // Skip reserved bits
-    SkipBits(decoderPtr);
+    pduBits_AlignReader(decoderPtr);
 
     // Message Identifier is available
     cdmaSmsPtr->message.bearerData.subParameterMask |= CDMAPDU_SUBPARAMETERMASK_MESSAGE_IDENTIFIER;
@@ -524,12 +365,12 @@ static void ReadSubParameterMessageIdentifier
 //--------------------------------------------------------------------------------------------------
 static void ReadSubParameterUserData
 (
-    readBitsBuffer_t   *decoderPtr,    ///< [IN/OUT] decoder
+    pduBits_Reader_t   *decoderPtr,    ///< [IN/OUT] decoder
     cdmaPdu_t          *cdmaSmsPtr     ///< [OUT] Buffer to store decoded data
 )
 {
     // Read the encoding value
-    cdmaSmsPtr->message.bearerData.userData.messageEncoding = ReadBits(decoderPtr,5);
+    cdmaSmsPtr->message.bearerData.userData.messageEncoding = pduBits_Read(decoderPtr,5);
 
     cdmaPdu_Encoding_t encoding = cdmaSmsPtr->message.bearerData.userData.messageEncoding;
     // Read the message type value
@@ -538,11 +379,11 @@ static void ReadSubParameterUserData
            (encoding == 10 ) // GSM Data-Coding-Scheme
        )
     {
-        cdmaSmsPtr->message.bearerData.userData.messageType = ReadBits(decoderPtr,8);
+        cdmaSmsPtr->message.bearerData.userData.messageType = pduBits_Read(decoderPtr,8);
     }
 
     // Read the length of CHARi
-    uint8_t fieldsNumber = ReadBits(decoderPtr,8);
+    uint8_t fieldsNumber = pduBits_Read(decoderPtr,8);
     cdmaSmsPtr->message.bearerData.userData.fieldsNumber = fieldsNumber;
 
     uint8_t charBitSize;
@@ -568,8 +409,8 @@ static void ReadSubParameterUserData
 
     int32_t totalBitSize = fieldsNumber*charBitSize;
 
-    writeBitsBuffer_t buffer;
-    InitializeWriteBuffer(&buffer,
+    pduBits_Writer_t buffer;
+    pduBits_InitWriter(&buffer,
         cdmaSmsPtr->message.bearerData.userData.chari,
         sizeof(cdmaSmsPtr->message.bearerData.userData.chari));
 
@@ -577,7 +418,7 @@ static void ReadSubParameterUserData
          totalBitSize>0;
          totalBitSize-=charBitSize, index++)
     {
-        WriteBits(&buffer,ReadBits(decoderPtr,charBitSize),charBitSize);
+        WriteBits(&buffer,pduBits_Read(decoderPtr,charBitSize),charBitSize);
     }
     WritePadding(&buffer);
 
@@ -593,12 +434,12 @@ static void ReadSubParameterUserData
 //--------------------------------------------------------------------------------------------------
 static void ReadSubParameterUserResponseCode
 (
-    readBitsBuffer_t   *decoderPtr,    ///< [IN/OUT] decoder
+    pduBits_Reader_t   *decoderPtr,    ///< [IN/OUT] decoder
     cdmaPdu_t          *cdmaSmsPtr     ///< [OUT] Buffer to store decoded data
 )
 {
     // Read the response code value
-    cdmaSmsPtr->message.bearerData.userResponseCode = ReadBits(decoderPtr,8);
+    cdmaSmsPtr->message.bearerData.userResponseCode = pduBits_Read(decoderPtr,8);
 
     // User response code is available
     cdmaSmsPtr->message.bearerData.subParameterMask |= CDMAPDU_SUBPARAMETERMASK_USER_RESPONSE_CODE;
@@ -612,27 +453,27 @@ static void ReadSubParameterUserResponseCode
 //--------------------------------------------------------------------------------------------------
 static void ReadSubParameterDate
 (
-    readBitsBuffer_t   *decoderPtr,  ///< [IN/OUT] decoder
+    pduBits_Reader_t   *decoderPtr,  ///< [IN/OUT] decoder
     cdmaPdu_Date_t     *datePtr      ///< [OUT] Buffer to store decoded data
 )
 {
     // Read the year value
-    datePtr->year = ReadBits(decoderPtr,8);
+    datePtr->year = pduBits_Read(decoderPtr,8);
 
     // Read the month value
-    datePtr->month = ReadBits(decoderPtr,8);
+    datePtr->month = pduBits_Read(decoderPtr,8);
 
     // Read the day value
-    datePtr->day = ReadBits(decoderPtr,8);
+    datePtr->day = pduBits_Read(decoderPtr,8);
 
     // Read the hours value
-    datePtr->hours = ReadBits(decoderPtr,8);
+    datePtr->hours = pduBits_Read(decoderPtr,8);
 
     // Read the minutes value
-    datePtr->minutes = ReadBits(decoderPtr,8);
+    datePtr->minutes = pduBits_Read(decoderPtr,8);
 
     // Read the seconds value
-    datePtr->seconds = ReadBits(decoderPtr,8);
+    datePtr->seconds = pduBits_Read(decoderPtr,8);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -643,7 +484,7 @@ static void ReadSubParameterDate
 //--------------------------------------------------------------------------------------------------
 static void ReadSubParameterMessageCenterTimeStamp
 (
-    readBitsBuffer_t   *decoderPtr,    ///< [IN/OUT] decoder
+    pduBits_Reader_t   *decoderPtr,    ///< [IN/OUT] decoder
     cdmaPdu_t          *cdmaSmsPtr     ///< [OUT] Buffer to store decoded data
 )
 {
@@ -661,7 +502,7 @@ static void ReadSubParameterMessageCenterTimeStamp
 //--------------------------------------------------------------------------------------------------
 static void ReadSubParameterValidityPeriodAbsolute
 (
-    readBitsBuffer_t   *decoderPtr,    ///< [IN/OUT] decoder
+    pduBits_Reader_t   *decoderPtr,    ///< [IN/OUT] decoder
     cdmaPdu_t          *cdmaSmsPtr     ///< [OUT] Buffer to store decoded data
 )
 {
@@ -680,12 +521,12 @@ static void ReadSubParameterValidityPeriodAbsolute
 //--------------------------------------------------------------------------------------------------
 static void ReadSubParameterValidityPeriodRelative
 (
-    readBitsBuffer_t   *decoderPtr,    ///< [IN/OUT] decoder
+    pduBits_Reader_t   *decoderPtr,    ///< [IN/OUT] decoder
     cdmaPdu_t          *cdmaSmsPtr     ///< [OUT] Buffer to store decoded data
 )
 {
     // Read the validity time value
-    cdmaSmsPtr->message.bearerData.validityPeriodRelative = ReadBits(decoderPtr,8);
+    cdmaSmsPtr->message.bearerData.validityPeriodRelative = pduBits_Read(decoderPtr,8);
 
     // Validity period absolute is available
     cdmaSmsPtr->message.bearerData.subParameterMask
@@ -700,7 +541,7 @@ static void ReadSubParameterValidityPeriodRelative
 //--------------------------------------------------------------------------------------------------
 static void ReadSubParameterDeferedDeliveryTimeAbsolute
 (
-    readBitsBuffer_t   *decoderPtr,    ///< [IN/OUT] decoder
+    pduBits_Reader_t   *decoderPtr,    ///< [IN/OUT] decoder
     cdmaPdu_t          *cdmaSmsPtr     ///< [OUT] Buffer to store decoded data
 )
 {
@@ -719,12 +560,12 @@ static void ReadSubParameterDeferedDeliveryTimeAbsolute
 //--------------------------------------------------------------------------------------------------
 static void ReadSubParameterDeferedDeliveryTimeRelative
 (
-    readBitsBuffer_t   *decoderPtr,    ///< [IN/OUT] decoder
+    pduBits_Reader_t   *decoderPtr,    ///< [IN/OUT] decoder
     cdmaPdu_t          *cdmaSmsPtr     ///< [OUT] Buffer to store decoded data
 )
 {
     // Read the deferred delivety time value
-    cdmaSmsPtr->message.bearerData.deferredDeliveryTimeRelative = ReadBits(decoderPtr,8);
+    cdmaSmsPtr->message.bearerData.deferredDeliveryTimeRelative = pduBits_Read(decoderPtr,8);
 
     // Validity period absolute is available
     cdmaSmsPtr->message.bearerData.subParameterMask
@@ -739,15 +580,15 @@ static void ReadSubParameterDeferedDeliveryTimeRelative
 //--------------------------------------------------------------------------------------------------
 static void ReadSubParameterPriorityIndicator
 (
-    readBitsBuffer_t   *decoderPtr,    ///< [IN/OUT] decoder
+    pduBits_Reader_t   *decoderPtr,    ///< [IN/OUT] decoder
     cdmaPdu_t          *cdmaSmsPtr     ///< [OUT] Buffer to store decoded data
 )
 {
     // Read the priority value
-    cdmaSmsPtr->message.bearerData.priority = ReadBits(decoderPtr,2);
+    cdmaSmsPtr->message.bearerData.priority = pduBits_Read(decoderPtr,2);
 
     // Skip the reserved bits
-    SkipBits(decoderPtr);
+    pduBits_AlignReader(decoderPtr);
 
     // Priority indicator is available
     cdmaSmsPtr->message.bearerData.subParameterMask |= CDMAPDU_SUBPARAMETERMASK_PRIORITY;
@@ -761,15 +602,15 @@ static void ReadSubParameterPriorityIndicator
 //--------------------------------------------------------------------------------------------------
 static void ReadSubParameterPrivacyIndicator
 (
-    readBitsBuffer_t   *decoderPtr,    ///< [IN/OUT] decoder
+    pduBits_Reader_t   *decoderPtr,    ///< [IN/OUT] decoder
     cdmaPdu_t          *cdmaSmsPtr     ///< [OUT] Buffer to store decoded data
 )
 {
     // Read the privacy value
-    cdmaSmsPtr->message.bearerData.privacy = ReadBits(decoderPtr,2);
+    cdmaSmsPtr->message.bearerData.privacy = pduBits_Read(decoderPtr,2);
 
     // Skip the reserved bits
-    SkipBits(decoderPtr);
+    pduBits_AlignReader(decoderPtr);
 
     // Priority indicator is available
     cdmaSmsPtr->message.bearerData.subParameterMask |= CDMAPDU_SUBPARAMETERMASK_PRIVACY;
@@ -783,24 +624,24 @@ static void ReadSubParameterPrivacyIndicator
 //--------------------------------------------------------------------------------------------------
 static void ReadSubParameterReplyOption
 (
-    readBitsBuffer_t   *decoderPtr,    ///< [IN/OUT] decoder
+    pduBits_Reader_t   *decoderPtr,    ///< [IN/OUT] decoder
     cdmaPdu_t          *cdmaSmsPtr     ///< [OUT] Buffer to store decoded data
 )
 {
     // Read the user ack value
-    cdmaSmsPtr->message.bearerData.replyOption.userAck = ReadBits(decoderPtr,1);
+    cdmaSmsPtr->message.bearerData.replyOption.userAck = pduBits_Read(decoderPtr,1);
 
     // Read the dak value
-    cdmaSmsPtr->message.bearerData.replyOption.deliveryAck = ReadBits(decoderPtr,1);
+    cdmaSmsPtr->message.bearerData.replyOption.deliveryAck = pduBits_Read(decoderPtr,1);
 
     // Read the read ack value
-    cdmaSmsPtr->message.bearerData.replyOption.readAck = ReadBits(decoderPtr,1);
+    cdmaSmsPtr->message.bearerData.replyOption.readAck = pduBits_Read(decoderPtr,1);
 
     // Read the report value
-    cdmaSmsPtr->message.bearerData.replyOption.deliveryReport = ReadBits(decoderPtr,1);
+    cdmaSmsPtr->message.bearerData.replyOption.deliveryReport = pduBits_Read(decoderPtr,1);
 
     // Skip the reserved bits
-    SkipBits(decoderPtr);
+    pduBits_AlignReader(decoderPtr);
 
     // Priority indicator is available
     cdmaSmsPtr->message.bearerData.subParameterMask |= CDMAPDU_SUBPARAMETERMASK_REPLY_OPTION;
@@ -814,12 +655,12 @@ static void ReadSubParameterReplyOption
 //--------------------------------------------------------------------------------------------------
 static void ReadSubParameterNumberOfMessage
 (
-    readBitsBuffer_t   *decoderPtr,    ///< [IN/OUT] decoder
+    pduBits_Reader_t   *decoderPtr,    ///< [IN/OUT] decoder
     cdmaPdu_t          *cdmaSmsPtr     ///< [OUT] Buffer to store decoded data
 )
 {
     // Read the Message count value
-    cdmaSmsPtr->message.bearerData.messageCount = ReadBits(decoderPtr,8);
+    cdmaSmsPtr->message.bearerData.messageCount = pduBits_Read(decoderPtr,8);
 
     // Number of message is available
     cdmaSmsPtr->message.bearerData.subParameterMask |= CDMAPDU_SUBPARAMETERMASK_MESSAGE_COUNT;
@@ -833,15 +674,15 @@ static void ReadSubParameterNumberOfMessage
 //--------------------------------------------------------------------------------------------------
 static void ReadSubParameterAlertOnMessageDelivery
 (
-    readBitsBuffer_t   *decoderPtr,    ///< [IN/OUT] decoder
+    pduBits_Reader_t   *decoderPtr,    ///< [IN/OUT] decoder
     cdmaPdu_t          *cdmaSmsPtr     ///< [OUT] Buffer to store decoded data
 )
 {
     // Read the alert priority value
-    cdmaSmsPtr->message.bearerData.alertOnMessageDelivery = ReadBits(decoderPtr,2);
+    cdmaSmsPtr->message.bearerData.alertOnMessageDelivery = pduBits_Read(decoderPtr,2);
 
     // Skip the reserved bits
-    SkipBits(decoderPtr);
+    pduBits_AlignReader(decoderPtr);
 
     // Alert on message delivery is available
     cdmaSmsPtr->message.bearerData.subParameterMask
@@ -856,12 +697,12 @@ static void ReadSubParameterAlertOnMessageDelivery
 //--------------------------------------------------------------------------------------------------
 static void ReadSubParameterLanguageIndicator
 (
-    readBitsBuffer_t   *decoderPtr,    ///< [IN/OUT] decoder
+    pduBits_Reader_t   *decoderPtr,    ///< [IN/OUT] decoder
     cdmaPdu_t          *cdmaSmsPtr     ///< [OUT] Buffer to store decoded data
 )
 {
     // Read the language value
-    cdmaSmsPtr->message.bearerData.alertOnMessageDelivery = ReadBits(decoderPtr,8);
+    cdmaSmsPtr->message.bearerData.alertOnMessageDelivery = pduBits_Read(decoderPtr,8);
 
     // Language indicator is available
     cdmaSmsPtr->message.bearerData.subParameterMask |= CDMAPDU_SUBPARAMETERMASK_LANGUAGE;
@@ -875,7 +716,7 @@ static void ReadSubParameterLanguageIndicator
 //--------------------------------------------------------------------------------------------------
 static void ReadSubParameterCallBackNumber
 (
-    readBitsBuffer_t   *decoderPtr,    ///< [IN/OUT] decoder
+    pduBits_Reader_t   *decoderPtr,    ///< [IN/OUT] decoder
     cdmaPdu_t          *cdmaSmsPtr     ///< [OUT] Buffer to store decoded data
 )
 {
@@ -894,15 +735,15 @@ static void ReadSubParameterCallBackNumber
 //--------------------------------------------------------------------------------------------------
 static void ReadSubParameterMessageDisplayMode
 (
-    readBitsBuffer_t   *decoderPtr,    ///< [IN/OUT] decoder
+    pduBits_Reader_t   *decoderPtr,    ///< [IN/OUT] decoder
     cdmaPdu_t          *cdmaSmsPtr     ///< [OUT] Buffer to store decoded data
 )
 {
     // Read the message display mode value
-    cdmaSmsPtr->message.bearerData.messageDisplayMode = ReadBits(decoderPtr,2);
+    cdmaSmsPtr->message.bearerData.messageDisplayMode = pduBits_Read(decoderPtr,2);
 
     // Skip the reserved bits
-    SkipBits(decoderPtr);
+    pduBits_AlignReader(decoderPtr);
 
     // Message display mode is available
     cdmaSmsPtr->message.bearerData.subParameterMask
@@ -917,12 +758,12 @@ static void ReadSubParameterMessageDisplayMode
 //--------------------------------------------------------------------------------------------------
 static void ReadSubParameterMessageDepositIndex
 (
-    readBitsBuffer_t   *decoderPtr,    ///< [IN/OUT] decoder
+    pduBits_Reader_t   *decoderPtr,    ///< [IN/OUT] decoder
     cdmaPdu_t          *cdmaSmsPtr     ///< [OUT] Buffer to store decoded data
 )
 {
     // Read the message deposit index value
-    cdmaSmsPtr->message.bearerData.messageDepositIndex = ReadBits(decoderPtr,16);
+    cdmaSmsPtr->message.bearerData.messageDepositIndex = pduBits_Read(decoderPtr,16);
 
     // Message deposit index is available
     cdmaSmsPtr->message.bearerData.subParameterMask
@@ -937,15 +778,15 @@ static void ReadSubParameterMessageDepositIndex
 //--------------------------------------------------------------------------------------------------
 static void ReadSubParameterMessageStatus
 (
-    readBitsBuffer_t   *decoderPtr,    ///< [IN/OUT] decoder
+    pduBits_Reader_t   *decoderPtr,    ///< [IN/OUT] decoder
     cdmaPdu_t          *cdmaSmsPtr     ///< [OUT] Buffer to store decoded data
 )
 {
     // Read the error class value
-    cdmaSmsPtr->message.bearerData.messageStatus.errorClass = ReadBits(decoderPtr,2);
+    cdmaSmsPtr->message.bearerData.messageStatus.errorClass = pduBits_Read(decoderPtr,2);
 
     // Read the message status mode value
-    cdmaSmsPtr->message.bearerData.messageStatus.messageStatusCode = ReadBits(decoderPtr,6);
+    cdmaSmsPtr->message.bearerData.messageStatus.messageStatusCode = pduBits_Read(decoderPtr,6);
 
     // Message status is available
     cdmaSmsPtr->message.bearerData.subParameterMask
@@ -960,12 +801,12 @@ static void ReadSubParameterMessageStatus
 //--------------------------------------------------------------------------------------------------
 static void ReadSubParameterTPFailureCause
 (
-    readBitsBuffer_t   *decoderPtr,    ///< [IN/OUT] decoder
+    pduBits_Reader_t   *decoderPtr,    ///< [IN/OUT] decoder
     cdmaPdu_t          *cdmaSmsPtr     ///< [OUT] Buffer to store decoded data
 )
 {
     // Read the value
-    cdmaSmsPtr->message.bearerData.tpFailureCause = ReadBits(decoderPtr,8);
+    cdmaSmsPtr->message.bearerData.tpFailureCause = pduBits_Read(decoderPtr,8);
 
     // TPFailure cause is available
     cdmaSmsPtr->message.bearerData.subParameterMask |= CDMAPDU_SUBPARAMETERMASK_TP_FAILURE_CAUSE;
@@ -982,7 +823,7 @@ static void ReadSubParameterTPFailureCause
 //--------------------------------------------------------------------------------------------------
 static uint32_t ReadSubParameters
 (
-    readBitsBuffer_t   *decoderPtr,    ///< [IN/OUT] decoder
+    pduBits_Reader_t   *decoderPtr,    ///< [IN/OUT] decoder
     cdmaPdu_t          *cdmaSmsPtr     ///< [OUT] Buffer to store decoded data
 )
 {
@@ -991,10 +832,10 @@ static uint32_t ReadSubParameters
     uint8_t subParameterLen;
 
     // Read the parameter Id
-    subParameterId = ReadBits(decoderPtr,8);
+    subParameterId = pduBits_Read(decoderPtr,8);
 
     // Read the length value
-    subParameterLen = ReadBits(decoderPtr,8);
+    subParameterLen = pduBits_Read(decoderPtr,8);
     subParameterIndex = decoderPtr->index;
 
     switch (subParameterId)
@@ -1248,7 +1089,7 @@ static uint32_t ReadSubParameters
             LE_WARN("Do not support this subparameter Id: %d", subParameterId);
         }
     }
-    SkipBits(decoderPtr);
+    pduBits_AlignReader(decoderPtr);
 
     // Reset the index if a read did not work correctly
     decoderPtr->index = subParameterIndex + subParameterLen;
@@ -1264,7 +1105,7 @@ static uint32_t ReadSubParameters
 //--------------------------------------------------------------------------------------------------
 static void ReadParameterBearerData
 (
-    readBitsBuffer_t   *decoderPtr,    ///< [IN/OUT] decoder
+    pduBits_Reader_t   *decoderPtr,    ///< [IN/OUT] decoder
     uint8_t             length,        ///< [IN] Size of the parameter
     cdmaPdu_t          *cdmaSmsPtr     ///< [OUT] Buffer to store decoded data
 )
@@ -1292,7 +1133,7 @@ static void ReadParameterBearerData
 //--------------------------------------------------------------------------------------------------
 static uint32_t ReadParameters
 (
-    readBitsBuffer_t   *decoderPtr,    ///< [IN/OUT] decoder
+    pduBits_Reader_t   *decoderPtr,    ///< [IN/OUT] decoder
     cdmaPdu_t          *cdmaSmsPtr     ///< [OUT] Buffer to store decoded data
 )
 {
@@ -1301,10 +1142,10 @@ static uint32_t ReadParameters
     uint8_t parameterLen;
 
     // Read the parameter Id
-    parameterId = ReadBits(decoderPtr,8);
+    parameterId = pduBits_Read(decoderPtr,8);
 
     // Read the length value
-    parameterLen = ReadBits(decoderPtr,8);
+    parameterLen = pduBits_Read(decoderPtr,8);
     parameterIndex = decoderPtr->index;
 
     switch (parameterId)
@@ -1389,7 +1230,7 @@ static uint32_t ReadParameters
             LE_WARN("Do not support this Parameter Id: %d", parameterId);
         }
     }
-    SkipBits(decoderPtr);
+    pduBits_AlignReader(decoderPtr);
 
     // Reset the index if a read did not work correctly
     decoderPtr->index = parameterIndex + parameterLen;
@@ -1406,7 +1247,7 @@ static uint32_t ReadParameters
 static void WriteParameterTeleserviceId
 (
     const cdmaPdu_t     *cdmaSmsPtr,    ///< [IN] Buffer to store decoded data
-    writeBitsBuffer_t  *encoderPtr     ///< [IN/OUT] encoder
+    pduBits_Writer_t   *encoderPtr     ///< [IN/OUT] encoder
 )
 {
     // Write the TVL Id value
@@ -1428,7 +1269,7 @@ static void WriteParameterTeleserviceId
 static void WriteParameterServiceCategory
 (
     const cdmaPdu_t     *cdmaSmsPtr,    ///< [IN] Buffer to store decoded data
-    writeBitsBuffer_t  *encoderPtr     ///< [IN/OUT] encoder
+    pduBits_Writer_t   *encoderPtr     ///< [IN/OUT] encoder
 )
 {
     // Write the TVL Id value
@@ -1450,7 +1291,7 @@ static void WriteParameterServiceCategory
 static bool WriteParameterAddress
 (
     const cdmaPdu_AddressParameter_t *addrPtr,     ///< [IN] Buffer to store decoded data
-    writeBitsBuffer_t               *encoderPtr   ///< [IN/OUT] encoder
+    pduBits_Writer_t                *encoderPtr   ///< [IN/OUT] encoder
 )
 {
     // Reserved the TLV Length value
@@ -1490,13 +1331,13 @@ static bool WriteParameterAddress
     }
 
     // Save each char into the buffer
-    readBitsBuffer_t buffer;
+    pduBits_Reader_t buffer;
     uint32_t i;
 
-    InitializeReadBuffer(&buffer,addrPtr->chari);
+    pduBits_InitReader(&buffer,addrPtr->chari);
     for (i=0;i<addrPtr->fieldsNumber;i++)
     {
-        WriteBits(encoderPtr,ReadBits(&buffer,sizeChar),sizeChar);
+        WriteBits(encoderPtr,pduBits_Read(&buffer,sizeChar),sizeChar);
     }
     WritePadding(encoderPtr);
 
@@ -1516,7 +1357,7 @@ static bool WriteParameterAddress
 static void WriteParameterOriginatingAddress
 (
     const cdmaPdu_t     *cdmaSmsPtr,    ///< [IN] Buffer to store decoded data
-    writeBitsBuffer_t  *encoderPtr     ///< [IN/OUT] encoderPtr
+    pduBits_Writer_t   *encoderPtr     ///< [IN/OUT] encoderPtr
 )
 {
     // Write the TVL Id value
@@ -1535,7 +1376,7 @@ static void WriteParameterOriginatingAddress
 static void WriteParameterDestinationAddress
 (
     const cdmaPdu_t     *cdmaSmsPtr,    ///< [IN] Buffer to store decoded data
-    writeBitsBuffer_t  *encoderPtr     ///< [IN/OUT] encoderPtr
+    pduBits_Writer_t   *encoderPtr     ///< [IN/OUT] encoderPtr
 )
 {
     // Write the TVL Id value
@@ -1554,7 +1395,7 @@ static void WriteParameterDestinationAddress
 static bool WriteParameterSubAddress
 (
     const cdmaPdu_SubAddress_t  *subAddrPtr,   ///< [IN] Buffer to store decoded data
-    writeBitsBuffer_t          *encoderPtr    ///< [IN/OUT] encoder
+    pduBits_Writer_t           *encoderPtr    ///< [IN/OUT] encoder
 )
 {
     // Reserved the TLV Length value
@@ -1571,13 +1412,13 @@ static bool WriteParameterSubAddress
     WriteBits(encoderPtr,subAddrPtr->fieldsNumber,8);
 
     // Save each char into the buffer
-    readBitsBuffer_t buffer;
+    pduBits_Reader_t buffer;
     uint32_t i;
 
-    InitializeReadBuffer(&buffer,subAddrPtr->chari);
+    pduBits_InitReader(&buffer,subAddrPtr->chari);
     for (i=0;i<subAddrPtr->fieldsNumber;i++)
     {
-        WriteBits(encoderPtr,ReadBits(&buffer,8),8);
+        WriteBits(encoderPtr,pduBits_Read(&buffer,8),8);
     }
     WritePadding(encoderPtr);
 
@@ -1597,7 +1438,7 @@ static bool WriteParameterSubAddress
 static void WriteParameterOriginatingSubAddress
 (
     const cdmaPdu_t     *cdmaSmsPtr,    ///< [IN] Buffer to store decoded data
-    writeBitsBuffer_t  *encoderPtr     ///< [IN/OUT] encoderPtr
+    pduBits_Writer_t   *encoderPtr     ///< [IN/OUT] encoderPtr
 )
 {
     // Write the TVL Id value
@@ -1616,7 +1457,7 @@ static void WriteParameterOriginatingSubAddress
 static void WriteParameterDestinationSubAddress
 (
     const cdmaPdu_t     *cdmaSmsPtr,    ///< [IN] Buffer to store decoded data
-    writeBitsBuffer_t  *encoderPtr     ///< [IN/OUT] encoderPtr
+    pduBits_Writer_t   *encoderPtr     ///< [IN/OUT] encoderPtr
 )
 {
     // Write the TVL Id value
@@ -1635,7 +1476,7 @@ static void WriteParameterDestinationSubAddress
 static void WriteParameterBearerReplyOption
 (
     const cdmaPdu_t     *cdmaSmsPtr,    ///< [IN] Buffer to store decoded data
-    writeBitsBuffer_t  *encoderPtr     ///< [IN/OUT] encoderPtr
+    pduBits_Writer_t   *encoderPtr     ///< [IN/OUT] encoderPtr
 )
 {
     // Write the TVL Id value
@@ -1660,7 +1501,7 @@ static void WriteParameterBearerReplyOption
 static void WriteParameterCauseCodes
 (
     const cdmaPdu_t     *cdmaSmsPtr,    ///< [IN] Buffer to store decoded data
-    writeBitsBuffer_t  *encoderPtr     ///< [IN/OUT] encoderPtr
+    pduBits_Writer_t   *encoderPtr     ///< [IN/OUT] encoderPtr
 )
 {
     // Write the TVL Id value
@@ -1695,7 +1536,7 @@ static void WriteParameterCauseCodes
 static void WriteSubParameterMessageIdentifier
 (
     const cdmaPdu_t     *cdmaSmsPtr,    ///< [IN] Buffer to store decoded data
-    writeBitsBuffer_t  *encoderPtr     ///< [IN/OUT] encoderPtr
+    pduBits_Writer_t   *encoderPtr     ///< [IN/OUT] encoderPtr
 )
 {
     // Write the TVL Id value
@@ -1727,7 +1568,7 @@ static void WriteSubParameterMessageIdentifier
 static void WriteSubParameterUserData
 (
     const cdmaPdu_t     *cdmaSmsPtr,    ///< [IN] Buffer to store decoded data
-    writeBitsBuffer_t  *encoderPtr     ///< [IN/OUT] encoderPtr
+    pduBits_Writer_t   *encoderPtr     ///< [IN/OUT] encoderPtr
 )
 {
     // Write the TVL Id value
@@ -1770,14 +1611,14 @@ static void WriteSubParameterUserData
 
     int32_t totalBitSize = cdmaSmsPtr->message.bearerData.userData.fieldsNumber*charBitSize;
 
-    readBitsBuffer_t buffer;
-    InitializeReadBuffer(&buffer,cdmaSmsPtr->message.bearerData.userData.chari);
+    pduBits_Reader_t buffer;
+    pduBits_InitReader(&buffer,cdmaSmsPtr->message.bearerData.userData.chari);
 
     for (index = 0;
          totalBitSize>0;
          totalBitSize-=charBitSize, index++)
     {
-        WriteBits(encoderPtr,ReadBits(&buffer,charBitSize),charBitSize);
+        WriteBits(encoderPtr,pduBits_Read(&buffer,charBitSize),charBitSize);
     }
     WritePadding(encoderPtr);
 
@@ -1795,7 +1636,7 @@ static void WriteSubParameterUserData
 static void WriteSubParameterUserResponseCode
 (
     const cdmaPdu_t     *cdmaSmsPtr,    ///< [IN] Buffer to store decoded data
-    writeBitsBuffer_t  *encoderPtr     ///< [IN/OUT] encoderPtr
+    pduBits_Writer_t   *encoderPtr     ///< [IN/OUT] encoderPtr
 )
 {
     // Write the TVL Id value
@@ -1817,7 +1658,7 @@ static void WriteSubParameterUserResponseCode
 static void WriteSubParameterDate
 (
     const cdmaPdu_Date_t *datePtr,    ///< [IN] Buffer to store decoded data
-    writeBitsBuffer_t   *encoderPtr  ///< [IN/OUT] decoder
+    pduBits_Writer_t    *encoderPtr  ///< [IN/OUT] decoder
 )
 {
     // Write the year value
@@ -1848,7 +1689,7 @@ static void WriteSubParameterDate
 static void WriteSubParameterMessageCenterTimeStamp
 (
     const cdmaPdu_t     *cdmaSmsPtr,    ///< [IN] Buffer to store decoded data
-    writeBitsBuffer_t  *encoderPtr     ///< [IN/OUT] encoderPtr
+    pduBits_Writer_t   *encoderPtr     ///< [IN/OUT] encoderPtr
 )
 {
     // Write the TVL Id value
@@ -1870,7 +1711,7 @@ static void WriteSubParameterMessageCenterTimeStamp
 static void WriteSubParameterValidityPeriodAbsolute
 (
     const cdmaPdu_t     *cdmaSmsPtr,    ///< [IN] Buffer to store decoded data
-    writeBitsBuffer_t  *encoderPtr     ///< [IN/OUT] encoderPtr
+    pduBits_Writer_t   *encoderPtr     ///< [IN/OUT] encoderPtr
 )
 {
     // Write the TVL Id value
@@ -1892,7 +1733,7 @@ static void WriteSubParameterValidityPeriodAbsolute
 static void WriteSubParameterValidityPeriodRelative
 (
     const cdmaPdu_t     *cdmaSmsPtr,    ///< [IN] Buffer to store decoded data
-    writeBitsBuffer_t  *encoderPtr     ///< [IN/OUT] encoderPtr
+    pduBits_Writer_t   *encoderPtr     ///< [IN/OUT] encoderPtr
 )
 {
     // Write the TVL Id value
@@ -1914,7 +1755,7 @@ static void WriteSubParameterValidityPeriodRelative
 static void WriteSubParameterDeferredDeliveyTimeAbsolute
 (
     const cdmaPdu_t     *cdmaSmsPtr,    ///< [IN] Buffer to store decoded data
-    writeBitsBuffer_t  *encoderPtr     ///< [IN/OUT] encoderPtr
+    pduBits_Writer_t   *encoderPtr     ///< [IN/OUT] encoderPtr
 )
 {
     // Write the TVL Id value
@@ -1936,7 +1777,7 @@ static void WriteSubParameterDeferredDeliveyTimeAbsolute
 static void WriteSubParameterDeferredDeliveyTimeRelative
 (
     const cdmaPdu_t     *cdmaSmsPtr,    ///< [IN] Buffer to store decoded data
-    writeBitsBuffer_t  *encoderPtr     ///< [IN/OUT] encoderPtr
+    pduBits_Writer_t   *encoderPtr     ///< [IN/OUT] encoderPtr
 )
 {
     // Write the TVL Id value
@@ -1959,7 +1800,7 @@ static void WriteSubParameterDeferredDeliveyTimeRelative
 static void WriteSubParameterPriorityIndicator
 (
     const cdmaPdu_t     *cdmaSmsPtr,    ///< [IN] Buffer to store decoded data
-    writeBitsBuffer_t  *encoderPtr     ///< [IN/OUT] encoderPtr
+    pduBits_Writer_t   *encoderPtr     ///< [IN/OUT] encoderPtr
 )
 {
     // Write the TVL Id value
@@ -1984,7 +1825,7 @@ static void WriteSubParameterPriorityIndicator
 static void WriteSubParameterPrivacyIndicator
 (
     const cdmaPdu_t     *cdmaSmsPtr,    ///< [IN] Buffer to store decoded data
-    writeBitsBuffer_t  *encoderPtr     ///< [IN/OUT] encoderPtr
+    pduBits_Writer_t   *encoderPtr     ///< [IN/OUT] encoderPtr
 )
 {
     // Write the TVL Id value
@@ -2009,7 +1850,7 @@ static void WriteSubParameterPrivacyIndicator
 static void WriteSubParameterReplyOption
 (
     const cdmaPdu_t     *cdmaSmsPtr,    ///< [IN] Buffer to store decoded data
-    writeBitsBuffer_t  *encoderPtr     ///< [IN/OUT] encoderPtr
+    pduBits_Writer_t   *encoderPtr     ///< [IN/OUT] encoderPtr
 )
 {
     // Write the TVL Id value
@@ -2043,7 +1884,7 @@ static void WriteSubParameterReplyOption
 static void WriteSubParameterNumberOfMessage
 (
     const cdmaPdu_t     *cdmaSmsPtr,    ///< [IN] Buffer to store decoded data
-    writeBitsBuffer_t  *encoderPtr     ///< [IN/OUT] encoderPtr
+    pduBits_Writer_t   *encoderPtr     ///< [IN/OUT] encoderPtr
 )
 {
     // Write the TVL Id value
@@ -2065,7 +1906,7 @@ static void WriteSubParameterNumberOfMessage
 static void WriteSubParameterAlertOnMessageDelivery
 (
     const cdmaPdu_t     *cdmaSmsPtr,    ///< [IN] Buffer to store decoded data
-    writeBitsBuffer_t  *encoderPtr     ///< [IN/OUT] encoderPtr
+    pduBits_Writer_t   *encoderPtr     ///< [IN/OUT] encoderPtr
 )
 {
     // Write the TVL Id value
@@ -2090,7 +1931,7 @@ static void WriteSubParameterAlertOnMessageDelivery
 static void WriteSubParameterLanguageIndicator
 (
     const cdmaPdu_t     *cdmaSmsPtr,    ///< [IN] Buffer to store decoded data
-    writeBitsBuffer_t  *encoderPtr     ///< [IN/OUT] encoderPtr
+    pduBits_Writer_t   *encoderPtr     ///< [IN/OUT] encoderPtr
 )
 {
     // Write the TVL Id value
@@ -2112,7 +1953,7 @@ static void WriteSubParameterLanguageIndicator
 static void WriteSubParameterCallBackNumber
 (
     const cdmaPdu_t     *cdmaSmsPtr,    ///< [IN] Buffer to store decoded data
-    writeBitsBuffer_t  *encoderPtr     ///< [IN/OUT] encoderPtr
+    pduBits_Writer_t   *encoderPtr     ///< [IN/OUT] encoderPtr
 )
 {
     // Write the TVL Id value
@@ -2131,7 +1972,7 @@ static void WriteSubParameterCallBackNumber
 static void WriteSubParameterMessageDisplayMode
 (
     const cdmaPdu_t     *cdmaSmsPtr,    ///< [IN] Buffer to store decoded data
-    writeBitsBuffer_t  *encoderPtr     ///< [IN/OUT] encoderPtr
+    pduBits_Writer_t   *encoderPtr     ///< [IN/OUT] encoderPtr
 )
 {
     // Write the TVL Id value
@@ -2156,7 +1997,7 @@ static void WriteSubParameterMessageDisplayMode
 static void WriteSubParameterMessageDepositIndex
 (
     const cdmaPdu_t     *cdmaSmsPtr,    ///< [IN] Buffer to store decoded data
-    writeBitsBuffer_t  *encoderPtr     ///< [IN/OUT] encoderPtr
+    pduBits_Writer_t   *encoderPtr     ///< [IN/OUT] encoderPtr
 )
 {
     // Write the TVL Id value
@@ -2178,7 +2019,7 @@ static void WriteSubParameterMessageDepositIndex
 static void WriteSubParameterMessageStatus
 (
     const cdmaPdu_t     *cdmaSmsPtr,    ///< [IN] Buffer to store decoded data
-    writeBitsBuffer_t  *encoderPtr     ///< [IN/OUT] encoderPtr
+    pduBits_Writer_t   *encoderPtr     ///< [IN/OUT] encoderPtr
 )
 {
     // Write the TVL Id value
@@ -2203,7 +2044,7 @@ static void WriteSubParameterMessageStatus
 static void WriteSubParameterTPFailureCause
 (
     const cdmaPdu_t     *cdmaSmsPtr,    ///< [IN] Buffer to store decoded data
-    writeBitsBuffer_t  *encoderPtr     ///< [IN/OUT] encoderPtr
+    pduBits_Writer_t   *encoderPtr     ///< [IN/OUT] encoderPtr
 )
 {
     // Write the TVL Id value
@@ -2225,7 +2066,7 @@ static void WriteSubParameterTPFailureCause
 static void WriteParameterBearerData
 (
     const cdmaPdu_t     *cdmaSmsPtr,    ///< [IN] Buffer to store decoded data
-    writeBitsBuffer_t   *encoderPtr     ///< [IN/OUT] encoderPtr
+    pduBits_Writer_t    *encoderPtr     ///< [IN/OUT] encoderPtr
 )
 {
     // Write the TVL Id value
@@ -2395,17 +2236,17 @@ le_result_t cdmaPdu_Decode
     cdmaPdu_t       *cdmaSmsPtr     ///< [OUT] Buffer to store decoded data
 )
 {
-    readBitsBuffer_t pduBuffer;
+    pduBits_Reader_t pduBuffer;
     size_t pduSize = dataPtrSize;
 
     // Reset the output.
     memset(cdmaSmsPtr,0,sizeof(*cdmaSmsPtr));
 
     // Initialize the decoder
-    InitializeReadBuffer(&pduBuffer, dataPtr);
+    pduBits_InitReader(&pduBuffer, dataPtr);
 
     // Read message format
-    cdmaSmsPtr->messageFormat = ReadBits(&pduBuffer,8);
+    cdmaSmsPtr->messageFormat = pduBits_Read(&pduBuffer,8);
     pduSize--;
 
     while (pduSize>0)
@@ -2436,13 +2277,13 @@ le_result_t cdmaPdu_Encode
     uint32_t        *pduByteSize    ///< [OUT] size of the encoded pdu in bytes
 )
 {
-    writeBitsBuffer_t pduBuffer;
+    pduBits_Writer_t pduBuffer;
 
     // Reset the output.
     memset(dataPtr,0,dataPtrSize);
 
     // Initialize the encoder
-    InitializeWriteBuffer(&pduBuffer, dataPtr, dataPtrSize);
+    pduBits_InitWriter(&pduBuffer, dataPtr, dataPtrSize);
 
     // Write message format
     WriteBits(&pduBuffer,cdmaSmsPtr->messageFormat,8);
@@ -16,6 +16,7 @@
 #include "pa_mdc.h"
 #include "le_ms_local.h"
 #include "watchdogChain.h"
+#include "apnTable.h"
 
 //--------------------------------------------------------------------------------------------------
 // Symbol and Enum definitions.
@@ -36,6 +37,22 @@
 #define APN_MCCMNC_FILE le_arg_GetArg(1)
 #endif
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * The binary APN tables generated from the APN files at build time. They are used first, the APN
+ * files being read only if a table is not available.
+ */
+//--------------------------------------------------------------------------------------------------
+#ifdef LEGATO_EMBEDDED
+#define APN_IIN_TABLE    \
+    "/legato/systems/current/apps/modemService/read-only/usr/local/share/apns-iin.bin"
+#define APN_MCCMNC_TABLE \
+    "/legato/systems/current/apps/modemService/read-only/usr/local/share/apns-mccmnc.bin"
+#else
+#define APN_IIN_TABLE    le_arg_GetArg(2)
+#define APN_MCCMNC_TABLE le_arg_GetArg(3)
+#endif
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Maximum number of profile objects supported
@@ -144,6 +161,15 @@ static le_event_Id_t CommandEventId;
 //--------------------------------------------------------------------------------------------------
 static le_log_TraceRef_t TraceRef;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * APN tables, opened on first use.
+ */
+//--------------------------------------------------------------------------------------------------
+static apnTable_Ref_t IinTableRef;
+static apnTable_Ref_t MccMncTableRef;
+static bool ApnTablesOpened;
+
 /// Macro used to generate trace output in this module.
 /// Takes the same parameters as LE_DEBUG() et. al.
 #define TRACE(...) LE_TRACE(TraceRef, ##__VA_ARGS__)
@@ -558,6 +584,103 @@ static le_result_t FindApnWithIccidFromFile
     return result;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open the APN tables, once.
+ */
+//--------------------------------------------------------------------------------------------------
+static void OpenApnTables
+(
+    void
+)
+{
+    if (!ApnTablesOpened)
+    {
+        IinTableRef = apnTable_Open(APN_IIN_TABLE);
+        MccMncTableRef = apnTable_Open(APN_MCCMNC_TABLE);
+        ApnTablesOpened = true;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  This function will attempt to find the APN of the ICCID in the IIN table, or in the IIN file
+ *  if the table is not available.
+ *
+ * @return LE_OK        Function was able to find an APN
+ * @return LE_NOT_FOUND Function was not able to find an APN for this ICCID
+ * @return LE_FAULT     There was an issue with the APN source
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t FindApnWithIccid
+(
+    const char* iccidPtr,   ///< [IN]  iccid
+    char * iccidApnPtr,     ///< [OUT] apn for iccid
+    size_t iccidApnSize     ///< [IN]  size of iccidApn buffer
+)
+{
+    OpenApnTables();
+
+    if (NULL == IinTableRef)
+    {
+        LE_DEBUG("Search for ICCID %s in file %s", iccidPtr, APN_IIN_FILE);
+        return FindApnWithIccidFromFile(APN_IIN_FILE, iccidPtr, iccidApnPtr, iccidApnSize);
+    }
+
+    le_result_t result = apnTable_FindByIccid(IinTableRef, iccidPtr, iccidApnPtr, iccidApnSize);
+    if (LE_OK == result)
+    {
+        LE_INFO("Got APN '%s' for ICCID %s", iccidApnPtr, iccidPtr);
+    }
+    else if (LE_OVERFLOW == result)
+    {
+        LE_WARN("APN buffer is too small");
+        result = LE_FAULT;
+    }
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  This function will attempt to find the default APN of the MCC/MNC in the MCC/MNC table, or in
+ *  the MCC/MNC file if the table is not available.
+ *
+ * @return LE_OK        Function was able to find an APN
+ * @return LE_NOT_FOUND Function was not able to find an APN for this MCC/MNC
+ * @return LE_FAULT     There was an issue with the APN source
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t FindApnWithMccMnc
+(
+    const char* mccPtr,     ///< [IN]  mcc
+    const char* mncPtr,     ///< [IN]  mnc
+    char * mccMncApnPtr,    ///< [OUT] apn for mccmnc
+    size_t mccMncApnSize    ///< [IN]  size of mccMncApn buffer
+)
+{
+    OpenApnTables();
+
+    if (NULL == MccMncTableRef)
+    {
+        LE_DEBUG("Search for MCC/MNC %s/%s in file %s", mccPtr, mncPtr, APN_MCCMNC_FILE);
+        return FindApnWithMccMncFromFile(APN_MCCMNC_FILE, mccPtr, mncPtr,
+                                         mccMncApnPtr, mccMncApnSize);
+    }
+
+    le_result_t result = apnTable_FindByMccMnc(MccMncTableRef, mccPtr, mncPtr,
+                                               mccMncApnPtr, mccMncApnSize);
+    if (LE_OK == result)
+    {
+        LE_INFO("Got APN '%s' for MCC/MNC [%s/%s]", mccMncApnPtr, mccPtr, mncPtr);
+    }
+    else if (LE_OVERFLOW == result)
+    {
+        LE_WARN("APN buffer is too small");
+        result = LE_FAULT;
+    }
+    return result;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Handler to process a command
@@ -2037,13 +2160,10 @@ le_result_t le_mdc_SetDefaultAPN
         return LE_FAULT;
     }
 
-    LE_DEBUG("Search for ICCID %s in file %s", iccidString, APN_IIN_FILE);
-
     // Try to find the APN with the ICCID first
-    if (LE_OK != FindApnWithIccidFromFile(APN_IIN_FILE, iccidString,
-                                          defaultApn, sizeof(defaultApn)))
+    if (LE_OK != FindApnWithIccid(iccidString, defaultApn, sizeof(defaultApn)))
     {
-        LE_WARN("Could not find ICCID %s in file %s", iccidString, APN_IIN_FILE);
+        LE_WARN("Could not find ICCID %s", iccidString);
 
         // Fallback mechanism: try to find the APN with the MCC/MNC
 
@@ -2056,13 +2176,9 @@ le_result_t le_mdc_SetDefaultAPN
             return LE_FAULT;
         }
 
-        LE_DEBUG("Search for MCC/MNC %s/%s in file %s", mccString, mncString, APN_MCCMNC_FILE);
-
-        if (LE_OK != FindApnWithMccMncFromFile(APN_MCCMNC_FILE, mccString, mncString,
-                                               defaultApn, sizeof(defaultApn)))
+        if (LE_OK != FindApnWithMccMnc(mccString, mncString, defaultApn, sizeof(defaultApn)))
         {
-            LE_WARN("Could not find MCC/MNC %s/%s in file %s",
-                    mccString, mncString, APN_MCCMNC_FILE);
+            LE_WARN("Could not find MCC/MNC %s/%s", mccString, mncString);
             return LE_FAULT;
         }
     }
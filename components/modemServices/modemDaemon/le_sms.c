@@ -107,6 +107,9 @@ typedef struct le_sms_Msg
     char              timestamp[LE_SMS_TIMESTAMP_MAX_BYTES]; ///< SMS time stamp (in text mode).
     pa_sms_Pdu_t      pdu;                                 ///< SMS PDU.
     bool              pduReady;                            ///< Is the PDU value ready?
+    pa_sms_Protocol_t pduProtocol;                         ///< Protocol of the encoded PDU.
+    bool              pduStatusReport;                     ///< Status report requested in the
+                                                           ///< encoded PDU.
     union
     {
         char          text[LE_SMS_TEXT_MAX_BYTES];         ///< SMS text.
@@ -127,6 +130,7 @@ typedef struct le_sms_Msg
     void*             callBackPtr;                         ///< Callback response.
     void*             ctxPtr;                              ///< Context.
     le_msg_SessionRef_t sessionRef;                        ///< Client session reference.
+    le_clk_Time_t     queueTime;                           ///< Time the sending was requested.
 
     /// SMS Status Report parameters
     uint8_t           messageReference;                             ///< TP Message Reference
@@ -192,6 +196,22 @@ typedef struct
 le_sms_MsgStats_t;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Data structure for the sending latency statistics, in milliseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t count;         ///< Number of sending attempts.
+    uint64_t queueSumMs;    ///< Sum of the times spent waiting for the modem.
+    uint32_t queueMaxMs;    ///< Longest time spent waiting for the modem.
+    uint64_t sendSumMs;     ///< Sum of the sending times.
+    uint32_t sendMaxMs;     ///< Longest sending time.
+}
+SendLatencyStats_t;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * session context node structure used for the SessionCtxList list.
@@ -346,6 +366,13 @@ static le_sem_Ref_t SmsSem;
 //--------------------------------------------------------------------------------------------------
 static le_sms_MsgStats_t MessageStats;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sending latency statistics. Protected by SmsSem.
+ */
+//--------------------------------------------------------------------------------------------------
+static SendLatencyStats_t SendLatencyStats;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * SMS Status Report activation state.
@@ -1385,11 +1412,93 @@ static le_result_t EncodeMessageToPdu
     else
     {
         msgPtr->pduReady = true;
+        msgPtr->pduProtocol = msgPtr->protocol;
+        msgPtr->pduStatusReport = StatusReportActivation;
     }
 
     return result;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether the PDU of a message can be sent as is. A PDU encoded by the service is only
+ * valid for the protocol and the status report request it was encoded with, so that it is encoded
+ * once and sent again without encoding as long as they do not change.
+ *
+ * @return true if the PDU is up to date, false if it must be encoded.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsPduUpToDate
+(
+    le_sms_Msg_t* msgPtr         ///< [IN] The message to check.
+)
+{
+    if (!msgPtr->pduReady)
+    {
+        return false;
+    }
+
+    // PDU set by the client or received from the network
+    if ((LE_SMS_FORMAT_PDU == msgPtr->format) || msgPtr->readonly)
+    {
+        return true;
+    }
+
+    return ((msgPtr->pduProtocol == msgPtr->protocol) &&
+            (msgPtr->pduStatusReport == StatusReportActivation));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert a time to milliseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t TimeToMs
+(
+    le_clk_Time_t time          ///< [IN] The time to convert.
+)
+{
+    return (uint32_t)(time.sec * 1000 + time.usec / 1000);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Update and report the sending latency statistics once a message has been sent. Must be called
+ * with SmsSem held.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReportSendLatency
+(
+    le_sms_Msg_t* msgPtr,        ///< [IN] The sent message.
+    le_clk_Time_t startTime      ///< [IN] Time the modem started to send the message.
+)
+{
+    uint32_t queueMs = TimeToMs(le_clk_Sub(startTime, msgPtr->queueTime));
+    uint32_t sendMs = TimeToMs(le_clk_Sub(le_clk_GetRelativeTime(), startTime));
+    SendLatencyStats_t* statsPtr = &SendLatencyStats;
+
+    statsPtr->count++;
+    statsPtr->queueSumMs += queueMs;
+    statsPtr->sendSumMs += sendMs;
+
+    if (queueMs > statsPtr->queueMaxMs)
+    {
+        statsPtr->queueMaxMs = queueMs;
+    }
+
+    if (sendMs > statsPtr->sendMaxMs)
+    {
+        statsPtr->sendMaxMs = sendMs;
+    }
+
+    LE_INFO("Message %p status %d: queued %"PRIu32" ms, sent in %"PRIu32" ms "
+            "(%"PRIu32" messages: queued %"PRIu64"/%"PRIu32" ms, sent in %"PRIu64"/%"PRIu32" ms "
+            "average/max)",
+            msgPtr, msgPtr->pdu.status, queueMs, sendMs, statsPtr->count,
+            statsPtr->queueSumMs / statsPtr->count, statsPtr->queueMaxMs,
+            statsPtr->sendSumMs / statsPtr->count, statsPtr->sendMaxMs);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Create a session context.
@@ -1958,8 +2067,8 @@ static le_result_t CheckAndEncodeMessage
         return LE_FAULT;
     }
 
-    // Encode data
-    if (!msgPtr->pduReady)
+    // Encode data, unless the PDU encoded for a previous sending is still valid
+    if (!IsPduUpToDate(msgPtr))
     {
         result = EncodeMessageToPdu(msgPtr);
     }
@@ -2053,6 +2162,7 @@ static le_result_t SendAsyncSMS
         msgCommand.msgRef = msgRef;
         msgPtr->callBackPtr = callBack;
         msgPtr->ctxPtr = context;
+        msgPtr->queueTime = le_clk_GetRelativeTime();
 
         LE_INFO("Send Send command for message (%p)", msgRef);
         le_event_Report(SmsCommandEventId, &msgCommand, sizeof(msgCommand));
@@ -2097,6 +2207,7 @@ static void ProcessSmsSendingCommandHandler
             le_sem_Wait(SmsSem);
             LE_INFO("LE_SMS_CMD_TYPE_SEND message (%p) ", messageRef);
 
+            le_clk_Time_t startTime = le_clk_GetRelativeTime();
             res = pa_sms_SendPduMsg(msgPtr->protocol, msgPtr->pdu.dataLen, msgPtr->pdu.data,
                                     &msgPtr->messageReference, PA_SMS_SENDING_TIMEOUT,
                                     &msgPtr->pdu.errorCode);
@@ -2113,6 +2224,7 @@ static void ProcessSmsSendingCommandHandler
                 msgPtr->pdu.status = LE_SMS_SENDING_FAILED;
             }
             LE_INFO("Async send command status: %d", msgPtr->pdu.status);
+            ReportSendLatency(msgPtr, startTime);
             le_sem_Post(SmsSem);
             SendSmsSendingStateEvent(messageRef);
         }
@@ -2905,9 +3017,17 @@ size_t le_sms_GetPDULen
         return 0;
     }
 
-    if ((msgPtr->readonly == false) && (!msgPtr->pduReady))
+    if ((msgPtr->readonly == false) && (msgPtr->protocol != PA_SMS_PROTOCOL_GW_CB))
     {
-        EncodeMessageToPdu(msgPtr);
+        /* Get transport layer protocol, the PDU is only valid for the one it was encoded for */
+        if (LE_OK != GetProtocol(&msgPtr->protocol))
+        {
+            return 0;
+        }
+        if (!IsPduUpToDate(msgPtr))
+        {
+            EncodeMessageToPdu(msgPtr);
+        }
     }
 
     if (msgPtr->pduReady)
@@ -3533,16 +3653,17 @@ le_result_t le_sms_GetPDU
         return LE_FAULT;
     }
 
-    if ((msgPtr->readonly == false)
-                    && (msgPtr->protocol != PA_SMS_PROTOCOL_GW_CB)
-                    && (!msgPtr->pduReady))
+    if ((msgPtr->readonly == false) && (msgPtr->protocol != PA_SMS_PROTOCOL_GW_CB))
     {
-        /* Get transport layer protocol */
+        /* Get transport layer protocol, the PDU is only valid for the one it was encoded for */
         if (LE_OK != GetProtocol(&msgPtr->protocol))
         {
             return LE_FAULT;
         }
-        EncodeMessageToPdu(msgPtr);
+        if (!IsPduUpToDate(msgPtr))
+        {
+            EncodeMessageToPdu(msgPtr);
+        }
     }
 
     if (!msgPtr->pduReady)
@@ -3732,10 +3853,17 @@ le_result_t le_sms_Send
         LE_DEBUG("Try to send PDU Msg %p, pdu.%p, pduLen.%u with protocol %d",
                         msgPtr, msgPtr->pdu.data, msgPtr->pdu.dataLen, msgPtr->protocol);
 
+        msgPtr->queueTime = le_clk_GetRelativeTime();
         le_sem_Wait(SmsSem);
+        le_clk_Time_t startTime = le_clk_GetRelativeTime();
         result = pa_sms_SendPduMsg(msgPtr->protocol, msgPtr->pdu.dataLen, msgPtr->pdu.data,
                                    &msgPtr->messageReference, PA_SMS_SENDING_TIMEOUT,
                                    &msgPtr->pdu.errorCode);
+        if (result >= 0)
+        {
+            msgPtr->pdu.status = LE_SMS_SENT;
+        }
+        ReportSendLatency(msgPtr, startTime);
         le_sem_Post(SmsSem);
 
         if (result < 0)
@@ -3748,7 +3876,6 @@ le_result_t le_sms_Send
         }
         else
         {
-            msgPtr->pdu.status = LE_SMS_SENT;
             result = LE_OK;
 
             // Update sent message count if necessary
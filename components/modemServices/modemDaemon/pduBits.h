@@ -0,0 +1,374 @@
+/** @file pduBits.h
+ *
+ * Bit-level packing shared by the GSM and CDMA PDU codecs:
+ *  - a bit-stream reader and writer, most significant bit first, with a 64-bit cache so that
+ *    fields up to 32 bits are read and written with a few shifts instead of a loop over bits,
+ *  - a GSM 7-bit packer and unpacker, least significant bit first (3GPP TS 23.038), working
+ *    on groups of 8 septets held in a 64-bit word, which fill exactly 7 bytes.
+ *
+ * The functions are inlined in the codecs, as they are called for each field or character.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#ifndef PDUBITS_INCLUDE_GUARD
+#define PDUBITS_INCLUDE_GUARD
+
+#include "legato.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of septets in a group, and number of bytes that such a group fills.
+ */
+//--------------------------------------------------------------------------------------------------
+#define PDUBITS_SEPTETS_PER_GROUP   8
+#define PDUBITS_BYTES_PER_GROUP     7
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of bytes filled by a number of packed septets.
+ */
+//--------------------------------------------------------------------------------------------------
+#define PDUBITS_SEPTETS_TO_BYTES(count)     (((count) * 7 + 7) / 8)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Bit-stream reader. The index is the number of bytes loaded in the cache: it can be moved by the
+ * caller once the cache has been emptied with pduBits_AlignReader().
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const uint8_t*  bufferPtr;      ///< Buffer to read
+    uint32_t        index;          ///< Index of the next byte to load in the cache
+    uint64_t        cache;          ///< Bits loaded and not read yet, in the low cacheSize bits
+    uint8_t         cacheSize;      ///< Number of bits in the cache
+}
+pduBits_Reader_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Bit-stream writer. The index is the number of complete bytes written in the buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint8_t*        bufferPtr;      ///< Buffer to write
+    uint32_t        bufferSize;     ///< Buffer size
+    uint32_t        index;          ///< Index of the next byte to write in the buffer
+    uint64_t        cache;          ///< Bits not written yet, in the low cacheSize bits
+    uint8_t         cacheSize;      ///< Number of bits in the cache, less than 8
+}
+pduBits_Writer_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pack a group of septets in a word, the first septet in the least significant bits.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline uint64_t pduBits_LoadSeptets
+(
+    const uint8_t* septetsPtr,      ///< [IN] Septets
+    size_t         count            ///< [IN] Number of septets, up to PDUBITS_SEPTETS_PER_GROUP
+)
+{
+    uint64_t word = 0;
+    size_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        word |= (uint64_t)(septetsPtr[i] & 0x7F) << (7 * i);
+    }
+
+    return word;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unpack a group of septets from a word, the first septet in the least significant bits.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline void pduBits_StoreSeptets
+(
+    uint64_t word,                  ///< [IN]  Packed septets
+    size_t   count,                 ///< [IN]  Number of septets, up to PDUBITS_SEPTETS_PER_GROUP
+    uint8_t* septetsPtr             ///< [OUT] Septets
+)
+{
+    size_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        septetsPtr[i] = (uint8_t)(word >> (7 * i)) & 0x7F;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Load little-endian bytes in a word.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline uint64_t pduBits_LoadBytes
+(
+    const uint8_t* bufferPtr,       ///< [IN] Bytes
+    size_t         size             ///< [IN] Number of bytes, up to 8
+)
+{
+    uint64_t word = 0;
+    size_t i;
+
+    for (i = 0; i < size; i++)
+    {
+        word |= (uint64_t)bufferPtr[i] << (8 * i);
+    }
+
+    return word;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Store a word in little-endian bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline void pduBits_StoreBytes
+(
+    uint64_t word,                  ///< [IN]  Word
+    size_t   size,                  ///< [IN]  Number of bytes, up to 8
+    uint8_t* bufferPtr              ///< [OUT] Bytes
+)
+{
+    size_t i;
+
+    for (i = 0; i < size; i++)
+    {
+        bufferPtr[i] = (uint8_t)(word >> (8 * i));
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize a bit-stream reader.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline void pduBits_InitReader
+(
+    pduBits_Reader_t* readerPtr,    ///< [OUT] Reader
+    const uint8_t*    bufferPtr     ///< [IN]  Buffer to read
+)
+{
+    readerPtr->bufferPtr = bufferPtr;
+    readerPtr->index = 0;
+    readerPtr->cache = 0;
+    readerPtr->cacheSize = 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the next bits of a bit stream.
+ *
+ * @return The value of the bits, or 0 if length is not between 1 and 32.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline uint32_t pduBits_Read
+(
+    pduBits_Reader_t* readerPtr,    ///< [IN/OUT] Reader
+    uint8_t           length        ///< [IN]     Number of bits to read, from 1 to 32
+)
+{
+    if ((0 == length) || (length > 32))
+    {
+        LE_WARN("Cannot read %u bits", length);
+        return 0;
+    }
+
+    // At most 7 bits are left in the cache, so that it holds up to 39 bits after loading.
+    while (readerPtr->cacheSize < length)
+    {
+        readerPtr->cache = (readerPtr->cache << 8) | readerPtr->bufferPtr[readerPtr->index++];
+        readerPtr->cacheSize += 8;
+    }
+
+    readerPtr->cacheSize -= length;
+
+    return (uint32_t)((readerPtr->cache >> readerPtr->cacheSize) & ((1ULL << length) - 1));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Skip the bits left in the current byte of a bit stream.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline void pduBits_AlignReader
+(
+    pduBits_Reader_t* readerPtr     ///< [IN/OUT] Reader
+)
+{
+    readerPtr->cache = 0;
+    readerPtr->cacheSize = 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize a bit-stream writer.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline void pduBits_InitWriter
+(
+    pduBits_Writer_t* writerPtr,    ///< [OUT] Writer
+    uint8_t*          bufferPtr,    ///< [IN]  Buffer to write
+    uint32_t          bufferSize    ///< [IN]  Buffer size
+)
+{
+    writerPtr->bufferPtr = bufferPtr;
+    writerPtr->bufferSize = bufferSize;
+    writerPtr->index = 0;
+    writerPtr->cache = 0;
+    writerPtr->cacheSize = 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write bits in a bit stream.
+ *
+ * @return
+ *  - LE_OK             The bits are written.
+ *  - LE_BAD_PARAMETER  The length is not between 1 and 32.
+ *  - LE_OVERFLOW       The buffer is too small, nothing is written.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline le_result_t pduBits_Write
+(
+    pduBits_Writer_t* writerPtr,    ///< [IN/OUT] Writer
+    uint32_t          value,        ///< [IN]     Value of the bits
+    uint8_t           length        ///< [IN]     Number of bits to write, from 1 to 32
+)
+{
+    uint8_t cacheSize = writerPtr->cacheSize + length;
+
+    if ((0 == length) || (length > 32))
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    if ((writerPtr->index + cacheSize / 8) > writerPtr->bufferSize)
+    {
+        return LE_OVERFLOW;
+    }
+
+    writerPtr->cache = (writerPtr->cache << length) | (value & ((1ULL << length) - 1));
+
+    while (cacheSize >= 8)
+    {
+        cacheSize -= 8;
+        writerPtr->bufferPtr[writerPtr->index++] = (uint8_t)(writerPtr->cache >> cacheSize);
+    }
+
+    writerPtr->cache &= (1ULL << cacheSize) - 1;
+    writerPtr->cacheSize = cacheSize;
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Complete the current byte of a bit stream with 0 bits.
+ *
+ * @return
+ *  - LE_OK             The byte is written, or there was no bit to write.
+ *  - LE_OVERFLOW       The buffer is too small.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline le_result_t pduBits_AlignWriter
+(
+    pduBits_Writer_t* writerPtr     ///< [IN/OUT] Writer
+)
+{
+    le_result_t result = LE_OK;
+
+    if (writerPtr->cacheSize)
+    {
+        if (writerPtr->index < writerPtr->bufferSize)
+        {
+            writerPtr->bufferPtr[writerPtr->index++] =
+                (uint8_t)(writerPtr->cache << (8 - writerPtr->cacheSize));
+        }
+        else
+        {
+            result = LE_OVERFLOW;
+        }
+    }
+
+    writerPtr->cache = 0;
+    writerPtr->cacheSize = 0;
+
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pack GSM septets. The unused bits of the last byte are set to 0.
+ *
+ * @return The number of bytes written, PDUBITS_SEPTETS_TO_BYTES(count).
+ */
+//--------------------------------------------------------------------------------------------------
+static inline size_t pduBits_PackSeptets
+(
+    const uint8_t* septetsPtr,      ///< [IN]  Septets, one per byte
+    size_t         count,           ///< [IN]  Number of septets
+    uint8_t*       bufferPtr        ///< [OUT] Packed septets
+)
+{
+    uint8_t* startPtr = bufferPtr;
+
+    // Complete groups, with constant bounds so that the loops are unrolled
+    for (; count >= PDUBITS_SEPTETS_PER_GROUP; count -= PDUBITS_SEPTETS_PER_GROUP)
+    {
+        pduBits_StoreBytes(pduBits_LoadSeptets(septetsPtr, PDUBITS_SEPTETS_PER_GROUP),
+                           PDUBITS_BYTES_PER_GROUP,
+                           bufferPtr);
+        septetsPtr += PDUBITS_SEPTETS_PER_GROUP;
+        bufferPtr += PDUBITS_BYTES_PER_GROUP;
+    }
+
+    if (count)
+    {
+        pduBits_StoreBytes(pduBits_LoadSeptets(septetsPtr, count),
+                           PDUBITS_SEPTETS_TO_BYTES(count),
+                           bufferPtr);
+        bufferPtr += PDUBITS_SEPTETS_TO_BYTES(count);
+    }
+
+    return bufferPtr - startPtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unpack GSM septets. Only the PDUBITS_SEPTETS_TO_BYTES(count) first bytes of the buffer are read.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline void pduBits_UnpackSeptets
+(
+    const uint8_t* bufferPtr,       ///< [IN]  Packed septets
+    size_t         count,           ///< [IN]  Number of septets
+    uint8_t*       septetsPtr       ///< [OUT] Septets, one per byte
+)
+{
+    // Complete groups, with constant bounds so that the loops are unrolled
+    for (; count >= PDUBITS_SEPTETS_PER_GROUP; count -= PDUBITS_SEPTETS_PER_GROUP)
+    {
+        pduBits_StoreSeptets(pduBits_LoadBytes(bufferPtr, PDUBITS_BYTES_PER_GROUP),
+                             PDUBITS_SEPTETS_PER_GROUP,
+                             septetsPtr);
+        septetsPtr += PDUBITS_SEPTETS_PER_GROUP;
+        bufferPtr += PDUBITS_BYTES_PER_GROUP;
+    }
+
+    if (count)
+    {
+        pduBits_StoreSeptets(pduBits_LoadBytes(bufferPtr, PDUBITS_SEPTETS_TO_BYTES(count)),
+                             count,
+                             septetsPtr);
+    }
+}
+
+#endif // PDUBITS_INCLUDE_GUARD
@@ -9,6 +9,7 @@
 #include "legato.h"
 #include "smsPdu.h"
 #include "cdmaPdu.h"
+#include "pduBits.h"
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -33,6 +34,9 @@ static le_log_TraceRef_t TraceRef;
 # define min(a, b) ((a)<(b) ? (a) : (b))
 #endif
 
+/* Maximum number of septets of a 7 bits user data, as TP-UDL is one byte */
+#define SEPTETS_MAX     256
+
 /* C.S0005-D v2.0 Table 2.7.1.3.2.4-4. Representation of DTMF Digits */
 static const char *DtmfChars = "D1234567890*#ABC";
 
@@ -528,6 +532,23 @@ const uint8_t Ascii7to8[] = {
 
 };
 
+/****************************************************************************
+ * This lookup table converts the character following an escape (27) in the
+ * 7 bit "default alphabet" extension table to ISO-8859-1. Characters which
+ * are not supported are set to 0, and replaced by the NPC8-character.
+ ****************************************************************************/
+static const uint8_t Ascii7to8Ext[128] = {
+    [10] = 12,      /* FORM FEED */
+    [20] = '^',
+    [40] = '{',
+    [41] = '}',
+    [47] = '\\',
+    [60] = '[',
+    [61] = '~',
+    [62] = ']',
+    [64] = '|',
+};
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Dump the PDU
@@ -560,77 +581,6 @@ static void DumpPdu
 }
 
 
-static inline unsigned int Read7Bits
-(
-    const uint8_t* bufferPtr,
-    uint32_t       pos
-)
-{
-    int a = bufferPtr[pos/8] >> (pos&7);
-    int b = 0;
-    if ((pos&7) > 1) {
-        b = bufferPtr[(pos/8)+1] << (8-(pos&7));
-    }
-
-    return (a|b) & 0x7F;
-}
-
-static inline void Write7Bits
-(
-    uint8_t* bufferPtr,
-    uint8_t  val,
-    uint32_t pos
-)
-{
-    val &= 0x7F;
-    uint8_t idx = pos/8;
-
-
-    if (!(pos&7)) {
-        bufferPtr[idx] = val;
-    }
-    else if ((pos&7) == 1) {
-        bufferPtr[idx] = bufferPtr[idx] | (val<<1);
-    }
-    else {
-        bufferPtr[idx] = bufferPtr[idx] | (val<<(pos&7));
-        bufferPtr[idx+1] = (val>>(8-(pos&7)));
-    }
-}
-
-static inline unsigned int ReadCdma7Bits
-(
-    const uint8_t* bufferPtr,
-    uint32_t       pos
-)
-{
-    uint8_t idx = pos/8;
-
-    return (((bufferPtr[idx]<<(pos&7))&0xFF)|(bufferPtr[idx+1]>>(8-(pos&7))))>>1;
-}
-
-static inline void WriteCdma7Bits
-(
-    uint8_t* bufferPtr,
-    uint8_t  val,
-    uint32_t pos
-)
-{
-    val &= 0x7F;
-    uint8_t idx = pos/8;
-
-    if (!(pos&7)) {
-        bufferPtr[idx] = val << 1;
-    }
-    else if ((pos&7) == 1) {
-        bufferPtr[idx] = bufferPtr[idx] | val;
-    }
-    else {
-        bufferPtr[idx] = bufferPtr[idx] | (val>>((pos&7)-1));
-        bufferPtr[idx+1] = ((val<<(8-((pos&7)-1)))&0xff);
-    }
-}
-
 /**
  * Convert an ascii array into a 7bits array
  * length is the number of bytes in the ascii buffer
@@ -647,49 +597,36 @@ static int32_t Convert8BitsTo7Bits
     uint8_t       *a7bitsNumber ///< [OUT] number of char in &7bitsPtr
 )
 {
-    int read;
-    int write = 0;
-    int size = 0;
+    uint8_t septets[LE_SMS_PDU_MAX_PAYLOAD * 8 / 7];
+    size_t  maxCount = min(a7bitSize * 8 / 7, sizeof(septets));
+    size_t  count = 0;
+    int     read;
 
+    /* Convert the characters with the lookup table, then pack all the septets at once */
     for (read = pos; read < length+pos; ++read)
     {
         uint8_t byte = Ascii8to7[a8bitPtr[read]];
+        bool    escaped = (byte >= 128);
 
-        /* Escape */
-        if (byte >= 128)
+        /* Check the room for the escape sequence as a whole before writing it */
+        if ((count + (escaped ? 2 : 1)) > maxCount)
         {
-            if (size>a7bitSize)
-            {
-                return LE_OVERFLOW;
-            }
-
-            Write7Bits(a7bitPtr, 0x1B, write*7);
-            write++;
-            byte -= 128;
+            return LE_OVERFLOW;
         }
 
-        if (size>a7bitSize)
+        /* Escape */
+        if (escaped)
         {
-            return LE_OVERFLOW;
+            septets[count++] = 0x1B;
+            byte -= 128;
         }
-
-        Write7Bits(a7bitPtr, byte, write*7);
-        write++;
-
-        /* Number of 8 bit chars */
-        size = (write * 7);
-        size = (size % 8 != 0) ? (size/8 + 1) : (size/8);
-    }
-
-    if (size>a7bitSize)
-    {
-        return LE_OVERFLOW;
+        septets[count++] = byte;
     }
 
     /* Number of written chars */
-    *a7bitsNumber = write;
+    *a7bitsNumber = count;
 
-    return size;
+    return pduBits_PackSeptets(septets, count, a7bitPtr);
 }
 
 /**
@@ -707,74 +644,39 @@ static int32_t Convert7BitsTo8Bits
     size_t         a8bitSize     ///< [IN] 8bits array size.
 )
 {
-    int r;
-    int w;
+    uint8_t septets[SEPTETS_MAX];
+    int     end = pos + length;
+    int     r;
+    int     w = 0;
 
-    w = 0;
-    for (r = pos; r < length+pos; r++)
+    if (end > SEPTETS_MAX)
     {
-        uint8_t byte = Read7Bits(a7bitPtr, r*7);
-        byte = Ascii7to8[byte];
+        return LE_OVERFLOW;
+    }
 
-        if (byte != 27)
-        {
-            if (w < a8bitSize)
-            {
-                a8bitPtr[w] = byte;
-                w++;
-            }
-            else
-            {
-                return LE_OVERFLOW;
-            }
-        }
-        else
+    /* Unpack all the septets at once, then convert them with the lookup tables */
+    pduBits_UnpackSeptets(a7bitPtr, end, septets);
+
+    for (r = pos; r < end; r++)
+    {
+        uint8_t byte = Ascii7to8[septets[r]];
+
+        if (byte == 27)
         {
             /* If we're escaped then the next byte have a special meaning. */
             r++;
+            byte = (r < end) ? Ascii7to8Ext[septets[r]] : 0;
+            byte = (byte != 0) ? byte : NPC8;
+        }
 
-            byte = Read7Bits(a7bitPtr, r*7);
-            if (w < a8bitSize)
-            {
-                switch (byte)
-                {
-                    case 10:
-                        a8bitPtr[w] = 12;
-                        break;
-                    case 20:
-                        a8bitPtr[w] = '^';
-                        break;
-                    case 40:
-                        a8bitPtr[w] = '{';
-                        break;
-                    case 41:
-                        a8bitPtr[w] = '}';
-                        break;
-                    case 47:
-                        a8bitPtr[w] = '\\';
-                        break;
-                    case 60:
-                        a8bitPtr[w] = '[';
-                        break;
-                    case 61:
-                        a8bitPtr[w] = '~';
-                        break;
-                    case 62:
-                        a8bitPtr[w] = ']';
-                        break;
-                    case 64:
-                        a8bitPtr[w] = '|';
-                        break;
-                    default:
-                        a8bitPtr[w] = NPC8;
-                        break;
-                }
-                w++;
-            }
-            else
-            {
-                return LE_OVERFLOW;
-            }
+        if (w < a8bitSize)
+        {
+            a8bitPtr[w] = byte;
+            w++;
+        }
+        else
+        {
+            return LE_OVERFLOW;
         }
     }
 
@@ -1846,29 +1748,27 @@ static le_result_t EncodeCdma7BitsData
     uint8_t       *a7bitsNumber ///< [OUT] number of char in 7bitsPtr
 )
 {
+    pduBits_Writer_t writer;
     int read;
-    int write = 0;
-    int size = 0;
 
     memset(a7bitPtr,0,a7bitSize);
+    pduBits_InitWriter(&writer, a7bitPtr, a7bitSize);
 
     for (read = 0; read < a8bitPtrSize; ++read)
     {
-        if (size>a7bitSize)
+        if (LE_OK != pduBits_Write(&writer, a8bitPtr[read], 7))
         {
             return LE_OVERFLOW;
         }
+    }
 
-        WriteCdma7Bits(a7bitPtr, a8bitPtr[read], write*7);
-        write++;
-
-        /* Number of 8 bit chars */
-        size = (write * 7);
-        size = (size % 8 != 0) ? (size/8 + 1) : (size/8);
+    if (LE_OK != pduBits_AlignWriter(&writer))
+    {
+        return LE_OVERFLOW;
     }
 
     /* Number of written chars */
-    *a7bitsNumber = write;
+    *a7bitsNumber = read;
 
     return LE_OK;
 }
@@ -1890,16 +1790,17 @@ static le_result_t DecodeCdma7bitsData
     uint32_t      *a8bitNumber   ///< [OUT] number of char written
 )
 {
-    int read;
+    pduBits_Reader_t reader;
     int write;
 
     memset(a8bitPtr,0,a8bitSize);
+    pduBits_InitReader(&reader, a7bitPtr);
 
-    for (read = 0, write = 0; read < a7bitPtrSize; read++, write++)
+    for (write = 0; write < a7bitPtrSize; write++)
     {
         if (write < a8bitSize)
         {
-            a8bitPtr[write] = ReadCdma7Bits(a7bitPtr, read*7);
+            a8bitPtr[write] = pduBits_Read(&reader, 7);
         }
         else
         {
@@ -0,0 +1,465 @@
+/**
+ * @file nmeaStream.c
+ *
+ * Implementation of the shared NMEA stream ring. See nmeaStream.h.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "nmeaStream.h"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Ring identification.
+ */
+//--------------------------------------------------------------------------------------------------
+#define RING_MAGIC      0x4e4d4541      // "NMEA"
+#define RING_VERSION    1
+
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC     0x0001U
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Ring slot.
+ *
+ * The writer stores the sequence number of the chunk plus one in begin, then the content, then
+ * the same value in end. A reader copies end, the content and begin in the reverse order: the
+ * copy is consistent if both values match the chunk it expects.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t begin;                                 ///< Stamp written before the content.
+    uint32_t end;                                   ///< Stamp written after the content.
+    uint32_t len;                                   ///< Chunk length.
+    char     data[NMEA_STREAM_SLOT_DATA_BYTES];     ///< Chunk data.
+}
+Slot_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Ring header, followed by the slots in the memory file.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t magic;         ///< RING_MAGIC.
+    uint32_t version;       ///< RING_VERSION.
+    uint32_t slotCount;     ///< Number of slots, power of two.
+    uint32_t slotSize;      ///< Size of a slot.
+    uint32_t writeSeq;      ///< Number of chunks written. This is also the futex readers wait on.
+    uint32_t reserved[3];   ///< Reserved, keeps the slots 8-byte aligned.
+    Slot_t   slots[];       ///< Slots.
+}
+Ring_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reader of the ring.
+ */
+//--------------------------------------------------------------------------------------------------
+struct nmeaStream_Reader
+{
+    const Ring_t* ringPtr;      ///< Read-only mapping of the ring.
+    size_t        mapSize;      ///< Size of the mapping.
+    uint32_t      readSeq;      ///< Sequence number of the next chunk to read.
+    uint32_t      overrunCount; ///< Number of chunks lost.
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Ring of the process, on the writer side.
+ */
+//--------------------------------------------------------------------------------------------------
+static Ring_t* RingPtr = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Memory file of the ring, on the writer side.
+ */
+//--------------------------------------------------------------------------------------------------
+static int RingFd = -1;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool of readers.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t ReaderPool;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the size of a ring.
+ *
+ * @return The size in bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t RingSize
+(
+    uint32_t slotCount      ///< [IN] Number of slots.
+)
+{
+    return sizeof(Ring_t) + ((size_t)slotCount * sizeof(Slot_t));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create the NMEA stream ring of the process.
+ *
+ * @return
+ *      - LE_OK on success.
+ *      - LE_DUPLICATE if the ring is already created.
+ *      - LE_BAD_PARAMETER if the slot count is not a power of two.
+ *      - LE_NOT_IMPLEMENTED if memory files are not supported.
+ *      - LE_FAULT on any other failure.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t nmeaStream_Create
+(
+    uint32_t slotCount      ///< [IN] Number of slots of the ring.
+)
+{
+    if (NULL != RingPtr)
+    {
+        return LE_DUPLICATE;
+    }
+
+    if ((0 == slotCount) || (0 != (slotCount & (slotCount - 1))))
+    {
+        LE_ERROR("Slot count %" PRIu32 " is not a power of two", slotCount);
+        return LE_BAD_PARAMETER;
+    }
+
+#ifdef SYS_memfd_create
+    size_t size = RingSize(slotCount);
+    int fd = syscall(SYS_memfd_create, "nmeaStream", MFD_CLOEXEC);
+
+    if (-1 == fd)
+    {
+        LE_ERROR("Unable to create NMEA stream memory file: %m");
+        return (ENOSYS == errno) ? LE_NOT_IMPLEMENTED : LE_FAULT;
+    }
+
+    if (-1 == ftruncate(fd, size))
+    {
+        LE_ERROR("Unable to size NMEA stream memory file: %m");
+        close(fd);
+        return LE_FAULT;
+    }
+
+    void* mapPtr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (MAP_FAILED == mapPtr)
+    {
+        LE_ERROR("Unable to map NMEA stream memory file: %m");
+        close(fd);
+        return LE_FAULT;
+    }
+
+    // The memory file is zero-filled: no slot holds a valid stamp yet
+    RingPtr = mapPtr;
+    RingPtr->magic = RING_MAGIC;
+    RingPtr->version = RING_VERSION;
+    RingPtr->slotCount = slotCount;
+    RingPtr->slotSize = sizeof(Slot_t);
+    __atomic_store_n(&RingPtr->writeSeq, 0, __ATOMIC_RELEASE);
+    RingFd = fd;
+
+    LE_DEBUG("NMEA stream ring created: %" PRIu32 " slots, %zu bytes", slotCount, size);
+    return LE_OK;
+#else
+    LE_ERROR("Memory files are not supported");
+    return LE_NOT_IMPLEMENTED;
+#endif
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write a NMEA frame to the ring. The function never blocks: slow readers lose the oldest frames.
+ */
+//--------------------------------------------------------------------------------------------------
+void nmeaStream_Write
+(
+    const char* framePtr,   ///< [IN] Frame to write.
+    size_t      frameLen    ///< [IN] Frame length in bytes.
+)
+{
+    if ((NULL == RingPtr) || (0 == frameLen))
+    {
+        return;
+    }
+
+    // Only the writer modifies writeSeq
+    uint32_t seq = RingPtr->writeSeq;
+    uint32_t mask = RingPtr->slotCount - 1;
+
+    while (frameLen > 0)
+    {
+        Slot_t* slotPtr = &RingPtr->slots[seq & mask];
+        size_t len = (frameLen > NMEA_STREAM_SLOT_DATA_BYTES) ?
+                     NMEA_STREAM_SLOT_DATA_BYTES : frameLen;
+
+        __atomic_store_n(&slotPtr->begin, seq + 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        memcpy(slotPtr->data, framePtr, len);
+        slotPtr->len = len;
+        __atomic_store_n(&slotPtr->end, seq + 1, __ATOMIC_RELEASE);
+
+        seq++;
+        framePtr += len;
+        frameLen -= len;
+    }
+
+    // Publish the frame and wake up the readers waiting for it
+    __atomic_store_n(&RingPtr->writeSeq, seq, __ATOMIC_RELEASE);
+    syscall(SYS_futex, &RingPtr->writeSeq, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get a new read-only file descriptor on the ring, to be handed out to a reader.
+ *
+ * @return The file descriptor, owned by the caller, or -1 on failure.
+ */
+//--------------------------------------------------------------------------------------------------
+int nmeaStream_GetReaderFd
+(
+    void
+)
+{
+    char path[32];
+    int fd;
+
+    if (-1 == RingFd)
+    {
+        return -1;
+    }
+
+    // Reopen the memory file read-only so that readers cannot map it writable
+    snprintf(path, sizeof(path), "/proc/self/fd/%d", RingFd);
+    fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (-1 == fd)
+    {
+        LE_ERROR("Unable to reopen NMEA stream memory file: %m");
+    }
+
+    return fd;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open a reader on a ring. The reader starts at the current end of the stream.
+ *
+ * @return The reader reference, or NULL if the file descriptor does not hold a valid ring.
+ *
+ * @note The file descriptor is closed by this function in all cases.
+ */
+//--------------------------------------------------------------------------------------------------
+nmeaStream_ReaderRef_t nmeaStream_Open
+(
+    int fd                  ///< [IN] Ring file descriptor, from le_gnss_GetNmeaStream().
+)
+{
+    struct stat st;
+    const Ring_t* ringPtr;
+
+    if (fd < 0)
+    {
+        return NULL;
+    }
+
+    if ((-1 == fstat(fd, &st)) || ((size_t)st.st_size < sizeof(Ring_t)))
+    {
+        LE_ERROR("Invalid NMEA stream file");
+        close(fd);
+        return NULL;
+    }
+
+    ringPtr = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (MAP_FAILED == ringPtr)
+    {
+        LE_ERROR("Unable to map NMEA stream: %m");
+        return NULL;
+    }
+
+    if ((RING_MAGIC != ringPtr->magic) || (RING_VERSION != ringPtr->version) ||
+        (sizeof(Slot_t) != ringPtr->slotSize) || (0 == ringPtr->slotCount) ||
+        (0 != (ringPtr->slotCount & (ringPtr->slotCount - 1))) ||
+        ((size_t)st.st_size < RingSize(ringPtr->slotCount)))
+    {
+        LE_ERROR("Invalid NMEA stream ring");
+        munmap((void*)ringPtr, st.st_size);
+        return NULL;
+    }
+
+    nmeaStream_ReaderRef_t readerRef = le_mem_ForceAlloc(ReaderPool);
+    readerRef->ringPtr = ringPtr;
+    readerRef->mapSize = st.st_size;
+    readerRef->readSeq = __atomic_load_n(&ringPtr->writeSeq, __ATOMIC_ACQUIRE);
+    readerRef->overrunCount = 0;
+
+    return readerRef;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close a reader.
+ */
+//--------------------------------------------------------------------------------------------------
+void nmeaStream_Close
+(
+    nmeaStream_ReaderRef_t readerRef    ///< [IN] Reader reference.
+)
+{
+    if (NULL == readerRef)
+    {
+        return;
+    }
+
+    munmap((void*)readerRef->ringPtr, readerRef->mapSize);
+    le_mem_Release(readerRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the next chunk of the stream, without blocking.
+ *
+ * @return
+ *      - LE_OK on success.
+ *      - LE_WOULD_BLOCK if no new data is available.
+ *      - LE_OVERFLOW if the buffer is too small for the chunk. The chunk is not consumed.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t nmeaStream_Read
+(
+    nmeaStream_ReaderRef_t readerRef,   ///< [IN] Reader reference.
+    char*                  bufPtr,      ///< [OUT] Buffer receiving the chunk.
+    size_t*                lenPtr       ///< [IN/OUT] Buffer size, then chunk length.
+)
+{
+    const Ring_t* ringPtr = readerRef->ringPtr;
+    char chunk[NMEA_STREAM_SLOT_DATA_BYTES];
+
+    while (true)
+    {
+        uint32_t writeSeq = __atomic_load_n(&ringPtr->writeSeq, __ATOMIC_ACQUIRE);
+        uint32_t lag = writeSeq - readerRef->readSeq;
+
+        if (0 == lag)
+        {
+            return LE_WOULD_BLOCK;
+        }
+
+        // Skip the chunks already overwritten by the writer
+        if (lag > ringPtr->slotCount)
+        {
+            readerRef->overrunCount += lag - ringPtr->slotCount;
+            readerRef->readSeq = writeSeq - ringPtr->slotCount;
+        }
+
+        uint32_t stamp = readerRef->readSeq + 1;
+        const Slot_t* slotPtr = &ringPtr->slots[readerRef->readSeq & (ringPtr->slotCount - 1)];
+        uint32_t end = __atomic_load_n(&slotPtr->end, __ATOMIC_ACQUIRE);
+        size_t len = slotPtr->len;
+
+        if (len > NMEA_STREAM_SLOT_DATA_BYTES)
+        {
+            len = NMEA_STREAM_SLOT_DATA_BYTES;
+        }
+        memcpy(chunk, slotPtr->data, len);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        uint32_t begin = __atomic_load_n(&slotPtr->begin, __ATOMIC_RELAXED);
+
+        if ((end != stamp) || (begin != stamp))
+        {
+            // The slot is being overwritten by the writer: this chunk is lost
+            readerRef->overrunCount++;
+            readerRef->readSeq++;
+            continue;
+        }
+
+        if (len > *lenPtr)
+        {
+            *lenPtr = len;
+            return LE_OVERFLOW;
+        }
+
+        memcpy(bufPtr, chunk, len);
+        *lenPtr = len;
+        readerRef->readSeq++;
+        return LE_OK;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Wait for new data in the stream.
+ *
+ * @return
+ *      - LE_OK if new data is available.
+ *      - LE_TIMEOUT if no data arrived before the timeout.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t nmeaStream_Wait
+(
+    nmeaStream_ReaderRef_t readerRef,   ///< [IN] Reader reference.
+    int32_t                timeoutMs    ///< [IN] Timeout in milliseconds, negative to wait forever.
+)
+{
+    const Ring_t* ringPtr = readerRef->ringPtr;
+    struct timespec timeout;
+    struct timespec* timeoutPtr = NULL;
+
+    if (timeoutMs >= 0)
+    {
+        timeout.tv_sec = timeoutMs / 1000;
+        timeout.tv_nsec = (timeoutMs % 1000) * 1000000L;
+        timeoutPtr = &timeout;
+    }
+
+    while (__atomic_load_n(&ringPtr->writeSeq, __ATOMIC_ACQUIRE) == readerRef->readSeq)
+    {
+        // The futex is a shared one: the ring is mapped by several processes
+        if ((-1 == syscall(SYS_futex, &ringPtr->writeSeq, FUTEX_WAIT, readerRef->readSeq,
+                           timeoutPtr, NULL, 0)) &&
+            (ETIMEDOUT == errno))
+        {
+            return LE_TIMEOUT;
+        }
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of chunks lost by a reader because the writer overwrote them before they were
+ * read.
+ *
+ * @return The number of lost chunks.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t nmeaStream_GetOverrunCount
+(
+    nmeaStream_ReaderRef_t readerRef    ///< [IN] Reader reference.
+)
+{
+    return readerRef->overrunCount;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Component initialization.
+ */
+//--------------------------------------------------------------------------------------------------
+COMPONENT_INIT
+{
+    ReaderPool = le_mem_CreatePool("NmeaStreamReader", sizeof(struct nmeaStream_Reader));
+}
@@ -0,0 +1,165 @@
+/**
+ * @file nmeaStream.h
+ *
+ * Shared NMEA stream ring.
+ *
+ * The positioning daemon copies the NMEA frames into a ring held in a memory file, a read-only
+ * descriptor of which is handed out to the clients by le_gnss_GetNmeaStream(). The ring has a
+ * single writer and any number of readers:
+ *  - each reader maps the ring read-only and keeps its own cursor, so readers never block the
+ *    writer nor each other;
+ *  - each slot is protected by a sequence stamp written before and after its content, which lets
+ *    a reader detect that the slot it is copying has been overwritten;
+ *  - a reader falling more than a ring behind the writer loses the oldest frames and its overrun
+ *    counter is incremented.
+ *
+ * Frames longer than a slot are split across consecutive slots, so the concatenation of the read
+ * chunks is the same byte stream as the one written.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#ifndef LEGATO_NMEA_STREAM_H_INCLUDE_GUARD
+#define LEGATO_NMEA_STREAM_H_INCLUDE_GUARD
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of data bytes in a ring slot.
+ */
+//--------------------------------------------------------------------------------------------------
+#define NMEA_STREAM_SLOT_DATA_BYTES     248
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Default number of slots of the ring. Must be a power of two.
+ */
+//--------------------------------------------------------------------------------------------------
+#define NMEA_STREAM_DEFAULT_SLOT_COUNT  128
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reference to a reader of the NMEA stream ring.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct nmeaStream_Reader* nmeaStream_ReaderRef_t;
+
+
+//--------------------------------------------------------------------------------------------------
+// Writer side, used by the positioning daemon.
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create the NMEA stream ring of the process.
+ *
+ * @return
+ *      - LE_OK on success.
+ *      - LE_DUPLICATE if the ring is already created.
+ *      - LE_BAD_PARAMETER if the slot count is not a power of two.
+ *      - LE_NOT_IMPLEMENTED if memory files are not supported.
+ *      - LE_FAULT on any other failure.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t nmeaStream_Create
+(
+    uint32_t slotCount      ///< [IN] Number of slots of the ring.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write a NMEA frame to the ring. The function never blocks: slow readers lose the oldest frames.
+ */
+//--------------------------------------------------------------------------------------------------
+void nmeaStream_Write
+(
+    const char* framePtr,   ///< [IN] Frame to write.
+    size_t      frameLen    ///< [IN] Frame length in bytes.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get a new read-only file descriptor on the ring, to be handed out to a reader.
+ *
+ * @return The file descriptor, owned by the caller, or -1 on failure.
+ */
+//--------------------------------------------------------------------------------------------------
+int nmeaStream_GetReaderFd
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+// Reader side, used by the NMEA stream clients.
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open a reader on a ring. The reader starts at the current end of the stream.
+ *
+ * @return The reader reference, or NULL if the file descriptor does not hold a valid ring.
+ *
+ * @note The file descriptor is closed by this function in all cases.
+ */
+//--------------------------------------------------------------------------------------------------
+nmeaStream_ReaderRef_t nmeaStream_Open
+(
+    int fd                  ///< [IN] Ring file descriptor, from le_gnss_GetNmeaStream().
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close a reader.
+ */
+//--------------------------------------------------------------------------------------------------
+void nmeaStream_Close
+(
+    nmeaStream_ReaderRef_t readerRef    ///< [IN] Reader reference.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the next chunk of the stream, without blocking.
+ *
+ * @return
+ *      - LE_OK on success.
+ *      - LE_WOULD_BLOCK if no new data is available.
+ *      - LE_OVERFLOW if the buffer is too small for the chunk. The chunk is not consumed.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t nmeaStream_Read
+(
+    nmeaStream_ReaderRef_t readerRef,   ///< [IN] Reader reference.
+    char*                  bufPtr,      ///< [OUT] Buffer receiving the chunk.
+    size_t*                lenPtr       ///< [IN/OUT] Buffer size, then chunk length.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Wait for new data in the stream.
+ *
+ * @return
+ *      - LE_OK if new data is available.
+ *      - LE_TIMEOUT if no data arrived before the timeout.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t nmeaStream_Wait
+(
+    nmeaStream_ReaderRef_t readerRef,   ///< [IN] Reader reference.
+    int32_t                timeoutMs    ///< [IN] Timeout in milliseconds, negative to wait forever.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of chunks lost by a reader because the writer overwrote them before they were
+ * read.
+ *
+ * @return The number of lost chunks.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t nmeaStream_GetOverrunCount
+(
+    nmeaStream_ReaderRef_t readerRef    ///< [IN] Reader reference.
+);
+
+#endif // LEGATO_NMEA_STREAM_H_INCLUDE_GUARD
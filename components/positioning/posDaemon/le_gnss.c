@@ -12,6 +12,7 @@
 #include "legato.h"
 #include "interfaces.h"
 #include "pa_gnss.h"
+#include "nmeaStream.h"
 
 
 //--------------------------------------------------------------------------------------------------
@@ -20,6 +21,9 @@
 
 #define GNSS_POSITION_SAMPLE_MAX         1
 
+/// Number of the last published position samples kept in the position sample ring.
+#define GNSS_POSITION_SAMPLE_RING_SIZE   4
+
 /// Typically, we don't expect more than this number of concurrent activation requests.
 #define GNSS_POSITION_ACTIVATION_MAX      13      // Ideally should be a prime number.
 
@@ -332,6 +336,31 @@ static le_dls_List_t PositionSampleList = LE_DLS_LIST_INIT;
 //--------------------------------------------------------------------------------------------------
 static le_ref_MapRef_t PositionSampleMap;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Ring of the last published position samples.
+ *
+ * A fix is copied once into a sample shared by all the subscribers: the ring and every sample
+ * reference delivered to a subscriber hold a reference count on it. The slot is recycled when the
+ * ring wraps around and all the subscribers have released their references.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_gnss_PositionSample_t* PositionSampleRing[GNSS_POSITION_SAMPLE_RING_SIZE];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Index of the most recent sample in the position sample ring.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t PositionSampleRingIdx = 0;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * True if the most recent sample of the ring holds the content of LastPositionSample.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool LastPositionSamplePublished = false;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Safe Reference Map for client Sample objects.
@@ -347,6 +376,14 @@ static le_ref_MapRef_t ClientRequestRefMap;
 //--------------------------------------------------------------------------------------------------
 static int NmeaPipeFd = -1;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * True if the NMEA frames are written to the NMEA named pipe. This is not the case when the NMEA
+ * device is managed by the firmware.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool NmeaPipeEnabled = false;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Position Handler destructor.
@@ -578,8 +615,14 @@ static void PaNmeaHandler
 {
     LE_DEBUG("Handler Function called with PA NMEA %p", nmeaPtr);
 
+    // Publish the NMEA sentence to the NMEA stream readers, this never blocks
+    nmeaStream_Write(nmeaPtr, strlen(nmeaPtr));
+
     // Write the NMEA sentence to the /dev/nmea device folder
-    WriteNmeaPipe(nmeaPtr);
+    if (NmeaPipeEnabled)
+    {
+        WriteNmeaPipe(nmeaPtr);
+    }
 
     le_mem_Release(nmeaPtr);
 }
@@ -943,6 +986,75 @@ static le_result_t ConvertPositionData
 // APIs.
 //--------------------------------------------------------------------------------------------------
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Publish the last position sample in the position sample ring, releasing the oldest sample of
+ * the ring.
+ *
+ * @return The published sample. The reference held by the ring is not transferred to the caller.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_gnss_PositionSample_t* PublishPositionSample
+(
+    void
+)
+{
+    le_gnss_PositionSample_t* positionSampleNodePtr;
+
+    PositionSampleRingIdx = (PositionSampleRingIdx + 1) % GNSS_POSITION_SAMPLE_RING_SIZE;
+
+    // Release the oldest sample first so that its slot can be reused if no client holds it anymore
+    if (NULL != PositionSampleRing[PositionSampleRingIdx])
+    {
+        le_mem_Release(PositionSampleRing[PositionSampleRingIdx]);
+    }
+
+    positionSampleNodePtr = (le_gnss_PositionSample_t*)le_mem_ForceAlloc(PositionSamplePoolRef);
+
+    // Copy the position sample to the position sample node
+    memcpy(positionSampleNodePtr, &LastPositionSample, sizeof(le_gnss_PositionSample_t));
+
+    // Add the node to the queue of the list by passing in the node's link.
+    positionSampleNodePtr->link = LE_DLS_LINK_INIT;
+    le_dls_Queue(&PositionSampleList, &(positionSampleNodePtr->link));
+
+    PositionSampleRing[PositionSampleRingIdx] = positionSampleNodePtr;
+    LastPositionSamplePublished = true;
+
+    return positionSampleNodePtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a sample reference for a client on a published position sample. The sample is shared:
+ * only a reference count is taken on it.
+ *
+ * @return The safe reference of the sample request, NULL on failure.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_gnss_SampleRef_t CreatePositionSampleRef
+(
+    le_gnss_PositionSample_t* positionSampleNodePtr,    ///< [IN] Published position sample.
+    le_msg_SessionRef_t       sessionRef                ///< [IN] Client session of the reference.
+)
+{
+    le_gnss_PositionSampleRequest_t* positionSampleRequestNodePtr =
+                 (le_gnss_PositionSampleRequest_t*)le_mem_ForceAlloc(PositionSampleRequestPoolRef);
+
+    le_mem_AddRef(positionSampleNodePtr);
+    positionSampleRequestNodePtr->positionSampleNodePtr = positionSampleNodePtr;
+    positionSampleRequestNodePtr->link = LE_DLS_LINK_INIT;
+
+    // Store message session reference which will be useful for close session handler
+    positionSampleRequestNodePtr->sessionRef = sessionRef;
+
+    // Store safe reference which will be useful for close session handler
+    positionSampleRequestNodePtr->positionSampleRef = le_ref_CreateRef(PositionSampleMap,
+                                                            positionSampleRequestNodePtr);
+
+    return positionSampleRequestNodePtr->positionSampleRef;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * The PA position Handler.
@@ -957,8 +1069,7 @@ static void PaPositionHandler
 
     le_gnss_PositionHandler_t*  positionHandlerNodePtr;
     le_dls_Link_t*              linkPtr;
-    le_gnss_PositionSampleRequest_t*    positionSampleRequestNodePtr=NULL;
-    uint8_t i;
+    le_gnss_PositionSample_t*   positionSampleNodePtr;
 
     if (NULL == positionPtr)
     {
@@ -970,6 +1081,7 @@ static void PaPositionHandler
 
     // Get the position sample data from the PA position data report
     GetPosSampleData(&LastPositionSample, positionPtr);
+    LastPositionSamplePublished = false;
 
     if(!NumOfPositionHandlers)
     {
@@ -981,28 +1093,9 @@ static void PaPositionHandler
     linkPtr = le_dls_Peek(&PositionHandlerList);
     if (NULL != linkPtr)
     {
-        // Create the position request sample node.
-        positionSampleRequestNodePtr =
-                 (le_gnss_PositionSampleRequest_t*)le_mem_ForceAlloc(PositionSampleRequestPoolRef);
-
-        // Create the position sample node.
-        positionSampleRequestNodePtr->positionSampleNodePtr =
-                 (le_gnss_PositionSample_t*)le_mem_ForceAlloc(PositionSamplePoolRef);
-
-        // Add reference for each subscribe handler.
-        for(i=0 ; i<NumOfPositionHandlers-1 ; i++)
-        {
-            le_mem_AddRef((void *)positionSampleRequestNodePtr);
-            le_mem_AddRef((void *)positionSampleRequestNodePtr->positionSampleNodePtr);
-        }
-
-        // Copy the position sample to the position sample node
-        memcpy(positionSampleRequestNodePtr->positionSampleNodePtr, &LastPositionSample,
-                     sizeof(le_gnss_PositionSample_t));
-
-        // Add the node to the queue of the list by passing in the node's link.
-        le_dls_Queue(&PositionSampleList, &(positionSampleRequestNodePtr->
-                                                positionSampleNodePtr->link));
+        // The fix is published once and shared by all the handlers, each handler getting its own
+        // sample reference on it.
+        positionSampleNodePtr = PublishPositionSample();
 
         // Call Handler(s)
         do
@@ -1012,18 +1105,13 @@ static void PaPositionHandler
                 (le_gnss_PositionHandler_t*)CONTAINER_OF(linkPtr, le_gnss_PositionHandler_t, link);
 
             LE_DEBUG("Report sample %p to the corresponding handler (handler %p)",
-                     positionSampleRequestNodePtr->positionSampleNodePtr,
+                     positionSampleNodePtr,
                      positionHandlerNodePtr->handlerFuncPtr);
 
             // Create a safe reference and call the client's handler
-            le_gnss_SampleRef_t safePositionSampleRef = le_ref_CreateRef(PositionSampleMap,
-                                                           positionSampleRequestNodePtr);
-
-            // Store message session reference which will be useful for close session handler
-            positionSampleRequestNodePtr->sessionRef = positionHandlerNodePtr->sessionRef;
-
-            // Store safereference which will be useful for close session handler
-            positionSampleRequestNodePtr->positionSampleRef = safePositionSampleRef;
+            le_gnss_SampleRef_t safePositionSampleRef =
+                        CreatePositionSampleRef(positionSampleNodePtr,
+                                                positionHandlerNodePtr->sessionRef);
 
             if(safePositionSampleRef != NULL)
             {
@@ -1225,7 +1313,7 @@ le_result_t gnss_Init
     // Create a pool for Position Sample objects
     PositionSamplePoolRef = le_mem_CreatePool("PositionSamplePoolRef",
                                               sizeof(le_gnss_PositionSample_t));
-    le_mem_ExpandPool(PositionSamplePoolRef,GNSS_POSITION_SAMPLE_MAX);
+    le_mem_ExpandPool(PositionSamplePoolRef, GNSS_POSITION_SAMPLE_RING_SIZE);
     le_mem_SetDestructor(PositionSamplePoolRef, PositionSampleDestructor);
 
     // Create a pool for Position Sample request objects
@@ -1254,6 +1342,7 @@ le_result_t gnss_Init
     // Initialize last Position sample
     memset(&LastPositionSample, 0, sizeof(LastPositionSample));
     LastPositionSample.fixState = LE_GNSS_STATE_FIX_NO_POS;
+    LastPositionSamplePublished = false;
 
     // Subscribe to PA position Data handler
     if ((PaHandlerRef=pa_gnss_AddPositionDataHandler(PaPositionHandler)) == NULL)
@@ -1269,6 +1358,7 @@ le_result_t gnss_Init
     // That node is a FIFO (named pipe): it will be managed from Legato (User space).
     if ((resultStat == 0) && (S_ISFIFO(nmeaFileStat.st_mode))) // FIFO (named pipe)
     {
+         NmeaPipeEnabled = true;
          if ((PaNmeaHandlerRef=pa_gnss_AddNmeaHandler(PaNmeaHandler)) == NULL)
          {
              LE_ERROR("Failed to add PA NMEA handler!");
@@ -1284,6 +1374,7 @@ le_result_t gnss_Init
         {
             // Create NMEA device folder
             CreateNmeaPipe();
+            NmeaPipeEnabled = true;
         }
         else
         {
@@ -2999,30 +3090,17 @@ le_gnss_SampleRef_t le_gnss_GetLastSampleRef
     void
 )
 {
-    le_gnss_PositionSampleRequest_t*   positionSampleRequestNodePtr=NULL;
-
-    // Create the position sample node.
-    positionSampleRequestNodePtr =
-               (le_gnss_PositionSampleRequest_t*)le_mem_ForceAlloc(PositionSampleRequestPoolRef);
-    positionSampleRequestNodePtr->positionSampleNodePtr =
-               (le_gnss_PositionSample_t*)le_mem_ForceAlloc(PositionSamplePoolRef);
-
-    // Copy the position sample to the position sample node
-    memcpy(positionSampleRequestNodePtr->positionSampleNodePtr, &LastPositionSample,
-           sizeof(le_gnss_PositionSample_t));
-
-    // Add the node to the queue of the list by passing in the node's link.
-    le_dls_Queue(&PositionSampleList, &(positionSampleRequestNodePtr->positionSampleNodePtr->link));
+    le_gnss_PositionSample_t* positionSampleNodePtr = PositionSampleRing[PositionSampleRingIdx];
 
-    LE_DEBUG("Get sample %p", positionSampleRequestNodePtr->positionSampleNodePtr);
-
-    positionSampleRequestNodePtr->sessionRef = le_gnss_GetClientSessionRef();
+    // Share the most recent published sample if it is still the last fix, otherwise publish it
+    if (!LastPositionSamplePublished)
+    {
+        positionSampleNodePtr = PublishPositionSample();
+    }
 
-    le_gnss_SampleRef_t reqRef = le_ref_CreateRef(PositionSampleMap, positionSampleRequestNodePtr);
-    positionSampleRequestNodePtr->positionSampleRef = reqRef;
+    LE_DEBUG("Get sample %p", positionSampleNodePtr);
 
-    // Create a safe reference and call the client's handler
-    return reqRef;
+    return CreatePositionSampleRef(positionSampleNodePtr, le_gnss_GetClientSessionRef());
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -3478,6 +3556,7 @@ le_result_t le_gnss_Stop
                 // Initialize last Position sample
                 memset(&LastPositionSample, 0, sizeof(LastPositionSample));
                 LastPositionSample.fixState = LE_GNSS_STATE_FIX_NO_POS;
+                LastPositionSamplePublished = false;
 
                 GnssState = LE_GNSS_STATE_READY;
             }
@@ -4537,4 +4616,54 @@ le_result_t le_gnss_ConvertDataCoordinateSystem
                                                locationDataType,
                                                locationDataSrc,
                                                locationDataDstPtr);
-}
\ No newline at end of file
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function returns a file descriptor on the shared NMEA stream ring.
+ *
+ * @return
+ *  - LE_OK              Success
+ *  - LE_NOT_IMPLEMENTED The NMEA stream is not supported by the platform
+ *  - LE_FAULT           Failure
+ *
+ * @note If the caller is passing a null pointer to this function, it is a fatal error, the
+ *       function will not return.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_gnss_GetNmeaStream
+(
+    int* ringFdPtr  ///< [OUT] Read-only file descriptor of the NMEA stream ring.
+)
+{
+    if (NULL == ringFdPtr)
+    {
+        LE_KILL_CLIENT("ringFdPtr is NULL !");
+        return LE_FAULT;
+    }
+
+    *ringFdPtr = -1;
+
+    // The ring is created for the first reader
+    le_result_t result = nmeaStream_Create(NMEA_STREAM_DEFAULT_SLOT_COUNT);
+    if ((LE_OK != result) && (LE_DUPLICATE != result))
+    {
+        LE_ERROR("Unable to create the NMEA stream, error = %d (%s)",
+                 result, LE_RESULT_TXT(result));
+        return result;
+    }
+
+    // The NMEA frames are not received from the PA when the NMEA device is managed by the firmware
+    if (NULL == PaNmeaHandlerRef)
+    {
+        if ((PaNmeaHandlerRef=pa_gnss_AddNmeaHandler(PaNmeaHandler)) == NULL)
+        {
+            LE_ERROR("Failed to add PA NMEA handler!");
+            return LE_FAULT;
+        }
+    }
+
+    *ringFdPtr = nmeaStream_GetReaderFd();
+
+    return (-1 == *ringFdPtr) ? LE_FAULT : LE_OK;
+}
@@ -205,6 +205,8 @@ typedef struct
         int32_t  hAccuracy;         ///< Horizontal accuracy.
         bool     locationValid;     ///< If true, location is set.
         bool     altitudeValid;     ///< If true, altitude is set.
+        double   latitudeRad;       ///< Latitude in radians, computed once per fix.
+        double   cosLatitude;       ///< Cosine of the latitude, computed once per fix.
 }
 PositionParam_t;
 
@@ -441,16 +443,26 @@ static uint32_t CalculateAcquisitionRate
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Calculate the distance in meters between two fix points (use Haversine formula).
+ * Convert a WGS84 coordinate [resolution 1e-6 degree] to radians.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+#define PI 3.14159265
+#define COORDINATE_TO_RAD(_coord_)  (((double)(_coord_))/1000000.0*PI/180)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Calculate the distance in meters between the last reported fix point of a handler and the
+ * current fix (use Haversine formula). The terms depending only on the current fix are computed
+ * once per fix in the position structure.
  *
  */
 //--------------------------------------------------------------------------------------------------
 static uint32_t ComputeDistance
 (
-    uint32_t latitude1,
-    uint32_t longitude1,
-    uint32_t latitude2,
-    uint32_t longitude2
+    int32_t                lastLatitude,    ///< [IN] Latitude of the last reported fix.
+    int32_t                lastLongitude,   ///< [IN] Longitude of the last reported fix.
+    const PositionParam_t* posParamPtr      ///< [IN] Current fix.
 )
 {
     // Haversine formula:
@@ -458,16 +470,14 @@ static uint32_t ComputeDistance
     // c = 2.atan2(√a, √(1−a))
     // distance = R.c.1000 (in meters)
     // where φ is latitude, λ is longitude, R is earth’s radius (mean radius = 6,371km)
-    #define PI 3.14159265
-
     double R = 6371; // km
-    double dLat = ((double)latitude2-(double)latitude1)/1000000.0*PI/180;
-    double dLon = ((double)longitude2-(double)longitude1)/1000000.0*PI/180;
-    double lat1 = ((double)latitude1)/1000000.0*PI/180;
-    double lat2 = ((double)latitude2)/1000000.0*PI/180;
+    double lat1 = COORDINATE_TO_RAD(lastLatitude);
+    double dLat = posParamPtr->latitudeRad - lat1;
+    double dLon = COORDINATE_TO_RAD(posParamPtr->longitude) - COORDINATE_TO_RAD(lastLongitude);
     double a, c;
 
-    a = sin(dLat/2) * sin(dLat/2) + sin(dLon/2) * sin(dLon/2) * cos(lat1) * cos(lat2);
+    a = sin(dLat/2) * sin(dLat/2)
+        + sin(dLon/2) * sin(dLon/2) * cos(lat1) * posParamPtr->cosLatitude;
     c = 2 * atan2(sqrt(a), sqrt(1-a));
 
     LE_DEBUG("Computed distance is %e meters (double)", (double)(R * c * 1000));
@@ -694,8 +704,7 @@ static le_result_t ComputeMove
 
     uint32_t horizontalMove = ComputeDistance(posSampleHandlerNodePtr->lastLat,
                                               posSampleHandlerNodePtr->lastLong,
-                                              posParamPtr->latitude,
-                                              posParamPtr->longitude);
+                                              posParamPtr);
 
     uint32_t verticalMove = abs(posParamPtr->altitude - posSampleHandlerNodePtr->lastAlt);
 
@@ -731,25 +740,54 @@ static le_result_t ComputeMove
 
 //--------------------------------------------------------------------------------------------------
 /**
- * The main position Sample Handler.
+ * Check if a movement handler has to be notified of the current fix.
  *
+ * Movement is detected in the following cases:
+ * - Vertical distance is beyond the magnitude
+ * - Horizontal distance is beyond the magnitude
+ * - We don't care about vertical & horizontal distance (magnitudes equal to 0)
+ *   therefore that movement handler is called each positioning acquisition rate
+ *
+ * @return true if the handler has to be notified.
  */
 //--------------------------------------------------------------------------------------------------
-static void PosSampleHandlerfunc
+static bool IsMovementDetected
 (
-    le_gnss_SampleRef_t positionSampleRef,
-    void* contextPtr
+  le_pos_SampleHandler_t *posSampleHandlerNodePtr,  ///< [IN] The handler reference.
+  const PositionParam_t  *posParamPtr               ///< [IN] The current fix.
+)
+{
+    bool hflag, vflag;
+
+    if ((0 == posSampleHandlerNodePtr->verticalMagnitude)
+        && (0 == posSampleHandlerNodePtr->horizontalMagnitude))
+    {
+        return true;
+    }
+
+    if (LE_FAULT == ComputeMove(posSampleHandlerNodePtr, posParamPtr, &hflag, &vflag))
+    {
+        return false;
+    }
+
+    return (((0 != posSampleHandlerNodePtr->verticalMagnitude) && (vflag)) ||
+            ((0 != posSampleHandlerNodePtr->horizontalMagnitude) && (hflag)));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create the position sample of the current fix. The sample is created once per fix and shared by
+ * all the handlers notified of it.
+ *
+ * @return The position sample node, with one reference owned by the caller.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_pos_Sample_t* CreatePosSample
+(
+    le_gnss_SampleRef_t    positionSampleRef,   ///< [IN] The GNSS sample of the fix.
+    const PositionParam_t* posParamPtr          ///< [IN] The current fix.
 )
 {
-    le_result_t result;
-    // Location parameters
-    bool        locationValid = false;
-    int32_t     latitude;
-    int32_t     longitude;
-    int32_t     hAccuracy;
-    bool        altitudeValid = false;
-    int32_t     altitude;
-    int32_t     vAccuracy;
     // Horizontal speed
     uint32_t hSpeed;
     uint32_t hSpeedAccuracy;
@@ -770,14 +808,140 @@ static void PosSampleHandlerfunc
     uint16_t milliseconds;
     // Leap seconds in advance
     uint8_t leapSeconds;
-    PositionParam_t posParam;
     // the position fix state
     le_gnss_FixState_t gnssState;
 
+    le_pos_Sample_t* posSampleNodePtr = (le_pos_Sample_t*)le_mem_ForceAlloc(PosSamplePoolRef);
+
+    posSampleNodePtr->latitudeValid = CHECK_VALIDITY(posParamPtr->latitude,INT32_MAX);
+    posSampleNodePtr->latitude = posParamPtr->latitude;
+
+    posSampleNodePtr->longitudeValid = CHECK_VALIDITY(posParamPtr->longitude,INT32_MAX);
+    posSampleNodePtr->longitude = posParamPtr->longitude;
+
+    posSampleNodePtr->hAccuracyValid = CHECK_VALIDITY(posParamPtr->hAccuracy,INT32_MAX);
+    posSampleNodePtr->hAccuracy = posParamPtr->hAccuracy;
+
+    posSampleNodePtr->altitudeValid = CHECK_VALIDITY(posParamPtr->altitude,INT32_MAX);
+    posSampleNodePtr->altitude = posParamPtr->altitude;
+
+    posSampleNodePtr->vAccuracyValid = CHECK_VALIDITY(posParamPtr->vAccuracy,INT32_MAX);
+    posSampleNodePtr->vAccuracy = posParamPtr->vAccuracy;
+
+    // Get horizontal speed
+    le_gnss_GetHorizontalSpeed(positionSampleRef, &hSpeed, &hSpeedAccuracy);
+    posSampleNodePtr->hSpeedValid = CHECK_VALIDITY(hSpeed,UINT32_MAX);
+    posSampleNodePtr->hSpeed = hSpeed;
+    posSampleNodePtr->hSpeedAccuracyValid = CHECK_VALIDITY(hSpeedAccuracy,UINT32_MAX);
+    posSampleNodePtr->hSpeedAccuracy = hSpeedAccuracy;
+
+    // Get vertical speed
+    le_gnss_GetVerticalSpeed(positionSampleRef, &vSpeed, &vSpeedAccuracy);
+    posSampleNodePtr->vSpeedValid = CHECK_VALIDITY(vSpeed,INT32_MAX);
+    posSampleNodePtr->vSpeed = vSpeed;
+    posSampleNodePtr->vSpeedAccuracyValid = CHECK_VALIDITY(vSpeedAccuracy,INT32_MAX);
+    posSampleNodePtr->vSpeedAccuracy = vSpeedAccuracy;
+
+    // Heading not supported by GNSS engine
+    posSampleNodePtr->headingValid = false;
+    posSampleNodePtr->heading = UINT32_MAX;
+    posSampleNodePtr->headingAccuracyValid = false;
+    posSampleNodePtr->headingAccuracy = UINT32_MAX;
+
+    // Get direction
+    le_gnss_GetDirection(positionSampleRef, &direction, &directionAccuracy);
+    posSampleNodePtr->directionValid = CHECK_VALIDITY(direction,UINT32_MAX);
+    posSampleNodePtr->direction = direction;
+    posSampleNodePtr->directionAccuracyValid = CHECK_VALIDITY(directionAccuracy,UINT32_MAX);
+    posSampleNodePtr->directionAccuracy = directionAccuracy;
+
+    // Get UTC time
+    if (LE_OK == le_gnss_GetDate(positionSampleRef, &year, &month, &day))
+    {
+        posSampleNodePtr->dateValid = true;
+    }
+    else
+    {
+        posSampleNodePtr->dateValid = false;
+    }
+    posSampleNodePtr->year = year;
+    posSampleNodePtr->month = month;
+    posSampleNodePtr->day = day;
+
+    if (LE_OK == le_gnss_GetTime(positionSampleRef, &hours, &minutes, &seconds, &milliseconds))
+    {
+        posSampleNodePtr->timeValid = true;
+    }
+    else
+    {
+        posSampleNodePtr->timeValid = false;
+    }
+    posSampleNodePtr->hours = hours;
+    posSampleNodePtr->minutes = minutes;
+    posSampleNodePtr->seconds = seconds;
+    posSampleNodePtr->milliseconds = milliseconds;
+
+    // Get UTC leap seconds in advance
+    if (LE_OK == le_gnss_GetGpsLeapSeconds(positionSampleRef, &leapSeconds))
+    {
+        posSampleNodePtr->leapSecondsValid = true;
+    }
+    else
+    {
+        posSampleNodePtr->leapSecondsValid = false;
+    }
+    posSampleNodePtr->leapSeconds = leapSeconds;
+
+    // Get position fix state
+    if (LE_OK != le_gnss_GetPositionState(positionSampleRef, &gnssState))
+    {
+        posSampleNodePtr->fixState = LE_POS_STATE_UNKNOWN;
+        LE_ERROR("Failed to get a position fix");
+    }
+    else
+    {
+        posSampleNodePtr->fixState = (le_pos_FixState_t)gnssState;
+    }
+
+    posSampleNodePtr->link = LE_DLS_LINK_INIT;
+
+    // Add the node to the queue of the list by passing in the node's link.
+    le_dls_Queue(&PosSampleList, &(posSampleNodePtr->link));
+
+    return posSampleNodePtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The main position Sample Handler.
+ *
+ * The fix is read from the GNSS sample and the movement filter terms depending only on the fix
+ * are computed once. Each handler is then checked against its own last reported position and
+ * the notified handlers share a single position sample, each one getting its own reference.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PosSampleHandlerfunc
+(
+    le_gnss_SampleRef_t positionSampleRef,
+    void* contextPtr
+)
+{
+    le_result_t result;
+    // Location parameters
+    bool        locationValid = false;
+    int32_t     latitude;
+    int32_t     longitude;
+    int32_t     hAccuracy;
+    bool        altitudeValid = false;
+    int32_t     altitude;
+    int32_t     vAccuracy;
+    PositionParam_t posParam;
+
     // Positioning sample parameters
     le_pos_SampleHandler_t* posSampleHandlerNodePtr;
     le_dls_Link_t*          linkPtr;
     PosSampleRequest_t*     posSampleRequestPtr=NULL;
+    le_pos_Sample_t*        posSampleNodePtr=NULL;
 
     if (NULL == positionSampleRef)
     {
@@ -826,16 +990,6 @@ static void PosSampleHandlerfunc
         LE_DEBUG("Altitude unknown [%d,%d]", altitude, vAccuracy);
     }
 
-    // Positioning sample
-    linkPtr = le_dls_Peek(&PosSampleHandlerList);
-
-    if (NULL == linkPtr)
-    {
-        // Release provided Position sample reference
-        le_gnss_ReleaseSampleRef(positionSampleRef);
-        return;
-    }
-
     posParam.latitude = latitude;
     posParam.longitude = longitude;
     posParam.altitude = altitude;
@@ -843,143 +997,32 @@ static void PosSampleHandlerfunc
     posParam.hAccuracy = hAccuracy;
     posParam.locationValid = locationValid;
     posParam.altitudeValid = altitudeValid;
+    posParam.latitudeRad = COORDINATE_TO_RAD(latitude);
+    posParam.cosLatitude = cos(posParam.latitudeRad);
 
-    do
+    // Positioning sample
+    linkPtr = le_dls_Peek(&PosSampleHandlerList);
+
+    while (NULL != linkPtr)
     {
-        bool hflag, vflag;
         // Get the node from the list
         posSampleHandlerNodePtr = (le_pos_SampleHandler_t*)CONTAINER_OF(linkPtr,
                                                                         le_pos_SampleHandler_t,
                                                                         link);
 
-        if (LE_FAULT == ComputeMove(posSampleHandlerNodePtr, &posParam, &hflag, &vflag))
+        if (IsMovementDetected(posSampleHandlerNodePtr, &posParam))
         {
-            // Release provided Position sample reference
-            le_gnss_ReleaseSampleRef(positionSampleRef);
-            return;
-        }
-
-        // Movement is detected in the following cases:
-        // - Vertical distance is beyond the magnitude
-        // - Horizontal distance is beyond the magnitude
-        // - We don't care about vertical & horizontal distance (magnitudes equal to 0)
-        //   therefore that movement handler is called each positioning acquisition rate
-        if (((0 != posSampleHandlerNodePtr->verticalMagnitude) && (vflag)) ||
-             ((0 != posSampleHandlerNodePtr->horizontalMagnitude) && (hflag)) ||
-             ((0 == posSampleHandlerNodePtr->verticalMagnitude)
-             && (0 == posSampleHandlerNodePtr->horizontalMagnitude)))
-        {
-            // Create the position sample node.
-            posSampleRequestPtr = le_mem_ForceAlloc(PosSampleRequestPoolRef);
-            posSampleRequestPtr->posSampleNodePtr
-                                = (le_pos_Sample_t*)le_mem_ForceAlloc(PosSamplePoolRef);
-            posSampleRequestPtr->posSampleNodePtr->latitudeValid
-                                = CHECK_VALIDITY(latitude,INT32_MAX);
-            posSampleRequestPtr->posSampleNodePtr->latitude = latitude;
-
-            posSampleRequestPtr->posSampleNodePtr->longitudeValid
-                                = CHECK_VALIDITY(longitude,INT32_MAX);
-            posSampleRequestPtr->posSampleNodePtr->longitude = longitude;
-
-            posSampleRequestPtr->posSampleNodePtr->hAccuracyValid
-                                = CHECK_VALIDITY(hAccuracy,INT32_MAX);
-            posSampleRequestPtr->posSampleNodePtr->hAccuracy = hAccuracy;
-
-            posSampleRequestPtr->posSampleNodePtr->altitudeValid
-                                = CHECK_VALIDITY(altitude,INT32_MAX);
-            posSampleRequestPtr->posSampleNodePtr->altitude = altitude;
-
-            posSampleRequestPtr->posSampleNodePtr->vAccuracyValid
-                                = CHECK_VALIDITY(vAccuracy,INT32_MAX);
-            posSampleRequestPtr->posSampleNodePtr->vAccuracy = vAccuracy;
-
-            // Get horizontal speed
-            le_gnss_GetHorizontalSpeed(positionSampleRef, &hSpeed, &hSpeedAccuracy);
-            posSampleRequestPtr->posSampleNodePtr->hSpeedValid
-                                    = CHECK_VALIDITY(hSpeed,UINT32_MAX);
-            posSampleRequestPtr->posSampleNodePtr->hSpeed = hSpeed;
-            posSampleRequestPtr->posSampleNodePtr->hSpeedAccuracyValid =
-                                                CHECK_VALIDITY(hSpeedAccuracy,UINT32_MAX);
-            posSampleRequestPtr->posSampleNodePtr->hSpeedAccuracy = hSpeedAccuracy;
-
-            // Get vertical speed
-            le_gnss_GetVerticalSpeed(positionSampleRef, &vSpeed, &vSpeedAccuracy);
-            posSampleRequestPtr->posSampleNodePtr->vSpeedValid
-                                = CHECK_VALIDITY(vSpeed,INT32_MAX);
-            posSampleRequestPtr->posSampleNodePtr->vSpeed = vSpeed;
-            posSampleRequestPtr->posSampleNodePtr->vSpeedAccuracyValid =
-                                                CHECK_VALIDITY(vSpeedAccuracy,INT32_MAX);
-            posSampleRequestPtr->posSampleNodePtr->vSpeedAccuracy = vSpeedAccuracy;
-
-            // Heading not supported by GNSS engine
-            posSampleRequestPtr->posSampleNodePtr->headingValid = false;
-            posSampleRequestPtr->posSampleNodePtr->heading = UINT32_MAX;
-            posSampleRequestPtr->posSampleNodePtr->headingAccuracyValid = false;
-            posSampleRequestPtr->posSampleNodePtr->headingAccuracy = UINT32_MAX;
-
-            // Get direction
-            le_gnss_GetDirection(positionSampleRef, &direction, &directionAccuracy);
-
-            posSampleRequestPtr->posSampleNodePtr->directionValid
-                                = CHECK_VALIDITY(direction,UINT32_MAX);
-            posSampleRequestPtr->posSampleNodePtr->direction = direction;
-            posSampleRequestPtr->posSampleNodePtr->directionAccuracyValid =
-                                            CHECK_VALIDITY(directionAccuracy,UINT32_MAX);
-            posSampleRequestPtr->posSampleNodePtr->directionAccuracy = directionAccuracy;
-
-            // Get UTC time
-            if (LE_OK == le_gnss_GetDate(positionSampleRef, &year, &month, &day))
-            {
-                posSampleRequestPtr->posSampleNodePtr->dateValid = true;
-            }
-            else
-            {
-                posSampleRequestPtr->posSampleNodePtr->dateValid = false;
-            }
-            posSampleRequestPtr->posSampleNodePtr->year = year;
-            posSampleRequestPtr->posSampleNodePtr->month = month;
-            posSampleRequestPtr->posSampleNodePtr->day = day;
-
-            if (LE_OK == le_gnss_GetTime(positionSampleRef, &hours, &minutes, &seconds,
-                                         &milliseconds))
-            {
-                posSampleRequestPtr->posSampleNodePtr->timeValid = true;
-            }
-            else
+            // The sample is created for the first notified handler and shared with the next ones.
+            // The reference taken at creation is kept until all the handlers have been called.
+            if (NULL == posSampleNodePtr)
             {
-                posSampleRequestPtr->posSampleNodePtr->timeValid = false;
+                posSampleNodePtr = CreatePosSample(positionSampleRef, &posParam);
             }
-            posSampleRequestPtr->posSampleNodePtr->hours = hours;
-            posSampleRequestPtr->posSampleNodePtr->minutes = minutes;
-            posSampleRequestPtr->posSampleNodePtr->seconds = seconds;
-            posSampleRequestPtr->posSampleNodePtr->milliseconds = milliseconds;
+            le_mem_AddRef(posSampleNodePtr);
 
-            // Get UTC leap seconds in advance
-            if (LE_OK == le_gnss_GetGpsLeapSeconds(positionSampleRef, &leapSeconds))
-            {
-               posSampleRequestPtr->posSampleNodePtr->leapSecondsValid = true;
-            }
-            else
-            {
-                posSampleRequestPtr->posSampleNodePtr->leapSecondsValid = false;
-            }
-            posSampleRequestPtr->posSampleNodePtr->leapSeconds = leapSeconds;
-
-            // Get position fix state
-            if (LE_OK != le_gnss_GetPositionState(positionSampleRef, &gnssState))
-            {
-                posSampleRequestPtr->posSampleNodePtr->fixState = LE_POS_STATE_UNKNOWN;
-                LE_ERROR("Failed to get a position fix");
-            }
-            else
-            {
-                posSampleRequestPtr->posSampleNodePtr->fixState = (le_pos_FixState_t)gnssState;
-            }
-
-            posSampleRequestPtr->posSampleNodePtr->link = LE_DLS_LINK_INIT;
-
-            // Add the node to the queue of the list by passing in the node's link.
-            le_dls_Queue(&PosSampleList, &(posSampleRequestPtr->posSampleNodePtr->link));
+            posSampleRequestPtr = le_mem_ForceAlloc(PosSampleRequestPoolRef);
+            posSampleRequestPtr->posSampleNodePtr = posSampleNodePtr;
+            posSampleRequestPtr->link = LE_DLS_LINK_INIT;
 
             // Save the information reported to the handler function
             posSampleHandlerNodePtr->lastLat = latitude;
@@ -987,7 +1030,7 @@ static void PosSampleHandlerfunc
             posSampleHandlerNodePtr->lastAlt = altitude;
 
             LE_DEBUG("Report sample %p to the corresponding handler (handler %p)",
-                     posSampleRequestPtr->posSampleNodePtr,
+                     posSampleNodePtr,
                      posSampleHandlerNodePtr->handlerFuncPtr);
 
             le_pos_SampleRef_t reqRef = le_ref_CreateRef(PosSampleMap, posSampleRequestPtr);
@@ -1005,7 +1048,12 @@ static void PosSampleHandlerfunc
 
         // Move to the next node.
         linkPtr = le_dls_PeekNext(&PosSampleHandlerList, linkPtr);
-    } while (NULL != linkPtr);
+    }
+
+    if (NULL != posSampleNodePtr)
+    {
+        le_mem_Release(posSampleNodePtr);
+    }
 
     // Release provided Position sample reference
     le_gnss_ReleaseSampleRef(positionSampleRef);
@@ -0,0 +1,627 @@
+/** @file secStoreIndex.c
+ *
+ * Cached index of the items stored in each client area of secure storage.
+ *
+ * Every item of every indexed area is kept in a single hash map keyed by the item's full path in
+ * secure storage.  An area is indexed the first time it is accessed by walking its entries through
+ * the platform adaptor; after that the daemon keeps the index in sync with its own writes and
+ * deletes, so repeated lookups never have to go back to the platform adaptor.
+ *
+ * <hr>
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+#include "pa_secStore.h"
+#include "secStoreIndex.h"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Estimated maximum number of items cached at once.  Used to size the item hash map.
+ */
+//--------------------------------------------------------------------------------------------------
+#define ITEM_MAP_SIZE       127
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * An indexed area of secure storage.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    char path[SECSTOREADMIN_MAX_PATH_BYTES];    ///< Path of the area.
+    size_t usedSpace;                           ///< Sum of the sizes of all items in the area.
+    le_dls_Link_t link;                         ///< Link in the list of indexed areas.
+}
+Area_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * An indexed item.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    char path[SECSTOREADMIN_MAX_PATH_BYTES];    ///< Full path of the item.  Used as map key.
+    size_t size;                                ///< Size of the item in bytes.
+    Area_t* areaPtr;                            ///< Area the item belongs to.
+}
+Item_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * An entry waiting to be visited while an area is being indexed.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    char path[SECSTOREADMIN_MAX_PATH_BYTES];    ///< Full path of the entry.
+    bool isDir;                                 ///< true if the entry is a directory.
+    le_sls_Link_t link;                         ///< Link in the list of pending entries.
+}
+PendingEntry_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Context used while listing the entries of a directory.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const char* dirPathPtr;                     ///< Path of the directory being listed.
+    le_sls_List_t* pendingListPtr;              ///< List to queue the entries on.
+}
+ListContext_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * List of indexed areas.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_dls_List_t AreaList = LE_DLS_LIST_INIT;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Map of all indexed items, keyed by full path.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t ItemMap = NULL;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pools of areas, items and pending entries.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t AreaPool = NULL;
+static le_mem_PoolRef_t ItemPool = NULL;
+static le_mem_PoolRef_t PendingEntryPool = NULL;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Builds the full path of an item.
+ *
+ * @note
+ *      Kills the daemon if the path does not fit, the caller has already validated the length.
+ */
+//--------------------------------------------------------------------------------------------------
+static void BuildItemPath
+(
+    const char* areaPathPtr,        ///< [IN] Path of the area.
+    const char* itemNamePtr,        ///< [IN] Item name, relative to the area path.
+    char* bufPtr,                   ///< [OUT] Buffer to store the path in.
+    size_t bufSize                  ///< [IN] Size of the buffer.
+)
+{
+    bufPtr[0] = '\0';
+
+    LE_FATAL_IF(le_path_Concat("/", bufPtr, bufSize, areaPathPtr, itemNamePtr, NULL) != LE_OK,
+                "Path for item '%s' in area '%s' is too long.", itemNamePtr, areaPathPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finds an indexed area.
+ *
+ * @return
+ *      Pointer to the area or NULL if the area is not indexed.
+ */
+//--------------------------------------------------------------------------------------------------
+static Area_t* FindArea
+(
+    const char* areaPathPtr         ///< [IN] Path of the area.
+)
+{
+    le_dls_Link_t* linkPtr = le_dls_Peek(&AreaList);
+
+    while (linkPtr != NULL)
+    {
+        Area_t* areaPtr = CONTAINER_OF(linkPtr, Area_t, link);
+
+        if (strcmp(areaPtr->path, areaPathPtr) == 0)
+        {
+            return areaPtr;
+        }
+
+        linkPtr = le_dls_PeekNext(&AreaList, linkPtr);
+    }
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds an item to the index, replacing any previous record of the same item.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PutItem
+(
+    Area_t* areaPtr,                ///< [IN] Area the item belongs to.
+    const char* itemPathPtr,        ///< [IN] Full path of the item.
+    size_t itemSize                 ///< [IN] Size of the item in bytes.
+)
+{
+    Item_t* itemPtr = le_hashmap_Get(ItemMap, itemPathPtr);
+
+    if (itemPtr != NULL)
+    {
+        areaPtr->usedSpace -= itemPtr->size;
+    }
+    else
+    {
+        itemPtr = le_mem_ForceAlloc(ItemPool);
+
+        LE_ASSERT(le_utf8_Copy(itemPtr->path, itemPathPtr, sizeof(itemPtr->path), NULL) == LE_OK);
+        itemPtr->areaPtr = areaPtr;
+
+        le_hashmap_Put(ItemMap, itemPtr->path, itemPtr);
+    }
+
+    itemPtr->size = itemSize;
+    areaPtr->usedSpace += itemSize;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queues an entry reported by the platform adaptor for later processing.
+ */
+//--------------------------------------------------------------------------------------------------
+static void QueueEntry
+(
+    const char* entryNamePtr,       ///< [IN] Entry name.
+    bool isDir,                     ///< [IN] true if the entry is a directory.
+    void* contextPtr                ///< [IN] List context.
+)
+{
+    ListContext_t* listCtxPtr = contextPtr;
+
+    PendingEntry_t* entryPtr = le_mem_ForceAlloc(PendingEntryPool);
+
+    entryPtr->path[0] = '\0';
+    entryPtr->isDir = isDir;
+    entryPtr->link = LE_SLS_LINK_INIT;
+
+    if (le_path_Concat("/", entryPtr->path, sizeof(entryPtr->path),
+                       listCtxPtr->dirPathPtr, entryNamePtr, NULL) != LE_OK)
+    {
+        LE_ERROR("Path of entry '%s' under '%s' is too long.", entryNamePtr, listCtxPtr->dirPathPtr);
+        le_mem_Release(entryPtr);
+        return;
+    }
+
+    le_sls_Queue(listCtxPtr->pendingListPtr, &(entryPtr->link));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Lists a directory, appending its entries to the pending list.
+ *
+ * @return
+ *      LE_OK if successful (a missing directory is treated as empty).
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ListDir
+(
+    const char* dirPathPtr,         ///< [IN] Directory to list.
+    le_sls_List_t* pendingListPtr   ///< [IN] List to queue the entries on.
+)
+{
+    ListContext_t listCtx = { .dirPathPtr = dirPathPtr, .pendingListPtr = pendingListPtr };
+
+    le_result_t result = pa_secStore_GetEntries(dirPathPtr, QueueEntry, &listCtx);
+
+    if (result == LE_NOT_FOUND)
+    {
+        return LE_OK;
+    }
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Releases all entries left in a pending list.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ClearPendingList
+(
+    le_sls_List_t* pendingListPtr   ///< [IN] List to clear.
+)
+{
+    le_sls_Link_t* linkPtr;
+
+    while ((linkPtr = le_sls_Pop(pendingListPtr)) != NULL)
+    {
+        le_mem_Release(CONTAINER_OF(linkPtr, PendingEntry_t, link));
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Deletes an area and all of its items from the index.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DropArea
+(
+    Area_t* areaPtr                 ///< [IN] Area to drop.
+)
+{
+    le_hashmap_It_Ref_t iter = le_hashmap_GetIterator(ItemMap);
+
+    while (le_hashmap_NextNode(iter) == LE_OK)
+    {
+        Item_t* itemPtr = le_hashmap_GetValue(iter);
+
+        if ((itemPtr != NULL) && (itemPtr->areaPtr == areaPtr))
+        {
+            le_hashmap_Remove(ItemMap, itemPtr->path);
+            le_mem_Release(itemPtr);
+        }
+    }
+
+    le_dls_Remove(&AreaList, &(areaPtr->link));
+    le_mem_Release(areaPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets an indexed area, walking it through the platform adaptor if it is not indexed yet.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t GetArea
+(
+    const char* areaPathPtr,        ///< [IN] Path of the area.
+    Area_t** areaPtrPtr             ///< [OUT] Indexed area.
+)
+{
+    Area_t* areaPtr = FindArea(areaPathPtr);
+
+    if (areaPtr != NULL)
+    {
+        *areaPtrPtr = areaPtr;
+        return LE_OK;
+    }
+
+    areaPtr = le_mem_ForceAlloc(AreaPool);
+
+    if (le_utf8_Copy(areaPtr->path, areaPathPtr, sizeof(areaPtr->path), NULL) != LE_OK)
+    {
+        LE_ERROR("Area path '%s' is too long.", areaPathPtr);
+        le_mem_Release(areaPtr);
+        return LE_FAULT;
+    }
+
+    areaPtr->usedSpace = 0;
+    areaPtr->link = LE_DLS_LINK_INIT;
+    le_dls_Queue(&AreaList, &(areaPtr->link));
+
+    // Walk the area breadth first.  Entries are collected before being visited because the
+    // platform adaptor does not allow re-entrant calls from its callback.
+    le_sls_List_t pendingList = LE_SLS_LIST_INIT;
+    le_result_t result = ListDir(areaPathPtr, &pendingList);
+    le_sls_Link_t* linkPtr;
+
+    while ((result == LE_OK) && ((linkPtr = le_sls_Pop(&pendingList)) != NULL))
+    {
+        PendingEntry_t* entryPtr = CONTAINER_OF(linkPtr, PendingEntry_t, link);
+
+        if (entryPtr->isDir)
+        {
+            result = ListDir(entryPtr->path, &pendingList);
+        }
+        else
+        {
+            size_t itemSize = 0;
+
+            result = pa_secStore_GetSize(entryPtr->path, &itemSize);
+
+            if (result == LE_OK)
+            {
+                PutItem(areaPtr, entryPtr->path, itemSize);
+            }
+            else if (result == LE_NOT_FOUND)
+            {
+                result = LE_OK;
+            }
+        }
+
+        le_mem_Release(entryPtr);
+    }
+
+    ClearPendingList(&pendingList);
+
+    if (result != LE_OK)
+    {
+        LE_ERROR("Could not index secure storage area '%s'. %s.",
+                 areaPathPtr, LE_RESULT_TXT(result));
+        DropArea(areaPtr);
+        return result;
+    }
+
+    LE_DEBUG("Indexed secure storage area '%s', %zu bytes used.", areaPathPtr, areaPtr->usedSpace);
+
+    *areaPtrPtr = areaPtr;
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initializes the index.  Must be called once before any other function in this module.
+ */
+//--------------------------------------------------------------------------------------------------
+void secIndex_Init
+(
+    void
+)
+{
+    AreaPool = le_mem_CreatePool("SecIndexAreaPool", sizeof(Area_t));
+    ItemPool = le_mem_CreatePool("SecIndexItemPool", sizeof(Item_t));
+    PendingEntryPool = le_mem_CreatePool("SecIndexPendingPool", sizeof(PendingEntry_t));
+
+    ItemMap = le_hashmap_Create("SecIndexItems",
+                                ITEM_MAP_SIZE,
+                                le_hashmap_HashString,
+                                le_hashmap_EqualsString);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the size of an item in an area.  The area is loaded from the platform adaptor if it has not
+ * been indexed yet.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_NOT_FOUND if the item does not exist.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t secIndex_GetItemSize
+(
+    const char* areaPathPtr,        ///< [IN] Path of the area in secure storage.
+    const char* itemNamePtr,        ///< [IN] Item name, relative to the area path.
+    size_t* sizePtr                 ///< [OUT] Size of the item in bytes.
+)
+{
+    Area_t* areaPtr;
+    le_result_t result = GetArea(areaPathPtr, &areaPtr);
+
+    if (result != LE_OK)
+    {
+        return result;
+    }
+
+    char itemPath[SECSTOREADMIN_MAX_PATH_BYTES];
+    BuildItemPath(areaPathPtr, itemNamePtr, itemPath, sizeof(itemPath));
+
+    Item_t* itemPtr = le_hashmap_Get(ItemMap, itemPath);
+
+    if (itemPtr == NULL)
+    {
+        return LE_NOT_FOUND;
+    }
+
+    *sizePtr = itemPtr->size;
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the total number of bytes used by all items in an area.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t secIndex_GetUsedSpace
+(
+    const char* areaPathPtr,        ///< [IN] Path of the area in secure storage.
+    size_t* usedSpacePtr            ///< [OUT] Number of bytes used by the area.
+)
+{
+    Area_t* areaPtr;
+    le_result_t result = GetArea(areaPathPtr, &areaPtr);
+
+    if (result == LE_OK)
+    {
+        *usedSpacePtr = areaPtr->usedSpace;
+    }
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Calls a function for every item of an area.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t secIndex_ForEachItem
+(
+    const char* areaPathPtr,        ///< [IN] Path of the area in secure storage.
+    secIndex_ItemFunc_t itemFunc,   ///< [IN] Function to call for each item.
+    void* contextPtr                ///< [IN] Context passed to the function.
+)
+{
+    Area_t* areaPtr;
+    le_result_t result = GetArea(areaPathPtr, &areaPtr);
+
+    if (result != LE_OK)
+    {
+        return result;
+    }
+
+    size_t prefixLen = strlen(areaPtr->path);
+    le_hashmap_It_Ref_t iter = le_hashmap_GetIterator(ItemMap);
+
+    while (le_hashmap_NextNode(iter) == LE_OK)
+    {
+        Item_t* itemPtr = le_hashmap_GetValue(iter);
+
+        if (itemPtr->areaPtr == areaPtr)
+        {
+            // Skip the area path and the separator that follows it.
+            itemFunc(itemPtr->path + prefixLen + 1, itemPtr->size, contextPtr);
+        }
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Records that an item has been successfully written to an area.  Does nothing if the area is not
+ * indexed yet.
+ */
+//--------------------------------------------------------------------------------------------------
+void secIndex_SetItem
+(
+    const char* areaPathPtr,        ///< [IN] Path of the area in secure storage.
+    const char* itemNamePtr,        ///< [IN] Item name, relative to the area path.
+    size_t itemSize                 ///< [IN] New size of the item in bytes.
+)
+{
+    Area_t* areaPtr = FindArea(areaPathPtr);
+
+    if (areaPtr != NULL)
+    {
+        char itemPath[SECSTOREADMIN_MAX_PATH_BYTES];
+        BuildItemPath(areaPathPtr, itemNamePtr, itemPath, sizeof(itemPath));
+
+        PutItem(areaPtr, itemPath, itemSize);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Records that an item, and everything under it, has been deleted from an area.  Does nothing if
+ * the area is not indexed yet.
+ */
+//--------------------------------------------------------------------------------------------------
+void secIndex_RemoveItem
+(
+    const char* areaPathPtr,        ///< [IN] Path of the area in secure storage.
+    const char* itemNamePtr         ///< [IN] Item name, relative to the area path.
+)
+{
+    Area_t* areaPtr = FindArea(areaPathPtr);
+
+    if (areaPtr == NULL)
+    {
+        return;
+    }
+
+    char itemPath[SECSTOREADMIN_MAX_PATH_BYTES];
+    BuildItemPath(areaPathPtr, itemNamePtr, itemPath, sizeof(itemPath));
+    size_t itemPathLen = strlen(itemPath);
+
+    // The platform adaptor deletes directories recursively so drop the item itself and anything
+    // that lives under it.
+    le_hashmap_It_Ref_t iter = le_hashmap_GetIterator(ItemMap);
+
+    while (le_hashmap_NextNode(iter) == LE_OK)
+    {
+        Item_t* itemPtr = le_hashmap_GetValue(iter);
+
+        if ( (itemPtr != NULL) &&
+             (itemPtr->areaPtr == areaPtr) &&
+             (strncmp(itemPtr->path, itemPath, itemPathLen) == 0) &&
+             ((itemPtr->path[itemPathLen] == '\0') || (itemPtr->path[itemPathLen] == '/')) )
+        {
+            areaPtr->usedSpace -= itemPtr->size;
+
+            le_hashmap_Remove(ItemMap, itemPtr->path);
+            le_mem_Release(itemPtr);
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Drops every cached area.  Must be called whenever secure storage is modified without going
+ * through an indexed area (e.g. through the admin API or when systems are re-initialized).
+ */
+//--------------------------------------------------------------------------------------------------
+void secIndex_InvalidateAll
+(
+    void
+)
+{
+    le_hashmap_It_Ref_t iter = le_hashmap_GetIterator(ItemMap);
+
+    while (le_hashmap_NextNode(iter) == LE_OK)
+    {
+        Item_t* itemPtr = le_hashmap_GetValue(iter);
+
+        if (itemPtr != NULL)
+        {
+            le_mem_Release(itemPtr);
+        }
+    }
+
+    le_hashmap_RemoveAll(ItemMap);
+
+    le_dls_Link_t* linkPtr;
+
+    while ((linkPtr = le_dls_Pop(&AreaList)) != NULL)
+    {
+        le_mem_Release(CONTAINER_OF(linkPtr, Area_t, link));
+    }
+}
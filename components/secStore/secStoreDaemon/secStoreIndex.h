@@ -0,0 +1,136 @@
+/** @file secStoreIndex.h
+ *
+ * Cached index of the items stored in each client area of secure storage.
+ *
+ * The index is built lazily the first time a client area is accessed and then kept up to date by
+ * the secure storage daemon as items are written and deleted.  This allows existence checks, size
+ * checks and client limit checks to be answered without calling into the platform adaptor.
+ *
+ * <hr>
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#ifndef LEGATO_SEC_STORE_INDEX_INCLUDE_GUARD
+#define LEGATO_SEC_STORE_INDEX_INCLUDE_GUARD
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Prototype for functions called for each item of an indexed area.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef void (*secIndex_ItemFunc_t)
+(
+    const char* itemNamePtr,        ///< [IN] Item name, relative to the area path.
+    size_t itemSize,                ///< [IN] Size of the item in bytes.
+    void* contextPtr                ///< [IN] Context supplied to secIndex_ForEachItem().
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initializes the index.  Must be called once before any other function in this module.
+ */
+//--------------------------------------------------------------------------------------------------
+void secIndex_Init
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the size of an item in an area.  The area is loaded from the platform adaptor if it has not
+ * been indexed yet.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_NOT_FOUND if the item does not exist.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t secIndex_GetItemSize
+(
+    const char* areaPathPtr,        ///< [IN] Path of the area in secure storage.
+    const char* itemNamePtr,        ///< [IN] Item name, relative to the area path.
+    size_t* sizePtr                 ///< [OUT] Size of the item in bytes.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the total number of bytes used by all items in an area.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t secIndex_GetUsedSpace
+(
+    const char* areaPathPtr,        ///< [IN] Path of the area in secure storage.
+    size_t* usedSpacePtr            ///< [OUT] Number of bytes used by the area.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Calls a function for every item of an area.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t secIndex_ForEachItem
+(
+    const char* areaPathPtr,        ///< [IN] Path of the area in secure storage.
+    secIndex_ItemFunc_t itemFunc,   ///< [IN] Function to call for each item.
+    void* contextPtr                ///< [IN] Context passed to the function.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Records that an item has been successfully written to an area.  Does nothing if the area is not
+ * indexed yet.
+ */
+//--------------------------------------------------------------------------------------------------
+void secIndex_SetItem
+(
+    const char* areaPathPtr,        ///< [IN] Path of the area in secure storage.
+    const char* itemNamePtr,        ///< [IN] Item name, relative to the area path.
+    size_t itemSize                 ///< [IN] New size of the item in bytes.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Records that an item, and everything under it, has been deleted from an area.  Does nothing if
+ * the area is not indexed yet.
+ */
+//--------------------------------------------------------------------------------------------------
+void secIndex_RemoveItem
+(
+    const char* areaPathPtr,        ///< [IN] Path of the area in secure storage.
+    const char* itemNamePtr         ///< [IN] Item name, relative to the area path.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Drops every cached area.  Must be called whenever secure storage is modified without going
+ * through an indexed area (e.g. through the admin API or when systems are re-initialized).
+ */
+//--------------------------------------------------------------------------------------------------
+void secIndex_InvalidateAll
+(
+    void
+);
+
+
+#endif // LEGATO_SEC_STORE_INDEX_INCLUDE_GUARD
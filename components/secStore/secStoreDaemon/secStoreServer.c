@@ -18,6 +18,8 @@
  * Copyright (C) Sierra Wireless Inc.
  */
 
+#include <arpa/inet.h>
+
 #include "legato.h"
 #include "interfaces.h"
 #include "appCfg.h"
@@ -25,6 +27,8 @@
 #include "limit.h"
 #include "user.h"
 #include "watchdogChain.h"
+#include "fileDescriptor.h"
+#include "secStoreIndex.h"
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -56,6 +60,14 @@
 //--------------------------------------------------------------------------------------------------
 #define GLOBAL_PATH         "/global"
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size, in bytes, of the record header that follows the item name in a batch: the item size as a
+ * 32-bit unsigned integer in network byte order.
+ */
+//--------------------------------------------------------------------------------------------------
+#define BATCH_SIZE_BYTES    sizeof(uint32_t)
+
 //--------------------------------------------------------------------------------------------------
 /**
  * The timer interval to kick the watchdog chain.
@@ -169,6 +181,50 @@ Entry_t;
 static le_mem_PoolRef_t EntryPool = NULL;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * A client's area of secure storage.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    bool isGlobal;                              ///< true if this is the global area.
+    char clientName[LIMIT_MAX_USER_NAME_BYTES]; ///< Name of the client (empty for the global area).
+    char path[SECSTOREADMIN_MAX_PATH_BYTES];    ///< Path of the area in secure storage.
+}
+ClientArea_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Buffers used to transfer items, or batches of items, through file descriptors.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t StreamBufferPool = NULL;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Data waiting to be written to a client's file descriptor.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint8_t* bufPtr;                ///< Stream buffer holding the data.
+    size_t size;                    ///< Number of bytes in the buffer.
+    size_t offset;                  ///< Number of bytes already written.
+}
+StreamOut_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool of pending stream writes.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t StreamOutPool = NULL;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Checks if the specified system index is in the list.
@@ -537,6 +593,9 @@ static le_result_t InitSystems
     ClearSystemList(&SecStoreSystems);
     ClearSystemList(&FrameworkSystems);
 
+    // Systems may have been copied or moved around so nothing cached is valid anymore.
+    secIndex_InvalidateAll();
+
     IsCurrSysPathValid = true;
 
     return LE_OK;
@@ -671,26 +730,139 @@ static void GetClientPath
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Checks if there is enough space in the client's area of secure storage for the client to write
- * the item.
+ * Gets the client's area of secure storage.  Must be called within an IPC message handler from the
+ * client.  Makes sure the systems are initialized first.
  *
  * @return
- *      LE_OK if the item would fit in the client's area of secure storage.
- *      LE_NO_MEMORY if there is not enough memory to store the item.
+ *      LE_OK if successful.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.  The client has been killed in this case.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t GetClientArea
+(
+    bool isGlobal,                          ///< [IN] Is this an operation is the global domain?
+    ClientArea_t* areaPtr                   ///< [OUT] Client's area.
+)
+{
+    // Make sure systems are initialized.
+    if (!IsCurrSysPathValid)
+    {
+        le_result_t r = InitSystems();
+
+        if (r != LE_OK)
+        {
+            return r;
+        }
+    }
+
+    areaPtr->isGlobal = isGlobal;
+    areaPtr->clientName[0] = '\0';
+
+    if (isGlobal)
+    {
+        LE_ASSERT(le_utf8_Copy(areaPtr->path, GLOBAL_PATH, sizeof(areaPtr->path), NULL) == LE_OK);
+        return LE_OK;
+    }
+
+    // Get the client's name and see if it is an app.
+    bool isApp;
+
+    if (GetClientName(areaPtr->clientName, sizeof(areaPtr->clientName), &isApp) != LE_OK)
+    {
+        LE_KILL_CLIENT("Could not get the client's name.");
+        return LE_FAULT;
+    }
+
+    // Get the path to the client's secure storage area.
+    GetClientPath(areaPtr->clientName, isApp, areaPtr->path, sizeof(areaPtr->path));
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the full path of an item in a client's area.
+ *
+ * @note
+ *      If the caller buffer is too small this function will kill the calling process.
+ */
+//--------------------------------------------------------------------------------------------------
+static void GetItemPath
+(
+    const ClientArea_t* areaPtr,            ///< [IN] Client's area.
+    const char* itemNamePtr,                ///< [IN] Name of the item.
+    char* bufPtr,                           ///< [OUT] Buffer to contain the path.
+    size_t bufSize                          ///< [IN] Size of the buffer.
+)
+{
+    bufPtr[0] = '\0';
+
+    LE_FATAL_IF(le_path_Concat("/", bufPtr, bufSize, areaPtr->path, itemNamePtr, NULL) != LE_OK,
+                "Path for item %s in area %s is too long.", itemNamePtr, areaPtr->path);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the size of an item in a client's area.  The area's index is used if it is available,
+ * otherwise the platform adaptor is queried.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_NOT_FOUND if the item does not exist.
  *      LE_UNAVAILABLE if the secure storage is currently unavailable.
  *      LE_FAULT if there was an error.
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t CheckClientLimit
+static le_result_t GetItemSize
 (
-    const char* clientNamePtr,              ///< [IN] Name of the client.
-    const char* clientPathPtr,              ///< [IN] Path to the client's area in secure storage.
+    const ClientArea_t* areaPtr,            ///< [IN] Client's area.
     const char* itemNamePtr,                ///< [IN] Name of the item.
-    size_t itemSize                         ///< [IN] Size, in bytes, of the item.
+    size_t* sizePtr                         ///< [OUT] Size of the item in bytes.
+)
+{
+    le_result_t result = secIndex_GetItemSize(areaPtr->path, itemNamePtr, sizePtr);
+
+    if ( (result == LE_OK) || (result == LE_NOT_FOUND) )
+    {
+        return result;
+    }
+
+    char itemPath[SECSTOREADMIN_MAX_PATH_BYTES];
+    GetItemPath(areaPtr, itemNamePtr, itemPath, sizeof(itemPath));
+
+    return pa_secStore_GetSize(itemPath, sizePtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks if there is enough space in the client's area of secure storage for the client to replace
+ * items totalling origSize bytes by items totalling newSize bytes.  The global area has no limit.
+ *
+ * @return
+ *      LE_OK if the items would fit in the client's area of secure storage.
+ *      LE_NO_MEMORY if there is not enough memory to store the items.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t CheckClientLimit
+(
+    const ClientArea_t* areaPtr,            ///< [IN] Client's area.
+    size_t origSize,                        ///< [IN] Size, in bytes, of the items being replaced.
+    size_t newSize                          ///< [IN] Size, in bytes, of the new items.
 )
 {
+    if (areaPtr->isGlobal)
+    {
+        return LE_OK;
+    }
+
     // Get the secure storage limit for the client.
-    appCfg_Iter_t iter = appCfg_FindApp(clientNamePtr);
+    appCfg_Iter_t iter = appCfg_FindApp(areaPtr->clientName);
     if (!iter)
     {
        LE_ERROR("iter is NULL");
@@ -701,29 +873,20 @@ static le_result_t CheckClientLimit
 
     // Get the current amount of space used by the client.
     size_t usedSpace = 0;
-    le_result_t result = pa_secStore_GetSize(clientPathPtr, &usedSpace);
+    le_result_t result = secIndex_GetUsedSpace(areaPtr->path, &usedSpace);
 
-    if ( (result != LE_OK) && (result != LE_NOT_FOUND) )
+    if (result != LE_OK)
     {
-        return result;
-    }
-
-    // Get the size of the item in the secure storage if it already exists.
-    char itemPath[SECSTOREADMIN_MAX_PATH_BYTES] = "";
-
-    LE_FATAL_IF(le_path_Concat("/", itemPath, sizeof(itemPath), clientPathPtr, itemNamePtr, NULL) != LE_OK,
-                "Client %s's path for item %s is too long.", clientNamePtr, itemNamePtr);
+        result = pa_secStore_GetSize(areaPtr->path, &usedSpace);
 
-    size_t origItemSize = 0;
-    result = pa_secStore_GetSize(itemPath, &origItemSize);
-
-    if ( (result != LE_OK) && (result != LE_NOT_FOUND) )
-    {
-        return result;
+        if ( (result != LE_OK) && (result != LE_NOT_FOUND) )
+        {
+            return result;
+        }
     }
 
-    // Calculate if replacing the item would fit within the limit.
-    if (((ssize_t)(secStoreLimit - usedSpace + origItemSize - itemSize)) >= 0)
+    // Calculate if replacing the items would fit within the limit.
+    if (((ssize_t)(secStoreLimit - usedSpace + origSize - newSize)) >= 0)
     {
         return LE_OK;
     }
@@ -775,6 +938,61 @@ static bool IsValidName
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes an item to a client's area, checking the client's limit first and keeping the area's
+ * index up to date.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_NO_MEMORY if there is not enough memory to store the item.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t WriteItem
+(
+    const ClientArea_t* areaPtr,    ///< [IN] Client's area.
+    const char* name,               ///< [IN] Name of the secure storage item.
+    const uint8_t* bufPtr,          ///< [IN] Buffer contain the data to store.
+    size_t bufNumElements           ///< [IN] Size of buffer.
+)
+{
+    // Check the available limit for the client.
+    size_t origItemSize = 0;
+    le_result_t result = GetItemSize(areaPtr, name, &origItemSize);
+
+    if ( (result != LE_OK) && (result != LE_NOT_FOUND) )
+    {
+        return result;
+    }
+
+    result = CheckClientLimit(areaPtr, origItemSize, bufNumElements);
+
+    if (result != LE_OK)
+    {
+        return result;
+    }
+
+    // Write the item to the secure storage.
+    char path[SECSTOREADMIN_MAX_PATH_BYTES];
+    GetItemPath(areaPtr, name, path, sizeof(path));
+
+    result = pa_secStore_Write(path, bufPtr, bufNumElements);
+
+    if (result == LE_OK)
+    {
+        secIndex_SetItem(areaPtr->path, name, bufNumElements);
+    }
+    else if (result == LE_BAD_PARAMETER)
+    {
+        return LE_FAULT;
+    }
+
+    return result;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Writes an item to secure storage.  If the item already exists then it will be overwritten with
@@ -809,63 +1027,15 @@ static le_result_t Write
         return LE_FAULT;
     }
 
-    // Make sure systems are initialized.
-    if (!IsCurrSysPathValid)
-    {
-        le_result_t r = InitSystems();
-
-        if (r != LE_OK)
-        {
-            return r;
-        }
-    }
-
-    char path[SECSTOREADMIN_MAX_PATH_BYTES] = {0};
-    le_result_t result;
-
-    if(isGlobal)
-    {
-        // Build global path based on prefix and item name.
-        LE_FATAL_IF(le_path_Concat("/", path, sizeof(path), GLOBAL_PATH, name, NULL) != LE_OK,
-                    "Global path for item %s is too long.", name);
-    }
-    else
-    {
-        // Get the client's name and see if it is an app.
-        bool isApp;
-        char clientName[LIMIT_MAX_USER_NAME_BYTES];
-
-        if (GetClientName(clientName, sizeof(clientName), &isApp) != LE_OK)
-        {
-            LE_KILL_CLIENT("Could not get the client's name.");
-            return LE_FAULT;
-        }
-
-        // Get the path to the client's secure storage area.
-        GetClientPath(clientName, isApp, path, sizeof(path));
-
-        // Check the available limit for the client.
-        result = CheckClientLimit(clientName, path, name, bufNumElements);
-
-        if (result != LE_OK)
-        {
-            return result;
-        }
-
-        // Append item name to client path.
-        LE_FATAL_IF(le_path_Concat("/", path, sizeof(path), name, NULL) != LE_OK,
-                    "Client %s's path for item %s is too long.", clientName, name);
-    }
-
-    // Write the item to the secure storage.
-    result = pa_secStore_Write(path, bufPtr, bufNumElements);
+    ClientArea_t area;
+    le_result_t result = GetClientArea(isGlobal, &area);
 
-    if (result == LE_BAD_PARAMETER)
+    if (result != LE_OK)
     {
-        return LE_FAULT;
+        return result;
     }
 
-    return result;
+    return WriteItem(&area, name, bufPtr, bufNumElements);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -914,6 +1084,47 @@ le_result_t secStoreGlobal_Write
     return Write(true, name, bufPtr, bufNumElements);
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads an item from a client's area.  The area's index is used to answer for missing items and
+ * too small buffers without going to the platform adaptor.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_OVERFLOW if the buffer is too small to hold the entire item.
+ *      LE_NOT_FOUND if the item does not exist.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReadItem
+(
+    const ClientArea_t* areaPtr,    ///< [IN] Client's area.
+    const char* name,               ///< [IN] Name of the secure storage item.
+    uint8_t* bufPtr,                ///< [OUT] Buffer to store the data in.
+    size_t* bufNumElementsPtr       ///< [INOUT] Size of buffer.
+)
+{
+    size_t itemSize;
+    le_result_t result = secIndex_GetItemSize(areaPtr->path, name, &itemSize);
+
+    if (result == LE_NOT_FOUND)
+    {
+        return LE_NOT_FOUND;
+    }
+
+    if ( (result == LE_OK) && (itemSize > *bufNumElementsPtr) )
+    {
+        return LE_OVERFLOW;
+    }
+
+    char path[SECSTOREADMIN_MAX_PATH_BYTES];
+    GetItemPath(areaPtr, name, path, sizeof(path));
+
+    return pa_secStore_Read(path, bufPtr, bufNumElementsPtr);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Reads an item from secure storage.
@@ -948,208 +1159,1069 @@ static le_result_t Read
         return LE_FAULT;
     }
 
-    // Make sure systems are initialized.
-    if (!IsCurrSysPathValid)
+    ClientArea_t area;
+    le_result_t result = GetClientArea(isGlobal, &area);
+
+    if (result != LE_OK)
     {
-        le_result_t r = InitSystems();
+        return result;
+    }
 
-        if (r != LE_OK)
-        {
-            return r;
+    // Read the item from the secure storage.
+    result = ReadItem(&area, name, bufPtr, bufNumElementsPtr);
+
+    // If there is an error, make sure that the buffer is empty.
+    if ( (LE_OK != result) && (bufNumElementsPtr > 0) )
+    {
+        bufPtr[0] = 0;
+        *bufNumElementsPtr = 0;
+    }
+
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads an item from secure storage.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_OVERFLOW if the buffer is too small to hold the entire item.  No data will be written to
+ *                  the buffer in this case.
+ *      LE_NOT_FOUND if the item does not exist.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_secStore_Read
+(
+    const char* name,               ///< [IN] Name of the secure storage item.
+    uint8_t* bufPtr,                ///< [OUT] Buffer to store the data in.
+    size_t* bufNumElementsPtr       ///< [INOUT] Size of buffer.
+)
+{
+    return Read(false, name, bufPtr, bufNumElementsPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads an item from secure storage.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_OVERFLOW if the buffer is too small to hold the entire item.  No data will be written to
+ *                  the buffer in this case.
+ *      LE_NOT_FOUND if the item does not exist.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t secStoreGlobal_Read
+(
+    const char* name,               ///< [IN] Name of the secure storage item.
+    uint8_t* bufPtr,                ///< [OUT] Buffer to store the data in.
+    size_t* bufNumElementsPtr       ///< [INOUT] Size of buffer.
+)
+{
+    return Read(true, name, bufPtr, bufNumElementsPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Deletes an item from secure storage.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_NOT_FOUND if the item does not exist.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t Delete
+(
+    bool isGlobal,      ///< [IN] Is this an operation is the global domain?
+    const char* name    ///< [IN] Name of the secure storage item.
+)
+{
+    // Check parameters.
+    if (!IsValidName(name))
+    {
+        LE_KILL_CLIENT("Item name is invalid.");
+        return LE_FAULT;
+    }
+
+    ClientArea_t area;
+    le_result_t result = GetClientArea(isGlobal, &area);
+
+    if (result != LE_OK)
+    {
+        return result;
+    }
+
+    char path[SECSTOREADMIN_MAX_PATH_BYTES];
+    GetItemPath(&area, name, path, sizeof(path));
+
+    // Delete the item from the secure storage.
+    result = pa_secStore_Delete(path);
+
+    if ( (result == LE_OK) || (result == LE_NOT_FOUND) )
+    {
+        secIndex_RemoveItem(area.path, name);
+    }
+
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Deletes an item from secure storage.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_NOT_FOUND if the item does not exist.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_secStore_Delete
+(
+    const char* name    ///< [IN] Name of the secure storage item.
+)
+{
+    return Delete(false, name);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Deletes an item from secure storage.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_NOT_FOUND if the item does not exist.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t secStoreGlobal_Delete
+(
+    const char* name    ///< [IN] Name of the secure storage item.
+)
+{
+    return Delete(true, name);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the size of an item in secure storage.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_NOT_FOUND if the item does not exist.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t GetSize
+(
+    bool isGlobal,                  ///< [IN] Is this an operation is the global domain?
+    const char* name,               ///< [IN] Name of the secure storage item.
+    uint32_t* sizePtr               ///< [OUT] Size of the item in bytes.
+)
+{
+    // Check parameters.
+    if (!IsValidName(name))
+    {
+        LE_KILL_CLIENT("Item name is invalid.");
+        return LE_FAULT;
+    }
+
+    if (sizePtr == NULL)
+    {
+        LE_KILL_CLIENT("sizePtr is NULL.");
+        return LE_FAULT;
+    }
+
+    ClientArea_t area;
+    le_result_t result = GetClientArea(isGlobal, &area);
+
+    if (result != LE_OK)
+    {
+        return result;
+    }
+
+    size_t size = 0;
+    result = GetItemSize(&area, name, &size);
+
+    *sizePtr = size;
+
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the size of an item in secure storage.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_NOT_FOUND if the item does not exist.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_secStore_GetItemSize
+(
+    const char* name,               ///< [IN] Name of the secure storage item.
+    uint32_t* sizePtr               ///< [OUT] Size of the item in bytes.
+)
+{
+    return GetSize(false, name, sizePtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the size of an item in secure storage.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_NOT_FOUND if the item does not exist.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t secStoreGlobal_GetItemSize
+(
+    const char* name,               ///< [IN] Name of the secure storage item.
+    uint32_t* sizePtr               ///< [OUT] Size of the item in bytes.
+)
+{
+    return GetSize(true, name, sizePtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads everything up to end-of-file from a client's file descriptor into a stream buffer.  The
+ * file descriptor is switched to non-blocking so that a client that did not close the write end of
+ * a pipe cannot stall the daemon.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_OVERFLOW if there is more than LE_SECSTORE_MAX_STREAM_SIZE bytes to read.
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReadStream
+(
+    int fd,                         ///< [IN] File descriptor to read from.
+    uint8_t* bufPtr,                ///< [OUT] Stream buffer.
+    size_t* sizePtr                 ///< [OUT] Number of bytes read.
+)
+{
+    size_t total = 0;
+
+    fd_SetNonBlocking(fd);
+
+    // Read one byte more than the buffer can hold so we know whether we hit end-of-file.
+    for (;;)
+    {
+        uint8_t extraByte;
+        uint8_t* destPtr = (total < LE_SECSTORE_MAX_STREAM_SIZE) ? bufPtr + total : &extraByte;
+        size_t destSize = (total < LE_SECSTORE_MAX_STREAM_SIZE) ?
+                          LE_SECSTORE_MAX_STREAM_SIZE - total : sizeof(extraByte);
+
+        ssize_t count = read(fd, destPtr, destSize);
+
+        if (count == 0)
+        {
+            *sizePtr = total;
+            return LE_OK;
+        }
+
+        if (count < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            if ( (errno == EAGAIN) || (errno == EWOULDBLOCK) )
+            {
+                LE_ERROR("Client did not close its end of the stream.");
+            }
+            else
+            {
+                LE_ERROR("Could not read client stream. %m.");
+            }
+
+            return LE_FAULT;
+        }
+
+        if (total >= LE_SECSTORE_MAX_STREAM_SIZE)
+        {
+            return LE_OVERFLOW;
+        }
+
+        total += count;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes as much pending data as possible to the client's file descriptor.
+ *
+ * @return
+ *      LE_OK if all the data has been written.
+ *      LE_WOULD_BLOCK if the file descriptor cannot accept more data for now.
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t DrainStream
+(
+    int fd,                         ///< [IN] File descriptor to write to.
+    StreamOut_t* streamPtr          ///< [IN] Pending data.
+)
+{
+    while (streamPtr->offset < streamPtr->size)
+    {
+        ssize_t count = write(fd,
+                              streamPtr->bufPtr + streamPtr->offset,
+                              streamPtr->size - streamPtr->offset);
+
+        if (count < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            if ( (errno == EAGAIN) || (errno == EWOULDBLOCK) )
+            {
+                return LE_WOULD_BLOCK;
+            }
+
+            LE_ERROR("Could not write client stream. %m.");
+            return LE_FAULT;
+        }
+
+        streamPtr->offset += count;
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Releases a pending stream write and closes its file descriptor.
+ */
+//--------------------------------------------------------------------------------------------------
+static void EndStream
+(
+    int fd,                         ///< [IN] File descriptor of the stream.
+    StreamOut_t* streamPtr          ///< [IN] Pending data.
+)
+{
+    fd_Close(fd);
+
+    le_mem_Release(streamPtr->bufPtr);
+    le_mem_Release(streamPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler called when a client's file descriptor can accept more data.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StreamOutHandler
+(
+    int fd,                         ///< [IN] File descriptor of the stream.
+    short events                    ///< [IN] Events that occurred.
+)
+{
+    le_fdMonitor_Ref_t monitorRef = le_fdMonitor_GetMonitor();
+    StreamOut_t* streamPtr = le_fdMonitor_GetContextPtr();
+
+    if ( (events & POLLOUT) && (DrainStream(fd, streamPtr) == LE_WOULD_BLOCK) )
+    {
+        return;
+    }
+
+    if (streamPtr->offset < streamPtr->size)
+    {
+        LE_WARN("Client stream closed with %zu bytes left to write.",
+                streamPtr->size - streamPtr->offset);
+    }
+
+    le_fdMonitor_Delete(monitorRef);
+    EndStream(fd, streamPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sends a stream buffer to a client's file descriptor.  Ownership of both the buffer and the file
+ * descriptor is taken.  Whatever cannot be written right away is written from the event loop as
+ * the client reads, so a slow reader never blocks the daemon.
+ */
+//--------------------------------------------------------------------------------------------------
+static void WriteStream
+(
+    int fd,                         ///< [IN] File descriptor to write to.
+    uint8_t* bufPtr,                ///< [IN] Stream buffer.
+    size_t size                     ///< [IN] Number of bytes to write.
+)
+{
+    StreamOut_t* streamPtr = le_mem_ForceAlloc(StreamOutPool);
+
+    streamPtr->bufPtr = bufPtr;
+    streamPtr->size = size;
+    streamPtr->offset = 0;
+
+    fd_SetNonBlocking(fd);
+
+    if (DrainStream(fd, streamPtr) != LE_WOULD_BLOCK)
+    {
+        EndStream(fd, streamPtr);
+        return;
+    }
+
+    le_fdMonitor_Ref_t monitorRef = le_fdMonitor_Create("SecStoreStream",
+                                                        fd,
+                                                        StreamOutHandler,
+                                                        POLLOUT);
+    le_fdMonitor_SetContextPtr(monitorRef, streamPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes an item to secure storage, taking its value from a file descriptor.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_OVERFLOW if there is more than LE_SECSTORE_MAX_STREAM_SIZE bytes to read.
+ *      LE_NO_MEMORY if there is not enough memory to store the item.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t WriteFromFd
+(
+    bool isGlobal,                  ///< [IN] Is this an operation is the global domain?
+    const char* name,               ///< [IN] Name of the secure storage item.
+    int fd                          ///< [IN] File descriptor to read the value from.
+)
+{
+    // Check parameters.
+    if (!IsValidName(name))
+    {
+        fd_Close(fd);
+        LE_KILL_CLIENT("Item name is invalid.");
+        return LE_FAULT;
+    }
+
+    if (fd < 0)
+    {
+        LE_KILL_CLIENT("Invalid file descriptor.");
+        return LE_FAULT;
+    }
+
+    ClientArea_t area;
+    le_result_t result = GetClientArea(isGlobal, &area);
+
+    if (result != LE_OK)
+    {
+        fd_Close(fd);
+        return result;
+    }
+
+    uint8_t* bufPtr = le_mem_ForceAlloc(StreamBufferPool);
+    size_t size = 0;
+
+    result = ReadStream(fd, bufPtr, &size);
+    fd_Close(fd);
+
+    if (result == LE_OK)
+    {
+        result = WriteItem(&area, name, bufPtr, size);
+    }
+
+    le_mem_Release(bufPtr);
+
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes an item to secure storage, taking its value from a file descriptor.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_OVERFLOW if there is more than LE_SECSTORE_MAX_STREAM_SIZE bytes to read.
+ *      LE_NO_MEMORY if there is not enough memory to store the item.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_secStore_WriteFromFd
+(
+    const char* name,               ///< [IN] Name of the secure storage item.
+    int fd                          ///< [IN] File descriptor to read the value from.
+)
+{
+    return WriteFromFd(false, name, fd);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes an item to secure storage, taking its value from a file descriptor.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_OVERFLOW if there is more than LE_SECSTORE_MAX_STREAM_SIZE bytes to read.
+ *      LE_NO_MEMORY if there is not enough memory to store the item.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t secStoreGlobal_WriteFromFd
+(
+    const char* name,               ///< [IN] Name of the secure storage item.
+    int fd                          ///< [IN] File descriptor to read the value from.
+)
+{
+    return WriteFromFd(true, name, fd);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads an item from secure storage into a file descriptor.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_NOT_FOUND if the item does not exist.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReadToFd
+(
+    bool isGlobal,                  ///< [IN] Is this an operation is the global domain?
+    const char* name,               ///< [IN] Name of the secure storage item.
+    int fd                          ///< [IN] File descriptor to write the value to.
+)
+{
+    // Check parameters.
+    if (!IsValidName(name))
+    {
+        fd_Close(fd);
+        LE_KILL_CLIENT("Item name is invalid.");
+        return LE_FAULT;
+    }
+
+    if (fd < 0)
+    {
+        LE_KILL_CLIENT("Invalid file descriptor.");
+        return LE_FAULT;
+    }
+
+    ClientArea_t area;
+    le_result_t result = GetClientArea(isGlobal, &area);
+
+    if (result != LE_OK)
+    {
+        fd_Close(fd);
+        return result;
+    }
+
+    uint8_t* bufPtr = le_mem_ForceAlloc(StreamBufferPool);
+    size_t size = LE_SECSTORE_MAX_STREAM_SIZE;
+
+    result = ReadItem(&area, name, bufPtr, &size);
+
+    if (result != LE_OK)
+    {
+        // The item is never larger than what can be streamed so an overflow is an internal error.
+        le_mem_Release(bufPtr);
+        fd_Close(fd);
+        return (result == LE_OVERFLOW) ? LE_FAULT : result;
+    }
+
+    WriteStream(fd, bufPtr, size);
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads an item from secure storage into a file descriptor.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_NOT_FOUND if the item does not exist.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_secStore_ReadToFd
+(
+    const char* name,               ///< [IN] Name of the secure storage item.
+    int fd                          ///< [IN] File descriptor to write the value to.
+)
+{
+    return ReadToFd(false, name, fd);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads an item from secure storage into a file descriptor.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_NOT_FOUND if the item does not exist.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t secStoreGlobal_ReadToFd
+(
+    const char* name,               ///< [IN] Name of the secure storage item.
+    int fd                          ///< [IN] File descriptor to write the value to.
+)
+{
+    return ReadToFd(true, name, fd);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parses the next record of a batch.
+ *
+ * @return
+ *      LE_OK if a record was parsed.
+ *      LE_NOT_FOUND if there are no more records.
+ *      LE_FORMAT_ERROR if the record is malformed.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t NextBatchRecord
+(
+    const uint8_t* batchPtr,        ///< [IN] Batch buffer.
+    size_t batchSize,               ///< [IN] Number of bytes in the batch.
+    size_t* offsetPtr,              ///< [INOUT] Offset of the record in the batch.
+    const char** namePtrPtr,        ///< [OUT] Name of the item.
+    const uint8_t** dataPtrPtr,     ///< [OUT] Value of the item.
+    size_t* dataSizePtr             ///< [OUT] Size of the item's value.
+)
+{
+    size_t offset = *offsetPtr;
+
+    if (offset >= batchSize)
+    {
+        return LE_NOT_FOUND;
+    }
+
+    const uint8_t* nulPtr = memchr(batchPtr + offset, '\0', batchSize - offset);
+
+    if (nulPtr == NULL)
+    {
+        return LE_FORMAT_ERROR;
+    }
+
+    *namePtrPtr = (const char*)(batchPtr + offset);
+    offset = (nulPtr - batchPtr) + 1;
+
+    if ((batchSize - offset) < BATCH_SIZE_BYTES)
+    {
+        return LE_FORMAT_ERROR;
+    }
+
+    uint32_t netSize;
+    memcpy(&netSize, batchPtr + offset, sizeof(netSize));
+    offset += BATCH_SIZE_BYTES;
+
+    size_t dataSize = ntohl(netSize);
+
+    if ((batchSize - offset) < dataSize)
+    {
+        return LE_FORMAT_ERROR;
+    }
+
+    *dataPtrPtr = batchPtr + offset;
+    *dataSizePtr = dataSize;
+    *offsetPtr = offset + dataSize;
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks whether an item of a batch is written again by a later record of the same batch, in which
+ * case only the last record is taken into account.
+ *
+ * @return
+ *      true if a later record has the same name.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsRewrittenInBatch
+(
+    const uint8_t* batchPtr,        ///< [IN] Batch buffer.
+    size_t batchSize,               ///< [IN] Number of bytes in the batch.
+    size_t offset,                  ///< [IN] Offset of the record following the item's record.
+    const char* namePtr             ///< [IN] Name of the item.
+)
+{
+    const char* laterNamePtr;
+    const uint8_t* dataPtr;
+    size_t dataSize;
+
+    while (NextBatchRecord(batchPtr, batchSize, &offset,
+                           &laterNamePtr, &dataPtr, &dataSize) == LE_OK)
+    {
+        if (strcmp(laterNamePtr, namePtr) == 0)
+        {
+            return true;
         }
     }
 
-    char path[SECSTOREADMIN_MAX_PATH_BYTES] = {0};
-    le_result_t result;
+    return false;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes several items to secure storage from batch records read from a file descriptor.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_OVERFLOW if there is more than LE_SECSTORE_MAX_STREAM_SIZE bytes to read.
+ *      LE_FORMAT_ERROR if the records are malformed.
+ *      LE_NO_MEMORY if there is not enough memory to store the items.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t WriteBatch
+(
+    bool isGlobal,                  ///< [IN] Is this an operation is the global domain?
+    int fd,                         ///< [IN] File descriptor to read the records from.
+    uint32_t* numItemsPtr           ///< [OUT] Number of items written.
+)
+{
+    if (fd < 0)
+    {
+        LE_KILL_CLIENT("Invalid file descriptor.");
+        return LE_FAULT;
+    }
 
-    if(isGlobal)
+    if (numItemsPtr == NULL)
     {
-        // Build global path based on prefix and item name.
-        LE_FATAL_IF(le_path_Concat("/", path, sizeof(path), GLOBAL_PATH, name, NULL) != LE_OK,
-                    "Global path for item %s is too long.", name);
+        fd_Close(fd);
+        LE_KILL_CLIENT("numItemsPtr is NULL.");
+        return LE_FAULT;
     }
-    else
+
+    *numItemsPtr = 0;
+
+    ClientArea_t area;
+    le_result_t result = GetClientArea(isGlobal, &area);
+
+    if (result != LE_OK)
+    {
+        fd_Close(fd);
+        return result;
+    }
+
+    uint8_t* batchPtr = le_mem_ForceAlloc(StreamBufferPool);
+    size_t batchSize = 0;
+
+    result = ReadStream(fd, batchPtr, &batchSize);
+    fd_Close(fd);
+
+    if (result != LE_OK)
     {
-        // Get the client's name and see if it is an app.
-        bool isApp;
-        char clientName[LIMIT_MAX_USER_NAME_BYTES];
+        le_mem_Release(batchPtr);
+        return result;
+    }
 
-        if (GetClientName(clientName, sizeof(clientName), &isApp) != LE_OK)
+    // First pass: validate every record and work out the space needed for the whole batch.  When
+    // an item appears several times, the last record wins and the others are skipped, so that the
+    // existing item is only replaced once.
+    size_t offset = 0;
+    size_t origSize = 0;
+    size_t newSize = 0;
+    const char* namePtr;
+    const uint8_t* dataPtr;
+    size_t dataSize;
+
+    while ((result = NextBatchRecord(batchPtr, batchSize, &offset,
+                                     &namePtr, &dataPtr, &dataSize)) == LE_OK)
+    {
+        if (!IsValidName(namePtr))
         {
-            LE_KILL_CLIENT("Could not get the client's name.");
+            le_mem_Release(batchPtr);
+            LE_KILL_CLIENT("Item name is invalid.");
             return LE_FAULT;
         }
 
-        // Get the path to the client's secure storage area.
-        GetClientPath(clientName, isApp, path, sizeof(path));
+        if (IsRewrittenInBatch(batchPtr, batchSize, offset, namePtr))
+        {
+            continue;
+        }
+
+        size_t itemSize = 0;
+        le_result_t sizeResult = GetItemSize(&area, namePtr, &itemSize);
+
+        if (sizeResult == LE_OK)
+        {
+            origSize += itemSize;
+        }
+        else if (sizeResult != LE_NOT_FOUND)
+        {
+            le_mem_Release(batchPtr);
+            return sizeResult;
+        }
 
-        // Append item name to client path.
-        LE_FATAL_IF(le_path_Concat("/", path, sizeof(path), name, NULL) != LE_OK,
-                    "Client %s's path for item %s is too long.", clientName, name);
+        newSize += dataSize;
     }
 
-    // Read the item from the secure storage.
-    result = pa_secStore_Read(path, bufPtr, bufNumElementsPtr);
+    if (result == LE_NOT_FOUND)
+    {
+        result = CheckClientLimit(&area, origSize, newSize);
+    }
 
-    // If there is an error, make sure that the buffer is empty.
-    if ( (LE_OK != result) && (bufNumElementsPtr > 0) )
+    // Second pass: write the items.
+    offset = 0;
+
+    while ( (result == LE_OK) &&
+            (NextBatchRecord(batchPtr, batchSize, &offset, &namePtr, &dataPtr, &dataSize) == LE_OK) )
     {
-        bufPtr[0] = 0;
-        *bufNumElementsPtr = 0;
+        if (IsRewrittenInBatch(batchPtr, batchSize, offset, namePtr))
+        {
+            continue;
+        }
+
+        char path[SECSTOREADMIN_MAX_PATH_BYTES];
+        GetItemPath(&area, namePtr, path, sizeof(path));
+
+        result = pa_secStore_Write(path, dataPtr, dataSize);
+
+        if (result == LE_OK)
+        {
+            secIndex_SetItem(area.path, namePtr, dataSize);
+            (*numItemsPtr)++;
+        }
+        else
+        {
+            LE_ERROR("Could not write batch item '%s'. %s.", namePtr, LE_RESULT_TXT(result));
+        }
     }
 
-    return result;
+    le_mem_Release(batchPtr);
+
+    return (result == LE_BAD_PARAMETER) ? LE_FAULT : result;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Reads an item from secure storage.
+ * Writes several items to secure storage from batch records read from a file descriptor.
  *
  * @return
  *      LE_OK if successful.
- *      LE_OVERFLOW if the buffer is too small to hold the entire item.  No data will be written to
- *                  the buffer in this case.
- *      LE_NOT_FOUND if the item does not exist.
+ *      LE_OVERFLOW if there is more than LE_SECSTORE_MAX_STREAM_SIZE bytes to read.
+ *      LE_FORMAT_ERROR if the records are malformed.
+ *      LE_NO_MEMORY if there is not enough memory to store the items.
  *      LE_UNAVAILABLE if the secure storage is currently unavailable.
  *      LE_FAULT if there was some other error.
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t le_secStore_Read
+le_result_t le_secStore_WriteBatch
 (
-    const char* name,               ///< [IN] Name of the secure storage item.
-    uint8_t* bufPtr,                ///< [OUT] Buffer to store the data in.
-    size_t* bufNumElementsPtr       ///< [INOUT] Size of buffer.
+    int fd,                         ///< [IN] File descriptor to read the records from.
+    uint32_t* numItemsPtr           ///< [OUT] Number of items written.
 )
 {
-    return Read(false, name, bufPtr, bufNumElementsPtr);
+    return WriteBatch(false, fd, numItemsPtr);
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Reads an item from secure storage.
+ * Writes several items to secure storage from batch records read from a file descriptor.
  *
  * @return
  *      LE_OK if successful.
- *      LE_OVERFLOW if the buffer is too small to hold the entire item.  No data will be written to
- *                  the buffer in this case.
- *      LE_NOT_FOUND if the item does not exist.
+ *      LE_OVERFLOW if there is more than LE_SECSTORE_MAX_STREAM_SIZE bytes to read.
+ *      LE_FORMAT_ERROR if the records are malformed.
+ *      LE_NO_MEMORY if there is not enough memory to store the items.
  *      LE_UNAVAILABLE if the secure storage is currently unavailable.
  *      LE_FAULT if there was some other error.
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t secStoreGlobal_Read
+le_result_t secStoreGlobal_WriteBatch
 (
-    const char* name,               ///< [IN] Name of the secure storage item.
-    uint8_t* bufPtr,                ///< [OUT] Buffer to store the data in.
-    size_t* bufNumElementsPtr       ///< [INOUT] Size of buffer.
+    int fd,                         ///< [IN] File descriptor to read the records from.
+    uint32_t* numItemsPtr           ///< [OUT] Number of items written.
 )
 {
-    return Read(true, name, bufPtr, bufNumElementsPtr);
+    return WriteBatch(true, fd, numItemsPtr);
 }
 
+
 //--------------------------------------------------------------------------------------------------
 /**
- * Deletes an item from secure storage.
+ * Reads several items from secure storage and writes them as batch records to a file descriptor.
  *
  * @return
  *      LE_OK if successful.
- *      LE_NOT_FOUND if the item does not exist.
+ *      LE_OVERFLOW if the records would be larger than LE_SECSTORE_MAX_STREAM_SIZE bytes.
  *      LE_UNAVAILABLE if the secure storage is currently unavailable.
  *      LE_FAULT if there was some other error.
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t Delete
+static le_result_t ReadBatch
 (
-    bool isGlobal,      ///< [IN] Is this an operation is the global domain?
-    const char* name    ///< [IN] Name of the secure storage item.
+    bool isGlobal,                  ///< [IN] Is this an operation is the global domain?
+    const uint8_t* namesPtr,        ///< [IN] Consecutive NUL-terminated item names.
+    size_t namesSize,               ///< [IN] Size of the names buffer.
+    int fd,                         ///< [IN] File descriptor to write the records to.
+    uint32_t* numItemsPtr           ///< [OUT] Number of items found and written.
 )
 {
-    // Check parameters.
-    if (!IsValidName(name))
+    if (fd < 0)
     {
-        LE_KILL_CLIENT("Item name is invalid.");
+        LE_KILL_CLIENT("Invalid file descriptor.");
         return LE_FAULT;
     }
 
-    // Make sure systems are initialized.
-    if (!IsCurrSysPathValid)
+    if ( (namesPtr == NULL) || (numItemsPtr == NULL) )
     {
-        le_result_t r = InitSystems();
-
-        if (r != LE_OK)
-        {
-            return r;
-        }
+        fd_Close(fd);
+        LE_KILL_CLIENT("Client buffer should not be NULL.");
+        return LE_FAULT;
     }
 
-    char path[SECSTOREADMIN_MAX_PATH_BYTES] = {0};
+    *numItemsPtr = 0;
 
-    if(isGlobal)
+    ClientArea_t area;
+    le_result_t result = GetClientArea(isGlobal, &area);
+
+    if (result != LE_OK)
     {
-        // Build global path based on prefix and item name.
-        LE_FATAL_IF(le_path_Concat("/", path, sizeof(path), GLOBAL_PATH, name, NULL) != LE_OK,
-                    "Global path for item %s is too long.", name);
+        fd_Close(fd);
+        return result;
     }
-    else
+
+    uint8_t* batchPtr = le_mem_ForceAlloc(StreamBufferPool);
+    size_t batchSize = 0;
+    size_t namesOffset = 0;
+
+    while ( (result == LE_OK) && (namesOffset < namesSize) )
     {
-        // Get the client's name and see if it is an app.
-        bool isApp;
-        char clientName[LIMIT_MAX_USER_NAME_BYTES];
+        const char* namePtr = (const char*)(namesPtr + namesOffset);
+        size_t nameLen = strnlen(namePtr, namesSize - namesOffset);
 
-        if (GetClientName(clientName, sizeof(clientName), &isApp) != LE_OK)
+        if ( (nameLen == (namesSize - namesOffset)) || !IsValidName(namePtr) )
         {
-            LE_KILL_CLIENT("Could not get the client's name.");
+            le_mem_Release(batchPtr);
+            fd_Close(fd);
+            LE_KILL_CLIENT("Item name is invalid.");
             return LE_FAULT;
         }
 
-        // Get the path to the client's secure storage area.
-        GetClientPath(clientName, isApp, path, sizeof(path));
+        namesOffset += nameLen + 1;
+
+        size_t headerSize = nameLen + 1 + BATCH_SIZE_BYTES;
+
+        if ((LE_SECSTORE_MAX_STREAM_SIZE - batchSize) < headerSize)
+        {
+            result = LE_OVERFLOW;
+            break;
+        }
+
+        // Read the value straight into the batch, after room for its header.
+        size_t dataSize = LE_SECSTORE_MAX_STREAM_SIZE - batchSize - headerSize;
+
+        result = ReadItem(&area, namePtr, batchPtr + batchSize + headerSize, &dataSize);
+
+        if (result == LE_NOT_FOUND)
+        {
+            result = LE_OK;
+            continue;
+        }
+
+        if (result != LE_OK)
+        {
+            break;
+        }
+
+        uint32_t netSize = htonl(dataSize);
 
-        // Append item name to client path.
-        LE_FATAL_IF(le_path_Concat("/", path, sizeof(path), name, NULL) != LE_OK,
-                    "Client %s's path for item %s is too long.", clientName, name);
+        memcpy(batchPtr + batchSize, namePtr, nameLen + 1);
+        memcpy(batchPtr + batchSize + nameLen + 1, &netSize, sizeof(netSize));
+
+        batchSize += headerSize + dataSize;
+        (*numItemsPtr)++;
     }
 
-    // Delete the item from the secure storage.
-    return pa_secStore_Delete(path);
+    if (result != LE_OK)
+    {
+        *numItemsPtr = 0;
+        le_mem_Release(batchPtr);
+        fd_Close(fd);
+        return result;
+    }
+
+    WriteStream(fd, batchPtr, batchSize);
+
+    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Deletes an item from secure storage.
+ * Reads several items from secure storage and writes them as batch records to a file descriptor.
  *
  * @return
  *      LE_OK if successful.
- *      LE_NOT_FOUND if the item does not exist.
+ *      LE_OVERFLOW if the records would be larger than LE_SECSTORE_MAX_STREAM_SIZE bytes.
  *      LE_UNAVAILABLE if the secure storage is currently unavailable.
  *      LE_FAULT if there was some other error.
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t le_secStore_Delete
+le_result_t le_secStore_ReadBatch
 (
-    const char* name    ///< [IN] Name of the secure storage item.
+    const uint8_t* namesPtr,        ///< [IN] Consecutive NUL-terminated item names.
+    size_t namesSize,               ///< [IN] Size of the names buffer.
+    int fd,                         ///< [IN] File descriptor to write the records to.
+    uint32_t* numItemsPtr           ///< [OUT] Number of items found and written.
 )
 {
-    return Delete(false, name);
+    return ReadBatch(false, namesPtr, namesSize, fd, numItemsPtr);
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Deletes an item from secure storage.
+ * Reads several items from secure storage and writes them as batch records to a file descriptor.
  *
  * @return
  *      LE_OK if successful.
- *      LE_NOT_FOUND if the item does not exist.
+ *      LE_OVERFLOW if the records would be larger than LE_SECSTORE_MAX_STREAM_SIZE bytes.
  *      LE_UNAVAILABLE if the secure storage is currently unavailable.
  *      LE_FAULT if there was some other error.
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t secStoreGlobal_Delete
+le_result_t secStoreGlobal_ReadBatch
 (
-    const char* name    ///< [IN] Name of the secure storage item.
+    const uint8_t* namesPtr,        ///< [IN] Consecutive NUL-terminated item names.
+    size_t namesSize,               ///< [IN] Size of the names buffer.
+    int fd,                         ///< [IN] File descriptor to write the records to.
+    uint32_t* numItemsPtr           ///< [OUT] Number of items found and written.
 )
 {
-    return Delete(true, name);
+    return ReadBatch(true, namesPtr, namesSize, fd, numItemsPtr);
 }
 
 
@@ -1533,6 +2605,105 @@ le_result_t secStoreAdmin_GetEntry
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Moves the iterator over as many of the following entries as fit in the buffer and gets their
+ * names.  Names are stored as consecutive NUL-terminated strings, directory names end with a '/'.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_NOT_FOUND if there are no more entries available.
+ *      LE_OVERFLOW if the buffer is too small to hold the next entry name.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t secStoreAdmin_GetNextEntries
+(
+    secStoreAdmin_IterRef_t iterRef,
+        ///< [IN]
+        ///< Iterator reference.
+
+    uint8_t* bufPtr,
+        ///< [OUT]
+        ///< Buffer to store the entry names.
+
+    size_t* bufNumElementsPtr,
+        ///< [INOUT]
+
+    uint32_t* numEntriesPtr
+        ///< [OUT]
+        ///< Number of entry names stored in the buffer.
+)
+{
+#if (SECSTOREADMIN == 1)
+    if ( (bufPtr == NULL) || (bufNumElementsPtr == NULL) || (numEntriesPtr == NULL) )
+    {
+        LE_KILL_CLIENT("Client buffer should not be NULL.");
+        return LE_FAULT;
+    }
+
+    // Get the iterator from the safe reference.
+    EntryIter_t* iterPtr = GetEntryIterPtr(iterRef);
+
+    if (NULL == iterPtr)
+    {
+        // Already killed client, just need to return from this function.
+        return LE_FAULT;
+    }
+
+    size_t bufSize = *bufNumElementsPtr;
+    size_t used = 0;
+
+    *numEntriesPtr = 0;
+    *bufNumElementsPtr = 0;
+
+    for (;;)
+    {
+        le_sls_Link_t* nextPtr = (iterPtr->currEntryPtr == NULL) ?
+                                 le_sls_Peek(&(iterPtr->entryList)) :
+                                 le_sls_PeekNext(&(iterPtr->entryList), iterPtr->currEntryPtr);
+
+        if (nextPtr == NULL)
+        {
+            break;
+        }
+
+        Entry_t* entryPtr = CONTAINER_OF(nextPtr, Entry_t, link);
+        size_t nameLen = strlen(entryPtr->path);
+        size_t neededSize = nameLen + (entryPtr->isDir ? 1 : 0) + 1;
+
+        if ((bufSize - used) < neededSize)
+        {
+            if (*numEntriesPtr == 0)
+            {
+                return LE_OVERFLOW;
+            }
+            break;
+        }
+
+        memcpy(bufPtr + used, entryPtr->path, nameLen);
+        used += nameLen;
+
+        if (entryPtr->isDir)
+        {
+            bufPtr[used++] = '/';
+        }
+
+        bufPtr[used++] = '\0';
+
+        iterPtr->currEntryPtr = nextPtr;
+        (*numEntriesPtr)++;
+    }
+
+    *bufNumElementsPtr = used;
+
+    return (*numEntriesPtr == 0) ? LE_NOT_FOUND : LE_OK;
+#else
+    return LE_UNSUPPORTED;
+#endif
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Writes a buffer of data into the specified path in secure storage.  If the item already exists,
@@ -1578,6 +2749,9 @@ le_result_t secStoreAdmin_Write
         return LE_FAULT;
     }
 
+    // The path may be inside a client area so drop the cached indexes.
+    secIndex_InvalidateAll();
+
     // Write the item to the secure storage.
     return pa_secStore_Write(path, bufPtr, bufNumElements);
 
@@ -1695,6 +2869,9 @@ le_result_t secStoreAdmin_Delete
         return LE_FAULT;
     }
 
+    // The path may be inside a client area so drop the cached indexes.
+    secIndex_InvalidateAll();
+
     // Delete the item from the secure storage.
     return pa_secStore_Delete(path);
 #else
@@ -1794,6 +2971,23 @@ le_result_t secStoreAdmin_GetTotalSpace
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * The signal event handler function for SIGPIPE called from the Legato event loop.
+ *
+ * A client closing the read end of a stream before all the data has been written would otherwise
+ * kill the daemon.  With the signal caught, the write only fails with EPIPE.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SigPipeHandler
+(
+    int sigNum
+)
+{
+    LE_DEBUG("%s received through SigPipeHandler.", strsignal(sigNum));
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * The secure storage daemon's initialization function.
@@ -1808,6 +3002,15 @@ COMPONENT_INIT
 
     SystemIndexPool = le_mem_CreatePool("SystemIndexPool", sizeof(SystemsIndex_t));
 
+    StreamBufferPool = le_mem_CreatePool("StreamBufferPool", LE_SECSTORE_MAX_STREAM_SIZE);
+    StreamOutPool = le_mem_CreatePool("StreamOutPool", sizeof(StreamOut_t));
+
+    secIndex_Init();
+
+    // Writing to a stream whose reader went away must fail rather than kill the daemon.
+    le_sig_Block(SIGPIPE);
+    le_sig_SetEventHandler(SIGPIPE, SigPipeHandler);
+
     // Register a handler that will clean up client specific data when clients disconnect.
     le_msg_AddServiceCloseHandler(secStoreAdmin_GetServiceRef(),
                                   CleanupClientIterators,
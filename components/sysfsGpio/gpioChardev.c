@@ -0,0 +1,1699 @@
+/**
+ * @file gpioChardev.c
+ *
+ * Implementation of the generic GPIO functions on top of the Linux GPIO character device
+ * (/dev/gpiochipN). This is an alternative to gpioSysfsUtils.c which is selected at build time by
+ * setting GPIO_CHARDEV=1.
+ *
+ * The sysfs interface opens, writes and closes an attribute file for every access. Here, a line
+ * handle is requested from the kernel the first time a pin is used and kept open until the client
+ * session closes, so reading or driving a pin costs a single ioctl. Pins which are read or written
+ * together through gpioSysfs_ReadValues()/gpioSysfs_WriteValues() share a multi-line handle so
+ * that all of them are accessed with a single ioctl. Edge events are read from the line event file
+ * descriptor, which carries the kernel timestamp of each edge.
+ *
+ * GPIO pin N is mapped to line offset (N - firstPin) of the GPIO chip, both being read from the
+ * config tree:
+ *  - gpioService:/chardev/chip (default "/dev/gpiochip0")
+ *  - gpioService:/chardev/firstPin (default 1)
+ *
+ * <HR>
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+#include "gpioSysfs.h"
+
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Config tree nodes and default values for the GPIO chip used by this backend.
+ */
+//--------------------------------------------------------------------------------------------------
+#define CFG_CHIP_PATH       "gpioService:/chardev/chip"
+#define CFG_FIRST_PIN       "gpioService:/chardev/firstPin"
+#define DEFAULT_CHIP_PATH   "/dev/gpiochip0"
+#define DEFAULT_FIRST_PIN   1
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Max and Min Pin Numbers
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_PIN_NUMBER 64
+#define MIN_PIN_NUMBER 1
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Consumer label given to the kernel for the lines requested by this service.
+ */
+//--------------------------------------------------------------------------------------------------
+#define CONSUMER_LABEL "gpioService"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of edge events read from a line event file descriptor in a single read().
+ */
+//--------------------------------------------------------------------------------------------------
+#define EVENT_READ_COUNT 16
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Line request flags which are kept when the line is reconfigured. Bias flags only exist in
+ * kernel headers from Linux 5.5.
+ */
+//--------------------------------------------------------------------------------------------------
+#define DIRECTION_FLAGS (GPIOHANDLE_REQUEST_INPUT | GPIOHANDLE_REQUEST_OUTPUT)
+#ifdef GPIOHANDLE_REQUEST_BIAS_PULL_UP
+#define BIAS_FLAGS      (GPIOHANDLE_REQUEST_BIAS_PULL_UP | GPIOHANDLE_REQUEST_BIAS_PULL_DOWN | \
+                         GPIOHANDLE_REQUEST_BIAS_DISABLE)
+#else
+#define BIAS_FLAGS      0
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A multi-line handle shared by GPIOs which are accessed together.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    int fd;                                         ///< Multi-line handle
+    uint32_t numLines;                              ///< Number of lines in the handle
+    gpioSysfs_GpioRef_t gpioRefs[GPIOHANDLES_MAX];  ///< GPIO of each line, in request order
+    struct gpiohandle_data data;                    ///< Last value written to each line
+}
+LineGroup_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Character device state of a GPIO.
+ */
+//--------------------------------------------------------------------------------------------------
+struct gpioSysfs_Line
+{
+    uint32_t offset;                        ///< Line offset in the GPIO chip
+    uint32_t flags;                         ///< GPIOHANDLE_REQUEST_* flags. 0 leaves line as-is
+    gpioSysfs_EdgeSensivityMode_t edge;     ///< Edge(s) reported to the change callback
+    int fd;                                 ///< Line handle or event fd, -1 if not requested
+    bool isEvent;                           ///< true if fd is a line event file descriptor
+    uint8_t value;                          ///< Last logical value written to the line
+    LineGroup_t* groupPtr;                  ///< Multi-line handle holding this line, or NULL
+    uint32_t groupIndex;                    ///< Index of this line in the multi-line handle
+    le_fdMonitor_HandlerFunc_t fdMonFunc;   ///< Event handler of the per-pin service
+    uint64_t eventTimestamp;                ///< Kernel timestamp of the last edge, 0 if none
+};
+
+typedef struct gpioSysfs_Line Line_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * File descriptor of the GPIO chip, -1 if not open.
+ */
+//--------------------------------------------------------------------------------------------------
+static int ChipFd = -1;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of lines of the GPIO chip.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t ChipNumLines;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * GPIO pin number mapped to line offset 0.
+ */
+//--------------------------------------------------------------------------------------------------
+static int FirstPin = DEFAULT_FIRST_PIN;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pools of line states and multi-line handles.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t LinePool;
+static le_mem_PoolRef_t LineGroupPool;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open the GPIO chip. This is done once, when the availability of the first pin is checked.
+ *
+ * @return true if the chip is open.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool OpenChip
+(
+    void
+)
+{
+    static bool initDone = false;
+    char chipPath[PATH_MAX];
+    struct gpiochip_info info;
+
+    if (initDone)
+    {
+        return (ChipFd >= 0);
+    }
+    initDone = true;
+
+    LinePool = le_mem_CreatePool("GpioLinePool", sizeof(Line_t));
+    LineGroupPool = le_mem_CreatePool("GpioLineGroupPool", sizeof(LineGroup_t));
+
+    if (LE_OK != le_cfg_QuickGetString(CFG_CHIP_PATH, chipPath, sizeof(chipPath),
+                                       DEFAULT_CHIP_PATH))
+    {
+        LE_ERROR("Invalid GPIO chip path in %s", CFG_CHIP_PATH);
+        return false;
+    }
+    FirstPin = le_cfg_QuickGetInt(CFG_FIRST_PIN, DEFAULT_FIRST_PIN);
+
+    do
+    {
+        ChipFd = open(chipPath, O_RDWR | O_CLOEXEC);
+    }
+    while ((ChipFd < 0) && (errno == EINTR));
+
+    if (ChipFd < 0)
+    {
+        LE_ERROR("Unable to open GPIO chip %s. %m", chipPath);
+        return false;
+    }
+
+    if (ioctl(ChipFd, GPIO_GET_CHIPINFO_IOCTL, &info) < 0)
+    {
+        LE_ERROR("Unable to get information of GPIO chip %s. %m", chipPath);
+        close(ChipFd);
+        ChipFd = -1;
+        return false;
+    }
+
+    ChipNumLines = info.lines;
+    LE_INFO("Using GPIO chip %s (%s, %u lines), pin %d at offset 0",
+            info.name, info.label, info.lines, FirstPin);
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the line state of a GPIO.
+ *
+ * @return The line state, or NULL if the reference is invalid or the GPIO is not in use.
+ */
+//--------------------------------------------------------------------------------------------------
+static Line_t* GetLine
+(
+    gpioSysfs_GpioRef_t gpioRef    ///< [IN] GPIO object reference
+)
+{
+    if ((!gpioRef) || (gpioRef->pinNum == 0) || (gpioRef->linePtr == NULL))
+    {
+        LE_ERROR("gpioRef is NULL or object not initialized");
+        return NULL;
+    }
+
+    return gpioRef->linePtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the kernel information of a line.
+ *
+ * @return
+ * - LE_OK on success
+ * - LE_IO_ERROR if the ioctl failed
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t GetLineInfo
+(
+    uint32_t offset,                ///< [IN] Line offset in the chip
+    struct gpioline_info* infoPtr   ///< [OUT] Line information
+)
+{
+    memset(infoPtr, 0, sizeof(*infoPtr));
+    infoPtr->line_offset = offset;
+
+    if (ioctl(ChipFd, GPIO_GET_LINEINFO_IOCTL, infoPtr) < 0)
+    {
+        LE_ERROR("Unable to get information of line %u. %m", offset);
+        return LE_IO_ERROR;
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the direction flag of a line, querying the kernel if the line has been left as-is.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t GetDirectionFlag
+(
+    Line_t* linePtr     ///< [IN] Line state
+)
+{
+    struct gpioline_info info;
+
+    if (linePtr->flags & DIRECTION_FLAGS)
+    {
+        return (linePtr->flags & DIRECTION_FLAGS);
+    }
+
+    if ((LE_OK == GetLineInfo(linePtr->offset, &info)) && (info.flags & GPIOLINE_FLAG_IS_OUT))
+    {
+        return GPIOHANDLE_REQUEST_OUTPUT;
+    }
+
+    return GPIOHANDLE_REQUEST_INPUT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release a multi-line handle. The lines go back to being requested one at a time on next use.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReleaseGroup
+(
+    LineGroup_t* groupPtr       ///< [IN] Multi-line handle
+)
+{
+    uint32_t i;
+
+    LE_DEBUG("Releasing handle of %u lines", groupPtr->numLines);
+
+    for (i = 0; i < groupPtr->numLines; i++)
+    {
+        Line_t* linePtr = groupPtr->gpioRefs[i]->linePtr;
+
+        linePtr->groupPtr = NULL;
+        linePtr->fd = -1;
+        linePtr->value = groupPtr->data.values[i];
+    }
+
+    LE_WARN_IF(close(groupPtr->fd) == -1, "Failed to close multi-line handle: %m");
+    le_mem_Release(groupPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release the kernel line handle or line event of a GPIO, stopping its fd monitor if any.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CloseLine
+(
+    gpioSysfs_GpioRef_t gpioRef     ///< [IN] GPIO object reference
+)
+{
+    Line_t* linePtr = gpioRef->linePtr;
+
+    if (gpioRef->fdMonitor != NULL)
+    {
+        LE_DEBUG("Stopping fd monitor");
+        le_fdMonitor_Delete(gpioRef->fdMonitor);
+        gpioRef->fdMonitor = NULL;
+    }
+
+    if (linePtr->groupPtr != NULL)
+    {
+        ReleaseGroup(linePtr->groupPtr);
+    }
+    else if (linePtr->fd >= 0)
+    {
+        LE_WARN_IF(close(linePtr->fd) == -1,
+                   "Failed to close line handle for gpio %d: %m", gpioRef->pinNum);
+        linePtr->fd = -1;
+    }
+
+    linePtr->isEvent = false;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Request the line of a GPIO from the kernel if it is not already held.
+ *
+ * When a change callback is registered on an input, a line event is requested and monitored so
+ * that edges are reported. Otherwise a line handle is requested with the current flags.
+ *
+ * @return
+ * - LE_OK on success
+ * - LE_IO_ERROR if the kernel refused the request
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t OpenLine
+(
+    gpioSysfs_GpioRef_t gpioRef     ///< [IN] GPIO object reference
+)
+{
+    Line_t* linePtr = gpioRef->linePtr;
+
+    if ((linePtr->groupPtr != NULL) || (linePtr->fd >= 0))
+    {
+        return LE_OK;
+    }
+
+    if ((gpioRef->handlerPtr != NULL) &&
+        (linePtr->edge != SYSFS_EDGE_SENSE_NONE) &&
+        !(linePtr->flags & GPIOHANDLE_REQUEST_OUTPUT))
+    {
+        struct gpioevent_request eventReq;
+
+        memset(&eventReq, 0, sizeof(eventReq));
+        eventReq.lineoffset = linePtr->offset;
+        eventReq.handleflags = GPIOHANDLE_REQUEST_INPUT |
+                               (linePtr->flags & (GPIOHANDLE_REQUEST_ACTIVE_LOW | BIAS_FLAGS));
+        switch (linePtr->edge)
+        {
+            case SYSFS_EDGE_SENSE_RISING:
+                eventReq.eventflags = GPIOEVENT_REQUEST_RISING_EDGE;
+                break;
+            case SYSFS_EDGE_SENSE_FALLING:
+                eventReq.eventflags = GPIOEVENT_REQUEST_FALLING_EDGE;
+                break;
+            default:
+                eventReq.eventflags = GPIOEVENT_REQUEST_BOTH_EDGES;
+                break;
+        }
+        le_utf8_Copy(eventReq.consumer_label, CONSUMER_LABEL, sizeof(eventReq.consumer_label), NULL);
+
+        if (ioctl(ChipFd, GPIO_GET_LINEEVENT_IOCTL, &eventReq) < 0)
+        {
+            LE_ERROR("Unable to request events of GPIO %s. %m", gpioRef->gpioName);
+            return LE_IO_ERROR;
+        }
+
+        // Events are drained until EAGAIN by the monitor handler
+        fcntl(eventReq.fd, F_SETFL, fcntl(eventReq.fd, F_GETFL) | O_NONBLOCK);
+
+        linePtr->fd = eventReq.fd;
+        linePtr->isEvent = true;
+
+        LE_DEBUG("Setting up file monitor for fd %d and pin %s", eventReq.fd, gpioRef->gpioName);
+        gpioRef->fdMonitor = le_fdMonitor_Create(gpioRef->gpioName, eventReq.fd,
+                                                 linePtr->fdMonFunc, POLLIN);
+        return LE_OK;
+    }
+
+    struct gpiohandle_request handleReq;
+
+    memset(&handleReq, 0, sizeof(handleReq));
+    handleReq.lineoffsets[0] = linePtr->offset;
+    handleReq.lines = 1;
+    handleReq.flags = linePtr->flags;
+    handleReq.default_values[0] = linePtr->value;
+    le_utf8_Copy(handleReq.consumer_label, CONSUMER_LABEL, sizeof(handleReq.consumer_label), NULL);
+
+    if (ioctl(ChipFd, GPIO_GET_LINEHANDLE_IOCTL, &handleReq) < 0)
+    {
+        LE_ERROR("Unable to request line of GPIO %s (flags 0x%x). %m",
+                 gpioRef->gpioName, linePtr->flags);
+        return LE_IO_ERROR;
+    }
+
+    linePtr->fd = handleReq.fd;
+    LE_DEBUG("Requested line %u for GPIO %s, flags 0x%x",
+             linePtr->offset, gpioRef->gpioName, linePtr->flags);
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Change the request flags of a line. The line is released and requested again with the new
+ * flags, unless they are unchanged and the line is already held.
+ *
+ * @return
+ * - LE_OK on success
+ * - LE_IO_ERROR if the kernel refused the request
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t Reconfigure
+(
+    gpioSysfs_GpioRef_t gpioRef,    ///< [IN] GPIO object reference
+    uint32_t flags                  ///< [IN] New GPIOHANDLE_REQUEST_* flags
+)
+{
+    Line_t* linePtr = gpioRef->linePtr;
+
+    if ((flags == linePtr->flags) && (linePtr->fd >= 0) && (linePtr->groupPtr == NULL))
+    {
+        return LE_OK;
+    }
+
+    CloseLine(gpioRef);
+    linePtr->flags = flags;
+
+    return OpenLine(gpioRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write the logical value of a line.
+ *
+ * @return
+ * - LE_OK on success
+ * - LE_IO_ERROR if the line could not be requested or written
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t WriteLineValue
+(
+    gpioSysfs_GpioRef_t gpioRef,    ///< [IN] GPIO object reference
+    gpioSysfs_Value_t level         ///< [IN] High or low
+)
+{
+    Line_t* linePtr = gpioRef->linePtr;
+    struct gpiohandle_data data;
+    int fd;
+
+    linePtr->value = (level != SYSFS_VALUE_LOW);
+
+    if (linePtr->groupPtr != NULL)
+    {
+        // All the lines of the handle are driven together, the others keep their last value
+        LineGroup_t* groupPtr = linePtr->groupPtr;
+
+        groupPtr->data.values[linePtr->groupIndex] = linePtr->value;
+        fd = groupPtr->fd;
+        data = groupPtr->data;
+    }
+    else
+    {
+        if (LE_OK != OpenLine(gpioRef))
+        {
+            return LE_IO_ERROR;
+        }
+
+        fd = linePtr->fd;
+        data.values[0] = linePtr->value;
+    }
+
+    if (ioctl(fd, GPIOHANDLE_SET_LINE_VALUES_IOCTL, &data) < 0)
+    {
+        LE_ERROR("Unable to set value of GPIO %s. %m", gpioRef->gpioName);
+        return LE_IO_ERROR;
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the logical value of a line.
+ *
+ * @return
+ * - LE_OK on success
+ * - LE_IO_ERROR if the line could not be requested or read
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReadLineValue
+(
+    gpioSysfs_GpioRef_t gpioRef,    ///< [IN] GPIO object reference
+    gpioSysfs_Value_t* levelPtr     ///< [OUT] High or low
+)
+{
+    Line_t* linePtr = gpioRef->linePtr;
+    struct gpiohandle_data data;
+    uint32_t index = 0;
+    int fd;
+
+    if (linePtr->groupPtr != NULL)
+    {
+        fd = linePtr->groupPtr->fd;
+        index = linePtr->groupIndex;
+    }
+    else
+    {
+        if (LE_OK != OpenLine(gpioRef))
+        {
+            return LE_IO_ERROR;
+        }
+        fd = linePtr->fd;
+    }
+
+    // Values can also be read through a line event file descriptor
+    if (ioctl(fd, GPIOHANDLE_GET_LINE_VALUES_IOCTL, &data) < 0)
+    {
+        LE_ERROR("Unable to read value of GPIO %s. %m", gpioRef->gpioName);
+        return LE_IO_ERROR;
+    }
+
+    *levelPtr = data.values[index] ? SYSFS_VALUE_HIGH : SYSFS_VALUE_LOW;
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get a multi-line handle holding exactly the given GPIOs, in order. An existing handle is reused;
+ * otherwise the lines are released and requested again together.
+ *
+ * Lines can only share a handle if they are requested with the same flags and are not monitored
+ * for edges.
+ *
+ * @return The multi-line handle, or NULL if the lines must be accessed one at a time.
+ */
+//--------------------------------------------------------------------------------------------------
+static LineGroup_t* GetLineGroup
+(
+    const gpioSysfs_GpioRef_t* gpioRefs,   ///< [IN] GPIO object references
+    size_t count                           ///< [IN] Number of GPIOs
+)
+{
+    LineGroup_t* groupPtr = gpioRefs[0]->linePtr->groupPtr;
+    uint32_t flags = gpioRefs[0]->linePtr->flags;
+    struct gpiohandle_request handleReq;
+    size_t i, j;
+
+    if ((groupPtr != NULL) && (groupPtr->numLines == count))
+    {
+        for (i = 0; i < count; i++)
+        {
+            if (groupPtr->gpioRefs[i] != gpioRefs[i])
+            {
+                break;
+            }
+        }
+
+        if (i == count)
+        {
+            return groupPtr;
+        }
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        if ((gpioRefs[i]->linePtr->flags != flags) || (gpioRefs[i]->handlerPtr != NULL))
+        {
+            return NULL;
+        }
+
+        // The kernel refuses to hold the same line twice in a handle
+        for (j = 0; j < i; j++)
+        {
+            if (gpioRefs[j] == gpioRefs[i])
+            {
+                return NULL;
+            }
+        }
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        CloseLine(gpioRefs[i]);
+    }
+
+    memset(&handleReq, 0, sizeof(handleReq));
+    for (i = 0; i < count; i++)
+    {
+        handleReq.lineoffsets[i] = gpioRefs[i]->linePtr->offset;
+        handleReq.default_values[i] = gpioRefs[i]->linePtr->value;
+    }
+    handleReq.lines = count;
+    handleReq.flags = flags;
+    le_utf8_Copy(handleReq.consumer_label, CONSUMER_LABEL, sizeof(handleReq.consumer_label), NULL);
+
+    if (ioctl(ChipFd, GPIO_GET_LINEHANDLE_IOCTL, &handleReq) < 0)
+    {
+        LE_WARN("Unable to request %zu lines together, accessing them one at a time. %m", count);
+        return NULL;
+    }
+
+    groupPtr = le_mem_ForceAlloc(LineGroupPool);
+    memset(groupPtr, 0, sizeof(*groupPtr));
+    groupPtr->fd = handleReq.fd;
+    groupPtr->numLines = count;
+
+    for (i = 0; i < count; i++)
+    {
+        Line_t* linePtr = gpioRefs[i]->linePtr;
+
+        groupPtr->gpioRefs[i] = gpioRefs[i];
+        groupPtr->data.values[i] = linePtr->value;
+        linePtr->groupPtr = groupPtr;
+        linePtr->groupIndex = i;
+    }
+
+    LE_DEBUG("Requested %zu lines together, flags 0x%x", count, flags);
+
+    return groupPtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check the references passed to a multi-line access.
+ *
+ * @return
+ * - LE_OK if the references are valid
+ * - LE_BAD_PARAMETER otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t CheckGpioRefs
+(
+    const gpioSysfs_GpioRef_t* gpioRefs,   ///< [IN] GPIO object references
+    size_t count                           ///< [IN] Number of GPIOs
+)
+{
+    size_t i;
+
+    if ((count == 0) || (count > GPIOHANDLES_MAX))
+    {
+        LE_ERROR("Invalid number of GPIOs: %zu", count);
+        return LE_BAD_PARAMETER;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        if (GetLine(gpioRefs[i]) == NULL)
+        {
+            return LE_BAD_PARAMETER;
+        }
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that a file descriptor is still the monitored event file descriptor of a GPIO.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsEventFd
+(
+    gpioSysfs_GpioRef_t gpioRef,    ///< [IN] GPIO module object reference
+    int fd                          ///< [IN] File descriptor
+)
+{
+    return (gpioRef->fdMonitor != NULL) && (gpioRef->linePtr != NULL) &&
+           gpioRef->linePtr->isEvent && (gpioRef->linePtr->fd == fd);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove the change callback for the given GPIO
+ */
+//--------------------------------------------------------------------------------------------------
+static void RemoveChangeCallback
+(
+    gpioSysfs_GpioRef_t gpioRef  ///< GPIO to remove the change callback from
+)
+{
+    LE_DEBUG("Removing callback references");
+    gpioRef->callbackContextPtr = NULL;
+    gpioRef->handlerPtr = NULL;
+
+    // Swap the line event for a plain line handle, which will be requested on next use
+    if (gpioRef->linePtr->isEvent)
+    {
+        CloseLine(gpioRef);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * setup GPIO pullup or pulldown disable/enable.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioSysfs_SetPullUpDown
+(
+    gpioSysfs_GpioRef_t gpioRef,       ///< [IN] GPIO object reference
+    gpioSysfs_PullUpDownType_t pud     ///< [IN] pull up, pull down type
+)
+{
+#ifdef GPIOHANDLE_REQUEST_BIAS_PULL_UP
+    Line_t* linePtr = GetLine(gpioRef);
+    uint32_t bias;
+
+    if (linePtr == NULL)
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    switch (pud)
+    {
+        case SYSFS_PULLUPDOWN_TYPE_UP:
+            bias = GPIOHANDLE_REQUEST_BIAS_PULL_UP;
+            break;
+        case SYSFS_PULLUPDOWN_TYPE_DOWN:
+            bias = GPIOHANDLE_REQUEST_BIAS_PULL_DOWN;
+            break;
+        default:
+            bias = GPIOHANDLE_REQUEST_BIAS_DISABLE;
+            break;
+    }
+
+    // The kernel only accepts bias flags along with a direction
+    return Reconfigure(gpioRef, (linePtr->flags & ~BIAS_FLAGS) | GetDirectionFlag(linePtr) | bias);
+#else
+    LE_WARN("Pull up/down not supported by the kernel GPIO character device headers");
+    return LE_NOT_IMPLEMENTED;
+#endif
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set up PushPull Output.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioSysfs_SetPushPullOutput
+(
+    gpioSysfs_GpioRef_t gpioRef,
+    gpioSysfs_ActiveType_t polarity,
+    bool value
+)
+{
+    Line_t* linePtr = GetLine(gpioRef);
+
+    if (linePtr == NULL)
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    uint32_t flags = GPIOHANDLE_REQUEST_OUTPUT | (linePtr->flags & BIAS_FLAGS) |
+                     ((polarity == SYSFS_ACTIVE_TYPE_LOW) ? GPIOHANDLE_REQUEST_ACTIVE_LOW : 0);
+
+    if (flags == linePtr->flags)
+    {
+        return WriteLineValue(gpioRef, value ? SYSFS_VALUE_HIGH : SYSFS_VALUE_LOW);
+    }
+
+    // The initial value is driven as soon as the line is requested
+    linePtr->value = value;
+    return Reconfigure(gpioRef, flags);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * setup GPIO OpenDrain.
+ *
+ * Enables open drain operation for each output-configured IO.
+ *
+ * Output pins can be driven in two different modes:
+ * - Regular push-pull operation: A transistor connects to high, and a transistor connects to low
+ *   (only one is operated at a time)
+ * - Open drain operation:  A transistor connects to low and nothing else
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioSysfs_SetOpenDrain
+(
+    gpioSysfs_GpioRef_t gpioRef,          ///< [IN] GPIO object reference
+    gpioSysfs_ActiveType_t polarity,      ///< [IN] Active-high or active-low
+    bool value                            ///< [IN] Initial value to drive
+)
+{
+    Line_t* linePtr = GetLine(gpioRef);
+
+    if (linePtr == NULL)
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    uint32_t flags = GPIOHANDLE_REQUEST_OUTPUT | GPIOHANDLE_REQUEST_OPEN_DRAIN |
+                     (linePtr->flags & BIAS_FLAGS) |
+                     ((polarity == SYSFS_ACTIVE_TYPE_LOW) ? GPIOHANDLE_REQUEST_ACTIVE_LOW : 0);
+
+    if (flags == linePtr->flags)
+    {
+        return WriteLineValue(gpioRef, value ? SYSFS_VALUE_HIGH : SYSFS_VALUE_LOW);
+    }
+
+    linePtr->value = value;
+    return Reconfigure(gpioRef, flags);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Configure the pin as a tri-state output pin.
+ *
+ * @note The initial state will be high-impedance.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioSysfs_SetTriState
+(
+    gpioSysfs_GpioRef_t gpioRef,       ///< [IN] GPIO module object reference
+    gpioSysfs_ActiveType_t polarity    ///< [IN] Active-high or active-low
+)
+{
+    LE_WARN("Tri-State API not implemented in chardev GPIO");
+    return LE_NOT_IMPLEMENTED;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Configure the pin as an input pin.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioSysfs_SetInput
+(
+    gpioSysfs_GpioRef_t gpioRef,         ///< [IN] GPIO module object reference
+    gpioSysfs_ActiveType_t polarity      ///< [IN] Active-high or active-low.
+)
+{
+    Line_t* linePtr = GetLine(gpioRef);
+
+    if (linePtr == NULL)
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    return Reconfigure(gpioRef, GPIOHANDLE_REQUEST_INPUT | (linePtr->flags & BIAS_FLAGS) |
+                       ((polarity == SYSFS_ACTIVE_TYPE_LOW) ? GPIOHANDLE_REQUEST_ACTIVE_LOW : 0));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set output pin to high impedance state.
+ *
+ * @warning Only valid for open-drain output pins. The line is released by driving it high.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioSysfs_SetHighZ
+(
+    gpioSysfs_GpioRef_t gpioRef         ///< [IN] GPIO module object reference
+)
+{
+    Line_t* linePtr = GetLine(gpioRef);
+
+    if (linePtr == NULL)
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    if (!(linePtr->flags & GPIOHANDLE_REQUEST_OPEN_DRAIN))
+    {
+        LE_WARN("SetHighZ only implemented for open drain outputs in chardev GPIO");
+        return LE_NOT_IMPLEMENTED;
+    }
+
+    // The physical level is the inverse of the logical value on active-low lines
+    return WriteLineValue(gpioRef, (linePtr->flags & GPIOHANDLE_REQUEST_ACTIVE_LOW) ?
+                                   SYSFS_VALUE_LOW : SYSFS_VALUE_HIGH);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * setup GPIO polarity.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioSysfs_SetPolarity
+(
+    gpioSysfs_GpioRef_t gpioRef,            ///< [IN] GPIO object reference
+    gpioSysfs_ActiveType_t level            ///< [IN] Active-high or active-low
+)
+{
+    Line_t* linePtr = GetLine(gpioRef);
+
+    if (linePtr == NULL)
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    return Reconfigure(gpioRef, (linePtr->flags & ~GPIOHANDLE_REQUEST_ACTIVE_LOW) |
+                       ((level == SYSFS_ACTIVE_TYPE_LOW) ? GPIOHANDLE_REQUEST_ACTIVE_LOW : 0));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set a change callback on a particular pin
+ *
+ * @return This will return a reference
+ */
+//--------------------------------------------------------------------------------------------------
+void* gpioSysfs_SetChangeCallback
+(
+    gpioSysfs_GpioRef_t gpioRef,                  ///< [IN] GPIO object reference
+    le_fdMonitor_HandlerFunc_t fdMonFunc,         ///< [IN] The fd monitor function
+    gpioSysfs_EdgeSensivityMode_t edge,           ///< [IN] Edge detection mode.
+    gpioSysfs_ChangeCallbackFunc_t handlerPtr,    ///< [IN]
+    void* contextPtr,                             ///< [IN]
+    int32_t sampleMs                              ///< [IN] If not interrupt capable, sample this often.
+)
+{
+    Line_t* linePtr = GetLine(gpioRef);
+
+    if (linePtr == NULL)
+    {
+        LE_KILL_CLIENT("gpioRef is NULL or object not initialized");
+        return NULL;
+    }
+
+    // Only one handler is allowed here
+    if (gpioRef->handlerPtr != NULL)
+    {
+        LE_KILL_CLIENT("Only one change handler can be registered");
+        return NULL;
+    }
+
+    // Store the callback function and context pointer
+    gpioRef->handlerPtr = handlerPtr;
+    gpioRef->callbackContextPtr = contextPtr;
+    linePtr->fdMonFunc = fdMonFunc;
+    linePtr->edge = edge;
+
+    if (linePtr->flags & GPIOHANDLE_REQUEST_OUTPUT)
+    {
+        LE_ERROR("Edge detection is not available on output GPIO %s", gpioRef->gpioName);
+        return gpioRef;
+    }
+
+    // Swap the line handle for a line event
+    CloseLine(gpioRef);
+    if (LE_OK != OpenLine(gpioRef))
+    {
+        LE_KILL_CLIENT("Unable to set edge detection correctly");
+        return NULL;
+    }
+
+    return gpioRef;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove a change callback on a particular pin
+ *
+ * @return Returns nothing.
+ */
+//--------------------------------------------------------------------------------------------------
+void gpioSysfs_RemoveChangeCallback
+(
+    gpioSysfs_GpioRef_t gpioRef,       ///< [IN] GPIO object reference
+    void * addHandlerRef               ///< [IN] The reference from when the handler was added
+)
+{
+    if ((addHandlerRef != gpioRef) || (GetLine(gpioRef) == NULL))
+    {
+        LE_KILL_CLIENT("Invalid GPIO reference provided");
+    }
+    else
+    {
+        RemoveChangeCallback(gpioRef);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Turn off edge detection. This function does not require a handler to be
+ * registered as it disables interrupts.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioSysfs_DisableEdgeSense
+(
+    gpioSysfs_GpioRef_t gpioRef         ///< [IN] GPIO object reference
+)
+{
+    Line_t* linePtr = GetLine(gpioRef);
+
+    if (linePtr == NULL)
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    linePtr->edge = SYSFS_EDGE_SENSE_NONE;
+
+    if (linePtr->isEvent)
+    {
+        CloseLine(gpioRef);
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * read value from GPIO input mode.
+ *
+ * @return
+ *      An active type, the status of pin: HIGH or LOW
+ */
+//--------------------------------------------------------------------------------------------------
+gpioSysfs_Value_t gpioSysfs_ReadValue
+(
+    gpioSysfs_GpioRef_t gpioRef            ///< [IN] GPIO object reference
+)
+{
+    gpioSysfs_Value_t value;
+
+    if (GetLine(gpioRef) == NULL)
+    {
+        LE_KILL_CLIENT("gpioRef is NULL or object not initialized");
+        return -1;
+    }
+
+    if (LE_OK != ReadLineValue(gpioRef, &value))
+    {
+        return -1;
+    }
+
+    LE_DEBUG("Value:%s", (value == SYSFS_VALUE_HIGH) ? "high" : "low");
+
+    return value;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the values of several GPIOs, with a single ioctl if they can share a line handle.
+ *
+ * @return
+ * - LE_OK on success
+ * - LE_BAD_PARAMETER if a reference is invalid or too many pins are given
+ * - LE_IO_ERROR if a value could not be read
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioSysfs_ReadValues
+(
+    const gpioSysfs_GpioRef_t* gpioRefs,   ///< [IN] GPIO object references
+    size_t count,                          ///< [IN] Number of GPIOs
+    gpioSysfs_Value_t* valuesPtr           ///< [OUT] Value of each GPIO
+)
+{
+    LineGroup_t* groupPtr;
+    size_t i;
+
+    if (LE_OK != CheckGpioRefs(gpioRefs, count))
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    groupPtr = GetLineGroup(gpioRefs, count);
+    if (groupPtr != NULL)
+    {
+        struct gpiohandle_data data;
+
+        if (ioctl(groupPtr->fd, GPIOHANDLE_GET_LINE_VALUES_IOCTL, &data) < 0)
+        {
+            LE_ERROR("Unable to read value of %zu GPIOs. %m", count);
+            return LE_IO_ERROR;
+        }
+
+        for (i = 0; i < count; i++)
+        {
+            valuesPtr[i] = data.values[i] ? SYSFS_VALUE_HIGH : SYSFS_VALUE_LOW;
+        }
+        return LE_OK;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        if (LE_OK != ReadLineValue(gpioRefs[i], &valuesPtr[i]))
+        {
+            return LE_IO_ERROR;
+        }
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write the values of several output GPIOs, with a single ioctl if they can share a line handle.
+ *
+ * @return
+ * - LE_OK on success
+ * - LE_BAD_PARAMETER if a reference is invalid or too many pins are given
+ * - LE_IO_ERROR if a value could not be written
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioSysfs_WriteValues
+(
+    const gpioSysfs_GpioRef_t* gpioRefs,   ///< [IN] GPIO object references
+    size_t count,                          ///< [IN] Number of GPIOs
+    const gpioSysfs_Value_t* valuesPtr     ///< [IN] Value to drive on each GPIO
+)
+{
+    LineGroup_t* groupPtr;
+    size_t i;
+
+    if (LE_OK != CheckGpioRefs(gpioRefs, count))
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    groupPtr = GetLineGroup(gpioRefs, count);
+    if (groupPtr != NULL)
+    {
+        for (i = 0; i < count; i++)
+        {
+            groupPtr->data.values[i] = (valuesPtr[i] != SYSFS_VALUE_LOW);
+            gpioRefs[i]->linePtr->value = groupPtr->data.values[i];
+        }
+
+        if (ioctl(groupPtr->fd, GPIOHANDLE_SET_LINE_VALUES_IOCTL, &groupPtr->data) < 0)
+        {
+            LE_ERROR("Unable to set value of %zu GPIOs. %m", count);
+            return LE_IO_ERROR;
+        }
+        return LE_OK;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        if (LE_OK != WriteLineValue(gpioRefs[i], valuesPtr[i]))
+        {
+            return LE_IO_ERROR;
+        }
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the kernel timestamp of the last edge reported to the change callback.
+ *
+ * @return
+ * - LE_OK on success
+ * - LE_BAD_PARAMETER if the reference is invalid
+ * - LE_NOT_FOUND if no edge has been reported yet
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioSysfs_GetEventTimestamp
+(
+    gpioSysfs_GpioRef_t gpioRef,       ///< [IN] GPIO module object reference
+    uint64_t* timestampNsPtr           ///< [OUT] Kernel timestamp of the edge (ns)
+)
+{
+    Line_t* linePtr = GetLine(gpioRef);
+
+    if (linePtr == NULL)
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    if (linePtr->eventTimestamp == 0)
+    {
+        return LE_NOT_FOUND;
+    }
+
+    *timestampNsPtr = linePtr->eventTimestamp;
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set an output pin to active state.
+ *
+ * @warning Only valid for output pins.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioSysfs_Activate
+(
+    gpioSysfs_GpioRef_t gpioRef
+)
+{
+    Line_t* linePtr = GetLine(gpioRef);
+
+    if (linePtr == NULL)
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    if (!(linePtr->flags & GPIOHANDLE_REQUEST_OUTPUT))
+    {
+        linePtr->value = 1;
+        if (LE_OK != Reconfigure(gpioRef, (linePtr->flags & ~DIRECTION_FLAGS) |
+                                          GPIOHANDLE_REQUEST_OUTPUT))
+        {
+            LE_ERROR("Failed to set Direction on GPIO %s", gpioRef->gpioName);
+            return LE_IO_ERROR;
+        }
+        return LE_OK;
+    }
+
+    if (LE_OK != WriteLineValue(gpioRef, SYSFS_VALUE_HIGH))
+    {
+        LE_ERROR("Failed to set GPIO %s to high", gpioRef->gpioName);
+        return LE_IO_ERROR;
+    }
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set output pin to inactive state.
+ *
+ * @warning Only valid for output pins.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioSysfs_Deactivate
+(
+    gpioSysfs_GpioRef_t gpioRef
+)
+{
+    Line_t* linePtr = GetLine(gpioRef);
+
+    if (linePtr == NULL)
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    if (!(linePtr->flags & GPIOHANDLE_REQUEST_OUTPUT))
+    {
+        linePtr->value = 0;
+        if (LE_OK != Reconfigure(gpioRef, (linePtr->flags & ~DIRECTION_FLAGS) |
+                                          GPIOHANDLE_REQUEST_OUTPUT))
+        {
+            LE_ERROR("Failed to set Direction on GPIO %s", gpioRef->gpioName);
+            return LE_IO_ERROR;
+        }
+        return LE_OK;
+    }
+
+    if (LE_OK != WriteLineValue(gpioRef, SYSFS_VALUE_LOW))
+    {
+        LE_ERROR("Failed to set GPIO %s to low", gpioRef->gpioName);
+        return LE_IO_ERROR;
+    }
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if the pin is currently active.
+ *
+ * @return true = active, false = inactive.
+ *
+ * @note this function can only be used on output pins
+ */
+//--------------------------------------------------------------------------------------------------
+bool gpioSysfs_IsActive
+(
+    gpioSysfs_GpioRef_t gpioRef         ///< [IN] GPIO object reference
+)
+{
+    if (gpioSysfs_IsInput(gpioRef))
+    {
+        LE_WARN("Attempt to check if an input is active");
+        return false;
+    }
+
+    return (gpioSysfs_ReadValue(gpioRef) == SYSFS_VALUE_HIGH);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if the pin is configured as an input.
+ *
+ * @return true = input, false = output.
+ */
+//--------------------------------------------------------------------------------------------------
+bool gpioSysfs_IsInput
+(
+    gpioSysfs_GpioRef_t gpioRef         ///< [IN] GPIO object reference
+)
+{
+    Line_t* linePtr = GetLine(gpioRef);
+
+    if (linePtr == NULL)
+    {
+        LE_KILL_CLIENT("gpioRef is NULL or object not initialized");
+        return false;
+    }
+
+    return (GetDirectionFlag(linePtr) == GPIOHANDLE_REQUEST_INPUT);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if the pin is configured as an output.
+ *
+ * @return true = output, false = input.
+ */
+//--------------------------------------------------------------------------------------------------
+bool gpioSysfs_IsOutput
+(
+    gpioSysfs_GpioRef_t gpioRef         ///< [IN] GPIO object reference
+)
+{
+    return (!gpioSysfs_IsInput(gpioRef));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the current value of pull up and down resistors.
+ *
+ * @return The current configured value
+ */
+//--------------------------------------------------------------------------------------------------
+gpioSysfs_PullUpDownType_t gpioSysfs_GetPullUpDown
+(
+    gpioSysfs_GpioRef_t gpioRef         ///< [IN] GPIO object reference
+)
+{
+    Line_t* linePtr = GetLine(gpioRef);
+    struct gpioline_info info;
+
+    if (linePtr == NULL)
+    {
+        LE_KILL_CLIENT("gpioRef is NULL or object not initialized");
+        return -1;
+    }
+
+    if (LE_OK != GetLineInfo(linePtr->offset, &info))
+    {
+        return -1;
+    }
+
+#ifdef GPIOLINE_FLAG_BIAS_PULL_UP
+    if (info.flags & GPIOLINE_FLAG_BIAS_PULL_DOWN)
+    {
+        LE_DEBUG("Detected pull up/down as down");
+        return SYSFS_PULLUPDOWN_TYPE_DOWN;
+    }
+    if (info.flags & GPIOLINE_FLAG_BIAS_PULL_UP)
+    {
+        LE_DEBUG("Detected pull up/down as up");
+        return SYSFS_PULLUPDOWN_TYPE_UP;
+    }
+#endif
+
+    return SYSFS_PULLUPDOWN_TYPE_OFF;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the current value the pin polarity.
+ *
+ * @return The current configured value
+ */
+//--------------------------------------------------------------------------------------------------
+gpioSysfs_ActiveType_t gpioSysfs_GetPolarity
+(
+    gpioSysfs_GpioRef_t gpioRef         ///< [IN] GPIO object reference
+)
+{
+    Line_t* linePtr = GetLine(gpioRef);
+    struct gpioline_info info;
+
+    if (linePtr == NULL)
+    {
+        LE_KILL_CLIENT("gpioRef is NULL or object not initialized");
+        return -1;
+    }
+
+    if (LE_OK != GetLineInfo(linePtr->offset, &info))
+    {
+        return -1;
+    }
+
+    return (info.flags & GPIOLINE_FLAG_ACTIVE_LOW) ? SYSFS_ACTIVE_TYPE_LOW : SYSFS_ACTIVE_TYPE_HIGH;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the current value of edge sensing.
+ *
+ * @return The current configured value
+ *
+ * @note it is invalid to read the edge sense of an output
+ */
+//--------------------------------------------------------------------------------------------------
+gpioSysfs_EdgeSensivityMode_t gpioSysfs_GetEdgeSense
+(
+    gpioSysfs_GpioRef_t gpioRef         ///< [IN] GPIO object reference
+)
+{
+    Line_t* linePtr = GetLine(gpioRef);
+
+    if (linePtr == NULL)
+    {
+        LE_KILL_CLIENT("gpioRef is NULL or object not initialized");
+        return -1;
+    }
+
+    if (gpioSysfs_IsOutput(gpioRef))
+    {
+        LE_WARN("Attempt to read edge sense on an output");
+        return SYSFS_EDGE_SENSE_NONE;
+    }
+
+    return linePtr->edge;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the edge sense value. In order to call this there must be a callback registered for
+ * interrupts. Otherwise this would just generate interrupts without them being handled.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioSysfs_SetEdgeSense
+(
+    gpioSysfs_GpioRef_t gpioRef,              ///< [IN] GPIO object reference
+    gpioSysfs_EdgeSensivityMode_t edge        ///< [IN] The mode of GPIO Edge Sensivity.
+)
+{
+    Line_t* linePtr = GetLine(gpioRef);
+
+    if (linePtr == NULL)
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    if (gpioRef->handlerPtr == NULL)
+    {
+        LE_ERROR("Attempt to change edge sense value without a registered handler");
+        return LE_FAULT;
+    }
+
+    if (edge == linePtr->edge)
+    {
+        return LE_OK;
+    }
+
+    // The line event must be requested again with the new edge flags
+    linePtr->edge = edge;
+    CloseLine(gpioRef);
+
+    return OpenLine(gpioRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function will be called when there are edge events to read from the line event file
+ * descriptor of a GPIO. The change callback is called once per edge.
+ */
+//--------------------------------------------------------------------------------------------------
+void gpioSysfs_InputMonitorHandlerFunc
+(
+    const gpioSysfs_GpioRef_t gpioRef,
+    int fd,
+    short events
+)
+{
+    struct gpioevent_data eventData[EVENT_READ_COUNT];
+    ssize_t len;
+    size_t i;
+
+    LE_DEBUG("Input handler called for %s", gpioRef->gpioName);
+
+    // Make sure the pin is in use and this isn't a spurious interrupt
+    if ((!gpioRef->inUse) || (gpioRef->linePtr == NULL))
+    {
+        LE_WARN("Spurious interrupt handled - ignoring");
+        return;
+    }
+
+    if (events & (POLLERR | POLLHUP))
+    {
+        LE_ERROR("Error on event file descriptor of GPIO %s (events 0x%x)",
+                 gpioRef->gpioName, events);
+    }
+
+    // Older kernels return a single event per read, so keep reading until the queue is empty.
+    // Stop as soon as the callback led to the line being released or requested again, as fd is
+    // then closed or no longer the event file descriptor of this line.
+    while (IsEventFd(gpioRef, fd))
+    {
+        len = read(fd, eventData, sizeof(eventData));
+        if (len < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            LE_ERROR_IF(errno != EAGAIN, "Unable to read events of GPIO %s. %m",
+                        gpioRef->gpioName);
+            return;
+        }
+        if (len == 0)
+        {
+            return;
+        }
+
+        for (i = 0; i < (len / sizeof(eventData[0])); i++)
+        {
+            gpioSysfs_ChangeCallbackFunc_t handlerPtr = gpioRef->handlerPtr;
+
+            gpioRef->linePtr->eventTimestamp = eventData[i].timestamp;
+            LE_DEBUG("Edge %s on %s at %" PRIu64 " ns",
+                     (eventData[i].id == GPIOEVENT_EVENT_RISING_EDGE) ? "rising" : "falling",
+                     gpioRef->gpioName, (uint64_t)eventData[i].timestamp);
+
+            if (handlerPtr != NULL)
+            {
+                handlerPtr(eventData[i].id == GPIOEVENT_EVENT_RISING_EDGE,
+                           gpioRef->callbackContextPtr);
+
+                if (!IsEventFd(gpioRef, fd))
+                {
+                    return;
+                }
+            }
+            else
+            {
+                LE_WARN("No callback registered for pin %s", gpioRef->gpioName);
+            }
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function will be called when the client-server session opens. This allows the relationship
+ * between the session and the GPIO object reference to be created.
+ */
+//--------------------------------------------------------------------------------------------------
+void gpioSysfs_SessionOpenHandlerFunc
+(
+    le_msg_SessionRef_t  sessionRef,  ///<[IN] Client session reference.
+    void*                contextPtr   ///<[IN] Client context pointer.
+)
+{
+    gpioSysfs_GpioRef_t gpioRef = (gpioSysfs_GpioRef_t)contextPtr;
+
+    if (NULL == gpioRef)
+    {
+        LE_KILL_CLIENT("Unable to match context to pin");
+        return;
+    }
+
+    // Make sure the GPIO is not already in use
+    if (gpioRef->inUse)
+    {
+        uid_t user = 0;
+        pid_t pid = 0;
+        le_msg_GetClientUserCreds(sessionRef, &user, &pid);
+
+        LE_WARN("Attempt to use a GPIO that is already in use by uid %d with pid %d",
+                user,
+                pid
+                );
+
+        le_msg_CloseSession(sessionRef);
+        return;
+    }
+
+    if (!OpenChip())
+    {
+        LE_WARN("GPIO chip unavailable for GPIO %s - stopping session", gpioRef->gpioName);
+        le_msg_CloseSession(sessionRef);
+        return;
+    }
+
+    // The line itself is only requested from the kernel on first use
+    if (gpioRef->linePtr == NULL)
+    {
+        gpioRef->linePtr = le_mem_ForceAlloc(LinePool);
+        memset(gpioRef->linePtr, 0, sizeof(Line_t));
+        gpioRef->linePtr->offset = gpioRef->pinNum - FirstPin;
+        gpioRef->linePtr->fd = -1;
+        gpioRef->linePtr->edge = SYSFS_EDGE_SENSE_NONE;
+    }
+
+    // Mark the PIN as in use
+    LE_INFO("Assigning GPIO %d", gpioRef->pinNum);
+    gpioRef->inUse = true;
+
+    // Store the current, valid session ref
+    gpioRef->currentSession = sessionRef;
+
+    LE_DEBUG("gpio pin:%d, GPIO Name:%s, line offset:%u",
+             gpioRef->pinNum, gpioRef->gpioName, gpioRef->linePtr->offset);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function will be called when the client-server session closes. The line is released so that
+ * it can be used by another consumer.
+ */
+//--------------------------------------------------------------------------------------------------
+void gpioSysfs_SessionCloseHandlerFunc
+(
+    le_msg_SessionRef_t  sessionRef,  ///<[IN] Client session reference.
+    void*                contextPtr   ///<[IN] Client context pointer.
+)
+{
+    gpioSysfs_GpioRef_t gpioRef = (gpioSysfs_GpioRef_t)contextPtr;
+
+    if (gpioRef == NULL)
+    {
+        LE_WARN("Unable to look up GPIO PIN for closing session");
+        return;
+    }
+
+    // Make sure this is the valid session. If we have rejected a connection
+    // then no clean up should be done as this will mess up the real session
+    if (gpioRef->currentSession != sessionRef)
+    {
+        LE_DEBUG("No clean up required. This is a rejected session");
+        return;
+    }
+
+    // Mark the pin as not in use
+    LE_INFO("Releasing GPIO %d", gpioRef->pinNum);
+    gpioRef->inUse = false;
+
+    gpioRef->callbackContextPtr = NULL;
+    gpioRef->handlerPtr = NULL;
+
+    if (gpioRef->linePtr != NULL)
+    {
+        CloseLine(gpioRef);
+        gpioRef->linePtr->flags = 0;
+        gpioRef->linePtr->edge = SYSFS_EDGE_SENSE_NONE;
+        gpioRef->linePtr->eventTimestamp = 0;
+    }
+
+    gpioRef->currentSession = NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Determine if a GPIO pin is available for use. The pin must map to a line of the GPIO chip which
+ * is not already used by the kernel or by another consumer.
+ */
+//--------------------------------------------------------------------------------------------------
+bool gpioSysfs_IsPinAvailable
+(
+    int pinNum         ///< [IN] GPIO pin number (starting at 1)
+)
+{
+    struct gpioline_info info;
+
+    if ((pinNum < MIN_PIN_NUMBER) || (pinNum > MAX_PIN_NUMBER))
+    {
+        LE_WARN("Pin number %d is out of range", pinNum);
+        return false;
+    }
+
+    if (!OpenChip())
+    {
+        return false;
+    }
+
+    if ((pinNum < FirstPin) || ((uint32_t)(pinNum - FirstPin) >= ChipNumLines))
+    {
+        LE_DEBUG("Pin %d is not a line of the GPIO chip", pinNum);
+        return false;
+    }
+
+    if (LE_OK != GetLineInfo(pinNum - FirstPin, &info))
+    {
+        return false;
+    }
+
+    LE_DEBUG("Line %d flags 0x%x, consumer '%s'", pinNum - FirstPin, info.flags, info.consumer);
+
+    return !(info.flags & GPIOLINE_FLAG_KERNEL);
+}
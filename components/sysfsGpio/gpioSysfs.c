@@ -29,6 +29,9 @@
 //--------------------------------------------------------------------------------------------------
 #define MS_WDOG_INTERVAL 8
 
+static le_result_t ReadPins(le_msg_SessionRef_t sessionRef, uint64_t pinMask, uint64_t* valuesPtr);
+static le_result_t WritePins(le_msg_SessionRef_t sessionRef, uint64_t pinMask, uint64_t values);
+
 static struct gpioSysfs_Gpio SysfsGpioPin1 = {1,"gpio1",false,NULL,NULL,NULL,NULL};
 static gpioSysfs_GpioRef_t gpioRefPin1 = &SysfsGpioPin1;
 
@@ -150,6 +153,21 @@ le_result_t le_gpioPin1_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin1);
 }
 
+le_result_t le_gpioPin1_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin1_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin1_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin1_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin1_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin1, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin1 boilerplate functions.
@@ -284,6 +302,21 @@ le_result_t le_gpioPin2_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin2);
 }
 
+le_result_t le_gpioPin2_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin2_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin2_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin2_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin2_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin2, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin2 boilerplate functions.
@@ -418,6 +451,21 @@ le_result_t le_gpioPin3_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin3);
 }
 
+le_result_t le_gpioPin3_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin3_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin3_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin3_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin3_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin3, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin3 boilerplate functions.
@@ -552,6 +600,21 @@ le_result_t le_gpioPin4_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin4);
 }
 
+le_result_t le_gpioPin4_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin4_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin4_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin4_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin4_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin4, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin4 boilerplate functions.
@@ -686,6 +749,21 @@ le_result_t le_gpioPin5_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin5);
 }
 
+le_result_t le_gpioPin5_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin5_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin5_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin5_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin5_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin5, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin5 boilerplate functions.
@@ -820,6 +898,21 @@ le_result_t le_gpioPin6_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin6);
 }
 
+le_result_t le_gpioPin6_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin6_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin6_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin6_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin6_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin6, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin6 boilerplate functions.
@@ -954,6 +1047,21 @@ le_result_t le_gpioPin7_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin7);
 }
 
+le_result_t le_gpioPin7_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin7_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin7_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin7_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin7_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin7, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin7 boilerplate functions.
@@ -1088,6 +1196,21 @@ le_result_t le_gpioPin8_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin8);
 }
 
+le_result_t le_gpioPin8_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin8_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin8_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin8_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin8_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin8, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin8 boilerplate functions.
@@ -1222,6 +1345,21 @@ le_result_t le_gpioPin9_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin9);
 }
 
+le_result_t le_gpioPin9_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin9_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin9_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin9_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin9_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin9, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin9 boilerplate functions.
@@ -1356,6 +1494,21 @@ le_result_t le_gpioPin10_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin10);
 }
 
+le_result_t le_gpioPin10_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin10_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin10_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin10_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin10_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin10, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin10 boilerplate functions.
@@ -1490,6 +1643,21 @@ le_result_t le_gpioPin11_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin11);
 }
 
+le_result_t le_gpioPin11_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin11_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin11_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin11_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin11_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin11, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin11 boilerplate functions.
@@ -1624,6 +1792,21 @@ le_result_t le_gpioPin12_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin12);
 }
 
+le_result_t le_gpioPin12_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin12_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin12_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin12_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin12_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin12, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin12 boilerplate functions.
@@ -1758,6 +1941,21 @@ le_result_t le_gpioPin13_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin13);
 }
 
+le_result_t le_gpioPin13_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin13_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin13_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin13_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin13_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin13, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin13 boilerplate functions.
@@ -1892,6 +2090,21 @@ le_result_t le_gpioPin14_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin14);
 }
 
+le_result_t le_gpioPin14_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin14_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin14_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin14_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin14_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin14, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin14 boilerplate functions.
@@ -2026,6 +2239,21 @@ le_result_t le_gpioPin15_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin15);
 }
 
+le_result_t le_gpioPin15_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin15_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin15_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin15_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin15_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin15, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin15 boilerplate functions.
@@ -2160,6 +2388,21 @@ le_result_t le_gpioPin16_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin16);
 }
 
+le_result_t le_gpioPin16_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin16_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin16_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin16_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin16_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin16, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin16 boilerplate functions.
@@ -2294,6 +2537,21 @@ le_result_t le_gpioPin17_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin17);
 }
 
+le_result_t le_gpioPin17_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin17_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin17_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin17_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin17_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin17, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin17 boilerplate functions.
@@ -2428,6 +2686,21 @@ le_result_t le_gpioPin18_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin18);
 }
 
+le_result_t le_gpioPin18_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin18_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin18_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin18_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin18_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin18, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin18 boilerplate functions.
@@ -2562,6 +2835,21 @@ le_result_t le_gpioPin19_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin19);
 }
 
+le_result_t le_gpioPin19_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin19_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin19_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin19_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin19_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin19, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin19 boilerplate functions.
@@ -2696,6 +2984,21 @@ le_result_t le_gpioPin20_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin20);
 }
 
+le_result_t le_gpioPin20_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin20_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin20_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin20_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin20_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin20, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin20 boilerplate functions.
@@ -2830,6 +3133,21 @@ le_result_t le_gpioPin21_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin21);
 }
 
+le_result_t le_gpioPin21_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin21_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin21_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin21_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin21_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin21, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin21 boilerplate functions.
@@ -2964,6 +3282,21 @@ le_result_t le_gpioPin22_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin22);
 }
 
+le_result_t le_gpioPin22_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin22_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin22_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin22_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin22_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin22, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin22 boilerplate functions.
@@ -3098,6 +3431,21 @@ le_result_t le_gpioPin23_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin23);
 }
 
+le_result_t le_gpioPin23_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin23_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin23_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin23_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin23_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin23, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin23 boilerplate functions.
@@ -3232,6 +3580,21 @@ le_result_t le_gpioPin24_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin24);
 }
 
+le_result_t le_gpioPin24_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin24_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin24_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin24_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin24_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin24, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin24 boilerplate functions.
@@ -3366,6 +3729,21 @@ le_result_t le_gpioPin25_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin25);
 }
 
+le_result_t le_gpioPin25_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin25_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin25_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin25_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin25_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin25, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin25 boilerplate functions.
@@ -3500,6 +3878,21 @@ le_result_t le_gpioPin26_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin26);
 }
 
+le_result_t le_gpioPin26_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin26_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin26_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin26_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin26_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin26, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin26 boilerplate functions.
@@ -3634,6 +4027,21 @@ le_result_t le_gpioPin27_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin27);
 }
 
+le_result_t le_gpioPin27_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin27_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin27_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin27_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin27_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin27, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin27 boilerplate functions.
@@ -3768,6 +4176,21 @@ le_result_t le_gpioPin28_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin28);
 }
 
+le_result_t le_gpioPin28_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin28_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin28_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin28_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin28_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin28, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin28 boilerplate functions.
@@ -3902,9 +4325,24 @@ le_result_t le_gpioPin29_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin29);
 }
 
-//--------------------------------------------------------------------------------------------------
-/**
- * End of Pin29 boilerplate functions.
+le_result_t le_gpioPin29_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin29_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin29_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin29_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin29_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin29, timestampNsPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * End of Pin29 boilerplate functions.
  */
 //--------------------------------------------------------------------------------------------------
 
@@ -4036,6 +4474,21 @@ le_result_t le_gpioPin30_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin30);
 }
 
+le_result_t le_gpioPin30_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin30_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin30_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin30_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin30_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin30, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin30 boilerplate functions.
@@ -4170,6 +4623,21 @@ le_result_t le_gpioPin31_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin31);
 }
 
+le_result_t le_gpioPin31_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin31_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin31_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin31_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin31_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin31, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin31 boilerplate functions.
@@ -4304,6 +4772,21 @@ le_result_t le_gpioPin32_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin32);
 }
 
+le_result_t le_gpioPin32_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin32_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin32_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin32_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin32_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin32, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin32 boilerplate functions.
@@ -4438,6 +4921,21 @@ le_result_t le_gpioPin33_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin33);
 }
 
+le_result_t le_gpioPin33_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin33_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin33_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin33_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin33_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin33, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin33 boilerplate functions.
@@ -4572,6 +5070,21 @@ le_result_t le_gpioPin34_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin34);
 }
 
+le_result_t le_gpioPin34_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin34_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin34_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin34_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin34_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin34, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin34 boilerplate functions.
@@ -4706,6 +5219,21 @@ le_result_t le_gpioPin35_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin35);
 }
 
+le_result_t le_gpioPin35_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin35_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin35_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin35_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin35_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin35, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin35 boilerplate functions.
@@ -4840,6 +5368,21 @@ le_result_t le_gpioPin36_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin36);
 }
 
+le_result_t le_gpioPin36_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin36_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin36_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin36_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin36_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin36, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin36 boilerplate functions.
@@ -4974,6 +5517,21 @@ le_result_t le_gpioPin37_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin37);
 }
 
+le_result_t le_gpioPin37_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin37_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin37_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin37_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin37_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin37, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin37 boilerplate functions.
@@ -5108,6 +5666,21 @@ le_result_t le_gpioPin38_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin38);
 }
 
+le_result_t le_gpioPin38_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin38_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin38_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin38_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin38_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin38, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin38 boilerplate functions.
@@ -5242,6 +5815,21 @@ le_result_t le_gpioPin39_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin39);
 }
 
+le_result_t le_gpioPin39_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin39_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin39_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin39_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin39_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin39, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin39 boilerplate functions.
@@ -5376,6 +5964,21 @@ le_result_t le_gpioPin40_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin40);
 }
 
+le_result_t le_gpioPin40_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin40_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin40_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin40_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin40_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin40, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin40 boilerplate functions.
@@ -5510,6 +6113,21 @@ le_result_t le_gpioPin41_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin41);
 }
 
+le_result_t le_gpioPin41_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin41_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin41_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin41_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin41_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin41, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin41 boilerplate functions.
@@ -5644,6 +6262,21 @@ le_result_t le_gpioPin42_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin42);
 }
 
+le_result_t le_gpioPin42_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin42_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin42_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin42_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin42_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin42, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin42 boilerplate functions.
@@ -5778,6 +6411,21 @@ le_result_t le_gpioPin43_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin43);
 }
 
+le_result_t le_gpioPin43_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin43_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin43_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin43_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin43_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin43, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin43 boilerplate functions.
@@ -5912,6 +6560,21 @@ le_result_t le_gpioPin44_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin44);
 }
 
+le_result_t le_gpioPin44_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin44_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin44_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin44_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin44_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin44, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin44 boilerplate functions.
@@ -6046,6 +6709,21 @@ le_result_t le_gpioPin45_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin45);
 }
 
+le_result_t le_gpioPin45_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin45_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin45_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin45_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin45_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin45, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin45 boilerplate functions.
@@ -6180,6 +6858,21 @@ le_result_t le_gpioPin46_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin46);
 }
 
+le_result_t le_gpioPin46_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin46_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin46_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin46_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin46_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin46, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin46 boilerplate functions.
@@ -6314,6 +7007,21 @@ le_result_t le_gpioPin47_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin47);
 }
 
+le_result_t le_gpioPin47_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin47_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin47_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin47_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin47_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin47, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin47 boilerplate functions.
@@ -6448,6 +7156,21 @@ le_result_t le_gpioPin48_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin48);
 }
 
+le_result_t le_gpioPin48_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin48_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin48_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin48_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin48_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin48, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin48 boilerplate functions.
@@ -6582,6 +7305,21 @@ le_result_t le_gpioPin49_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin49);
 }
 
+le_result_t le_gpioPin49_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin49_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin49_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin49_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin49_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin49, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin49 boilerplate functions.
@@ -6716,6 +7454,21 @@ le_result_t le_gpioPin50_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin50);
 }
 
+le_result_t le_gpioPin50_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin50_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin50_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin50_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin50_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin50, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin50 boilerplate functions.
@@ -6850,6 +7603,21 @@ le_result_t le_gpioPin51_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin51);
 }
 
+le_result_t le_gpioPin51_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin51_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin51_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin51_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin51_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin51, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin51 boilerplate functions.
@@ -6984,6 +7752,21 @@ le_result_t le_gpioPin52_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin52);
 }
 
+le_result_t le_gpioPin52_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin52_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin52_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin52_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin52_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin52, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin52 boilerplate functions.
@@ -7118,6 +7901,21 @@ le_result_t le_gpioPin53_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin53);
 }
 
+le_result_t le_gpioPin53_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin53_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin53_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin53_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin53_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin53, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin53 boilerplate functions.
@@ -7252,6 +8050,21 @@ le_result_t le_gpioPin54_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin54);
 }
 
+le_result_t le_gpioPin54_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin54_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin54_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin54_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin54_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin54, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin54 boilerplate functions.
@@ -7386,6 +8199,21 @@ le_result_t le_gpioPin55_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin55);
 }
 
+le_result_t le_gpioPin55_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin55_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin55_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin55_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin55_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin55, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin55 boilerplate functions.
@@ -7520,6 +8348,21 @@ le_result_t le_gpioPin56_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin56);
 }
 
+le_result_t le_gpioPin56_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin56_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin56_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin56_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin56_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin56, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin56 boilerplate functions.
@@ -7654,6 +8497,21 @@ le_result_t le_gpioPin57_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin57);
 }
 
+le_result_t le_gpioPin57_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin57_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin57_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin57_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin57_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin57, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin57 boilerplate functions.
@@ -7788,6 +8646,21 @@ le_result_t le_gpioPin58_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin58);
 }
 
+le_result_t le_gpioPin58_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin58_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin58_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin58_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin58_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin58, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin58 boilerplate functions.
@@ -7922,6 +8795,21 @@ le_result_t le_gpioPin59_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin59);
 }
 
+le_result_t le_gpioPin59_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin59_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin59_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin59_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin59_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin59, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin59 boilerplate functions.
@@ -8056,6 +8944,21 @@ le_result_t le_gpioPin60_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin60);
 }
 
+le_result_t le_gpioPin60_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin60_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin60_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin60_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin60_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin60, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin60 boilerplate functions.
@@ -8190,6 +9093,21 @@ le_result_t le_gpioPin61_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin61);
 }
 
+le_result_t le_gpioPin61_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin61_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin61_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin61_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin61_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin61, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin61 boilerplate functions.
@@ -8324,6 +9242,21 @@ le_result_t le_gpioPin62_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin62);
 }
 
+le_result_t le_gpioPin62_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin62_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin62_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin62_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin62_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin62, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin62 boilerplate functions.
@@ -8458,6 +9391,21 @@ le_result_t le_gpioPin63_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin63);
 }
 
+le_result_t le_gpioPin63_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin63_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin63_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin63_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin63_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin63, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin63 boilerplate functions.
@@ -8592,6 +9540,21 @@ le_result_t le_gpioPin64_DisableEdgeSense (void)
     return gpioSysfs_DisableEdgeSense(gpioRefPin64);
 }
 
+le_result_t le_gpioPin64_ReadPins (uint64_t pinMask, uint64_t* valuesPtr)
+{
+    return ReadPins(le_gpioPin64_GetClientSessionRef(), pinMask, valuesPtr);
+}
+
+le_result_t le_gpioPin64_WritePins (uint64_t pinMask, uint64_t values)
+{
+    return WritePins(le_gpioPin64_GetClientSessionRef(), pinMask, values);
+}
+
+le_result_t le_gpioPin64_GetEventTimestamp (uint64_t* timestampNsPtr)
+{
+    return gpioSysfs_GetEventTimestamp(gpioRefPin64, timestampNsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * End of Pin64 boilerplate functions.
@@ -8599,6 +9562,199 @@ le_result_t le_gpioPin64_DisableEdgeSense (void)
 //--------------------------------------------------------------------------------------------------
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * GPIO of each pin, pin n at index (n - 1).
+ */
+//--------------------------------------------------------------------------------------------------
+static const gpioSysfs_GpioRef_t PinRefs[] =
+{
+    &SysfsGpioPin1,
+    &SysfsGpioPin2,
+    &SysfsGpioPin3,
+    &SysfsGpioPin4,
+    &SysfsGpioPin5,
+    &SysfsGpioPin6,
+    &SysfsGpioPin7,
+    &SysfsGpioPin8,
+    &SysfsGpioPin9,
+    &SysfsGpioPin10,
+    &SysfsGpioPin11,
+    &SysfsGpioPin12,
+    &SysfsGpioPin13,
+    &SysfsGpioPin14,
+    &SysfsGpioPin15,
+    &SysfsGpioPin16,
+    &SysfsGpioPin17,
+    &SysfsGpioPin18,
+    &SysfsGpioPin19,
+    &SysfsGpioPin20,
+    &SysfsGpioPin21,
+    &SysfsGpioPin22,
+    &SysfsGpioPin23,
+    &SysfsGpioPin24,
+    &SysfsGpioPin25,
+    &SysfsGpioPin26,
+    &SysfsGpioPin27,
+    &SysfsGpioPin28,
+    &SysfsGpioPin29,
+    &SysfsGpioPin30,
+    &SysfsGpioPin31,
+    &SysfsGpioPin32,
+    &SysfsGpioPin33,
+    &SysfsGpioPin34,
+    &SysfsGpioPin35,
+    &SysfsGpioPin36,
+    &SysfsGpioPin37,
+    &SysfsGpioPin38,
+    &SysfsGpioPin39,
+    &SysfsGpioPin40,
+    &SysfsGpioPin41,
+    &SysfsGpioPin42,
+    &SysfsGpioPin43,
+    &SysfsGpioPin44,
+    &SysfsGpioPin45,
+    &SysfsGpioPin46,
+    &SysfsGpioPin47,
+    &SysfsGpioPin48,
+    &SysfsGpioPin49,
+    &SysfsGpioPin50,
+    &SysfsGpioPin51,
+    &SysfsGpioPin52,
+    &SysfsGpioPin53,
+    &SysfsGpioPin54,
+    &SysfsGpioPin55,
+    &SysfsGpioPin56,
+    &SysfsGpioPin57,
+    &SysfsGpioPin58,
+    &SysfsGpioPin59,
+    &SysfsGpioPin60,
+    &SysfsGpioPin61,
+    &SysfsGpioPin62,
+    &SysfsGpioPin63,
+    &SysfsGpioPin64,
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the GPIOs of the pins in a mask, in pin order. Each pin is only served to the client
+ * connected to its own service, so the pins must all be held by the process owning the session.
+ *
+ * @return
+ * - LE_OK on success
+ * - LE_BAD_PARAMETER if the mask is empty or a pin is not held by the client
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t GetPinRefs
+(
+    le_msg_SessionRef_t sessionRef,         ///< [IN] Session of the calling client
+    uint64_t pinMask,                       ///< [IN] Pins, bit (n - 1) standing for pin n
+    gpioSysfs_GpioRef_t* gpioRefs,          ///< [OUT] GPIO of each pin
+    size_t* countPtr                        ///< [OUT] Number of pins
+)
+{
+    pid_t clientPid;
+    size_t count = 0;
+    size_t i;
+
+    if ((pinMask == 0) || (LE_OK != le_msg_GetClientProcessId(sessionRef, &clientPid)))
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(PinRefs); i++)
+    {
+        if (pinMask & (1ULL << i))
+        {
+            gpioSysfs_GpioRef_t gpioRef = PinRefs[i];
+            pid_t pinPid;
+
+            if ((gpioRef->currentSession == NULL) ||
+                (LE_OK != le_msg_GetClientProcessId(gpioRef->currentSession, &pinPid)) ||
+                (pinPid != clientPid))
+            {
+                LE_ERROR("GPIO %s is not held by client pid %d", gpioRef->gpioName, clientPid);
+                return LE_BAD_PARAMETER;
+            }
+
+            gpioRefs[count++] = gpioRef;
+        }
+    }
+
+    *countPtr = count;
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the values of the pins in a mask for a client.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReadPins
+(
+    le_msg_SessionRef_t sessionRef,         ///< [IN] Session of the calling client
+    uint64_t pinMask,                       ///< [IN] Pins, bit (n - 1) standing for pin n
+    uint64_t* valuesPtr                     ///< [OUT] Value of each pin, same bit layout
+)
+{
+    gpioSysfs_GpioRef_t gpioRefs[NUM_ARRAY_MEMBERS(PinRefs)];
+    gpioSysfs_Value_t values[NUM_ARRAY_MEMBERS(PinRefs)];
+    size_t count;
+    size_t i;
+    le_result_t result = GetPinRefs(sessionRef, pinMask, gpioRefs, &count);
+
+    if (LE_OK == result)
+    {
+        result = gpioSysfs_ReadValues(gpioRefs, count, values);
+    }
+
+    if (LE_OK == result)
+    {
+        *valuesPtr = 0;
+        for (i = 0; i < count; i++)
+        {
+            if (values[i] != SYSFS_VALUE_LOW)
+            {
+                *valuesPtr |= 1ULL << (gpioRefs[i]->pinNum - 1);
+            }
+        }
+    }
+
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the values of the pins in a mask for a client.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t WritePins
+(
+    le_msg_SessionRef_t sessionRef,         ///< [IN] Session of the calling client
+    uint64_t pinMask,                       ///< [IN] Pins, bit (n - 1) standing for pin n
+    uint64_t values                         ///< [IN] Value of each pin, same bit layout
+)
+{
+    gpioSysfs_GpioRef_t gpioRefs[NUM_ARRAY_MEMBERS(PinRefs)];
+    gpioSysfs_Value_t pinValues[NUM_ARRAY_MEMBERS(PinRefs)];
+    size_t count;
+    size_t i;
+    le_result_t result = GetPinRefs(sessionRef, pinMask, gpioRefs, &count);
+
+    if (LE_OK != result)
+    {
+        return result;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        pinValues[i] = (values & (1ULL << (gpioRefs[i]->pinNum - 1))) ?
+                       SYSFS_VALUE_HIGH : SYSFS_VALUE_LOW;
+    }
+
+    return gpioSysfs_WriteValues(gpioRefs, count, pinValues);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * The place where the component starts up.  All initialization happens here.
@@ -224,6 +224,62 @@ gpioSysfs_Value_t gpioSysfs_ReadValue
     gpioSysfs_GpioRef_t gpioRef    ///< [IN] GPIO module object reference
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the values of several GPIOs at once.
+ *
+ * The character device backend reads all the pins with a single ioctl when they have been
+ * configured identically. The sysfs backend reads them one at a time.
+ *
+ * @return
+ * - LE_OK on success
+ * - LE_BAD_PARAMETER if a reference is invalid or too many pins are given
+ * - LE_IO_ERROR if a value could not be read
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioSysfs_ReadValues
+(
+    const gpioSysfs_GpioRef_t* gpioRefs,   ///< [IN] GPIO object references
+    size_t count,                          ///< [IN] Number of GPIOs
+    gpioSysfs_Value_t* valuesPtr           ///< [OUT] Value of each GPIO
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write the values of several output GPIOs at once.
+ *
+ * The character device backend drives all the pins with a single ioctl when they have been
+ * configured identically. The sysfs backend writes them one at a time.
+ *
+ * @return
+ * - LE_OK on success
+ * - LE_BAD_PARAMETER if a reference is invalid or too many pins are given
+ * - LE_IO_ERROR if a value could not be written
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioSysfs_WriteValues
+(
+    const gpioSysfs_GpioRef_t* gpioRefs,   ///< [IN] GPIO object references
+    size_t count,                          ///< [IN] Number of GPIOs
+    const gpioSysfs_Value_t* valuesPtr     ///< [IN] Value to drive on each GPIO
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the kernel timestamp of the last edge reported to the change callback.
+ *
+ * @return
+ * - LE_OK on success
+ * - LE_NOT_FOUND if no edge has been reported yet
+ * - LE_NOT_IMPLEMENTED if the backend does not timestamp edges (sysfs)
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioSysfs_GetEventTimestamp
+(
+    gpioSysfs_GpioRef_t gpioRef,       ///< [IN] GPIO module object reference
+    uint64_t* timestampNsPtr           ///< [OUT] Kernel timestamp of the edge (ns)
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Configure the pin as an input pin.
@@ -448,6 +504,7 @@ struct gpioSysfs_Gpio {
     void *callbackContextPtr;                     ///< Client context to be passed back
     le_fdMonitor_Ref_t fdMonitor;                 ///< fdMonitor Object associated to this GPIO
     le_msg_SessionRef_t currentSession;           ///< Current valid IPC session for this pin
+    struct gpioSysfs_Line* linePtr;               ///< Line handle state (chardev backend only)
 };
 
 
@@ -734,6 +734,98 @@ gpioSysfs_Value_t gpioSysfs_ReadValue
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the values of several GPIOs. The sysfs has no multi-pin access so each value file is read
+ * in turn.
+ *
+ * @return
+ * - LE_OK on success
+ * - LE_BAD_PARAMETER if a reference is invalid
+ * - LE_IO_ERROR if a value could not be read
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioSysfs_ReadValues
+(
+    const gpioSysfs_GpioRef_t* gpioRefs,   ///< [IN] GPIO object references
+    size_t count,                          ///< [IN] Number of GPIOs
+    gpioSysfs_Value_t* valuesPtr           ///< [OUT] Value of each GPIO
+)
+{
+    char path[64];
+    char result[17];
+    size_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        if ((!gpioRefs[i]) || (gpioRefs[i]->pinNum == 0))
+        {
+            LE_ERROR("gpioRef is NULL or object not initialized");
+            return LE_BAD_PARAMETER;
+        }
+
+        snprintf(path, sizeof(path), "%s/%s/%s", SYSFS_GPIO_PATH, gpioRefs[i]->gpioName, "value");
+        if (LE_OK != ReadSysGpioSignalAttr(path, sizeof(result), result))
+        {
+            return LE_IO_ERROR;
+        }
+
+        valuesPtr[i] = (atoi(result) != 0) ? SYSFS_VALUE_HIGH : SYSFS_VALUE_LOW;
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write the values of several output GPIOs. The sysfs has no multi-pin access so each value file
+ * is written in turn.
+ *
+ * @return
+ * - LE_OK on success
+ * - LE_BAD_PARAMETER if a reference is invalid
+ * - LE_IO_ERROR if a value could not be written
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioSysfs_WriteValues
+(
+    const gpioSysfs_GpioRef_t* gpioRefs,   ///< [IN] GPIO object references
+    size_t count,                          ///< [IN] Number of GPIOs
+    const gpioSysfs_Value_t* valuesPtr     ///< [IN] Value to drive on each GPIO
+)
+{
+    size_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        le_result_t res = WriteOutputValue(gpioRefs[i], valuesPtr[i]);
+        if (LE_OK != res)
+        {
+            return (LE_BAD_PARAMETER == res) ? res : LE_IO_ERROR;
+        }
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the kernel timestamp of the last edge. The sysfs only signals that the value file changed,
+ * so no timestamp is available.
+ *
+ * @return LE_NOT_IMPLEMENTED
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioSysfs_GetEventTimestamp
+(
+    gpioSysfs_GpioRef_t gpioRef,       ///< [IN] GPIO module object reference
+    uint64_t* timestampNsPtr           ///< [OUT] Kernel timestamp of the edge (ns)
+)
+{
+    LE_WARN("Edge timestamps not implemented in sysfs GPIO");
+    return LE_NOT_IMPLEMENTED;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Set an output pin to active state.
@@ -45,6 +45,98 @@ static ni_IteratorRef_t GetIteratorFromRef
 
 
 
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Get a write iterator pointer from an iterator reference.  The client is terminated if the
+ *  iterator isn't a write iterator.
+ */
+// -------------------------------------------------------------------------------------------------
+static ni_IteratorRef_t GetWriteIteratorFromRef
+(
+    le_cfg_IteratorRef_t externalRef  ///< [IN] Iterator reference to extract a pointer from.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    ni_IteratorRef_t iteratorRef = GetIteratorFromRef(externalRef);
+
+    if (   (iteratorRef != NULL)
+        && (ni_IsWriteable(iteratorRef) == false))
+    {
+        tu_TerminateConfigAdminClient(le_cfgAdmin_GetClientSessionRef(),
+                                      "This operation requires a write iterator.");
+
+        return NULL;
+    }
+
+    return iteratorRef;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Check that a file descriptor given for a bulk import or export refers to a regular file.  The
+ *  config tree serves all its clients from a single thread, so it can't be left blocked on a pipe
+ *  or a socket.
+ *
+ *  @return LE_OK if the descriptor can be used, LE_BAD_PARAMETER otherwise.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t CheckBulkFd
+(
+    int fd  ///< [IN] The descriptor to check.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    struct stat fileStat;
+
+    if (   (fd < 0)
+        || (fstat(fd, &fileStat) == -1)
+        || (S_ISREG(fileStat.st_mode) == false))
+    {
+        LE_ERROR("Bulk import/export descriptor is not a regular file.");
+        return LE_BAD_PARAMETER;
+    }
+
+    return LE_OK;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Check whether a node path is the same as, or is under, another node path.  Both paths must be
+ *  absolute paths as given by ni_GetPathForNode().
+ *
+ *  @return True if pathPtr is basePathPtr or one of its descendants.
+ */
+// -------------------------------------------------------------------------------------------------
+static bool IsSameOrChildPath
+(
+    const char* basePathPtr,  ///< [IN] The possible ancestor.
+    const char* pathPtr       ///< [IN] The path to check.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    size_t baseLen = strlen(basePathPtr);
+
+    // Ignore a trailing separator, so that the root path covers every other path.
+    if (   (baseLen > 0)
+        && (basePathPtr[baseLen - 1] == '/'))
+    {
+        baseLen--;
+    }
+
+    return    (strncmp(basePathPtr, pathPtr, baseLen) == 0)
+           && (   (pathPtr[baseLen] == 0)
+               || (pathPtr[baseLen] == '/'));
+}
+
+
+
+
 // -------------------------------------------------------------------------------------------------
 //  Import and export of the tree data.
 // -------------------------------------------------------------------------------------------------
@@ -221,6 +313,243 @@ void le_cfgAdmin_ExportTree
 
 
 
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Read a sub-tree from a file descriptor, in the given format.  The sub-tree then overwrites the
+ *  node at the given nodePath, as part of the iterator's write transaction.
+ *
+ *  \b Responds \b With:
+ *
+ *  Responds with one of the following values:
+ *
+ *          - LE_OK            - Import was completed successfully.
+ *          - LE_FAULT         - An I/O error occurred while reading the data.
+ *          - LE_FORMAT_ERROR  - Configuration data being imported appears corrupted.
+ *          - LE_BAD_PARAMETER - The descriptor doesn't refer to a regular file.
+ *          - LE_NOT_FOUND     - The node could not be created.
+ */
+// -------------------------------------------------------------------------------------------------
+void le_cfgAdmin_ImportTreeFd
+(
+    le_cfgAdmin_ServerCmdRef_t commandRef,  ///< [IN] Reference used to generate a reply for this
+                                            ///<      request.
+    le_cfg_IteratorRef_t externalRef,       ///< [IN] Write iterator that is being used for the
+                                            ///<      import.
+    int fd,                                 ///< [IN] Import the tree data from this descriptor.
+    le_cfgAdmin_Format_t format,            ///< [IN] Format of the data.
+    const char* nodePathPtr                 ///< [IN] Where in the tree should this import happen?
+                                            ///<      Leave as an empty string to use the iterator's
+                                            ///<      current node.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    LE_DEBUG("** Importing a tree in format %d onto node '%s', using iterator, '%p'.",
+             format, nodePathPtr, externalRef);
+
+    ni_IteratorRef_t iteratorRef = GetWriteIteratorFromRef(externalRef);
+    le_result_t result = CheckBulkFd(fd);
+
+    if (iteratorRef == NULL)
+    {
+        result = LE_OK;
+    }
+    else if (result == LE_OK)
+    {
+        tdb_NodeRef_t nodeRef = ni_TryCreateNode(iteratorRef, nodePathPtr);
+
+        if (nodeRef == NULL)
+        {
+            result = LE_NOT_FOUND;
+        }
+        else if (format == LE_CFGADMIN_FORMAT_JSON)
+        {
+            result = tdb_ReadTreeNodeJson(nodeRef, fd);
+        }
+        else if (format == LE_CFGADMIN_FORMAT_NATIVE)
+        {
+            result = tdb_ReadTreeNode(nodeRef, fd) ? LE_OK : LE_FORMAT_ERROR;
+        }
+        else
+        {
+            tu_TerminateConfigAdminClient(le_cfgAdmin_GetClientSessionRef(),
+                                          "Unknown import format.");
+            result = LE_BAD_PARAMETER;
+        }
+    }
+
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+
+    le_cfgAdmin_ImportTreeFdRespond(commandRef, result);
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Stream the node given by nodePath and its children to a file descriptor, in the given format.
+ *
+ *  \b Responds \b With:
+ *
+ *  Responds with one of the following values:
+ *
+ *          - LE_OK            - Export was completed successfully.
+ *          - LE_FAULT         - An I/O error occurred while writing the data.
+ *          - LE_BAD_PARAMETER - The descriptor doesn't refer to a regular file.
+ */
+// -------------------------------------------------------------------------------------------------
+void le_cfgAdmin_ExportTreeFd
+(
+    le_cfgAdmin_ServerCmdRef_t commandRef,  ///< [IN] Reference used to generate a reply for this
+                                            ///<      request.
+    le_cfg_IteratorRef_t externalRef,       ///< [IN] Iterator that is being used for the export.
+    int fd,                                 ///< [IN] Export the tree data to this descriptor.
+    le_cfgAdmin_Format_t format,            ///< [IN] Format of the data.
+    const char* nodePathPtr                 ///< [IN] Where in the tree should this export happen?
+                                            ///<      Leave as an empty string to use the iterator's
+                                            ///<      current node.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    LE_DEBUG("** Exporting a tree in format %d from node '%s', using iterator, '%p'.",
+             format, nodePathPtr, externalRef);
+
+    ni_IteratorRef_t iteratorRef = GetIteratorFromRef(externalRef);
+    le_result_t result = CheckBulkFd(fd);
+
+    if (iteratorRef == NULL)
+    {
+        result = LE_OK;
+    }
+    else if (result == LE_OK)
+    {
+        tdb_NodeRef_t nodeRef = ni_GetNode(iteratorRef, nodePathPtr);
+
+        if (format == LE_CFGADMIN_FORMAT_JSON)
+        {
+            result = tdb_WriteTreeNodeJson(nodeRef, fd);
+        }
+        else if (format == LE_CFGADMIN_FORMAT_NATIVE)
+        {
+            result = tdb_WriteTreeNode(nodeRef, fd);
+        }
+        else
+        {
+            tu_TerminateConfigAdminClient(le_cfgAdmin_GetClientSessionRef(),
+                                          "Unknown export format.");
+            result = LE_BAD_PARAMETER;
+        }
+
+        if (result == LE_IO_ERROR)
+        {
+            result = LE_FAULT;
+        }
+    }
+
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+
+    le_cfgAdmin_ExportTreeFdRespond(commandRef, result);
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Copy the node at srcPath and all of its children over the node at destPath, as part of the
+ *  iterator's write transaction.  If requested the source is then deleted, moving the sub-tree.
+ *
+ *  \b Responds \b With:
+ *
+ *  Responds with one of the following values:
+ *
+ *          - LE_OK            - Copy was completed successfully.
+ *          - LE_NOT_FOUND     - The source node doesn't exist or the destination could not be
+ *                               created.
+ *          - LE_BAD_PARAMETER - The source and destination overlap.
+ *          - LE_OVERFLOW      - A copied node's path would be too long.
+ */
+// -------------------------------------------------------------------------------------------------
+void le_cfgAdmin_CopyTree
+(
+    le_cfgAdmin_ServerCmdRef_t commandRef,  ///< [IN] Reference used to generate a reply for this
+                                            ///<      request.
+    le_cfg_IteratorRef_t externalRef,       ///< [IN] Write iterator that is being used for the
+                                            ///<      copy.
+    const char* srcPathPtr,                 ///< [IN] Node to copy.
+    const char* destPathPtr,                ///< [IN] Node to overwrite with the copy.
+    bool deleteSource                       ///< [IN] Delete the source node after the copy.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    LE_DEBUG("** %s node '%s' to '%s', using iterator, '%p'.",
+             deleteSource ? "Moving" : "Copying", srcPathPtr, destPathPtr, externalRef);
+
+    ni_IteratorRef_t iteratorRef = GetWriteIteratorFromRef(externalRef);
+
+    if (iteratorRef == NULL)
+    {
+        le_cfgAdmin_CopyTreeRespond(commandRef, LE_OK);
+        return;
+    }
+
+    // Copying a node into itself, or over one of its ancestors, would destroy the data being
+    // copied.  Check this on the paths, before the destination is created.
+    static char srcPath[LE_CFG_STR_LEN_BYTES] = "";
+    static char destPath[LE_CFG_STR_LEN_BYTES] = "";
+
+    if (   (ni_GetPathForNode(iteratorRef, srcPathPtr, srcPath, sizeof(srcPath)) != LE_OK)
+        || (ni_GetPathForNode(iteratorRef, destPathPtr, destPath, sizeof(destPath)) != LE_OK))
+    {
+        le_cfgAdmin_CopyTreeRespond(commandRef, LE_BAD_PARAMETER);
+        return;
+    }
+
+    if (   IsSameOrChildPath(srcPath, destPath)
+        || IsSameOrChildPath(destPath, srcPath))
+    {
+        LE_ERROR("Can not copy '%s' to '%s', the nodes overlap.", srcPath, destPath);
+        le_cfgAdmin_CopyTreeRespond(commandRef, LE_BAD_PARAMETER);
+        return;
+    }
+
+    tdb_NodeRef_t srcRef = ni_GetNode(iteratorRef, srcPathPtr);
+
+    if (   (srcRef == NULL)
+        || (tdb_GetNodeType(srcRef) == LE_CFG_TYPE_DOESNT_EXIST))
+    {
+        le_cfgAdmin_CopyTreeRespond(commandRef, LE_NOT_FOUND);
+        return;
+    }
+
+    tdb_NodeRef_t destRef = ni_TryCreateNode(iteratorRef, destPathPtr);
+
+    if (destRef == NULL)
+    {
+        le_cfgAdmin_CopyTreeRespond(commandRef, LE_NOT_FOUND);
+        return;
+    }
+
+    le_result_t result = tdb_CopyNode(destRef, srcRef);
+
+    if (   (result == LE_OK)
+        && (deleteSource))
+    {
+        ni_DeleteNode(iteratorRef, srcPathPtr);
+    }
+
+    le_cfgAdmin_CopyTreeRespond(commandRef, result);
+}
+
+
+
+
 // -------------------------------------------------------------------------------------------------
 //  Tree maintenance.
 // -------------------------------------------------------------------------------------------------
@@ -179,6 +179,93 @@ static size_t MaxStr
 
 
 
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Split a buffer of packed, NULL terminated, strings from a batch request into a list of string
+ *  pointers.
+ *
+ *  @return LE_OK if successful.
+ *          LE_FORMAT_ERROR if the last string isn't NULL terminated.
+ *          LE_OVERFLOW if there are more strings than the list can hold.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t SplitBatchBuffer
+(
+    const uint8_t* bufferPtr,  ///< [IN]  The packed strings.
+    size_t bufferSize,         ///< [IN]  Size of the packed strings, including the last NULL.
+    const char** entriesPtr,   ///< [OUT] List to fill with pointers to the strings.
+    size_t maxEntries,         ///< [IN]  Size of the list.
+    size_t* countPtr           ///< [OUT] Number of strings found.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    size_t offset = 0;
+
+    *countPtr = 0;
+
+    if (   (bufferSize > 0)
+        && (bufferPtr[bufferSize - 1] != '\0'))
+    {
+        return LE_FORMAT_ERROR;
+    }
+
+    while (offset < bufferSize)
+    {
+        if (*countPtr >= maxEntries)
+        {
+            return LE_OVERFLOW;
+        }
+
+        const char* entryPtr = (const char*)bufferPtr + offset;
+
+        entriesPtr[*countPtr] = entryPtr;
+        (*countPtr)++;
+
+        offset += strlen(entryPtr) + 1;
+    }
+
+    return LE_OK;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Check that a value from a batch write request can be written as the given type.
+ *
+ *  @return True if the value can be written, false if not.
+ */
+// -------------------------------------------------------------------------------------------------
+static bool IsBatchValueValid
+(
+    le_cfg_nodeType_t type,  ///< [IN] Type of the value to write.
+    double number            ///< [IN] Value for the numeric types.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    switch (type)
+    {
+        case LE_CFG_TYPE_EMPTY:
+        case LE_CFG_TYPE_STRING:
+        case LE_CFG_TYPE_BOOL:
+        case LE_CFG_TYPE_FLOAT:
+            return true;
+
+        case LE_CFG_TYPE_INT:
+            // Note that a NaN fails all of these comparisons.
+            return    (number >= INT32_MIN)
+                   && (number <= INT32_MAX)
+                   && (number == (double)(int32_t)number);
+
+        default:
+            return false;
+    }
+}
+
+
+
+
 // -------------------------------------------------------------------------------------------------
 /**
  *  Called by the "Quick" functions to get a reference to the tree the user wants.  If the tree
@@ -1197,6 +1284,221 @@ void le_cfg_SetBool
 
 
 
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Read the values of several nodes in one request.  The paths are packed one after the other,
+ *  each followed by a NULL, and the string values are packed the same way in the response.
+ *
+ *  Valid for both read and write transactions.
+ *
+ *  \b Responds \b With:
+ *
+ *  This function will respond with one of the following values:
+ *
+ *          - LE_OK           - The values were read successfully.
+ *          - LE_FORMAT_ERROR - The last path isn't NULL terminated.
+ *          - LE_OVERFLOW     - The paths or values don't fit in the client's buffers.
+ *
+ *  No values are returned if the request fails.
+ */
+// -------------------------------------------------------------------------------------------------
+void le_cfg_GetBatch
+(
+    le_cfg_ServerCmdRef_t commandRef,  ///< [IN] Reference used to generate a reply for this
+                                       ///<      request.
+    le_cfg_IteratorRef_t externalRef,  ///< [IN] Iterator to use as a basis for the transaction.
+    const uint8_t* pathsPtr,           ///< [IN] Packed paths of the nodes to read.
+    size_t pathsSize,                  ///< [IN] Size of the packed paths.
+    size_t typesSize,                  ///< [IN] Number of types the client can take.
+    size_t numbersSize,                ///< [IN] Number of numeric values the client can take.
+    size_t stringsSize                 ///< [IN] Size of the client's string values buffer.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    LE_DEBUG("** Reading a batch of values from the iterator's <%p> current node.", externalRef);
+
+    ni_IteratorRef_t iteratorRef = GetIteratorFromRef(externalRef);
+    const char* paths[LE_CFG_BATCH_MAX_NODES];
+    le_cfg_nodeType_t types[LE_CFG_BATCH_MAX_NODES];
+    double numbers[LE_CFG_BATCH_MAX_NODES];
+    char strings[LE_CFG_BATCH_BYTES];
+    size_t count = 0;
+    size_t stringsUsed = 0;
+
+    if (iteratorRef == NULL)
+    {
+        le_cfg_GetBatchRespond(commandRef, LE_FAULT, types, 0, numbers, 0, NULL, 0);
+        return;
+    }
+
+    // The generated server code already caps the client's buffer sizes to the sizes in the API.
+    size_t maxCount = (typesSize < numbersSize) ? typesSize : numbersSize;
+    size_t maxStrings = (stringsSize < sizeof(strings)) ? stringsSize : sizeof(strings);
+
+    le_result_t result = SplitBatchBuffer(pathsPtr, pathsSize, paths, maxCount, &count);
+
+    for (size_t i = 0; (result == LE_OK) && (i < count); i++)
+    {
+        if (CheckPathForSpecifier(paths[i]))
+        {
+            result = LE_FAULT;
+        }
+        else if (stringsUsed >= maxStrings)
+        {
+            result = LE_OVERFLOW;
+        }
+        else
+        {
+            char* stringPtr = strings + stringsUsed;
+
+            result = ni_GetNodeValues(iteratorRef,
+                                      paths[i],
+                                      &types[i],
+                                      &numbers[i],
+                                      stringPtr,
+                                      MaxStr(maxStrings - stringsUsed));
+
+            stringsUsed += strlen(stringPtr) + 1;
+        }
+    }
+
+    if (result != LE_OK)
+    {
+        count = 0;
+        stringsUsed = 0;
+    }
+
+    le_cfg_GetBatchRespond(commandRef,
+                           result,
+                           types,
+                           count,
+                           numbers,
+                           count,
+                           (const uint8_t*)strings,
+                           stringsUsed);
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Write the values of several nodes in one request.  Only valid during a write transaction.
+ *
+ *  The whole request is checked before any of the values are written.
+ *
+ *  \b Responds \b With:
+ *
+ *  This function will respond with one of the following values:
+ *
+ *          - LE_OK            - The values were written successfully.
+ *          - LE_FORMAT_ERROR  - The paths or string values don't match the list of types.
+ *          - LE_BAD_PARAMETER - A type can't be written, an int value isn't a 32-bit integer, or
+ *                               a path or a string value is longer than LE_CFG_STR_LEN.
+ *          - LE_FAULT         - A path tries to change trees.  The client is disconnected.
+ */
+// -------------------------------------------------------------------------------------------------
+void le_cfg_SetBatch
+(
+    le_cfg_ServerCmdRef_t commandRef,    ///< [IN] Reference used to generate a reply for this
+                                         ///<      request.
+    le_cfg_IteratorRef_t externalRef,    ///< [IN] Iterator to use as a basis for the transaction.
+    const uint8_t* pathsPtr,             ///< [IN] Packed paths of the nodes to write.
+    size_t pathsSize,                    ///< [IN] Size of the packed paths.
+    const le_cfg_nodeType_t* typesPtr,   ///< [IN] Type of the value to write to each node.
+    size_t typesSize,                    ///< [IN] Number of types.
+    const double* numbersPtr,            ///< [IN] Numeric value of each node.
+    size_t numbersSize,                  ///< [IN] Number of numeric values.
+    const uint8_t* stringsPtr,           ///< [IN] Packed string value of each node.
+    size_t stringsSize                   ///< [IN] Size of the packed string values.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    LE_DEBUG("** Writing a batch of %zu values from the iterator's <%p> current node.",
+             typesSize,
+             externalRef);
+
+    ni_IteratorRef_t iteratorRef = GetWriteIteratorFromRef(externalRef);
+    const char* paths[LE_CFG_BATCH_MAX_NODES];
+    const char* strings[LE_CFG_BATCH_MAX_NODES];
+    size_t pathCount = 0;
+    size_t stringCount = 0;
+    le_result_t result = LE_OK;
+
+    if (iteratorRef == NULL)
+    {
+        le_cfg_SetBatchRespond(commandRef, LE_FAULT);
+        return;
+    }
+
+    // Check the whole request first, so that a bad request doesn't leave a partial write behind.
+    if (   (SplitBatchBuffer(pathsPtr,
+                             pathsSize,
+                             paths,
+                             NUM_ARRAY_MEMBERS(paths),
+                             &pathCount) != LE_OK)
+        || (SplitBatchBuffer(stringsPtr,
+                             stringsSize,
+                             strings,
+                             NUM_ARRAY_MEMBERS(strings),
+                             &stringCount) != LE_OK)
+        || (pathCount != typesSize)
+        || (stringCount != typesSize)
+        || (numbersSize != typesSize))
+    {
+        result = LE_FORMAT_ERROR;
+    }
+
+    for (size_t i = 0; (result == LE_OK) && (i < pathCount); i++)
+    {
+        if (CheckPathForSpecifier(paths[i]))
+        {
+            result = LE_FAULT;
+        }
+        else if (   (IsBatchValueValid(typesPtr[i], numbersPtr[i]) == false)
+                 || (strnlen(paths[i], LE_CFG_STR_LEN_BYTES) > LE_CFG_STR_LEN)
+                 || (strnlen(strings[i], LE_CFG_STR_LEN_BYTES) > LE_CFG_STR_LEN))
+        {
+            result = LE_BAD_PARAMETER;
+        }
+    }
+
+    for (size_t i = 0; (result == LE_OK) && (i < pathCount); i++)
+    {
+        switch (typesPtr[i])
+        {
+            case LE_CFG_TYPE_EMPTY:
+                ni_SetEmpty(iteratorRef, paths[i]);
+                break;
+
+            case LE_CFG_TYPE_STRING:
+                ni_SetNodeValueString(iteratorRef, paths[i], strings[i]);
+                break;
+
+            case LE_CFG_TYPE_BOOL:
+                ni_SetNodeValueBool(iteratorRef, paths[i], numbersPtr[i] != 0);
+                break;
+
+            case LE_CFG_TYPE_INT:
+                ni_SetNodeValueInt(iteratorRef, paths[i], (int32_t)numbersPtr[i]);
+                break;
+
+            case LE_CFG_TYPE_FLOAT:
+                ni_SetNodeValueFloat(iteratorRef, paths[i], numbersPtr[i]);
+                break;
+
+            default:
+                // Already rejected by IsBatchValueValid().
+                break;
+        }
+    }
+
+    le_cfg_SetBatchRespond(commandRef, result);
+}
+
+
+
+
 
 
 // -------------------------------------------------------------------------------------------------
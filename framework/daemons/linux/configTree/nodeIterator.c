@@ -1311,3 +1311,54 @@ void ni_SetNodeValueBool
         tdb_SetValueAsBool(nodeRef, value);
     }
 }
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Read the type and the value of a node in one lookup, for the batch reads.
+ *
+ *  @return LE_OK if the string value fits within the supplied buffer, LE_OVERFLOW otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t ni_GetNodeValues
+(
+    ni_IteratorRef_t iteratorRef,  ///< [IN]  The iterator object to access.
+    const char* pathPtr,           ///< [IN]  Optional path to another node in the tree.
+    le_cfg_nodeType_t* typePtr,    ///< [OUT] The type of the node.
+    double* numberPtr,             ///< [OUT] The value of a bool, int or float node, 0 otherwise.
+    char* destBufferPtr,           ///< [OUT] The buffer to copy the value as a string into.
+    size_t bufferMax               ///< [IN]  The maximum size of the string buffer.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    tdb_NodeRef_t nodeRef = ni_GetNode(iteratorRef, pathPtr);
+
+    *numberPtr = 0;
+
+    if (nodeRef == NULL)
+    {
+        *typePtr = LE_CFG_TYPE_DOESNT_EXIST;
+        return le_utf8_Copy(destBufferPtr, "", bufferMax, NULL);
+    }
+
+    *typePtr = tdb_GetNodeType(nodeRef);
+
+    switch (*typePtr)
+    {
+        case LE_CFG_TYPE_BOOL:
+            *numberPtr = tdb_GetValueAsBool(nodeRef, false) ? 1 : 0;
+            break;
+
+        case LE_CFG_TYPE_INT:
+        case LE_CFG_TYPE_FLOAT:
+            *numberPtr = tdb_GetValueAsFloat(nodeRef, 0.0);
+            break;
+
+        default:
+            break;
+    }
+
+    return tdb_GetValueAsString(nodeRef, destBufferPtr, bufferMax, "");
+}
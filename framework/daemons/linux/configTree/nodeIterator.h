@@ -612,4 +612,24 @@ void ni_SetNodeValueBool
 
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Read the type and the value of a node in one lookup, for the batch reads.
+ *
+ *  @return LE_OK if the string value fits within the supplied buffer, LE_OVERFLOW otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t ni_GetNodeValues
+(
+    ni_IteratorRef_t iteratorRef,  ///< [IN]  The iterator object to access.
+    const char* pathPtr,           ///< [IN]  Optional path to another node in the tree.
+    le_cfg_nodeType_t* typePtr,    ///< [OUT] The type of the node.
+    double* numberPtr,             ///< [OUT] The value of a bool, int or float node, 0 otherwise.
+    char* destBufferPtr,           ///< [OUT] The buffer to copy the value as a string into.
+    size_t bufferMax               ///< [IN]  The maximum size of the string buffer.
+);
+
+
+
+
 #endif
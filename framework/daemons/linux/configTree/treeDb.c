@@ -149,6 +149,12 @@
 
 
 
+/// Maximum nesting of the unknown JSON members skipped while importing JSON data.
+#define JSON_MAX_SKIP_DEPTH 32
+
+
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Records the event registration for a given node in a given tree.
@@ -333,6 +339,25 @@ TokenType_t;
 
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Types of scalar values that can be found in JSON configuration data.
+ **/
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    JT_NONE,            ///< No value was given.
+    JT_NULL,            ///< The null literal.
+    JT_BOOL,            ///< true or false.
+    JT_INT,             ///< Number without a fraction or an exponent.
+    JT_FLOAT,           ///< Number with a fraction or an exponent.
+    JT_STRING           ///< UTF-8 text string.
+}
+JsonValueType_t;
+
+
+
+
 /// The memory pool responsible for tree nodes.
 static le_mem_PoolRef_t NodePoolRef = NULL;
 
@@ -2402,33 +2427,19 @@ static le_result_t InternalWriteNode
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Calculate the number of bytes required to store a node path, including seperators and a trailing
- *  NULL.
+ *  Write a null terminated string to the output stream, as is.
  *
- *  @return The amount of bytes required to store the whole path string.
+ *  @return LE_OK if the write succeeded, LE_IO_ERROR if the write failed.
  */
 // -------------------------------------------------------------------------------------------------
-static size_t ComputePathLength
+static le_result_t WriteText
 (
-    tdb_NodeRef_t nodeRef  ///< [IN] Compute a path for this node.
+    FILE* filePtr,       ///< [IN] The file being written to.
+    const char* textPtr  ///< [IN] The text to write.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    size_t pathLen = 0;
-    char nodeName[LE_CFG_NAME_LEN_BYTES] = "";
-
-    while (nodeRef != NULL)
-    {
-        LE_ASSERT(tdb_GetNodeName(nodeRef, nodeName, sizeof(nodeName)) == LE_OK);
-
-        // Add this path segment's length to our running total, along with the required path
-        // seperator.
-        pathLen += 1 + le_utf8_NumBytes(nodeName);
-        nodeRef = tdb_GetNodeParent(nodeRef);
-    }
-
-    // Don't forget to include a spot for the trailing NULL.
-    return pathLen + 1;
+    return WriteFile(filePtr, textPtr, strlen(textPtr));
 }
 
 
@@ -2436,21 +2447,53 @@ static size_t ComputePathLength
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Bump up the version id of this tree.
+ *  Write a JSON string to the output stream, escaping the quotes, back-slashes and control
+ *  characters as it does so.
+ *
+ *  @return LE_OK if the write succeeded, LE_IO_ERROR if the write failed.
  */
 // -------------------------------------------------------------------------------------------------
-static void IncrementRevision
+static le_result_t WriteJsonString
 (
-    tdb_TreeRef_t treeRef  ///< [IN] Increment the revision of this tree.
+    FILE* filePtr,         ///< [IN] The file to write to.
+    const char* stringPtr  ///< [IN] The actual string to write.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    treeRef->revisionId++;
+    le_result_t result = WriteFile(filePtr, "\"", 1);
 
-    if (treeRef->revisionId > 3)
+    while (   (*stringPtr != 0)
+           && (result == LE_OK))
     {
-        treeRef->revisionId = 1;
+        unsigned char next = *stringPtr;
+
+        if (   (next == '\"')
+            || (next == '\\'))
+        {
+            const char escBuffer[2] = { '\\', next };
+            result = WriteFile(filePtr, escBuffer, sizeof(escBuffer));
+        }
+        else if (next < 0x20)
+        {
+            char escBuffer[SMALL_STR];
+            snprintf(escBuffer, sizeof(escBuffer), "\\u%04x", next);
+
+            result = WriteText(filePtr, escBuffer);
+        }
+        else
+        {
+            result = WriteFile(filePtr, stringPtr, 1);
+        }
+
+        stringPtr++;
+    }
+
+    if (result == LE_OK)
+    {
+        result = WriteFile(filePtr, "\"", 1);
     }
+
+    return result;
 }
 
 
@@ -2458,93 +2501,125 @@ static void IncrementRevision
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Attempt to load a configuration tree from a config file.  This function will look for the latest
- *  valid version of the config file and load that one.
+ *  Serialize a tree node and it's children as a JSON object.  The layout is the same as the one
+ *  generated by the config tool:
+ *
+ *  @verbatim
+    { "name": "node", "type": "stem", "children": [ { "name": "leaf", "type": "int", "value": 1 } ] }
+    @endverbatim
+ *
+ *  @return LE_OK if the write succeeded, LE_IO_ERROR if the write failed.
  */
 // -------------------------------------------------------------------------------------------------
-static void LoadTree
+static le_result_t InternalWriteNodeJson
 (
-    tdb_TreeRef_t treeRef  ///< [IN] The tree object to load from the filesystem.
+    tdb_NodeRef_t nodeRef,  ///< [IN] The node being written.
+    FILE* filePtr           ///< [IN] The file being written to.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    // If we don't know the revision then hunt it out from the filesystem.
-    if (treeRef->revisionId == 0)
+    // Note that the buffer is static to save on stack space, it is never used across the recursive
+    // call.
+    static char stringBuffer[LE_CFG_STR_LEN_BYTES] = "";
+
+    le_cfg_nodeType_t type = LE_CFG_TYPE_DOESNT_EXIST;
+
+    if (nodeRef != NULL)
     {
-        UpdateRevision(treeRef);
+        type = tdb_GetNodeType(nodeRef);
+        tdb_GetNodeName(nodeRef, stringBuffer, sizeof(stringBuffer));
+    }
+    else
+    {
+        stringBuffer[0] = 0;
     }
 
-    // If this tree has no root, create it now.
-    if (treeRef->rootNodeRef == NULL)
+    le_result_t result = WriteText(filePtr, "{\"name\":");
+
+    if (result == LE_OK)
     {
-        treeRef->rootNodeRef = NewNode();
+        result = WriteJsonString(filePtr, stringBuffer);
     }
 
-    // Ok, if we found a valid revision of the tree in the fs, try to load it now.
-    if (treeRef->revisionId != 0)
+    if (result != LE_OK)
     {
-        char pathPtr[LE_CFG_STR_LEN_BYTES] = "";
-        GetTreePath(treeRef->name, treeRef->revisionId, pathPtr, sizeof(pathPtr));
+        return result;
+    }
 
-        LE_DEBUG("** Loading configuration tree from '%s'.", pathPtr);
+    switch (type)
+    {
+        case LE_CFG_TYPE_EMPTY:
+        case LE_CFG_TYPE_DOESNT_EXIST:
+            result = WriteText(filePtr, ",\"type\":\"empty\"");
+            break;
 
-        int fileRef = -1;
+        case LE_CFG_TYPE_BOOL:
+            tdb_GetValueAsString(nodeRef, stringBuffer, sizeof(stringBuffer), "");
+            result = WriteText(filePtr,
+                               strcmp(stringBuffer, "f") == 0 ? ",\"type\":\"bool\",\"value\":false"
+                                                              : ",\"type\":\"bool\",\"value\":true");
+            break;
 
-        do
-        {
-            fileRef = open(pathPtr, O_RDONLY);
-        }
-        while ((fileRef == -1) && (errno == EINTR));
+        case LE_CFG_TYPE_STRING:
+            tdb_GetValueAsString(nodeRef, stringBuffer, sizeof(stringBuffer), "");
+            result = WriteText(filePtr, ",\"type\":\"string\",\"value\":");
 
-        tdb_EnsureExists(treeRef->rootNodeRef);
+            if (result == LE_OK)
+            {
+                result = WriteJsonString(filePtr, stringBuffer);
+            }
+            break;
 
-        if (fileRef == -1)
-        {
-            LE_ERROR("Could not open configuration tree file: %s, reason: %s",
-                     pathPtr,
-                     strerror(errno));
-        }
-        else
-        {
-            if (tdb_ReadTreeNode(treeRef->rootNodeRef, fileRef) == false)
+        case LE_CFG_TYPE_INT:
+        case LE_CFG_TYPE_FLOAT:
+            tdb_GetValueAsString(nodeRef, stringBuffer, sizeof(stringBuffer), "");
+            result = WriteText(filePtr,
+                               type == LE_CFG_TYPE_INT ? ",\"type\":\"int\",\"value\":"
+                                                       : ",\"type\":\"float\",\"value\":");
+
+            if (result == LE_OK)
             {
-                LE_ERROR("Could not parse configuration tree file: %s.", pathPtr);
-                le_mem_Release(treeRef->rootNodeRef);
-                treeRef->rootNodeRef = NewNode();
+                result = WriteText(filePtr, stringBuffer);
             }
+            break;
 
-            close(fileRef);
-        }
-    }
-}
+        // Looks like this node is a collection, so write out it's child nodes now.  Like the config
+        // tool, the root of a tree is given the type "tree".
+        case LE_CFG_TYPE_STEM:
+            result = WriteText(filePtr,
+                               tdb_GetNodeParent(nodeRef) == NULL
+                                   ? ",\"type\":\"tree\",\"children\":["
+                                   : ",\"type\":\"stem\",\"children\":[");
+            {
+                tdb_NodeRef_t childRef = tdb_GetFirstActiveChildNode(nodeRef);
 
+                while (   (childRef != NULL)
+                       && (result == LE_OK))
+                {
+                    result = InternalWriteNodeJson(childRef, filePtr);
+                    childRef = tdb_GetNextActiveSiblingNode(childRef);
 
+                    if (   (childRef != NULL)
+                        && (result == LE_OK))
+                    {
+                        result = WriteFile(filePtr, ",", 1);
+                    }
+                }
+            }
 
-// -------------------------------------------------------------------------------------------------
-/**
- *  Removes the handler object from the given registration object.  This function will also free the
- *  memory that the handler object had used.
- */
-// -------------------------------------------------------------------------------------------------
-static void RemoveHandler
-(
-    Registration_t* registrationPtr,  ///< [IN] The registration object to remove the link from.
-    Handler_t* handlerPtr             ///< [IN] The handler object we're removing.
-)
-// -------------------------------------------------------------------------------------------------
-{
-    // Kill the ref, and remove the object from the registration list.
-    le_ref_DeleteRef(HandlerSafeRefMap, handlerPtr->safeRef);
-    le_dls_Remove(&registrationPtr->handlerList, &handlerPtr->link);
+            if (result == LE_OK)
+            {
+                result = WriteFile(filePtr, "]", 1);
+            }
+            break;
+    }
 
-    // Clear out the link data, just to be safe.
-    handlerPtr->link = LE_DLS_LINK_INIT;
-    handlerPtr->sessionRef = NULL;
-    handlerPtr->registrationPtr = NULL;
-    handlerPtr->safeRef = NULL;
+    if (result == LE_OK)
+    {
+        result = WriteFile(filePtr, "}", 1);
+    }
 
-    // Finally kill the object.
-    le_mem_Release(handlerPtr);
+    return result;
 }
 
 
@@ -2552,55 +2627,28 @@ static void RemoveHandler
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  This function is called by the hash map ForEach function, which is invoked when a session closed
- *  event occurs.
- *
- *  This function takes care of cleaning out orphaned event handlers from the registration objects
- *  currently stored in the registration hash map.  If a given registration handler is no longer
- *  required then the object itself is queued for deletion.  It is queued and not deleted in place
- *  because the hash map does not support deleting objects in the middle of an iteration.
+ *  Skip any whitespace, then read the next character from the input stream and make sure it is the
+ *  expected one.
  *
- *  @return True.  This function always returns true to indicate that iteration should continue
- *          until the end of the hash map.
+ *  @return LE_OK if the expected character was read.
+ *          LE_FORMAT_ERROR if another character was found, or the end of file was reached.
  */
 // -------------------------------------------------------------------------------------------------
-static bool OnHandlerRegistrationCleanup
+static le_result_t ReadJsonChar
 (
-    const void* keyPtr,    ///< [IN] The key used by this hash entry.
-    const void* valuePtr,  ///< [IN] The registration object.
-    void* contextPtr       ///< [IN] Context info including the ref for the session that closed.
+    FILE* filePtr,  ///< [IN] The file we're reading from.
+    char expected   ///< [IN] The character that must come next.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    // Convert our pointers into something useable.
-    Registration_t* registrationPtr = (Registration_t*)valuePtr;
-    CleanUpContext_t* cleanUpContextPtr = (CleanUpContext_t*)contextPtr;
-
-    // Go through this registration object's list of update handlers and check to see if they were
-    // registered on the target session.  If so, free them from the list.
-    le_dls_Link_t* linkPtr = le_dls_Peek(&registrationPtr->handlerList);
-
-    while (linkPtr != NULL)
-    {
-        Handler_t* handlerObjectPtr = CONTAINER_OF(linkPtr, Handler_t, link);
-        linkPtr = le_dls_PeekNext(&registrationPtr->handlerList, linkPtr);
-
-        if (handlerObjectPtr->sessionRef == cleanUpContextPtr->sessionRef)
-        {
-            RemoveHandler(registrationPtr, handlerObjectPtr);
-        }
-    }
-
-    // Now, check to see if there are any handlers left in this object.  If the registration object
-    // is empty, then queue it for deletion.
-    if (le_dls_IsEmpty(&registrationPtr->handlerList))
+    if (   (SkipWhiteSpace(filePtr) != LE_OK)
+        || (fgetc(filePtr) != expected))
     {
-        registrationPtr->link = LE_SLS_LINK_INIT;
-        le_sls_Queue(&cleanUpContextPtr->deleteQueue, &registrationPtr->link);
+        LE_ERROR("Expected '%c' in JSON data.", expected);
+        return LE_FORMAT_ERROR;
     }
 
-    // We want to continue iterating through the collection.
-    return true;
+    return LE_OK;
 }
 
 
@@ -2608,21 +2656,33 @@ static bool OnHandlerRegistrationCleanup
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Call this function to delete a tree file from the filesystem.
+ *  Read the 4 hex digits of a JSON \\u escape sequence.
+ *
+ *  @return The code unit read, or -1 if the sequence is not valid.
  */
 // -------------------------------------------------------------------------------------------------
-static void DeleteTreeFile
+static int32_t ReadJsonHexEscape
 (
-    const char* filePathPtr  ///< Path to the tree file in question.
+    FILE* filePtr  ///< [IN] The file we're reading from.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    LE_DEBUG("** Deleting tree file, '%s'.", filePathPtr);
+    int32_t value = 0;
+    int i;
 
-    if (unlink(filePathPtr) != 0)
+    for (i = 0; i < 4; i++)
     {
-        LE_ERROR("File delete failure, '%s', reason '%m'.", filePathPtr);
+        int next = fgetc(filePtr);
+
+        if (isxdigit(next) == 0)
+        {
+            return -1;
+        }
+
+        value = (value << 4) | (isdigit(next) ? next - '0' : (tolower(next) - 'a' + 10));
     }
+
+    return value;
 }
 
 
@@ -2630,38 +2690,1128 @@ static void DeleteTreeFile
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Find the root node represented by the path ref.
- *
- *  If the path is an absolute path, then the base node for the reference is the root node of the
- *  tree in question.
- *
- *  If the path is a relative path, then the base node of the request is the node given.
+ *  Read a JSON string, including its opening and closing quotes, and convert its escape sequences
+ *  to UTF-8.
  *
- *  @return A reference to the base node of the operation.
+ *  @return LE_OK if the string is read from the file.
+ *          LE_FORMAT_ERROR if the string is malformed or too large for the buffer.
  */
 // -------------------------------------------------------------------------------------------------
-static tdb_NodeRef_t GetPathBaseNodeRef
+static le_result_t ReadJsonString
 (
-    tdb_NodeRef_t nodeRef,         ///< [IN] The base node to start from.
-    le_pathIter_Ref_t nodePathRef  ///< [IN] The path we're searching for in the tree.
+    FILE* filePtr,     ///< [IN]  The file we're reading from.
+    char* stringPtr,   ///< [OUT] String buffer to hold the string we've read.
+    size_t stringSize  ///< [IN]  How big is the supplied string buffer?
 )
 // -------------------------------------------------------------------------------------------------
 {
-    // If the path is absolute and the node we were given is NOT the root node of it's tree, find
-    // the root node of the tree.  Otherwise just return the node reference we were given.
-    if (   (le_pathIter_IsAbsolute(nodePathRef))
-        && (nodeRef->parentRef != NULL))
+    if (ReadJsonChar(filePtr, '\"') != LE_OK)
     {
-        nodeRef = GetRootParentNode(nodeRef);
+        return LE_FORMAT_ERROR;
     }
 
-    return nodeRef;
-}
+    size_t count = 0;
+    int next;
 
+    while ((next = fgetc(filePtr)) != '\"')
+    {
+        char utf8Buffer[4];
+        size_t utf8Len = 1;
 
+        if (   (next == EOF)
+            || (next < 0x20))
+        {
+            LE_ERROR("Unterminated string in JSON data.");
+            return LE_FORMAT_ERROR;
+        }
 
+        utf8Buffer[0] = next;
 
-// -------------------------------------------------------------------------------------------------
+        if (next == '\\')
+        {
+            next = fgetc(filePtr);
+
+            switch (next)
+            {
+                case '\"':
+                case '\\':
+                case '/':
+                    utf8Buffer[0] = next;
+                    break;
+
+                case 'b':
+                    utf8Buffer[0] = '\b';
+                    break;
+
+                case 'f':
+                    utf8Buffer[0] = '\f';
+                    break;
+
+                case 'n':
+                    utf8Buffer[0] = '\n';
+                    break;
+
+                case 'r':
+                    utf8Buffer[0] = '\r';
+                    break;
+
+                case 't':
+                    utf8Buffer[0] = '\t';
+                    break;
+
+                case 'u':
+                    {
+                        int32_t codePoint = ReadJsonHexEscape(filePtr);
+
+                        // Combine a surrogate pair into a single code point.
+                        if (   (codePoint >= 0xD800)
+                            && (codePoint <= 0xDBFF))
+                        {
+                            int32_t lowSurrogate = -1;
+
+                            if (   (fgetc(filePtr) == '\\')
+                                && (fgetc(filePtr) == 'u'))
+                            {
+                                lowSurrogate = ReadJsonHexEscape(filePtr);
+                            }
+
+                            if (   (lowSurrogate < 0xDC00)
+                                || (lowSurrogate > 0xDFFF))
+                            {
+                                codePoint = -1;
+                            }
+                            else
+                            {
+                                codePoint = 0x10000 + ((codePoint - 0xD800) << 10)
+                                                    + (lowSurrogate - 0xDC00);
+                            }
+                        }
+
+                        if (   (codePoint <= 0)
+                            || (   (codePoint >= 0xDC00)
+                                && (codePoint <= 0xDFFF)))
+                        {
+                            LE_ERROR("Bad \\u escape sequence in JSON data.");
+                            return LE_FORMAT_ERROR;
+                        }
+
+                        if (codePoint < 0x80)
+                        {
+                            utf8Buffer[0] = codePoint;
+                        }
+                        else if (codePoint < 0x800)
+                        {
+                            utf8Buffer[0] = 0xC0 | (codePoint >> 6);
+                            utf8Buffer[1] = 0x80 | (codePoint & 0x3F);
+                            utf8Len = 2;
+                        }
+                        else if (codePoint < 0x10000)
+                        {
+                            utf8Buffer[0] = 0xE0 | (codePoint >> 12);
+                            utf8Buffer[1] = 0x80 | ((codePoint >> 6) & 0x3F);
+                            utf8Buffer[2] = 0x80 | (codePoint & 0x3F);
+                            utf8Len = 3;
+                        }
+                        else
+                        {
+                            utf8Buffer[0] = 0xF0 | (codePoint >> 18);
+                            utf8Buffer[1] = 0x80 | ((codePoint >> 12) & 0x3F);
+                            utf8Buffer[2] = 0x80 | ((codePoint >> 6) & 0x3F);
+                            utf8Buffer[3] = 0x80 | (codePoint & 0x3F);
+                            utf8Len = 4;
+                        }
+                    }
+                    break;
+
+                default:
+                    LE_ERROR("Bad escape sequence in JSON data.");
+                    return LE_FORMAT_ERROR;
+            }
+        }
+
+        if ((count + utf8Len) >= stringSize)
+        {
+            stringPtr[count] = 0;
+            LE_ERROR("String in JSON data, '%s...', too large.", stringPtr);
+
+            return LE_FORMAT_ERROR;
+        }
+
+        memcpy(stringPtr + count, utf8Buffer, utf8Len);
+        count += utf8Len;
+    }
+
+    stringPtr[count] = 0;
+
+    return LE_OK;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Read a JSON scalar value: a string, a number, true, false, or null.  Booleans are converted to
+ *  the config tree's "t" and "f" representation.
+ *
+ *  @return LE_OK if the value is read from the file.
+ *          LE_FORMAT_ERROR if the value is malformed, isn't a scalar, or if a number is out of range.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t ReadJsonScalar
+(
+    FILE* filePtr,             ///< [IN]  The file we're reading from.
+    char* stringPtr,           ///< [OUT] String buffer to hold the value we've read.
+    size_t stringSize,         ///< [IN]  How big is the supplied string buffer?
+    JsonValueType_t* typePtr   ///< [OUT] The type of value read from the file.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    if (SkipWhiteSpace(filePtr) != LE_OK)
+    {
+        LE_ERROR("Unexpected EOF in JSON data.");
+        return LE_FORMAT_ERROR;
+    }
+
+    if (PeekChar(filePtr) == '\"')
+    {
+        *typePtr = JT_STRING;
+        return ReadJsonString(filePtr, stringPtr, stringSize);
+    }
+
+    // Everything else is a literal or a number, made of letters, digits, signs and decimal points.
+    size_t count = 0;
+    signed char next = PeekChar(filePtr);
+
+    while (   (isalnum(next))
+           || (next == '-')
+           || (next == '+')
+           || (next == '.'))
+    {
+        if (count >= (stringSize - 1))
+        {
+            LE_ERROR("Value in JSON data too large.");
+            return LE_FORMAT_ERROR;
+        }
+
+        stringPtr[count++] = fgetc(filePtr);
+        next = PeekChar(filePtr);
+    }
+
+    stringPtr[count] = 0;
+
+    if (strcmp(stringPtr, "true") == 0)
+    {
+        *typePtr = JT_BOOL;
+        le_utf8_Copy(stringPtr, "t", stringSize, NULL);
+    }
+    else if (strcmp(stringPtr, "false") == 0)
+    {
+        *typePtr = JT_BOOL;
+        le_utf8_Copy(stringPtr, "f", stringSize, NULL);
+    }
+    else if (strcmp(stringPtr, "null") == 0)
+    {
+        *typePtr = JT_NULL;
+    }
+    else if (strpbrk(stringPtr, ".eE") == NULL)
+    {
+        // Integers must fit the config tree's 32-bit int values.
+        char* endPtr;
+
+        errno = 0;
+        long long value = strtoll(stringPtr, &endPtr, 10);
+
+        if (   (count == 0)
+            || (*endPtr != 0)
+            || (errno != 0)
+            || (value < INT32_MIN)
+            || (value > INT32_MAX))
+        {
+            LE_ERROR("Bad integer value, '%s', in JSON data.", stringPtr);
+            return LE_FORMAT_ERROR;
+        }
+
+        *typePtr = JT_INT;
+    }
+    else
+    {
+        char* endPtr;
+        strtod(stringPtr, &endPtr);
+
+        if (*endPtr != 0)
+        {
+            LE_ERROR("Bad number, '%s', in JSON data.", stringPtr);
+            return LE_FORMAT_ERROR;
+        }
+
+        *typePtr = JT_FLOAT;
+    }
+
+    return LE_OK;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Skip over a JSON value of any kind.  This is used for object members that the config tree
+ *  doesn't know about.
+ *
+ *  @return LE_OK if the value is skipped.
+ *          LE_FORMAT_ERROR if the value is malformed or nested too deeply.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t SkipJsonValue
+(
+    FILE* filePtr,  ///< [IN] The file we're reading from.
+    size_t depth    ///< [IN] How deeply the value is nested in skipped values.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    // Note that the buffer is static to save on stack space, the skipped data is never used.
+    static char stringBuffer[LE_CFG_STR_LEN_BYTES] = "";
+
+    if (depth > JSON_MAX_SKIP_DEPTH)
+    {
+        LE_ERROR("Unknown JSON data nested too deeply.");
+        return LE_FORMAT_ERROR;
+    }
+
+    if (SkipWhiteSpace(filePtr) != LE_OK)
+    {
+        LE_ERROR("Unexpected EOF in JSON data.");
+        return LE_FORMAT_ERROR;
+    }
+
+    signed char open = PeekChar(filePtr);
+
+    if (   (open != '{')
+        && (open != '['))
+    {
+        JsonValueType_t type;
+        return ReadJsonScalar(filePtr, stringBuffer, sizeof(stringBuffer), &type);
+    }
+
+    signed char close = (open == '{') ? '}' : ']';
+
+    fgetc(filePtr);
+    SkipWhiteSpace(filePtr);
+
+    if (PeekChar(filePtr) == close)
+    {
+        fgetc(filePtr);
+        return LE_OK;
+    }
+
+    while (true)
+    {
+        if (   (open == '{')
+            && (   (ReadJsonString(filePtr, stringBuffer, sizeof(stringBuffer)) != LE_OK)
+                || (ReadJsonChar(filePtr, ':') != LE_OK)))
+        {
+            return LE_FORMAT_ERROR;
+        }
+
+        if (SkipJsonValue(filePtr, depth + 1) != LE_OK)
+        {
+            return LE_FORMAT_ERROR;
+        }
+
+        SkipWhiteSpace(filePtr);
+        signed char next = fgetc(filePtr);
+
+        if (next == close)
+        {
+            return LE_OK;
+        }
+
+        if (next != ',')
+        {
+            LE_ERROR("Expected ',' or '%c' in JSON data.", close);
+            return LE_FORMAT_ERROR;
+        }
+    }
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Convert a JSON node type name, as written by the config tool, to a node type.
+ *
+ *  @return The node type, or LE_CFG_TYPE_DOESNT_EXIST if the name is not known.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_cfg_nodeType_t JsonTypeToNodeType
+(
+    const char* typeNamePtr  ///< [IN] The type name read from the JSON data.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    if (strcmp(typeNamePtr, "string") == 0)
+    {
+        return LE_CFG_TYPE_STRING;
+    }
+    else if (strcmp(typeNamePtr, "bool") == 0)
+    {
+        return LE_CFG_TYPE_BOOL;
+    }
+    else if (strcmp(typeNamePtr, "int") == 0)
+    {
+        return LE_CFG_TYPE_INT;
+    }
+    else if (strcmp(typeNamePtr, "float") == 0)
+    {
+        return LE_CFG_TYPE_FLOAT;
+    }
+    else if (   (strcmp(typeNamePtr, "stem") == 0)
+             || (strcmp(typeNamePtr, "tree") == 0))
+    {
+        return LE_CFG_TYPE_STEM;
+    }
+    else if (strcmp(typeNamePtr, "empty") == 0)
+    {
+        return LE_CFG_TYPE_EMPTY;
+    }
+
+    return LE_CFG_TYPE_DOESNT_EXIST;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Delete all of the children of a stem node.  The grandchildren are deleted before their parent,
+ *  so that on a shadow tree they are shadowed and marked as deleted too.  (tdb_DeleteNode marks the
+ *  parent as modified first, which stops its children from being shadowed.)  That way, if a deleted
+ *  child is given new contents again, its original children are still dropped by the merge.
+ */
+// -------------------------------------------------------------------------------------------------
+static void DeleteChildrenForReplace
+(
+    tdb_NodeRef_t nodeRef  ///< [IN] The stem node to clear.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    tdb_NodeRef_t childRef = tdb_GetFirstActiveChildNode(nodeRef);
+
+    while (childRef != NULL)
+    {
+        tdb_NodeRef_t nextChildRef = tdb_GetNextActiveSiblingNode(childRef);
+
+        if (childRef->type == LE_CFG_TYPE_STEM)
+        {
+            DeleteChildrenForReplace(childRef);
+        }
+
+        tdb_DeleteNode(childRef);
+        childRef = nextChildRef;
+    }
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Clear out a node that is about to be given new contents.  Unlike tdb_SetEmpty, the children of
+ *  a stem are deleted rather than released, so that on a shadow tree the merge also drops the
+ *  original children that don't get written again.  The node is also marked as existing, as it may
+ *  have been deleted while clearing out its parent.
+ */
+// -------------------------------------------------------------------------------------------------
+static void ClearNodeForReplace
+(
+    tdb_NodeRef_t nodeRef  ///< [IN] The node to clear.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    tdb_EnsureExists(nodeRef);
+
+    if (nodeRef->type != LE_CFG_TYPE_STEM)
+    {
+        tdb_SetEmpty(nodeRef);
+        return;
+    }
+
+    DeleteChildrenForReplace(nodeRef);
+    SetModifiedFlag(nodeRef);
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Read a node from a JSON object.  If the node is a collection, then read in its children too.
+ *
+ *  The node to write to is either given, for the top of the import, or is the child of parentRef
+ *  named by the object's "name" member.  In the latter case the name must come before the "value"
+ *  and "children" members, as it does in the data generated by the config tool.  If the "type"
+ *  member is missing the node type is taken from the JSON value.
+ *
+ *  @return LE_OK if the read is successful.
+ *          LE_FORMAT_ERROR if parse errors are encountered.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t InternalReadNodeJson
+(
+    tdb_NodeRef_t parentRef,  ///< [IN] The parent of the node to read, if nodeRef is NULL.
+    tdb_NodeRef_t nodeRef,    ///< [IN] The node we're reading a value for, or NULL to create or
+                              ///<      replace the child of parentRef named in the object.
+    FILE* filePtr,            ///< [IN] The file we're reading the value from.
+    size_t pathLen            ///< [IN] The length of the path including parentRef or nodeRef.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    // Note that the buffer is static to save on stack space, it is never used across the recursive
+    // call.
+    static char stringBuffer[LE_CFG_STR_LEN_BYTES] = "";
+
+    char keyBuffer[SMALL_STR] = "";
+    le_cfg_nodeType_t type = LE_CFG_TYPE_DOESNT_EXIST;
+    JsonValueType_t valueType = JT_NONE;
+    bool hasChildren = false;
+
+    if (ReadJsonChar(filePtr, '{') != LE_OK)
+    {
+        return LE_FORMAT_ERROR;
+    }
+
+    SkipWhiteSpace(filePtr);
+
+    if (PeekChar(filePtr) == '}')
+    {
+        fgetc(filePtr);
+    }
+    else
+    {
+        signed char next;
+
+        do
+        {
+            if (   (ReadJsonString(filePtr, keyBuffer, sizeof(keyBuffer)) != LE_OK)
+                || (ReadJsonChar(filePtr, ':') != LE_OK))
+            {
+                return LE_FORMAT_ERROR;
+            }
+
+            if (strcmp(keyBuffer, "name") == 0)
+            {
+                if (ReadJsonString(filePtr, stringBuffer, sizeof(stringBuffer)) != LE_OK)
+                {
+                    return LE_FORMAT_ERROR;
+                }
+
+                // The name of the top node is ignored, the data goes to the node being imported
+                // to.
+                if (nodeRef == NULL)
+                {
+                    size_t newPathLen = pathLen + 1 + le_utf8_NumBytes(stringBuffer);
+
+                    if (newPathLen > LE_CFG_STR_LEN)
+                    {
+                        LE_ERROR("New path length for node '%s' is too long.", stringBuffer);
+                        return LE_FORMAT_ERROR;
+                    }
+
+                    if (   (strcmp(stringBuffer, ".") == 0)
+                        || (strcmp(stringBuffer, "..") == 0))
+                    {
+                        LE_ERROR("Bad node name, '%s'.", stringBuffer);
+                        return LE_FORMAT_ERROR;
+                    }
+
+                    nodeRef = GetNamedChild(parentRef, stringBuffer);
+
+                    if (nodeRef == NULL)
+                    {
+                        nodeRef = NewChildNode(parentRef);
+
+                        if (tdb_SetNodeName(nodeRef, stringBuffer) != LE_OK)
+                        {
+                            LE_ERROR("Bad node name, '%s'.", stringBuffer);
+                            return LE_FORMAT_ERROR;
+                        }
+                    }
+                    else
+                    {
+                        ClearNodeForReplace(nodeRef);
+                    }
+
+                    tdb_EnsureExists(nodeRef);
+                    pathLen = newPathLen;
+                }
+            }
+            else if (strcmp(keyBuffer, "type") == 0)
+            {
+                if (ReadJsonString(filePtr, stringBuffer, sizeof(stringBuffer)) != LE_OK)
+                {
+                    return LE_FORMAT_ERROR;
+                }
+
+                type = JsonTypeToNodeType(stringBuffer);
+
+                if (type == LE_CFG_TYPE_DOESNT_EXIST)
+                {
+                    LE_ERROR("Unknown node type, '%s', in JSON data.", stringBuffer);
+                    return LE_FORMAT_ERROR;
+                }
+            }
+            else if (   (strcmp(keyBuffer, "value") == 0)
+                     || (strcmp(keyBuffer, "children") == 0))
+            {
+                if (nodeRef == NULL)
+                {
+                    LE_ERROR("JSON node member '%s' found before the node's name.", keyBuffer);
+                    return LE_FORMAT_ERROR;
+                }
+
+                if (   (valueType != JT_NONE)
+                    || (hasChildren))
+                {
+                    LE_ERROR("JSON node has more than one value.");
+                    return LE_FORMAT_ERROR;
+                }
+
+                if (strcmp(keyBuffer, "value") == 0)
+                {
+                    if (ReadJsonScalar(filePtr,
+                                       stringBuffer,
+                                       sizeof(stringBuffer),
+                                       &valueType) != LE_OK)
+                    {
+                        return LE_FORMAT_ERROR;
+                    }
+
+                    if (valueType != JT_NULL)
+                    {
+                        tdb_SetValueAsString(nodeRef, stringBuffer);
+                    }
+                }
+                else
+                {
+                    hasChildren = true;
+
+                    if (ReadJsonChar(filePtr, '[') != LE_OK)
+                    {
+                        return LE_FORMAT_ERROR;
+                    }
+
+                    SkipWhiteSpace(filePtr);
+
+                    if (PeekChar(filePtr) == ']')
+                    {
+                        fgetc(filePtr);
+                    }
+                    else
+                    {
+                        do
+                        {
+                            le_result_t result = InternalReadNodeJson(nodeRef,
+                                                                      NULL,
+                                                                      filePtr,
+                                                                      pathLen);
+
+                            if (result != LE_OK)
+                            {
+                                return result;
+                            }
+
+                            SkipWhiteSpace(filePtr);
+                            next = fgetc(filePtr);
+                        }
+                        while (next == ',');
+
+                        if (next != ']')
+                        {
+                            LE_ERROR("Expected ',' or ']' in JSON data.");
+                            return LE_FORMAT_ERROR;
+                        }
+                    }
+                }
+            }
+            else if (SkipJsonValue(filePtr, 0) != LE_OK)
+            {
+                return LE_FORMAT_ERROR;
+            }
+
+            SkipWhiteSpace(filePtr);
+            next = fgetc(filePtr);
+        }
+        while (next == ',');
+
+        if (next != '}')
+        {
+            LE_ERROR("Expected ',' or '}' in JSON data.");
+            return LE_FORMAT_ERROR;
+        }
+    }
+
+    if (nodeRef == NULL)
+    {
+        LE_ERROR("JSON node without a name.");
+        return LE_FORMAT_ERROR;
+    }
+
+    // If the type wasn't given, it comes from the value.
+    if (type == LE_CFG_TYPE_DOESNT_EXIST)
+    {
+        switch (valueType)
+        {
+            case JT_BOOL:
+                type = LE_CFG_TYPE_BOOL;
+                break;
+
+            case JT_INT:
+                type = LE_CFG_TYPE_INT;
+                break;
+
+            case JT_FLOAT:
+                type = LE_CFG_TYPE_FLOAT;
+                break;
+
+            case JT_STRING:
+                type = LE_CFG_TYPE_STRING;
+                break;
+
+            case JT_NONE:
+            case JT_NULL:
+                type = hasChildren ? LE_CFG_TYPE_STEM : LE_CFG_TYPE_EMPTY;
+                break;
+        }
+    }
+
+    // Now make sure that the value matches the type.
+    bool isValueOk;
+
+    switch (type)
+    {
+        case LE_CFG_TYPE_BOOL:
+            isValueOk = (valueType == JT_BOOL);
+            break;
+
+        case LE_CFG_TYPE_INT:
+            isValueOk = (valueType == JT_INT);
+            break;
+
+        case LE_CFG_TYPE_FLOAT:
+            isValueOk = (valueType == JT_INT) || (valueType == JT_FLOAT);
+            break;
+
+        case LE_CFG_TYPE_STRING:
+            isValueOk = (valueType == JT_STRING);
+            break;
+
+        case LE_CFG_TYPE_EMPTY:
+            isValueOk = ((valueType == JT_NONE) || (valueType == JT_NULL)) && !hasChildren;
+            break;
+
+        default:
+            isValueOk = (valueType == JT_NONE) || (valueType == JT_NULL);
+            break;
+    }
+
+    if (isValueOk == false)
+    {
+        LE_ERROR("JSON node value doesn't match its type.");
+        return LE_FORMAT_ERROR;
+    }
+
+    // Values have been stored as strings, so record their real type now.  Stems already got their
+    // type as their children were added.
+    if (   (type == LE_CFG_TYPE_BOOL)
+        || (type == LE_CFG_TYPE_INT)
+        || (type == LE_CFG_TYPE_FLOAT))
+    {
+        nodeRef->type = type;
+    }
+    else if (type == LE_CFG_TYPE_EMPTY)
+    {
+        ClearDeletedFlag(nodeRef);
+    }
+
+    if (IsShadow(nodeRef) == false)
+    {
+        ClearModifiedFlag(nodeRef);
+    }
+    else
+    {
+        SetModifiedFlag(nodeRef);
+    }
+
+    tdb_EnsureExists(nodeRef);
+
+    return LE_OK;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Copy a node's value to another node.  If the value is a collection, then copy its children too.
+ *
+ *  @return LE_OK if the copy is successful.
+ *          LE_OVERFLOW if the path of a copied node would be too long.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t InternalCopyNode
+(
+    tdb_NodeRef_t destRef,  ///< [IN] The node being written to.
+    tdb_NodeRef_t srcRef,   ///< [IN] The node being copied.
+    size_t pathLen          ///< [IN] The length of the path including destRef.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    // Note that the buffer is static to save on stack space, it is never used across the recursive
+    // call.
+    static char stringBuffer[LE_CFG_STR_LEN_BYTES] = "";
+
+    le_cfg_nodeType_t type = tdb_GetNodeType(srcRef);
+
+    ClearNodeForReplace(destRef);
+
+    switch (type)
+    {
+        case LE_CFG_TYPE_BOOL:
+        case LE_CFG_TYPE_INT:
+        case LE_CFG_TYPE_FLOAT:
+        case LE_CFG_TYPE_STRING:
+            tdb_GetValueAsString(srcRef, stringBuffer, sizeof(stringBuffer), "");
+            tdb_SetValueAsString(destRef, stringBuffer);
+            destRef->type = type;
+            break;
+
+        case LE_CFG_TYPE_STEM:
+            {
+                tdb_NodeRef_t srcChildRef = tdb_GetFirstActiveChildNode(srcRef);
+
+                while (srcChildRef != NULL)
+                {
+                    tdb_GetNodeName(srcChildRef, stringBuffer, sizeof(stringBuffer));
+
+                    size_t newPathLen = pathLen + 1 + le_utf8_NumBytes(stringBuffer);
+
+                    if (newPathLen > LE_CFG_STR_LEN)
+                    {
+                        LE_ERROR("New path length for node '%s' is too long.", stringBuffer);
+                        return LE_OVERFLOW;
+                    }
+
+                    tdb_NodeRef_t childRef = GetNamedChild(destRef, stringBuffer);
+
+                    if (childRef == NULL)
+                    {
+                        childRef = NewChildNode(destRef);
+                        LE_ASSERT(tdb_SetNodeName(childRef, stringBuffer) == LE_OK);
+                    }
+
+                    tdb_EnsureExists(childRef);
+
+                    le_result_t result = InternalCopyNode(childRef, srcChildRef, newPathLen);
+
+                    if (result != LE_OK)
+                    {
+                        return result;
+                    }
+
+                    srcChildRef = tdb_GetNextActiveSiblingNode(srcChildRef);
+                }
+            }
+            break;
+
+        case LE_CFG_TYPE_EMPTY:
+        case LE_CFG_TYPE_DOESNT_EXIST:
+            // The node has already been cleared, so there's nothing left to do but make sure that
+            // the node exists.
+            ClearDeletedFlag(destRef);
+            break;
+    }
+
+    if (IsShadow(destRef) == false)
+    {
+        ClearModifiedFlag(destRef);
+    }
+    else
+    {
+        SetModifiedFlag(destRef);
+    }
+
+    tdb_EnsureExists(destRef);
+
+    return LE_OK;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Calculate the number of bytes required to store a node path, including seperators and a trailing
+ *  NULL.
+ *
+ *  @return The amount of bytes required to store the whole path string.
+ */
+// -------------------------------------------------------------------------------------------------
+static size_t ComputePathLength
+(
+    tdb_NodeRef_t nodeRef  ///< [IN] Compute a path for this node.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    size_t pathLen = 0;
+    char nodeName[LE_CFG_NAME_LEN_BYTES] = "";
+
+    while (nodeRef != NULL)
+    {
+        LE_ASSERT(tdb_GetNodeName(nodeRef, nodeName, sizeof(nodeName)) == LE_OK);
+
+        // Add this path segment's length to our running total, along with the required path
+        // seperator.
+        pathLen += 1 + le_utf8_NumBytes(nodeName);
+        nodeRef = tdb_GetNodeParent(nodeRef);
+    }
+
+    // Don't forget to include a spot for the trailing NULL.
+    return pathLen + 1;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Bump up the version id of this tree.
+ */
+// -------------------------------------------------------------------------------------------------
+static void IncrementRevision
+(
+    tdb_TreeRef_t treeRef  ///< [IN] Increment the revision of this tree.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    treeRef->revisionId++;
+
+    if (treeRef->revisionId > 3)
+    {
+        treeRef->revisionId = 1;
+    }
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Attempt to load a configuration tree from a config file.  This function will look for the latest
+ *  valid version of the config file and load that one.
+ */
+// -------------------------------------------------------------------------------------------------
+static void LoadTree
+(
+    tdb_TreeRef_t treeRef  ///< [IN] The tree object to load from the filesystem.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    // If we don't know the revision then hunt it out from the filesystem.
+    if (treeRef->revisionId == 0)
+    {
+        UpdateRevision(treeRef);
+    }
+
+    // If this tree has no root, create it now.
+    if (treeRef->rootNodeRef == NULL)
+    {
+        treeRef->rootNodeRef = NewNode();
+    }
+
+    // Ok, if we found a valid revision of the tree in the fs, try to load it now.
+    if (treeRef->revisionId != 0)
+    {
+        char pathPtr[LE_CFG_STR_LEN_BYTES] = "";
+        GetTreePath(treeRef->name, treeRef->revisionId, pathPtr, sizeof(pathPtr));
+
+        LE_DEBUG("** Loading configuration tree from '%s'.", pathPtr);
+
+        int fileRef = -1;
+
+        do
+        {
+            fileRef = open(pathPtr, O_RDONLY);
+        }
+        while ((fileRef == -1) && (errno == EINTR));
+
+        tdb_EnsureExists(treeRef->rootNodeRef);
+
+        if (fileRef == -1)
+        {
+            LE_ERROR("Could not open configuration tree file: %s, reason: %s",
+                     pathPtr,
+                     strerror(errno));
+        }
+        else
+        {
+            if (tdb_ReadTreeNode(treeRef->rootNodeRef, fileRef) == false)
+            {
+                LE_ERROR("Could not parse configuration tree file: %s.", pathPtr);
+                le_mem_Release(treeRef->rootNodeRef);
+                treeRef->rootNodeRef = NewNode();
+            }
+
+            close(fileRef);
+        }
+    }
+}
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Removes the handler object from the given registration object.  This function will also free the
+ *  memory that the handler object had used.
+ */
+// -------------------------------------------------------------------------------------------------
+static void RemoveHandler
+(
+    Registration_t* registrationPtr,  ///< [IN] The registration object to remove the link from.
+    Handler_t* handlerPtr             ///< [IN] The handler object we're removing.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    // Kill the ref, and remove the object from the registration list.
+    le_ref_DeleteRef(HandlerSafeRefMap, handlerPtr->safeRef);
+    le_dls_Remove(&registrationPtr->handlerList, &handlerPtr->link);
+
+    // Clear out the link data, just to be safe.
+    handlerPtr->link = LE_DLS_LINK_INIT;
+    handlerPtr->sessionRef = NULL;
+    handlerPtr->registrationPtr = NULL;
+    handlerPtr->safeRef = NULL;
+
+    // Finally kill the object.
+    le_mem_Release(handlerPtr);
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  This function is called by the hash map ForEach function, which is invoked when a session closed
+ *  event occurs.
+ *
+ *  This function takes care of cleaning out orphaned event handlers from the registration objects
+ *  currently stored in the registration hash map.  If a given registration handler is no longer
+ *  required then the object itself is queued for deletion.  It is queued and not deleted in place
+ *  because the hash map does not support deleting objects in the middle of an iteration.
+ *
+ *  @return True.  This function always returns true to indicate that iteration should continue
+ *          until the end of the hash map.
+ */
+// -------------------------------------------------------------------------------------------------
+static bool OnHandlerRegistrationCleanup
+(
+    const void* keyPtr,    ///< [IN] The key used by this hash entry.
+    const void* valuePtr,  ///< [IN] The registration object.
+    void* contextPtr       ///< [IN] Context info including the ref for the session that closed.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    // Convert our pointers into something useable.
+    Registration_t* registrationPtr = (Registration_t*)valuePtr;
+    CleanUpContext_t* cleanUpContextPtr = (CleanUpContext_t*)contextPtr;
+
+    // Go through this registration object's list of update handlers and check to see if they were
+    // registered on the target session.  If so, free them from the list.
+    le_dls_Link_t* linkPtr = le_dls_Peek(&registrationPtr->handlerList);
+
+    while (linkPtr != NULL)
+    {
+        Handler_t* handlerObjectPtr = CONTAINER_OF(linkPtr, Handler_t, link);
+        linkPtr = le_dls_PeekNext(&registrationPtr->handlerList, linkPtr);
+
+        if (handlerObjectPtr->sessionRef == cleanUpContextPtr->sessionRef)
+        {
+            RemoveHandler(registrationPtr, handlerObjectPtr);
+        }
+    }
+
+    // Now, check to see if there are any handlers left in this object.  If the registration object
+    // is empty, then queue it for deletion.
+    if (le_dls_IsEmpty(&registrationPtr->handlerList))
+    {
+        registrationPtr->link = LE_SLS_LINK_INIT;
+        le_sls_Queue(&cleanUpContextPtr->deleteQueue, &registrationPtr->link);
+    }
+
+    // We want to continue iterating through the collection.
+    return true;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Call this function to delete a tree file from the filesystem.
+ */
+// -------------------------------------------------------------------------------------------------
+static void DeleteTreeFile
+(
+    const char* filePathPtr  ///< Path to the tree file in question.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    LE_DEBUG("** Deleting tree file, '%s'.", filePathPtr);
+
+    if (unlink(filePathPtr) != 0)
+    {
+        LE_ERROR("File delete failure, '%s', reason '%m'.", filePathPtr);
+    }
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Find the root node represented by the path ref.
+ *
+ *  If the path is an absolute path, then the base node for the reference is the root node of the
+ *  tree in question.
+ *
+ *  If the path is a relative path, then the base node of the request is the node given.
+ *
+ *  @return A reference to the base node of the operation.
+ */
+// -------------------------------------------------------------------------------------------------
+static tdb_NodeRef_t GetPathBaseNodeRef
+(
+    tdb_NodeRef_t nodeRef,         ///< [IN] The base node to start from.
+    le_pathIter_Ref_t nodePathRef  ///< [IN] The path we're searching for in the tree.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    // If the path is absolute and the node we were given is NOT the root node of it's tree, find
+    // the root node of the tree.  Otherwise just return the node reference we were given.
+    if (   (le_pathIter_IsAbsolute(nodePathRef))
+        && (nodeRef->parentRef != NULL))
+    {
+        nodeRef = GetRootParentNode(nodeRef);
+    }
+
+    return nodeRef;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
 /**
  *  Create a new C style file pointer from the POSIX file descriptor.
  *
@@ -3324,6 +4474,148 @@ le_result_t tdb_WriteTreeNode
 
 
 
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Read a configuration tree node's contents from JSON data, in the format generated by the config
+ *  tool.  The node's previous contents are replaced.
+ *
+ *  @return LE_OK if the read is successful.
+ *          LE_FORMAT_ERROR if the data could not be parsed.
+ *          LE_FAULT if the file could not be read.
+ */
+// -------------------------------------------------------------------------------------------------
+le_result_t tdb_ReadTreeNodeJson
+(
+    tdb_NodeRef_t nodeRef,  ///< [IN] The node to write the new data to.
+    int descriptor          ///< [IN] The file to read from.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(nodeRef != NULL);
+    LE_ASSERT(descriptor != -1);
+
+    // Clear out any contents that the node may have, and make sure that it isn't marked as deleted.
+    ClearNodeForReplace(nodeRef);
+
+    FILE* filePtr = OpenFilePtr(descriptor, "r");
+
+    if (filePtr == NULL)
+    {
+        return LE_FAULT;
+    }
+
+    le_result_t result = LE_OK;
+    size_t pathLen = ComputePathLength(nodeRef);
+
+    if (pathLen >= LE_CFG_STR_LEN)
+    {
+        result = LE_FORMAT_ERROR;
+    }
+    else
+    {
+        result = InternalReadNodeJson(NULL, nodeRef, filePtr, pathLen);
+
+        // Make sure that there isn't anything left in the file.
+        if (   (result == LE_OK)
+            && (SkipWhiteSpace(filePtr) != LE_OUT_OF_RANGE))
+        {
+            LE_ERROR("Unexpected data after the JSON object.");
+            result = LE_FORMAT_ERROR;
+        }
+
+        // We shouldn't be leaving the node in a half initialized state.
+        if (result != LE_OK)
+        {
+            tdb_SetEmpty(nodeRef);
+        }
+    }
+
+    CloseFilePtr(filePtr);
+
+    return result;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Serialize a tree node and it's children as JSON, in the format generated by the config tool.
+ *
+ *  @return LE_OK if the write succeeded, LE_IO_ERROR if the write failed.
+ */
+// -------------------------------------------------------------------------------------------------
+le_result_t tdb_WriteTreeNodeJson
+(
+    tdb_NodeRef_t nodeRef,  ///< [IN] Write the contents of this node to a file descriptor.
+    int descriptor          ///< [IN] The file descriptor to write to.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    FILE* filePtr = OpenFilePtr(descriptor, "w");
+
+    if (filePtr == NULL)
+    {
+        return LE_IO_ERROR;
+    }
+
+    le_result_t result = InternalWriteNodeJson(nodeRef, filePtr);
+
+    if (result == LE_OK)
+    {
+        result = WriteFile(filePtr, "\n", 1);
+    }
+
+    CloseFilePtr(filePtr);
+
+    return result;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Copy a node and all of its children over another node of the same tree.  The destination's
+ *  previous contents are replaced.  The caller must make sure that neither node contains the other.
+ *
+ *  @return LE_OK if the copy is successful.
+ *          LE_OVERFLOW if the path of a copied node would be too long, in which case the destination
+ *          is left empty.
+ */
+// -------------------------------------------------------------------------------------------------
+le_result_t tdb_CopyNode
+(
+    tdb_NodeRef_t destRef,  ///< [IN] The node to overwrite.
+    tdb_NodeRef_t srcRef    ///< [IN] The node to copy.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(destRef != NULL);
+    LE_ASSERT(srcRef != NULL);
+
+    size_t pathLen = ComputePathLength(destRef);
+
+    if (pathLen >= LE_CFG_STR_LEN)
+    {
+        return LE_OVERFLOW;
+    }
+
+    tdb_EnsureExists(destRef);
+
+    le_result_t result = InternalCopyNode(destRef, srcRef, pathLen);
+
+    if (result != LE_OK)
+    {
+        tdb_SetEmpty(destRef);
+    }
+
+    return result;
+}
+
+
+
+
 // -------------------------------------------------------------------------------------------------
 /**
  *  Given a base node and a path, find another node in the tree.
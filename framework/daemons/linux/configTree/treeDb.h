@@ -287,6 +287,60 @@ le_result_t tdb_WriteTreeNode
 
 
 
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Read a configuration tree node's contents from JSON data, in the format generated by the config
+ *  tool.  The node's previous contents are replaced.
+ *
+ *  @return LE_OK if the read is successful.
+ *          LE_FORMAT_ERROR if the data could not be parsed.
+ *          LE_FAULT if the file could not be read.
+ */
+// -------------------------------------------------------------------------------------------------
+le_result_t tdb_ReadTreeNodeJson
+(
+    tdb_NodeRef_t nodeRef,  ///< [IN] The node to write the new data to.
+    int descriptor          ///< [IN] The file to read from.
+);
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Serialize a tree node and it's children as JSON, in the format generated by the config tool.
+ *
+ *  @return LE_OK if the write succeeded, LE_IO_ERROR if the write failed.
+ */
+// -------------------------------------------------------------------------------------------------
+le_result_t tdb_WriteTreeNodeJson
+(
+    tdb_NodeRef_t nodeRef,  ///< [IN] Write the contents of this node to a file descriptor.
+    int descriptor          ///< [IN] The file descriptor to write to.
+);
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Copy a node and all of its children over another node of the same tree.  The destination's
+ *  previous contents are replaced.  The caller must make sure that neither node contains the other.
+ *
+ *  @return LE_OK if the copy is successful.
+ *          LE_OVERFLOW if the path of a copied node would be too long, in which case the destination
+ *          is left empty.
+ */
+// -------------------------------------------------------------------------------------------------
+le_result_t tdb_CopyNode
+(
+    tdb_NodeRef_t destRef,  ///< [IN] The node to overwrite.
+    tdb_NodeRef_t srcRef    ///< [IN] The node to copy.
+);
+
+
+
+
 // -------------------------------------------------------------------------------------------------
 /**
  *  Given a base node and a path, find another node in the tree.
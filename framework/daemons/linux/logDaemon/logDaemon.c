@@ -67,8 +67,26 @@
 #include "logDaemon.h"
 #include "limit.h"
 #include "fileDescriptor.h"
+#include "logStore.h"
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Directory of the persistent log store.  The store is disabled if it cannot be created.
+ */
+//--------------------------------------------------------------------------------------------------
+#ifndef LOG_STORE_DIR
+#define LOG_STORE_DIR "/mnt/flash/legato_logs/store"
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Default and maximum number of records returned by a log store query.
+ */
+//--------------------------------------------------------------------------------------------------
+#define DEFAULT_QUERY_RECORDS   100
+#define MAX_QUERY_RECORDS       10000
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Maximum number of processes that we expect to see.  Used to set the hashmap and pool sizes.
@@ -301,6 +319,50 @@ static le_mem_PoolRef_t TracePoolRef;
                                 - LIMIT_MAX_COMPONENT_NAME_LEN )
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum length of log messages.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_MSG_SIZE            256
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the buffer an application's stdout/stderr is read into.  All the complete lines found in
+ * one read are handled at once, so this also bounds the work done for one source before the other
+ * sources get serviced.
+ */
+//--------------------------------------------------------------------------------------------------
+#define FD_LOG_READ_BYTES       4096
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of lines per second an application's stdout/stderr can log on average, and number of
+ * lines it can log in a burst.  Lines over this rate are discarded and counted, and the number of
+ * suppressed lines is logged with the next line that gets through.  The burst holds the start-up
+ * output of a process, the average rate is above what the Legato log API sends in normal operation.
+ */
+//--------------------------------------------------------------------------------------------------
+#define FD_LOG_RATE_LINES_PER_SEC   50
+#define FD_LOG_BURST_LINES          200
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Line counters of an application's stdout/stderr.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint64_t        logged;             ///< Lines logged.
+    uint64_t        suppressed;         ///< Lines discarded by the rate limit.
+    uint64_t        truncated;          ///< Lines longer than MAX_MSG_SIZE cut short.
+}
+FdLogStats_t;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * File descriptor logging object.
@@ -310,11 +372,22 @@ static le_mem_PoolRef_t TracePoolRef;
 //--------------------------------------------------------------------------------------------------
 typedef struct
 {
+    le_dls_Link_t   link;                                   ///< Link in the FdLogList.
     char            appName[LIMIT_MAX_APP_NAME_BYTES];      ///< App name.
     char            procName[LIMIT_MAX_PROCESS_NAME_BYTES]; ///< Process name.
     int             pid;                                    ///< PID of the process.
     le_log_Level_t  level;                                  ///< Log level.
     le_fdMonitor_Ref_t monitorRef;                          ///< Monitor object.
+    char            readBuf[FD_LOG_READ_BYTES];             ///< Data read, starting with the
+                                                            ///  incomplete line of the last read.
+    size_t          readLen;                                ///< Number of bytes in readBuf.
+    bool            isSkippingLine;                         ///< true if discarding the end of a
+                                                            ///  truncated line.
+    uint32_t        tokens;                                 ///< Lines that can be logged now.
+    uint64_t        refillTimeMs;                           ///< Time the tokens were refilled at.
+    uint32_t        pendingSuppressed;                      ///< Lines suppressed since the last
+                                                            ///  line logged.
+    FdLogStats_t    stats;                                  ///< Line counters.
 }
 FdLog_t;
 
@@ -329,10 +402,18 @@ static le_mem_PoolRef_t FdLogPoolRef;
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Maximum length of log messages.
+ * List of file descriptor logging objects.
  */
 //--------------------------------------------------------------------------------------------------
-#define MAX_MSG_SIZE            256
+static le_dls_List_t FdLogList = LE_DLS_LIST_INIT;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Line counters of the file descriptors that have been closed.
+ */
+//--------------------------------------------------------------------------------------------------
+static FdLogStats_t ClosedFdLogStats;
 
 
 
@@ -951,8 +1032,8 @@ static bool ParseCmdPacket
     }
     packetPtr++;
 
-    // The "list" command has no parameters.
-    if (commandCode == LOG_CMD_LIST_COMPONENTS)
+    // The "list" and "fdstats" commands have no parameters.
+    if ( (commandCode == LOG_CMD_LIST_COMPONENTS) || (commandCode == LOG_CMD_LIST_FD_STATS) )
     {
         return true;
     }
@@ -2186,6 +2267,219 @@ static void SetTrace
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sends a client a command to enable or disable call sites in one of its log sessions.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void UpdateClientCallSiteSetting
+(
+    RunningProcess_t* runningProcObjPtr,
+    LogSession_t* logSessionPtr,
+    const char* callSiteSpec,
+    bool isEnabled
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_msg_MessageRef_t msgRef = le_msg_CreateMsg(runningProcObjPtr->ipcSessionRef);
+    char* payloadPtr = le_msg_GetPayloadPtr(msgRef);
+    size_t maxSize = le_msg_GetMaxPayloadSize(msgRef);
+
+    size_t byteCount = snprintf(payloadPtr,
+                                maxSize,
+                                "%c%s/%s",
+                                isEnabled ? LOG_CMD_ENABLE_CALLSITE : LOG_CMD_DISABLE_CALLSITE,
+                                logSessionPtr->componentName,
+                                callSiteSpec);
+
+    if (byteCount >= maxSize)
+    {
+        LE_CRIT("Message too long (%zu bytes) to send to component '%s' in process '%s' (pid %d).",
+                byteCount,
+                logSessionPtr->componentName,
+                runningProcObjPtr->procNameObjPtr->name,
+                runningProcObjPtr->pid);
+        le_msg_ReleaseMsg(msgRef);
+    }
+    else
+    {
+        le_msg_Send(msgRef);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Enables or disables call sites in a specific running process.
+ *
+ * @return The number of log sessions of the process that the setting was sent to.
+ **/
+//--------------------------------------------------------------------------------------------------
+static size_t SetCallSiteForRunningProcess
+(
+    RunningProcess_t* runningProcObjPtr,
+    const char* componentName,
+    const char* callSiteSpec,
+    bool isEnabled
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t count = 0;
+
+    // If the setting applies to all log sessions in the process,
+    if (strcmp(componentName, "*") == 0)
+    {
+        le_dls_Link_t* linkPtr = le_dls_Peek(&runningProcObjPtr->logSessionList);
+        while (linkPtr != NULL)
+        {
+            LogSession_t* logSessionObjPtr = CONTAINER_OF(linkPtr, LogSession_t, link);
+
+            UpdateClientCallSiteSetting(runningProcObjPtr,
+                                        logSessionObjPtr,
+                                        callSiteSpec,
+                                        isEnabled);
+            count++;
+
+            linkPtr = le_dls_PeekNext(&runningProcObjPtr->logSessionList, linkPtr);
+        }
+    }
+    // If the setting applies to a specific log session within the process,
+    else
+    {
+        LogSession_t* logSessionObjPtr = FindLogSession(runningProcObjPtr, componentName);
+        if (logSessionObjPtr != NULL)
+        {
+            UpdateClientCallSiteSetting(runningProcObjPtr,
+                                        logSessionObjPtr,
+                                        callSiteSpec,
+                                        isEnabled);
+            count++;
+        }
+    }
+
+    return count;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Enables or disables call sites in all the running processes sharing a process name.
+ *
+ * @return The number of log sessions that the setting was sent to.
+ **/
+//--------------------------------------------------------------------------------------------------
+static size_t SetCallSiteForProcessName
+(
+    const ProcessName_t* procNameObjPtr,
+    const char* componentName,
+    const char* callSiteSpec,
+    bool isEnabled
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t count = 0;
+
+    le_dls_Link_t* linkPtr = le_dls_Peek(&procNameObjPtr->runningProcessesList);
+    while (linkPtr != NULL)
+    {
+        RunningProcess_t* runningProcObjPtr = CONTAINER_OF(linkPtr, RunningProcess_t, link);
+
+        count += SetCallSiteForRunningProcess(runningProcObjPtr,
+                                              componentName,
+                                              callSiteSpec,
+                                              isEnabled);
+
+        linkPtr = le_dls_PeekNext(&procNameObjPtr->runningProcessesList, linkPtr);
+    }
+
+    return count;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Enable/disable call sites.
+ *
+ * Unlike the level and trace settings, call site settings are not remembered by the Log Control
+ * Daemon: they only apply to the processes running when the command is received.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void SetCallSite
+(
+    const char* processName,
+    const char* componentName,
+    const char* callSiteSpec,
+    bool isEnabled,
+    le_msg_SessionRef_t toolIpcSessionRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    char message[LOG_MAX_CMD_PACKET_BYTES];
+    size_t count = 0;
+
+    // If a PID was used to specify that the settings apply to a specific running process,
+    pid_t pid = StringToPid(processName);
+    if (pid > 0)
+    {
+        RunningProcess_t* runningProcObjPtr = le_hashmap_Get(ProcessIdMapRef, &pid);
+        if (runningProcObjPtr == NULL)
+        {
+            snprintf(message, sizeof(message), "***ERROR: PID %d not found.", pid);
+            LE_WARN("%s", message);
+            SendToLogTool(toolIpcSessionRef, message);
+            return;
+        }
+
+        count = SetCallSiteForRunningProcess(runningProcObjPtr,
+                                             componentName,
+                                             callSiteSpec,
+                                             isEnabled);
+    }
+    // If the process name is "*", this setting applies to ALL PROCESSES.
+    else if (strcmp(processName, "*") == 0)
+    {
+        le_hashmap_It_Ref_t iteratorRef = le_hashmap_GetIterator(ProcessNameMapRef);
+        while (le_hashmap_NextNode(iteratorRef) == LE_OK)
+        {
+            count += SetCallSiteForProcessName(le_hashmap_GetValue(iteratorRef),
+                                               componentName,
+                                               callSiteSpec,
+                                               isEnabled);
+        }
+    }
+    else
+    {
+        ProcessName_t* procNameObjPtr = le_hashmap_Get(ProcessNameMapRef, processName);
+        if (procNameObjPtr != NULL)
+        {
+            count = SetCallSiteForProcessName(procNameObjPtr,
+                                              componentName,
+                                              callSiteSpec,
+                                              isEnabled);
+        }
+    }
+
+    if (count == 0)
+    {
+        snprintf(message,
+                 sizeof(message),
+                 "***ERROR: No running component matches '%s/%s'.",
+                 processName,
+                 componentName);
+    }
+    else
+    {
+        snprintf(message,
+                 sizeof(message),
+                 "%s '%s' in %zu component(s).",
+                 isEnabled ? "Enabled" : "Disabled",
+                 callSiteSpec,
+                 count);
+    }
+    SendToLogTool(toolIpcSessionRef, message);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Sends a message to the log tool containing a printable, null-terminated, UTF-8 string
@@ -2458,6 +2752,184 @@ static void ForgetProcess
 
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds line counters to a total.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddFdLogStats
+(
+    FdLogStats_t* totalPtr,         ///< [IN/OUT] Total.
+    const FdLogStats_t* statsPtr    ///< [IN] Counters to add.
+)
+{
+    totalPtr->logged += statsPtr->logged;
+    totalPtr->suppressed += statsPtr->suppressed;
+    totalPtr->truncated += statsPtr->truncated;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sends the line counters of the application processes' stdout/stderr to the log control tool.
+ *
+ * @note    Sends one message for each fd and one for the total, including the closed fds.
+ */
+//--------------------------------------------------------------------------------------------------
+static void GenerateFdStatsList
+(
+    le_msg_SessionRef_t ipcSessionRef   ///< [IN] Log control tool's current IPC session.
+)
+{
+    char message[LOG_MAX_CMD_PACKET_BYTES];
+    FdLogStats_t total = ClosedFdLogStats;
+
+    le_dls_Link_t* linkPtr = le_dls_Peek(&FdLogList);
+    while (linkPtr != NULL)
+    {
+        FdLog_t* fdLogPtr = CONTAINER_OF(linkPtr, FdLog_t, link);
+
+        snprintf(message,
+                 sizeof(message),
+                 "%s/%s[%d] %s: logged %" PRIu64 ", suppressed %" PRIu64 ", truncated %" PRIu64,
+                 fdLogPtr->appName,
+                 fdLogPtr->procName,
+                 fdLogPtr->pid,
+                 (fdLogPtr->level == LE_LOG_ERR) ? "stderr" : "stdout",
+                 fdLogPtr->stats.logged,
+                 fdLogPtr->stats.suppressed,
+                 fdLogPtr->stats.truncated);
+        SendToLogTool(ipcSessionRef, message);
+
+        AddFdLogStats(&total, &fdLogPtr->stats);
+
+        linkPtr = le_dls_PeekNext(&FdLogList, linkPtr);
+    }
+
+    snprintf(message,
+             sizeof(message),
+             "total: logged %" PRIu64 ", suppressed %" PRIu64 ", truncated %" PRIu64,
+             total.logged,
+             total.suppressed,
+             total.truncated);
+    SendToLogTool(ipcSessionRef, message);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sends a record of the log store to the log control tool.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SendStoredRecordToLogTool
+(
+    const logStore_Record_t* recordPtr, ///< [IN] Record.
+    void* contextPtr                    ///< [IN] Log control tool's current IPC session.
+)
+{
+    char timeStr[32] = "";
+    time_t sec = recordPtr->timeMs / 1000;
+    struct tm tm;
+
+    if (localtime_r(&sec, &tm) != NULL)
+    {
+        strftime(timeStr, sizeof(timeStr), "%b %d %H:%M:%S", &tm);
+    }
+
+    // Messages longer than a log control packet are cut.
+    char message[LOG_MAX_CMD_PACKET_BYTES];
+    snprintf(message,
+             sizeof(message),
+             "%s.%03u : %s | %s%s%s[%d] | %s",
+             timeStr,
+             (unsigned int)(recordPtr->timeMs % 1000),
+             GetLevelString(recordPtr->level),
+             recordPtr->appNamePtr,
+             (recordPtr->appNamePtr[0] != '\0') ? "/" : "",
+             recordPtr->procNamePtr,
+             (int)recordPtr->pid,
+             recordPtr->msgPtr);
+
+    SendToLogTool(contextPtr, message);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sends the records of the log store matching a query to the log control tool.
+ *
+ * The command data is "<level> <minutes> <maxRecords> <appName>", where a minutes of 0 means no
+ * time limit, a maxRecords of 0 means the default number of records, and an appName of "*" means
+ * all apps.
+ *
+ * The store only holds the standard output and standard error lines of the app processes, which
+ * have no component, so the component part of the destination is ignored.
+ */
+//--------------------------------------------------------------------------------------------------
+static void QueryLogStore
+(
+    const char* processName,            ///< [IN] Process name or "*".
+    const char* queryStr,               ///< [IN] Command data.
+    le_msg_SessionRef_t ipcSessionRef   ///< [IN] Log control tool's current IPC session.
+)
+{
+    char levelStr[16];
+    unsigned int minutes;
+    unsigned int maxRecords;
+    char appName[LIMIT_MAX_APP_NAME_BYTES];
+    char message[LOG_MAX_CMD_PACKET_BYTES];
+
+    if (sscanf(queryStr,
+               "%15s %u %u %" STRINGIZE(LIMIT_MAX_APP_NAME_LEN) "s",
+               levelStr,
+               &minutes,
+               &maxRecords,
+               appName) != 4)
+    {
+        snprintf(message, sizeof(message), "***ERROR: Invalid log store query '%s'.", queryStr);
+        LE_WARN("%s", message);
+        SendToLogTool(ipcSessionRef, message);
+        return;
+    }
+
+    logStore_Query_t query =
+    {
+        .appNamePtr = (strcmp(appName, "*") == 0) ? NULL : appName,
+        .procNamePtr = (strcmp(processName, "*") == 0) ? NULL : processName,
+        .level = log_StrToSeverityLevel(levelStr),
+        .sinceMs = 0,
+        .maxRecords = (maxRecords == 0) ? DEFAULT_QUERY_RECORDS : maxRecords
+    };
+
+    if (query.level == (le_log_Level_t)(-1))
+    {
+        snprintf(message, sizeof(message), "***ERROR: Invalid log level '%s'.", levelStr);
+        LE_WARN("%s", message);
+        SendToLogTool(ipcSessionRef, message);
+        return;
+    }
+
+    if (query.maxRecords > MAX_QUERY_RECORDS)
+    {
+        query.maxRecords = MAX_QUERY_RECORDS;
+    }
+
+    if (minutes > 0)
+    {
+        le_clk_Time_t now = le_clk_GetAbsoluteTime();
+        uint64_t nowMs = (uint64_t)now.sec * 1000 + now.usec / 1000;
+        uint64_t periodMs = (uint64_t)minutes * 60 * 1000;
+
+        query.sinceMs = (nowMs > periodMs) ? nowMs - periodMs : 0;
+    }
+
+    if (logStore_Query(&query, SendStoredRecordToLogTool, ipcSessionRef) != LE_OK)
+    {
+        SendToLogTool(ipcSessionRef, "***ERROR: The log store is not available.");
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Process a message received from a connected log session client.
@@ -2494,8 +2966,12 @@ static void ClientMsgReceiveHandler
             case LOG_CMD_SET_LEVEL:
             case LOG_CMD_ENABLE_TRACE:
             case LOG_CMD_DISABLE_TRACE:
+            case LOG_CMD_ENABLE_CALLSITE:
+            case LOG_CMD_DISABLE_CALLSITE:
             case LOG_CMD_LIST_COMPONENTS:
             case LOG_CMD_FORGET_PROCESS:
+            case LOG_CMD_LIST_FD_STATS:
+            case LOG_CMD_QUERY_STORE:
 
                 LE_ERROR("Client attempted to issue a log control command (%c)!", command);
 
@@ -2565,6 +3041,18 @@ static void ControlToolMsgReceiveHandler
 
                 break;
 
+            case LOG_CMD_ENABLE_CALLSITE:
+
+                SetCallSite(processName, componentName, commandDataPtr, true, ipcSessionRef);
+
+                break;
+
+            case LOG_CMD_DISABLE_CALLSITE:
+
+                SetCallSite(processName, componentName, commandDataPtr, false, ipcSessionRef);
+
+                break;
+
             case LOG_CMD_REG_COMPONENT:
 
                 LE_ERROR("Unexpected command '%c' from log control tool.", command);
@@ -2583,6 +3071,18 @@ static void ControlToolMsgReceiveHandler
 
                 break;
 
+            case LOG_CMD_LIST_FD_STATS:
+
+                GenerateFdStatsList(ipcSessionRef);
+
+                break;
+
+            case LOG_CMD_QUERY_STORE:
+
+                QueryLogStore(processName, commandDataPtr, ipcSessionRef);
+
+                break;
+
             default:
 
                 LE_ERROR("Unknown command byte '%c' received from log control tool.", command);
@@ -2597,6 +3097,184 @@ static void ControlToolMsgReceiveHandler
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Logs a line read from an fd, in a message of its own so that it is not cut or merged by syslog.
+ */
+//--------------------------------------------------------------------------------------------------
+static void LogFdLine
+(
+    FdLog_t* fdLogPtr,          ///< [IN] Fd log object the line was read from.
+    const char* linePtr,        ///< [IN] Line, not necessarily null-terminated.
+    size_t lineLen              ///< [IN] Length of the line, less than MAX_MSG_SIZE.
+)
+{
+    char msg[MAX_MSG_SIZE];
+
+    memcpy(msg, linePtr, lineLen);
+    msg[lineLen] = '\0';
+
+    // TODO: Don't log the app name for now so that it matches all the other log formats.  Add
+    //       the app name to all log messages at the same time.
+    log_LogGenericMsg(fdLogPtr->level, fdLogPtr->procName, fdLogPtr->pid, msg);
+    logStore_Append(fdLogPtr->level, fdLogPtr->appName, fdLogPtr->procName, fdLogPtr->pid,
+                    linePtr, lineLen);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the current time in milliseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t GetTimeMs
+(
+    void
+)
+{
+    le_clk_Time_t now = le_clk_GetRelativeTime();
+
+    return (uint64_t)now.sec * 1000 + now.usec / 1000;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Takes a token from the fd log object's token bucket, after adding the tokens earned since the
+ * last refill.
+ *
+ * @return
+ *      true if a line can be logged.
+ *      false if the line must be suppressed.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool TakeFdLogToken
+(
+    FdLog_t* fdLogPtr,          ///< [IN] Fd log object.
+    uint64_t nowMs              ///< [IN] Current time in milliseconds.
+)
+{
+    uint64_t newTokens = (nowMs - fdLogPtr->refillTimeMs) * FD_LOG_RATE_LINES_PER_SEC / 1000;
+
+    if (newTokens > 0)
+    {
+        if (fdLogPtr->tokens + newTokens >= FD_LOG_BURST_LINES)
+        {
+            fdLogPtr->tokens = FD_LOG_BURST_LINES;
+            fdLogPtr->refillTimeMs = nowMs;
+        }
+        else
+        {
+            // Only advance by the time the new tokens were earned in, to keep the fraction.
+            fdLogPtr->tokens += newTokens;
+            fdLogPtr->refillTimeMs += newTokens * 1000 / FD_LOG_RATE_LINES_PER_SEC;
+        }
+    }
+
+    if (fdLogPtr->tokens == 0)
+    {
+        return false;
+    }
+
+    fdLogPtr->tokens--;
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handles a line read from an fd, logging it if the rate limit allows it.
+ */
+//--------------------------------------------------------------------------------------------------
+static void HandleFdLogLine
+(
+    FdLog_t* fdLogPtr,          ///< [IN] Fd log object the line was read from.
+    const char* linePtr,        ///< [IN] Line, not null-terminated.
+    size_t lineLen,             ///< [IN] Length of the line.
+    uint64_t nowMs              ///< [IN] Current time in milliseconds.
+)
+{
+    if (!TakeFdLogToken(fdLogPtr, nowMs))
+    {
+        fdLogPtr->pendingSuppressed++;
+        fdLogPtr->stats.suppressed++;
+        return;
+    }
+
+    if (fdLogPtr->pendingSuppressed > 0)
+    {
+        char summary[64];
+        int len = snprintf(summary, sizeof(summary), "[%" PRIu32 " lines suppressed]",
+                           fdLogPtr->pendingSuppressed);
+
+        LogFdLine(fdLogPtr, summary, len);
+        fdLogPtr->pendingSuppressed = 0;
+    }
+
+    if (lineLen >= MAX_MSG_SIZE)
+    {
+        lineLen = MAX_MSG_SIZE - 1;
+        fdLogPtr->stats.truncated++;
+    }
+
+    LogFdLine(fdLogPtr, linePtr, lineLen);
+    fdLogPtr->stats.logged++;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handles the lines in the read buffer of an fd log object.  The incomplete line at the end of
+ * the buffer is kept for the next read, unless the buffer is full or the fd is being closed.
+ */
+//--------------------------------------------------------------------------------------------------
+static void HandleFdLogData
+(
+    FdLog_t* fdLogPtr,          ///< [IN] Fd log object.
+    bool isClosing              ///< [IN] true to handle the incomplete line too.
+)
+{
+    uint64_t nowMs = GetTimeMs();
+
+    char* linePtr = fdLogPtr->readBuf;
+    char* endPtr = fdLogPtr->readBuf + fdLogPtr->readLen;
+
+    while (linePtr < endPtr)
+    {
+        char* newlinePtr = memchr(linePtr, '\n', endPtr - linePtr);
+
+        if ( (newlinePtr == NULL) && !isClosing &&
+             ((linePtr != fdLogPtr->readBuf) || (fdLogPtr->readLen < sizeof(fdLogPtr->readBuf))) )
+        {
+            // Wait for the rest of the line.
+            break;
+        }
+
+        char* lineEndPtr = (newlinePtr != NULL) ? newlinePtr : endPtr;
+
+        if (fdLogPtr->isSkippingLine)
+        {
+            // End of a line that was already truncated.
+            fdLogPtr->isSkippingLine = (newlinePtr == NULL);
+        }
+        else
+        {
+            HandleFdLogLine(fdLogPtr, linePtr, lineEndPtr - linePtr, nowMs);
+
+            // A line that fills the whole buffer is cut, drop the rest of it.
+            fdLogPtr->isSkippingLine = (newlinePtr == NULL) && !isClosing;
+        }
+
+        linePtr = (newlinePtr != NULL) ? newlinePtr + 1 : endPtr;
+    }
+
+    // Keep the incomplete line.
+    fdLogPtr->readLen = endPtr - linePtr;
+    memmove(fdLogPtr->readBuf, linePtr, fdLogPtr->readLen);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Deletes the fd log object and monitor.  Closes the associated fd.
@@ -2608,6 +3286,22 @@ static void DeleteFdLog
     FdLog_t* fdLogPtr           ///< [IN] Fd log object to delete.
 )
 {
+    // Log the incomplete line and the count of the last suppressed lines.
+    HandleFdLogData(fdLogPtr, true);
+
+    if (fdLogPtr->pendingSuppressed > 0)
+    {
+        char summary[64];
+        int len = snprintf(summary, sizeof(summary), "[%" PRIu32 " lines suppressed]",
+                           fdLogPtr->pendingSuppressed);
+
+        LogFdLine(fdLogPtr, summary, len);
+    }
+
+    AddFdLogStats(&ClosedFdLogStats, &fdLogPtr->stats);
+
+    le_dls_Remove(&FdLogList, &fdLogPtr->link);
+
     // Delete the fd monitor.
     le_fdMonitor_Delete(fdLogPtr->monitorRef);
 
@@ -2634,14 +3328,14 @@ static void LogFdMessages
 
     if (events & POLLIN)
     {
-        // Read the data from the fd.
-        char msg[MAX_MSG_SIZE] = {'\0'};
-
-        int c;
+        // Read as much as fits after the incomplete line of the last read.
+        ssize_t c;
 
         do
         {
-            c = read(fd, msg, sizeof(msg));
+            c = read(fd,
+                     fdLogPtr->readBuf + fdLogPtr->readLen,
+                     sizeof(fdLogPtr->readBuf) - fdLogPtr->readLen);
         }
         while ( (c == -1) && (errno == EINTR) );
 
@@ -2651,12 +3345,12 @@ static void LogFdMessages
                      fdLogPtr->appName, fdLogPtr->procName, fdLogPtr->pid);
 
             DeleteFdLog(fd, fdLogPtr);
+            return;
         }
 
-        // Log the data.
-        // TODO: Don't log the app name for now so that it matches all the other log formats.  Add
-        //       the app name to all log messages at the same time.
-        log_LogGenericMsg(fdLogPtr->level, fdLogPtr->procName, fdLogPtr->pid, msg);
+        fdLogPtr->readLen += c;
+
+        HandleFdLogData(fdLogPtr, false);
     }
 
     if ( (events & POLLRDHUP) || (events & POLLERR) || (events & POLLHUP) )
@@ -2699,6 +3393,15 @@ static void CreateFdLogMonitor
 
     fdLogPtr->level = logLevel;
     fdLogPtr->pid = pid;
+    fdLogPtr->link = LE_DLS_LINK_INIT;
+    fdLogPtr->readLen = 0;
+    fdLogPtr->isSkippingLine = false;
+    fdLogPtr->tokens = FD_LOG_BURST_LINES;
+    fdLogPtr->refillTimeMs = GetTimeMs();
+    fdLogPtr->pendingSuppressed = 0;
+    memset(&fdLogPtr->stats, 0, sizeof(fdLogPtr->stats));
+
+    le_dls_Queue(&FdLogList, &fdLogPtr->link);
 
     // Create the fd monitor.
     fdLogPtr->monitorRef = le_fdMonitor_Create(monitorNamePtr, fd, LogFdMessages, 0);
@@ -2785,6 +3488,22 @@ void logFd_StdOut
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes the records of the log store kept in RAM to flash before exiting.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SigTermHandler
+(
+    int sigNum                  ///< [IN] Signal number.
+)
+{
+    logStore_Flush();
+
+    exit(EXIT_SUCCESS);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * The main function for the log daemon.  Listens for commands from process/components and log tools
@@ -2826,6 +3545,12 @@ COMPONENT_INIT
                                           ProcessIdHash,
                                           ProcessIdEquals);
 
+    // Load the index of the persistent log store, and save its last records when being stopped.
+    logStore_Init(LOG_STORE_DIR);
+
+    le_sig_Block(SIGTERM);
+    le_sig_SetEventHandler(SIGTERM, SigTermHandler);
+
     // Get a reference to the Log Control Protocol identification.
     le_msg_ProtocolRef_t protocolRef = le_msg_GetProtocolRef(LOG_CONTROL_PROTOCOL_ID,
                                                              LOG_MAX_CMD_PACKET_BYTES);
@@ -86,6 +86,8 @@
 #define LOG_CMD_SET_LEVEL               'l' // CommandData = level string (see below)
 #define LOG_CMD_ENABLE_TRACE            'e' // CommandData = keyword string
 #define LOG_CMD_DISABLE_TRACE           'd' // CommandData = keyword string
+#define LOG_CMD_ENABLE_CALLSITE         'E' // CommandData = "fileName" or "fileName:lineNumber"
+#define LOG_CMD_DISABLE_CALLSITE        'D' // CommandData = "fileName" or "fileName:lineNumber"
 
 
 //--------------------------------------------------------------------------------------------------
@@ -103,6 +105,8 @@
 //--------------------------------------------------------------------------------------------------
 #define LOG_CMD_LIST_COMPONENTS         'c' // No ProcessName, ComponentName, or CommandData
 #define LOG_CMD_FORGET_PROCESS          'x' // No ComponentName or CommandData
+#define LOG_CMD_LIST_FD_STATS           's' // No ProcessName, ComponentName, or CommandData
+#define LOG_CMD_QUERY_STORE             'q' // CommandData = "level minutes maxRecords appName"
 
 
 // =======================================================
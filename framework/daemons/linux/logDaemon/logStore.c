@@ -0,0 +1,1255 @@
+/** @file logStore.c
+ *
+ * Persistent log store of the Log Control Daemon.
+ *
+ * A segment file is a sequence of blocks.  Each block is a BlockHeader_t followed by the zlib
+ * compressed records.  A record is a fixed size header (time, PID, level and string lengths)
+ * followed by the app and process names and the message, without null terminators.
+ *
+ * The segment files are named after their sequence number, in hexadecimal, so the oldest segment
+ * is the one with the lowest number.  A block is written with a single write, so a power failure
+ * can only leave a partial block at the end of the newest segment.  It is cut off when the index
+ * is loaded.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "limit.h"
+#include "fileDescriptor.h"
+#include "logStore.h"
+#include <dirent.h>
+#include <sys/uio.h>
+#include <zlib.h>
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum size of the records of a block, before compression.
+ */
+//--------------------------------------------------------------------------------------------------
+#define BLOCK_BYTES                 (16 * 1024)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum size of the compressed records of a block.  zlib never expands its input by more than a
+ * few bytes per 16 kB.
+ */
+//--------------------------------------------------------------------------------------------------
+#define COMPRESSED_BLOCK_BYTES      (BLOCK_BYTES + 64)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum size of a segment file, and maximum number of segment files.  The oldest segment is
+ * deleted when a new one is started past the maximum, so the store never uses more than 2 MB of
+ * flash.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SEGMENT_BYTES               (256 * 1024)
+#define MAX_SEGMENTS                8
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum time, in seconds, the records stay in RAM before being written to flash.
+ */
+//--------------------------------------------------------------------------------------------------
+#define FLUSH_INTERVAL_SEC          300
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Records at this level or more severe are written to flash immediately.
+ */
+//--------------------------------------------------------------------------------------------------
+#define FLUSH_LEVEL                 LE_LOG_CRIT
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum length of a stored message.  Longer messages are truncated.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_MSG_LEN                 1023
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Block header magic number ("LSB2").  The blocks of older record layouts are discarded.
+ */
+//--------------------------------------------------------------------------------------------------
+#define BLOCK_MAGIC                 0x3242534C
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the name filter of a block, in 64-bit words.
+ */
+//--------------------------------------------------------------------------------------------------
+#define NAME_FILTER_WORDS           4
+#define NAME_FILTER_BITS            (NAME_FILTER_WORDS * 64)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record header layout.
+ */
+//--------------------------------------------------------------------------------------------------
+#define RECORD_TIME_OFFSET          0   // uint64_t, milliseconds since the Epoch.
+#define RECORD_PID_OFFSET           8   // int32_t
+#define RECORD_LEVEL_OFFSET         12  // uint8_t
+#define RECORD_APP_LEN_OFFSET       13  // uint8_t
+#define RECORD_PROC_LEN_OFFSET      14  // uint8_t
+#define RECORD_MSG_LEN_OFFSET       15  // uint16_t
+#define RECORD_HEADER_BYTES         17
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Block header, written before the compressed records of the block.  The headers of a segment are
+ * its index.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t magic;                             ///< BLOCK_MAGIC.
+    uint32_t compressedBytes;                   ///< Size of the compressed records.
+    uint32_t rawBytes;                          ///< Size of the records before compression.
+    uint32_t numRecords;                        ///< Number of records.
+    uint64_t firstTimeMs;                       ///< Time of the oldest record.
+    uint64_t lastTimeMs;                        ///< Time of the newest record.
+    uint64_t nameFilter[NAME_FILTER_WORDS];     ///< Bloom filter of the names in the records.
+    uint32_t levelMask;                         ///< Bit set for each level in the records.
+    uint32_t crc;                               ///< CRC32 of the compressed records and of the
+                                                ///  header up to this field.
+}
+BlockHeader_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Block index entry.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_sls_Link_t   link;           ///< Link in the segment's block list.
+    off_t           offset;         ///< Offset of the block header in the segment file.
+    BlockHeader_t   header;         ///< Copy of the block header.
+}
+Block_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Segment file.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_dls_Link_t   link;           ///< Link in the SegmentList.
+    uint32_t        seq;            ///< Sequence number, which gives the file name.
+    off_t           size;           ///< Size of the valid blocks.
+    le_sls_List_t   blockList;      ///< Index of the blocks, oldest first.
+}
+Segment_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Query being run, with its name filter and the newest matches found so far.
+ *
+ * The matches are copies of the records, kept in a ring of at most queryPtr->maxRecords slots:
+ * match number N is in slot N % maxRecords, so once the ring is full each match replaces the
+ * oldest one.  The ring is grown as matches are found, so a query with a large maxRecords only
+ * uses memory for the records it actually matches.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const logStore_Query_t*         queryPtr;           ///< Query.
+    uint64_t                        nameFilter[NAME_FILTER_WORDS]; ///< Bits of the query's names.
+    uint32_t                        levelMask;          ///< Levels matching the query.
+    size_t                          numMatches;         ///< Number of records matched so far.
+    uint8_t**                       ringPtr;            ///< Copies of the newest matches.
+    size_t                          ringSize;           ///< Number of slots of the ring.
+}
+Scan_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * true if the store is in use.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsEnabled = false;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Directory of the segment files.
+ */
+//--------------------------------------------------------------------------------------------------
+static char StoreDir[LIMIT_MAX_PATH_BYTES];
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Segments, oldest first, and their number.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_dls_List_t SegmentList = LE_DLS_LIST_INIT;
+static size_t NumSegments = 0;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * File descriptor of the newest segment, opened for appending, or -1.
+ */
+//--------------------------------------------------------------------------------------------------
+static int CurrentFd = -1;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pools of the segment and block objects.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t SegmentPoolRef;
+static le_mem_PoolRef_t BlockPoolRef;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Records not written to flash yet, and the header of the block they will be written in.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t PendingRecords[BLOCK_BYTES];
+static BlockHeader_t PendingHeader;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Buffers for compressing and decompressing blocks.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t CompressedBuf[COMPRESSED_BLOCK_BYTES];
+static uint8_t RawBuf[BLOCK_BYTES];
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Timer writing the pending records to flash.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_timer_Ref_t FlushTimer;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the path of a segment file.
+ */
+//--------------------------------------------------------------------------------------------------
+static void GetSegmentPath
+(
+    uint32_t seq,               ///< [IN] Sequence number of the segment.
+    char* pathPtr,              ///< [OUT] Path.
+    size_t pathSize             ///< [IN] Size of the path buffer.
+)
+{
+    LE_ASSERT(snprintf(pathPtr, pathSize, "%s/%08" PRIx32 ".seg", StoreDir, seq) < pathSize);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Computes the CRC of a block.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t ComputeBlockCrc
+(
+    const BlockHeader_t* headerPtr,     ///< [IN] Block header.
+    const uint8_t* dataPtr              ///< [IN] Compressed records.
+)
+{
+    uint32_t crc = le_crc_Crc32((uint8_t*)dataPtr, headerPtr->compressedBytes, LE_CRC_START_CRC32);
+
+    return le_crc_Crc32((uint8_t*)headerPtr, offsetof(BlockHeader_t, crc), crc);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets the bits of a name in a name filter.  The name type is hashed with the name so that an app
+ * and a process with the same name set different bits.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddToNameFilter
+(
+    uint64_t* filterPtr,        ///< [IN/OUT] Name filter.
+    char type,                  ///< [IN] Name type.
+    const char* namePtr,        ///< [IN] Name.
+    size_t nameLen              ///< [IN] Length of the name.
+)
+{
+    // FNV-1a.
+    uint32_t hash = 2166136261U;
+    size_t i;
+
+    hash = (hash ^ (uint8_t)type) * 16777619U;
+
+    for (i = 0; i < nameLen; i++)
+    {
+        hash = (hash ^ (uint8_t)namePtr[i]) * 16777619U;
+    }
+
+    uint32_t bit = hash % NAME_FILTER_BITS;
+    filterPtr[bit / 64] |= (uint64_t)1 << (bit % 64);
+
+    bit = (hash >> 16) % NAME_FILTER_BITS;
+    filterPtr[bit / 64] |= (uint64_t)1 << (bit % 64);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks whether a block can contain records matching the query being run.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool BlockMayMatch
+(
+    const Scan_t* scanPtr,              ///< [IN] Query being run.
+    const BlockHeader_t* headerPtr      ///< [IN] Block header.
+)
+{
+    if ( (headerPtr->numRecords == 0) ||
+         (headerPtr->lastTimeMs < scanPtr->queryPtr->sinceMs) ||
+         ((headerPtr->levelMask & scanPtr->levelMask) == 0) )
+    {
+        return false;
+    }
+
+    int i;
+
+    for (i = 0; i < NAME_FILTER_WORDS; i++)
+    {
+        if ((headerPtr->nameFilter[i] & scanPtr->nameFilter[i]) != scanPtr->nameFilter[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copies a name from a record.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CopyRecordString
+(
+    char* destPtr,              ///< [OUT] Null-terminated copy.
+    const uint8_t* srcPtr,      ///< [IN] String in the record.
+    size_t len                  ///< [IN] Length of the string, less than the copy's size.
+)
+{
+    memcpy(destPtr, srcPtr, len);
+    destPtr[len] = '\0';
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks whether a name of a record matches the query's name.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool NameMatches
+(
+    const char* queryNamePtr,   ///< [IN] Name of the query, NULL to match all names.
+    const char* namePtr         ///< [IN] Name of the record.
+)
+{
+    return (queryNamePtr == NULL) || (strcmp(queryNamePtr, namePtr) == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Keeps a copy of a record matching the query being run, replacing the oldest match once the ring
+ * is full.
+ */
+//--------------------------------------------------------------------------------------------------
+static void KeepMatch
+(
+    Scan_t* scanPtr,            ///< [IN/OUT] Query being run.
+    const uint8_t* recordPtr,   ///< [IN] Record.
+    size_t recordLen            ///< [IN] Size of the record.
+)
+{
+    size_t maxRecords = scanPtr->queryPtr->maxRecords;
+    size_t slot = scanPtr->numMatches % maxRecords;
+
+    if (slot >= scanPtr->ringSize)
+    {
+        size_t newSize = (scanPtr->ringSize == 0) ? 64 : scanPtr->ringSize * 2;
+
+        if (newSize > maxRecords)
+        {
+            newSize = maxRecords;
+        }
+
+        scanPtr->ringPtr = realloc(scanPtr->ringPtr, newSize * sizeof(*scanPtr->ringPtr));
+        LE_ASSERT(scanPtr->ringPtr != NULL);
+
+        memset(scanPtr->ringPtr + scanPtr->ringSize,
+               0,
+               (newSize - scanPtr->ringSize) * sizeof(*scanPtr->ringPtr));
+        scanPtr->ringSize = newSize;
+    }
+
+    scanPtr->ringPtr[slot] = realloc(scanPtr->ringPtr[slot], recordLen);
+    LE_ASSERT(scanPtr->ringPtr[slot] != NULL);
+
+    memcpy(scanPtr->ringPtr[slot], recordPtr, recordLen);
+    scanPtr->numMatches++;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gives a record kept by KeepMatch() to a query handler.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReportRecord
+(
+    const uint8_t* headerPtr,                   ///< [IN] Record, already checked by ScanRecords().
+    logStore_RecordHandlerFunc_t handlerFunc,   ///< [IN] Handler.
+    void* contextPtr                            ///< [IN] Context given to the handler.
+)
+{
+    uint64_t timeMs;
+    int32_t pid;
+    uint16_t msgLen;
+
+    memcpy(&timeMs, headerPtr + RECORD_TIME_OFFSET, sizeof(timeMs));
+    memcpy(&pid, headerPtr + RECORD_PID_OFFSET, sizeof(pid));
+    memcpy(&msgLen, headerPtr + RECORD_MSG_LEN_OFFSET, sizeof(msgLen));
+
+    size_t appLen = headerPtr[RECORD_APP_LEN_OFFSET];
+    size_t procLen = headerPtr[RECORD_PROC_LEN_OFFSET];
+
+    char appName[LIMIT_MAX_APP_NAME_BYTES];
+    char procName[LIMIT_MAX_PROCESS_NAME_BYTES];
+    char msg[MAX_MSG_LEN + 1];
+    const uint8_t* stringPtr = headerPtr + RECORD_HEADER_BYTES;
+
+    CopyRecordString(appName, stringPtr, appLen);
+    stringPtr += appLen;
+    CopyRecordString(procName, stringPtr, procLen);
+    stringPtr += procLen;
+    CopyRecordString(msg, stringPtr, msgLen);
+
+    logStore_Record_t record =
+    {
+        .timeMs = timeMs,
+        .level = headerPtr[RECORD_LEVEL_OFFSET],
+        .pid = pid,
+        .appNamePtr = appName,
+        .procNamePtr = procName,
+        .msgPtr = msg
+    };
+
+    handlerFunc(&record, contextPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Runs the query over the records of a block.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ScanRecords
+(
+    Scan_t* scanPtr,            ///< [IN/OUT] Query being run.
+    const uint8_t* recordsPtr,  ///< [IN] Records.
+    size_t size                 ///< [IN] Size of the records.
+)
+{
+    const logStore_Query_t* queryPtr = scanPtr->queryPtr;
+    size_t offset = 0;
+
+    while (offset + RECORD_HEADER_BYTES <= size)
+    {
+        const uint8_t* headerPtr = recordsPtr + offset;
+        uint64_t timeMs;
+        int32_t pid;
+        uint16_t msgLen;
+
+        memcpy(&timeMs, headerPtr + RECORD_TIME_OFFSET, sizeof(timeMs));
+        memcpy(&pid, headerPtr + RECORD_PID_OFFSET, sizeof(pid));
+        memcpy(&msgLen, headerPtr + RECORD_MSG_LEN_OFFSET, sizeof(msgLen));
+
+        uint8_t level = headerPtr[RECORD_LEVEL_OFFSET];
+        size_t appLen = headerPtr[RECORD_APP_LEN_OFFSET];
+        size_t procLen = headerPtr[RECORD_PROC_LEN_OFFSET];
+        size_t recordLen = RECORD_HEADER_BYTES + appLen + procLen + msgLen;
+
+        if ( (offset + recordLen > size) ||
+             (appLen > LIMIT_MAX_APP_NAME_LEN) ||
+             (procLen > LIMIT_MAX_PROCESS_NAME_LEN) ||
+             (msgLen > MAX_MSG_LEN) )
+        {
+            LE_ERROR("Corrupted log store record.");
+            return;
+        }
+
+        offset += recordLen;
+
+        if ( (timeMs < queryPtr->sinceMs) || (level < queryPtr->level) || (level > LE_LOG_EMERG) )
+        {
+            continue;
+        }
+
+        char appName[LIMIT_MAX_APP_NAME_BYTES];
+        char procName[LIMIT_MAX_PROCESS_NAME_BYTES];
+        const uint8_t* stringPtr = headerPtr + RECORD_HEADER_BYTES;
+
+        CopyRecordString(appName, stringPtr, appLen);
+        stringPtr += appLen;
+        CopyRecordString(procName, stringPtr, procLen);
+
+        if ( !NameMatches(queryPtr->appNamePtr, appName) ||
+             !NameMatches(queryPtr->procNamePtr, procName) )
+        {
+            continue;
+        }
+
+        KeepMatch(scanPtr, headerPtr, recordLen);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads, checks and decompresses a block into RawBuf.
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_FAULT if the block could not be read or is corrupted.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReadBlock
+(
+    int fd,                     ///< [IN] Segment file.
+    const Block_t* blockPtr     ///< [IN] Block.
+)
+{
+    const BlockHeader_t* headerPtr = &blockPtr->header;
+    ssize_t readBytes;
+
+    do
+    {
+        readBytes = pread(fd,
+                          CompressedBuf,
+                          headerPtr->compressedBytes,
+                          blockPtr->offset + sizeof(BlockHeader_t));
+    }
+    while ( (readBytes == -1) && (errno == EINTR) );
+
+    if (readBytes != headerPtr->compressedBytes)
+    {
+        LE_ERROR("Could not read log store block.  %m.");
+        return LE_FAULT;
+    }
+
+    if (ComputeBlockCrc(headerPtr, CompressedBuf) != headerPtr->crc)
+    {
+        LE_ERROR("Corrupted log store block.");
+        return LE_FAULT;
+    }
+
+    uLongf rawBytes = sizeof(RawBuf);
+
+    if ( (uncompress(RawBuf, &rawBytes, CompressedBuf, headerPtr->compressedBytes) != Z_OK) ||
+         (rawBytes != headerPtr->rawBytes) )
+    {
+        LE_ERROR("Could not decompress log store block.");
+        return LE_FAULT;
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Runs the query over the whole store, including the pending records.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ScanStore
+(
+    Scan_t* scanPtr             ///< [IN/OUT] Query being run.
+)
+{
+    scanPtr->numMatches = 0;
+
+    le_dls_Link_t* segLinkPtr = le_dls_Peek(&SegmentList);
+
+    while (segLinkPtr != NULL)
+    {
+        Segment_t* segPtr = CONTAINER_OF(segLinkPtr, Segment_t, link);
+        int fd = -1;
+
+        le_sls_Link_t* blockLinkPtr = le_sls_Peek(&segPtr->blockList);
+
+        while (blockLinkPtr != NULL)
+        {
+            Block_t* blockPtr = CONTAINER_OF(blockLinkPtr, Block_t, link);
+
+            if (BlockMayMatch(scanPtr, &blockPtr->header))
+            {
+                if (fd == -1)
+                {
+                    char path[LIMIT_MAX_PATH_BYTES];
+                    GetSegmentPath(segPtr->seq, path, sizeof(path));
+
+                    fd = open(path, O_RDONLY | O_CLOEXEC);
+
+                    if (fd == -1)
+                    {
+                        LE_ERROR("Could not open log store segment '%s'.  %m.", path);
+                        break;
+                    }
+                }
+
+                if (ReadBlock(fd, blockPtr) == LE_OK)
+                {
+                    ScanRecords(scanPtr, RawBuf, blockPtr->header.rawBytes);
+                }
+            }
+
+            blockLinkPtr = le_sls_PeekNext(&segPtr->blockList, blockLinkPtr);
+        }
+
+        if (fd != -1)
+        {
+            fd_Close(fd);
+        }
+
+        segLinkPtr = le_dls_PeekNext(&SegmentList, segLinkPtr);
+    }
+
+    if (BlockMayMatch(scanPtr, &PendingHeader))
+    {
+        ScanRecords(scanPtr, PendingRecords, PendingHeader.rawBytes);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Deletes the oldest segment.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DeleteOldestSegment
+(
+    void
+)
+{
+    le_dls_Link_t* linkPtr = le_dls_Pop(&SegmentList);
+    Segment_t* segPtr = CONTAINER_OF(linkPtr, Segment_t, link);
+
+    char path[LIMIT_MAX_PATH_BYTES];
+    GetSegmentPath(segPtr->seq, path, sizeof(path));
+
+    if ( (unlink(path) == -1) && (errno != ENOENT) )
+    {
+        LE_ERROR("Could not delete log store segment '%s'.  %m.", path);
+    }
+
+    le_sls_Link_t* blockLinkPtr;
+
+    while ((blockLinkPtr = le_sls_Pop(&segPtr->blockList)) != NULL)
+    {
+        le_mem_Release(CONTAINER_OF(blockLinkPtr, Block_t, link));
+    }
+
+    le_mem_Release(segPtr);
+    NumSegments--;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates a segment object and adds it to the list, ordered by sequence number.
+ */
+//--------------------------------------------------------------------------------------------------
+static Segment_t* AddSegment
+(
+    uint32_t seq                ///< [IN] Sequence number.
+)
+{
+    Segment_t* segPtr = le_mem_ForceAlloc(SegmentPoolRef);
+
+    segPtr->link = LE_DLS_LINK_INIT;
+    segPtr->seq = seq;
+    segPtr->size = 0;
+    segPtr->blockList = LE_SLS_LIST_INIT;
+
+    le_dls_Link_t* linkPtr = le_dls_PeekTail(&SegmentList);
+
+    while ( (linkPtr != NULL) && (CONTAINER_OF(linkPtr, Segment_t, link)->seq > seq) )
+    {
+        linkPtr = le_dls_PeekPrev(&SegmentList, linkPtr);
+    }
+
+    if (linkPtr == NULL)
+    {
+        le_dls_Stack(&SegmentList, &segPtr->link);
+    }
+    else
+    {
+        le_dls_AddAfter(&SegmentList, linkPtr, &segPtr->link);
+    }
+
+    NumSegments++;
+
+    return segPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds a block to the index of a segment.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddBlock
+(
+    Segment_t* segPtr,                  ///< [IN] Segment.
+    off_t offset,                       ///< [IN] Offset of the block header.
+    const BlockHeader_t* headerPtr      ///< [IN] Block header.
+)
+{
+    Block_t* blockPtr = le_mem_ForceAlloc(BlockPoolRef);
+
+    blockPtr->link = LE_SLS_LINK_INIT;
+    blockPtr->offset = offset;
+    blockPtr->header = *headerPtr;
+
+    le_sls_Queue(&segPtr->blockList, &blockPtr->link);
+
+    segPtr->size = offset + sizeof(BlockHeader_t) + headerPtr->compressedBytes;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Loads the index of a segment from its block headers.  A partial block left at the end of the
+ * file by a power failure is cut off.
+ */
+//--------------------------------------------------------------------------------------------------
+static void LoadSegmentIndex
+(
+    Segment_t* segPtr           ///< [IN] Segment.
+)
+{
+    char path[LIMIT_MAX_PATH_BYTES];
+    GetSegmentPath(segPtr->seq, path, sizeof(path));
+
+    int fd = open(path, O_RDWR | O_CLOEXEC);
+
+    if (fd == -1)
+    {
+        LE_ERROR("Could not open log store segment '%s'.  %m.", path);
+        return;
+    }
+
+    struct stat st;
+
+    if (fstat(fd, &st) == -1)
+    {
+        LE_ERROR("Could not stat log store segment '%s'.  %m.", path);
+        fd_Close(fd);
+        return;
+    }
+
+    off_t offset = 0;
+    BlockHeader_t header;
+
+    while (pread(fd, &header, sizeof(header), offset) == sizeof(header))
+    {
+        off_t end = offset + sizeof(header) + header.compressedBytes;
+
+        if ( (header.magic != BLOCK_MAGIC) ||
+             (header.compressedBytes > COMPRESSED_BLOCK_BYTES) ||
+             (header.rawBytes > BLOCK_BYTES) ||
+             (end > st.st_size) )
+        {
+            break;
+        }
+
+        // Only the last block can be partially written, check its content.
+        if (end == st.st_size)
+        {
+            if ( (pread(fd, CompressedBuf, header.compressedBytes, offset + sizeof(header))
+                  != header.compressedBytes) ||
+                 (ComputeBlockCrc(&header, CompressedBuf) != header.crc) )
+            {
+                break;
+            }
+        }
+
+        AddBlock(segPtr, offset, &header);
+        offset = end;
+    }
+
+    if (offset < st.st_size)
+    {
+        LE_WARN("Cutting log store segment '%s' at %jd bytes (was %jd).",
+                path, (intmax_t)offset, (intmax_t)st.st_size);
+
+        if (ftruncate(fd, offset) == -1)
+        {
+            LE_ERROR("Could not truncate log store segment '%s'.  %m.", path);
+        }
+    }
+
+    segPtr->size = offset;
+
+    fd_Close(fd);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Opens the newest segment for appending.
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_FAULT if the file could not be opened.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t OpenCurrentSegment
+(
+    bool isNew                  ///< [IN] true if the segment file must be created.
+)
+{
+    Segment_t* segPtr = CONTAINER_OF(le_dls_PeekTail(&SegmentList), Segment_t, link);
+
+    char path[LIMIT_MAX_PATH_BYTES];
+    GetSegmentPath(segPtr->seq, path, sizeof(path));
+
+    int flags = O_WRONLY | O_APPEND | O_CLOEXEC | (isNew ? (O_CREAT | O_TRUNC) : 0);
+
+    CurrentFd = open(path, flags, S_IRUSR | S_IWUSR);
+
+    if (CurrentFd == -1)
+    {
+        LE_ERROR("Could not open log store segment '%s'.  %m.", path);
+        return LE_FAULT;
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Starts a new segment, deleting the oldest one if there are too many.
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_FAULT if the file could not be created.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t StartSegment
+(
+    void
+)
+{
+    le_dls_Link_t* linkPtr = le_dls_PeekTail(&SegmentList);
+    uint32_t seq = (linkPtr == NULL) ? 0 : CONTAINER_OF(linkPtr, Segment_t, link)->seq + 1;
+
+    if (CurrentFd != -1)
+    {
+        fd_Close(CurrentFd);
+        CurrentFd = -1;
+    }
+
+    AddSegment(seq);
+
+    while (NumSegments > MAX_SEGMENTS)
+    {
+        DeleteOldestSegment();
+    }
+
+    return OpenCurrentSegment(true);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Appends a block to the current segment, starting a new segment if it does not fit.
+ */
+//--------------------------------------------------------------------------------------------------
+static void WriteBlock
+(
+    const BlockHeader_t* headerPtr,     ///< [IN] Block header.
+    const uint8_t* dataPtr              ///< [IN] Compressed records.
+)
+{
+    size_t blockBytes = sizeof(*headerPtr) + headerPtr->compressedBytes;
+    le_dls_Link_t* linkPtr = le_dls_PeekTail(&SegmentList);
+
+    if ( (linkPtr == NULL) ||
+         (CONTAINER_OF(linkPtr, Segment_t, link)->size + blockBytes > SEGMENT_BYTES) ||
+         (CurrentFd == -1) )
+    {
+        if (StartSegment() != LE_OK)
+        {
+            return;
+        }
+    }
+
+    Segment_t* segPtr = CONTAINER_OF(le_dls_PeekTail(&SegmentList), Segment_t, link);
+
+    struct iovec iov[2] =
+    {
+        { .iov_base = (void*)headerPtr, .iov_len = sizeof(*headerPtr) },
+        { .iov_base = (void*)dataPtr, .iov_len = headerPtr->compressedBytes }
+    };
+    ssize_t writeBytes;
+
+    do
+    {
+        writeBytes = writev(CurrentFd, iov, NUM_ARRAY_MEMBERS(iov));
+    }
+    while ( (writeBytes == -1) && (errno == EINTR) );
+
+    if (writeBytes != blockBytes)
+    {
+        LE_ERROR("Could not write log store block (%zd of %zu bytes).  %m.",
+                 writeBytes, blockBytes);
+
+        // Remove the partial block.
+        if (ftruncate(CurrentFd, segPtr->size) == -1)
+        {
+            LE_ERROR("Could not truncate log store segment.  %m.");
+        }
+
+        return;
+    }
+
+    if (fdatasync(CurrentFd) == -1)
+    {
+        LE_WARN("Could not sync log store segment.  %m.");
+    }
+
+    AddBlock(segPtr, segPtr->size, headerPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Empties the pending block.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ResetPendingBlock
+(
+    void
+)
+{
+    memset(&PendingHeader, 0, sizeof(PendingHeader));
+    PendingHeader.magic = BLOCK_MAGIC;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler of the flush timer.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FlushTimerHandler
+(
+    le_timer_Ref_t timerRef     ///< [IN] Flush timer.
+)
+{
+    logStore_Flush();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initializes the log store in a directory, loading the index of the segments already there.
+ * The store is disabled if the directory cannot be created.
+ */
+//--------------------------------------------------------------------------------------------------
+void logStore_Init
+(
+    const char* dirPathPtr          ///< [IN] Directory of the segment files.
+)
+{
+    SegmentPoolRef = le_mem_CreatePool("LogStoreSegment", sizeof(Segment_t));
+    BlockPoolRef = le_mem_CreatePool("LogStoreBlock", sizeof(Block_t));
+    le_mem_ExpandPool(SegmentPoolRef, MAX_SEGMENTS + 1);
+
+    ResetPendingBlock();
+
+    FlushTimer = le_timer_Create("LogStoreFlush");
+    le_clk_Time_t interval = { .sec = FLUSH_INTERVAL_SEC, .usec = 0 };
+    LE_ASSERT(le_timer_SetInterval(FlushTimer, interval) == LE_OK);
+    LE_ASSERT(le_timer_SetHandler(FlushTimer, FlushTimerHandler) == LE_OK);
+
+    if (le_utf8_Copy(StoreDir, dirPathPtr, sizeof(StoreDir), NULL) != LE_OK)
+    {
+        LE_ERROR("Log store path '%s' is too long.", dirPathPtr);
+        return;
+    }
+
+    if (le_dir_MakePath(StoreDir, S_IRWXU) != LE_OK)
+    {
+        LE_WARN("Could not create log store directory '%s'.  Log store disabled.", StoreDir);
+        return;
+    }
+
+    DIR* dirPtr = opendir(StoreDir);
+
+    if (dirPtr == NULL)
+    {
+        LE_WARN("Could not open log store directory '%s'.  %m.  Log store disabled.", StoreDir);
+        return;
+    }
+
+    struct dirent* entryPtr;
+
+    while ((entryPtr = readdir(dirPtr)) != NULL)
+    {
+        uint32_t seq;
+        int nameLen = 0;
+
+        if ( (sscanf(entryPtr->d_name, "%8" SCNx32 ".seg%n", &seq, &nameLen) == 1) &&
+             (nameLen == strlen(entryPtr->d_name)) )
+        {
+            AddSegment(seq);
+        }
+    }
+
+    closedir(dirPtr);
+
+    while (NumSegments > MAX_SEGMENTS)
+    {
+        DeleteOldestSegment();
+    }
+
+    le_dls_Link_t* linkPtr = le_dls_Peek(&SegmentList);
+
+    while (linkPtr != NULL)
+    {
+        LoadSegmentIndex(CONTAINER_OF(linkPtr, Segment_t, link));
+
+        linkPtr = le_dls_PeekNext(&SegmentList, linkPtr);
+    }
+
+    // Keep appending to the newest segment.  If it cannot be opened, a new one is started on the
+    // first write.
+    if (NumSegments > 0)
+    {
+        OpenCurrentSegment(false);
+    }
+
+    IsEnabled = true;
+
+    LE_INFO("Log store in '%s' has %zu segments.", StoreDir, NumSegments);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds a record to the store.  Names longer than the limits are truncated.
+ */
+//--------------------------------------------------------------------------------------------------
+void logStore_Append
+(
+    le_log_Level_t level,           ///< [IN] Severity level.
+    const char* appNamePtr,         ///< [IN] App name, empty for framework processes.
+    const char* procNamePtr,        ///< [IN] Process name.
+    pid_t pid,                      ///< [IN] PID of the process.
+    const char* msgPtr,             ///< [IN] Message, not necessarily null-terminated.
+    size_t msgLen                   ///< [IN] Length of the message.
+)
+{
+    if ( (!IsEnabled) || (level < LE_LOG_DEBUG) || (level > LE_LOG_EMERG) )
+    {
+        return;
+    }
+
+    size_t appLen = strnlen(appNamePtr, LIMIT_MAX_APP_NAME_LEN);
+    size_t procLen = strnlen(procNamePtr, LIMIT_MAX_PROCESS_NAME_LEN);
+    uint16_t storedMsgLen = (msgLen > MAX_MSG_LEN) ? MAX_MSG_LEN : msgLen;
+    size_t recordLen = RECORD_HEADER_BYTES + appLen + procLen + storedMsgLen;
+
+    if (PendingHeader.rawBytes + recordLen > sizeof(PendingRecords))
+    {
+        logStore_Flush();
+    }
+
+    le_clk_Time_t now = le_clk_GetAbsoluteTime();
+    uint64_t timeMs = (uint64_t)now.sec * 1000 + now.usec / 1000;
+    int32_t storedPid = pid;
+    uint8_t* recordPtr = PendingRecords + PendingHeader.rawBytes;
+
+    memcpy(recordPtr + RECORD_TIME_OFFSET, &timeMs, sizeof(timeMs));
+    memcpy(recordPtr + RECORD_PID_OFFSET, &storedPid, sizeof(storedPid));
+    recordPtr[RECORD_LEVEL_OFFSET] = level;
+    recordPtr[RECORD_APP_LEN_OFFSET] = appLen;
+    recordPtr[RECORD_PROC_LEN_OFFSET] = procLen;
+    memcpy(recordPtr + RECORD_MSG_LEN_OFFSET, &storedMsgLen, sizeof(storedMsgLen));
+
+    uint8_t* stringPtr = recordPtr + RECORD_HEADER_BYTES;
+    memcpy(stringPtr, appNamePtr, appLen);
+    stringPtr += appLen;
+    memcpy(stringPtr, procNamePtr, procLen);
+    stringPtr += procLen;
+    memcpy(stringPtr, msgPtr, storedMsgLen);
+
+    if (PendingHeader.numRecords == 0)
+    {
+        PendingHeader.firstTimeMs = timeMs;
+    }
+
+    PendingHeader.lastTimeMs = timeMs;
+    PendingHeader.rawBytes += recordLen;
+    PendingHeader.numRecords++;
+    PendingHeader.levelMask |= 1U << level;
+
+    if (appLen > 0)
+    {
+        AddToNameFilter(PendingHeader.nameFilter, 'a', appNamePtr, appLen);
+    }
+
+    AddToNameFilter(PendingHeader.nameFilter, 'p', procNamePtr, procLen);
+
+    if (level >= FLUSH_LEVEL)
+    {
+        logStore_Flush();
+    }
+    else if (!le_timer_IsRunning(FlushTimer))
+    {
+        le_timer_Start(FlushTimer);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes the records accumulated in RAM to the current segment.
+ */
+//--------------------------------------------------------------------------------------------------
+void logStore_Flush
+(
+    void
+)
+{
+    if ( (!IsEnabled) || (PendingHeader.numRecords == 0) )
+    {
+        return;
+    }
+
+    if (le_timer_IsRunning(FlushTimer))
+    {
+        le_timer_Stop(FlushTimer);
+    }
+
+    uLongf compressedBytes = sizeof(CompressedBuf);
+
+    if (compress2(CompressedBuf,
+                  &compressedBytes,
+                  PendingRecords,
+                  PendingHeader.rawBytes,
+                  Z_DEFAULT_COMPRESSION) != Z_OK)
+    {
+        LE_ERROR("Could not compress log store block.  %" PRIu32 " records lost.",
+                 PendingHeader.numRecords);
+    }
+    else
+    {
+        PendingHeader.compressedBytes = compressedBytes;
+        PendingHeader.crc = ComputeBlockCrc(&PendingHeader, CompressedBuf);
+
+        WriteBlock(&PendingHeader, CompressedBuf);
+    }
+
+    ResetPendingBlock();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reports the records matching a query, including the records not written to flash yet.
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_UNAVAILABLE if the store is disabled.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t logStore_Query
+(
+    const logStore_Query_t* queryPtr,           ///< [IN] Query.
+    logStore_RecordHandlerFunc_t handlerFunc,   ///< [IN] Handler called for each record.
+    void* contextPtr                            ///< [IN] Context given to the handler.
+)
+{
+    if (!IsEnabled)
+    {
+        return LE_UNAVAILABLE;
+    }
+
+    if (queryPtr->maxRecords == 0)
+    {
+        return LE_OK;
+    }
+
+    Scan_t scan =
+    {
+        .queryPtr = queryPtr,
+        .levelMask = ~((1U << queryPtr->level) - 1),
+        .numMatches = 0,
+        .ringPtr = NULL,
+        .ringSize = 0
+    };
+
+    if (queryPtr->appNamePtr != NULL)
+    {
+        AddToNameFilter(scan.nameFilter, 'a', queryPtr->appNamePtr, strlen(queryPtr->appNamePtr));
+    }
+
+    if (queryPtr->procNamePtr != NULL)
+    {
+        AddToNameFilter(scan.nameFilter, 'p', queryPtr->procNamePtr, strlen(queryPtr->procNamePtr));
+    }
+
+    ScanStore(&scan);
+
+    // Report the matches kept in the ring, from the oldest to the newest.
+    size_t numReported = (scan.numMatches < queryPtr->maxRecords) ? scan.numMatches :
+                                                                    queryPtr->maxRecords;
+    size_t i;
+
+    for (i = scan.numMatches - numReported; i < scan.numMatches; i++)
+    {
+        ReportRecord(scan.ringPtr[i % queryPtr->maxRecords], handlerFunc, contextPtr);
+    }
+
+    for (i = 0; i < scan.ringSize; i++)
+    {
+        free(scan.ringPtr[i]);
+    }
+
+    free(scan.ringPtr);
+
+    return LE_OK;
+}
@@ -0,0 +1,130 @@
+/** @file logStore.h
+ *
+ * Persistent log store of the Log Control Daemon.
+ *
+ * Log records are accumulated in a RAM block.  When the block is full, when the flush interval
+ * expires or when a critical record is added, the block is compressed and appended to the current
+ * segment file with a single write.  Segments are only ever appended to: when the current segment
+ * is full a new one is started and the oldest segment is deleted once the maximum number of
+ * segments is reached, so the flash space used is bounded and the writes are spread over the
+ * whole store.
+ *
+ * Only the lines that the log daemon reads from the standard output and standard error of the app
+ * processes are stored.  The messages of the Legato logging API go straight to syslog without
+ * passing through the daemon, so they are not in the store, and the records have no component
+ * name.
+ *
+ * Each block starts with a header giving its time range, the levels of its records and a filter
+ * of the app and process names in it.  The headers of all the blocks are kept in memory as the
+ * index of each segment, so a query only reads and decompresses the blocks that can contain
+ * matching records.  A query scans the store once, keeping copies of its newest matches.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#ifndef LOG_STORE_INCLUDE_GUARD
+#define LOG_STORE_INCLUDE_GUARD
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Log record, as given to the query handler.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint64_t        timeMs;         ///< Absolute time, in milliseconds since the Epoch.
+    le_log_Level_t  level;          ///< Severity level.
+    pid_t           pid;            ///< PID of the process.
+    const char*     appNamePtr;     ///< App name, empty for framework processes.
+    const char*     procNamePtr;    ///< Process name.
+    const char*     msgPtr;         ///< Message.
+}
+logStore_Record_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Query of the log store.  The name filters are NULL to match all the records.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const char*     appNamePtr;     ///< App name to match, or NULL.
+    const char*     procNamePtr;    ///< Process name to match, or NULL.
+    le_log_Level_t  level;          ///< Least severe level to match.
+    uint64_t        sinceMs;        ///< Oldest time to match, in milliseconds since the Epoch.
+    size_t          maxRecords;     ///< Maximum number of records, the newest are reported.
+}
+logStore_Query_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler called for each record matching a query, from the oldest to the newest.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef void (*logStore_RecordHandlerFunc_t)
+(
+    const logStore_Record_t* recordPtr,     ///< [IN] Record.  Only valid during the call.
+    void* contextPtr                        ///< [IN] Context given to logStore_Query().
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initializes the log store in a directory, loading the index of the segments already there.
+ * The store is disabled if the directory cannot be created.
+ */
+//--------------------------------------------------------------------------------------------------
+void logStore_Init
+(
+    const char* dirPathPtr          ///< [IN] Directory of the segment files.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds a record to the store.  Names longer than the limits are truncated.
+ */
+//--------------------------------------------------------------------------------------------------
+void logStore_Append
+(
+    le_log_Level_t level,           ///< [IN] Severity level.
+    const char* appNamePtr,         ///< [IN] App name, empty for framework processes.
+    const char* procNamePtr,        ///< [IN] Process name.
+    pid_t pid,                      ///< [IN] PID of the process.
+    const char* msgPtr,             ///< [IN] Message, not necessarily null-terminated.
+    size_t msgLen                   ///< [IN] Length of the message.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes the records accumulated in RAM to the current segment.
+ */
+//--------------------------------------------------------------------------------------------------
+void logStore_Flush
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reports the records matching a query, including the records not written to flash yet.
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_UNAVAILABLE if the store is disabled.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t logStore_Query
+(
+    const logStore_Query_t* queryPtr,           ///< [IN] Query.
+    logStore_RecordHandlerFunc_t handlerFunc,   ///< [IN] Handler called for each record.
+    void* contextPtr                            ///< [IN] Context given to the handler.
+);
+
+
+#endif // LOG_STORE_INCLUDE_GUARD
@@ -3261,14 +3261,17 @@ app_Ref_t app_Create
     }
 
     // Enable "notify_on_release" for this app, so the Supervisor will be notified when this app
-    // stops.
-    // Need to account for the characters other than app name in the path of notify_on_release.
-    char notifyPath[LIMIT_MAX_APP_NAME_BYTES + 41] = {0};
-    LE_ASSERT(snprintf(notifyPath, sizeof(notifyPath),
-                       "/sys/fs/cgroup/freezer/%s/notify_on_release", appPtr->name)
-              < sizeof(notifyPath));
-
-    file_WriteStr(notifyPath, "1", 0);
+    // stops.  In the unified hierarchy the app's cgroup events are monitored instead.
+    if (!cgrp_IsUnified())
+    {
+        // Need to account for the characters other than app name in the path of notify_on_release.
+        char notifyPath[LIMIT_MAX_APP_NAME_BYTES + 41] = {0};
+        LE_ASSERT(snprintf(notifyPath, sizeof(notifyPath),
+                           "/sys/fs/cgroup/freezer/%s/notify_on_release", appPtr->name)
+                  < sizeof(notifyPath));
+
+        file_WriteStr(notifyPath, "1", 0);
+    }
 
     le_cfg_CancelTxn(cfgIterator);
     return appPtr;
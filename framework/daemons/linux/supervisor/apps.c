@@ -71,6 +71,7 @@
 #include "properties.h"
 #include "smack.h"
 #include "cgroups.h"
+#include "resourceLimits.h"
 #include "file.h"
 #include "installer.h"
 
@@ -174,6 +175,9 @@ typedef struct AppContainer
                                           ///< this app. NULL if not connected client.
     le_appCtrl_TraceAttachHandlerFunc_t traceAttachHandler; ///< Client's trace attach handler.
     void* traceAttachContextPtr;          ///< Context for the client's trace attach handler.
+    le_appCtrl_PressureHandlerFunc_t pressureHandler; ///< Client's pressure handler.
+    void* pressureContextPtr;             ///< Context for the client's pressure handler.
+    le_appCtrl_AppRef_t pressureAppRef;   ///< Client's app reference given to the pressure handler.
     le_timer_Ref_t CheckAppStopTimer;     ///< Timer for waiting APP stop
     int AppStopTryCount;                  ///< Counter number for retrying to mark the stopped APP
 }
@@ -204,6 +208,14 @@ static le_ref_MapRef_t AppMap;
 static le_ref_MapRef_t AppAttachHandlerMap;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Safe reference map for application pressure handlers.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_ref_MapRef_t AppPressureHandlerMap;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * List of all active app containers.
@@ -630,6 +642,9 @@ static le_result_t CreateApp
     containerPtr->clientRef = NULL;
     containerPtr->traceAttachHandler = NULL;
     containerPtr->traceAttachContextPtr = NULL;
+    containerPtr->pressureHandler = NULL;
+    containerPtr->pressureContextPtr = NULL;
+    containerPtr->pressureAppRef = NULL;
     containerPtr->CheckAppStopTimer = NULL;
     containerPtr->AppStopTryCount = 0;
 
@@ -1133,6 +1148,32 @@ static void MarkAppAsStopped
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handles the exit of the last process of an app's cgroup.
+ */
+//--------------------------------------------------------------------------------------------------
+static void HandleAppRelease
+(
+    const char* appNamePtr      ///< [IN] Name of the app.
+)
+{
+    AppContainer_t* appContainerPtr = GetActiveApp(appNamePtr);
+    if (appContainerPtr == NULL)
+    {
+        // App may be missing in some fault cases when shutting down the system.
+        // App has already been cleaned up, so safe to ignore shutdown notification.
+        LE_WARN("Cannot find active app '%s'", appNamePtr);
+    }
+    else
+    {
+        app_Ref_t appRef = appContainerPtr->appRef;
+
+        MarkAppAsStopped(appRef, appContainerPtr);
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Handler function called when the last process has exited a freezer cgroup.
@@ -1157,19 +1198,7 @@ static void AppStopHandler
 
         if (numBytesRead > 0)
         {
-            AppContainer_t* appContainerPtr = GetActiveApp(appName);
-            if (appContainerPtr == NULL)
-            {
-                // App may be missing in some fault cases when shutting down the system.
-                // App has already been cleaned up, so safe to ignore shutdown notification.
-                LE_WARN("Cannot find active app '%s'", appName);
-            }
-            else
-            {
-                app_Ref_t appRef = appContainerPtr->appRef;
-
-                MarkAppAsStopped(appRef, appContainerPtr);
-            }
+            HandleAppRelease(appName);
         }
         else if (numBytesRead == 0)
         {
@@ -1183,6 +1212,60 @@ static void AppStopHandler
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler of the resource events of the apps' cgroups, in the unified hierarchy.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AppResourceEventHandler
+(
+    const char* appNamePtr,     ///< [IN] Name of the app.
+    cgrp_Event_t event          ///< [IN] Event.
+)
+{
+    le_appCtrl_Resource_t resource;
+    cgrp_Resource_t cgrpResource;
+
+    switch (event)
+    {
+        case CGRP_EVENT_EMPTY:
+            HandleAppRelease(appNamePtr);
+            return;
+
+        case CGRP_EVENT_CPU_PRESSURE:
+            resource = LE_APPCTRL_RESOURCE_CPU;
+            cgrpResource = CGRP_RESOURCE_CPU;
+            break;
+
+        case CGRP_EVENT_MEM_PRESSURE:
+            resource = LE_APPCTRL_RESOURCE_MEMORY;
+            cgrpResource = CGRP_RESOURCE_MEM;
+            break;
+
+        case CGRP_EVENT_IO_PRESSURE:
+            resource = LE_APPCTRL_RESOURCE_IO;
+            cgrpResource = CGRP_RESOURCE_IO;
+            break;
+
+        default:
+            return;
+    }
+
+    AppContainer_t* appContainerPtr = GetActiveApp(appNamePtr);
+
+    if ((appContainerPtr == NULL) || (appContainerPtr->pressureHandler == NULL))
+    {
+        return;
+    }
+
+    cgrp_Pressure_t pressure = {0};
+    cgrp_GetPressure(appNamePtr, cgrpResource, &pressure);
+
+    appContainerPtr->pressureHandler(appContainerPtr->pressureAppRef, resource, pressure.avg10,
+                                     appContainerPtr->pressureContextPtr);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Release an application reference.
@@ -1198,6 +1281,9 @@ static void ReleaseAppRef
     app_SetRunForAllProcs(appContainerPtr->appRef, true);
     app_RemoveAllLinks(appContainerPtr->appRef);
     app_SetBlockCallback(appContainerPtr->appRef, NULL, NULL);
+    appContainerPtr->pressureHandler = NULL;
+    appContainerPtr->pressureContextPtr = NULL;
+    appContainerPtr->pressureAppRef = NULL;
 
     // Remove the safe ref.
     le_ref_DeleteRef(AppMap, appSafeRef);
@@ -1281,6 +1367,9 @@ void apps_Init
     AppProcMap = le_ref_CreateMap("AppProcs", 5);
     AppMap = le_ref_CreateMap("App", 5);
     AppAttachHandlerMap = le_ref_CreateMap("AppAttachHandlers", 5);
+    AppPressureHandlerMap = le_ref_CreateMap("AppPressureHandlers", 5);
+
+    resLim_Init(AppResourceEventHandler);
 
     le_instStat_AddAppUninstallEventHandler(DeletesInactiveApp, NULL);
     le_instStat_AddAppInstallEventHandler(DeletesInactiveApp, NULL);
@@ -1295,9 +1384,13 @@ void apps_Init
                                                   AppStopHandler, POLLIN);
 
     // Specify the program to be run when the last process exits a freezer sub-group. This program
-    // notifies the Supervisor which app has stopped.
-    file_WriteStr("/sys/fs/cgroup/freezer/release_agent",
-                  "/legato/systems/current/bin/_appStopClient", 0);
+    // notifies the Supervisor which app has stopped.  The unified hierarchy has no release agent,
+    // the exit of the last process is reported by AppResourceEventHandler() instead.
+    if (!cgrp_IsUnified())
+    {
+        file_WriteStr("/sys/fs/cgroup/freezer/release_agent",
+                      "/legato/systems/current/bin/_appStopClient", 0);
+    }
 }
 
 
@@ -1975,6 +2068,79 @@ void le_appCtrl_RemoveTraceAttachHandler
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add handler function for EVENT 'le_appCtrl_Pressure'
+ *
+ * Event that indicates an app is under resource pressure.
+ */
+//--------------------------------------------------------------------------------------------------
+le_appCtrl_PressureHandlerRef_t le_appCtrl_AddPressureHandler
+(
+    le_appCtrl_AppRef_t appRef,
+        ///< [IN] Ref to the app.
+
+    le_appCtrl_PressureHandlerFunc_t handlerPtr,
+        ///< [IN]
+
+    void* contextPtr
+        ///< [IN]
+)
+{
+    AppContainer_t* appContainerPtr = le_ref_Lookup(AppMap, appRef);
+
+    if (appContainerPtr == NULL)
+    {
+        LE_KILL_CLIENT("Invalid application reference.");
+        return NULL;
+    }
+
+    // Check if a handler is already registered for this app.
+    if (appContainerPtr->pressureHandler != NULL)
+    {
+        LE_KILL_CLIENT("A pressure handler for %s is already registered.",
+                        app_GetName(appContainerPtr->appRef));
+        return NULL;
+    }
+
+    if (!cgrp_IsUnified())
+    {
+        LE_WARN("Resource pressure is only reported with the cgroup v2 unified hierarchy.");
+    }
+
+    // Store the client's handler and context pointer.
+    appContainerPtr->pressureHandler = handlerPtr;
+    appContainerPtr->pressureContextPtr = contextPtr;
+    appContainerPtr->pressureAppRef = appRef;
+
+    return le_ref_CreateRef(AppPressureHandlerMap, appContainerPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove handler function for EVENT 'le_appCtrl_Pressure'
+ */
+//--------------------------------------------------------------------------------------------------
+void le_appCtrl_RemovePressureHandler
+(
+    le_appCtrl_PressureHandlerRef_t handlerRef
+        ///< [IN]
+)
+{
+    AppContainer_t* appContainerPtr = le_ref_Lookup(AppPressureHandlerMap, handlerRef);
+
+    if (appContainerPtr != NULL)
+    {
+        le_ref_DeleteRef(AppPressureHandlerMap, handlerRef);
+
+        appContainerPtr->pressureHandler = NULL;
+        appContainerPtr->pressureContextPtr = NULL;
+        appContainerPtr->pressureAppRef = NULL;
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Unblocks the traced process.  This should normally be done once the tracer has successfully
@@ -3,9 +3,15 @@
  *
  * API for managing Legato-bundled kernel modules.
  *
+ * Modules are loaded with finit_module(), or insmod if the kernel does not provide it.  At start-up
+ * the dependency graph of the modules to load is computed once, and the modules whose required
+ * modules are loaded are loaded in parallel by a pool of worker threads.  The load time of each
+ * module is logged.
+ *
  * Copyright (C) Sierra Wireless Inc.
  */
 #include "legato.h"
+#include <sys/syscall.h>
 #include "limit.h"
 #include "fileDescriptor.h"
 #include "smack.h"
@@ -31,6 +37,14 @@
 #define KMODULE_MAX_ARGC 256
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of threads loading kernel modules in parallel at start-up.
+ */
+//--------------------------------------------------------------------------------------------------
+#define KMODULE_MAX_LOAD_THREADS 4
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Maximum parameter string buffer size in the form of "<name>=<value>\0".
@@ -112,6 +126,9 @@ typedef struct
                                                              // traversing to detect cycle
     bool               recurStack;                           // Track recursion stack while
                                                              // traversing to detect cycle
+    le_dls_Link_t      loadLink;                             // link object for parallel load
+    size_t             pendingDepCount;                      // Required modules not loaded yet
+    uint32_t           loadTimeMs;                           // Time taken to load the module
 }
 KModuleObj_t;
 
@@ -145,6 +162,23 @@ static le_dls_List_t ModuleAlphaOrderList = LE_DLS_LIST_INIT;
 static le_sls_List_t CyclicDependencyList = LE_SLS_LIST_INIT;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * State of the parallel loading of the modules at start-up.  The lists and counters are protected
+ * by the mutex.
+ */
+//--------------------------------------------------------------------------------------------------
+static struct {
+    le_dls_List_t  pendingList;     // Modules waiting for their required modules (loadLink)
+    le_dls_List_t  readyList;       // Modules ready to be loaded (loadLink)
+    size_t         remainingCount;  // Modules not loaded yet
+    le_result_t    result;          // LE_FAULT once a non-optional module failed to load
+    size_t         threadCount;     // Number of worker threads
+    le_mutex_Ref_t mutex;           // Mutex protecting this structure
+    le_sem_Ref_t   readySem;        // Posted for each ready module, and for each worker at the end
+} ParallelLoad = { LE_DLS_LIST_INIT, LE_DLS_LIST_INIT, 0, LE_OK, 0, NULL, NULL };
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Free list of module parameters starting from argv[2]
@@ -755,6 +789,9 @@ static void ModuleInsert(char *modName)
     m->isCyclicDependency = false;
     m->visited = false;
     m->recurStack = false;
+    m->loadLink = LE_DLS_LINK_INIT;
+    m->pendingDepCount = 0;
+    m->loadTimeMs = 0;
 
     ModuleGetLoad(m);            /* Read load from configTree */
     ModuleGetIsOptional(m);      /* Read if the module is optional from configTree */
@@ -848,6 +885,140 @@ static le_result_t TraverseDependencyInsert
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Load a module with finit_module(), passing its parameters the way insmod does.  Execute insmod
+ * if the kernel does not provide finit_module().
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t InitModule(KModuleObj_t *mod)
+{
+#ifdef SYS_finit_module
+    size_t len = 0;
+    int i;
+
+    /* Parameters are separated by spaces in a single string */
+    for (i = 2; i < mod->argc; i++)
+    {
+        len += strlen(mod->argv[i]) + 1;
+    }
+
+    char params[len + 1];
+    char *p = params;
+
+    for (i = 2; i < mod->argc; i++)
+    {
+        size_t paramLen = strlen(mod->argv[i]);
+
+        if (p != params)
+        {
+            *p++ = ' ';
+        }
+        memcpy(p, mod->argv[i], paramLen);
+        p += paramLen;
+    }
+    *p = '\0';
+
+    int fd = open(mod->path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        LE_CRIT("Failed to open module '%s'. %m", mod->path);
+        return LE_FAULT;
+    }
+
+    LE_INFO("Load '%s'", mod->path);
+
+    int rc = syscall(SYS_finit_module, fd, params, 0);
+    int err = errno;
+
+    fd_Close(fd);
+
+    if (rc == 0)
+    {
+        return LE_OK;
+    }
+    if (err == EEXIST)
+    {
+        LE_INFO("Module '%s' is already loaded.", mod->name);
+        return LE_OK;
+    }
+    if (err != ENOSYS)
+    {
+        errno = err;
+        LE_CRIT("Failed to load module '%s'. %m", mod->name);
+        return LE_FAULT;
+    }
+
+    LE_INFO("finit_module() is not supported, falling back to " INSMOD_COMMAND);
+#endif
+
+    mod->argv[0] = INSMOD_COMMAND;
+    return ExecuteCommand(mod->argv, mod->argc);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Load a module by its install script, or by finit_module() if it has none, and record its load
+ * time.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t LoadModule(KModuleObj_t *mod)
+{
+    le_result_t result;
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+
+    /* If install script is provided, execute the script otherwise load the module */
+    if (strcmp(mod->installScript, "") != 0)
+    {
+        char *scriptargv[3];
+
+        scriptargv[0] =  mod->installScript;
+        scriptargv[1] =  mod->path;
+        scriptargv[2] =  NULL;
+
+        result = ExecuteCommand(scriptargv, 2);
+        if (result != LE_OK)
+        {
+            LE_CRIT("Install script '%s' execution failed", mod->installScript);
+            return result;
+        }
+
+        /* Read module load status from /proc/modules */
+        if (CheckProcModules(mod->name) != STATUS_INSTALLED)
+        {
+            /* If the module is not in live state, wait for 10 seconds to see if the module
+             * recovers to live state.
+             */
+            LE_INFO("Module '%s' not in 'Live' state, wait for 10 seconds.", mod->name);
+            sleep(10);
+
+            if (CheckProcModules(mod->name) != STATUS_INSTALLED)
+            {
+                LE_CRIT("Module '%s' not in 'Live' state.", mod->name);
+                return LE_FAULT;
+            }
+        }
+    }
+    else
+    {
+        result = InitModule(mod);
+        if (result != LE_OK)
+        {
+            return result;
+        }
+    }
+
+    le_clk_Time_t loadTime = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+
+    mod->loadTimeMs = loadTime.sec * 1000 + loadTime.usec / 1000;
+    mod->moduleLoadStatus = STATUS_INSTALLED;
+    LE_INFO("New kernel module '%s' (%" PRIu32 " ms)", mod->name, mod->loadTimeMs);
+
+    return LE_OK;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * insmod the kernel module
@@ -860,9 +1031,6 @@ static le_result_t InstallEachKernelModule(KModuleObj_t *m, bool enableUseCount)
     /* The ordered list of required kernel modules to install */
     le_dls_List_t ModuleInsertList = LE_DLS_LIST_INIT;
 
-    ModuleLoadStatus_t loadStatusProcMod;
-    char *scriptargv[3];
-
     result = TraverseDependencyInsert(&ModuleInsertList, m, enableUseCount);
     if (result != LE_OK)
     {
@@ -887,69 +1055,17 @@ static le_result_t InstallEachKernelModule(KModuleObj_t *m, bool enableUseCount)
 
         if (mod->moduleLoadStatus != STATUS_INSTALLED)
         {
-            /* If install script is provided, execute the script otherwise execute insmod */
-            if (strcmp(mod->installScript, "") != 0)
-            {
-                scriptargv[0] =  mod->installScript;
-                scriptargv[1] =  mod->path;
-                scriptargv[2] =  NULL;
-
-                result = ExecuteCommand(scriptargv, 2);
-                if (result != LE_OK)
-                {
-                    LE_CRIT("Install script '%s' execution failed", mod->installScript);
-
-                    if (mod->isOptional)
-                    {
-                        continue;
-                    }
-                    return result;
-                }
-
-                /* Read module load status from /proc/modules */
-                loadStatusProcMod =  CheckProcModules(mod->name);
-                if (loadStatusProcMod != STATUS_INSTALLED)
-                {
-                    LE_INFO("Module '%s' not in 'Live' state, wait for 10 seconds.", mod->name);
-                    sleep(10);
-
-                    /* If the module is not in live state, wait for 10 seconds to see if the
-                     * module recovers to live state, otherwise restart the system.
-                     */
-                    if (loadStatusProcMod != STATUS_INSTALLED)
-                    {
-                        if (mod->isOptional)
-                        {
-                            LE_INFO(
-                                "Module '%s' not in 'Live' state and is optional. "
-                                "Skip restarting system.",
-                                mod->name);
-                            continue;
-                        }
-
-                        LE_CRIT("Module '%s' not in 'Live' state. Restart system ...", mod->name);
-                        return LE_FAULT;
-                    }
-                }
-            }
-            else
+            result = LoadModule(mod);
+            if (result != LE_OK)
             {
-                mod->argv[0] = INSMOD_COMMAND;
-                result = ExecuteCommand(mod->argv, mod->argc);
-                if (result != LE_OK)
+                if (mod->isOptional)
                 {
-                    if (mod->isOptional)
-                    {
-                        LE_INFO("Ignoring failure. "
-                                 "Module '%s' failed to load and is an optional module.", mod->name);
-                        continue;
-                    }
-                    return result;
+                    LE_INFO("Ignoring failure. "
+                             "Module '%s' failed to load and is an optional module.", mod->name);
+                    continue;
                 }
+                return result;
             }
-
-            mod->moduleLoadStatus = STATUS_INSTALLED;
-            LE_INFO("New kernel module '%s'", mod->name);
         }
     }
     return LE_OK;
@@ -1041,14 +1157,200 @@ static void setIsRequiredModule()
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Iterate through the module table and install kernel module
+ * Get the number of times a module lists another module as required.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t CountRequired(KModuleObj_t *modPtr, const char *reqNamePtr)
+{
+    size_t count = 0;
+    le_sls_Link_t* modNameLinkPtr = le_sls_Peek(&(modPtr->reqModuleName));
+
+    while (modNameLinkPtr != NULL)
+    {
+        ModNameNode_t* modNameNodePtr = CONTAINER_OF(modNameLinkPtr, ModNameNode_t, link);
+
+        if (strcmp(modNameNodePtr->modName, reqNamePtr) == 0)
+        {
+            count++;
+        }
+
+        modNameLinkPtr = le_sls_PeekNext(&(modPtr->reqModuleName), modNameLinkPtr);
+    }
+
+    return count;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move the pending modules that no longer wait for any required module to the ready list.
+ *
+ * @return Number of modules made ready.
+ *
+ * @note Must be called with the parallel load mutex locked, or before the workers are started.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t QueueReadyModules(void)
+{
+    size_t count = 0;
+    le_dls_Link_t* linkPtr = le_dls_Peek(&ParallelLoad.pendingList);
+
+    while (linkPtr != NULL)
+    {
+        KModuleObj_t *modPtr = CONTAINER_OF(linkPtr, KModuleObj_t, loadLink);
+
+        linkPtr = le_dls_PeekNext(&ParallelLoad.pendingList, linkPtr);
+
+        if (modPtr->pendingDepCount == 0)
+        {
+            le_dls_Remove(&ParallelLoad.pendingList, &(modPtr->loadLink));
+            le_dls_Queue(&ParallelLoad.readyList, &(modPtr->loadLink));
+            count++;
+        }
+    }
+
+    return count;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Worker thread loading the ready modules until all the modules are loaded or one failed.
+ */
+//--------------------------------------------------------------------------------------------------
+static void *LoadWorker(void *contextPtr)
+{
+    for (;;)
+    {
+        le_dls_Link_t *linkPtr = NULL;
+
+        le_sem_Wait(ParallelLoad.readySem);
+
+        le_mutex_Lock(ParallelLoad.mutex);
+        if (ParallelLoad.result == LE_OK)
+        {
+            linkPtr = le_dls_Pop(&ParallelLoad.readyList);
+        }
+        le_mutex_Unlock(ParallelLoad.mutex);
+
+        if (linkPtr == NULL)
+        {
+            /* Loading is over */
+            return NULL;
+        }
+
+        KModuleObj_t *mod = CONTAINER_OF(linkPtr, KModuleObj_t, loadLink);
+        le_result_t result = LoadModule(mod);
+        size_t readyCount = 0;
+        size_t i;
+
+        le_mutex_Lock(ParallelLoad.mutex);
+
+        if (result != LE_OK)
+        {
+            if (mod->isOptional)
+            {
+                LE_INFO("Ignoring failure. "
+                         "Module '%s' failed to load and is an optional module.", mod->name);
+            }
+            else
+            {
+                LE_ERROR("Error in installing module %s.", mod->name);
+                ParallelLoad.result = LE_FAULT;
+            }
+        }
+
+        /* The modules requiring this one may now be ready. As for sequential loading, the failure
+         * of an optional module does not prevent loading the modules requiring it.
+         */
+        linkPtr = le_dls_Peek(&ParallelLoad.pendingList);
+        while (linkPtr != NULL)
+        {
+            KModuleObj_t *pendingPtr = CONTAINER_OF(linkPtr, KModuleObj_t, loadLink);
+
+            pendingPtr->pendingDepCount -= CountRequired(pendingPtr, mod->name);
+            linkPtr = le_dls_PeekNext(&ParallelLoad.pendingList, linkPtr);
+        }
+        readyCount = QueueReadyModules();
+
+        ParallelLoad.remainingCount--;
+        if ((ParallelLoad.remainingCount == 0) || (ParallelLoad.result != LE_OK))
+        {
+            /* Wake up all the workers to stop them */
+            readyCount = ParallelLoad.threadCount;
+        }
+
+        le_mutex_Unlock(ParallelLoad.mutex);
+
+        for (i = 0; i < readyCount; i++)
+        {
+            le_sem_Post(ParallelLoad.readySem);
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Collect a module and the modules it requires in the list of modules to load.
+ *
+ * @return
+ *      - LE_OK if the module can be loaded, or if it is optional and cannot.
+ *      - LE_FAULT if the dependencies of a non-optional module could not be resolved.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t CollectModule(KModuleObj_t *modPtr)
+{
+    le_dls_List_t moduleInsertList = LE_DLS_LIST_INIT;
+    le_dls_Link_t *listLink;
+    le_result_t result = TraverseDependencyInsert(&moduleInsertList, modPtr, true);
+
+    while ((listLink = le_dls_Pop(&moduleInsertList)) != NULL)
+    {
+        KModuleObj_t *mod = CONTAINER_OF(listLink, KModuleObj_t, dependencyLink);
+
+        if ((result == LE_OK) &&
+            (mod->moduleLoadStatus != STATUS_INSTALLED) &&
+            !le_dls_IsInList(&ParallelLoad.pendingList, &(mod->loadLink)))
+        {
+            le_dls_Queue(&ParallelLoad.pendingList, &(mod->loadLink));
+            ParallelLoad.remainingCount++;
+        }
+    }
+
+    if (result != LE_OK)
+    {
+        /* If the module is marked optional, ignore fault, otherwise take fault action. */
+        if (modPtr->isOptional)
+        {
+            LE_WARN("Traversing module '%s' dependencies failed, ignore as module is optional",
+                    modPtr->name);
+            return LE_OK;
+        }
+
+        LE_ERROR("Traversing module '%s' dependencies failed, fault action will be taken",
+                 modPtr->name);
+    }
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Iterate through the module table and install kernel modules.
+ *
+ * The dependency graph of the modules is computed once, then the modules are loaded by worker
+ * threads, each module as soon as the modules it requires are loaded.
  */
 //--------------------------------------------------------------------------------------------------
 static void installModules()
 {
     KModuleObj_t *modPtr;
-    le_result_t result;
     le_dls_Link_t* linkPtr;
+    le_thread_Ref_t threads[KMODULE_MAX_LOAD_THREADS];
+    char threadName[LIMIT_MAX_THREAD_NAME_BYTES];
+    size_t i;
 
     /* Traverse linked list in alphabetical order of module name and traverse dependencies. */
     linkPtr = le_dls_Peek(&ModuleAlphaOrderList);
@@ -1058,26 +1360,102 @@ static void installModules()
         LE_ASSERT(modPtr != NULL);
 
         /*
-         * Skip if the modules are loaded manually via app or if it is a required module.
-         * If the module is load manual, it will be loaded when app starts.
-         * If the module is a required module, it will be loaded with its parent module.
+         * Skip if the modules are loaded manually via app.  If the module is load manual, it will
+         * be loaded when app starts.
          */
-        if (modPtr->isLoadManual)
-        {
-            linkPtr = le_dls_PeekNext(&ModuleAlphaOrderList, linkPtr);
-            continue;
-        }
-
-        result = InstallEachKernelModule(modPtr, true);
-        if (result != LE_OK)
+        if ((!modPtr->isLoadManual) && (CollectModule(modPtr) != LE_OK))
         {
             LE_ERROR("Error in installing module %s. Restarting system ...", modPtr->name);
             framework_Reboot();
-            break;
+            return;
         }
 
         linkPtr = le_dls_PeekNext(&ModuleAlphaOrderList, linkPtr);
     }
+
+    if (ParallelLoad.remainingCount == 0)
+    {
+        return;
+    }
+
+    /* Count the required modules each module waits for */
+    linkPtr = le_dls_Peek(&ParallelLoad.pendingList);
+    while (linkPtr != NULL)
+    {
+        modPtr = CONTAINER_OF(linkPtr, KModuleObj_t, loadLink);
+
+        le_sls_Link_t* modNameLinkPtr = le_sls_Peek(&(modPtr->reqModuleName));
+        while (modNameLinkPtr != NULL)
+        {
+            ModNameNode_t* modNameNodePtr = CONTAINER_OF(modNameLinkPtr, ModNameNode_t, link);
+            KModuleObj_t* reqModPtr = le_hashmap_Get(KModuleHandler.moduleTable,
+                                                     modNameNodePtr->modName);
+
+            if ((reqModPtr != NULL) && (reqModPtr->moduleLoadStatus != STATUS_INSTALLED))
+            {
+                modPtr->pendingDepCount++;
+            }
+
+            modNameLinkPtr = le_sls_PeekNext(&(modPtr->reqModuleName), modNameLinkPtr);
+        }
+
+        linkPtr = le_dls_PeekNext(&ParallelLoad.pendingList, linkPtr);
+    }
+
+    size_t readyCount = QueueReadyModules();
+    LE_ASSERT(readyCount > 0);
+
+    long cpuCount = sysconf(_SC_NPROCESSORS_ONLN);
+
+    ParallelLoad.threadCount = (cpuCount > 0) ? cpuCount : 1;
+    if (ParallelLoad.threadCount > KMODULE_MAX_LOAD_THREADS)
+    {
+        ParallelLoad.threadCount = KMODULE_MAX_LOAD_THREADS;
+    }
+    if (ParallelLoad.threadCount > ParallelLoad.remainingCount)
+    {
+        ParallelLoad.threadCount = ParallelLoad.remainingCount;
+    }
+
+    size_t moduleCount = ParallelLoad.remainingCount;
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+
+    ParallelLoad.result = LE_OK;
+    ParallelLoad.mutex = le_mutex_CreateNonRecursive("KModuleLoad");
+    ParallelLoad.readySem = le_sem_Create("KModuleReady", readyCount);
+
+    for (i = 0; i < ParallelLoad.threadCount; i++)
+    {
+        snprintf(threadName, sizeof(threadName), "KModuleLoad%zu", i);
+        threads[i] = le_thread_Create(threadName, LoadWorker, NULL);
+        le_thread_SetJoinable(threads[i]);
+        le_thread_Start(threads[i]);
+    }
+
+    for (i = 0; i < ParallelLoad.threadCount; i++)
+    {
+        le_thread_Join(threads[i], NULL);
+    }
+
+    le_sem_Delete(ParallelLoad.readySem);
+    le_mutex_Delete(ParallelLoad.mutex);
+
+    /* Modules left over after a failure stay in the try state */
+    while (le_dls_Pop(&ParallelLoad.pendingList) != NULL);
+    while (le_dls_Pop(&ParallelLoad.readyList) != NULL);
+    ParallelLoad.remainingCount = 0;
+
+    le_clk_Time_t loadTime = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+
+    LE_INFO("Kernel module loading took %u ms (%zu modules, %zu threads)",
+            (unsigned int)(loadTime.sec * 1000 + loadTime.usec / 1000),
+            moduleCount, ParallelLoad.threadCount);
+
+    if (ParallelLoad.result != LE_OK)
+    {
+        LE_ERROR("Error in installing modules. Restarting system ...");
+        framework_Reboot();
+    }
 }
 
 
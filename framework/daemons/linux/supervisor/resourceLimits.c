@@ -132,6 +132,17 @@
 #define CFG_NODE_LIMIT_MAX_FILE_DESCRIPTORS             "maxFileDescriptors"
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * The name of the node in the config tree that is true if an application's memory may be throttled
+ * while the system is under memory pressure.
+ *
+ * If this entry in the config tree is missing or is empty, the app is not throttled.
+ */
+//--------------------------------------------------------------------------------------------------
+#define CFG_NODE_MEMORY_THROTTLE                        "memoryThrottle"
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Resource limit defaults.
@@ -161,6 +172,96 @@
 #define MAX_LIMIT_FILE_DESCRIPTORS                      1024
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Share of the memory limit above which the allocations of an app are throttled, in the unified
+ * hierarchy.  The high limit is set to the memory limit minus this fraction of it.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MEM_HIGH_LIMIT_MARGIN_DIVISOR                   8
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pressure trigger of the apps: an app is reported under pressure when some of its tasks stalled
+ * on a resource for 10% of the window.  The window is a multiple of 2 s so that the trigger does
+ * not need the CAP_SYS_RESOURCE capability.
+ */
+//--------------------------------------------------------------------------------------------------
+#define APP_PRESSURE_STALL_US                           200000
+#define APP_PRESSURE_WINDOW_US                          2000000
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pressure trigger of the system memory: the apps which allow it are throttled when some of the
+ * tasks of the system stalled on memory for 15% of the window.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SYSTEM_PRESSURE_STALL_US                        300000
+#define SYSTEM_PRESSURE_WINDOW_US                       2000000
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Period at which the system memory pressure is checked while the apps are throttled, and the
+ * 10 s average (in hundredths of a percent) below which the apps stop being throttled.
+ */
+//--------------------------------------------------------------------------------------------------
+#define THROTTLE_CHECK_INTERVAL_MS                      10000
+#define THROTTLE_RELEASE_AVG10                          500
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Estimated maximum number of apps, for the app cgroup map.
+ */
+//--------------------------------------------------------------------------------------------------
+#define EST_MAX_NUM_APPS                                31
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Cgroup of an app in the unified hierarchy, with the monitors of its resource events.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    char                appName[LIMIT_MAX_APP_NAME_BYTES];  ///< App name, also the cgroup name.
+    size_t              memHighLimit;       ///< Configured memory high limit, in kilobytes.
+    bool                memoryThrottle;     ///< Throttled while the system is under pressure.
+    cgrp_MonitorRef_t   emptyMonitor;       ///< Monitor of the exit of the last process.
+    cgrp_MonitorRef_t   memEventsMonitor;   ///< Monitor of the memory limit events.
+    cgrp_MonitorRef_t   pressureMonitors[CGRP_NUM_RESOURCES];  ///< Pressure triggers.
+}
+AppCgroup_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool and map of the app cgroups, by app name.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t AppCgroupPool;
+static le_hashmap_Ref_t AppCgroupMap;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler of the resource events of the apps.
+ */
+//--------------------------------------------------------------------------------------------------
+static resLim_EventHandlerFunc_t EventHandler;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Timer checking the system memory pressure while the apps are throttled.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_timer_Ref_t ThrottleTimer;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Gets the resource limit value from the config tree.
@@ -307,6 +408,295 @@ static void SetRLimit
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the number of cgroup hierarchies an app has a cgroup in.  The unified hierarchy is shared
+ * by all the sub-systems, and the app's cgroup in it is the one of the first sub-system.
+ *
+ * @return
+ *      The number of hierarchies.
+ */
+//--------------------------------------------------------------------------------------------------
+static cgrp_SubSys_t NumHierarchies
+(
+    void
+)
+{
+    return cgrp_IsUnified() ? 1 : CGRP_NUM_SUBSYSTEMS;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler of the resource events of an app's cgroup.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AppCgroupEventHandler
+(
+    const char* cgroupNamePtr,      ///< [IN] App name.
+    cgrp_Event_t event,             ///< [IN] Event.
+    void* contextPtr                ///< [IN] Not used.
+)
+{
+    switch (event)
+    {
+        case CGRP_EVENT_MEM_HIGH:
+            LE_DEBUG("App '%s' is over its memory high limit and is being throttled.",
+                     cgroupNamePtr);
+            break;
+
+        case CGRP_EVENT_MEM_MAX:
+            LE_WARN("App '%s' reached its memory limit.", cgroupNamePtr);
+            break;
+
+        case CGRP_EVENT_OOM_KILL:
+            LE_ERROR("A process of app '%s' was killed by the OOM killer.", cgroupNamePtr);
+            break;
+
+        case CGRP_EVENT_CPU_PRESSURE:
+        case CGRP_EVENT_MEM_PRESSURE:
+        case CGRP_EVENT_IO_PRESSURE:
+            LE_DEBUG("App '%s' is under pressure (event %d).", cgroupNamePtr, event);
+            break;
+
+        default:
+            break;
+    }
+
+    if (EventHandler != NULL)
+    {
+        EventHandler(cgroupNamePtr, event);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stops monitoring the resource events of an app's cgroup.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StopMonitoringAppCgroup
+(
+    const char* appNamePtr          ///< [IN] App name.
+)
+{
+    AppCgroup_t* appCgroupPtr = le_hashmap_Remove(AppCgroupMap, appNamePtr);
+
+    if (appCgroupPtr == NULL)
+    {
+        return;
+    }
+
+    if (appCgroupPtr->emptyMonitor != NULL)
+    {
+        cgrp_RemoveHandler(appCgroupPtr->emptyMonitor);
+    }
+
+    if (appCgroupPtr->memEventsMonitor != NULL)
+    {
+        cgrp_RemoveHandler(appCgroupPtr->memEventsMonitor);
+    }
+
+    cgrp_Resource_t resource;
+    for (resource = 0; resource < CGRP_NUM_RESOURCES; resource++)
+    {
+        if (appCgroupPtr->pressureMonitors[resource] != NULL)
+        {
+            cgrp_RemoveHandler(appCgroupPtr->pressureMonitors[resource]);
+        }
+    }
+
+    le_mem_Release(appCgroupPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets the memory high limit of an app's cgroup and starts monitoring its resource events.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_FAULT if the exit of the app's processes cannot be monitored.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t MonitorAppCgroup
+(
+    const char* appNamePtr,         ///< [IN] App name.
+    size_t memHighLimit,            ///< [IN] Memory high limit, in kilobytes.
+    bool memoryThrottle             ///< [IN] Throttled while the system is under pressure.
+)
+{
+    // Drop the monitors left by a previous cgroup of the same name.
+    StopMonitoringAppCgroup(appNamePtr);
+
+    if (cgrp_mem_SetHighLimit(appNamePtr, memHighLimit) != LE_OK)
+    {
+        LE_WARN("Could not set the memory high limit of app '%s'.", appNamePtr);
+    }
+
+    AppCgroup_t* appCgroupPtr = le_mem_ForceAlloc(AppCgroupPool);
+
+    memset(appCgroupPtr, 0, sizeof(*appCgroupPtr));
+    LE_ASSERT(le_utf8_Copy(appCgroupPtr->appName, appNamePtr, sizeof(appCgroupPtr->appName),
+                           NULL) == LE_OK);
+    appCgroupPtr->memHighLimit = memHighLimit;
+    appCgroupPtr->memoryThrottle = memoryThrottle;
+
+    le_hashmap_Put(AppCgroupMap, appCgroupPtr->appName, appCgroupPtr);
+
+    // The exit of the last process replaces the freezer's notify_on_release, so it is required.
+    appCgroupPtr->emptyMonitor = cgrp_AddEmptyHandler(appNamePtr, AppCgroupEventHandler, NULL);
+
+    if (appCgroupPtr->emptyMonitor == NULL)
+    {
+        StopMonitoringAppCgroup(appNamePtr);
+        return LE_FAULT;
+    }
+
+    appCgroupPtr->memEventsMonitor = cgrp_mem_AddEventHandler(appNamePtr,
+                                                              AppCgroupEventHandler,
+                                                              NULL);
+
+    cgrp_Resource_t resource;
+    for (resource = 0; resource < CGRP_NUM_RESOURCES; resource++)
+    {
+        appCgroupPtr->pressureMonitors[resource] = cgrp_AddPressureHandler(appNamePtr,
+                                                                           resource,
+                                                                           APP_PRESSURE_STALL_US,
+                                                                           APP_PRESSURE_WINDOW_US,
+                                                                           AppCgroupEventHandler,
+                                                                           NULL);
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler of the system memory pressure.  The memory high limit of each running app which allows
+ * it (memoryThrottle in its .adef) is lowered to its current usage, so that the kernel reclaims the
+ * memory of these apps and throttles their allocations rather than those of the framework and the
+ * other apps, until the pressure is relieved.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SystemPressureHandler
+(
+    const char* cgroupNamePtr,      ///< [IN] NULL for the system.
+    cgrp_Event_t event,             ///< [IN] CGRP_EVENT_MEM_PRESSURE.
+    void* contextPtr                ///< [IN] Not used.
+)
+{
+    if (le_timer_IsRunning(ThrottleTimer))
+    {
+        // Already throttled.
+        return;
+    }
+
+    size_t numThrottled = 0;
+    le_hashmap_It_Ref_t iter = le_hashmap_GetIterator(AppCgroupMap);
+
+    while (le_hashmap_NextNode(iter) == LE_OK)
+    {
+        const AppCgroup_t* appCgroupPtr = le_hashmap_GetValue(iter);
+
+        if ( (!appCgroupPtr->memoryThrottle) ||
+             cgrp_IsEmpty(CGRP_SUBSYS_MEM, appCgroupPtr->appName) )
+        {
+            continue;
+        }
+
+        ssize_t usedBytes = cgrp_GetMemUsed(appCgroupPtr->appName);
+
+        if ( (usedBytes > 0) &&
+             (usedBytes / 1024 < appCgroupPtr->memHighLimit) &&
+             (cgrp_mem_SetHighLimit(appCgroupPtr->appName, usedBytes / 1024) == LE_OK) )
+        {
+            numThrottled++;
+        }
+    }
+
+    LE_WARN("System is under memory pressure.  Throttling the memory of %zu apps.", numThrottled);
+
+    LE_ASSERT(le_timer_Start(ThrottleTimer) == LE_OK);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks the system memory pressure while the apps are throttled, and restores the memory high
+ * limits of the apps once the pressure is relieved.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ThrottleTimerHandler
+(
+    le_timer_Ref_t timerRef         ///< [IN] Throttle timer.
+)
+{
+    cgrp_Pressure_t pressure;
+
+    if ( (cgrp_GetPressure(NULL, CGRP_RESOURCE_MEM, &pressure) == LE_OK) &&
+         (pressure.avg10 >= THROTTLE_RELEASE_AVG10) )
+    {
+        return;
+    }
+
+    le_hashmap_It_Ref_t iter = le_hashmap_GetIterator(AppCgroupMap);
+
+    while (le_hashmap_NextNode(iter) == LE_OK)
+    {
+        const AppCgroup_t* appCgroupPtr = le_hashmap_GetValue(iter);
+
+        if (appCgroupPtr->memoryThrottle)
+        {
+            cgrp_mem_SetHighLimit(appCgroupPtr->appName, appCgroupPtr->memHighLimit);
+        }
+    }
+
+    LE_INFO("System memory pressure is relieved.  Apps are not throttled anymore.");
+
+    le_timer_Stop(timerRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initializes the resource limits.  In the cgroup v2 unified hierarchy, the resource events of the
+ * apps are monitored and reported to the handler, and the memory of the apps which allow it is
+ * throttled while the system is under memory pressure.
+ */
+//--------------------------------------------------------------------------------------------------
+void resLim_Init
+(
+    resLim_EventHandlerFunc_t handlerFunc   ///< [IN] Handler of the resource events of the apps.
+)
+{
+    EventHandler = handlerFunc;
+
+    if (!cgrp_IsUnified())
+    {
+        return;
+    }
+
+    AppCgroupPool = le_mem_CreatePool("AppCgroups", sizeof(AppCgroup_t));
+    AppCgroupMap = le_hashmap_Create("AppCgroups",
+                                     EST_MAX_NUM_APPS,
+                                     le_hashmap_HashString,
+                                     le_hashmap_EqualsString);
+
+    ThrottleTimer = le_timer_Create("AppMemThrottle");
+    LE_ASSERT(le_timer_SetMsInterval(ThrottleTimer, THROTTLE_CHECK_INTERVAL_MS) == LE_OK);
+    LE_ASSERT(le_timer_SetRepeat(ThrottleTimer, 0) == LE_OK);
+    LE_ASSERT(le_timer_SetHandler(ThrottleTimer, ThrottleTimerHandler) == LE_OK);
+
+    if (cgrp_AddPressureHandler(NULL, CGRP_RESOURCE_MEM, SYSTEM_PRESSURE_STALL_US,
+                                SYSTEM_PRESSURE_WINDOW_US, SystemPressureHandler, NULL) == NULL)
+    {
+        LE_WARN("System memory pressure is not available.  Apps will not be throttled.");
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Sets the resource limits for the specified application.
@@ -325,7 +715,7 @@ le_result_t resLim_SetAppLimits
 
     // Create cgroups for this application in each of the cgroup subsystems.
     cgrp_SubSys_t subSys = 0;
-    while (subSys < CGRP_NUM_SUBSYSTEMS)
+    while (subSys < NumHierarchies())
     {
         switch(cgrp_Create(subSys, appNamePtr))
         {
@@ -373,7 +763,18 @@ le_result_t resLim_SetAppLimits
         return LE_FAULT;
     }
 
+    bool memoryThrottle = le_cfg_GetBool(appCfg, CFG_NODE_MEMORY_THROTTLE, false);
+
     le_cfg_CancelTxn(appCfg);
+
+    if (cgrp_IsUnified())
+    {
+        return MonitorAppCgroup(appNamePtr,
+                                (maxMemoryBytes - maxMemoryBytes / MEM_HIGH_LIMIT_MARGIN_DIVISOR)
+                                / 1024,
+                                memoryThrottle);
+    }
+
     return LE_OK;
 }
 
@@ -465,14 +866,45 @@ le_result_t resLim_SetProcLimits
                         DEFAULT_LIMIT_MAX_QUEUED_SIGNALS);
     }
 
+    if (cgrp_IsUnified())
+    {
+        // A process is in the same cgroup for all the sub-systems, so a realtime process cannot be
+        // kept out of the cpu controller as below.  If the kernel rejects it because realtime
+        // processes are scheduled by group, the cpu controller is removed from all the cgroups.
+        const char* appNamePtr = proc_GetAppName(procRef);
+        le_result_t result = cgrp_AddProc(CGRP_SUBSYS_FREEZE, appNamePtr, pid);
+
+        if ((result == LE_FAULT) && proc_IsRealtime(procRef) && cgrp_cpu_IsEnabled())
+        {
+            LE_WARN("Realtime process %d of app '%s' rejected by the cpu cgroup controller.",
+                    pid, appNamePtr);
+
+            if (cgrp_cpu_Disable() == LE_OK)
+            {
+                result = cgrp_AddProc(CGRP_SUBSYS_FREEZE, appNamePtr, pid);
+            }
+        }
+
+        if (result != LE_OK)
+        {
+            LE_ERROR("Could not add process %d to the cgroup of app '%s'.", pid, appNamePtr);
+            return LE_FAULT;
+        }
+
+        return LE_OK;
+    }
+
     // Add the process to its app's cgroups in each of the cgroup subsystems.
     cgrp_SubSys_t subSys = 0;
     for (; subSys < CGRP_NUM_SUBSYSTEMS; subSys++)
     {
         // Do not add realtime processes to the cpu cgroup.
-        if ( (subSys != CGRP_SUBSYS_CPU) || (!proc_IsRealtime(procRef)) )
+        if ( ((subSys != CGRP_SUBSYS_CPU) || (!proc_IsRealtime(procRef))) &&
+             (cgrp_AddProc(subSys, proc_GetAppName(procRef), pid) != LE_OK) )
         {
-            LE_ASSERT(cgrp_AddProc(subSys, proc_GetAppName(procRef), pid) == LE_OK);
+            LE_ERROR("Could not add process %d to the %s cgroup of app '%s'.",
+                     pid, cgrp_SubSysName(subSys), proc_GetAppName(procRef));
+            return LE_FAULT;
         }
     }
 
@@ -494,9 +926,14 @@ void resLim_CleanupApp
 {
     const char* appNamePtr = app_GetName(appRef);
 
+    if (cgrp_IsUnified())
+    {
+        StopMonitoringAppCgroup(appNamePtr);
+    }
+
     // Remove cgroups for this app in each of the cgroup subsystems.
     cgrp_SubSys_t subSys = 0;
-    for (; subSys < CGRP_NUM_SUBSYSTEMS; subSys++)
+    for (; subSys < NumHierarchies(); subSys++)
     {
         LE_ERROR_IF(cgrp_Delete(subSys, appNamePtr) != LE_OK,
                     "Could not remove %s cgroup for application '%s'.",
@@ -12,6 +12,32 @@
 
 #include "app.h"
 #include "proc.h"
+#include "cgroups.h"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler of the resource events of the apps.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef void (*resLim_EventHandlerFunc_t)
+(
+    const char* appNamePtr,         ///< [IN] Name of the app.
+    cgrp_Event_t event              ///< [IN] Event.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initializes the resource limits.  In the cgroup v2 unified hierarchy, the resource events of the
+ * apps are monitored and reported to the handler, and the memory of the apps which allow it is
+ * throttled while the system is under memory pressure.
+ */
+//--------------------------------------------------------------------------------------------------
+void resLim_Init
+(
+    resLim_EventHandlerFunc_t handlerFunc   ///< [IN] Handler of the resource events of the apps.
+);
 
 
 //--------------------------------------------------------------------------------------------------
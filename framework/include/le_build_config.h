@@ -53,6 +53,15 @@
  * against SEGV. However this handler relies on undefined behaviour of sigsetjmp(), so is more
  * risky.
  *
+ * @section bld_cfg_log_compile_level LE_LOG_COMPILE_LEVEL
+ *
+ * When @c LE_LOG_COMPILE_LEVEL is defined to one of the @ref le_log_Level_t values, the LE_DEBUG(),
+ * LE_INFO(), etc. macros less severe than that level are compiled out: they generate no code and
+ * cannot be enabled at runtime.  For example, to remove all debug messages from a release build,
+ * uncomment "//#define LE_LOG_COMPILE_LEVEL LE_LOG_INFO", or pass
+ * @c -DLE_LOG_COMPILE_LEVEL=LE_LOG_INFO in the @c cflags of the components concerned.  By
+ * default, no message is compiled out.
+ *
  * <HR>
  *
  * Copyright (C) Sierra Wireless Inc.
@@ -87,4 +96,9 @@
 
 
 
+// Uncomment this define to compile out the log messages less severe than INFO.
+//#define LE_LOG_COMPILE_LEVEL LE_LOG_INFO
+
+
+
 #endif
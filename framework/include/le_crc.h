@@ -17,6 +17,31 @@
  * and a CRC32. When the CRC32 is expected to be first computed, the value @ref LE_CRC_START_CRC32
  * needs to be set as crc32 value.
  *
+ * @section Crc32Stream Streaming and parallel computation
+ *
+ *   - @c le_crc_Crc32Init() - Initialize a streaming context
+ *   - @c le_crc_Crc32Update() - Add a block of data to a context
+ *   - @c le_crc_Crc32Merge() - Append the data of a context to another one
+ *   - @c le_crc_Crc32Final() - Get the CRC32 of a context
+ *   - @c le_crc_Crc32Combine() - Combine the CRC32 of two consecutive blocks
+ *
+ * A context keeps the CRC32 and the size of the data added to it. Since the CRC32 of a block can be
+ * combined with the CRC32 of the block before it, large data can be split in parts whose CRC32 are
+ * computed independently, for instance by several threads, then merged in order:
+ * @code
+ * le_crc_Crc32Ctx_t firstHalf, secondHalf;
+ *
+ * le_crc_Crc32Init(&firstHalf);
+ * le_crc_Crc32Init(&secondHalf);
+ *
+ * // These two calls can run in different threads
+ * le_crc_Crc32Update(&firstHalf, dataPtr, size / 2);
+ * le_crc_Crc32Update(&secondHalf, dataPtr + size / 2, size - size / 2);
+ *
+ * le_crc_Crc32Merge(&firstHalf, &secondHalf);
+ * crc = le_crc_Crc32Final(&firstHalf); // Same as le_crc_Crc32(dataPtr, size, LE_CRC_START_CRC32)
+ * @endcode
+ *
  * @note It is possible to compute a "global" CRC32 of a huge amount of data by splitting into small
  * blocks and continue computing the CRC32 on each one.
  *
@@ -81,6 +106,18 @@
 //--------------------------------------------------------------------------------------------------
 #define LE_CRC_START_CRC32         0xFFFFFFFFU
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Streaming CRC32 context
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t crc;       ///< CRC32 of the data added so far
+    uint64_t size;      ///< Number of bytes added so far
+}
+le_crc_Crc32Ctx_t;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function is used to calculate a CRC-32
@@ -96,4 +133,66 @@ uint32_t le_crc_Crc32
     uint32_t crc        ///< [IN] Starting CRC seed
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Combine the CRC32 of two consecutive blocks, both computed from @ref LE_CRC_START_CRC32.
+ *
+ * @return
+ *      - CRC32 of the concatenation of the two blocks
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t le_crc_Crc32Combine
+(
+    uint32_t crc1,      ///< [IN] CRC of the first block
+    uint32_t crc2,      ///< [IN] CRC of the second block
+    uint64_t size2      ///< [IN] Number of bytes of the second block
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize a streaming CRC32 context.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_crc_Crc32Init
+(
+    le_crc_Crc32Ctx_t* ctxPtr   ///< [OUT] Context
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a block of data to a streaming CRC32 context.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_crc_Crc32Update
+(
+    le_crc_Crc32Ctx_t* ctxPtr,      ///< [IN/OUT] Context
+    const void*        addressPtr,  ///< [IN] Input buffer
+    size_t             size         ///< [IN] Number of bytes to read
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append the data of a context to another one. The data of nextCtxPtr must follow the data of
+ * ctxPtr.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_crc_Crc32Merge
+(
+    le_crc_Crc32Ctx_t*       ctxPtr,        ///< [IN/OUT] Context of the first part
+    const le_crc_Crc32Ctx_t* nextCtxPtr     ///< [IN] Context of the following part
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the CRC32 of the data added to a streaming context.
+ *
+ * @return
+ *      - 32-bit CRC, as returned by le_crc_Crc32() from @ref LE_CRC_START_CRC32
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t le_crc_Crc32Final
+(
+    const le_crc_Crc32Ctx_t* ctxPtr     ///< [IN] Context
+);
+
 #endif // LEGATO_CRC_INCLUDE_GUARD
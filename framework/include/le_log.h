@@ -179,6 +179,20 @@
  * These allow apps to hook into the trace management system to use it to implement
  * sophisticated, app-specific tracing or profiling features.
  *
+ * @subsection c_log_callSites Call Sites
+ *
+ * Each of the logging and tracing macros above has its own static call site descriptor, holding
+ * its level, source file and line number.  The call site is registered with the logging system
+ * the first time it logs a message, and can then be disabled or enabled individually at runtime
+ * using the log control tool (see @ref c_log_control_tool).  A disabled call site costs a single
+ * test of a flag in its descriptor: its filter level is not checked and its parameters are not
+ * evaluated.
+ *
+ * The messages less severe than a level can also be removed from a build altogether by defining
+ * @c LE_LOG_COMPILE_LEVEL (see @ref c_le_build_cfg).  For example, building a component with
+ * @c -DLE_LOG_COMPILE_LEVEL=LE_LOG_INFO in its @c cflags removes all of its LE_DEBUG() messages,
+ * including those in hot loops, from the generated code.
+ *
  * @subsection c_log_resultTxt Result Code Text
  *
  * The @ref le_result_t macro supports printing an error condition in a human-readable text string.
@@ -233,6 +247,15 @@ $ log trace foo myProc/myComp
  * @verbatim
 $ log stoptrace foo myProc/myComp
 @endverbatim
+ *
+ * To disable the messages logged by line 123 of the file "myFile.c" in the component "myComp" of
+ * the running processes called "myProc", and to enable them again:
+ * @verbatim
+$ log disable myFile.c:123 myProc/myComp
+$ log enable myFile.c:123 myProc/myComp
+@endverbatim
+ *
+ * If the line number is omitted, all the call sites of the file are disabled or enabled.
  *
  * With all of the above examples "*" can be used in place of the process name or a component
  * name (or both) to mean "all processes" and/or "all components".
@@ -404,6 +427,45 @@ void _le_log_Send
     ...
 ) __attribute__ ((format (printf, 7, 8)));
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * States of a log call site.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LE_LOG_CALLSITE_NEW         0   ///< Not registered yet.
+#define LE_LOG_CALLSITE_ENABLED     1   ///< Registered and enabled.
+#define LE_LOG_CALLSITE_DISABLED    2   ///< Registered and disabled.
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Static descriptor of a log call site, one per use of a logging or tracing macro.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct le_log_CallSite
+{
+    le_log_Level_t level;               ///< Severity level, or -1 for a trace.
+    const char* fileNamePtr;            ///< Name of the source file.
+    unsigned int lineNumber;            ///< Line number in the source file.
+    int state;                          ///< LE_LOG_CALLSITE_NEW, _ENABLED or _DISABLED.
+    le_log_SessionRef_t logSession;     ///< Log session the call site is registered in.
+    struct le_log_CallSite* nextPtr;    ///< Next registered call site.
+}
+le_log_CallSite_t;
+
+/// Static initializer of a call site descriptor for the current line of the current file.
+#define LE_LOG_CALLSITE_INIT(level) \
+    { (level), STRINGIZE(LE_FILENAME), __LINE__, LE_LOG_CALLSITE_NEW, NULL, NULL }
+
+void _le_log_SendSite
+(
+    le_log_CallSite_t* callSitePtr,
+    const le_log_TraceRef_t traceRef,
+    le_log_SessionRef_t logSession,
+    const char* functionNamePtr,
+    const char* formatPtr,
+    ...
+) __attribute__ ((format (printf, 5, 6)));
+
 le_log_TraceRef_t _le_log_GetTraceRef
 (
     le_log_SessionRef_t logSession,
@@ -458,14 +520,32 @@ LE_SHARED le_log_Level_t* LE_LOG_LEVEL_FILTER_PTR;
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Internal macro to filter out messages that do not meet the current filtering level.
+ * Least severe level of the messages compiled in.  See @ref c_log_callSites.
+ */
+//--------------------------------------------------------------------------------------------------
+#ifndef LE_LOG_COMPILE_LEVEL
+#define LE_LOG_COMPILE_LEVEL LE_LOG_DEBUG
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Internal macro to filter out messages that are compiled out, whose call site is disabled or
+ * that do not meet the current filtering level.
+ *
+ * The compile-time level test is a constant expression, so the compiler drops the whole block
+ * (including the static call site descriptor) when it is false.
  */
 //--------------------------------------------------------------------------------------------------
 #define _LE_LOG_MSG(level, formatString, ...) \
     do { \
-        if ((LE_LOG_LEVEL_FILTER_PTR == NULL) || (level >= *LE_LOG_LEVEL_FILTER_PTR)) \
-            _le_log_Send(level, NULL, LE_LOG_SESSION, STRINGIZE(LE_FILENAME), __func__, __LINE__, \
-                    formatString, ##__VA_ARGS__); \
+        if ((level) >= LE_LOG_COMPILE_LEVEL) \
+        { \
+            static le_log_CallSite_t _le_log_CallSite = LE_LOG_CALLSITE_INIT(level); \
+            if ((_le_log_CallSite.state != LE_LOG_CALLSITE_DISABLED) && \
+                ((LE_LOG_LEVEL_FILTER_PTR == NULL) || (level >= *LE_LOG_LEVEL_FILTER_PTR))) \
+                _le_log_SendSite(&_le_log_CallSite, NULL, LE_LOG_SESSION, __func__, \
+                        formatString, ##__VA_ARGS__); \
+        } \
     } while(0)
 
 
@@ -609,17 +689,20 @@ const char* _le_log_GetResultCodeString
  * Logs the string if the keyword has been enabled by a runtime tool or configuration setting.
  */
 //--------------------------------------------------------------------------------------------------
-#define LE_TRACE(traceRef, string, ...)         \
-        if (le_log_IsTraceEnabled(traceRef))    \
-        {                                       \
-            _le_log_Send((le_log_Level_t)-1,    \
-                    traceRef,                   \
-                    LE_LOG_SESSION,             \
-                    STRINGIZE(LE_FILENAME),     \
-                    __func__,                   \
-                    __LINE__,                   \
-                    string,                     \
-                    ##__VA_ARGS__);             \
+#define LE_TRACE(traceRef, string, ...)                                                 \
+        if (le_log_IsTraceEnabled(traceRef))                                            \
+        {                                                                               \
+            static le_log_CallSite_t _le_log_CallSite =                                 \
+                                            LE_LOG_CALLSITE_INIT((le_log_Level_t)-1);   \
+            if (_le_log_CallSite.state != LE_LOG_CALLSITE_DISABLED)                     \
+            {                                                                           \
+                _le_log_SendSite(&_le_log_CallSite,                                     \
+                        traceRef,                                                       \
+                        LE_LOG_SESSION,                                                 \
+                        __func__,                                                       \
+                        string,                                                         \
+                        ##__VA_ARGS__);                                                 \
+            }                                                                           \
         }
 
 
@@ -12,6 +12,18 @@
 #include "fileDescriptor.h"
 #include "fileSystem.h"
 #include "killProc.h"
+#include <sys/vfs.h>
+#include <linux/magic.h>
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * File system magic number of the cgroup v2 unified hierarchy, missing from older kernel headers.
+ */
+//--------------------------------------------------------------------------------------------------
+#ifndef CGROUP2_SUPER_MAGIC
+#define CGROUP2_SUPER_MAGIC         0x63677270
+#endif
 
 
 //--------------------------------------------------------------------------------------------------
@@ -87,6 +99,221 @@ static const char* SubSysName[CGRP_NUM_SUBSYSTEMS] = {"cpu,cpuacct", "memory", "
 #define MAX_FREEZE_STATE_BYTES      20
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Files of the cgroup v2 unified hierarchy that replace the per sub-system files above.
+ */
+//--------------------------------------------------------------------------------------------------
+#define V2_TASKS_FILENAME           "cgroup.threads"
+#define V2_CPU_WEIGHT_FILENAME      "cpu.weight"
+#define V2_MEM_MAX_FILENAME         "memory.max"
+#define V2_MEM_HIGH_FILENAME        "memory.high"
+#define V2_MEM_CURRENT_FILENAME     "memory.current"
+#define V2_MEM_PEAK_FILENAME        "memory.peak"
+#define V2_SWAP_CURRENT_FILENAME    "memory.swap.current"
+#define V2_SWAP_PEAK_FILENAME       "memory.swap.peak"
+#define V2_FREEZE_FILENAME          "cgroup.freeze"
+#define V2_EVENTS_FILENAME          "cgroup.events"
+#define V2_MEM_EVENTS_FILENAME      "memory.events"
+#define V2_SUBTREE_CONTROL_FILENAME "cgroup.subtree_control"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Controllers enabled for the children of the root cgroup in the unified hierarchy.
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* V2Controllers[] = {"+cpu", "+memory", "+io"};
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Command disabling the cpu controller for the children of the root cgroup.
+ */
+//--------------------------------------------------------------------------------------------------
+#define V2_DISABLE_CPU_CONTROLLER   "-cpu"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Whether the cpu controller is enabled for the children of the root cgroup of the unified
+ * hierarchy.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool CpuControllerEnabled = false;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pressure stall information files, per resource.  The system-wide files are in /proc/pressure.
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* PressureFileName[CGRP_NUM_RESOURCES] =
+    {"cpu.pressure", "memory.pressure", "io.pressure"};
+
+#define SYSTEM_PRESSURE_PATH        "/proc/pressure"
+
+static const char* SystemPressureName[CGRP_NUM_RESOURCES] = {"cpu", "memory", "io"};
+
+static const cgrp_Event_t PressureEvent[CGRP_NUM_RESOURCES] =
+    {CGRP_EVENT_CPU_PRESSURE, CGRP_EVENT_MEM_PRESSURE, CGRP_EVENT_IO_PRESSURE};
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Default cpu share of a cgroup v1 group and default cpu weight of a cgroup v2 group.  Shares are
+ * converted to weights relative to these so that apps keep the same share of the cpu against the
+ * rest of the system.
+ */
+//--------------------------------------------------------------------------------------------------
+#define DEFAULT_CPU_SHARE           1024
+#define DEFAULT_CPU_WEIGHT          100
+#define MIN_CPU_WEIGHT              1
+#define MAX_CPU_WEIGHT              10000
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the buffer used to read the event and pressure files.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_EVENTS_FILE_BYTES       256
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Kinds of monitor.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    MONITOR_PRESSURE,               ///< Pressure stall trigger.
+    MONITOR_EMPTY,                  ///< Populated state of the cgroup, from cgroup.events.
+    MONITOR_MEM_EVENTS              ///< Memory limit events, from memory.events.
+}
+MonitorType_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Counters of memory.events that are reported.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    MEM_EVENT_HIGH = 0,
+    MEM_EVENT_MAX,
+    MEM_EVENT_OOM_KILL,
+    NUM_MEM_EVENTS
+}
+MemEvent_t;
+
+static const char* MemEventName[NUM_MEM_EVENTS] = {"high", "max", "oom_kill"};
+
+static const cgrp_Event_t MemEventType[NUM_MEM_EVENTS] =
+    {CGRP_EVENT_MEM_HIGH, CGRP_EVENT_MEM_MAX, CGRP_EVENT_OOM_KILL};
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Monitor of a cgroup file.  The kernel signals the changes of the file with POLLPRI.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct cgrp_Monitor
+{
+    MonitorType_t           type;               ///< Kind of monitor.
+    cgrp_Resource_t         resource;           ///< Monitored resource, for a pressure trigger.
+    char                    cgroupName[LIMIT_MAX_PATH_BYTES]; ///< Cgroup, empty for the system.
+    int                     fd;                 ///< Monitored file, -1 once closed.
+    le_fdMonitor_Ref_t      fdMonitorRef;       ///< fd monitor, NULL once deleted.
+    cgrp_EventHandlerFunc_t handlerFunc;        ///< Handler, NULL once the monitor is removed.
+    void*                   contextPtr;         ///< Context of the handler.
+    bool                    isPopulated;        ///< Last populated state, for an empty monitor.
+    uint64_t                memEventCount[NUM_MEM_EVENTS]; ///< Last counters, for memory events.
+}
+Monitor_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool of monitors.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t MonitorPool;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Whether the unified hierarchy is mounted on the cgroup root: 1 if it is, 0 if not, -1 if this
+ * has not been checked yet.
+ */
+//--------------------------------------------------------------------------------------------------
+static int UnifiedMode = -1;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks whether the cgroup root is the cgroup v2 unified hierarchy.  In this mode all the
+ * sub-systems share a single hierarchy, and a cgroup has the same directory for all sub-systems.
+ *
+ * @return
+ *      true if the unified hierarchy is used.
+ *      false if a hierarchy is mounted for each sub-system.
+ */
+//--------------------------------------------------------------------------------------------------
+bool cgrp_IsUnified
+(
+    void
+)
+{
+    if (UnifiedMode < 0)
+    {
+        struct statfs fsInfo;
+
+        UnifiedMode = ( (statfs(ROOT_PATH, &fsInfo) == 0) &&
+                        (fsInfo.f_type == CGROUP2_SUPER_MAGIC) ) ? 1 : 0;
+    }
+
+    return (UnifiedMode == 1);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the directory of a sub-system hierarchy under the cgroup root.  It is empty in the unified
+ * hierarchy.
+ *
+ * @return
+ *      The directory name.
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* HierarchyDir
+(
+    cgrp_SubSys_t subsystem         ///< [IN] Sub-system.
+)
+{
+    return cgrp_IsUnified() ? "" : SubSysName[subsystem];
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Picks the cgroup v1 or the cgroup v2 name of a cgroup file.
+ *
+ * @return
+ *      The file name for the mounted hierarchy.
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* FileName
+(
+    const char* v1NamePtr,          ///< [IN] File name in a sub-system hierarchy.
+    const char* v2NamePtr           ///< [IN] File name in the unified hierarchy.
+)
+{
+    return cgrp_IsUnified() ? v2NamePtr : v1NamePtr;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Checks if all cgroup subsystems are mounted.
@@ -147,6 +374,52 @@ static void MountSubSys
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Enables the controllers of the supported sub-systems for the children of the root cgroup of the
+ * unified hierarchy.  The freezer is built into every cgroup v2 group.
+ */
+//--------------------------------------------------------------------------------------------------
+static void EnableControllers
+(
+    void
+)
+{
+    char path[LIMIT_MAX_PATH_BYTES] = ROOT_PATH;
+    LE_ASSERT(le_path_Concat("/", path, sizeof(path), V2_SUBTREE_CONTROL_FILENAME,
+                             (char*)NULL) == LE_OK);
+
+    int fd = open(path, O_WRONLY | O_CLOEXEC);
+    LE_FATAL_IF(fd < 0, "Could not open '%s'.  %m.", path);
+
+    size_t i;
+    for (i = 0; i < NUM_ARRAY_MEMBERS(V2Controllers); i++)
+    {
+        // Write the controllers one at a time, so that a missing controller does not prevent the
+        // others from being enabled.
+        ssize_t len = strlen(V2Controllers[i]);
+        ssize_t numBytesWritten;
+
+        do
+        {
+            numBytesWritten = write(fd, V2Controllers[i], len);
+        }
+        while ((numBytesWritten == -1) && (errno == EINTR));
+
+        if (numBytesWritten != len)
+        {
+            LE_WARN("Could not enable the '%s' cgroup controller.  %m.", V2Controllers[i] + 1);
+        }
+        else if (strcmp(V2Controllers[i], "+cpu") == 0)
+        {
+            CpuControllerEnabled = true;
+        }
+    }
+
+    fd_Close(fd);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Initializes cgroups for the system.  Sets up a hierarchy for each supported subsystem.
@@ -162,6 +435,15 @@ void cgrp_Init
     void
 )
 {
+    MonitorPool = le_mem_CreatePool("CgroupMonitors", sizeof(Monitor_t));
+
+    if (cgrp_IsUnified())
+    {
+        LE_INFO("Using the cgroup v2 unified hierarchy.");
+        EnableControllers();
+        return;
+    }
+
     // Setup the cgroup root directory if it does not already exist.
     if (!fs_IsMounted(ROOT_NAME, ROOT_PATH))
     {
@@ -208,7 +490,7 @@ static int OpenCgrpFile
 {
     // Create the path to the cgroup file.
     char path[LIMIT_MAX_PATH_BYTES] = ROOT_PATH;
-    LE_ASSERT(le_path_Concat("/", path, sizeof(path), SubSysName[subsystem], cgroupNamePtr,
+    LE_ASSERT(le_path_Concat("/", path, sizeof(path), HierarchyDir(subsystem), cgroupNamePtr,
                              fileNamePtr, (char*)NULL) == LE_OK);
 
     // Open the cgroup file.
@@ -431,6 +713,144 @@ static void RemoveTrailingWhiteSpace
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parses an unsigned integer value.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_FAULT if the string is not a number.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ParseU64
+(
+    const char* strPtr,             ///< [IN] String to parse.
+    uint64_t* valuePtr              ///< [OUT] Parsed value.
+)
+{
+    char* endPtr;
+
+    errno = 0;
+    unsigned long long value = strtoull(strPtr, &endPtr, 10);
+
+    if ((errno != 0) || (endPtr == strPtr))
+    {
+        return LE_FAULT;
+    }
+
+    *valuePtr = value;
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the value of a key in the content of a flat keyed file, made of "<key> <value>" lines such
+ * as cgroup.events and memory.events.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_NOT_FOUND if the key is not in the content.
+ *      LE_FAULT if the value is not a number.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t GetKeyedValue
+(
+    const char* contentPtr,         ///< [IN] Content of the file.
+    const char* keyPtr,             ///< [IN] Key.
+    uint64_t* valuePtr              ///< [OUT] Value of the key.
+)
+{
+    size_t keyLen = strlen(keyPtr);
+    const char* linePtr = contentPtr;
+
+    while ((linePtr != NULL) && (*linePtr != '\0'))
+    {
+        if ((strncmp(linePtr, keyPtr, keyLen) == 0) && (linePtr[keyLen] == ' '))
+        {
+            return ParseU64(linePtr + keyLen + 1, valuePtr);
+        }
+
+        linePtr = strchr(linePtr, '\n');
+
+        if (linePtr != NULL)
+        {
+            linePtr++;
+        }
+    }
+
+    return LE_NOT_FOUND;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads an unsigned integer value from a cgroup file.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t GetU64Value
+(
+    cgrp_SubSys_t subsystem,        ///< [IN] Sub-system of the cgroup.
+    const char* cgroupNamePtr,      ///< [IN] Name of the cgroup.
+    const char* fileNamePtr,        ///< [IN] File name to read from.
+    uint64_t* valuePtr              ///< [OUT] Value read.
+)
+{
+    char buffer[MAX_DIGITS] = {0};
+
+    if (GetValue(subsystem, cgroupNamePtr, fileNamePtr, buffer, sizeof(buffer)) != LE_OK)
+    {
+        return LE_FAULT;
+    }
+
+    return ParseU64(buffer, valuePtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the memory and swap usage of a cgroup of the unified hierarchy, from its memory and swap
+ * counter files.  The swap file is only present when the kernel supports swap.
+ *
+ * @return
+ *      Number of bytes.
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+static ssize_t GetV2MemUsage
+(
+    const char* cgroupNamePtr,      ///< [IN] Name of the cgroup.
+    const char* memFileNamePtr,     ///< [IN] Memory counter file.
+    const char* swapFileNamePtr     ///< [IN] Swap counter file.
+)
+{
+    uint64_t memBytes;
+
+    if (GetU64Value(CGRP_SUBSYS_MEM, cgroupNamePtr, memFileNamePtr, &memBytes) != LE_OK)
+    {
+        return LE_FAULT;
+    }
+
+    char path[LIMIT_MAX_PATH_BYTES] = ROOT_PATH;
+    LE_ASSERT(le_path_Concat("/", path, sizeof(path), cgroupNamePtr, swapFileNamePtr,
+                             (char*)NULL) == LE_OK);
+
+    uint64_t swapBytes = 0;
+
+    if ( (access(path, F_OK) == 0) &&
+         (GetU64Value(CGRP_SUBSYS_MEM, cgroupNamePtr, swapFileNamePtr, &swapBytes) != LE_OK) )
+    {
+        return LE_FAULT;
+    }
+
+    return memBytes + swapBytes;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Creates a cgroup with the specified name in the specified sub-system.  If the cgroup already
@@ -455,7 +875,7 @@ le_result_t cgrp_Create
 {
     // Create the path to the cgroup.
     char path[LIMIT_MAX_PATH_BYTES] = ROOT_PATH;
-    LE_ASSERT(le_path_Concat("/", path, sizeof(path), SubSysName[subsystem], cgroupNamePtr,
+    LE_ASSERT(le_path_Concat("/", path, sizeof(path), HierarchyDir(subsystem), cgroupNamePtr,
                              (char*)NULL) == LE_OK);
 
     // Create the cgroup.
@@ -568,7 +988,8 @@ ssize_t cgrp_GetThreadList
 )
 {
     // Open the cgroup's tasks file for reading.
-    int fd = OpenCgrpFile(subsystem, cgroupNamePtr, TASKS_FILENAME, O_RDONLY);
+    int fd = OpenCgrpFile(subsystem, cgroupNamePtr,
+                          FileName(TASKS_FILENAME, V2_TASKS_FILENAME), O_RDONLY);
 
     if (fd < 0)
     {
@@ -696,7 +1117,8 @@ bool cgrp_IsEmpty
 )
 {
     // Open the cgroup's tasks file for reading.
-    int fd = OpenCgrpFile(subsystem, cgroupNamePtr, TASKS_FILENAME, O_RDONLY);
+    int fd = OpenCgrpFile(subsystem, cgroupNamePtr,
+                          FileName(TASKS_FILENAME, V2_TASKS_FILENAME), O_RDONLY);
 
     if (fd < 0)
     {
@@ -745,7 +1167,7 @@ le_result_t cgrp_Delete
 {
     // Create the path to the cgroup.
     char path[LIMIT_MAX_PATH_BYTES] = ROOT_PATH;
-    LE_ASSERT(le_path_Concat("/", path, sizeof(path), SubSysName[subsystem], cgroupNamePtr,
+    LE_ASSERT(le_path_Concat("/", path, sizeof(path), HierarchyDir(subsystem), cgroupNamePtr,
                              (char*)NULL) == LE_OK);
 
     // Attempt to remove the cgroup directory.
@@ -834,12 +1256,38 @@ le_result_t cgrp_cpu_SetShare
                                     ///  details.
 )
 {
-    // Convert the value to a string.
-    char shareStr[MAX_DIGITS];
-    LE_ASSERT(snprintf(shareStr, sizeof(shareStr), "%zd", share) < sizeof(shareStr));
+    if (cgrp_IsUnified())
+    {
+        if (!CpuControllerEnabled)
+        {
+            // No cpu.weight file, all the cgroups are scheduled as the root cgroup.
+            LE_DEBUG("No cpu controller, share of cgroup '%s' ignored.", cgroupNamePtr);
+            return LE_OK;
+        }
+
+        // The unified hierarchy uses weights instead of shares, scale the share so that the default
+        // share maps onto the default weight.
+        uint64_t weight = ((uint64_t)share * DEFAULT_CPU_WEIGHT) / DEFAULT_CPU_SHARE;
+
+        if (weight < MIN_CPU_WEIGHT)
+        {
+            weight = MIN_CPU_WEIGHT;
+        }
+        else if (weight > MAX_CPU_WEIGHT)
+        {
+            weight = MAX_CPU_WEIGHT;
+        }
+
+        share = weight;
+    }
+
+    // Convert the value to a string.
+    char shareStr[MAX_DIGITS];
+    LE_ASSERT(snprintf(shareStr, sizeof(shareStr), "%zd", share) < sizeof(shareStr));
 
     // Write the share value to the file.
-    if (WriteToFile(CGRP_SUBSYS_CPU, cgroupNamePtr, CPU_SHARES_FILENAME, shareStr) != LE_OK)
+    if (WriteToFile(CGRP_SUBSYS_CPU, cgroupNamePtr,
+                    FileName(CPU_SHARES_FILENAME, V2_CPU_WEIGHT_FILENAME), shareStr) != LE_OK)
     {
         return LE_FAULT;
     }
@@ -848,6 +1296,89 @@ le_result_t cgrp_cpu_SetShare
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks whether the cpu controller applies to the cgroups.  It is always the case with a hierarchy
+ * per sub-system.
+ *
+ * @return
+ *      true if the cpu controller is enabled.
+ *      false otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+bool cgrp_cpu_IsEnabled
+(
+    void
+)
+{
+    return !cgrp_IsUnified() || CpuControllerEnabled;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Disables the cpu controller for all the cgroups of the unified hierarchy.  A kernel scheduling
+ * realtime processes by group only accepts them in the root cgroup of the cpu controller, which in
+ * the unified hierarchy means that no other cgroup has the cpu controller.  The cpu shares are then
+ * ignored.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_UNSUPPORTED if a hierarchy is mounted for each sub-system.
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t cgrp_cpu_Disable
+(
+    void
+)
+{
+    if (!cgrp_IsUnified())
+    {
+        return LE_UNSUPPORTED;
+    }
+
+    if (!CpuControllerEnabled)
+    {
+        return LE_OK;
+    }
+
+    char path[LIMIT_MAX_PATH_BYTES] = ROOT_PATH;
+    LE_ASSERT(le_path_Concat("/", path, sizeof(path), V2_SUBTREE_CONTROL_FILENAME,
+                             (char*)NULL) == LE_OK);
+
+    int fd = open(path, O_WRONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        LE_ERROR("Could not open '%s'.  %m.", path);
+        return LE_FAULT;
+    }
+
+    ssize_t len = strlen(V2_DISABLE_CPU_CONTROLLER);
+    ssize_t numBytesWritten;
+
+    do
+    {
+        numBytesWritten = write(fd, V2_DISABLE_CPU_CONTROLLER, len);
+    }
+    while ((numBytesWritten == -1) && (errno == EINTR));
+
+    if (numBytesWritten != len)
+    {
+        LE_ERROR("Could not disable the cpu cgroup controller.  %m.");
+        fd_Close(fd);
+        return LE_FAULT;
+    }
+
+    fd_Close(fd);
+
+    CpuControllerEnabled = false;
+    LE_WARN("Cpu cgroup controller disabled, the cpu shares no longer apply.");
+
+    return LE_OK;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Sets the memory limit for a cgroup.
@@ -870,8 +1401,10 @@ le_result_t cgrp_mem_SetLimit
 
     LE_ASSERT(snprintf(limitStr, sizeof(limitStr), "%zd", limit * 1024) < sizeof(limitStr));
 
+    const char* fileNamePtr = FileName(MEM_LIMIT_FILENAME, V2_MEM_MAX_FILENAME);
+
     // Write the limit to the file.
-    if (WriteToFile(CGRP_SUBSYS_MEM, cgroupNamePtr, MEM_LIMIT_FILENAME, limitStr) != LE_OK)
+    if (WriteToFile(CGRP_SUBSYS_MEM, cgroupNamePtr, fileNamePtr, limitStr) != LE_OK)
     {
         return LE_FAULT;
     }
@@ -881,7 +1414,7 @@ le_result_t cgrp_mem_SetLimit
 
     if (GetValue(CGRP_SUBSYS_MEM,
                  cgroupNamePtr,
-                 MEM_LIMIT_FILENAME,
+                 fileNamePtr,
                  readLimitStr,
                  sizeof(readLimitStr)) != LE_OK)
     {
@@ -898,6 +1431,43 @@ page rounding or memory availability.", cgroupNamePtr, readLimitStr, limitStr);
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets the memory high limit of a cgroup.  Above this limit the kernel throttles the allocations of
+ * the processes in the cgroup and reclaims their memory, instead of invoking the OOM killer.
+ *
+ * @note Only available in the unified hierarchy.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_UNSUPPORTED if the unified hierarchy is not used.
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t cgrp_mem_SetHighLimit
+(
+    const char* cgroupNamePtr,      ///< Name of the cgroup to set the limit for.
+    size_t limit                    ///< Memory high limit in kilobytes.
+)
+{
+    if (!cgrp_IsUnified())
+    {
+        return LE_UNSUPPORTED;
+    }
+
+    char limitStr[MAX_DIGITS];
+
+    LE_ASSERT(snprintf(limitStr, sizeof(limitStr), "%zd", limit * 1024) < sizeof(limitStr));
+
+    if (WriteToFile(CGRP_SUBSYS_MEM, cgroupNamePtr, V2_MEM_HIGH_FILENAME, limitStr) != LE_OK)
+    {
+        return LE_FAULT;
+    }
+
+    return LE_OK;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Freezes all the tasks in a cgroup.  This is an asynchronous function call that returns
@@ -915,7 +1485,9 @@ le_result_t cgrp_frz_Freeze
     const char* cgroupNamePtr       ///< [IN] Name of the cgroup.
 )
 {
-    if (WriteToFile(CGRP_SUBSYS_FREEZE, cgroupNamePtr, FREEZE_STATE_FILENAME, "FROZEN") != LE_OK)
+    if (WriteToFile(CGRP_SUBSYS_FREEZE, cgroupNamePtr,
+                    FileName(FREEZE_STATE_FILENAME, V2_FREEZE_FILENAME),
+                    cgrp_IsUnified() ? "1" : "FROZEN") != LE_OK)
     {
         return LE_FAULT;
     }
@@ -941,7 +1513,9 @@ le_result_t cgrp_frz_Thaw
     const char* cgroupNamePtr       ///< [IN] Name of the cgroup.
 )
 {
-    if (WriteToFile(CGRP_SUBSYS_FREEZE, cgroupNamePtr, FREEZE_STATE_FILENAME, "THAWED") != LE_OK)
+    if (WriteToFile(CGRP_SUBSYS_FREEZE, cgroupNamePtr,
+                    FileName(FREEZE_STATE_FILENAME, V2_FREEZE_FILENAME),
+                    cgrp_IsUnified() ? "0" : "THAWED") != LE_OK)
     {
         return LE_FAULT;
     }
@@ -964,6 +1538,22 @@ cgrp_FreezeState_t cgrp_frz_GetState
     const char* cgroupNamePtr       ///< [IN] Name of the cgroup.
 )
 {
+    if (cgrp_IsUnified())
+    {
+        // The frozen state is reported in the events file, once all the tasks are frozen.
+        char eventsStr[MAX_EVENTS_FILE_BYTES] = {0};
+        uint64_t frozen;
+
+        if ( (GetValue(CGRP_SUBSYS_FREEZE, cgroupNamePtr, V2_EVENTS_FILENAME,
+                       eventsStr, sizeof(eventsStr)) != LE_OK) ||
+             (GetKeyedValue(eventsStr, "frozen", &frozen) != LE_OK) )
+        {
+            return LE_FAULT;
+        }
+
+        return (frozen != 0) ? CGRP_FROZEN : CGRP_THAWED;
+    }
+
     char stateStr[MAX_FREEZE_STATE_BYTES] = {0};
 
     le_result_t result = GetValue(CGRP_SUBSYS_FREEZE,
@@ -1008,6 +1598,11 @@ ssize_t cgrp_GetMemUsed
     const char* cgroupNamePtr       ///< [IN] Name of the cgroup.
 )
 {
+    if (cgrp_IsUnified())
+    {
+        return GetV2MemUsage(cgroupNamePtr, V2_MEM_CURRENT_FILENAME, V2_SWAP_CURRENT_FILENAME);
+    }
+
     char buffer[32] = {0};
     ssize_t result;
 
@@ -1041,6 +1636,11 @@ ssize_t cgrp_GetMaxMemUsed
     const char* cgroupNamePtr       ///< [IN] Name of the cgroup.
 )
 {
+    if (cgrp_IsUnified())
+    {
+        return GetV2MemUsage(cgroupNamePtr, V2_MEM_PEAK_FILENAME, V2_SWAP_PEAK_FILENAME);
+    }
+
     char buffer[32] = {0};
     ssize_t result;
 
@@ -1062,3 +1662,567 @@ ssize_t cgrp_GetMaxMemUsed
 }
 
 
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Builds the path of the pressure stall information file of a resource.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_UNSUPPORTED if a cgroup is given and the unified hierarchy is not used.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t BuildPressurePath
+(
+    const char* cgroupNamePtr,      ///< [IN] Name of the cgroup, NULL for the whole system.
+    cgrp_Resource_t resource,       ///< [IN] Resource.
+    char* pathPtr,                  ///< [OUT] Path of the file.
+    size_t pathSize                 ///< [IN] Size of the path buffer.
+)
+{
+    LE_ASSERT((resource >= 0) && (resource < CGRP_NUM_RESOURCES));
+
+    if (cgroupNamePtr == NULL)
+    {
+        LE_ASSERT(le_utf8_Copy(pathPtr, SYSTEM_PRESSURE_PATH, pathSize, NULL) == LE_OK);
+        LE_ASSERT(le_path_Concat("/", pathPtr, pathSize, SystemPressureName[resource],
+                                 (char*)NULL) == LE_OK);
+        return LE_OK;
+    }
+
+    if (!cgrp_IsUnified())
+    {
+        return LE_UNSUPPORTED;
+    }
+
+    LE_ASSERT(le_utf8_Copy(pathPtr, ROOT_PATH, pathSize, NULL) == LE_OK);
+    LE_ASSERT(le_path_Concat("/", pathPtr, pathSize, cgroupNamePtr, PressureFileName[resource],
+                             (char*)NULL) == LE_OK);
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads the whole content of a monitored file from its start.  The content is NULL-terminated.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_FAULT if there was an error, which happens once the cgroup has been removed.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReadMonitoredFile
+(
+    int fd,                         ///< [IN] File descriptor of the file.
+    char* bufPtr,                   ///< [OUT] Buffer to store the content in.
+    size_t bufSize                  ///< [IN] Size of the buffer.
+)
+{
+    ssize_t numBytesRead;
+
+    do
+    {
+        numBytesRead = pread(fd, bufPtr, bufSize - 1, 0);
+    }
+    while ((numBytesRead == -1) && (errno == EINTR));
+
+    if (numBytesRead < 0)
+    {
+        return LE_FAULT;
+    }
+
+    bufPtr[numBytesRead] = '\0';
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parses the "some" line of a pressure stall information file.  The averages have two decimals.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_FAULT if the content is not understood.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ParsePressure
+(
+    const char* contentPtr,         ///< [IN] Content of the file.
+    cgrp_Pressure_t* pressurePtr    ///< [OUT] Pressure.
+)
+{
+    unsigned int avg10[2];
+    unsigned int avg60[2];
+    unsigned int avg300[2];
+    uint64_t total;
+
+    if (sscanf(contentPtr, "some avg10=%u.%u avg60=%u.%u avg300=%u.%u total=%" SCNu64,
+               &avg10[0], &avg10[1], &avg60[0], &avg60[1], &avg300[0], &avg300[1], &total) != 7)
+    {
+        return LE_FAULT;
+    }
+
+    pressurePtr->avg10 = avg10[0] * 100 + avg10[1];
+    pressurePtr->avg60 = avg60[0] * 100 + avg60[1];
+    pressurePtr->avg300 = avg300[0] * 100 + avg300[1];
+    pressurePtr->totalUs = total;
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the pressure stall information of a resource: how long some of the tasks of a cgroup, or of
+ * the system, waited for the resource.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_UNSUPPORTED if the kernel does not provide pressure stall information for the cgroup.
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t cgrp_GetPressure
+(
+    const char* cgroupNamePtr,      ///< [IN] Name of the cgroup, NULL for the whole system.
+    cgrp_Resource_t resource,       ///< [IN] Resource.
+    cgrp_Pressure_t* pressurePtr    ///< [OUT] Pressure.
+)
+{
+    char path[LIMIT_MAX_PATH_BYTES];
+
+    if (BuildPressurePath(cgroupNamePtr, resource, path, sizeof(path)) != LE_OK)
+    {
+        return LE_UNSUPPORTED;
+    }
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0)
+    {
+        return (errno == ENOENT) ? LE_UNSUPPORTED : LE_FAULT;
+    }
+
+    char content[MAX_EVENTS_FILE_BYTES];
+    le_result_t result = ReadMonitoredFile(fd, content, sizeof(content));
+
+    fd_Close(fd);
+
+    if (result == LE_OK)
+    {
+        result = ParsePressure(content, pressurePtr);
+    }
+
+    if (result != LE_OK)
+    {
+        LE_ERROR("Could not read the pressure from '%s'.", path);
+    }
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stops monitoring the file of a monitor and closes it.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StopMonitor
+(
+    Monitor_t* monitorPtr           ///< [IN] Monitor.
+)
+{
+    if (monitorPtr->fdMonitorRef != NULL)
+    {
+        le_fdMonitor_Delete(monitorPtr->fdMonitorRef);
+        monitorPtr->fdMonitorRef = NULL;
+    }
+
+    if (monitorPtr->fd >= 0)
+    {
+        fd_Close(monitorPtr->fd);
+        monitorPtr->fd = -1;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Calls the handler of a monitor, unless the monitor has been removed by a previous handler.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReportEvent
+(
+    Monitor_t* monitorPtr,          ///< [IN] Monitor.
+    cgrp_Event_t event              ///< [IN] Event.
+)
+{
+    if (monitorPtr->handlerFunc != NULL)
+    {
+        monitorPtr->handlerFunc(monitorPtr->cgroupName[0] != '\0' ? monitorPtr->cgroupName : NULL,
+                                event,
+                                monitorPtr->contextPtr);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads the monitored events file of a cgroup.  The monitor is stopped if the cgroup is gone.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_FAULT if the file could not be read.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReadEventsFile
+(
+    Monitor_t* monitorPtr,          ///< [IN] Monitor.
+    char* bufPtr,                   ///< [OUT] Buffer to store the content in.
+    size_t bufSize                  ///< [IN] Size of the buffer.
+)
+{
+    if (ReadMonitoredFile(monitorPtr->fd, bufPtr, bufSize) != LE_OK)
+    {
+        LE_DEBUG("Stop monitoring cgroup '%s'.  %m.", monitorPtr->cgroupName);
+        StopMonitor(monitorPtr);
+        return LE_FAULT;
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Updates the populated state of an empty monitor, and reports when the last process left.
+ */
+//--------------------------------------------------------------------------------------------------
+static void UpdatePopulated
+(
+    Monitor_t* monitorPtr           ///< [IN] Monitor.
+)
+{
+    char content[MAX_EVENTS_FILE_BYTES];
+    uint64_t populated;
+
+    if ( (ReadEventsFile(monitorPtr, content, sizeof(content)) != LE_OK) ||
+         (GetKeyedValue(content, "populated", &populated) != LE_OK) )
+    {
+        return;
+    }
+
+    bool wasPopulated = monitorPtr->isPopulated;
+    monitorPtr->isPopulated = (populated != 0);
+
+    if (wasPopulated && !monitorPtr->isPopulated)
+    {
+        ReportEvent(monitorPtr, CGRP_EVENT_EMPTY);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Updates the memory event counters of a memory events monitor, and reports the counters that
+ * increased.
+ */
+//--------------------------------------------------------------------------------------------------
+static void UpdateMemEvents
+(
+    Monitor_t* monitorPtr,          ///< [IN] Monitor.
+    bool isReported                 ///< [IN] false to only record the current counters.
+)
+{
+    char content[MAX_EVENTS_FILE_BYTES];
+
+    if (ReadEventsFile(monitorPtr, content, sizeof(content)) != LE_OK)
+    {
+        return;
+    }
+
+    MemEvent_t memEvent;
+    bool isIncreased[NUM_MEM_EVENTS] = {false};
+
+    for (memEvent = 0; memEvent < NUM_MEM_EVENTS; memEvent++)
+    {
+        uint64_t count;
+
+        if ( (GetKeyedValue(content, MemEventName[memEvent], &count) == LE_OK) &&
+             (count != monitorPtr->memEventCount[memEvent]) )
+        {
+            monitorPtr->memEventCount[memEvent] = count;
+            isIncreased[memEvent] = true;
+        }
+    }
+
+    for (memEvent = 0; isReported && (memEvent < NUM_MEM_EVENTS); memEvent++)
+    {
+        if (isIncreased[memEvent])
+        {
+            ReportEvent(monitorPtr, MemEventType[memEvent]);
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler of the events on a monitored file.
+ */
+//--------------------------------------------------------------------------------------------------
+static void MonitorEventHandler
+(
+    int fd,                         ///< [IN] Monitored file.
+    short events                    ///< [IN] Events that happened.
+)
+{
+    Monitor_t* monitorPtr = le_fdMonitor_GetContextPtr();
+
+    // Keep the monitor until this function returns, the handlers may remove it.
+    le_mem_AddRef(monitorPtr);
+
+    switch (monitorPtr->type)
+    {
+        case MONITOR_PRESSURE:
+            if (events & POLLERR)
+            {
+                // The trigger is destroyed with its cgroup.
+                LE_DEBUG("Pressure trigger of cgroup '%s' is gone.", monitorPtr->cgroupName);
+                StopMonitor(monitorPtr);
+            }
+            else if (events & POLLPRI)
+            {
+                ReportEvent(monitorPtr, PressureEvent[monitorPtr->resource]);
+            }
+            break;
+
+        case MONITOR_EMPTY:
+            UpdatePopulated(monitorPtr);
+            break;
+
+        case MONITOR_MEM_EVENTS:
+            UpdateMemEvents(monitorPtr, true);
+            break;
+    }
+
+    le_mem_Release(monitorPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates a monitor of an opened file and starts monitoring it.
+ *
+ * @return
+ *      The monitor.
+ */
+//--------------------------------------------------------------------------------------------------
+static Monitor_t* CreateMonitor
+(
+    MonitorType_t type,                     ///< [IN] Kind of monitor.
+    const char* cgroupNamePtr,              ///< [IN] Name of the cgroup, NULL for the system.
+    int fd,                                 ///< [IN] File to monitor.
+    cgrp_EventHandlerFunc_t handlerFunc,    ///< [IN] Handler.
+    void* contextPtr                        ///< [IN] Context of the handler.
+)
+{
+    LE_ASSERT(handlerFunc != NULL);
+
+    Monitor_t* monitorPtr = le_mem_ForceAlloc(MonitorPool);
+
+    memset(monitorPtr, 0, sizeof(*monitorPtr));
+    monitorPtr->type = type;
+    monitorPtr->fd = fd;
+    monitorPtr->handlerFunc = handlerFunc;
+    monitorPtr->contextPtr = contextPtr;
+
+    if (cgroupNamePtr != NULL)
+    {
+        LE_ASSERT(le_utf8_Copy(monitorPtr->cgroupName, cgroupNamePtr,
+                               sizeof(monitorPtr->cgroupName), NULL) == LE_OK);
+    }
+
+    char name[LIMIT_MAX_PATH_BYTES];
+    snprintf(name, sizeof(name), "cgrp:%s", (cgroupNamePtr != NULL) ? cgroupNamePtr : "");
+
+    monitorPtr->fdMonitorRef = le_fdMonitor_Create(name, fd, MonitorEventHandler, POLLPRI);
+    le_fdMonitor_SetContextPtr(monitorPtr->fdMonitorRef, monitorPtr);
+
+    return monitorPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds a handler called when the tasks of a cgroup, or of the system, stall on a resource for
+ * longer than a threshold within a time window.  The kernel checks the threshold and wakes up the
+ * caller only when it is crossed, so no polling is involved.
+ *
+ * The handler is called with a CGRP_EVENT_*_PRESSURE event.
+ *
+ * @note The window must be between 500 ms and 10 s, and the stall time must not exceed the window.
+ *       Without the CAP_SYS_RESOURCE capability, the window must be a multiple of 2 s.
+ *
+ * @return
+ *      Reference to the monitor if successful.
+ *      NULL if pressure stall information is not available or if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+cgrp_MonitorRef_t cgrp_AddPressureHandler
+(
+    const char* cgroupNamePtr,              ///< [IN] Name of the cgroup, NULL for the system.
+    cgrp_Resource_t resource,               ///< [IN] Resource.
+    uint32_t stallUs,                       ///< [IN] Stall time threshold, in microseconds.
+    uint32_t windowUs,                      ///< [IN] Time window, in microseconds.
+    cgrp_EventHandlerFunc_t handlerFunc,    ///< [IN] Handler.
+    void* contextPtr                        ///< [IN] Context of the handler.
+)
+{
+    char path[LIMIT_MAX_PATH_BYTES];
+
+    if (BuildPressurePath(cgroupNamePtr, resource, path, sizeof(path)) != LE_OK)
+    {
+        return NULL;
+    }
+
+    int fd;
+
+    do
+    {
+        fd = open(path, O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    }
+    while ((fd < 0) && (errno == EINTR));
+
+    if (fd < 0)
+    {
+        LE_WARN("Pressure stall information is not available from '%s'.  %m.", path);
+        return NULL;
+    }
+
+    // The trigger lives as long as the file stays open.
+    char trigger[MAX_DIGITS];
+    LE_ASSERT(snprintf(trigger, sizeof(trigger), "some %" PRIu32 " %" PRIu32, stallUs, windowUs)
+              < sizeof(trigger));
+
+    // The trigger string must be written with its terminator.
+    if (write(fd, trigger, strlen(trigger) + 1) < 0)
+    {
+        LE_ERROR("Could not set pressure trigger '%s' on '%s'.  %m.", trigger, path);
+        fd_Close(fd);
+        return NULL;
+    }
+
+    Monitor_t* monitorPtr = CreateMonitor(MONITOR_PRESSURE, cgroupNamePtr, fd,
+                                          handlerFunc, contextPtr);
+    monitorPtr->resource = resource;
+
+    return monitorPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds a handler called with CGRP_EVENT_EMPTY when the last process of a cgroup exits.
+ *
+ * @note Only available in the unified hierarchy.  With a hierarchy per sub-system, the
+ *       notify_on_release mechanism of the freezer sub-system is used instead.
+ *
+ * @return
+ *      Reference to the monitor if successful.
+ *      NULL if the unified hierarchy is not used or if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+cgrp_MonitorRef_t cgrp_AddEmptyHandler
+(
+    const char* cgroupNamePtr,              ///< [IN] Name of the cgroup.
+    cgrp_EventHandlerFunc_t handlerFunc,    ///< [IN] Handler.
+    void* contextPtr                        ///< [IN] Context of the handler.
+)
+{
+    if (!cgrp_IsUnified())
+    {
+        return NULL;
+    }
+
+    int fd = OpenCgrpFile(CGRP_SUBSYS_FREEZE, cgroupNamePtr, V2_EVENTS_FILENAME,
+                          O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0)
+    {
+        return NULL;
+    }
+
+    Monitor_t* monitorPtr = CreateMonitor(MONITOR_EMPTY, cgroupNamePtr, fd,
+                                          handlerFunc, contextPtr);
+
+    // Get the current state, this also acknowledges the changes signalled so far.
+    UpdatePopulated(monitorPtr);
+
+    return monitorPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds a handler called when the memory usage of a cgroup goes over its high limit
+ * (CGRP_EVENT_MEM_HIGH), reaches its hard limit (CGRP_EVENT_MEM_MAX), or when the OOM killer kills
+ * one of its tasks (CGRP_EVENT_OOM_KILL).
+ *
+ * @note Only available in the unified hierarchy.
+ *
+ * @return
+ *      Reference to the monitor if successful.
+ *      NULL if the unified hierarchy is not used or if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+cgrp_MonitorRef_t cgrp_mem_AddEventHandler
+(
+    const char* cgroupNamePtr,              ///< [IN] Name of the cgroup.
+    cgrp_EventHandlerFunc_t handlerFunc,    ///< [IN] Handler.
+    void* contextPtr                        ///< [IN] Context of the handler.
+)
+{
+    if (!cgrp_IsUnified())
+    {
+        return NULL;
+    }
+
+    int fd = OpenCgrpFile(CGRP_SUBSYS_MEM, cgroupNamePtr, V2_MEM_EVENTS_FILENAME,
+                          O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0)
+    {
+        return NULL;
+    }
+
+    Monitor_t* monitorPtr = CreateMonitor(MONITOR_MEM_EVENTS, cgroupNamePtr, fd,
+                                          handlerFunc, contextPtr);
+
+    // Only the events that happen from now on are reported.
+    UpdateMemEvents(monitorPtr, false);
+
+    return monitorPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Removes a handler added by cgrp_AddPressureHandler(), cgrp_AddEmptyHandler() or
+ * cgrp_mem_AddEventHandler().  The handler is not called anymore once this returns, even from the
+ * handler of another event being reported.
+ */
+//--------------------------------------------------------------------------------------------------
+void cgrp_RemoveHandler
+(
+    cgrp_MonitorRef_t monitorRef            ///< [IN] Monitor.
+)
+{
+    Monitor_t* monitorPtr = monitorRef;
+
+    StopMonitor(monitorPtr);
+    monitorPtr->handlerFunc = NULL;
+
+    le_mem_Release(monitorPtr);
+}
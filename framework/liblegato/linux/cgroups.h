@@ -6,6 +6,8 @@
  * @ref c_cgrp_settingAttributes <br>
  * @ref c_cgrp_addingProcesses <br>
  * @ref c_cgrp_delete <br>
+ * @ref c_cgrp_unified <br>
+ * @ref c_cgrp_events <br>
  * @ref c_cgrp_threadSafety <br>
  *
  *
@@ -92,6 +94,34 @@
  * processes.
  *
  *
+ * @section c_cgrp_unified Unified Hierarchy
+ *
+ * If the cgroup v2 unified hierarchy is mounted on /sys/fs/cgroup, it is used instead of a
+ * hierarchy per sub-system.  All sub-systems then share a single hierarchy and a cgroup is the same
+ * group in every sub-system, so it only needs to be created, populated and deleted once.
+ * cgrp_IsUnified() tells which mode is used.  The functions of this API keep the same meaning in
+ * both modes, for example the cpu share is converted to a cpu weight.
+ *
+ * A kernel scheduling realtime processes by group rejects them from the cgroups that have the cpu
+ * controller.  With a hierarchy per sub-system they are simply not added to the cpu hierarchy, but
+ * in the unified hierarchy cgrp_cpu_Disable() has to remove the cpu controller from all the cgroups.
+ *
+ *
+ * @section c_cgrp_events Resource Events
+ *
+ * In the unified hierarchy the kernel signals resource events through the cgroup files, and these
+ * can be monitored by the event loop of the calling thread instead of polling the usage:
+ *
+ * - cgrp_AddPressureHandler() reports when the tasks stall on the cpu, memory or I/O for longer
+ *   than a threshold, using pressure stall information (PSI) triggers.  The system-wide pressure
+ *   is also available with a hierarchy per sub-system.
+ * - cgrp_mem_AddEventHandler() reports when the memory usage hits the high or hard limit, and when
+ *   the OOM killer kills a task.
+ * - cgrp_AddEmptyHandler() reports when the last process of the cgroup exits.
+ *
+ * cgrp_GetPressure() gets the current pressure stall averages.
+ *
+ *
  * @section c_cgrp_threadSafety Thread Safety
  *
  * The functions in this API are not thread safe.  Other synchronization methods must be used to
@@ -132,6 +162,75 @@ typedef enum
 cgrp_FreezeState_t;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Resources for which the kernel reports pressure stall information.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    CGRP_RESOURCE_CPU = 0,      ///< CPU.
+    CGRP_RESOURCE_MEM,          ///< Memory.
+    CGRP_RESOURCE_IO,           ///< Block I/O.
+    CGRP_NUM_RESOURCES          ///< Number of resources.  Must be the last item in this enum.
+}
+cgrp_Resource_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pressure stall information: share of the time some of the tasks waited for a resource.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t avg10;             ///< Average over the last 10 seconds, in hundredths of a percent.
+    uint32_t avg60;             ///< Average over the last 60 seconds, in hundredths of a percent.
+    uint32_t avg300;            ///< Average over the last 300 seconds, in hundredths of a percent.
+    uint64_t totalUs;           ///< Total stall time, in microseconds.
+}
+cgrp_Pressure_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Cgroup resource events.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    CGRP_EVENT_EMPTY = 0,       ///< The last process of the cgroup exited.
+    CGRP_EVENT_CPU_PRESSURE,    ///< The tasks stalled on the cpu over the threshold.
+    CGRP_EVENT_MEM_PRESSURE,    ///< The tasks stalled on memory over the threshold.
+    CGRP_EVENT_IO_PRESSURE,     ///< The tasks stalled on I/O over the threshold.
+    CGRP_EVENT_MEM_HIGH,        ///< The memory usage went over the high limit and was throttled.
+    CGRP_EVENT_MEM_MAX,         ///< The memory usage reached the hard limit.
+    CGRP_EVENT_OOM_KILL         ///< The OOM killer killed a task of the cgroup.
+}
+cgrp_Event_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler of cgroup resource events.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef void (*cgrp_EventHandlerFunc_t)
+(
+    const char* cgroupNamePtr,  ///< [IN] Name of the cgroup, NULL for a system-wide event.
+    cgrp_Event_t event,         ///< [IN] Event.
+    void* contextPtr            ///< [IN] Context given when the handler was added.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reference to a cgroup event monitor.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct cgrp_Monitor* cgrp_MonitorRef_t;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Initializes cgroups for the system.  Sets up a hierarchy for each supported subsystem.
@@ -148,6 +247,22 @@ void cgrp_Init
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks whether the cgroup root is the cgroup v2 unified hierarchy.  In this mode all the
+ * sub-systems share a single hierarchy, and a cgroup has the same directory for all sub-systems.
+ *
+ * @return
+ *      true if the unified hierarchy is used.
+ *      false if a hierarchy is mounted for each sub-system.
+ */
+//--------------------------------------------------------------------------------------------------
+bool cgrp_IsUnified
+(
+    void
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Creates a cgroup with the specified name in the specified sub-system.  If the cgroup already
@@ -340,6 +455,41 @@ le_result_t cgrp_cpu_SetShare
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks whether the cpu controller applies to the cgroups.  It is always the case with a hierarchy
+ * per sub-system.
+ *
+ * @return
+ *      true if the cpu controller is enabled.
+ *      false otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+bool cgrp_cpu_IsEnabled
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Disables the cpu controller for all the cgroups of the unified hierarchy.  A kernel scheduling
+ * realtime processes by group only accepts them in the root cgroup of the cpu controller, which in
+ * the unified hierarchy means that no other cgroup has the cpu controller.  The cpu shares are then
+ * ignored.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_UNSUPPORTED if a hierarchy is mounted for each sub-system.
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t cgrp_cpu_Disable
+(
+    void
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Sets the memory limit for a cgroup.
@@ -435,4 +585,124 @@ ssize_t cgrp_GetMaxMemUsed
     const char* cgroupNamePtr       ///< [IN] Name of the cgroup.
 );
 
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets the memory high limit of a cgroup.  Above this limit the kernel throttles the allocations of
+ * the processes in the cgroup and reclaims their memory, instead of invoking the OOM killer.
+ *
+ * @note Only available in the unified hierarchy.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_UNSUPPORTED if the unified hierarchy is not used.
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t cgrp_mem_SetHighLimit
+(
+    const char* cgroupNamePtr,      ///< Name of the cgroup to set the limit for.
+    size_t limit                    ///< Memory high limit in kilobytes.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the pressure stall information of a resource: how long some of the tasks of a cgroup, or of
+ * the system, waited for the resource.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_UNSUPPORTED if the kernel does not provide pressure stall information for the cgroup.
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t cgrp_GetPressure
+(
+    const char* cgroupNamePtr,      ///< [IN] Name of the cgroup, NULL for the whole system.
+    cgrp_Resource_t resource,       ///< [IN] Resource.
+    cgrp_Pressure_t* pressurePtr    ///< [OUT] Pressure.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds a handler called when the tasks of a cgroup, or of the system, stall on a resource for
+ * longer than a threshold within a time window.  The kernel checks the threshold and wakes up the
+ * caller only when it is crossed, so no polling is involved.
+ *
+ * The handler is called with a CGRP_EVENT_*_PRESSURE event.
+ *
+ * @note The window must be between 500 ms and 10 s, and the stall time must not exceed the window.
+ *       Without the CAP_SYS_RESOURCE capability, the window must be a multiple of 2 s.
+ *
+ * @return
+ *      Reference to the monitor if successful.
+ *      NULL if pressure stall information is not available or if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+cgrp_MonitorRef_t cgrp_AddPressureHandler
+(
+    const char* cgroupNamePtr,              ///< [IN] Name of the cgroup, NULL for the system.
+    cgrp_Resource_t resource,               ///< [IN] Resource.
+    uint32_t stallUs,                       ///< [IN] Stall time threshold, in microseconds.
+    uint32_t windowUs,                      ///< [IN] Time window, in microseconds.
+    cgrp_EventHandlerFunc_t handlerFunc,    ///< [IN] Handler.
+    void* contextPtr                        ///< [IN] Context of the handler.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds a handler called with CGRP_EVENT_EMPTY when the last process of a cgroup exits.
+ *
+ * @note Only available in the unified hierarchy.  With a hierarchy per sub-system, the
+ *       notify_on_release mechanism of the freezer sub-system is used instead.
+ *
+ * @return
+ *      Reference to the monitor if successful.
+ *      NULL if the unified hierarchy is not used or if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+cgrp_MonitorRef_t cgrp_AddEmptyHandler
+(
+    const char* cgroupNamePtr,              ///< [IN] Name of the cgroup.
+    cgrp_EventHandlerFunc_t handlerFunc,    ///< [IN] Handler.
+    void* contextPtr                        ///< [IN] Context of the handler.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds a handler called when the memory usage of a cgroup goes over its high limit
+ * (CGRP_EVENT_MEM_HIGH), reaches its hard limit (CGRP_EVENT_MEM_MAX), or when the OOM killer kills
+ * one of its tasks (CGRP_EVENT_OOM_KILL).
+ *
+ * @note Only available in the unified hierarchy.
+ *
+ * @return
+ *      Reference to the monitor if successful.
+ *      NULL if the unified hierarchy is not used or if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+cgrp_MonitorRef_t cgrp_mem_AddEventHandler
+(
+    const char* cgroupNamePtr,              ///< [IN] Name of the cgroup.
+    cgrp_EventHandlerFunc_t handlerFunc,    ///< [IN] Handler.
+    void* contextPtr                        ///< [IN] Context of the handler.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Removes a handler added by cgrp_AddPressureHandler(), cgrp_AddEmptyHandler() or
+ * cgrp_mem_AddEventHandler().  The handler is not called anymore once this returns, even from the
+ * handler of another event being reported.
+ */
+//--------------------------------------------------------------------------------------------------
+void cgrp_RemoveHandler
+(
+    cgrp_MonitorRef_t monitorRef            ///< [IN] Monitor.
+);
+
 #endif // LEGATO_SRC_CGROUPS_INCLUDE_GUARD
@@ -21,6 +21,14 @@
 #define MAX_MSG_SIZE            256
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of bytes in the source file name of a call site rule, including the terminator.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_CALLSITE_FILE_NAME_BYTES    128
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Log severity strings.
@@ -63,6 +71,8 @@ typedef struct le_log_Session
     le_log_Level_t level;               ///< The component's severity level filter.
                                         ///  Log messages with severity less than this are ignored.
     le_sls_List_t keywordList;          ///< The list of keywords for this component.
+    le_sls_List_t callSiteRuleList;     ///< The list of call site rules for this component.
+    le_log_CallSite_t* callSiteListPtr; ///< The call sites registered in this component.
     le_sls_Link_t link;                 ///< The link used for linking with the SessionList.
 }
 LogSession_t;
@@ -94,6 +104,8 @@ static LogSession_t DefaultLogSession =    {
                                             .componentNamePtr="<invalid>",
                                             .level=LOG_DEFAULT_LOG_FILTER,
                                             .keywordList=LE_SLS_LIST_INIT,
+                                            .callSiteRuleList=LE_SLS_LIST_INIT,
+                                            .callSiteListPtr=NULL,
                                             .link=LE_SLS_LINK_INIT
                                         };
 
@@ -120,6 +132,31 @@ KeywordObj_t;
 static le_mem_PoolRef_t KeywordMemPool;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * A call site rule, set by the log control tool to enable or disable the call sites of a source
+ * file, or of one of its lines.  The rules are kept so that they also apply to the call sites
+ * registered later.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_sls_Link_t link;                             // The link in the call site rule list.
+    char fileName[MAX_CALLSITE_FILE_NAME_BYTES];    // The source file name.
+    unsigned int lineNumber;                        // The line number, or 0 for the whole file.
+    bool isEnabled;                                 // true if the call sites are enabled.
+}
+CallSiteRule_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A memory pool where we get the memory for the call site rules.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t CallSiteRuleMemPool;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * c_messaging Session Reference used to communicate with the Log Control Daemon.
@@ -356,6 +393,169 @@ static void DisableTrace
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the rule for a source file or a line of a source file.
+ *
+ * @return A pointer to the rule or NULL if not found.
+ *
+ * @warning Assumes that mutex is already locked by the caller.
+ */
+//--------------------------------------------------------------------------------------------------
+static CallSiteRule_t* GetCallSiteRule
+(
+    le_sls_List_t* ruleListPtr,     // The rule list to search in.
+    const char* fileNamePtr,        // The source file name.
+    unsigned int lineNumber         // The line number, or 0 for the whole file.
+)
+{
+    le_sls_Link_t* linkPtr = le_sls_Peek(ruleListPtr);
+
+    while (linkPtr)
+    {
+        CallSiteRule_t* rulePtr = CONTAINER_OF(linkPtr, CallSiteRule_t, link);
+
+        if ((rulePtr->lineNumber == lineNumber) && (strcmp(rulePtr->fileName, fileNamePtr) == 0))
+        {
+            return rulePtr;
+        }
+        linkPtr = le_sls_PeekNext(ruleListPtr, linkPtr);
+    }
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the state a call site must have according to the rules of its log session.  A rule for its
+ * line takes precedence over a rule for its whole file.
+ *
+ * @return LE_LOG_CALLSITE_ENABLED or LE_LOG_CALLSITE_DISABLED.
+ *
+ * @warning Assumes that mutex is already locked by the caller.
+ */
+//--------------------------------------------------------------------------------------------------
+static int GetCallSiteState
+(
+    LogSession_t* sessionPtr,
+    const le_log_CallSite_t* callSitePtr
+)
+{
+    if (le_sls_IsEmpty(&sessionPtr->callSiteRuleList))
+    {
+        return LE_LOG_CALLSITE_ENABLED;
+    }
+
+    const char* fileNamePtr = le_path_GetBasenamePtr((char*)callSitePtr->fileNamePtr, "/");
+
+    CallSiteRule_t* rulePtr = GetCallSiteRule(&sessionPtr->callSiteRuleList,
+                                              fileNamePtr,
+                                              callSitePtr->lineNumber);
+    if (rulePtr == NULL)
+    {
+        rulePtr = GetCallSiteRule(&sessionPtr->callSiteRuleList, fileNamePtr, 0);
+    }
+
+    if ((rulePtr != NULL) && !rulePtr->isEnabled)
+    {
+        return LE_LOG_CALLSITE_DISABLED;
+    }
+
+    return LE_LOG_CALLSITE_ENABLED;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Enable or disable the call sites of a source file, or of one of its lines.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SetCallSite
+(
+    const char* componentNamePtr,   // The component that contains the call sites.
+    const char* callSiteSpecPtr,    // The call sites: "fileName" or "fileName:lineNumber".
+    bool isEnabled                  // true to enable the call sites, false to disable them.
+)
+{
+    char fileName[MAX_CALLSITE_FILE_NAME_BYTES];
+    unsigned int lineNumber = 0;
+    size_t numBytes;
+
+    if (le_utf8_CopyUpToSubStr(fileName, callSiteSpecPtr, ":", sizeof(fileName), &numBytes)
+        != LE_OK)
+    {
+        LE_ERROR("Call site file name too long in '%s'.", callSiteSpecPtr);
+        return;
+    }
+
+    if (callSiteSpecPtr[numBytes] == ':')
+    {
+        char* endPtr;
+
+        errno = 0;
+        unsigned long value = strtoul(callSiteSpecPtr + numBytes + 1, &endPtr, 10);
+        if ((errno != 0) || (*endPtr != '\0') || (value == 0) || (value > UINT_MAX))
+        {
+            LE_ERROR("Invalid call site line number in '%s'.", callSiteSpecPtr);
+            return;
+        }
+        lineNumber = value;
+    }
+
+    Lock();
+
+    // Find the session for this component.
+    LogSession_t* sessionPtr = GetSession(componentNamePtr);
+
+    if (sessionPtr)
+    {
+        // Create or update the rule.
+        CallSiteRule_t* rulePtr = GetCallSiteRule(&sessionPtr->callSiteRuleList,
+                                                  fileName,
+                                                  lineNumber);
+        if (rulePtr == NULL)
+        {
+            rulePtr = le_mem_ForceAlloc(CallSiteRuleMemPool);
+            LE_ASSERT(le_utf8_Copy(rulePtr->fileName, fileName, sizeof(rulePtr->fileName), NULL)
+                      == LE_OK);
+            rulePtr->lineNumber = lineNumber;
+            rulePtr->link = LE_SLS_LINK_INIT;
+            le_sls_Queue(&sessionPtr->callSiteRuleList, &rulePtr->link);
+        }
+        rulePtr->isEnabled = isEnabled;
+
+        // A rule for the whole file overrides the rules previously set for its lines.
+        if (lineNumber == 0)
+        {
+            le_sls_Link_t* linkPtr = le_sls_Peek(&sessionPtr->callSiteRuleList);
+
+            while (linkPtr)
+            {
+                CallSiteRule_t* lineRulePtr = CONTAINER_OF(linkPtr, CallSiteRule_t, link);
+
+                if (strcmp(lineRulePtr->fileName, fileName) == 0)
+                {
+                    lineRulePtr->isEnabled = isEnabled;
+                }
+                linkPtr = le_sls_PeekNext(&sessionPtr->callSiteRuleList, linkPtr);
+            }
+        }
+
+        // Apply the rules to the call sites already registered.
+        le_log_CallSite_t* callSitePtr = sessionPtr->callSiteListPtr;
+
+        while (callSitePtr)
+        {
+            callSitePtr->state = GetCallSiteState(sessionPtr, callSitePtr);
+            callSitePtr = callSitePtr->nextPtr;
+        }
+    }
+
+    Unlock();
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Set the log level filter for a specific component.
@@ -401,6 +601,8 @@ static LogSession_t* CreateSession
     logSessionPtr->componentNamePtr = componentNamePtr;
     logSessionPtr->level = DefaultLogSession.level;
     logSessionPtr->keywordList = LE_SLS_LIST_INIT;
+    logSessionPtr->callSiteRuleList = LE_SLS_LIST_INIT;
+    logSessionPtr->callSiteListPtr = NULL;
     logSessionPtr->link = LE_SLS_LINK_INIT;
 
     Lock();
@@ -661,6 +863,14 @@ static void ProcessLogCmd
                 DisableTrace(componentName, commandDataPtr);
                 break;
 
+            case LOG_CMD_ENABLE_CALLSITE:
+                SetCallSite(componentName, commandDataPtr, true);
+                break;
+
+            case LOG_CMD_DISABLE_CALLSITE:
+                SetCallSite(componentName, commandDataPtr, false);
+                break;
+
             default:
                 LE_ERROR("Invalid command character '%c'.", command);
                 break;
@@ -756,6 +966,9 @@ void log_Init
     KeywordMemPool = le_mem_CreatePool("TraceKeys", sizeof(KeywordObj_t));
     le_mem_ExpandPool(KeywordMemPool, 10);   /// @todo Make this configurable.
 
+    // Create the call site rule memory pool.
+    CallSiteRuleMemPool = le_mem_CreatePool("CallSiteRules", sizeof(CallSiteRule_t));
+
     // Create the session memory pool.
     SessionMemPool = le_mem_CreatePool("LogSession", sizeof(LogSession_t));
     le_mem_ExpandPool(SessionMemPool, 10);  /// @todo Make this configurable.
@@ -1022,7 +1235,7 @@ static int ConvertToSyslogLevel
  * Builds the log message and sends it to the logging system.
  */
 //--------------------------------------------------------------------------------------------------
-void _le_log_Send
+static void SendMsg
 (
     const le_log_Level_t level,         // The severity level. Set to -1 if this is a Trace log.
     const le_log_TraceRef_t traceRef,   // The Trace reference. Set to NULL if this is not a Trace log.
@@ -1030,7 +1243,8 @@ void _le_log_Send
     const char* filenamePtr,            // The name of the source file that logged the message.
     const char* functionNamePtr,        // The name of the function that logged the message.
     const unsigned int lineNumber,      // The line number in the source file that logged the message.
-    const char* formatPtr, ...          // The user message format and options.
+    const char* formatPtr,              // The user message format.
+    va_list varParams                   // The user message options.
 )
 {
     // Save the current errno to be used in the log message because some of the system calls below
@@ -1090,9 +1304,6 @@ void _le_log_Send
     // Get the user message.
     char msg[MAX_MSG_SIZE] = "";
 
-    va_list varParams;
-    va_start(varParams, formatPtr);
-
     // Reset the errno to ensure that we report the proper errno value.
     errno = savedErrno;
 
@@ -1100,8 +1311,6 @@ void _le_log_Send
     // it.  If there was a truncation then that'll just show up in the logs.
     vsnprintf(msg, sizeof(msg), formatPtr, varParams);
 
-    va_end(varParams);
-
     // If running on an embedded target, write the message out to the log.
 #ifdef LEGATO_EMBEDDED
 
@@ -1132,6 +1341,87 @@ void _le_log_Send
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Builds the log message and sends it to the logging system.
+ */
+//--------------------------------------------------------------------------------------------------
+void _le_log_Send
+(
+    const le_log_Level_t level,         // The severity level. Set to -1 if this is a Trace log.
+    const le_log_TraceRef_t traceRef,   // The Trace reference. Set to NULL if this is not a Trace log.
+    le_log_SessionRef_t logSession,     // The log session.
+    const char* filenamePtr,            // The name of the source file that logged the message.
+    const char* functionNamePtr,        // The name of the function that logged the message.
+    const unsigned int lineNumber,      // The line number in the source file that logged the message.
+    const char* formatPtr, ...          // The user message format and options.
+)
+{
+    va_list varParams;
+    va_start(varParams, formatPtr);
+
+    SendMsg(level, traceRef, logSession, filenamePtr, functionNamePtr, lineNumber,
+            formatPtr, varParams);
+
+    va_end(varParams);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Builds the log message of a call site and sends it to the logging system.
+ *
+ * The first time a call site sends a message in a log session, it is registered in that session
+ * and the call site rules of the session are applied to it.  The message is dropped if the call
+ * site is disabled by these rules.
+ */
+//--------------------------------------------------------------------------------------------------
+void _le_log_SendSite
+(
+    le_log_CallSite_t* callSitePtr,     // The call site.
+    const le_log_TraceRef_t traceRef,   // The Trace reference. Set to NULL if this is not a Trace log.
+    le_log_SessionRef_t logSession,     // The log session.
+    const char* functionNamePtr,        // The name of the function that logged the message.
+    const char* formatPtr, ...          // The user message format and options.
+)
+{
+    // Call sites logging before their component is registered are not registered either, as
+    // they cannot be controlled yet.
+    if ((callSitePtr->state == LE_LOG_CALLSITE_NEW) && (logSession != NULL))
+    {
+        int savedErrno = errno;
+
+        Lock();
+
+        // Another thread may have registered the call site in the meantime.
+        if (callSitePtr->state == LE_LOG_CALLSITE_NEW)
+        {
+            callSitePtr->logSession = logSession;
+            callSitePtr->nextPtr = logSession->callSiteListPtr;
+            logSession->callSiteListPtr = callSitePtr;
+            callSitePtr->state = GetCallSiteState(logSession, callSitePtr);
+        }
+
+        Unlock();
+
+        errno = savedErrno;
+
+        if (callSitePtr->state == LE_LOG_CALLSITE_DISABLED)
+        {
+            return;
+        }
+    }
+
+    va_list varParams;
+    va_start(varParams, formatPtr);
+
+    SendMsg(callSitePtr->level, traceRef, logSession, callSitePtr->fileNamePtr,
+            functionNamePtr, callSitePtr->lineNumber, formatPtr, varParams);
+
+    va_end(varParams);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Get a null-terminated, printable string representing an le_result_t value.
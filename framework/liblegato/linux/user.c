@@ -15,6 +15,11 @@
  * Groups are created and deleted by modifying the /etc/group file.  File update and locking is
  * handled in the same way as the passwd file.
  *
+ * Lookups are served from an in-memory index of the passwd and group files, hashed by name and by
+ * ID, so that creating the users, groups and supplementary groups of an app does not scan the files
+ * for every name.  The index is rebuilt on the first lookup after an inotify notification reports
+ * that one of the files, or the apps translation table, was replaced or written.
+ *
  * Copyright (C) Sierra Wireless Inc.
  */
 
@@ -26,6 +31,7 @@
 #include <grp.h>
 #include <sys/file.h>
 #include <sys/sendfile.h>
+#include <sys/inotify.h>
 
 
 //--------------------------------------------------------------------------------------------------
@@ -101,7 +107,8 @@ static size_t MaxGroupEntrySize = LIMIT_MAX_PATH_BYTES;
  * /etc/group.
  */
 //--------------------------------------------------------------------------------------------------
-#define APPS_TRANSLATION_FILE   "/legato/systems/current/config/appsTab.bin"
+#define APPS_TRANSLATION_DIR    "/legato/systems/current/config"
+#define APPS_TRANSLATION_FILE   APPS_TRANSLATION_DIR "/appsTab.bin"
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -146,6 +153,115 @@ static le_mem_PoolRef_t AppsTabPool = NULL;
 //--------------------------------------------------------------------------------------------------
 static bool IsEtcWritable = false;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Entry of the user or group index.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_dls_Link_t link;                         ///< Link in the list of entries of the index.
+    char          name[LIMIT_MAX_USER_NAME_BYTES]; ///< User or group name.
+    uint32_t      id;                           ///< User ID or group ID.
+    gid_t         gid;                          ///< Primary group of a user.
+}
+IndexEntry_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Index of the passwd or group file.
+ *
+ * An entry whose name does not fit in an IndexEntry_t is not indexed and the index is marked
+ * incomplete, so that a lookup missing the index falls back to reading the file.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const char*      filePath;      ///< Indexed file.
+    le_hashmap_Ref_t byName;        ///< Entries by name, first entry of the file for a name.
+    le_hashmap_Ref_t byId;          ///< Entries by ID, first entry of the file for an ID.
+    le_dls_List_t    entryList;     ///< All the entries of the index.
+    bool             isValid;       ///< The index matches the file.
+    bool             isComplete;    ///< Every entry of the file is in the index.
+}
+Index_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Indexes of the passwd and group files.
+ */
+//--------------------------------------------------------------------------------------------------
+static Index_t UserIndex = { .filePath = PASSWORD_FILE, .entryList = LE_DLS_LIST_INIT };
+static Index_t GroupIndex = { .filePath = GROUP_FILE, .entryList = LE_DLS_LIST_INIT };
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool of index entries.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t IndexEntryPool = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The apps translation table in memory matches the file.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsAppsTabLoaded = false;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Non-blocking inotify descriptor reporting the changes of the indexed files, -1 if inotify is not
+ * available.  Without it the indexes are rebuilt on every lookup.
+ */
+//--------------------------------------------------------------------------------------------------
+static int IndexNotifyFd = -1;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Directories watched for the indexed files.  The directories are watched rather than the files
+ * because the files are replaced by a rename when they are updated.
+ */
+//--------------------------------------------------------------------------------------------------
+static struct
+{
+    const char* dirPath;    ///< Watched directory.
+    int         wd;         ///< Watch descriptor, -1 if the directory is not watched.
+}
+IndexWatches[] =
+{
+    { "/etc", -1 },
+    { APPS_TRANSLATION_DIR, -1 },
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of watched directories.  The apps translation table is only used, and its directory only
+ * watched, if /etc is not writable.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t IndexWatchCount = 1;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Events invalidating the indexed files of a watched directory.
+ */
+//--------------------------------------------------------------------------------------------------
+#define INDEX_WATCH_EVENTS  (IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | \
+                             IN_DELETE_SELF | IN_MOVE_SELF)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mutex protecting the indexes.
+ */
+//--------------------------------------------------------------------------------------------------
+static pthread_mutex_t Mutex = PTHREAD_MUTEX_INITIALIZER;   // POSIX "Fast" mutex.
+
+/// Locks the mutex.
+#define LOCK    LE_ASSERT(pthread_mutex_lock(&Mutex) == 0);
+
+/// Unlocks the mutex.
+#define UNLOCK  LE_ASSERT(pthread_mutex_unlock(&Mutex) == 0);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Updates the user or group ID range value from a string.  If the string contains the value to
@@ -553,10 +669,385 @@ void user_Init
 
         AppsTab = (appTab_t *)le_mem_ForceAlloc(AppsTabPool);
         memset(AppsTab, 0, sizeof(appTab_t) * NbAppsInTranslationTable);
+
+        IndexWatchCount = NUM_ARRAY_MEMBERS(IndexWatches);
+    }
+
+    // Create the user and group indexes, built on the first lookup.
+    IndexEntryPool = le_mem_CreatePool("UserIndexEntry", sizeof(IndexEntry_t));
+    UserIndex.byName = le_hashmap_Create("UserNames", 31,
+                                         le_hashmap_HashString, le_hashmap_EqualsString);
+    UserIndex.byId = le_hashmap_Create("UserIds", 31,
+                                       le_hashmap_HashUInt32, le_hashmap_EqualsUInt32);
+    GroupIndex.byName = le_hashmap_Create("GroupNames", 31,
+                                          le_hashmap_HashString, le_hashmap_EqualsString);
+    GroupIndex.byId = le_hashmap_Create("GroupIds", 31,
+                                        le_hashmap_HashUInt32, le_hashmap_EqualsUInt32);
+
+    IndexNotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (IndexNotifyFd < 0)
+    {
+        LE_WARN("Could not watch the user and group files, they will be read on every lookup.  %m");
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Invalidates the indexes and the apps translation table.
+ */
+//--------------------------------------------------------------------------------------------------
+static void InvalidateIndexes
+(
+    void
+)
+{
+    UserIndex.isValid = false;
+    GroupIndex.isValid = false;
+    IsAppsTabLoaded = false;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads the pending inotify events and invalidates the indexes of the files that changed.  A
+ * directory that could not be watched invalidates everything, so that the files are read again.
+ *
+ * @note Must be called with the mutex locked.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RefreshIndexes
+(
+    void
+)
+{
+    size_t i;
+
+    if (IndexNotifyFd < 0)
+    {
+        InvalidateIndexes();
+        return;
+    }
+
+    for (i = 0; i < IndexWatchCount; i++)
+    {
+        if (IndexWatches[i].wd < 0)
+        {
+            IndexWatches[i].wd = inotify_add_watch(IndexNotifyFd,
+                                                   IndexWatches[i].dirPath,
+                                                   INDEX_WATCH_EVENTS);
+            InvalidateIndexes();
+        }
+    }
+
+    char buf[sizeof(struct inotify_event) + NAME_MAX + 1]
+        __attribute__((aligned(__alignof__(struct inotify_event))));
+    ssize_t len;
+
+    while ((len = read(IndexNotifyFd, buf, sizeof(buf))) > 0)
+    {
+        char* ptr = buf;
+
+        while (ptr < buf + len)
+        {
+            const struct inotify_event* eventPtr = (const struct inotify_event*)ptr;
+
+            if (eventPtr->mask & (IN_Q_OVERFLOW | IN_IGNORED | IN_DELETE_SELF | IN_MOVE_SELF))
+            {
+                // Events may be lost, or a watched directory went away.  Watch the directories
+                // again by their path and read everything again.
+                for (i = 0; i < IndexWatchCount; i++)
+                {
+                    if ((eventPtr->wd == IndexWatches[i].wd) && !(eventPtr->mask & IN_IGNORED))
+                    {
+                        inotify_rm_watch(IndexNotifyFd, IndexWatches[i].wd);
+                    }
+                    if ((eventPtr->wd == IndexWatches[i].wd) || (eventPtr->mask & IN_Q_OVERFLOW))
+                    {
+                        IndexWatches[i].wd = -1;
+                    }
+                }
+                InvalidateIndexes();
+            }
+            else if (eventPtr->len > 0)
+            {
+                if (strcmp(eventPtr->name, le_path_GetBasenamePtr(PASSWORD_FILE, "/")) == 0)
+                {
+                    UserIndex.isValid = false;
+                }
+                else if (strcmp(eventPtr->name, le_path_GetBasenamePtr(GROUP_FILE, "/")) == 0)
+                {
+                    GroupIndex.isValid = false;
+                }
+                else if (strcmp(eventPtr->name,
+                                le_path_GetBasenamePtr(APPS_TRANSLATION_FILE, "/")) == 0)
+                {
+                    IsAppsTabLoaded = false;
+                }
+            }
+
+            ptr += sizeof(struct inotify_event) + eventPtr->len;
+        }
+    }
+
+    if ((len < 0) && (errno != EAGAIN) && (errno != EINTR))
+    {
+        LE_ERROR("Could not read the user index notifications.  %m");
+        InvalidateIndexes();
     }
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Removes all the entries of an index.
+ *
+ * @note Must be called with the mutex locked.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ClearIndex
+(
+    Index_t* indexPtr           ///< [IN] Index to clear.
+)
+{
+    le_dls_Link_t* linkPtr;
+
+    le_hashmap_RemoveAll(indexPtr->byName);
+    le_hashmap_RemoveAll(indexPtr->byId);
+
+    while ((linkPtr = le_dls_Pop(&indexPtr->entryList)) != NULL)
+    {
+        le_mem_Release(CONTAINER_OF(linkPtr, IndexEntry_t, link));
+    }
+
+    indexPtr->isValid = false;
+    indexPtr->isComplete = true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds an entry of the file to an index.  An entry whose name or ID is already in the index is only
+ * reachable by the other key, as the first entry of the file wins like for getpwnam() and friends.
+ *
+ * @note Must be called with the mutex locked.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddIndexEntry
+(
+    Index_t* indexPtr,          ///< [IN] Index to add to.
+    const char* namePtr,        ///< [IN] User or group name.
+    uint32_t id,                ///< [IN] User ID or group ID.
+    gid_t gid                   ///< [IN] Primary group of a user.
+)
+{
+    IndexEntry_t* entryPtr = le_mem_ForceAlloc(IndexEntryPool);
+
+    if (le_utf8_Copy(entryPtr->name, namePtr, sizeof(entryPtr->name), NULL) != LE_OK)
+    {
+        le_mem_Release(entryPtr);
+        indexPtr->isComplete = false;
+        return;
+    }
+
+    entryPtr->id = id;
+    entryPtr->gid = gid;
+    entryPtr->link = LE_DLS_LINK_INIT;
+    le_dls_Queue(&indexPtr->entryList, &entryPtr->link);
+
+    if (!le_hashmap_ContainsKey(indexPtr->byName, entryPtr->name))
+    {
+        le_hashmap_Put(indexPtr->byName, entryPtr->name, entryPtr);
+    }
+
+    if (!le_hashmap_ContainsKey(indexPtr->byId, &entryPtr->id))
+    {
+        le_hashmap_Put(indexPtr->byId, &entryPtr->id, entryPtr);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Rebuilds an index from its file if the file changed since the index was built.
+ *
+ * @note Does not lock the indexed file, the files are replaced atomically.
+ * @note Must be called with the mutex locked.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_FAULT if the file could not be read.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t UpdateIndex
+(
+    Index_t* indexPtr           ///< [IN] Index to update.
+)
+{
+    RefreshIndexes();
+
+    if (indexPtr->isValid)
+    {
+        return LE_OK;
+    }
+
+    ClearIndex(indexPtr);
+
+    FILE* filePtr = fopen(indexPtr->filePath, "r");
+    if (filePtr == NULL)
+    {
+        LE_ERROR("Could not open file %s.  %m.", indexPtr->filePath);
+        return LE_FAULT;
+    }
+
+    int err;
+
+    if (indexPtr == &UserIndex)
+    {
+        char buf[MaxPasswdEntrySize];
+        struct passwd pwd;
+        struct passwd* pwdPtr;
+
+        while (((err = fgetpwent_r(filePtr, &pwd, buf, sizeof(buf), &pwdPtr)) == 0) ||
+               (err == EINTR))
+        {
+            if (pwdPtr != NULL)
+            {
+                AddIndexEntry(indexPtr, pwd.pw_name, pwd.pw_uid, pwd.pw_gid);
+            }
+        }
+    }
+    else
+    {
+        char buf[MaxGroupEntrySize];
+        struct group grp;
+        struct group* grpPtr;
+
+        while (((err = fgetgrent_r(filePtr, &grp, buf, sizeof(buf), &grpPtr)) == 0) ||
+               (err == EINTR))
+        {
+            if (grpPtr != NULL)
+            {
+                AddIndexEntry(indexPtr, grp.gr_name, grp.gr_gid, grp.gr_gid);
+            }
+        }
+    }
+
+    fclose(filePtr);
+
+    if (err != ENOENT)
+    {
+        errno = err;
+        LE_ERROR("Could not read file %s.  %m.", indexPtr->filePath);
+        ClearIndex(indexPtr);
+        return LE_FAULT;
+    }
+
+    indexPtr->isValid = true;
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Looks up an entry of an index by name or by ID, and copies it.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_NOT_FOUND if the file has no such entry.
+ *      LE_UNAVAILABLE if the entry is not in the index, but the index is not complete or not
+ *                     initialized.
+ *      LE_FAULT if the file could not be read.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t LookupIndex
+(
+    Index_t* indexPtr,          ///< [IN] Index to look up.
+    const char* namePtr,        ///< [IN] Name to look for, or NULL to look for the ID.
+    uint32_t id,                ///< [IN] ID to look for if namePtr is NULL.
+    IndexEntry_t* entryPtr      ///< [OUT] Copy of the entry.
+)
+{
+    le_result_t result;
+
+    if (indexPtr->byName == NULL)
+    {
+        // user_Init() was not called, read the file.
+        return LE_UNAVAILABLE;
+    }
+
+    LOCK
+
+    result = UpdateIndex(indexPtr);
+    if (result == LE_OK)
+    {
+        IndexEntry_t* foundPtr = (namePtr != NULL ? le_hashmap_Get(indexPtr->byName, namePtr) :
+                                                    le_hashmap_Get(indexPtr->byId, &id));
+
+        if (foundPtr != NULL)
+        {
+            *entryPtr = *foundPtr;
+        }
+        else
+        {
+            result = (indexPtr->isComplete ? LE_NOT_FOUND : LE_UNAVAILABLE);
+        }
+    }
+
+    UNLOCK
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads the apps translation table into AppsTab, unless it did not change since it was last read.
+ * If the table does not exist the table in memory is kept.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_FAULT if the table could not be read.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t LoadAppsTab
+(
+    void
+)
+{
+    le_result_t result = LE_OK;
+
+    LOCK
+
+    RefreshIndexes();
+
+    if (!IsAppsTabLoaded)
+    {
+        FILE *fd = fopen(APPS_TRANSLATION_FILE, "r");
+        if (fd)
+        {
+            size_t rc;
+            rc = fread(AppsTab, sizeof(appTab_t), NbAppsInTranslationTable, fd);
+            fclose(fd);
+            if (NbAppsInTranslationTable != rc)
+            {
+                LE_ERROR("Read of apps translation table failed (rc %zu != %u)",
+                         rc, NbAppsInTranslationTable);
+                result = LE_FAULT;
+            }
+            else
+            {
+                IsAppsTabLoaded = true;
+            }
+        }
+    }
+
+    UNLOCK
+
+    return result;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Gets a user name from a user ID.
@@ -590,28 +1081,33 @@ static le_result_t GetName
         uint32_t ids = uid - BASE_MIN_UID;
 
         // /etc is not writable so try first to read the apps translation tab if it exist.
-        FILE *fd = fopen(APPS_TRANSLATION_FILE, "r");
-        if (fd)
+        if (LoadAppsTab() != LE_OK)
         {
-            size_t rc;
-            rc = fread(AppsTab, sizeof(appTab_t), NbAppsInTranslationTable, fd);
-            fclose(fd);
-            if (NbAppsInTranslationTable != rc)
-            {
-                LE_ERROR("Read of apps translation table failed (rc %zu != %u)",
-                         rc, NbAppsInTranslationTable);
-                return LE_FAULT;
-            }
+            return LE_FAULT;
+        }
 
-            // Check if the apps already exists in the apps translation table.
-            if ('\0' != AppsTab[ids].name[0])
-            {
-                // Copy the username to the caller's buffer.
-                return le_utf8_Copy(nameBufPtr, AppsTab[ids].name, nameBufSize, NULL);
-            }
+        // Check if the apps already exists in the apps translation table.
+        if ('\0' != AppsTab[ids].name[0])
+        {
+            // Copy the username to the caller's buffer.
+            return le_utf8_Copy(nameBufPtr, AppsTab[ids].name, nameBufSize, NULL);
         }
     }
 
+    // Look up the index, the file is read again only for the entries the index does not hold.
+    IndexEntry_t entry;
+    le_result_t result = LookupIndex(&UserIndex, NULL, uid, &entry);
+
+    if (result == LE_OK)
+    {
+        // Copy the username to the caller's buffer.
+        return le_utf8_Copy(nameBufPtr, entry.name, nameBufSize, NULL);
+    }
+    else if (result != LE_UNAVAILABLE)
+    {
+        return result;
+    }
+
     do
     {
         err = getpwuid_r(uid, &pwd, buf, sizeof(buf), &resultPtr);
@@ -672,28 +1168,33 @@ static le_result_t GetGroupName
         uint32_t ids = gid - BASE_MIN_UID;
 
         // /etc is not writable so try first to read the apps translation tab if it exist.
-        FILE *fd = fopen(APPS_TRANSLATION_FILE, "r");
-        if (fd)
+        if (LoadAppsTab() != LE_OK)
         {
-            size_t rc;
-            rc = fread(AppsTab, sizeof(appTab_t), NbAppsInTranslationTable, fd);
-            fclose(fd);
-            if (NbAppsInTranslationTable != rc)
-            {
-                LE_ERROR("Read of apps translation table failed (rc %zu != %u)",
-                         rc, NbAppsInTranslationTable);
-                return LE_FAULT;
-            }
+            return LE_FAULT;
+        }
 
-            // Check if the apps already exists in the apps translation table.
-            if ('\0' != AppsTab[ids].name[0])
-            {
-                // Copy the username to the caller's buffer.
-                return le_utf8_Copy(nameBufPtr, AppsTab[ids].name, nameBufSize, NULL);
-            }
+        // Check if the apps already exists in the apps translation table.
+        if ('\0' != AppsTab[ids].name[0])
+        {
+            // Copy the username to the caller's buffer.
+            return le_utf8_Copy(nameBufPtr, AppsTab[ids].name, nameBufSize, NULL);
         }
     }
 
+    // Look up the index, the file is read again only for the entries the index does not hold.
+    IndexEntry_t entry;
+    le_result_t result = LookupIndex(&GroupIndex, NULL, gid, &entry);
+
+    if (result == LE_OK)
+    {
+        // Copy the group name to the caller's buffer.
+        return le_utf8_Copy(nameBufPtr, entry.name, nameBufSize, NULL);
+    }
+    else if (result != LE_UNAVAILABLE)
+    {
+        return result;
+    }
+
     do
     {
         err = getgrgid_r(gid, &grp, buf, sizeof(buf), &resultPtr);
@@ -754,18 +1255,9 @@ static le_result_t GetIDs
     if (!IsEtcWritable)
     {
         // /etc is not writable so try first to read the apps translation tab if it exist.
-        FILE *fd = fopen(APPS_TRANSLATION_FILE, "r");
-        if (fd)
+        if (LoadAppsTab() != LE_OK)
         {
-            size_t rc;
-            rc = fread(AppsTab, sizeof(appTab_t), NbAppsInTranslationTable, fd);
-            fclose(fd);
-            if (NbAppsInTranslationTable != rc)
-            {
-                LE_ERROR("Read of apps translation table failed (rc %zu != %u)",
-                         rc, NbAppsInTranslationTable);
-                return LE_FAULT;
-            }
+            return LE_FAULT;
         }
 
         for (ids = 0; ids < NbAppsInTranslationTable; ids++)
@@ -782,6 +1274,29 @@ static le_result_t GetIDs
         }
     }
 
+    // Look up the index, the file is read again only for the entries the index does not hold.
+    IndexEntry_t entry;
+    le_result_t result = LookupIndex(&UserIndex, usernamePtr, 0, &entry);
+
+    if (result == LE_OK)
+    {
+        if (uidPtr != NULL)
+        {
+            *uidPtr = entry.id;
+        }
+
+        if (gidPtr != NULL)
+        {
+            *gidPtr = entry.gid;
+        }
+
+        return LE_OK;
+    }
+    else if (result != LE_UNAVAILABLE)
+    {
+        return result;
+    }
+
     do
     {
         err = getpwnam_r(usernamePtr, &pwd, buf, sizeof(buf), &resultPtr);
@@ -871,18 +1386,9 @@ static le_result_t GetGid
     if (!IsEtcWritable)
     {
         // /etc is not writable so try first to read the apps translation tab if it exist.
-        FILE *fd = fopen(APPS_TRANSLATION_FILE, "r");
-        if (fd)
+        if (LoadAppsTab() != LE_OK)
         {
-            size_t rc;
-            rc = fread(AppsTab, sizeof(appTab_t), NbAppsInTranslationTable, fd);
-            fclose(fd);
-            if (NbAppsInTranslationTable != rc)
-            {
-                LE_ERROR("Read of apps translation table failed (rc %zu != %u)",
-                         rc, NbAppsInTranslationTable);
-                return LE_FAULT;
-            }
+            return LE_FAULT;
         }
 
         for (ids = 0; ids < NbAppsInTranslationTable; ids++)
@@ -899,6 +1405,20 @@ static le_result_t GetGid
         }
     }
 
+    // Look up the index, the file is read again only for the entries the index does not hold.
+    IndexEntry_t entry;
+    le_result_t result = LookupIndex(&GroupIndex, groupNamePtr, 0, &entry);
+
+    if (result == LE_OK)
+    {
+        *gidPtr = entry.id;
+        return LE_OK;
+    }
+    else if (result != LE_UNAVAILABLE)
+    {
+        return result;
+    }
+
     do
     {
         err = getgrnam_r(groupNamePtr, &grp, buf, sizeof(buf), &resultPtr);
@@ -1158,18 +1678,10 @@ le_result_t user_Create
         // /etc is not writable. Use the apps translation table instead /etc/passwd.
         uint32_t ids;
         uint32_t uidfree = (uint32_t)-1;
-        FILE *fd = fopen(APPS_TRANSLATION_FILE, "r");
-        if (fd)
+        FILE *fd;
+        if (LoadAppsTab() != LE_OK)
         {
-            size_t rc;
-            rc = fread(AppsTab, sizeof(appTab_t), NbAppsInTranslationTable, fd);
-            fclose(fd);
-            if (NbAppsInTranslationTable != rc)
-            {
-                LE_ERROR("Read of apps translation table failed (rc %zu != %u)",
-                         rc, NbAppsInTranslationTable);
-                return LE_FAULT;
-            }
+            return LE_FAULT;
         }
 
         for (ids = 0; ids < NbAppsInTranslationTable; ids++)
@@ -1721,18 +2233,10 @@ static le_result_t DeleteUser
     else
     {
         uint32_t uid;
-        FILE* fd = fopen(APPS_TRANSLATION_FILE, "r");
-        if (fd)
+        FILE* fd;
+        if (LoadAppsTab() != LE_OK)
         {
-            size_t rc;
-            rc = fread(AppsTab, sizeof(appTab_t), NbAppsInTranslationTable, fd);
-            fclose(fd);
-            if (NbAppsInTranslationTable != rc)
-            {
-                LE_ERROR("Read of apps translation table failed (rc %zu != %u)",
-                         rc, NbAppsInTranslationTable);
-                return LE_FAULT;
-            }
+            return LE_FAULT;
         }
 
         for (uid = 0; uid < NbAppsInTranslationTable; uid++)
@@ -188,6 +188,7 @@ static void GenerateBasicInfo
     GenerateValue(defStream, "cpuShare", appPtr->cpuShare);
     GenerateValue(defStream, "maxFileSystemBytes", appPtr->maxFileSystemBytes);
     GenerateValue(defStream, "maxMemoryBytes", appPtr->maxMemoryBytes);
+    GenerateValue(defStream, "memoryThrottle", appPtr->isMemoryThrottled);
     GenerateValue(defStream, "maxMQueueBytes", appPtr->maxMQueueBytes);
     GenerateValue(defStream, "maxQueuedSignals", appPtr->maxQueuedSignals);
     GenerateValue(defStream, "maxThreads", appPtr->maxThreads);
@@ -28,6 +28,7 @@ App_t::App_t
     name(path::GetIdentifierSafeName(path::RemoveSuffix(path::GetLastNode(filePtr->path), ".adef"))),
     workingDir("app/" + name),
     isSandboxed(true),
+    isMemoryThrottled(false),
     startTrigger(AUTO),
     isPreloaded(false),
     isPreBuilt(false),
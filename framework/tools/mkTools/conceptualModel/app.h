@@ -35,6 +35,8 @@ struct App_t : public HasTargetInfo_t
 
     bool isSandboxed;       ///< true if the application should be sandboxed.
 
+    bool isMemoryThrottled; ///< true if the app's memory is throttled under system memory pressure.
+
     enum {AUTO, MANUAL} startTrigger;    ///< Start automatically or only when asked?
 
     bool isPreloaded;   ///< true = exclude app update from system update (app pre-loaded on target)
@@ -64,6 +64,11 @@ static void GenerateAppLimitsConfig
 
     cfgStream << "  \"maxMemoryBytes\" [" << appPtr->maxMemoryBytes.Get() << "]" << std::endl;
 
+    if (appPtr->isMemoryThrottled)
+    {
+        cfgStream << "  \"memoryThrottle\" !t" << std::endl;
+    }
+
     cfgStream << "  \"cpuShare\" [" << appPtr->cpuShare.Get() << "]" << std::endl;
 
     if (appPtr->maxFileSystemBytes.IsSet())
@@ -1867,6 +1867,10 @@ model::App_t* GetApp
         {
             SetMaxWatchdogTimeout(appPtr, ToSimpleSectionPtr(sectionPtr));
         }
+        else if (sectionName == "memoryThrottle")
+        {
+            appPtr->isMemoryThrottled = (ToSimpleSectionPtr(sectionPtr)->Text() == "true");
+        }
         else
         {
             sectionPtr->ThrowException(
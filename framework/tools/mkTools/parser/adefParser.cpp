@@ -668,6 +668,10 @@ static parseTree::CompoundItem_t* ParseSection
     {
         return ParseSimpleSection(lexer, sectionNameTokenPtr, parseTree::Token_t::INTEGER);
     }
+    else if (sectionName == "memoryThrottle")
+    {
+        return ParseSimpleSection(lexer, sectionNameTokenPtr, parseTree::Token_t::BOOLEAN);
+    }
     else
     {
         lexer.ThrowException(
@@ -25,6 +25,9 @@ static const char* ProcNamePtr = NULL;
 /// Address of the command function to be executed.
 static void (*CommandFunc)(void);
 
+/// true if the pressure command keeps printing the pressure events of the application.
+static bool FollowPressure = false;
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -202,6 +205,7 @@ static void PrintHelp
         "    app status [<appName>]\n"
         "    app version <appName>\n"
         "    app info [<appName>]\n"
+        "    app pressure <appName> [--follow]\n"
         "    app runProc <appName> <procName> [options]\n"
         "    app runProc <appName> [<procName>] --exe=<exePath> [options]\n"
         "\n"
@@ -249,6 +253,15 @@ static void PrintHelp
         "       If no name is given, prints the information of all installed applications.\n"
         "       If a name is given, prints the information of the specified application.\n"
         "\n"
+        "    app pressure <appName> [--follow]\n"
+        "       Prints the cpu, memory and io pressure of the specified running application, as the\n"
+        "       percentages of time its processes stalled on the resource over the last 10, 60 and\n"
+        "       300 seconds.  Requires the cgroup v2 unified hierarchy.\n"
+        "\n"
+        "       --follow\n"
+        "           Keep running and print a line each time the Supervisor reports that the\n"
+        "           application stalled on a resource.\n"
+        "\n"
         "    app runProc <appName> <procName> [options]\n"
         "       Runs a configured process inside an app using the process settings from the\n"
         "       configuration database.  If an exePath is provided as an option then the specified\n"
@@ -1200,6 +1213,130 @@ static void PrintInfo
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Resource names, indexed by cgrp_Resource_t.  le_appCtrl_Resource_t uses the same order.
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* ResourceNames[CGRP_NUM_RESOURCES] = {"cpu", "memory", "io"};
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Prints a pressure average given in hundredths of a percent.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PrintPressureAvg
+(
+    const char* labelPtr,       ///< [IN] Label of the average.
+    uint32_t avg                ///< [IN] Average in hundredths of a percent.
+)
+{
+    printf("  %s: %u.%02u%%", labelPtr, avg / 100, avg % 100);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler called by the Supervisor when the followed application stalls on a resource.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PressureHandler
+(
+    le_appCtrl_AppRef_t appRef,         ///< [IN] Application reference.
+    le_appCtrl_Resource_t resource,     ///< [IN] Resource the application stalled on.
+    uint32_t avg10,                     ///< [IN] Pressure over the last 10 seconds.
+    void* contextPtr                    ///< [IN] Not used.
+)
+{
+    if ((size_t)resource >= NUM_ARRAY_MEMBERS(ResourceNames))
+    {
+        return;
+    }
+
+    printf("%s stalled on %s:", AppNamePtr, ResourceNames[resource]);
+    PrintPressureAvg("avg10", avg10);
+    printf("\n");
+
+    fflush(stdout);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Implements the "pressure" command.
+ *
+ * @note This function does not return unless the --follow option is given.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void PrintPressure
+(
+    void
+)
+{
+    if (!cgrp_IsUnified())
+    {
+        fprintf(stderr, "Resource pressure requires the cgroup v2 unified hierarchy.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    le_appInfo_ConnectService();
+
+    if (!IsAppRunning(AppNamePtr))
+    {
+        printf("Application '%s' is not running.\n", AppNamePtr);
+        exit(EXIT_FAILURE);
+    }
+
+    cgrp_Resource_t resource;
+
+    for (resource = 0; resource < CGRP_NUM_RESOURCES; resource++)
+    {
+        cgrp_Pressure_t pressure;
+
+        le_result_t result = cgrp_GetPressure(AppNamePtr, resource, &pressure);
+
+        if (result == LE_UNSUPPORTED)
+        {
+            printf("%s: not available\n", ResourceNames[resource]);
+            continue;
+        }
+
+        if (result != LE_OK)
+        {
+            INTERNAL_ERR("Could not read the %s pressure of app '%s'.",
+                         ResourceNames[resource], AppNamePtr);
+        }
+
+        printf("%s:", ResourceNames[resource]);
+        PrintPressureAvg("avg10", pressure.avg10);
+        PrintPressureAvg("avg60", pressure.avg60);
+        PrintPressureAvg("avg300", pressure.avg300);
+        printf("  total: %" PRIu64 " us\n", pressure.totalUs);
+    }
+
+    if (!FollowPressure)
+    {
+        exit(EXIT_SUCCESS);
+    }
+
+    le_appCtrl_ConnectService();
+
+    le_appCtrl_AppRef_t appRef = le_appCtrl_GetRef(AppNamePtr);
+
+    if (appRef == NULL)
+    {
+        INTERNAL_ERR("Could not get a reference to app '%s'.", AppNamePtr);
+    }
+
+    le_appCtrl_AddPressureHandler(appRef, PressureHandler, NULL);
+
+    fflush(stdout);
+
+    // Return to the event loop to receive the pressure events.
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Implements the "list" command.
@@ -1868,6 +2005,13 @@ static void CommandArgHandler
         le_arg_AddPositionalCallback(AppNameArgHandler);
         le_arg_AllowLessPositionalArgsThanCallbacks();
     }
+    else if (strcmp(command, "pressure") == 0)
+    {
+        CommandFunc = PrintPressure;
+
+        le_arg_AddPositionalCallback(AppNameArgHandler);
+        le_arg_SetFlagVar(&FollowPressure, NULL, "follow");
+    }
     else
     {
         fprintf(stderr, "Unknown command '%s'.  Try --help.\n", command);
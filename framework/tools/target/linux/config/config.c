@@ -128,7 +128,8 @@ static void PrintHelpAndExit
            "Where:\n"
            "\t<tree path>: Is a path to the tree and node to operate on.\n"
            "\t<tree name>: Is the name of a tree in the system, but without a path.\n"
-           "\t<file path>: Path to the file to import from or export to.\n"
+           "\t<file path>: Path to the file to import from or export to.  It can also be a\n"
+           "\t             pipe, such as /dev/stdin or /dev/stdout.\n"
            "\t<new value>: Is a string value to write to the config tree.\n"
            "\t<type>:      Is optional and must be one of bool, int, float, or string.\n"
            "\t             If type is bool, then value must be either true or false.\n"
@@ -728,145 +729,6 @@ static int HandleGetJSON
 
 
 
-// -------------------------------------------------------------------------------------------------
-/**
- *  Function that handles the actual import of JSON data into the configTree.
- *
- *  @return LE_OK if the import is successful, LE_FAULT otherwise.
- */
-// -------------------------------------------------------------------------------------------------
-static le_result_t HandleImportJSONIteration
-(
-    le_cfg_IteratorRef_t iterRef,  ///< Dump the JSON data into this iterator.
-    json_t* nodePtr                ///< From this JSON object.
-)
-// -------------------------------------------------------------------------------------------------
-{
-    // Get value
-    json_t* value = json_object_get(nodePtr, JSON_FIELD_VALUE);
-
-    // Check type
-    const char* typeStr = json_string_value(json_object_get(nodePtr, JSON_FIELD_TYPE));
-    le_cfg_nodeType_t type = GetNodeTypeFromString(typeStr);
-
-    switch (type)
-    {
-        case LE_CFG_TYPE_BOOL:
-            le_cfg_SetBool(iterRef, "", json_is_true(value));
-            break;
-
-        case LE_CFG_TYPE_STRING:
-            le_cfg_SetString(iterRef, "", json_string_value(value));
-            break;
-
-        case LE_CFG_TYPE_INT:
-            le_cfg_SetInt(iterRef, "", json_integer_value(value));
-            break;
-
-        case LE_CFG_TYPE_FLOAT:
-            le_cfg_SetFloat(iterRef, "", json_real_value(value));
-            break;
-
-        case LE_CFG_TYPE_STEM:
-            {
-                // Iterate on children
-                json_t* childrenPtr = json_object_get(nodePtr, JSON_FIELD_CHILDREN);
-                json_t* childPtr;
-                int i;
-
-                json_array_foreach(childrenPtr, i, childPtr)
-                {
-                    // Get name
-                    const char* name = json_string_value(json_object_get(childPtr,
-                                                                         JSON_FIELD_NAME));
-
-                    // Is node exist with this name?
-                    le_cfg_nodeType_t existingType = le_cfg_GetNodeType(iterRef, name);
-                    switch (existingType)
-                    {
-                        case LE_CFG_TYPE_DOESNT_EXIST:
-                        case LE_CFG_TYPE_STEM:
-                        case LE_CFG_TYPE_EMPTY:
-                            // Not existing, already a stem or empty node, nothing to do
-                        break;
-
-                        default:
-                            // Issue with node creation
-                            fprintf(stderr, "Node conflict when importing, at node %s", name);
-                            return LE_NOT_POSSIBLE;
-                        break;
-                    }
-
-                    // Iterate to this child
-                    le_cfg_GoToNode(iterRef, name);
-
-                    // Iterate
-                    le_result_t subResult = HandleImportJSONIteration(iterRef, childPtr);
-                    if (subResult != LE_OK)
-                    {
-                        // Something went wrong
-                        return subResult;
-                    }
-
-                    // Go back to parent
-                    le_cfg_GoToParent(iterRef);
-                }
-            }
-            break;
-
-        default:
-            return LE_FAULT;
-    }
-
-    return LE_OK;
-}
-
-
-
-
-// -------------------------------------------------------------------------------------------------
-/**
- *  Load a JSON representation of some config data and import it into the configTree at the
- *  iterator's starting location.
- *
- *  @return LE_OK if the import is successful.  LE_FAULT otherwise.
- */
-// -------------------------------------------------------------------------------------------------
-static le_result_t HandleImportJSON
-(
-    le_cfg_IteratorRef_t iterRef,  ///< The iterator being written to.
-    const char* filePathPtr        ///< Load the JSON from a file at this path.
-)
-// -------------------------------------------------------------------------------------------------
-{
-    // Attempt to load JSON file.  If it fails to validate, then bail out.
-    json_error_t error;
-    json_t* decodedRootPtr = json_load_file(filePathPtr, 0, &error);
-
-    if (decodedRootPtr == NULL)
-    {
-        fprintf(stderr,
-                "JSON import error: line: %d, column: %d, position: %d, source: '%s', error: %s",
-                error.line,
-                error.column,
-                error.position,
-                error.source,
-                error.text);
-
-        return LE_FAULT;
-    }
-
-    // OK, looks like the JSON loaded, so iterate through it and dump it's contents into the
-    // configTree.
-    le_result_t result = HandleImportJSONIteration(iterRef, decodedRootPtr);
-    json_decref(decodedRootPtr);
-
-    return result;
-}
-
-
-
-
 // -------------------------------------------------------------------------------------------------
 /**
  *  This function will attempt read a value from the tree, and write it to standard out.  If the
@@ -1040,7 +902,9 @@ static void NodeDestPathArgHandler
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Change the name of a given node to a new name.
+ *  Copy a node to a new name, or move it if DeleteAfterCopy is set.  The new name is relative to
+ *  the node's parent, unless it is an absolute path.  The copy is done by the config tree in a
+ *  single request.
  *
  *  @return EXIT_SUCCESS if the command completes properly.  EXIT_FAILURE otherwise.
  */
@@ -1051,102 +915,186 @@ static int HandleCopy
 )
 // -------------------------------------------------------------------------------------------------
 {
-    // Create a temp file to export the tree to.
-    char tempFilePath[] = "/tmp/configExport-XXXXXX";
-    int tempFd;
+    char destPath[LE_CFG_STR_LEN_BYTES] = "";
+    int len;
 
-    do
+    if (NodeDestPath[0] == '/')
     {
-        tempFd = mkstemp(tempFilePath);
+        len = snprintf(destPath, sizeof(destPath), "%s", NodeDestPath);
     }
-    while ((tempFd == -1) && (errno == EINTR));
-
-    if (tempFd == -1)
+    else
     {
-        fprintf(stderr, "Could not create temp file. Reason, %s (%d).", strerror(errno), errno);
-        return 1;
+        len = snprintf(destPath, sizeof(destPath), "../%s", NodeDestPath);
     }
 
-    // Unlink the file now so that we can make sure that it will end up being deleted, no matter how
-    // we exit.
-    if (unlink(tempFilePath) == -1)
+    if ((size_t)len >= sizeof(destPath))
     {
-        printf("Could not unlink temporary file. Reason, %s (%d).", strerror(errno), errno);
+        fprintf(stderr, "Destination path is too long.\n");
+        return EXIT_FAILURE;
     }
 
-    // Create a transaction and export the data from the config tree.
     le_cfg_IteratorRef_t iterRef = le_cfg_CreateWriteTxn(NodePath);
-    le_result_t result = le_cfgAdmin_ExportTree(iterRef, tempFilePath, "");
+    le_result_t result = le_cfgAdmin_CopyTree(iterRef, "", destPath, DeleteAfterCopy);
 
-    if (result != LE_OK)
+    switch (result)
     {
-        fprintf(stderr,
-                "An I/O error occurred while updating the config tree.  "
-                "Tree has been left untouched.\n");
-        goto txnDone;
+        case LE_OK:
+            break;
+
+        case LE_NOT_FOUND:
+            fprintf(stderr, "Node not found.  Tree has been left untouched.\n");
+            break;
+
+        case LE_BAD_PARAMETER:
+            fprintf(stderr,
+                    "A node can not be copied into itself or over one of its parents.  "
+                    "Tree has been left untouched.\n");
+            break;
+
+        default:
+            fprintf(stderr,
+                    "An unexpected error has occurred: %s, (%d).  "
+                    "Tree has been left untouched.\n",
+                    LE_RESULT_TXT(result),
+                    result);
+            break;
     }
 
-    if (DeleteAfterCopy != false)
+    // Make sure that the change was successful, and either commit or discard any changes that were
+    // made.
+    if (result == LE_OK)
     {
-        // Since this is a rename, then delete the node at the original location.
-        le_cfg_DeleteNode(iterRef, "");
+        le_cfg_CommitTxn(iterRef);
+        return EXIT_SUCCESS;
     }
 
-    // Now, move the iterator to the node's new name, then attempt to reload the data.
-    le_cfg_GoToNode(iterRef, "..");
-    result = le_cfgAdmin_ImportTree(iterRef, tempFilePath, NodeDestPath);
+    le_cfg_CancelTxn(iterRef);
+    return EXIT_FAILURE;
+}
 
-    if (result != LE_OK)
-    {
-        switch (result)
-        {
-            case LE_FAULT:
-                fprintf(stderr,
-                        "An I/O error occurred while updating the config tree.  "
-                        "Tree has been left untouched.\n");
-                break;
 
-            case LE_FORMAT_ERROR:
-                fprintf(stderr,
-                        "Import/export corruption detected.  Tree has been left untouched.\n");
-                break;
 
-            default:
-                fprintf(stderr,
-                        "An unexpected error has occurred: %s, (%d).\n",
-                        LE_RESULT_TXT(result),
-                        result);
-                break;
-        }
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Check whether a descriptor refers to a regular file.  The config tree only accepts regular
+ *  files for bulk import and export, as it serves all its clients from a single thread and can't
+ *  be left blocked on a pipe or a terminal.
+ *
+ *  @return true if the descriptor can be sent to the config tree as is.
+ */
+// -------------------------------------------------------------------------------------------------
+static bool IsRegularFile
+(
+    int fd  ///< [IN] The descriptor to check.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    struct stat fileStat;
+
+    return (fstat(fd, &fileStat) == 0) && S_ISREG(fileStat.st_mode);
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Create an anonymous temp file, used to spool the data of an import or export from or to a pipe,
+ *  so that the config tree is handed a regular file.
+ *
+ *  @return The descriptor of the temp file, or -1 on error.
+ */
+// -------------------------------------------------------------------------------------------------
+static int CreateSpoolFile
+(
+    void
+)
+// -------------------------------------------------------------------------------------------------
+{
+    char tempFilePath[] = "/tmp/configSpool-XXXXXX";
+    int tempFd;
+
+    do
+    {
+        tempFd = mkstemp(tempFilePath);
     }
+    while ((tempFd == -1) && (errno == EINTR));
 
- txnDone:
-    // Make sure that the change was successful, and either commit or discard any changes that were
-    // made.
-    if (result == LE_OK)
+    if (tempFd == -1)
     {
-        le_cfg_CommitTxn(iterRef);
+        fprintf(stderr, "Could not create temp file: %s\n", strerror(errno));
+        return -1;
     }
-    else
+
+    // Unlink the file now so that it is deleted no matter how we exit.
+    if (unlink(tempFilePath) == -1)
     {
-        le_cfg_CancelTxn(iterRef);
+        fprintf(stderr, "Could not unlink temp file: %s\n", strerror(errno));
     }
 
-    // Was the operation successful?
-    int exitResult = (result == LE_OK) ? EXIT_SUCCESS : EXIT_FAILURE;
+    return tempFd;
+}
+
 
-    // Finally, clean up our temp file and report our results.
-    int closeRetVal;
 
-    closeRetVal = close(tempFd);
 
-    if ((closeRetVal == -1) && (errno != EINTR))
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Copy all of the data of one descriptor to another, up to the end of file.
+ *
+ *  @return LE_OK if the data was copied, LE_FAULT on I/O error.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t CopyFdData
+(
+    int fromFd,  ///< [IN] Read the data from this descriptor.
+    int toFd     ///< [IN] Write the data to this descriptor.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    char buffer[4096];
+
+    for (;;)
     {
-        fprintf(stderr, "Could not close temp file (%m).");
-        exitResult = EXIT_FAILURE;
-    }
+        ssize_t readCount = read(fromFd, buffer, sizeof(buffer));
+
+        if (readCount == 0)
+        {
+            return LE_OK;
+        }
+
+        if (readCount == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
 
-    return exitResult;
+            fprintf(stderr, "Read error: %s\n", strerror(errno));
+            return LE_FAULT;
+        }
+
+        ssize_t writtenCount = 0;
+
+        while (writtenCount < readCount)
+        {
+            ssize_t count = write(toFd, buffer + writtenCount, readCount - writtenCount);
+
+            if (count == -1)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+
+                fprintf(stderr, "Write error: %s\n", strerror(errno));
+                return LE_FAULT;
+            }
+
+            writtenCount += count;
+        }
+    }
 }
 
 
@@ -1164,19 +1112,51 @@ static int HandleImport
 )
 // -------------------------------------------------------------------------------------------------
 {
-    le_cfg_IteratorRef_t iterRef = le_cfg_CreateWriteTxn(NodePath);
-    le_result_t result;
+    int fd;
 
-    // Check requested format format.
-    if (UseJson)
+    do
     {
-        result = HandleImportJSON(iterRef, FilePath);
+        fd = open(FilePath, O_RDONLY);
     }
-    else
+    while ((fd == -1) && (errno == EINTR));
+
+    if (fd == -1)
     {
-        result = le_cfgAdmin_ImportTree(iterRef, FilePath, "");
+        fprintf(stderr, "Could not open '%s': %s\n", FilePath, strerror(errno));
+        return EXIT_FAILURE;
     }
 
+    // Data from a pipe or a terminal, such as /dev/stdin, is first read into a temp file.
+    if (!IsRegularFile(fd))
+    {
+        int spoolFd = CreateSpoolFile();
+
+        if (   (spoolFd == -1)
+            || (CopyFdData(fd, spoolFd) != LE_OK)
+            || (lseek(spoolFd, 0, SEEK_SET) == -1))
+        {
+            fprintf(stderr, "Could not read '%s'.\n", FilePath);
+            close(fd);
+            if (spoolFd != -1)
+            {
+                close(spoolFd);
+            }
+            return EXIT_FAILURE;
+        }
+
+        close(fd);
+        fd = spoolFd;
+    }
+
+    // The whole file is parsed by the config tree, in a single request.  Note that the descriptor
+    // is closed when it is sent.
+    le_cfg_IteratorRef_t iterRef = le_cfg_CreateWriteTxn(NodePath);
+    le_result_t result = le_cfgAdmin_ImportTreeFd(iterRef,
+                                                  fd,
+                                                  UseJson ? LE_CFGADMIN_FORMAT_JSON
+                                                          : LE_CFGADMIN_FORMAT_NATIVE,
+                                                  "");
+
     if (result != LE_OK)
     {
         ReportImportExportFail(result, "Import", NodePath, FilePath);
@@ -1207,16 +1187,72 @@ static int HandleExport
 {
     le_result_t result;
 
-    // Check required format.
-    if (UseJson)
+    // Exporting all of the trees at once is only supported in JSON, and is done here.  Everything
+    // else is written by the config tree, in a single request.
+    if (   (UseJson)
+        && (strcmp(NodePath, "*") == 0))
     {
-        result = HandleGetJSON(NodePath, FilePath);
+        result = (HandleGetJSON(NodePath, FilePath) == EXIT_SUCCESS) ? LE_OK : LE_FAULT;
     }
     else
     {
+        int fd;
+        int spoolFd = -1;
+
+        do
+        {
+            fd = open(FilePath, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+        }
+        while ((fd == -1) && (errno == EINTR));
+
+        if (fd == -1)
+        {
+            fprintf(stderr, "Could not open '%s': %s\n", FilePath, strerror(errno));
+            return EXIT_FAILURE;
+        }
+
+        // Data for a pipe or a terminal, such as /dev/stdout, is first written to a temp file, and
+        // copied once the config tree is done.  The descriptor is closed when it is sent, so the
+        // config tree is given a duplicate of the temp file's.
+        int exportFd = fd;
+
+        if (!IsRegularFile(fd))
+        {
+            spoolFd = CreateSpoolFile();
+            exportFd = (spoolFd == -1) ? -1 : dup(spoolFd);
+
+            if (exportFd == -1)
+            {
+                fprintf(stderr, "Could not write '%s'.\n", FilePath);
+                close(fd);
+                if (spoolFd != -1)
+                {
+                    close(spoolFd);
+                }
+                return EXIT_FAILURE;
+            }
+        }
+
         le_cfg_IteratorRef_t iterRef = le_cfg_CreateReadTxn(NodePath);
-        result = le_cfgAdmin_ExportTree(iterRef, FilePath, "");
+        result = le_cfgAdmin_ExportTreeFd(iterRef,
+                                          exportFd,
+                                          UseJson ? LE_CFGADMIN_FORMAT_JSON
+                                                  : LE_CFGADMIN_FORMAT_NATIVE,
+                                          "");
         le_cfg_CancelTxn(iterRef);
+
+        if (spoolFd != -1)
+        {
+            if (   (result == LE_OK)
+                && (   (lseek(spoolFd, 0, SEEK_SET) == -1)
+                    || (CopyFdData(spoolFd, fd) != LE_OK)))
+            {
+                result = LE_FAULT;
+            }
+
+            close(spoolFd);
+            close(fd);
+        }
     }
 
     if (result != LE_OK)
@@ -26,6 +26,11 @@ $ log trace keyword processName/componentName
  * To disable a trace:
  * @verbatim
 $ log stoptrace keyword processName/componentName
+@endverbatim
+ *
+ * To disable the log messages of a line of a source file:
+ * @verbatim
+$ log disable fileName:lineNumber processName/componentName
 @endverbatim
  *
  *
@@ -91,6 +96,17 @@ static const char* CommandParamPtr = NULL;
 static const char* SessionIdPtr = DEFAULT_SESSION_ID;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Options of the "query" command.
+ **/
+//--------------------------------------------------------------------------------------------------
+static const char* QueryLevelPtr = LOG_SET_LEVEL_DEBUG_STR;
+static const char* QueryAppNamePtr = "*";
+static int QueryMinutes = 0;
+static int QueryMaxRecords = 0;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * True if an error response was received from the Log Control Daemon.
@@ -118,7 +134,11 @@ static void PrintHelpAndExit
         "    log level FILTER_STR [DESTINATION]\n"
         "    log trace KEYWORD_STR [DESTINATION]\n"
         "    log stoptrace KEYWORD_STR [DESTINATION]\n"
+        "    log disable FILE[:LINE] [DESTINATION]\n"
+        "    log enable FILE[:LINE] [DESTINATION]\n"
         "    log forget PROCESS_NAME\n"
+        "    log fdstats\n"
+        "    log query [OPTIONS] [DESTINATION]\n"
         "\n"
         "DESCRIPTION:\n"
         "    log list            Lists all processes/components registered with the\n"
@@ -142,10 +162,36 @@ static void PrintHelpAndExit
         "                        keyword is not logged.  The KEYWORD_STR is a trace\n"
         "                        keyword.\n"
         "\n"
+        "    log disable         Disables the log messages and traces of the given\n"
+        "                        line of a source file, or of all its lines if\n"
+        "                        LINE is omitted.  FILE is the file name as shown\n"
+        "                        in the log messages.  Only applies to running\n"
+        "                        processes.\n"
+        "\n"
+        "    log enable          Enables again log messages and traces disabled by\n"
+        "                        'log disable'.\n"
+        "\n"
         "    log forget          Forgets all settings for processes with a given name.\n"
         "                        Future processes with that name will have default\n"
         "                        settings.\n"
         "\n"
+        "    log fdstats         Lists the number of lines logged, suppressed by the\n"
+        "                        rate limit and truncated for the standard out and\n"
+        "                        standard error of each application process, and the\n"
+        "                        totals since the log daemon started.\n"
+        "\n"
+        "    log query           Prints the records of the persistent log store\n"
+        "                        that match the process of the DESTINATION and\n"
+        "                        the options.  The store only holds the standard\n"
+        "                        out and standard error lines of app processes,\n"
+        "                        so the componentName of the DESTINATION is\n"
+        "                        ignored:\n"
+        "                            --level=FILTER_STR  Least severe level.\n"
+        "                            --app=APP_NAME      App the process belongs to.\n"
+        "                            --minutes=N         Only the last N minutes.\n"
+        "                            --max=N             Only the newest N records\n"
+        "                                                (default 100).\n"
+        "\n"
         "The [DESTINATION] is optional and specifies the process and component to\n"
         "send the command to.  The [DESTINATION] must be in this format:\n"
         "\n"
@@ -464,6 +510,44 @@ static void TraceKeywordArgHandler
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function the gets called by le_arg_Scan() when a call site argument ("fileName" or
+ * "fileName:lineNumber") is seen on the command line.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void CallSiteArgHandler
+(
+    const char* callSite
+)
+{
+    const char* lineNumberPtr = strchr(callSite, ':');
+
+    if ((callSite[0] == '\0') || (callSite[0] == ':') || (strchr(callSite, '/') != NULL))
+    {
+        ExitWithErrorMsg("Invalid source file name.");
+    }
+
+    if (lineNumberPtr != NULL)
+    {
+        char* endPtr;
+
+        errno = 0;
+        long lineNumber = strtol(lineNumberPtr + 1, &endPtr, 10);
+        if ((errno != 0) || (*endPtr != '\0') || (lineNumber <= 0) || (lineNumberPtr[1] == '+'))
+        {
+            ExitWithErrorMsg("Invalid line number.");
+        }
+    }
+
+    CommandParamPtr = callSite;
+
+    // Wait for an optional log session identifier next.
+    le_arg_AddPositionalCallback(SessionIdArgHandler);
+    le_arg_AllowLessPositionalArgsThanCallbacks();
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Function that gets called by le_arg_Scan() when the process identifier argument (either a process
@@ -479,6 +563,49 @@ static void ProcessIdArgHandler
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function that gets called by le_arg_Scan() when the --level option of the "query" command is
+ * found on the command line.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void QueryLevelArgHandler
+(
+    const char* logLevel
+)
+{
+    le_log_Level_t level = ParseSeverityLevel(logLevel);
+    if (level == (le_log_Level_t)(-1))
+    {
+        ExitWithErrorMsg("Invalid log level.");
+    }
+
+    QueryLevelPtr = log_SeverityLevelToStr(level);
+    LE_ASSERT(QueryLevelPtr != NULL);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function that gets called by le_arg_Scan() when the --app option of the "query" command is found
+ * on the command line.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void QueryAppArgHandler
+(
+    const char* appName
+)
+{
+    if ( (appName[0] == '\0') || (strchr(appName, ' ') != NULL) ||
+         (strlen(appName) > LIMIT_MAX_APP_NAME_LEN) )
+    {
+        ExitWithErrorMsg("Invalid app name.");
+    }
+
+    QueryAppNamePtr = appName;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Function that gets called by le_arg_Scan() when it sees the first positional argument while
@@ -516,12 +643,45 @@ static void CommandArgHandler
         // Expect a trace keyword next.
         le_arg_AddPositionalCallback(TraceKeywordArgHandler);
     }
+    else if (strcmp(command, "disable") == 0)
+    {
+        Command = LOG_CMD_DISABLE_CALLSITE;
+
+        // Expect a call site next.
+        le_arg_AddPositionalCallback(CallSiteArgHandler);
+    }
+    else if (strcmp(command, "enable") == 0)
+    {
+        Command = LOG_CMD_ENABLE_CALLSITE;
+
+        // Expect a call site next.
+        le_arg_AddPositionalCallback(CallSiteArgHandler);
+    }
     else if (strcmp(command, "list") == 0)
     {
         Command = LOG_CMD_LIST_COMPONENTS;
 
         // This command has no parameters and no destination.
     }
+    else if (strcmp(command, "fdstats") == 0)
+    {
+        Command = LOG_CMD_LIST_FD_STATS;
+
+        // This command has no parameters and no destination.
+    }
+    else if (strcmp(command, "query") == 0)
+    {
+        Command = LOG_CMD_QUERY_STORE;
+
+        le_arg_SetStringCallback(QueryLevelArgHandler, NULL, "level");
+        le_arg_SetStringCallback(QueryAppArgHandler, NULL, "app");
+        le_arg_SetIntVar(&QueryMinutes, NULL, "minutes");
+        le_arg_SetIntVar(&QueryMaxRecords, NULL, "max");
+
+        // Accept an optional log session identifier.
+        le_arg_AddPositionalCallback(SessionIdArgHandler);
+        le_arg_AllowLessPositionalArgsThanCallbacks();
+    }
     else if (strcmp(command, "forget") == 0)
     {
         Command = LOG_CMD_FORGET_PROCESS;
@@ -566,6 +726,8 @@ COMPONENT_INIT
         case LOG_CMD_SET_LEVEL:
         case LOG_CMD_ENABLE_TRACE:
         case LOG_CMD_DISABLE_TRACE:
+        case LOG_CMD_ENABLE_CALLSITE:
+        case LOG_CMD_DISABLE_CALLSITE:
 
             AppendToCommand(msgRef, SessionIdPtr);
             AppendToCommand(msgRef, "/");
@@ -574,8 +736,9 @@ COMPONENT_INIT
             break;
 
         case LOG_CMD_LIST_COMPONENTS:
+        case LOG_CMD_LIST_FD_STATS:
 
-            // This one has no arguments.
+            // These have no arguments.
 
             break;
 
@@ -584,6 +747,24 @@ COMPONENT_INIT
             AppendToCommand(msgRef, CommandParamPtr);
 
             break;
+
+        case LOG_CMD_QUERY_STORE:
+        {
+            if ( (QueryMinutes < 0) || (QueryMaxRecords < 0) )
+            {
+                ExitWithErrorMsg("Invalid query option.");
+            }
+
+            char queryStr[LOG_MAX_CMD_PACKET_BYTES];
+            snprintf(queryStr, sizeof(queryStr), "%s %d %d %s",
+                     QueryLevelPtr, QueryMinutes, QueryMaxRecords, QueryAppNamePtr);
+
+            AppendToCommand(msgRef, SessionIdPtr);
+            AppendToCommand(msgRef, "/");
+            AppendToCommand(msgRef, queryStr);
+
+            break;
+        }
     }
 
     // Send the command and wait for messages from the Log Control Daemon.  When the Log Control